@@ -17,6 +17,10 @@ set(mlas_common_srcs
   ${ONNXRUNTIME_ROOT}/core/mlas/lib/tanh.cpp
   ${ONNXRUNTIME_ROOT}/core/mlas/lib/erf.cpp
   ${ONNXRUNTIME_ROOT}/core/mlas/lib/compute.cpp
+  ${ONNXRUNTIME_ROOT}/core/mlas/lib/layernorm.cpp
+  ${ONNXRUNTIME_ROOT}/core/mlas/lib/groupnorm.cpp
+  ${ONNXRUNTIME_ROOT}/core/mlas/lib/tree.cpp
+  ${ONNXRUNTIME_ROOT}/core/mlas/lib/reduce.cpp
   ${ONNXRUNTIME_ROOT}/core/mlas/lib/quantize.cpp
   ${ONNXRUNTIME_ROOT}/core/mlas/lib/qladd.cpp
   ${ONNXRUNTIME_ROOT}/core/mlas/lib/qlmul.cpp
@@ -91,6 +95,8 @@ elseif(MSVC)
       ${mlas_platform_srcs_avx}
       ${mlas_platform_srcs_avx2}
       ${ONNXRUNTIME_ROOT}/core/mlas/lib/intrinsics/avx512/quantize_avx512f.cpp
+      ${ONNXRUNTIME_ROOT}/core/mlas/lib/intrinsics/avx512/layernorm_avx512f.cpp
+      ${ONNXRUNTIME_ROOT}/core/mlas/lib/intrinsics/avx512/tree_avx512f.cpp
       ${ONNXRUNTIME_ROOT}/core/mlas/lib/amd64/QgemmU8S8KernelAvx2.asm
       ${ONNXRUNTIME_ROOT}/core/mlas/lib/amd64/QgemmU8U8KernelAvx2.asm
       ${ONNXRUNTIME_ROOT}/core/mlas/lib/amd64/QgemmU8X8KernelAvx2.asm
@@ -269,6 +275,8 @@ else()
       ${ONNXRUNTIME_ROOT}/core/mlas/lib/x86_64/ErfKernelFma3.S
       ${ONNXRUNTIME_ROOT}/core/mlas/lib/intrinsics/avx2/qladd_avx2.cpp
       ${ONNXRUNTIME_ROOT}/core/mlas/lib/intrinsics/avx2/qdwconv_avx2.cpp
+      ${ONNXRUNTIME_ROOT}/core/mlas/lib/intrinsics/avx2/layernorm_avx2.cpp
+      ${ONNXRUNTIME_ROOT}/core/mlas/lib/intrinsics/avx2/tree_avx2.cpp
     )
     set_source_files_properties(${mlas_platform_srcs_avx2} PROPERTIES COMPILE_FLAGS "-mavx2 -mfma")
 
@@ -310,6 +318,8 @@ else()
       if(COMPILES_AVX512F_INTRINSICS)
         set(mlas_platform_srcs_avx512f
           ${ONNXRUNTIME_ROOT}/core/mlas/lib/intrinsics/avx512/quantize_avx512f.cpp
+          ${ONNXRUNTIME_ROOT}/core/mlas/lib/intrinsics/avx512/layernorm_avx512f.cpp
+          ${ONNXRUNTIME_ROOT}/core/mlas/lib/intrinsics/avx512/tree_avx512f.cpp
           ${mlas_platform_srcs_avx512f}
         )
       else()
@@ -16,10 +16,12 @@ namespace onnxruntime {
 //   - tensor values: The lifetimes of these tensor-values are statically
 //     determined, which is used for memory reuse/sharing optimizations. The
 //     runtime allocates/frees these values at the right time (as determined
-//     by the static allocation plan). Note that this is simplified since we
-//     do not try to optimize for "slice" like ops, where we may be able to
-//     conditionally reuse memory/data in some cases but not others.
-//     Generalizing this is future work.
+//     by the static allocation plan).
+//   - views: outputs of "slice" like ops that may refer to a contiguous range
+//     of an input's buffer. Whether the view is possible is only known at
+//     execution time, so the kernel either creates the output at an offset
+//     into the input or falls back to allocating it. A view never owns the
+//     buffer; it is released together with the buffer it refers to.
 
 enum class AllocKind {
   kNotSet = -1,
@@ -29,7 +31,8 @@ enum class AllocKind {
   kAllocateStatically = 3,
   kAllocateOutput = 4,
   kShare = 5,
-  kAllocatedExternally = 6
+  kAllocatedExternally = 6,
+  kView = 7
 };
 
 std::ostream& operator<<(std::ostream& out, AllocKind alloc_kind);
@@ -75,6 +75,14 @@ class KernelDef {
     return variadic_alias_offsets_;
   }
 
+  const std::vector<std::pair<int, int>>& MayView() const {
+    return view_map_;
+  }
+
+  const optional<std::pair<int, int>>& VariadicMayView() const {
+    return variadic_view_;
+  }
+
   OrtMemType InputMemoryType(size_t input_index) const {
     auto it = input_memory_type_args_.find(input_index);
     if (it == input_memory_type_args_.end())
@@ -157,6 +165,13 @@ class KernelDef {
   // output 'i + output_offset' is an alias of input 'i + input_offset' for all i >= 0
   optional<std::pair<int, int>> variadic_alias_offsets_;
 
+  // An element <i, j> means that output j may be a view into a contiguous range of input i.
+  std::vector<std::pair<int, int>> view_map_;
+
+  // This variable stores <input_index, output_offset> for the variadic view mapping
+  // output 'i + output_offset' may be a view into input 'input_index' for all i >= 0
+  optional<std::pair<int, int>> variadic_view_;
+
   // Require input tensors to be allocated contiguously.
   bool allocate_inputs_contiguously_ = false;
 
@@ -279,6 +294,22 @@ class KernelDefBuilder {
   */
   KernelDefBuilder& VariadicAlias(int input_offset, int output_offset);
 
+  /**
+     View mapping from inputs to outputs. The output may be created at a byte
+     offset into the input's buffer (e.g. an outer axis Slice) instead of being
+     copied. Whether that is possible is decided by the kernel at execution
+     time via OpKernelContext::OutputView; the kernel must fall back to a
+     regular Output when it returns nullptr. The content of the input is not
+     changed.
+  */
+  KernelDefBuilder& MayView(const std::vector<std::pair<int, int>>& views);
+  KernelDefBuilder& MayView(int input_index, int output_index);
+
+  /**
+     Apply MayView(input_index, i + output_offset) for i >= 0, e.g. for the outputs of Split.
+  */
+  KernelDefBuilder& VariadicMayView(int input_index, int output_offset);
+
   /**
      Specify that this kernel requires input tensors to be allocated
      contiguously. This allows kernels to execute as a single large
@@ -69,6 +69,12 @@ class OpKernelContext {
     return *output_ptr;
   }
 
+  // Create the output tensor as a view at byte_offset into the input tensor at input_index, so no data is copied.
+  // Only possible if the kernel registered the pair with KernelDefBuilder::MayView and the allocation plan chose
+  // to create the output as a view. Returns nullptr otherwise, in which case the kernel should fetch the output
+  // with Output(index, shape) and write it as usual. The kernel must not modify the returned tensor.
+  Tensor* OutputView(int index, const TensorShape& shape, int input_index, ptrdiff_t byte_offset);
+
   // Fetch a sparse-tensor output corresponding to the specified index.
   // num_values must specify the number of non-zero values (commonly known as NNZ/nnz),
   // and shape must specify the shape of the underlying dense-tensor.
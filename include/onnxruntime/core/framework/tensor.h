@@ -6,6 +6,7 @@
 #include <stddef.h>
 #include <iostream>
 #include <string>
+#include <type_traits>
 #include <vector>
 
 #include "gsl/gsl"
@@ -76,6 +77,25 @@ class Tensor final {
   Tensor(MLDataType p_type, const TensorShape& shape, void* p_data, std::shared_ptr<IAllocator> deleter,
          ptrdiff_t offset = 0);
 
+  /**
+   * Create a string tensor in the string buffer layout: the bytes of all the strings one after the other and
+   * the offsets of the strings, in a single allocation from `allocator` instead of one std::string per element.
+   * The caller fills the offsets and the bytes, see MutableStringBufferOffsets and MutableStringBufferData.
+   * Kernels read such tensors through StringTensorView, Data<std::string>() is not available.
+   * \param shape Shape of the tensor
+   * \param total_bytes Total length of the strings
+   * \param allocator Allocator of the buffer, which is released with the tensor
+   */
+  static std::unique_ptr<Tensor> CreateStringBuffer(const TensorShape& shape, size_t total_bytes,
+                                                    std::shared_ptr<IAllocator> allocator);
+
+  /**
+   * Create a string tensor in the string buffer layout over the buffer of `source`, with a shape of the same size.
+   * The tensor does not own the buffer, so `source` must outlive it. This is how an output aliases an input in the
+   * string buffer layout (e.g. Identity or Reshape), as the buffer holds no std::string elements.
+   */
+  static std::unique_ptr<Tensor> CreateStringBufferAlias(const TensorShape& shape, Tensor& source);
+
   ~Tensor();
 
   //Move is allowed
@@ -128,6 +148,7 @@ class Tensor final {
     // Type check
     ORT_ENFORCE(utils::IsPrimitiveDataType<T>(dtype_), "Tensor type mismatch. ",
                 "T ", "!=", dtype_);
+    CheckNotStringBuffer<T>();
     return reinterpret_cast<T*>(static_cast<char*>(p_data_) + byte_offset_);
   }
 
@@ -139,6 +160,7 @@ class Tensor final {
     // Type check
     ORT_ENFORCE(utils::IsPrimitiveDataType<T>(dtype_), "Tensor type mismatch. ",
                 "T ", "!=", dtype_);
+    CheckNotStringBuffer<T>();
     T* data = reinterpret_cast<T*>(static_cast<char*>(p_data_) + byte_offset_);
     return gsl::make_span(data, static_cast<size_t>(shape_.Size()));
   }
@@ -148,6 +170,7 @@ class Tensor final {
     // Type check
     ORT_ENFORCE(utils::IsPrimitiveDataType<T>(dtype_), "Tensor type mismatch. ",
                 "T ", "!=", dtype_);
+    CheckNotStringBuffer<T>();
     return reinterpret_cast<const T*>(static_cast<char*>(p_data_) + byte_offset_);
   }
 
@@ -156,6 +179,7 @@ class Tensor final {
     // Type check
     ORT_ENFORCE(utils::IsPrimitiveDataType<T>(dtype_), "Tensor type mismatch. ",
                 "T ", "!=", dtype_);
+    CheckNotStringBuffer<T>();
     const T* data = reinterpret_cast<const T*>(static_cast<char*>(p_data_) + byte_offset_);
     return gsl::make_span(data, static_cast<typename gsl::span<T>::index_type>(shape_.Size()));
   }
@@ -182,6 +206,33 @@ class Tensor final {
     return buffer_deleter_ != nullptr;
   }
 
+  /**
+     Returns true if this is a string tensor in the string buffer layout, see CreateStringBuffer.
+  */
+  bool IsStringBuffer() const noexcept { return is_string_buffer_; }
+
+  /**
+     Offsets of the strings of a tensor in the string buffer layout: Shape().Size() + 1 values, string i is
+     [offsets[i], offsets[i + 1]) in StringBufferData() and the last offset is the total length.
+  */
+  const size_t* StringBufferOffsets() const {
+    ORT_ENFORCE(is_string_buffer_, "Tensor is not in the string buffer layout.");
+    return static_cast<const size_t*>(p_data_);
+  }
+
+  size_t* MutableStringBufferOffsets() {
+    ORT_ENFORCE(is_string_buffer_, "Tensor is not in the string buffer layout.");
+    return static_cast<size_t*>(p_data_);
+  }
+
+  const char* StringBufferData() const {
+    return reinterpret_cast<const char*>(StringBufferOffsets() + shape_.Size() + 1);
+  }
+
+  char* MutableStringBufferData() {
+    return reinterpret_cast<char*>(MutableStringBufferOffsets() + shape_.Size() + 1);
+  }
+
   /**
    * Resizes the tensor without touching underlying storage.
    * This requires the total size of the tensor to remains constant.
@@ -226,6 +277,14 @@ class Tensor final {
 
   void ReleaseBuffer();
 
+  template <typename T>
+  void CheckNotStringBuffer() const {
+    if constexpr (std::is_same<std::remove_cv_t<T>, std::string>::value) {
+      ORT_ENFORCE(!is_string_buffer_,
+                  "The string tensor is in the string buffer layout and has no std::string elements.");
+    }
+  }
+
   void* p_data_;
   /**
      if buffer_deleter_ is null, it means tensor does not own the buffer.
@@ -238,6 +297,7 @@ class Tensor final {
   const PrimitiveDataTypeBase* dtype_;
   OrtMemoryInfo alloc_info_;
   ptrdiff_t byte_offset_;
+  bool is_string_buffer_ = false;
 };
 #ifdef __GNUC__
 #pragma GCC diagnostic pop
@@ -1445,6 +1445,27 @@ struct OrtApi {
   * Use this API to release the instance of OrtTensorRTProviderV2.
   */
   ORT_CLASS_RELEASE2(TensorRTProviderOptions);
+
+  /**
+  * Create a string tensor in the string buffer layout: the strings are copied to a single buffer allocated
+  * with 'allocator' instead of one allocation per element. The strings are passed in the layout returned by
+  * GetStringTensorContent.
+  * The operators reading this layout (Tokenizer, TfIdfVectorizer, StringNormalizer, LabelEncoder and
+  * CategoryMapper) and the ones only changing the shape or copying their input (e.g. Identity, Reshape) accept such
+  * a tensor as input, the other operators fail on it. FillStringTensor and FillStringTensorElement can't modify it.
+  *
+  * \param allocator - allocator of the tensor buffer, which is released with the OrtValue
+  * \param shape - shape of the tensor, its number of elements must be offsets_len
+  * \param s - the bytes of all the strings, one after the other
+  * \param s_len - total length of the strings
+  * \param offsets - offset of every string in 's', string i ends where string i + 1 starts or at s_len
+  * \param out - the created tensor, to be released with ReleaseValue
+  */
+  ORT_API2_STATUS(CreateStringTensorWithBuffer, _Inout_ OrtAllocator* allocator,
+                  _In_ const int64_t* shape, size_t shape_len,
+                  _In_reads_bytes_(s_len) const void* s, size_t s_len,
+                  _In_reads_(offsets_len) const size_t* offsets, size_t offsets_len,
+                  _Outptr_ OrtValue** out);
 };
 
 /*
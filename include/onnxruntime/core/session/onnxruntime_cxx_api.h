@@ -425,6 +425,8 @@ struct Value : Base<OrtValue> {
   template <typename T>
   static Value CreateTensor(OrtAllocator* allocator, const int64_t* shape, size_t shape_len);
   static Value CreateTensor(OrtAllocator* allocator, const int64_t* shape, size_t shape_len, ONNXTensorElementDataType type);
+  static Value CreateStringTensorWithBuffer(OrtAllocator* allocator, const int64_t* shape, size_t shape_len,
+                                            const void* s, size_t s_len, const size_t* offsets, size_t offsets_len);
 
   static Value CreateMap(Value& keys, Value& values);
   static Value CreateSequence(std::vector<Value>& values);
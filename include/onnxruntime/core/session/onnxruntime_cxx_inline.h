@@ -761,6 +761,15 @@ inline Value Value::CreateTensor(OrtAllocator* allocator, const int64_t* shape,
   return Value{out};
 }
 
+inline Value Value::CreateStringTensorWithBuffer(OrtAllocator* allocator, const int64_t* shape, size_t shape_len,
+                                                 const void* s, size_t s_len, const size_t* offsets,
+                                                 size_t offsets_len) {
+  OrtValue* out;
+  ThrowOnError(GetApi().CreateStringTensorWithBuffer(allocator, shape, shape_len, s, s_len, offsets, offsets_len,
+                                                      &out));
+  return Value{out};
+}
+
 inline Value Value::CreateMap(Value& keys, Value& values) {
   OrtValue* out;
   OrtValue* inputs[2] = {keys, values};
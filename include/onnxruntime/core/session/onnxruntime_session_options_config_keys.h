@@ -51,6 +51,13 @@ static const char* const kOrtSessionOptionsDisableQuantQDQ = "session.disable_qu
 // GeluApproximation has side effects which may change the inference results. It is disabled by default due to this.
 static const char* const kOrtSessionOptionsEnableGeluApproximation = "optimization.enable_gelu_approximation";
 
+// Remove the ZipMap nodes producing graph outputs. "0": disable; "1": enable. The default is "0".
+// Such an output becomes the tensor of probabilities given to the ZipMap, [N][number of classes] float values in the
+// order of the class labels of the ZipMap, instead of a sequence with one map per row. Building the maps costs more
+// than most scikit-learn classifiers for large batches. The name of the output is kept but its type changes, and the
+// class labels are added at the end of the graph outputs as a 1-D tensor named "<output name>_keys".
+static const char* const kOrtSessionOptionsStripZipMapOutputs = "optimization.strip_zipmap_outputs";
+
 // Enable or disable using device allocator for allocating initialized tensor memory. "1": enable; "0": disable. The default is "0".
 // Using device allocators means the memory allocation is made using malloc/new.
 static const char* const kOrtSessionOptionsUseDeviceAllocatorForInitializers = "session.use_device_allocator_for_initializers";
@@ -60,3 +67,24 @@ static const char* const kOrtSessionOptionsUseDeviceAllocatorForInitializers = "
 // "1": default, thread will spin a number of times before blocking
 static const char* const kOrtSessionOptionsConfigAllowInterOpSpinning = "session.inter_op.allow_spinning";
 static const char* const kOrtSessionOptionsConfigAllowIntraOpSpinning = "session.intra_op.allow_spinning";
+
+// Maximum size in bytes of the outputs of a node for it to be constant folded. "0" means no limit. The default is "0".
+static const char* const kOrtSessionOptionsConstantFoldingMaxOutputSize =
+    "optimization.constant_folding.max_output_size_in_bytes";
+
+// Maximum size in bytes of the outputs of Expand, Tile and ConstantOfShape nodes for them to be constant folded when
+// their outputs are larger than their inputs. Such nodes are cheap to run but folding them can greatly increase the
+// size of the model. "0" means no limit. The default is "4194304" (4 MB).
+static const char* const kOrtSessionOptionsConstantFoldingMaxExpansionSize =
+    "optimization.constant_folding.max_expansion_size_in_bytes";
+
+// Directory used to cache constant folded outputs across sessions. Entries are keyed by a hash of the folded node and
+// the contents of its inputs, so the folding is skipped when the same model is loaded again.
+// The cache is disabled if this is not set.
+static const char* const kOrtSessionOptionsConstantFoldingCacheDir = "optimization.constant_folding.cache_dir";
+
+// Path of a file to write a JSON report of the graph transformers to when the session is initialized.
+// For every transformer the report lists the time spent in it, how often it was applied and modified the graph, the
+// number of nodes it added and removed, and the net change in initializer bytes. The report is not written if this is
+// not set. The same information is recorded as profiling events when profiling is enabled.
+static const char* const kOrtSessionOptionsGraphTransformerReportFile = "optimization.graph_transformer_report_file";
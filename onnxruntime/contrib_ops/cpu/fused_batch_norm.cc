@@ -0,0 +1,26 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/providers/cpu/nn/batch_norm.h"
+#include "contrib_ops/cpu/fused_activation.h"
+
+namespace onnxruntime {
+namespace contrib {
+
+class FusedBatchNormFloat final : public BatchNorm<float> {
+ public:
+  FusedBatchNormFloat(const OpKernelInfo& info) : BatchNorm<float>(info) {
+    ORT_ENFORCE(GetFusedActivationAttr(info, activation_).IsOK());
+  }
+};
+
+ONNX_CPU_OPERATOR_TYPED_MS_KERNEL(
+    FusedBatchNormalization,
+    1,
+    float,
+    KernelDefBuilder()
+        .TypeConstraint("T", DataTypeImpl::GetTensorType<float>()),
+    FusedBatchNormFloat);
+
+}  // namespace contrib
+}  // namespace onnxruntime
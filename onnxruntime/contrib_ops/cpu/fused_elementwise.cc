@@ -0,0 +1,381 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "contrib_ops/cpu/fused_elementwise.h"
+
+#include <algorithm>
+#include <cmath>
+#include <unordered_map>
+
+#include "core/framework/tensor.h"
+#include "core/mlas/inc/mlas.h"
+#include "core/platform/threadpool.h"
+
+namespace onnxruntime {
+namespace contrib {
+
+ONNX_OPERATOR_KERNEL_EX(
+    FusedElementwise,
+    kMSDomain,
+    1,
+    kCpuExecutionProvider,
+    KernelDefBuilder().TypeConstraint("T", DataTypeImpl::GetTensorType<float>()),
+    FusedElementwise);
+
+bool TryParseFusedElementwiseOp(const std::string& op_type, FusedElementwiseOp& op) {
+  static const std::unordered_map<std::string, FusedElementwiseOp> op_map = {
+      {"Add", FusedElementwiseOp::Add},
+      {"Sub", FusedElementwiseOp::Sub},
+      {"Mul", FusedElementwiseOp::Mul},
+      {"Div", FusedElementwiseOp::Div},
+      {"Max", FusedElementwiseOp::Max},
+      {"Min", FusedElementwiseOp::Min},
+      {"Pow", FusedElementwiseOp::Pow},
+      {"Relu", FusedElementwiseOp::Relu},
+      {"Sigmoid", FusedElementwiseOp::Sigmoid},
+      {"Tanh", FusedElementwiseOp::Tanh},
+      {"Exp", FusedElementwiseOp::Exp},
+      {"Log", FusedElementwiseOp::Log},
+      {"Neg", FusedElementwiseOp::Neg},
+      {"Abs", FusedElementwiseOp::Abs},
+      {"Sqrt", FusedElementwiseOp::Sqrt},
+      {"Reciprocal", FusedElementwiseOp::Reciprocal},
+      {"Erf", FusedElementwiseOp::Erf},
+  };
+
+  auto it = op_map.find(op_type);
+  if (it == op_map.end()) {
+    return false;
+  }
+  op = it->second;
+  return true;
+}
+
+bool IsBinaryFusedElementwiseOp(FusedElementwiseOp op) {
+  switch (op) {
+    case FusedElementwiseOp::Add:
+    case FusedElementwiseOp::Sub:
+    case FusedElementwiseOp::Mul:
+    case FusedElementwiseOp::Div:
+    case FusedElementwiseOp::Max:
+    case FusedElementwiseOp::Min:
+    case FusedElementwiseOp::Pow:
+      return true;
+    default:
+      return false;
+  }
+}
+
+FusedElementwise::FusedElementwise(const OpKernelInfo& info) : OpKernel(info) {
+  std::vector<std::string> ops;
+  std::vector<int64_t> operands;
+  ORT_ENFORCE(info.GetAttrs<std::string>("ops", ops).IsOK(), "Attribute 'ops' is required.");
+  ORT_ENFORCE(info.GetAttrs<int64_t>("operands", operands).IsOK(), "Attribute 'operands' is required.");
+  ORT_ENFORCE(!ops.empty() && ops.size() <= kMaxSteps,
+              "FusedElementwise supports between 1 and ", kMaxSteps, " steps. Got ", ops.size());
+  ORT_ENFORCE(operands.size() == 2 * ops.size(),
+              "Attribute 'operands' must contain two entries per step.");
+
+  const int64_t num_inputs = static_cast<int64_t>(info.GetInputCount());
+  steps_.reserve(ops.size());
+  for (size_t i = 0; i < ops.size(); ++i) {
+    Step step;
+    ORT_ENFORCE(TryParseFusedElementwiseOp(ops[i], step.op), "Unsupported op in FusedElementwise: ", ops[i]);
+    step.operand_a = operands[2 * i];
+    step.operand_b = operands[2 * i + 1];
+
+    // operands may only refer to inputs or to the results of preceding steps
+    const int64_t limit = num_inputs + static_cast<int64_t>(i);
+    ORT_ENFORCE(step.operand_a >= 0 && step.operand_a < limit, "Invalid operand for step ", i);
+    if (IsBinaryFusedElementwiseOp(step.op)) {
+      ORT_ENFORCE(step.operand_b >= 0 && step.operand_b < limit, "Invalid operand for step ", i);
+    } else {
+      ORT_ENFORCE(step.operand_b == -1, "Unary step ", i, " must use -1 as its second operand.");
+    }
+
+    steps_.push_back(step);
+  }
+}
+
+namespace {
+
+// How an input is mapped onto the flattened output.
+enum class InputKind {
+  Full,    // same number of elements as the output
+  Scalar,  // a single element broadcast to every output element
+  Suffix,  // matches the trailing dimensions of the output, repeated with a period of its size
+};
+
+struct InputInfo {
+  const float* data;
+  InputKind kind;
+  int64_t period;
+};
+
+struct Operand {
+  const float* data;
+  bool scalar;
+};
+
+template <typename Fn>
+void ComputeBinary(const Operand& a, const Operand& b, float* dst, size_t count, bool& dst_scalar, Fn fn) {
+  if (a.scalar && b.scalar) {
+    dst[0] = fn(a.data[0], b.data[0]);
+    dst_scalar = true;
+    return;
+  }
+
+  dst_scalar = false;
+  if (a.scalar) {
+    const float a_value = a.data[0];
+    for (size_t i = 0; i < count; i++) {
+      dst[i] = fn(a_value, b.data[i]);
+    }
+  } else if (b.scalar) {
+    const float b_value = b.data[0];
+    for (size_t i = 0; i < count; i++) {
+      dst[i] = fn(a.data[i], b_value);
+    }
+  } else {
+    for (size_t i = 0; i < count; i++) {
+      dst[i] = fn(a.data[i], b.data[i]);
+    }
+  }
+}
+
+template <typename Fn>
+void ComputeUnary(const Operand& a, float* dst, size_t count, bool& dst_scalar, Fn fn) {
+  dst_scalar = a.scalar;
+  const size_t n = a.scalar ? 1 : count;
+  for (size_t i = 0; i < n; i++) {
+    dst[i] = fn(a.data[i]);
+  }
+}
+
+void ComputeStep(FusedElementwiseOp op, const Operand& a, const Operand& b,
+                 float* dst, size_t count, bool& dst_scalar) {
+  switch (op) {
+    case FusedElementwiseOp::Add:
+      ComputeBinary(a, b, dst, count, dst_scalar, [](float x, float y) { return x + y; });
+      break;
+    case FusedElementwiseOp::Sub:
+      ComputeBinary(a, b, dst, count, dst_scalar, [](float x, float y) { return x - y; });
+      break;
+    case FusedElementwiseOp::Mul:
+      ComputeBinary(a, b, dst, count, dst_scalar, [](float x, float y) { return x * y; });
+      break;
+    case FusedElementwiseOp::Div:
+      ComputeBinary(a, b, dst, count, dst_scalar, [](float x, float y) { return x / y; });
+      break;
+    case FusedElementwiseOp::Max:
+      ComputeBinary(a, b, dst, count, dst_scalar, [](float x, float y) { return std::max(x, y); });
+      break;
+    case FusedElementwiseOp::Min:
+      ComputeBinary(a, b, dst, count, dst_scalar, [](float x, float y) { return std::min(x, y); });
+      break;
+    case FusedElementwiseOp::Pow:
+      ComputeBinary(a, b, dst, count, dst_scalar, [](float x, float y) { return std::pow(x, y); });
+      break;
+    case FusedElementwiseOp::Relu:
+      ComputeUnary(a, dst, count, dst_scalar, [](float x) { return std::max(x, 0.0f); });
+      break;
+    case FusedElementwiseOp::Neg:
+      ComputeUnary(a, dst, count, dst_scalar, [](float x) { return -x; });
+      break;
+    case FusedElementwiseOp::Abs:
+      ComputeUnary(a, dst, count, dst_scalar, [](float x) { return std::abs(x); });
+      break;
+    case FusedElementwiseOp::Sqrt:
+      ComputeUnary(a, dst, count, dst_scalar, [](float x) { return std::sqrt(x); });
+      break;
+    case FusedElementwiseOp::Reciprocal:
+      ComputeUnary(a, dst, count, dst_scalar, [](float x) { return 1.0f / x; });
+      break;
+    case FusedElementwiseOp::Log:
+      ComputeUnary(a, dst, count, dst_scalar, [](float x) { return std::log(x); });
+      break;
+    case FusedElementwiseOp::Sigmoid:
+      dst_scalar = a.scalar;
+      MlasComputeLogistic(a.data, dst, a.scalar ? 1 : count);
+      break;
+    case FusedElementwiseOp::Tanh:
+      dst_scalar = a.scalar;
+      MlasComputeTanh(a.data, dst, a.scalar ? 1 : count);
+      break;
+    case FusedElementwiseOp::Exp:
+      dst_scalar = a.scalar;
+      MlasComputeExp(a.data, dst, a.scalar ? 1 : count);
+      break;
+    case FusedElementwiseOp::Erf:
+      dst_scalar = a.scalar;
+      MlasComputeErf(a.data, dst, a.scalar ? 1 : count);
+      break;
+  }
+}
+
+// Approximate cost in cycles of a step per element, used to size the parallel work units.
+double StepCost(FusedElementwiseOp op) {
+  switch (op) {
+    case FusedElementwiseOp::Sigmoid:
+    case FusedElementwiseOp::Tanh:
+    case FusedElementwiseOp::Exp:
+    case FusedElementwiseOp::Erf:
+    case FusedElementwiseOp::Log:
+    case FusedElementwiseOp::Pow:
+      return 8.0;
+    case FusedElementwiseOp::Div:
+    case FusedElementwiseOp::Sqrt:
+    case FusedElementwiseOp::Reciprocal:
+      return 4.0;
+    default:
+      return 1.0;
+  }
+}
+
+}  // namespace
+
+Status FusedElementwise::Compute(OpKernelContext* context) const {
+  const int num_inputs = context->InputCount();
+
+  // Compute the broadcast output shape.
+  size_t output_rank = 0;
+  for (int i = 0; i < num_inputs; ++i) {
+    output_rank = std::max(output_rank, context->Input<Tensor>(i)->Shape().NumDimensions());
+  }
+
+  std::vector<int64_t> output_dims(output_rank, 1);
+  for (int i = 0; i < num_inputs; ++i) {
+    const auto& shape = context->Input<Tensor>(i)->Shape();
+    const size_t offset = output_rank - shape.NumDimensions();
+    for (size_t d = 0; d < shape.NumDimensions(); ++d) {
+      const int64_t dim = shape[d];
+      int64_t& output_dim = output_dims[offset + d];
+      if (dim != 1) {
+        ORT_RETURN_IF_NOT(output_dim == 1 || output_dim == dim,
+                          "FusedElementwise: input ", i, " is not broadcast compatible: ", shape);
+        output_dim = dim;
+      }
+    }
+  }
+
+  TensorShape output_shape(output_dims);
+  Tensor* output = context->Output(0, output_shape);
+  const int64_t output_size = output_shape.Size();
+  if (output_size == 0) {
+    return Status::OK();
+  }
+
+  // Classify how each input maps onto the flattened output.
+  std::vector<InputInfo> inputs;
+  inputs.reserve(num_inputs);
+  size_t num_suffix_inputs = 0;
+  double bytes_loaded = 0;
+  for (int i = 0; i < num_inputs; ++i) {
+    const auto* tensor = context->Input<Tensor>(i);
+    const auto& shape = tensor->Shape();
+    const int64_t size = shape.Size();
+
+    InputInfo input{tensor->Data<float>(), InputKind::Full, size};
+    if (size == 1) {
+      input.kind = InputKind::Scalar;
+    } else if (size == output_size) {
+      input.kind = InputKind::Full;
+      bytes_loaded += sizeof(float);
+    } else {
+      // ignoring leading 1s, the input dims must equal the trailing output dims
+      size_t first = 0;
+      while (first < shape.NumDimensions() && shape[first] == 1) {
+        ++first;
+      }
+      const size_t suffix_rank = shape.NumDimensions() - first;
+      for (size_t d = 0; d < suffix_rank; ++d) {
+        ORT_RETURN_IF_NOT(shape[first + d] == output_dims[output_rank - suffix_rank + d],
+                          "FusedElementwise: input ", i, " with shape ", shape,
+                          " must match the trailing dimensions of the output shape ", output_shape);
+      }
+      input.kind = InputKind::Suffix;
+      ++num_suffix_inputs;
+      bytes_loaded += sizeof(float);
+    }
+
+    inputs.push_back(input);
+  }
+
+  double compute_cycles = 0;
+  for (const auto& step : steps_) {
+    compute_cycles += StepCost(step.op);
+  }
+
+  float* output_data = output->MutableData<float>();
+  const std::ptrdiff_t block_count = static_cast<std::ptrdiff_t>((output_size + kBlockSize - 1) / kBlockSize);
+  const TensorOpCost block_cost{bytes_loaded * kBlockSize, static_cast<double>(sizeof(float) * kBlockSize),
+                                compute_cycles * kBlockSize};
+
+  concurrency::ThreadPool::TryParallelFor(
+      context->GetOperatorThreadPool(), block_count, block_cost,
+      [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+        float registers[kMaxSteps][kBlockSize];
+        bool register_scalar[kMaxSteps];
+        std::vector<float> suffix_buffer(num_suffix_inputs * kBlockSize);
+        std::vector<Operand> input_operands(inputs.size());
+
+        for (std::ptrdiff_t block = first; block < last; ++block) {
+          const int64_t start = static_cast<int64_t>(block) * static_cast<int64_t>(kBlockSize);
+          const size_t count = static_cast<size_t>(std::min<int64_t>(kBlockSize, output_size - start));
+
+          // Resolve the inputs for this block.
+          size_t suffix_index = 0;
+          for (size_t i = 0; i < inputs.size(); ++i) {
+            const auto& input = inputs[i];
+            switch (input.kind) {
+              case InputKind::Full:
+                input_operands[i] = Operand{input.data + start, false};
+                break;
+              case InputKind::Scalar:
+                input_operands[i] = Operand{input.data, true};
+                break;
+              case InputKind::Suffix: {
+                float* buffer = suffix_buffer.data() + suffix_index++ * kBlockSize;
+                int64_t position = start % input.period;
+                size_t filled = 0;
+                while (filled < count) {
+                  const size_t chunk = static_cast<size_t>(
+                      std::min<int64_t>(static_cast<int64_t>(count - filled), input.period - position));
+                  std::copy_n(input.data + position, chunk, buffer + filled);
+                  filled += chunk;
+                  position = 0;
+                }
+                input_operands[i] = Operand{buffer, false};
+              } break;
+            }
+          }
+
+          auto resolve = [&](int64_t index) {
+            if (index < static_cast<int64_t>(inputs.size())) {
+              return input_operands[static_cast<size_t>(index)];
+            }
+            const size_t reg = static_cast<size_t>(index) - inputs.size();
+            return Operand{registers[reg], register_scalar[reg]};
+          };
+
+          // Interpret the program over the block. The final step writes directly to the output.
+          const size_t last_step = steps_.size() - 1;
+          for (size_t s = 0; s < steps_.size(); ++s) {
+            const auto& step = steps_[s];
+            const Operand a = resolve(step.operand_a);
+            const Operand b = step.operand_b >= 0 ? resolve(step.operand_b) : Operand{nullptr, true};
+            float* dst = (s == last_step) ? output_data + start : registers[s];
+            ComputeStep(step.op, a, b, dst, count, register_scalar[s]);
+          }
+
+          if (register_scalar[last_step]) {
+            std::fill_n(output_data + start + 1, count - 1, output_data[start]);
+          }
+        }
+      });
+
+  return Status::OK();
+}
+
+}  // namespace contrib
+}  // namespace onnxruntime
@@ -0,0 +1,68 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include "core/common/common.h"
+#include "core/framework/op_kernel.h"
+
+namespace onnxruntime {
+namespace contrib {
+
+// Elementwise operators that can be evaluated by FusedElementwise.
+enum class FusedElementwiseOp : int32_t {
+  Add,
+  Sub,
+  Mul,
+  Div,
+  Max,
+  Min,
+  Pow,
+  Relu,
+  Sigmoid,
+  Tanh,
+  Exp,
+  Log,
+  Neg,
+  Abs,
+  Sqrt,
+  Reciprocal,
+  Erf,
+};
+
+// Returns true and sets op if op_type names an operator supported by FusedElementwise.
+bool TryParseFusedElementwiseOp(const std::string& op_type, FusedElementwiseOp& op);
+
+// Returns true if op takes two operands.
+bool IsBinaryFusedElementwiseOp(FusedElementwiseOp op);
+
+/**
+FusedElementwise evaluates a chain of elementwise operators produced by ElementwiseFusion.
+The output is processed in blocks small enough to stay in L1 cache. For each block, every
+step of the program is interpreted once over the whole block so the per-element cost is a
+tight vectorizable loop and the intermediate results never leave the cache.
+*/
+class FusedElementwise final : public OpKernel {
+ public:
+  // Maximum number of steps in a single fused program.
+  static constexpr size_t kMaxSteps = 16;
+
+  // Number of elements processed per step before moving to the next step.
+  static constexpr size_t kBlockSize = 256;
+
+  FusedElementwise(const OpKernelInfo& info);
+
+  Status Compute(OpKernelContext* context) const override;
+
+ private:
+  struct Step {
+    FusedElementwiseOp op;
+    int64_t operand_a;
+    int64_t operand_b;
+  };
+
+  std::vector<Step> steps_;
+};
+
+}  // namespace contrib
+}  // namespace onnxruntime
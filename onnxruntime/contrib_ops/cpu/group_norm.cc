@@ -0,0 +1,55 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "contrib_ops/cpu/group_norm.h"
+#include "core/providers/cpu/nn/instance_norm_helper.h"
+
+namespace onnxruntime {
+namespace contrib {
+
+ONNX_CPU_OPERATOR_TYPED_MS_KERNEL(
+    GroupNorm,
+    1,
+    float,
+    KernelDefBuilder()
+        .TypeConstraint("T", DataTypeImpl::GetTensorType<float>()),
+    GroupNorm);
+
+Status GroupNorm::Compute(OpKernelContext* context) const {
+  const auto* X = context->Input<Tensor>(0);
+  const auto* gamma = context->Input<Tensor>(1);
+  const auto* beta = context->Input<Tensor>(2);
+
+  // The per channel scale and bias are validated the same way as InstanceNormalization.
+  ORT_RETURN_IF_ERROR(InstanceNormHelper::ValidateInputs(X, gamma, beta));
+
+  const auto& X_shape = X->Shape();
+  const int64_t N = X_shape[0];
+  const int64_t C = X_shape[1];
+  const int64_t spatial_size = X_shape.SizeFromDimension(2);
+
+  if (C % groups_ != 0) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT,
+                           "Number of channels ", C, " is not divisible by the number of groups ", groups_);
+  }
+
+  Tensor* Y = context->Output(0, X_shape);
+
+  MlasComputeGroupNorm(X->Data<float>(),
+                       gamma->Data<float>(),
+                       beta->Data<float>(),
+                       Y->MutableData<float>(),
+                       static_cast<size_t>(N),
+                       static_cast<size_t>(C),
+                       1,
+                       static_cast<size_t>(spatial_size),
+                       static_cast<size_t>(groups_),
+                       epsilon_,
+                       &activation_,
+                       context->GetOperatorThreadPool());
+
+  return Status::OK();
+}
+
+}  // namespace contrib
+}  // namespace onnxruntime
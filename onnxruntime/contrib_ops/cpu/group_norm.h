@@ -0,0 +1,31 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include "core/common/common.h"
+#include "core/framework/op_kernel.h"
+#include "contrib_ops/cpu/fused_activation.h"
+
+namespace onnxruntime {
+namespace contrib {
+
+class GroupNorm final : public OpKernel {
+ public:
+  GroupNorm(const OpKernelInfo& info) : OpKernel(info) {
+    epsilon_ = info.GetAttrOrDefault<float>("epsilon", 1e-5f);
+    ORT_ENFORCE(info.GetAttr<int64_t>("groups", &groups_).IsOK());
+    ORT_ENFORCE(groups_ > 0, "groups must be positive");
+    ORT_ENFORCE(GetFusedActivationAttr(info, activation_).IsOK());
+  }
+
+  Status Compute(OpKernelContext* context) const override;
+
+ private:
+  float epsilon_;
+  int64_t groups_;
+  MLAS_ACTIVATION activation_;
+};
+
+}  // namespace contrib
+}  // namespace onnxruntime
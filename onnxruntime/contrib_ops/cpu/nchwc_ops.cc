@@ -252,6 +252,43 @@ Status NchwcAveragePool::Compute(OpKernelContext* context) const {
                                                                          : MlasAveragePoolingExcludePad);
 }
 
+Status NchwcGroupNorm::Compute(OpKernelContext* context) const {
+  const auto* X = context->Input<Tensor>(0);
+  const auto* gamma = context->Input<Tensor>(1);
+  const auto* beta = context->Input<Tensor>(2);
+
+  const auto& X_shape = X->Shape();
+  ORT_ENFORCE(X_shape.NumDimensions() == 4);
+
+  const int64_t nchwc_block_size = static_cast<int64_t>(MlasNchwcGetBlockSize());
+  const int64_t channels = X_shape[1];
+  ORT_ENFORCE((channels % nchwc_block_size) == 0);
+  ORT_ENFORCE(gamma->Shape().Size() == channels && beta->Shape().Size() == channels);
+
+  // Each group must span whole channel blocks or fit inside a single channel block.
+  ORT_ENFORCE((channels % groups_) == 0);
+  const int64_t channels_per_group = channels / groups_;
+  ORT_ENFORCE((channels_per_group % nchwc_block_size) == 0 || (nchwc_block_size % channels_per_group) == 0);
+
+  auto* Y = context->Output(0, X_shape);
+
+  MlasComputeGroupNorm(
+      X->template Data<float>(),
+      gamma->template Data<float>(),
+      beta->template Data<float>(),
+      Y->template MutableData<float>(),
+      static_cast<size_t>(X_shape[0]),
+      static_cast<size_t>(channels),
+      static_cast<size_t>(nchwc_block_size),
+      static_cast<size_t>(X_shape.SizeFromDimension(2)),
+      static_cast<size_t>(groups_),
+      epsilon_,
+      &activation_,
+      context->GetOperatorThreadPool());
+
+  return Status::OK();
+}
+
 std::vector<float> NchwcUpsample::ComputeInterpolation(int64_t input_length,
                                                        int64_t output_length,
                                                        int64_t scale) const {
@@ -442,5 +479,14 @@ ONNX_CPU_OPERATOR_TYPED_NCHWC_KERNEL(
         .TypeConstraint("T", DataTypeImpl::GetTensorType<float>()),
     NchwcUpsample);
 
+ONNX_CPU_OPERATOR_TYPED_NCHWC_KERNEL(
+    GroupNorm,
+    1,
+    float,
+    KernelDefBuilder()
+        .MayInplace(0, 0)
+        .TypeConstraint("T", DataTypeImpl::GetTensorType<float>()),
+    NchwcGroupNorm);
+
 }  // namespace contrib
 }  // namespace onnxruntime
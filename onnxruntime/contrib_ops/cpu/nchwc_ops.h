@@ -80,6 +80,23 @@ class NchwcAveragePool final : public OpKernel, public NchwcPoolBase {
   Status Compute(OpKernelContext* context) const override;
 };
 
+class NchwcGroupNorm final : public OpKernel {
+ public:
+  NchwcGroupNorm(const OpKernelInfo& info) : OpKernel(info) {
+    ORT_ENFORCE(info.GetAttr<float>("epsilon", &epsilon_).IsOK());
+    ORT_ENFORCE(info.GetAttr<int64_t>("groups", &groups_).IsOK());
+    ORT_ENFORCE(groups_ > 0, "groups must be positive");
+    ORT_ENFORCE(GetFusedActivationAttr(info, activation_).IsOK());
+  }
+
+  Status Compute(OpKernelContext* context) const override;
+
+ private:
+  float epsilon_;
+  int64_t groups_;
+  MLAS_ACTIVATION activation_;
+};
+
 class NchwcUpsample final : public OpKernel {
  private:
   enum class TransformationMode {
@@ -1,7 +1,9 @@
 // Copyright (c) Microsoft Corporation. All rights reserved.
 // Licensed under the MIT License.
 
+#include "core/common/safeint.h"
 #include "core/framework/tensor.h"
+#include "core/mlas/inc/mlas.h"
 #include "core/util/math_cpuonly.h"
 #include "core/providers/common.h"
 #include "core/platform/threadpool.h"
@@ -90,6 +92,13 @@ Status SkipLayerNorm<T>::Compute(OpKernelContext* p_ctx) const {
   int64_t hidden_size = input_dims[2];
   int64_t task_count = batch_size * sequence_length;
 
+  // Optional outputs: the statistics of each row and the sum of input, skip and bias
+  // (which is the input of the next residual connection in the model)
+  std::vector<int64_t> statistics_dims{batch_size, sequence_length, 1};
+  Tensor* mean = p_ctx->Output(1, TensorShape(statistics_dims));
+  Tensor* inv_std_var = p_ctx->Output(2, TensorShape(statistics_dims));
+  Tensor* input_skip_bias_sum = p_ctx->Output(3, input->Shape());
+
   const T* input_data = input->Data<T>();
   const T* skip_data = skip->Data<T>();
   const T* gamma_data = gamma->Data<T>();
@@ -97,37 +106,59 @@ Status SkipLayerNorm<T>::Compute(OpKernelContext* p_ctx) const {
   const T* bias_data = bias == nullptr ? nullptr : bias->Data<T>();
 
   T* output_data = output->MutableData<T>();
+  float* mean_data = mean == nullptr ? nullptr : mean->MutableData<float>();
+  float* inv_std_var_data = inv_std_var == nullptr ? nullptr : inv_std_var->MutableData<float>();
+  T* input_skip_bias_sum_data = input_skip_bias_sum == nullptr ? nullptr : input_skip_bias_sum->MutableData<T>();
+
+  if constexpr (std::is_same<T, float>::value) {
+    MlasComputeLayerNorm(input_data, skip_data, bias_data, gamma_data, beta_data, output_data,
+                         input_skip_bias_sum_data, mean_data, inv_std_var_data,
+                         static_cast<size_t>(task_count), static_cast<size_t>(hidden_size), epsilon_,
+                         false, p_ctx->GetOperatorThreadPool());
+  } else {
+    concurrency::ThreadPool::TryBatchParallelFor(p_ctx->GetOperatorThreadPool(), static_cast<int32_t>(task_count),
+                                                 [&](ptrdiff_t task_idx) {
+                                                   const T* p_input = input_data + task_idx * hidden_size;
+                                                   const T* p_skip = skip_data + task_idx * hidden_size;
+                                                   T* p_output = output_data + task_idx * hidden_size;
+
+                                                   T mean = 0;
+                                                   T mean_square = 0;
+
+                                                   for (int64_t h = 0; h < hidden_size; h++) {
+                                                     T value = p_input[h] + p_skip[h];
+                                                     if (nullptr != bias_data) {
+                                                       value += bias_data[h];
+                                                     }
+                                                     p_output[h] = value;
+                                                     mean += value;
+                                                     mean_square += value * value;
+                                                   }
+
+                                                   if (nullptr != input_skip_bias_sum_data) {
+                                                     memcpy(input_skip_bias_sum_data + task_idx * hidden_size, p_output,
+                                                            SafeInt<size_t>(hidden_size) * sizeof(T));
+                                                   }
 
-  concurrency::ThreadPool::TryBatchParallelFor(p_ctx->GetOperatorThreadPool(), static_cast<int32_t>(task_count),
-                                               [&](ptrdiff_t task_idx) {
-                                                 const T* p_input = input_data + task_idx * hidden_size;
-                                                 const T* p_skip = skip_data + task_idx * hidden_size;
-                                                 T* p_output = output_data + task_idx * hidden_size;
+                                                   mean = mean / hidden_size;
+                                                   mean_square = sqrt(mean_square / hidden_size - mean * mean + epsilon_);
 
-                                                 T mean = 0;
-                                                 T mean_square = 0;
+                                                   for (int64_t h = 0; h < hidden_size; h++) {
+                                                     if (nullptr == beta_data) {
+                                                       p_output[h] = (p_output[h] - mean) / mean_square * gamma_data[h];
+                                                     } else {
+                                                       p_output[h] = (p_output[h] - mean) / mean_square * gamma_data[h] + beta_data[h];
+                                                     }
+                                                   }
 
-                                                 for (int64_t h = 0; h < hidden_size; h++) {
-                                                   T value = p_input[h] + p_skip[h];
-                                                   if (nullptr != bias_data) {
-                                                     value += bias_data[h];
+                                                   if (nullptr != mean_data) {
+                                                     mean_data[task_idx] = static_cast<float>(mean);
                                                    }
-                                                   p_output[h] = value;
-                                                   mean += value;
-                                                   mean_square += value * value;
-                                                 }
-
-                                                 mean = mean / hidden_size;
-                                                 mean_square = sqrt(mean_square / hidden_size - mean * mean + epsilon_);
-
-                                                 for (int64_t h = 0; h < hidden_size; h++) {
-                                                   if (nullptr == beta_data) {
-                                                     p_output[h] = (p_output[h] - mean) / mean_square * gamma_data[h];
-                                                   } else {
-                                                     p_output[h] = (p_output[h] - mean) / mean_square * gamma_data[h] + beta_data[h];
+                                                   if (nullptr != inv_std_var_data) {
+                                                     inv_std_var_data[task_idx] = static_cast<float>(1 / mean_square);
                                                    }
-                                                 }
-                                               }, 0);
+                                                 }, 0);
+  }
 
   return Status::OK();
 }
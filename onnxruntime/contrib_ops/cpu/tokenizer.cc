@@ -5,11 +5,20 @@
 #include "core/common/utf8_util.h"
 #include "core/framework/tensor.h"
 #include "core/framework/op_kernel.h"
+#include "core/framework/string_tensor_view.h"
+#include "core/platform/threadpool.h"
+#include "core/providers/cpu/containers.h"
 #include "re2/re2.h"
 
 namespace onnxruntime {
 namespace contrib {
 
+namespace tokenizer_details {
+struct TokenRows;
+}  // namespace tokenizer_details
+
+using tokenizer_details::TokenRows;
+
 class Tokenizer final : public OpKernel {
  public:
   explicit Tokenizer(const OpKernelInfo& info);
@@ -20,15 +29,13 @@ class Tokenizer final : public OpKernel {
   Status Compute(OpKernelContext* context) const override;
 
  private:
-  Status CharTokenize(OpKernelContext* context, size_t N, size_t C,
-                      const std::vector<int64_t>& input_dims) const;
+  // Each function validates and tokenizes the input strings [first, last) into `rows`.
+  Status CharTokenize(const StringTensorView& input, size_t first, size_t last, TokenRows& rows) const;
 
-  Status SeparatorExpressionTokenizer(OpKernelContext* context, size_t N, size_t C,
-                                      const std::vector<int64_t>& input_dims) const;
+  Status SeparatorExpressionTokenizer(const StringTensorView& input, size_t first, size_t last,
+                                      TokenRows& rows) const;
 
-  Status TokenExpression(OpKernelContext* ctx,
-                         size_t N, size_t C,
-                         const std::vector<int64_t>& input_dims) const;
+  Status TokenExpression(const StringTensorView& input, size_t first, size_t last, TokenRows& rows) const;
 
   bool mark_{false};
   std::string pad_value_;
@@ -51,6 +58,77 @@ ONNX_CPU_OPERATOR_TYPED_MS_KERNEL(
 namespace tokenizer_details {
 const char start_text = 0x2;
 const char end_text = 0x3;
+
+// Strings are tokenized in blocks of consecutive strings of at least this many bytes. Smaller blocks take less time
+// than handing them to another thread of the pool. Same block size as StringNormalizer.
+constexpr size_t kMinBytesPerBlock = 8 * 1024;
+
+// Tokens of a block of input strings, stored one row after the other: the tokens of
+// row i are [row_ends[i - 1], row_ends[i]). The tokens point into the input strings.
+// The character tokenizer only validates the strings and counts their tokens.
+struct TokenRows {
+  explicit TokenRows(OpKernelContext& ctx) : tokens(GetAllocator<re2::StringPiece>(ctx)) {}
+
+  FastAllocVector<re2::StringPiece> tokens;
+  std::vector<size_t> row_ends;
+  size_t max_tokens = 0;
+  Status status;
+};
+
+// Writes every row of tokens followed by its padding, optionally between start/end markers.
+void OutputTokenRows(const TokenRows& rows, bool mark, const std::string& pad_value,
+                     size_t max_tokens, std::string* output_data) {
+  size_t token_index = 0;
+  for (const size_t row_end : rows.row_ends) {
+    std::string* output = output_data;
+    if (mark) {
+      (output++)->assign(&start_text, 1);
+    }
+    for (; token_index < row_end; ++token_index) {
+      const auto& token = rows.tokens[token_index];
+      (output++)->assign(token.data(), token.size());
+    }
+    if (mark) {
+      (output++)->assign(&end_text, 1);
+    }
+    assert(output <= output_data + max_tokens);
+    for (; output < output_data + max_tokens; ++output) {
+      *output = pad_value;
+    }
+    output_data += max_tokens;
+  }
+}
+
+// Writes every utf8 character of the input strings [first, last) as a token followed by the padding,
+// optionally between start/end markers.
+void OutputCharRows(const StringTensorView& input, size_t first, size_t last, bool mark,
+                    const std::string& pad_value, size_t max_tokens, std::string* output_data) {
+  for (; first != last; ++first) {
+    const std::string_view s = input[first];
+    std::string* output = output_data;
+    if (mark) {
+      (output++)->assign(&start_text, 1);
+    }
+    const size_t str_len = s.size();
+    for (size_t token_idx = 0; token_idx < str_len;) {
+      size_t tlen = 0;
+      bool result = utf8_util::utf8_bytes(static_cast<unsigned char>(s[token_idx]), tlen);
+      assert(result);
+      (void)result;
+      assert(token_idx + tlen <= str_len);
+      (output++)->assign(s.data() + token_idx, tlen);
+      token_idx += tlen;
+    }
+    if (mark) {
+      (output++)->assign(&end_text, 1);
+    }
+    assert(output <= output_data + max_tokens);
+    for (; output < output_data + max_tokens; ++output) {
+      *output = pad_value;
+    }
+    output_data += max_tokens;
+  }
+}
 }  // namespace tokenizer_details
 
 using namespace tokenizer_details;
@@ -113,88 +191,31 @@ Tokenizer::Tokenizer(const OpKernelInfo& info) : OpKernel(info) {
   }
 }
 
-Status Tokenizer::CharTokenize(OpKernelContext* ctx, size_t N, size_t C,
-                               const std::vector<int64_t>& input_dims) const {
+Status Tokenizer::CharTokenize(const StringTensorView& input, size_t first, size_t last, TokenRows& rows) const {
   // With char tokenzation we get as many tokens as the number of
-  // utf8 characters in the string. So for every string we calculate its character(utf8) length
-  // add padding and add start/end test separators if necessary
-  size_t max_tokens = 0;
-  auto X = ctx->Input<Tensor>(0);
-  auto const input_data = X->template Data<std::string>();
-  auto curr_input = input_data;
-  auto const last = input_data + N * C;
-  while (curr_input != last) {
-    const auto& s = *curr_input;
+  // utf8 characters in the string. The characters are split when
+  // the output is written.
+  for (; first != last; ++first) {
+    const std::string_view s = input[first];
     size_t tokens = 0;  // length in utf8 chars
     if (!utf8_validate(reinterpret_cast<const unsigned char*>(s.data()), s.size(),
                        tokens)) {
       return Status(common::ONNXRUNTIME, common::INVALID_ARGUMENT,
-                    "Input string contains invalid utf8 chars: " + s);
-    }
-    max_tokens = std::max(max_tokens, tokens);
-    ++curr_input;
-  }
-
-  std::vector<int64_t> output_dims(input_dims);
-  // Check if we have no output due to apparently empty strings input.
-  if (max_tokens == 0) {
-    output_dims.push_back(0);
-    TensorShape output_shape(output_dims);
-    ctx->Output(0, output_shape);
-    return Status::OK();
-  }
-
-  if (mark_) {
-    max_tokens += 2;  // Start/end markers as separate tokens
-  }
-
-  output_dims.push_back(max_tokens);
-  TensorShape output_shape(output_dims);
-  auto output_tensor = ctx->Output(0, output_shape);
-  auto const output_data = output_tensor->template MutableData<std::string>();
-  size_t output_index = 0;
-  curr_input = input_data;
-  while (curr_input != last) {
-    const auto& s = *curr_input;
-    if (mark_) {
-      (output_data + output_index)->assign(&start_text, 1);
-      ++output_index;
+                    "Input string contains invalid utf8 chars: " + std::string(s));
     }
-    size_t tokens = 0;
-    const size_t str_len = s.size();
-    for (size_t token_idx = 0; token_idx < str_len;) {
-      size_t tlen = 0;
-      bool result = utf8_bytes(static_cast<unsigned char>(s[token_idx]), tlen);
-      assert(result);
-      (void)result;
-      assert(token_idx + tlen <= str_len);
-      *(output_data + output_index) = s.substr(token_idx, tlen);
-      ++output_index;
-      token_idx += tlen;
-      ++tokens;
-    }
-    if (mark_) {
-      (output_data + output_index)->assign(&end_text, 1);
-      ++output_index;
-    }
-    // Padding strings
-    assert(tokens + (mark_ * 2) <= max_tokens);
-    const size_t pads = max_tokens - (mark_ * 2) - tokens;
-    for (size_t p = 0; p < pads; ++p) {
-      *(output_data + output_index) = pad_value_;
-      ++output_index;
-    }
-    ++curr_input;
+    rows.max_tokens = std::max(rows.max_tokens, tokens);
   }
   return Status::OK();
 }
 
-Status Tokenizer::SeparatorExpressionTokenizer(OpKernelContext* ctx,
-                                               size_t N, size_t C,
-                                               const std::vector<int64_t>& input_dims) const {
+Status Tokenizer::SeparatorExpressionTokenizer(const StringTensorView& input, size_t first, size_t last,
+                                               TokenRows& rows) const {
   using namespace re2;
-  std::vector<std::vector<StringPiece>> rows;
-  rows.reserve(N * C);
+  rows.row_ends.reserve(last - first);
+
+  // Tokens of the current string, split by the separators one after the other.
+  std::vector<StringPiece> row;
+  std::vector<StringPiece> tokens;
 
   // We do not constraint the search to match
   // on the beginning or end of the string
@@ -202,24 +223,19 @@ Status Tokenizer::SeparatorExpressionTokenizer(OpKernelContext* ctx,
 
   // Scan all strings and attempt to find separators in them
   // collect all the output tokens here
-  size_t max_tokens = 0;
-  auto X = ctx->Input<Tensor>(0);
-  auto const input_data = X->template Data<std::string>();
-  auto curr_input = input_data;
-  auto const last = input_data + N * C;
-  while (curr_input != last) {
-    const auto& s = *curr_input;
+  for (auto curr_input = first; curr_input != last; ++curr_input) {
+    const std::string_view s = input[curr_input];
     size_t utf8_chars = 0;  // length in utf8 chars
     if (!utf8_validate(reinterpret_cast<const unsigned char*>(s.data()), s.size(),
                        utf8_chars)) {
       return Status(common::ONNXRUNTIME, common::INVALID_ARGUMENT,
-                    "Input string contains invalid utf8 chars: " + s);
+                    "Input string contains invalid utf8 chars: " + std::string(s));
     }
 
-    std::vector<StringPiece> row{s};
+    row.assign(1, StringPiece(s.data(), s.size()));
 
     for (const auto& sep : separators_) {
-      std::vector<StringPiece> tokens;
+      tokens.clear();
       for (const auto& text : row) {
         const auto end_pos = text.length();
         size_t start_pos = 0;
@@ -269,100 +285,35 @@ Status Tokenizer::SeparatorExpressionTokenizer(OpKernelContext* ctx,
       // Replace the row with the results of this tokenezation
       row.swap(tokens);
     }  // separators_
-    max_tokens = std::max(max_tokens, row.size());
-    rows.push_back(std::move(row));
-    ++curr_input;
-  }
-
-  std::vector<int64_t> output_dims(input_dims);
-  // Check if we have no output due to either empty input
-  // everything is a separator
-  if (max_tokens == 0) {
-    output_dims.push_back(0);
-    TensorShape output_shape(output_dims);
-    ctx->Output(0, output_shape);
-    return Status::OK();
-  }
-
-  if (mark_) {
-    max_tokens += 2;  // Start/end markers as separate tokens
-  }
-
-  output_dims.push_back(max_tokens);
-  TensorShape output_shape(output_dims);
-
-  auto output_tensor = ctx->Output(0, output_shape);
-  auto const output_data = output_tensor->template MutableData<std::string>();
-
-#ifdef _DEBUG
-  const size_t max_output_index = N * C * max_tokens;
-#endif
-  size_t output_index = 0;
-  curr_input = input_data;
-  for (auto& row : rows) {
-#ifdef _DEBUG
-    size_t c_idx = output_index;
-#endif
-    if (mark_) {
-      (output_data + output_index)->assign(&start_text, 1);
-      ++output_index;
-    }
-    // Output tokens for this row
-    for (const auto& token : row) {
-      (output_data + output_index)->assign(token.data(), token.size());
-      ++output_index;
-    }
-    if (mark_) {
-      (output_data + output_index)->assign(&end_text, 1);
-      ++output_index;
-    }
-    const size_t pads = max_tokens - (mark_ * 2) - row.size();
-    for (size_t p = 0; p < pads; ++p) {
-      *(output_data + output_index) = pad_value_;
-      ++output_index;
-    }
-#ifdef _DEBUG
-    assert(output_index <= max_output_index);
-    assert((output_index - c_idx) <= max_tokens);
-#endif
-    ++curr_input;
+    rows.max_tokens = std::max(rows.max_tokens, row.size());
+    rows.tokens.insert(rows.tokens.end(), row.cbegin(), row.cend());
+    rows.row_ends.push_back(rows.tokens.size());
   }
   return Status::OK();
 }
 
-Status Tokenizer::TokenExpression(OpKernelContext* ctx,
-                                  size_t N, size_t C,
-                                  const std::vector<int64_t>& input_dims) const {
+Status Tokenizer::TokenExpression(const StringTensorView& input, size_t first, size_t last,
+                                  TokenRows& rows) const {
   using namespace re2;
-  // Represents a token that will be output after
-  // first is the index, second is the size;
-  std::vector<std::vector<StringPiece>> tokens;
-  tokens.reserve(N * C);
-
-  size_t max_tokens = 0;
-  auto X = ctx->Input<Tensor>(0);
-  auto const input_data = X->template Data<std::string>();
-  auto curr_input = input_data;
-  auto const last = input_data + N * C;
+  rows.row_ends.reserve(last - first);
 
   // We do not constraint the search to match
   // on the beginning or end of the string
   const RE2::Anchor anchor = RE2::UNANCHORED;
 
-  while (curr_input != last) {
-    const auto& s = *curr_input;
+  for (auto curr_input = first; curr_input != last; ++curr_input) {
+    const std::string_view s = input[curr_input];
 
     size_t utf8_chars = 0;
     if (!utf8_validate(reinterpret_cast<const unsigned char*>(s.data()), s.size(),
                        utf8_chars)) {
       return Status(common::ONNXRUNTIME, common::INVALID_ARGUMENT,
-                    "Input string contains invalid utf8 chars: " + s);
+                    "Input string contains invalid utf8 chars: " + std::string(s));
     }
 
-    tokens.emplace_back();
-    auto& row = tokens.back();
+    const size_t row_start = rows.tokens.size();
 
-    StringPiece text(s);
+    StringPiece text(s.data(), s.size());
     const auto end_pos = s.length();
     size_t start_pos = 0;
     StringPiece submatch;
@@ -384,7 +335,7 @@ Status Tokenizer::TokenExpression(OpKernelContext* ctx,
                         "Match contains invalid utf8 chars: " + submatch.as_string());
         }
         if (utf8_chars >= size_t(mincharnum_)) {
-          row.push_back(submatch);
+          rows.tokens.push_back(submatch);
           start_pos = match_pos + token_len;
         } else {
           size_t bytes = 0;
@@ -393,66 +344,9 @@ Status Tokenizer::TokenExpression(OpKernelContext* ctx,
         }
       }
     } while (match);
-    max_tokens = std::max(max_tokens, row.size());
-    ++curr_input;
-  }
-
-  // Check for empty output
-  std::vector<int64_t> output_dims(input_dims);
-  // Check if we have no output due to either empty input
-  // everything is a separator
-  if (max_tokens == 0) {
-    output_dims.push_back(0);
-    TensorShape output_shape(output_dims);
-    ctx->Output(0, output_shape);
-    return Status::OK();
-  }
-
-  if (mark_) {
-    max_tokens += 2;  // Start/end markers as separate tokens
-  }
-
-  output_dims.push_back(max_tokens);
-  TensorShape output_shape(output_dims);
-
-  auto output_tensor = ctx->Output(0, output_shape);
-  auto const output_data = output_tensor->template MutableData<std::string>();
-
-#ifdef _DEBUG
-  const size_t max_output_index = N * C * max_tokens;
-#endif
-  curr_input = input_data;
-  size_t output_index = 0;
-  for (const auto& row : tokens) {
-    assert(curr_input != last);
-#ifdef _DEBUG
-    size_t c_idx = output_index;
-#endif
-    if (mark_) {
-      (output_data + output_index)->assign(&start_text, 1);
-      ++output_index;
-    }
-    // Output tokens for this row
-    for (const auto& token : row) {
-      (output_data + output_index)->assign(token.data(), token.length());
-      ++output_index;
-    }
-    if (mark_) {
-      (output_data + output_index)->assign(&end_text, 1);
-      ++output_index;
-    }
-    const size_t pads = max_tokens - (mark_ * 2) - row.size();
-    for (size_t p = 0; p < pads; ++p) {
-      *(output_data + output_index) = pad_value_;
-      ++output_index;
-    }
-#ifdef _DEBUG
-    assert(output_index <= max_output_index);
-    assert((output_index - c_idx) <= max_tokens);
-#endif
-    ++curr_input;
+    rows.max_tokens = std::max(rows.max_tokens, rows.tokens.size() - row_start);
+    rows.row_ends.push_back(rows.tokens.size());
   }
-
   return Status::OK();
 }
 
@@ -494,17 +388,75 @@ Status Tokenizer::Compute(OpKernelContext* ctx) const {
     return s;
   }
 
-  if (char_tokenezation_) {
-    s = CharTokenize(ctx, N, C, input_dims);
-  } else {
-    if (!separators_.empty()) {
-      s = SeparatorExpressionTokenizer(ctx, N, C, input_dims);
+  // The strings are tokenized in parallel by blocks of consecutive strings. The first
+  // error, in the order of the strings, is returned.
+  const StringTensorView input(*X);
+  const std::ptrdiff_t total = static_cast<std::ptrdiff_t>(N * C);
+  const size_t total_bytes = input.TotalLength();
+  concurrency::ThreadPool* tp = ctx->GetOperatorThreadPool();
+  const std::ptrdiff_t block_count = std::min<std::ptrdiff_t>(
+      {total,
+       static_cast<std::ptrdiff_t>(total_bytes / kMinBytesPerBlock + 1),
+       static_cast<std::ptrdiff_t>(concurrency::ThreadPool::DegreeOfParallelism(tp))});
+
+  std::vector<TokenRows> blocks;
+  blocks.reserve(block_count);
+  for (std::ptrdiff_t block = 0; block < block_count; ++block) {
+    blocks.emplace_back(*ctx);
+  }
+
+  concurrency::ThreadPool::TrySimpleParallelFor(tp, block_count, [&](std::ptrdiff_t block) {
+    auto work = concurrency::ThreadPool::PartitionWork(block, block_count, total);
+    auto& rows = blocks[block];
+    const auto first = static_cast<size_t>(work.start);
+    const auto last = static_cast<size_t>(work.end);
+    if (char_tokenezation_) {
+      rows.status = CharTokenize(input, first, last, rows);
+    } else if (!separators_.empty()) {
+      rows.status = SeparatorExpressionTokenizer(input, first, last, rows);
     } else {
       assert(regex_ != nullptr);
-      s = TokenExpression(ctx, N, C, input_dims);
+      rows.status = TokenExpression(input, first, last, rows);
     }
+  });
+
+  size_t max_tokens = 0;
+  for (const auto& rows : blocks) {
+    ORT_RETURN_IF_ERROR(rows.status);
+    max_tokens = std::max(max_tokens, rows.max_tokens);
   }
-  return s;
+
+  std::vector<int64_t> output_dims(input_dims);
+  // Check if we have no output due to either empty input
+  // everything is a separator
+  if (max_tokens == 0) {
+    output_dims.push_back(0);
+    TensorShape output_shape(output_dims);
+    ctx->Output(0, output_shape);
+    return Status::OK();
+  }
+
+  if (mark_) {
+    max_tokens += 2;  // Start/end markers as separate tokens
+  }
+
+  output_dims.push_back(max_tokens);
+  TensorShape output_shape(output_dims);
+  auto output_tensor = ctx->Output(0, output_shape);
+  auto const output_data = output_tensor->template MutableData<std::string>();
+
+  // Every block writes its rows directly to their position in the output.
+  concurrency::ThreadPool::TrySimpleParallelFor(tp, block_count, [&](std::ptrdiff_t block) {
+    auto work = concurrency::ThreadPool::PartitionWork(block, block_count, total);
+    std::string* block_output = output_data + work.start * max_tokens;
+    if (char_tokenezation_) {
+      OutputCharRows(input, static_cast<size_t>(work.start), static_cast<size_t>(work.end), mark_, pad_value_,
+                     max_tokens, block_output);
+    } else {
+      OutputTokenRows(blocks[block], mark_, pad_value_, max_tokens, block_output);
+    }
+  });
+  return Status::OK();
 }
 }  // namespace contrib
 }  // namespace onnxruntime
@@ -41,6 +41,9 @@ Status SkipLayerNorm<T>::ComputeInternal(OpKernelContext* ctx) const {
 
   Tensor* output = ctx->Output(0, input->Shape());
 
+  // optional sum of the input, skip and bias, which is the input of the next residual connection
+  Tensor* skip_input_bias_add_output = ctx->Output(3, input->Shape());
+
   const auto& input_dims = input->Shape().GetDims();
   if (input_dims.size() != 3) {
     return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT,
@@ -94,6 +97,7 @@ Status SkipLayerNorm<T>::ComputeInternal(OpKernelContext* ctx) const {
   if (!LaunchSkipLayerNormKernel(
           Stream(),
           output->template MutableData<T>(),
+          skip_input_bias_add_output != nullptr ? skip_input_bias_add_output->template MutableData<T>() : nullptr,
           input->template Data<T>(),
           skip->template Data<T>(),
           gamma->template Data<T>(),
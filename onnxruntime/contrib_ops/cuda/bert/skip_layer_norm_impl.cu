@@ -31,7 +31,7 @@ namespace cuda {
 template <typename T, unsigned TPB>
 __global__ void SkipLayerNormKernelSmall(
     const int ld, const T* input, const T* skip, const T* beta, const T* gamma, const T* bias, 
-    const T epsilon, T* output) {
+    const T epsilon, T* output, T* skip_input_bias_add_output) {
   const T reverse_ld = T(1.f / ld);
   const int offset = blockIdx.x * ld;
 
@@ -45,6 +45,10 @@ __global__ void SkipLayerNormKernelSmall(
     val = (bias == nullptr) ? input[idx] + skip[idx] : input[idx] + skip[idx] + bias[threadIdx.x];
     const T rldval = reverse_ld * val;
     thread_data = pair_sum(thread_data, cub::KeyValuePair<T, T>(rldval, rldval * val));
+
+    if (skip_input_bias_add_output != nullptr) {
+      skip_input_bias_add_output[idx] = val;
+    }
   }
 
   LayerNormSmall<T, TPB>(val, thread_data, ld, idx, beta, gamma, epsilon, output);
@@ -53,7 +57,7 @@ __global__ void SkipLayerNormKernelSmall(
 template <typename T, unsigned TPB>
 __global__ void SkipLayerNormKernel(
     const int ld, const T* input, const T* skip, const T* beta, const T* gamma, const T* bias, 
-    const T epsilon, T* output) {
+    const T epsilon, T* output, T* skip_input_bias_add_output) {
   const T reverse_ld = T(1.f / ld);
   const int offset = blockIdx.x * ld;
 
@@ -66,6 +70,11 @@ __global__ void SkipLayerNormKernel(
     const T val = (bias == nullptr) ? input[idx] + skip[idx] : input[idx] + skip[idx] + bias[i];
     const T rldval = reverse_ld * val;
     thread_data = pair_sum(thread_data, cub::KeyValuePair<T, T>(rldval, rldval * val));
+
+    if (skip_input_bias_add_output != nullptr) {
+      skip_input_bias_add_output[idx] = val;
+    }
+
     output[idx] = val;
   }
 
@@ -75,7 +84,7 @@ __global__ void SkipLayerNormKernel(
 template <typename T>
 bool ComputeSkipLayerNorm(
     cudaStream_t stream, const int ld, const int n, const T* input, const T* skip,
-    const T* beta, const T* gamma, const T* bias, const T epsilon, T* output) {
+    const T* beta, const T* gamma, const T* bias, const T epsilon, T* output, T* skip_input_bias_add_output) {
   // this must be true because n is the total size of the tensor
   assert(n % ld == 0);
   const int grid_size = n / ld;
@@ -83,18 +92,18 @@ bool ComputeSkipLayerNorm(
   if (ld <= 32) {
     constexpr int block_size = 32;
     SkipLayerNormKernelSmall<T, block_size>
-        <<<grid_size, block_size, 0, stream>>>(ld, input, skip, beta, gamma, bias, epsilon, output);
+        <<<grid_size, block_size, 0, stream>>>(ld, input, skip, beta, gamma, bias, epsilon, output, skip_input_bias_add_output);
   } else if (ld <= 128) {
     constexpr int block_size = 128;
     SkipLayerNormKernelSmall<T, block_size>
-        <<<grid_size, block_size, 0, stream>>>(ld, input, skip, beta, gamma, bias, epsilon, output);
+        <<<grid_size, block_size, 0, stream>>>(ld, input, skip, beta, gamma, bias, epsilon, output, skip_input_bias_add_output);
   } else if (ld == 384) {
     constexpr int block_size = 384;
     SkipLayerNormKernelSmall<T, block_size>
-        <<<grid_size, block_size, 0, stream>>>(ld, input, skip, beta, gamma, bias, epsilon, output);
+        <<<grid_size, block_size, 0, stream>>>(ld, input, skip, beta, gamma, bias, epsilon, output, skip_input_bias_add_output);
   } else {
     constexpr int block_size = 256;
-    SkipLayerNormKernel<T, block_size><<<grid_size, block_size, 0, stream>>>(ld, input, skip, beta, gamma, bias, epsilon, output);
+    SkipLayerNormKernel<T, block_size><<<grid_size, block_size, 0, stream>>>(ld, input, skip, beta, gamma, bias, epsilon, output, skip_input_bias_add_output);
   }
   return CUDA_CALL(cudaPeekAtLastError());
 }
@@ -102,6 +111,7 @@ bool ComputeSkipLayerNorm(
 bool LaunchSkipLayerNormKernel(
     cudaStream_t stream,
     void* output,
+    void* skip_input_bias_add_output,
     const void* input,
     const void* skip,
     const void* gamma,
@@ -122,7 +132,8 @@ bool LaunchSkipLayerNormKernel(
         reinterpret_cast<const half*>(gamma),
         reinterpret_cast<const half*>(bias),
         __float2half_rn(epsilon),
-        reinterpret_cast<half*>(output));
+        reinterpret_cast<half*>(output),
+        reinterpret_cast<half*>(skip_input_bias_add_output));
   } else {
     return ComputeSkipLayerNorm(
         stream,
@@ -134,7 +145,8 @@ bool LaunchSkipLayerNormKernel(
         reinterpret_cast<const float*>(gamma),
         reinterpret_cast<const float*>(bias),
         epsilon,
-        reinterpret_cast<float*>(output));
+        reinterpret_cast<float*>(output),
+        reinterpret_cast<float*>(skip_input_bias_add_output));
   }
 }
 
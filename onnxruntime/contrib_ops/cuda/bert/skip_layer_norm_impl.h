@@ -10,6 +10,7 @@ namespace cuda {
 bool LaunchSkipLayerNormKernel(
     cudaStream_t stream,
     void* output,        // output tensor
+    void* skip_input_bias_add_output,  // optional output of input + skip + bias
     const void* input,   // input tensor
     const void* skip,    // skip tensor
     const void* gamma,   // Layer normalization gamma tensor
@@ -0,0 +1,259 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+namespace onnxruntime {
+
+// Final mix of a 64-bit hash (from MurmurHash3), spreads every input bit over the whole result.
+inline uint64_t FlatHashMix(uint64_t h) {
+  h ^= h >> 33;
+  h *= 0xff51afd7ed558ccdULL;
+  h ^= h >> 33;
+  h *= 0xc4ceb9fe1a85ec53ULL;
+  h ^= h >> 33;
+  return h;
+}
+
+// Hash functions used by FlatHashTable. Unlike std::hash, which is the identity for integers with some
+// standard libraries, every bit of the result depends on the whole key: the table takes its probe position
+// and its tag from different bits.
+template <typename T, typename Enable = void>
+struct FlatHash;
+
+template <typename T>
+struct FlatHash<T, std::enable_if_t<std::is_integral<T>::value>> {
+  uint64_t operator()(T value) const { return FlatHashMix(static_cast<uint64_t>(value)); }
+};
+
+template <typename T>
+struct FlatHash<T, std::enable_if_t<std::is_floating_point<T>::value>> {
+  uint64_t operator()(T value) const {
+    // -0 and +0 compare equal so they must have the same hash.
+    if (value == T(0)) {
+      value = T(0);
+    }
+    uint64_t bits = 0;
+    std::memcpy(&bits, &value, sizeof(T));
+    return FlatHashMix(bits);
+  }
+};
+
+// Also hashes std::string_view so that a table of std::string can be searched without a copy of the key.
+template <>
+struct FlatHash<std::string> {
+  uint64_t operator()(std::string_view value) const { return Hash(value.data(), value.size()); }
+
+  // Reads the string 8 bytes at a time.
+  static uint64_t Hash(const char* data, size_t size) {
+    uint64_t h = 0x9e3779b97f4a7c15ULL ^ size;
+    for (; size >= 8; data += 8, size -= 8) {
+      uint64_t word;
+      std::memcpy(&word, data, 8);
+      h = (h ^ word) * 0xff51afd7ed558ccdULL;
+      h ^= h >> 32;
+    }
+    if (size > 0) {
+      uint64_t word = 0;
+      std::memcpy(&word, data, size);
+      h = (h ^ word) * 0xc4ceb9fe1a85ec53ULL;
+    }
+    return FlatHashMix(h);
+  }
+};
+
+// Open addressing hash table for lookup tables built once (typically from the attributes of a kernel) and
+// then only read, possibly from several threads. Keys are never removed.
+//
+// The keys and values are stored inline in one array of slots (short std::string keys stay in their small
+// string buffer), next to an array of control bytes holding 7 bits of the hash of every used slot. A lookup
+// compares 8 control bytes at once within a 64-bit word and only compares the keys of the slots with the
+// same tag, so most misses never touch the slots. The load factor is kept under 7/8.
+template <typename TKey, typename TValue, typename THash = FlatHash<TKey>>
+class FlatHashTable {
+ public:
+  FlatHashTable() = default;
+
+  explicit FlatHashTable(size_t expected_size) { Reserve(expected_size); }
+
+  size_t Size() const { return size_; }
+  bool Empty() const { return size_ == 0; }
+
+  // Makes room for `expected_size` keys without growing the table.
+  void Reserve(size_t expected_size) {
+    size_t capacity = kGroupSize;
+    while (capacity * 7 / 8 < expected_size) {
+      capacity *= 2;
+    }
+    if (capacity > Capacity()) {
+      Rehash(capacity);
+    }
+  }
+
+  // Inserts the key if it is not in the table yet. Returns false and keeps the current value otherwise.
+  bool Insert(const TKey& key, const TValue& value) {
+    return Emplace(key, value, false);
+  }
+
+  // Inserts the key or replaces its value.
+  void InsertOrAssign(const TKey& key, const TValue& value) {
+    Emplace(key, value, true);
+  }
+
+  // Returns the value of the key or nullptr if the key is not in the table.
+  const TValue* Find(const TKey& key) const {
+    return FindEquivalent(key);
+  }
+
+  // Find for a key of another type that THash hashes like, and compares equal to, the equivalent TKey,
+  // e.g. a std::string_view in a table of std::string.
+  template <typename TLookup>
+  const TValue* FindEquivalent(const TLookup& key) const {
+    if (size_ == 0) {
+      return nullptr;
+    }
+
+    const uint64_t hash = THash()(key);
+    const uint64_t tag = hash & 0x7f;
+    size_t position = static_cast<size_t>(hash >> 7) & mask_;
+
+    while (true) {
+      const uint64_t group = LoadGroup(position);
+      for (uint64_t match = MatchTag(group, tag); match != 0; match &= match - 1) {
+        const auto& slot = slots_[(position + LowestByte(match)) & mask_];
+        if (slot.first == key) {
+          return &slot.second;
+        }
+      }
+      if (MatchEmpty(group) != 0) {
+        return nullptr;
+      }
+      position = (position + kGroupSize) & mask_;
+    }
+  }
+
+ private:
+  static constexpr size_t kGroupSize = 8;
+  static constexpr uint8_t kEmpty = 0x80;
+  static constexpr uint64_t kLsbs = 0x0101010101010101ULL;
+  static constexpr uint64_t kMsbs = 0x8080808080808080ULL;
+
+  size_t Capacity() const { return slots_.size(); }
+
+  // Loads the control bytes of the slots [position, position + kGroupSize), the first byte in the low bits.
+  uint64_t LoadGroup(size_t position) const {
+    uint64_t group;
+    std::memcpy(&group, control_.data() + position, kGroupSize);
+#if defined(__BYTE_ORDER__) && (__BYTE_ORDER__ == __ORDER_BIG_ENDIAN__)
+    group = __builtin_bswap64(group);
+#endif
+    return group;
+  }
+
+  // Sets the high bit of the bytes equal to `tag`. A byte above a match may also be reported, which is
+  // harmless as the keys are compared anyway.
+  static uint64_t MatchTag(uint64_t group, uint64_t tag) {
+    const uint64_t x = group ^ (kLsbs * tag);
+    return (x - kLsbs) & ~x & kMsbs;
+  }
+
+  // Sets the high bit of the empty bytes: used bytes hold a 7-bit tag.
+  static uint64_t MatchEmpty(uint64_t group) { return group & kMsbs; }
+
+  static size_t LowestByte(uint64_t match) {
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_ARM64))
+    unsigned long index;
+    _BitScanForward64(&index, match);
+    return index / 8;
+#elif defined(__GNUC__)
+    return static_cast<size_t>(__builtin_ctzll(match)) / 8;
+#else
+    size_t index = 0;
+    while ((match & 0xff) == 0) {
+      match >>= 8;
+      ++index;
+    }
+    return index;
+#endif
+  }
+
+  void SetControl(size_t index, uint8_t value) {
+    control_[index] = value;
+    // The bytes after the last slot mirror the first group so that a group can be loaded at any position.
+    if (index < kGroupSize) {
+      control_[Capacity() + index] = value;
+    }
+  }
+
+  bool Emplace(const TKey& key, const TValue& value, bool assign) {
+    if ((size_ + 1) * 8 > Capacity() * 7) {
+      Rehash(Capacity() == 0 ? kGroupSize : Capacity() * 2);
+    }
+
+    const uint64_t hash = THash()(key);
+    const uint64_t tag = hash & 0x7f;
+    size_t position = static_cast<size_t>(hash >> 7) & mask_;
+
+    while (true) {
+      const uint64_t group = LoadGroup(position);
+      for (uint64_t match = MatchTag(group, tag); match != 0; match &= match - 1) {
+        auto& slot = slots_[(position + LowestByte(match)) & mask_];
+        if (slot.first == key) {
+          if (assign) {
+            slot.second = value;
+          }
+          return false;
+        }
+      }
+
+      // Keys are never removed so the key can't be after the first empty slot of its probe sequence.
+      const uint64_t empty = MatchEmpty(group);
+      if (empty != 0) {
+        const size_t index = (position + LowestByte(empty)) & mask_;
+        SetControl(index, static_cast<uint8_t>(tag));
+        slots_[index].first = key;
+        slots_[index].second = value;
+        ++size_;
+        return true;
+      }
+      position = (position + kGroupSize) & mask_;
+    }
+  }
+
+  void Rehash(size_t capacity) {
+    std::vector<uint8_t> control = std::move(control_);
+    std::vector<std::pair<TKey, TValue>> slots = std::move(slots_);
+
+    control_.assign(capacity + kGroupSize, kEmpty);
+    slots_.clear();
+    slots_.resize(capacity);
+    mask_ = capacity - 1;
+    size_ = 0;
+
+    for (size_t i = 0; i < slots.size(); ++i) {
+      if (control[i] != kEmpty) {
+        Emplace(slots[i].first, slots[i].second, false);
+      }
+    }
+  }
+
+  std::vector<uint8_t> control_;
+  std::vector<std::pair<TKey, TValue>> slots_;
+  size_t mask_ = 0;
+  size_t size_ = 0;
+};
+
+}  // namespace onnxruntime
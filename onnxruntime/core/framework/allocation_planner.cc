@@ -43,6 +43,9 @@ std::ostream& operator<<(std::ostream& out, AllocKind alloc_kind) {
     case AllocKind::kAllocatedExternally:
       out << "AllocatedExternally";
       break;
+    case AllocKind::kView:
+      out << "View";
+      break;
     case AllocKind::kNotSet:
       out << "NotSet";
       break;
@@ -68,7 +71,8 @@ std::ostream& operator<<(std::ostream& out, std::pair<const SequentialExecutionP
     if (0 <= index && static_cast<size_t>(index) < plan_size) {
       auto& elt_plan = plan.allocation_plan[index];
       out << elt_plan.alloc_kind;
-      if (elt_plan.alloc_kind == AllocKind::kReuse) out << " " << elt_plan.reused_buffer;
+      if (elt_plan.alloc_kind == AllocKind::kReuse || elt_plan.alloc_kind == AllocKind::kView)
+        out << " " << elt_plan.reused_buffer;
 
       auto& loc = elt_plan.location;
       out << ", " << loc.ToString();
@@ -179,6 +183,10 @@ class PlannerImpl {
   // they became free (more recently freed earlier in the list).
   std::list<FreeBufferInfo> freelist_;
 
+  // views_ : the ml-values planned as views (AllocKind::kView), keyed by the original buffer they refer to.
+  // A view is released when its original buffer becomes free, but never offered for reuse itself.
+  std::unordered_map<OrtValueIndex, std::vector<OrtValueIndex>> views_;
+
   OrtValueIndex Index(const OrtValueName& name) {
     OrtValueIndex result;
     auto status = ort_value_name_idx_map_.GetIdx(name, result);
@@ -244,6 +252,19 @@ class PlannerImpl {
     auto& symplan = AllocPlan(reused_for);
     symplan.alloc_kind = alloc_kind;
     symplan.reused_buffer = original;
+
+    // a view starts at an offset into the original buffer, so anything reusing it must reuse the view's data
+    // rather than the start of the original buffer. lifetimes are still tracked against the original buffer.
+    const auto& reused_plan = AllocPlan(reused);
+    if (reused_plan.alloc_kind == AllocKind::kView) {
+      symplan.reused_buffer = reused;
+    } else if (reused_plan.alloc_kind == AllocKind::kReuse) {
+      symplan.reused_buffer = reused_plan.reused_buffer;
+    }
+
+    if (alloc_kind == AllocKind::kView) {
+      views_[original].push_back(reused_for);
+    }
   }
 
 #if !defined(ORT_MINIMAL_BUILD) && defined(ORT_MEMORY_PROFILE)
@@ -255,6 +276,69 @@ class PlannerImpl {
   }
 #endif
 
+  // Record that the original buffer becomes free after the given step, along with any views into it.
+  void FreeBuffer(OrtValueIndex original, size_t program_counter) {
+    freelist_.push_front(FreeBufferInfo(original, program_counter));
+    if (AllocPlan(original).alloc_kind == AllocKind::kAllocate) {
+      AllocPlan(original).program_counter.AddEnd(program_counter);
+    }
+
+    auto views = views_.find(original);
+    if (views != views_.end()) {
+      for (auto view : views->second) {
+        freelist_.push_front(FreeBufferInfo(view, program_counter));
+      }
+      views_.erase(views);
+    }
+  }
+
+  // Find if the output_arg_num-th output of the node may be created as a view into one of its inputs.
+  bool FindViewableInput(const onnxruntime::Node& node, int output_arg_num, OrtValueIndex* viewable_input) {
+    const KernelCreateInfo& ci = GetKernelCreateInfo(kernel_create_info_map_, node.Index());
+    if (ci.kernel_def == nullptr) {
+      return false;
+    }
+
+    auto p_output_arg = node.OutputDefs()[output_arg_num];
+    if (HasFence(p_output_arg)) {
+      return false;
+    }
+
+    auto input_args = node.InputDefs();
+    auto is_viewable = [&](int input_arg_num) {
+      if (input_arg_num < 0 || static_cast<size_t>(input_arg_num) >= input_args.size()) {
+        return false;
+      }
+
+      auto p_input_arg = input_args[input_arg_num];
+      if (!p_input_arg->Exists() || IsNonTensor(*p_input_arg)) {
+        return false;
+      }
+
+      auto input_arg_index = Index(p_input_arg->Name());
+      if (Buffer(input_arg_index) == -1 || HasFence(p_input_arg) ||
+          !(AllocPlan(input_arg_index).location == AllocPlan(p_output_arg->Name()).location)) {
+        return false;
+      }
+
+      *viewable_input = input_arg_index;
+      return true;
+    };
+
+    for (auto pair : ci.kernel_def->MayView()) {
+      if (pair.second == output_arg_num && is_viewable(pair.first)) {
+        return true;
+      }
+    }
+
+    const optional<std::pair<int, int>>& variadic_view = ci.kernel_def->VariadicMayView();
+    if (variadic_view.has_value() && output_arg_num >= variadic_view.value().second) {
+      return is_viewable(variadic_view.value().first);
+    }
+
+    return false;
+  }
+
   // Find if there exists some input tensor that we can use in-place for output_arg_num-th input in the node.
   bool FindReusableInput(const onnxruntime::Node& node, int output_arg_num, OrtValueIndex* reusable_input) {
 #ifdef ENABLE_TRAINING
@@ -413,6 +497,7 @@ class PlannerImpl {
 
     for (auto it = freelist_.begin(); it != freelist_.end(); ++it) {
       size_t reusable = static_cast<size_t>(it->ml_value);
+      if (AllocPlan(it->ml_value).alloc_kind == AllocKind::kView) continue;
       const onnxruntime::NodeArg* p_node_arg = ort_value_info_.at(reusable).p_def_site;
       if (!p_node_arg) {
         // TODO this should be an error case, needs more investigation
@@ -745,6 +830,10 @@ class PlannerImpl {
           // we do not try sharing-optimization for non-tensors
           AllocPlan(current).alloc_kind = AllocKind::kAllocate;
           AllocPlan(current).program_counter.AddStart(program_counter);
+        } else if (!context_.IsParallelExecutionEnabled() &&
+                   FindViewableInput(*pnode, static_cast<int>(output_arg_def_index), &reused)) {
+          // The kernel may create this output at an offset into one of its inputs.
+          Reuse(reused, current, AllocKind::kView);
         } else if (!context_.IsParallelExecutionEnabled() &&
                    FindReusableInput(*pnode, static_cast<int>(output_arg_def_index), &reused)) {
           // Reuse one of this node's input buffers as the output buffer (for in-place update)
@@ -782,10 +871,7 @@ class PlannerImpl {
           }
 #endif
           if ((original != -1) && (0 == DecrementUseCount(original))) {
-            freelist_.push_front(FreeBufferInfo(original, program_counter));
-            if (AllocPlan(original).alloc_kind == AllocKind::kAllocate) {
-              AllocPlan(original).program_counter.AddEnd(program_counter);
-            }
+            FreeBuffer(original, program_counter);
           }
         }
       }
@@ -804,10 +890,7 @@ class PlannerImpl {
           }
 #endif
           if ((original != -1) && (0 == DecrementUseCount(original))) {
-            freelist_.push_front(FreeBufferInfo(original, program_counter));
-            if (AllocPlan(original).alloc_kind == AllocKind::kAllocate) {
-              AllocPlan(original).program_counter.AddEnd(program_counter);
-            }
+            FreeBuffer(original, program_counter);
           }
         }
       }
@@ -826,10 +909,7 @@ class PlannerImpl {
           }
 #endif
           if (0 == DecrementUseCount(original)) {
-            freelist_.push_front(FreeBufferInfo(original, program_counter));
-            if (AllocPlan(original).alloc_kind == AllocKind::kAllocate) {
-              AllocPlan(original).program_counter.AddEnd(program_counter);
-            }
+            FreeBuffer(original, program_counter);
           }
         }
       }
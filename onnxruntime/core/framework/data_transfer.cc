@@ -2,6 +2,7 @@
 // Licensed under the MIT License.
 
 #include "core/framework/data_transfer.h"
+#include "core/framework/string_tensor_view.h"
 
 namespace onnxruntime {
 
@@ -28,6 +29,16 @@ common::Status CPUDataTransfer::CopyTensor(const Tensor& src, Tensor& dst, int /
     // no need copying as both pointers are referring to same piece of memory.
     return Status::OK();
   }
+  // The destination has std::string elements, the source may be in either string tensor layout.
+  if (src.IsDataTypeString()) {
+    const StringTensorView src_strings(src);
+    ORT_ENFORCE(src_strings.Size() == static_cast<size_t>(dst.Shape().Size()));
+    auto* dst_strings = dst.MutableData<std::string>();
+    for (size_t i = 0; i < src_strings.Size(); ++i) {
+      dst_strings[i].assign(src_strings[i].data(), src_strings[i].size());
+    }
+    return Status::OK();
+  }
   // Copying only happens between two same size tensors.
   ORT_ENFORCE(src.SizeInBytes() == dst.SizeInBytes());
   memcpy(dst_data, src_data, src.SizeInBytes());
@@ -163,6 +163,23 @@ Status IExecutionFrame::GetOrCreateNodeOutputMLValue(const int output_index, int
   return status;
 }
 
+OrtValue* IExecutionFrame::TryCreateNodeOutputViewMLValue(int output_arg_index, int input_arg_index,
+                                                          const TensorShape& shape, ptrdiff_t byte_offset) {
+  int ort_value_idx = GetNodeIdxToMLValueIdx(output_arg_index);
+  const OrtValue* source = GetNodeInputOrOutputMLValue(input_arg_index);
+  if (ort_value_idx == NodeIndexInfo::kInvalidEntry || source == nullptr || !source->IsTensor()) {
+    return nullptr;
+  }
+
+  OrtValue& ort_value = all_values_[ort_value_idx];
+  if (ort_value.IsAllocated() ||
+      !CreateNodeOutputViewMLValueImpl(ort_value, ort_value_idx, *source, shape, byte_offset)) {
+    return nullptr;
+  }
+
+  return &ort_value;
+}
+
 bool IExecutionFrame::TryGetInferredShape(int /*index*/, TensorShape& /*shape*/) const {
   // By default, there is not information about inferred shape, so this default
   // implementation always returns false. The derived class of IExecutionFrame
@@ -555,6 +572,21 @@ Status ExecutionFrame::AllocateMLValueTensorPreAllocateBuffer(OrtValue& ort_valu
 
   // reused OrtValue share the same fence
   ort_value.ShareFenceWith(ort_value_reuse);
+
+  // The string buffer layout holds no std::string elements, so a tensor over the same buffer keeps the layout.
+  if (reuse_tensor->IsStringBuffer()) {
+    if (element_type != DataTypeImpl::GetType<std::string>() || buffer_num_elements != required_num_elements) {
+      return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL,
+                             "A string tensor in the string buffer layout can only be reused by a string tensor of "
+                             "the same size. Got ", DataTypeImpl::ToString(element_type), " ", shape, ".");
+    }
+
+    auto ml_tensor = DataTypeImpl::GetType<Tensor>();
+    auto p_tensor = Tensor::CreateStringBufferAlias(shape, *reuse_tensor);
+    ort_value.Init(p_tensor.release(), ml_tensor, ml_tensor->GetDeleteFunc());
+    return Status::OK();
+  }
+
   return AllocateTensorWithPreAllocateBufferHelper(ort_value, reuse_buffer, element_type, location, shape);
 }
 
@@ -638,8 +670,10 @@ Status ExecutionFrame::AllocateAsPerAllocationPlan(OrtValue& ort_value, int ort_
     switch (alloc_kind) {
       // Right now for kAllocate and kAllocateOutput we are using same approach.
       // In the future we may want to have different way to handle it.
+      // A kView output only gets here if the kernel couldn't create it as a view, so it needs its own buffer.
       case AllocKind::kAllocateOutput:
-      case AllocKind::kAllocate: {
+      case AllocKind::kAllocate:
+      case AllocKind::kView: {
         ORT_RETURN_IF_ERROR(AllocateMLValueTensorSelfOwnBuffer(ort_value, ort_value_index, ml_data_type, alloc_info,
                                                                *shape, per_alloc_plan.create_fence_if_async));
         break;
@@ -724,6 +758,28 @@ void ExecutionFrame::VerifyOutputSizes(int output_index, const Node& node, const
   }
 }
 
+bool ExecutionFrame::CreateNodeOutputViewMLValueImpl(OrtValue& ort_value, int ort_value_idx, const OrtValue& source,
+                                                     const TensorShape& shape, ptrdiff_t byte_offset) {
+  if (GetAllocationPlan(ort_value_idx).alloc_kind != AllocKind::kView) {
+    return false;
+  }
+
+  const Tensor& source_tensor = source.Get<Tensor>();
+  const auto* element_type = source_tensor.DataType();
+  ORT_ENFORCE(byte_offset >= 0 &&
+                  static_cast<size_t>(byte_offset) + shape.Size() * element_type->Size() <= source_tensor.SizeInBytes(),
+              "View of shape ", shape, " at byte offset ", byte_offset, " is out of bounds of source with shape ",
+              source_tensor.Shape());
+
+  // the view only refers to the source buffer. the planner keeps the source alive for as long as the view is used.
+  void* view_buffer = static_cast<char*>(const_cast<void*>(source_tensor.DataRaw())) + byte_offset;
+  ORT_ENFORCE(AllocateTensorWithPreAllocateBufferHelper(ort_value, view_buffer, element_type,
+                                                        source_tensor.Location(), shape)
+                  .IsOK());
+
+  return true;
+}
+
 Status ExecutionFrame::ReleaseMLValueImpl(int ort_value_idx) {
   ORT_RETURN_IF_ERROR(IExecutionFrame::ReleaseMLValueImpl(ort_value_idx));
   TraceFree(ort_value_idx);
@@ -739,10 +795,11 @@ const AllocPlanPerValue& ExecutionFrame::GetAllocationPlan(int ort_value_idx) {
 
 void ExecutionFrame::TraceAllocate(int ort_value_idx, size_t size) {
   if (planner_) {
-    // don't trace the output tensors or external outputs.
+    // don't trace the output tensors, external outputs, or views that fell back to allocating.
     auto& allocation_plan = GetAllocationPlan(ort_value_idx);
     if (allocation_plan.alloc_kind == AllocKind::kAllocateOutput ||
-        allocation_plan.alloc_kind == AllocKind::kAllocatedExternally) {
+        allocation_plan.alloc_kind == AllocKind::kAllocatedExternally ||
+        allocation_plan.alloc_kind == AllocKind::kView) {
       return;
     }
     auto status = planner_->TraceAllocation(ort_value_idx, size);
@@ -784,7 +841,15 @@ Status ExecutionFrame::GeneratePatterns(MemoryPatternGroup* out) const {
     return Status(ONNXRUNTIME, FAIL, "Memory pattern planner is not enabled on this execution framework.");
   }
 
-  return planner_->GeneratePatterns(out);
+  ORT_RETURN_IF_ERROR(planner_->GeneratePatterns(out));
+
+  for (size_t i = 0; i < out->locations.size(); ++i) {
+    LOGS(session_state_.Logger(), VERBOSE) << "Memory pattern for " << out->locations[i].ToString()
+                                           << ": planned peak " << out->patterns[i].PeakSize()
+                                           << " bytes, without reuse " << out->patterns[i].NaiveSize() << " bytes";
+  }
+
+  return Status::OK();
 }
 
 bool ExecutionFrame::TryGetInferredShape(int index, TensorShape& shape) const {
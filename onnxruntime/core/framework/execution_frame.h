@@ -65,6 +65,12 @@ class IExecutionFrame {
   Status GetOrCreateNodeOutputMLValue(const int index, int output_arg_index, const TensorShape* shape,
                                       OrtValue*& p_ort_value, const Node& node, size_t nnz = 0);
 
+  // This method is not thread safe!
+  // Create the output as a view at byte_offset into the value at input_arg_index if the allocation plan allows it.
+  // Returns nullptr if the output is an unused optional output, has already been created, or can't be a view.
+  OrtValue* TryCreateNodeOutputViewMLValue(int output_arg_index, int input_arg_index, const TensorShape& shape,
+                                           ptrdiff_t byte_offset);
+
   // This function try retrieve the inferred shapes for the given NodeArg index.
   // If the retrieval is successful, this function returns true and false otherwise.
   virtual bool TryGetInferredShape(int index, TensorShape& shape) const;
@@ -107,6 +113,13 @@ class IExecutionFrame {
   virtual Status CreateNodeOutputMLValueImpl(OrtValue& ort_value, int ort_value_idx, const TensorShape* shape,
                                              size_t nnz) = 0;
 
+  // optional function to create ort_value as a view into source. returns false if that isn't supported.
+  virtual bool CreateNodeOutputViewMLValueImpl(OrtValue& /*ort_value*/, int /*ort_value_idx*/,
+                                               const OrtValue& /*source*/, const TensorShape& /*shape*/,
+                                               ptrdiff_t /*byte_offset*/) {
+    return false;
+  }
+
   virtual Status CopyTensor(const Tensor& src, Tensor& dest) const = 0;
 
   const NodeIndexInfo& node_index_info_;
@@ -179,6 +192,8 @@ class ExecutionFrame final : public IExecutionFrame {
   AllocatorPtr GetAllocatorImpl(const OrtMemoryInfo& info) const override;
   Status ReleaseMLValueImpl(int ort_value_idx) override;
   Status CreateNodeOutputMLValueImpl(OrtValue& ort_value, int ort_value_idx, const TensorShape* shape, size_t nnz) override;
+  bool CreateNodeOutputViewMLValueImpl(OrtValue& ort_value, int ort_value_idx, const OrtValue& source,
+                                       const TensorShape& shape, ptrdiff_t byte_offset) override;
   void VerifyOutputSizes(int output_index, const Node& node, const TensorShape& output_shape) override;
   Status CopyTensor(const Tensor& src, Tensor& dest) const override;
 
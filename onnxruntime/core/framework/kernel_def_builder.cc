@@ -256,6 +256,22 @@ KernelDefBuilder& KernelDefBuilder::Alias(int input_index, int output_index) {
   return *this;
 }
 
+KernelDefBuilder& KernelDefBuilder::MayView(const std::vector<std::pair<int, int>>& views) {
+  kernel_def_->view_map_ = views;
+  return *this;
+}
+
+KernelDefBuilder& KernelDefBuilder::MayView(int input_index, int output_index) {
+  kernel_def_->view_map_.emplace_back(input_index, output_index);
+  return *this;
+}
+
+KernelDefBuilder& KernelDefBuilder::VariadicMayView(int input_index, int output_offset) {
+  ORT_ENFORCE(input_index >= 0 && output_offset >= 0);
+  kernel_def_->variadic_view_ = std::make_pair(input_index, output_offset);
+  return *this;
+}
+
 KernelDefBuilder& KernelDefBuilder::VariadicAlias(int input_offset, int output_offset) {
   ORT_ENFORCE(input_offset >= 0 && output_offset >= 0);
   kernel_def_->variadic_alias_offsets_ = std::make_pair(input_offset, output_offset);
@@ -25,11 +25,13 @@ class MemoryPattern {
 
   MemoryPattern(MemoryPattern&& rhs) noexcept
       : patterns_{std::move(rhs.patterns_)},
-        peak_size_{std::move(rhs.peak_size_)} {}
+        peak_size_{std::move(rhs.peak_size_)},
+        naive_size_{std::move(rhs.naive_size_)} {}
 
   MemoryPattern& operator=(MemoryPattern&& rhs) noexcept {
     patterns_ = std::move(rhs.patterns_);
     peak_size_ = std::move(rhs.peak_size_);
+    naive_size_ = std::move(rhs.naive_size_);
     return *this;
   }
 
@@ -37,6 +39,11 @@ class MemoryPattern {
     return peak_size_;
   }
 
+  // Total size of all the blocks, i.e. the size needed without any reuse.
+  size_t NaiveSize() const {
+    return naive_size_;
+  }
+
   const MemoryBlock* GetBlock(int ml_value_idx) const {
     auto it = patterns_.find(ml_value_idx);
     if (it == patterns_.end())
@@ -55,6 +62,7 @@ class MemoryPattern {
 
   std::unordered_map<int, MemoryBlock> patterns_;
   size_t peak_size_{0};
+  size_t naive_size_{0};
 };
 
 struct MemoryPatternGroup {
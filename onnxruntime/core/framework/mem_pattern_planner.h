@@ -16,7 +16,11 @@ limitations under the License.
 // Licensed under the MIT License.
 
 #pragma once
+#include <algorithm>
+#include <limits>
 #include <list>
+#include <unordered_map>
+#include <vector>
 #include "core/common/safeint.h"
 #include "core/framework/mem_pattern.h"
 #include "core/framework/allocation_planner.h"
@@ -130,68 +134,30 @@ class MemPatternPlanner {
   }
 #endif
 
+  // Record the allocation. Without counters the offsets are assigned in GenerateMemPattern once the lifetimes
+  // of all the traced allocations are known.
   void TraceAllocation(int ml_value_idx, size_t size) {
     ORT_ENFORCE(!using_counters_);
 
     std::lock_guard<OrtMutex> lock(lock_);
 
-    if (size == 0) {
-      allocs_.emplace_back(ml_value_idx, MemoryBlock(0, 0));
-      return;
-    }
-
-    size_t current = 0;
-    size_t waste_bytes = std::numeric_limits<size_t>::max();
-    size_t best_offset = 0;
-    bool best_offset_found = false;
-
-    for (auto it = blocks_.begin(); it != blocks_.end(); it++) {
-      if (allocs_[*it].block_.offset_ >= current) {
-        auto gap = allocs_[*it].block_.offset_ - current;
-        if (gap >= size && (gap - size) < waste_bytes) {
-          waste_bytes = gap - size;
-          best_offset = current;
-          best_offset_found = true;
-        }
-      }
-      current = std::max(current, allocs_[*it].block_.offset_ + allocs_[*it].block_.size_);
-    }
-
-    ORT_ENFORCE(current <= buffer_size_);
-
-    if (current < buffer_size_) {
-      auto gap = buffer_size_ - current;
-      if ((gap >= size) && ((gap - size) < waste_bytes)) {
-        best_offset = current;
-        best_offset_found = true;
-      }
-    }
-
-    if (!best_offset_found) {
-      best_offset = current;
-    }
-
-    // we only need to bounds check the addition of size to best_offset as that is the only time we extend
-    // the maximum size of the buffer.
-    buffer_size_ = std::max(buffer_size_, SafeInt<size_t>(best_offset) + size);
-    allocs_.emplace_back(ml_value_idx, MemoryBlock(best_offset, size));
-    std::list<int>::iterator best_fit_it = blocks_.end();
-    for (auto it = blocks_.begin(); it != blocks_.end(); it++) {
-      if (allocs_[*it].block_.offset_ < best_offset)
-        continue;
-
-      if ((allocs_[*it].block_.offset_ > best_offset) || (allocs_[*it].block_.size_ >= size)) {
-        best_fit_it = it;
-        break;
-      }
-    }
-
-    blocks_.insert(best_fit_it, (static_cast<int>(allocs_.size()) - 1));
+    live_allocs_[ml_value_idx] = allocs_.size();
+    allocs_.emplace_back(ml_value_idx, MemoryBlock(0, size));
+    lifetimes_.push_back({clock_++, std::numeric_limits<size_t>::max()});
   }
 
   void TraceFree(int ml_value_index) {
     std::lock_guard<OrtMutex> lock(lock_);
 
+    if (!using_counters_) {
+      auto it = live_allocs_.find(ml_value_index);
+      if (it != live_allocs_.end()) {
+        lifetimes_[it->second].end = clock_++;
+        live_allocs_.erase(it);
+      }
+      return;
+    }
+
     for (auto it = blocks_.begin(); it != blocks_.end(); it++) {
       if (allocs_[*it].index_ == ml_value_index) {
         blocks_.erase(it);
@@ -234,15 +200,98 @@ class MemPatternPlanner {
 #endif
 
     MemoryPattern pattern;
-    pattern.peak_size_ = buffer_size_;
-    for (auto& alloc : allocs_) {
-      pattern.patterns_[alloc.index_] = alloc.block_;
+    if (using_counters_) {
+      pattern.peak_size_ = buffer_size_;
+      for (auto& alloc : allocs_) {
+        pattern.patterns_[alloc.index_] = alloc.block_;
+        pattern.naive_size_ += alloc.block_.size_;
+      }
+    } else {
+      PlanOffsets(pattern);
     }
 
     return pattern;
   }
 
  private:
+  // Assign offsets to the traced allocations, largest first. Each allocation is placed in the smallest gap
+  // between the already placed allocations whose lifetimes overlap with its own, or after all of them if
+  // no gap is large enough. Unlike placing the allocations in trace order, large tensors that are allocated
+  // late can't be pushed beyond the peak by small long lived ones that happened to be allocated before them.
+  void PlanOffsets(MemoryPattern& pattern) const {
+    std::vector<size_t> order(allocs_.size());
+    for (size_t i = 0; i < order.size(); ++i) {
+      order[i] = i;
+    }
+
+    // ties are placed in trace order
+    std::stable_sort(order.begin(), order.end(), [this](size_t lhs, size_t rhs) {
+      return allocs_[lhs].block_.size_ > allocs_[rhs].block_.size_;
+    });
+
+    std::vector<MemoryBlock> blocks(allocs_.size());
+    std::vector<size_t> placed;
+    std::vector<const MemoryBlock*> overlapping;
+    SafeInt<size_t> peak_size = 0;
+    SafeInt<size_t> naive_size = 0;
+
+    for (size_t alloc_idx : order) {
+      const size_t size = allocs_[alloc_idx].block_.size_;
+      const Lifetime& lifetime = lifetimes_[alloc_idx];
+      naive_size += size;
+      if (size == 0) {
+        continue;
+      }
+
+      overlapping.clear();
+      for (size_t other : placed) {
+        if (lifetime.start < lifetimes_[other].end && lifetimes_[other].start < lifetime.end) {
+          overlapping.push_back(&blocks[other]);
+        }
+      }
+
+      std::sort(overlapping.begin(), overlapping.end(),
+                [](const MemoryBlock* lhs, const MemoryBlock* rhs) { return lhs->offset_ < rhs->offset_; });
+
+      size_t current = 0;
+      size_t waste_bytes = std::numeric_limits<size_t>::max();
+      size_t best_offset = 0;
+      bool best_offset_found = false;
+      for (const MemoryBlock* block : overlapping) {
+        if (block->offset_ > current) {
+          auto gap = block->offset_ - current;
+          if (gap >= size && (gap - size) < waste_bytes) {
+            waste_bytes = gap - size;
+            best_offset = current;
+            best_offset_found = true;
+          }
+        }
+
+        current = std::max(current, block->offset_ + block->size_);
+      }
+
+      if (!best_offset_found) {
+        best_offset = current;
+      }
+
+      blocks[alloc_idx] = MemoryBlock(best_offset, size);
+      peak_size = std::max(peak_size, SafeInt<size_t>(best_offset) + size);
+      placed.push_back(alloc_idx);
+    }
+
+    pattern.peak_size_ = peak_size;
+    pattern.naive_size_ = naive_size;
+    for (size_t i = 0; i < allocs_.size(); ++i) {
+      pattern.patterns_[allocs_[i].index_] = blocks[i];
+    }
+  }
+
+  struct Lifetime {
+    // trace clock values of the allocation and of the free. end is max if the value was not freed.
+    size_t start;
+    size_t end;
+  };
+
   struct OrtValueAllocationBlock {
     int index_{-1};
     MemoryBlock block_;
@@ -258,6 +307,10 @@ class MemPatternPlanner {
   std::vector<OrtValueAllocationBlock> allocs_;
   // blocks_ the list of currently allocated memory blocks, sorted in order of their offset
   std::list<int> blocks_;
+  // lifetimes of allocs_ and the index in allocs_ of the values that are not freed yet. only used without counters.
+  std::vector<Lifetime> lifetimes_;
+  std::unordered_map<int, size_t> live_allocs_;
+  size_t clock_{0};
   SafeInt<size_t> buffer_size_{0};
   bool using_counters_;
   mutable OrtMutex lock_;
@@ -49,6 +49,16 @@ Tensor* OpKernelContext::Output(int index, const std::initializer_list<int64_t>&
   return Output(index, TensorShape(shape));
 }
 
+Tensor* OpKernelContext::OutputView(int index, const TensorShape& shape, int input_index, ptrdiff_t byte_offset) {
+  if (index < 0 || index >= OutputCount() || input_index < 0 || input_index >= InputCount())
+    return nullptr;
+
+  OrtValue* p_ml_value = execution_frame_->TryCreateNodeOutputViewMLValue(GetOutputArgIndex(index),
+                                                                          GetInputArgIndex(input_index),
+                                                                          shape, byte_offset);
+  return p_ml_value ? p_ml_value->GetMutable<Tensor>() : nullptr;
+}
+
 SparseTensor* OpKernelContext::Output(int index, size_t nnz, const TensorShape& shape) {
   auto p_ml_value = OutputMLValue(index, shape, nnz);
   return p_ml_value ? p_ml_value->GetMutable<SparseTensor>() : nullptr;
@@ -0,0 +1,57 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <string>
+#include <string_view>
+
+#include "core/framework/tensor.h"
+
+namespace onnxruntime {
+
+// Read only access to the elements of a string tensor in either layout: one std::string per element or
+// the string buffer layout (see Tensor::CreateStringBuffer). The tensor must outlive the view.
+class StringTensorView {
+ public:
+  explicit StringTensorView(const Tensor& tensor)
+      : size_(static_cast<size_t>(tensor.Shape().Size())), is_string_buffer_(tensor.IsStringBuffer()) {
+    ORT_ENFORCE(tensor.IsDataTypeString(), "StringTensorView requires a string tensor.");
+    if (is_string_buffer_) {
+      offsets_ = tensor.StringBufferOffsets();
+      bytes_ = tensor.StringBufferData();
+    } else {
+      strings_ = tensor.Data<std::string>();
+    }
+  }
+
+  size_t Size() const { return size_; }
+
+  std::string_view operator[](size_t index) const {
+    if (!is_string_buffer_) {
+      return strings_[index];
+    }
+    return std::string_view(bytes_ + offsets_[index], offsets_[index + 1] - offsets_[index]);
+  }
+
+  // Total length of the strings.
+  size_t TotalLength() const {
+    if (is_string_buffer_) {
+      return offsets_[size_];
+    }
+    size_t total = 0;
+    for (size_t i = 0; i < size_; ++i) {
+      total += strings_[i].size();
+    }
+    return total;
+  }
+
+ private:
+  size_t size_;
+  bool is_string_buffer_;
+  const std::string* strings_ = nullptr;
+  const size_t* offsets_ = nullptr;
+  const char* bytes_ = nullptr;
+};
+
+}  // namespace onnxruntime
@@ -43,7 +43,47 @@ Tensor::Tensor(MLDataType p_type, const TensorShape& shape, void* p_data, std::s
   Init(p_type, shape, p_data, deleter, offset);
 }
 
+std::unique_ptr<Tensor> Tensor::CreateStringBuffer(const TensorShape& shape, size_t total_bytes,
+                                                   std::shared_ptr<IAllocator> allocator) {
+  int64_t shape_size = shape.Size();
+  if (shape_size < 0)
+    ORT_THROW("shape.Size() must >=0");
+
+  // the offsets come first so that they are aligned
+  SafeInt<size_t> len = 0;
+  if (!allocator->CalcMemSizeForArray(SafeInt<size_t>(shape_size) + 1, sizeof(size_t), &len))
+    ORT_THROW("tensor failed memory size calculation");
+  len += total_bytes;
+
+  auto* offsets = static_cast<size_t*>(allocator->Alloc(len));
+  ORT_ENFORCE(offsets != nullptr, "Failed to allocate the string buffer.");
+  // an empty tensor is complete, otherwise the caller fills the offsets
+  offsets[0] = 0;
+  offsets[shape_size] = total_bytes;
+
+  auto tensor = std::make_unique<Tensor>(DataTypeImpl::GetType<std::string>(), shape, nullptr, allocator->Info());
+  tensor->p_data_ = offsets;
+  tensor->buffer_deleter_ = std::move(allocator);
+  tensor->is_string_buffer_ = true;
+  return tensor;
+}
+
+std::unique_ptr<Tensor> Tensor::CreateStringBufferAlias(const TensorShape& shape, Tensor& source) {
+  ORT_ENFORCE(source.is_string_buffer_, "Tensor is not in the string buffer layout.");
+  ORT_ENFORCE(shape.Size() == source.shape_.Size(), "A string buffer can only be aliased with the same size: ",
+              shape, " != ", source.shape_);
+
+  auto tensor = std::make_unique<Tensor>(DataTypeImpl::GetType<std::string>(), shape, nullptr, source.alloc_info_);
+  tensor->p_data_ = source.p_data_;
+  tensor->is_string_buffer_ = true;
+  return tensor;
+}
+
 size_t Tensor::SizeInBytes() const {
+  if (is_string_buffer_) {
+    return (static_cast<size_t>(shape_.Size()) + 1) * sizeof(size_t) + StringBufferOffsets()[shape_.Size()];
+  }
+
   size_t ret;
   if (!IAllocator::CalcMemSizeForArray(SafeInt<size_t>(shape_.Size()), dtype_->Size(), &ret)) {
     ORT_THROW("tensor size overflow");
@@ -79,12 +119,14 @@ Tensor::Tensor(Tensor&& other) noexcept
       shape_(other.shape_),
       dtype_(other.dtype_),
       alloc_info_(other.alloc_info_),
-      byte_offset_(other.byte_offset_) {
+      byte_offset_(other.byte_offset_),
+      is_string_buffer_(other.is_string_buffer_) {
   other.dtype_ = DataTypeImpl::GetType<float>()->AsPrimitiveDataType();
   other.shape_ = TensorShape(std::vector<int64_t>(1, 0));
   other.p_data_ = nullptr;
   other.buffer_deleter_ = nullptr;
   other.byte_offset_ = 0;
+  other.is_string_buffer_ = false;
 }
 
 Tensor& Tensor::operator=(Tensor&& other) noexcept {
@@ -97,12 +139,14 @@ Tensor& Tensor::operator=(Tensor&& other) noexcept {
     byte_offset_ = other.byte_offset_;
     p_data_ = other.p_data_;
     buffer_deleter_ = other.buffer_deleter_;
+    is_string_buffer_ = other.is_string_buffer_;
 
     other.dtype_ = DataTypeImpl::GetType<float>()->AsPrimitiveDataType();
     other.shape_ = TensorShape(std::vector<int64_t>(1, 0));
     other.p_data_ = nullptr;
     other.byte_offset_ = 0;
     other.buffer_deleter_ = nullptr;
+    other.is_string_buffer_ = false;
   }
   return *this;
 }
@@ -115,8 +159,8 @@ void Tensor::ReleaseBuffer() {
   if (buffer_deleter_) {
     // if current tensor is responsible for deleting the buffer
     // and it is a string tensor, need to explicitly call string(s)
-    // __dtor(s).
-    if (IsDataTypeString()) {
+    // __dtor(s). The string buffer layout holds no std::string.
+    if (IsDataTypeString() && !is_string_buffer_) {
       using string = std::string;
       auto* ptr = static_cast<std::string*>(p_data_);
       int64_t len = shape_.Size();
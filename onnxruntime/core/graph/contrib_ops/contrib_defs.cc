@@ -706,9 +706,19 @@ GELU (Gaussian Error Linear Unit) approximation: Y=0.5*X*(1+tanh(0.797885*X+0.03
       .Output(0, "output", "3D output tensor with shape (batch_size, sequence_length, hidden_size)", "T")
       .Output(1, "mean", "Saved mean used during training to speed up gradient computation", "U", OpSchema::Optional)
       .Output(2, "inv_std_var", "Saved inverse standard variance used during training to speed up gradient computation.", "U", OpSchema::Optional)
+      .Output(3, "input_skip_bias_sum", "Sum of the input, skip and bias (if any), which is the input of the next residual connection. "
+              "3D tensor with shape (batch_size, sequence_length, hidden_size).", "T", OpSchema::Optional)
       .TypeConstraint("T", {"tensor(float)", "tensor(float16)"}, "Constrain input and output types to float or half tensors.")
       .TypeConstraint("U", {"tensor(float)"}, "Constrain mean and inv_std_var to float tensors.")
-      .TypeAndShapeInferenceFunction(ONNX_NAMESPACE::propagateShapeAndTypeFromFirstInput);
+      .TypeAndShapeInferenceFunction([](ONNX_NAMESPACE::InferenceContext& ctx) {
+        propagateShapeAndTypeFromFirstInput(ctx);
+        if (ctx.getNumOutputs() > 3) {
+          propagateElemTypeFromInputToOutput(ctx, 0, 3);
+          if (hasInputShape(ctx, 0)) {
+            propagateShapeFromInputToOutput(ctx, 0, 3);
+          }
+        }
+      });
 
 
   static const char* NGramRepeatBlock_ver1_doc = R"DOC(
@@ -1466,6 +1476,47 @@ activation.)DOC")
         ONNX_NAMESPACE::convPoolShapeInference(ctx, true, false, 0, 1);
       });
 
+  ONNX_CONTRIB_OPERATOR_SCHEMA(FusedBatchNormalization)
+      .SetDomain(kMSDomain)
+      .SinceVersion(1)
+      .SetDoc(R"DOC(
+The fused batch normalization operator schema is the same as BatchNormalization in inference mode
+besides it includes the attributes activation and activation_params.)DOC")
+      .Attr("epsilon", "The epsilon value to use to avoid division by zero.", AttributeProto::FLOAT, 1e-5f)
+      .Attr("activation", "", AttributeProto::STRING, OPTIONAL_VALUE)
+      .Attr("activation_params", "", AttributeProto::FLOATS, OPTIONAL_VALUE)
+      .Input(0, "X", "Input data tensor of shape (N, C, D1, D2, ..., Dn).", "T")
+      .Input(1, "scale", "Scale tensor of shape (C).", "T")
+      .Input(2, "B", "Bias tensor of shape (C).", "T")
+      .Input(3, "input_mean", "Running (estimated) mean tensor of shape (C).", "T")
+      .Input(4, "input_var", "Running (estimated) variance tensor of shape (C).", "T")
+      .Output(0, "Y", "The output tensor of the same shape as X.", "T")
+      .TypeConstraint("T", {"tensor(float)"}, "Constrain input and output types to float tensors.")
+      .TypeAndShapeInferenceFunction(ONNX_NAMESPACE::propagateShapeAndTypeFromFirstInput);
+
+  static const char* GroupNorm_ver1_doc = R"DOC(
+Applies group normalization over the input tensor of shape (N, C, D1, D2, ..., Dn). The channels are
+divided into groups and the mean and variance are computed over the channels of each group and the
+spatial dimensions of each batch:
+  Y = Activation((X - Mean) / Sqrt(Variance + epsilon) * gamma + beta)
+where gamma and beta are per channel. Instance normalization is the special case of one channel per group.)DOC";
+
+  ONNX_CONTRIB_OPERATOR_SCHEMA(GroupNorm)
+      .SetDomain(kMSDomain)
+      .SinceVersion(1)
+      .SetDoc(GroupNorm_ver1_doc)
+      .Attr("epsilon", "The epsilon value to use to avoid division by zero.", AttributeProto::FLOAT, 1e-5f)
+      .Attr("groups", "The number of groups of channels. It should be a divisor of the number of channels C.",
+            AttributeProto::INT)
+      .Attr("activation", "", AttributeProto::STRING, OPTIONAL_VALUE)
+      .Attr("activation_params", "", AttributeProto::FLOATS, OPTIONAL_VALUE)
+      .Input(0, "X", "Input data tensor of shape (N, C, D1, D2, ..., Dn).", "T")
+      .Input(1, "gamma", "Scale tensor of shape (C).", "T")
+      .Input(2, "beta", "Bias tensor of shape (C).", "T")
+      .Output(0, "Y", "The output tensor of the same shape as X.", "T")
+      .TypeConstraint("T", {"tensor(float)"}, "Constrain input and output types to float tensors.")
+      .TypeAndShapeInferenceFunction(ONNX_NAMESPACE::propagateShapeAndTypeFromFirstInput);
+
   ONNX_CONTRIB_OPERATOR_SCHEMA(FusedGemm)
       .SetDomain(kMSDomain)
       .SinceVersion(1)
@@ -2494,6 +2545,47 @@ It's an extension of Gelu. It takes the sum of input A and bias input B as the i
           "Constrain input and output types to float tensors.")
       .TypeAndShapeInferenceFunction(ONNX_NAMESPACE::propagateShapeAndTypeFromFirstInput);
 
+  static const char* FusedElementwise_ver1_doc = R"DOC(
+Evaluates a chain of elementwise operators in a single pass over the output.
+The chain is described as a small program: step i applies ops[i] to the operands
+operands[2*i] and operands[2*i+1] (the second operand is -1 for unary operators).
+Operand indices below the number of inputs refer to the inputs; an index of
+(number of inputs + j) refers to the result of step j. The result of the last step is the output.
+Every input must either have the output shape, be a scalar, or match the trailing dimensions of the output.
+Supported ops are Add, Sub, Mul, Div, Max, Min, Pow, Relu, Sigmoid, Tanh, Exp, Log, Neg, Abs, Sqrt, Reciprocal and Erf.)DOC";
+
+  ONNX_CONTRIB_OPERATOR_SCHEMA(FusedElementwise)
+      .SetDomain(kMSDomain)
+      .SinceVersion(1)
+      .SetDoc(FusedElementwise_ver1_doc)
+      .Attr("ops", "The elementwise operator applied by each step.", AttributeProto::STRINGS)
+      .Attr("operands",
+            "Two operand indices per step. Unary operators use -1 for the second operand.",
+            AttributeProto::INTS)
+      .Input(0, "inputs", "The external inputs of the fused chain.", "T", OpSchema::Variadic)
+      .Output(0, "Y", "The output.", "T")
+      .TypeConstraint(
+          "T",
+          {"tensor(float)"},
+          "Constrain input and output types to float tensors.")
+      .TypeAndShapeInferenceFunction([](ONNX_NAMESPACE::InferenceContext& ctx) {
+        propagateElemTypeFromInputToOutput(ctx, 0, 0);
+        int num_inputs = static_cast<int>(ctx.getNumInputs());
+        std::vector<const ONNX_NAMESPACE::TensorShapeProto*> shapes;
+        for (int i = 0; i < num_inputs; ++i) {
+          auto input_type = ctx.getInputType(i);
+          if (nullptr == input_type || !input_type->has_tensor_type() ||
+              !input_type->tensor_type().has_shape()) {
+            return;
+          }
+          shapes.push_back(&input_type->tensor_type().shape());
+        }
+
+        multidirectionalBroadcastShapeInference(
+            shapes,
+            *ctx.getOutputType(0)->mutable_tensor_type()->mutable_shape());
+      });
+
   // Used to be ONNX 1.7 Inverse(12)
   // Comment out docs not to increase the binary size
   //
@@ -183,6 +183,21 @@ void RegisterNchwcSchemas() {
   ONNX_CONTRIB_OPERATOR_SCHEMA(GlobalAveragePool)
       .FillUsing(NchwcGlobalPoolOpSchemaGenerator);
 
+  ONNX_CONTRIB_OPERATOR_SCHEMA(GroupNorm)
+      .SetDomain(kMSNchwcDomain)
+      .SinceVersion(1)
+      .SetDoc(R"DOC(For internal use.)DOC")
+      .Attr("epsilon", "", AttributeProto::FLOAT, 1e-5f)
+      .Attr("groups", "", AttributeProto::INT)
+      .Attr("activation", "", AttributeProto::STRING, OPTIONAL_VALUE)
+      .Attr("activation_params", "", AttributeProto::FLOATS, OPTIONAL_VALUE)
+      .Input(0, "X", "", "T")
+      .Input(1, "gamma", "", "T")
+      .Input(2, "beta", "", "T")
+      .Output(0, "Y", "", "T")
+      .TypeConstraint("T", {"tensor(float)"}, "Constrain input and output types to float tensors")
+      .TypeAndShapeInferenceFunction(ONNX_NAMESPACE::propagateShapeAndTypeFromFirstInput);
+
   ONNX_CONTRIB_OPERATOR_SCHEMA(Upsample)
       .SetDomain(kMSNchwcDomain)
       .SinceVersion(1)
@@ -737,6 +737,41 @@ MlasMaximumPool(
     size_t KernelSize
     );
 
+//
+// Reduction routines.
+//
+
+enum MLAS_REDUCTION_KIND {
+    MlasSumReduction,
+    MlasMeanReduction,
+    MlasSumSquareReduction,
+    MlasMaximumReduction,
+    MlasMinimumReduction,
+    MlasLogSumExpReduction,
+    MlasReductionKindCount,
+};
+
+void
+MLASCALL
+MlasReduceRows(
+    MLAS_REDUCTION_KIND ReductionKind,
+    const float* Input,
+    float* Output,
+    size_t Rows,
+    size_t Columns
+    );
+
+void
+MLASCALL
+MlasReduceColumns(
+    MLAS_REDUCTION_KIND ReductionKind,
+    const float* Input,
+    float* Output,
+    size_t Rows,
+    size_t Columns,
+    size_t LeadingDimension
+    );
+
 //
 // Miscellaneous compute routines.
 //
@@ -776,6 +811,57 @@ MlasComputeSoftmax(
     MLAS_THREADPOOL* ThreadPool
     );
 
+void
+MLASCALL
+MlasComputeLayerNorm(
+    const float* Input,
+    const float* Skip,
+    const float* Bias,
+    const float* Gamma,
+    const float* Beta,
+    float* Output,
+    float* SumOutput,
+    float* Mean,
+    float* InvStdDev,
+    size_t N,
+    size_t D,
+    float Epsilon,
+    bool Simplified,
+    MLAS_THREADPOOL* ThreadPool
+    );
+
+void
+MLASCALL
+MlasComputeScaleShift(
+    const float* Input,
+    const float* Scale,
+    const float* Shift,
+    float* Output,
+    size_t BatchCount,
+    size_t Channels,
+    size_t BlockSize,
+    size_t SpatialSize,
+    const MLAS_ACTIVATION* Activation,
+    MLAS_THREADPOOL* ThreadPool
+    );
+
+void
+MLASCALL
+MlasComputeGroupNorm(
+    const float* Input,
+    const float* Scale,
+    const float* Bias,
+    float* Output,
+    size_t BatchCount,
+    size_t Channels,
+    size_t BlockSize,
+    size_t SpatialSize,
+    size_t GroupCount,
+    float Epsilon,
+    const MLAS_ACTIVATION* Activation,
+    MLAS_THREADPOOL* ThreadPool
+    );
+
 void
 MLASCALL
 MlasComputeTanh(
@@ -784,6 +870,32 @@ MlasComputeTanh(
     size_t N
     );
 
+//
+// Decision tree routines.
+//
+
+enum MLAS_TREE_BRANCH_MODE {
+    MlasTreeBranchLeq,
+    MlasTreeBranchLt,
+    MlasTreeBranchGte,
+    MlasTreeBranchGt,
+    MlasTreeBranchEq,
+    MlasTreeBranchNeq,
+};
+
+void
+MLASCALL
+MlasTreeTraversePerfect(
+    const float* Input,
+    size_t InputStride,
+    size_t RowCount,
+    const int32_t* FeatureIds,
+    const float* Thresholds,
+    size_t Depth,
+    MLAS_TREE_BRANCH_MODE BranchMode,
+    uint32_t* LeafIndices
+    );
+
 //
 // Half-precision floating-point routines.
 //
@@ -0,0 +1,841 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    groupnorm.cpp
+
+Abstract:
+
+    This module implements routines to compute the channel normalizations used
+    by convolutional networks: the per channel scale and shift of inference
+    batch normalization and group normalization (of which instance
+    normalization is the special case of one channel per group).
+
+    Both routines fuse the scale and shift with an optional activation and
+    support the standard NCHW layout and the NCHWc blocked layout. For group
+    normalization, the statistics of a group are computed in a single pass
+    over the input, followed by a single pass that normalizes, scales, shifts
+    and activates the elements while they are still in the cache.
+
+--*/
+
+#include "mlasi.h"
+
+//
+// Define the maximum NCHWc block size supported by these routines.
+//
+
+#define MLAS_GROUPNORM_MAXIMUM_BLOCK_SIZE 16
+
+//
+// Structure to pass the normalization parameters to worker threads.
+//
+
+struct MLAS_GROUPNORM_WORK_BLOCK {
+    ptrdiff_t ThreadCount;
+    const float* Input;
+    const float* Scale;
+    const float* Bias;
+    float* Output;
+    const MLAS_ACTIVATION* Activation;
+    size_t BatchCount;
+    size_t Channels;
+    size_t BlockSize;
+    size_t SpatialSize;
+    size_t GroupCount;
+    float Epsilon;
+};
+
+void
+MlasScaleShiftChannel(
+    const float* Input,
+    float* Output,
+    float Offset,
+    float Scale,
+    float Shift,
+    size_t SpatialSize
+    )
+/*++
+
+Routine Description:
+
+    This routine offsets, scales and shifts the elements of a single channel
+    stored in the NCHW layout.
+
+Arguments:
+
+    Input - Supplies the input channel.
+
+    Output - Supplies the output channel.
+
+    Offset - Supplies the value subtracted from each element before scaling.
+
+    Scale - Supplies the scale for the channel.
+
+    Shift - Supplies the shift for the channel.
+
+    SpatialSize - Supplies the number of elements of the channel.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    MLAS_FLOAT32X4 OffsetVector = MlasBroadcastFloat32x4(Offset);
+    MLAS_FLOAT32X4 ScaleVector = MlasBroadcastFloat32x4(Scale);
+    MLAS_FLOAT32X4 ShiftVector = MlasBroadcastFloat32x4(Shift);
+
+    size_t n = 0;
+
+    while (n + 8 <= SpatialSize) {
+
+        MLAS_FLOAT32X4 Vector0 = MlasSubtractFloat32x4(MlasLoadFloat32x4(Input + n), OffsetVector);
+        MLAS_FLOAT32X4 Vector1 = MlasSubtractFloat32x4(MlasLoadFloat32x4(Input + n + 4), OffsetVector);
+
+        MlasStoreFloat32x4(Output + n, MlasMultiplyAddFloat32x4(Vector0, ScaleVector, ShiftVector));
+        MlasStoreFloat32x4(Output + n + 4, MlasMultiplyAddFloat32x4(Vector1, ScaleVector, ShiftVector));
+
+        n += 8;
+    }
+
+    while (n + 4 <= SpatialSize) {
+
+        MLAS_FLOAT32X4 Vector = MlasSubtractFloat32x4(MlasLoadFloat32x4(Input + n), OffsetVector);
+
+        MlasStoreFloat32x4(Output + n, MlasMultiplyAddFloat32x4(Vector, ScaleVector, ShiftVector));
+
+        n += 4;
+    }
+
+    for (; n < SpatialSize; n++) {
+        Output[n] = (Input[n] - Offset) * Scale + Shift;
+    }
+}
+
+void
+MlasScaleShiftChannelBlock(
+    const float* Input,
+    float* Output,
+    const float* Offset,
+    const float* Scale,
+    const float* Shift,
+    size_t BlockSize,
+    size_t SpatialSize
+    )
+/*++
+
+Routine Description:
+
+    This routine offsets, scales and shifts the elements of a single channel
+    block stored in the NCHWc layout.
+
+Arguments:
+
+    Input - Supplies the input channel block.
+
+    Output - Supplies the output channel block.
+
+    Offset - Supplies the value subtracted from each element of each channel
+        of the block before scaling, else nullptr if no value is subtracted.
+
+    Scale - Supplies the scale for each channel of the block.
+
+    Shift - Supplies the shift for each channel of the block.
+
+    BlockSize - Supplies the number of channels of the block.
+
+    SpatialSize - Supplies the number of elements of each channel.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    MLAS_FLOAT32X4 OffsetVector[MLAS_GROUPNORM_MAXIMUM_BLOCK_SIZE / 4];
+    MLAS_FLOAT32X4 ScaleVector[MLAS_GROUPNORM_MAXIMUM_BLOCK_SIZE / 4];
+    MLAS_FLOAT32X4 ShiftVector[MLAS_GROUPNORM_MAXIMUM_BLOCK_SIZE / 4];
+
+    const size_t VectorCount = BlockSize / 4;
+
+    for (size_t v = 0; v < VectorCount; v++) {
+        OffsetVector[v] = (Offset != nullptr) ? MlasLoadFloat32x4(Offset + v * 4) : MlasZeroFloat32x4();
+        ScaleVector[v] = MlasLoadFloat32x4(Scale + v * 4);
+        ShiftVector[v] = MlasLoadFloat32x4(Shift + v * 4);
+    }
+
+    for (size_t n = 0; n < SpatialSize; n++) {
+
+        for (size_t v = 0; v < VectorCount; v++) {
+            MLAS_FLOAT32X4 Vector = MlasSubtractFloat32x4(MlasLoadFloat32x4(Input + v * 4), OffsetVector[v]);
+            MlasStoreFloat32x4(Output + v * 4, MlasMultiplyAddFloat32x4(Vector, ScaleVector[v], ShiftVector[v]));
+        }
+
+        Input += BlockSize;
+        Output += BlockSize;
+    }
+}
+
+void
+MlasGroupNormAccumulate(
+    const float* Input,
+    size_t N,
+    float Shift,
+    float* Sum,
+    float* SumSquare
+    )
+/*++
+
+Routine Description:
+
+    This routine computes the sum and the sum of squares of the shifted
+    elements of a contiguous buffer.
+
+    Shifting the elements by a sample of the buffer keeps the sums small
+    relative to the variance, which avoids the cancellation of the single pass
+    variance formula when the mean is large relative to the deviation.
+
+Arguments:
+
+    Input - Supplies the input buffer.
+
+    N - Supplies the number of elements of the buffer.
+
+    Shift - Supplies the value subtracted from each element.
+
+    Sum - Receives the sum of the shifted elements.
+
+    SumSquare - Receives the sum of squares of the shifted elements.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    MLAS_FLOAT32X4 ShiftVector = MlasBroadcastFloat32x4(Shift);
+    MLAS_FLOAT32X4 SumVector0 = MlasZeroFloat32x4();
+    MLAS_FLOAT32X4 SumVector1 = SumVector0;
+    MLAS_FLOAT32X4 SumSquareVector0 = SumVector0;
+    MLAS_FLOAT32X4 SumSquareVector1 = SumVector0;
+
+    size_t n = 0;
+
+    while (n + 8 <= N) {
+
+        MLAS_FLOAT32X4 Vector0 = MlasSubtractFloat32x4(MlasLoadFloat32x4(Input + n), ShiftVector);
+        MLAS_FLOAT32X4 Vector1 = MlasSubtractFloat32x4(MlasLoadFloat32x4(Input + n + 4), ShiftVector);
+
+        SumVector0 = MlasAddFloat32x4(SumVector0, Vector0);
+        SumVector1 = MlasAddFloat32x4(SumVector1, Vector1);
+        SumSquareVector0 = MlasMultiplyAddFloat32x4(Vector0, Vector0, SumSquareVector0);
+        SumSquareVector1 = MlasMultiplyAddFloat32x4(Vector1, Vector1, SumSquareVector1);
+
+        n += 8;
+    }
+
+    float SumValue = MlasReduceAddFloat32x4(MlasAddFloat32x4(SumVector0, SumVector1));
+    float SumSquareValue = MlasReduceAddFloat32x4(MlasAddFloat32x4(SumSquareVector0, SumSquareVector1));
+
+    for (; n < N; n++) {
+        float Value = Input[n] - Shift;
+        SumValue += Value;
+        SumSquareValue += Value * Value;
+    }
+
+    *Sum = SumValue;
+    *SumSquare = SumSquareValue;
+}
+
+void
+MlasGroupNormAccumulateBlock(
+    const float* Input,
+    size_t BlockSize,
+    size_t SpatialSize,
+    float* Mean,
+    float* Variance
+    )
+/*++
+
+Routine Description:
+
+    This routine computes the mean and the variance of each channel of a
+    single channel block stored in the NCHWc layout.
+
+Arguments:
+
+    Input - Supplies the input channel block.
+
+    BlockSize - Supplies the number of channels of the block.
+
+    SpatialSize - Supplies the number of elements of each channel.
+
+    Mean - Receives the mean of each channel of the block.
+
+    Variance - Receives the variance of each channel of the block.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    MLAS_FLOAT32X4 ShiftVector[MLAS_GROUPNORM_MAXIMUM_BLOCK_SIZE / 4];
+    MLAS_FLOAT32X4 SumVector[MLAS_GROUPNORM_MAXIMUM_BLOCK_SIZE / 4];
+    MLAS_FLOAT32X4 SumSquareVector[MLAS_GROUPNORM_MAXIMUM_BLOCK_SIZE / 4];
+
+    const size_t VectorCount = BlockSize / 4;
+
+    //
+    // Shift each channel by its first element (see MlasGroupNormAccumulate).
+    //
+
+    for (size_t v = 0; v < VectorCount; v++) {
+        ShiftVector[v] = MlasLoadFloat32x4(Input + v * 4);
+        SumVector[v] = MlasZeroFloat32x4();
+        SumSquareVector[v] = MlasZeroFloat32x4();
+    }
+
+    for (size_t n = 0; n < SpatialSize; n++) {
+
+        for (size_t v = 0; v < VectorCount; v++) {
+            MLAS_FLOAT32X4 Vector = MlasSubtractFloat32x4(MlasLoadFloat32x4(Input + v * 4), ShiftVector[v]);
+            SumVector[v] = MlasAddFloat32x4(SumVector[v], Vector);
+            SumSquareVector[v] = MlasMultiplyAddFloat32x4(Vector, Vector, SumSquareVector[v]);
+        }
+
+        Input += BlockSize;
+    }
+
+    for (size_t v = 0; v < VectorCount; v++) {
+
+        MLAS_FLOAT32X4 MeanVector = MlasMultiplyFloat32x4(SumVector[v], MlasBroadcastFloat32x4(1.0f / SpatialSize));
+        MLAS_FLOAT32X4 VarianceVector = MlasSubtractFloat32x4(
+            MlasMultiplyFloat32x4(SumSquareVector[v], MlasBroadcastFloat32x4(1.0f / SpatialSize)),
+            MlasMultiplyFloat32x4(MeanVector, MeanVector));
+
+        MlasStoreFloat32x4(Mean + v * 4, MlasAddFloat32x4(MeanVector, ShiftVector[v]));
+        MlasStoreFloat32x4(Variance + v * 4, MlasMaximumFloat32x4(VarianceVector, MlasZeroFloat32x4()));
+    }
+}
+
+void
+MlasComputeScaleShiftThreaded(
+    void* Context,
+    ptrdiff_t Index
+    )
+/*++
+
+Routine Description:
+
+    This routine is invoked from a worker thread to execute a segment of a
+    scale and shift operation.
+
+Arguments:
+
+    Context - Supplies the pointer to the context for the threaded operation.
+
+    Index - Supplies the current index of the threaded operation.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    const auto* WorkBlock = (MLAS_GROUPNORM_WORK_BLOCK*)Context;
+
+    const size_t BlockSize = WorkBlock->BlockSize;
+    const size_t SpatialSize = WorkBlock->SpatialSize;
+    const size_t BlockCount = WorkBlock->Channels / BlockSize;
+    const size_t ElementsPerBlock = BlockSize * SpatialSize;
+
+    //
+    // Partition the operation along the batch and channel block dimensions.
+    //
+
+    size_t WorkIndex;
+    size_t WorkRemaining;
+
+    MlasPartitionWork(Index, WorkBlock->ThreadCount, WorkBlock->BatchCount * BlockCount,
+        &WorkIndex, &WorkRemaining);
+
+    const float* Input = WorkBlock->Input + WorkIndex * ElementsPerBlock;
+    float* Output = WorkBlock->Output + WorkIndex * ElementsPerBlock;
+
+    while (WorkRemaining-- > 0) {
+
+        const size_t c = (WorkIndex % BlockCount) * BlockSize;
+
+        if (BlockSize == 1) {
+            MlasScaleShiftChannel(Input, Output, 0.0f, WorkBlock->Scale[c], WorkBlock->Bias[c], SpatialSize);
+        } else {
+            MlasScaleShiftChannelBlock(Input, Output, nullptr, WorkBlock->Scale + c, WorkBlock->Bias + c,
+                BlockSize, SpatialSize);
+        }
+
+        MlasActivation(WorkBlock->Activation, Output, nullptr, 1, ElementsPerBlock, ElementsPerBlock);
+
+        Input += ElementsPerBlock;
+        Output += ElementsPerBlock;
+        WorkIndex++;
+    }
+}
+
+void
+MlasComputeGroupNormThreaded(
+    void* Context,
+    ptrdiff_t Index
+    )
+/*++
+
+Routine Description:
+
+    This routine is invoked from a worker thread to execute a segment of a
+    group normalization operation.
+
+Arguments:
+
+    Context - Supplies the pointer to the context for the threaded operation.
+
+    Index - Supplies the current index of the threaded operation.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    const auto* WorkBlock = (MLAS_GROUPNORM_WORK_BLOCK*)Context;
+
+    const size_t Channels = WorkBlock->Channels;
+    const size_t BlockSize = WorkBlock->BlockSize;
+    const size_t SpatialSize = WorkBlock->SpatialSize;
+    const size_t ChannelsPerGroup = Channels / WorkBlock->GroupCount;
+    const float Epsilon = WorkBlock->Epsilon;
+
+    //
+    // Each unit of work is a contiguous range of channels that holds whole
+    // groups: a single group for the NCHW layout or for groups spanning whole
+    // channel blocks, else a single channel block that holds several groups.
+    //
+
+    const size_t ChunkChannels = std::max(ChannelsPerGroup, BlockSize);
+    const size_t ChunkCount = Channels / ChunkChannels;
+    const size_t ElementsPerChunk = ChunkChannels * SpatialSize;
+
+    size_t WorkIndex;
+    size_t WorkRemaining;
+
+    MlasPartitionWork(Index, WorkBlock->ThreadCount, WorkBlock->BatchCount * ChunkCount,
+        &WorkIndex, &WorkRemaining);
+
+    const float* Input = WorkBlock->Input + WorkIndex * ElementsPerChunk;
+    float* Output = WorkBlock->Output + WorkIndex * ElementsPerChunk;
+
+    while (WorkRemaining-- > 0) {
+
+        const size_t ChunkChannel = (WorkIndex % ChunkCount) * ChunkChannels;
+        const float* Scale = WorkBlock->Scale + ChunkChannel;
+        const float* Bias = WorkBlock->Bias + ChunkChannel;
+
+        if (ChannelsPerGroup >= BlockSize) {
+
+            //
+            // The chunk is a single group stored contiguously in memory.
+            //
+
+            float Sum;
+            float SumSquare;
+
+            MlasGroupNormAccumulate(Input, ElementsPerChunk, Input[0], &Sum, &SumSquare);
+
+            const float MeanShifted = Sum / ElementsPerChunk;
+            const float Variance = std::max(SumSquare / ElementsPerChunk - MeanShifted * MeanShifted, 0.0f);
+            const float Mean = MeanShifted + Input[0];
+            const float InvStdDev = 1.0f / std::sqrt(Variance + Epsilon);
+
+            if (BlockSize == 1) {
+
+                for (size_t c = 0; c < ChunkChannels; c++) {
+
+                    MlasScaleShiftChannel(Input + c * SpatialSize, Output + c * SpatialSize,
+                        Mean, Scale[c] * InvStdDev, Bias[c], SpatialSize);
+
+                    MlasActivation(WorkBlock->Activation, Output + c * SpatialSize, nullptr, 1,
+                        SpatialSize, SpatialSize);
+                }
+
+            } else {
+
+                MLAS_DECLSPEC_ALIGN(float BlockOffset[MLAS_GROUPNORM_MAXIMUM_BLOCK_SIZE], 16);
+                MLAS_DECLSPEC_ALIGN(float BlockScale[MLAS_GROUPNORM_MAXIMUM_BLOCK_SIZE], 16);
+
+                const size_t ElementsPerBlock = BlockSize * SpatialSize;
+
+                std::fill_n(BlockOffset, BlockSize, Mean);
+
+                for (size_t c = 0; c < ChunkChannels; c += BlockSize) {
+
+                    for (size_t i = 0; i < BlockSize; i++) {
+                        BlockScale[i] = Scale[c + i] * InvStdDev;
+                    }
+
+                    float* BlockOutput = Output + c * SpatialSize;
+
+                    MlasScaleShiftChannelBlock(Input + c * SpatialSize, BlockOutput, BlockOffset,
+                        BlockScale, Bias + c, BlockSize, SpatialSize);
+
+                    MlasActivation(WorkBlock->Activation, BlockOutput, nullptr, 1, ElementsPerBlock,
+                        ElementsPerBlock);
+                }
+            }
+
+        } else {
+
+            //
+            // The chunk is a single channel block that holds several groups.
+            // Compute the statistics of each channel of the block and then
+            // combine the channels of each group.
+            //
+
+            MLAS_DECLSPEC_ALIGN(float ChannelMean[MLAS_GROUPNORM_MAXIMUM_BLOCK_SIZE], 16);
+            MLAS_DECLSPEC_ALIGN(float ChannelVariance[MLAS_GROUPNORM_MAXIMUM_BLOCK_SIZE], 16);
+            MLAS_DECLSPEC_ALIGN(float BlockOffset[MLAS_GROUPNORM_MAXIMUM_BLOCK_SIZE], 16);
+            MLAS_DECLSPEC_ALIGN(float BlockScale[MLAS_GROUPNORM_MAXIMUM_BLOCK_SIZE], 16);
+
+            MlasGroupNormAccumulateBlock(Input, BlockSize, SpatialSize, ChannelMean, ChannelVariance);
+
+            for (size_t g = 0; g < BlockSize; g += ChannelsPerGroup) {
+
+                //
+                // The variance of the group is the mean of the channel
+                // variances plus the variance of the channel means.
+                //
+
+                float Mean = 0.0f;
+
+                for (size_t i = g; i < g + ChannelsPerGroup; i++) {
+                    Mean += ChannelMean[i];
+                }
+
+                Mean /= ChannelsPerGroup;
+
+                float Variance = 0.0f;
+
+                for (size_t i = g; i < g + ChannelsPerGroup; i++) {
+                    const float Deviation = ChannelMean[i] - Mean;
+                    Variance += ChannelVariance[i] + Deviation * Deviation;
+                }
+
+                Variance /= ChannelsPerGroup;
+
+                const float InvStdDev = 1.0f / std::sqrt(Variance + Epsilon);
+
+                for (size_t i = g; i < g + ChannelsPerGroup; i++) {
+                    BlockOffset[i] = Mean;
+                    BlockScale[i] = Scale[i] * InvStdDev;
+                }
+            }
+
+            MlasScaleShiftChannelBlock(Input, Output, BlockOffset, BlockScale, Bias, BlockSize, SpatialSize);
+
+            MlasActivation(WorkBlock->Activation, Output, nullptr, 1, ElementsPerChunk, ElementsPerChunk);
+        }
+
+        Input += ElementsPerChunk;
+        Output += ElementsPerChunk;
+        WorkIndex++;
+    }
+}
+
+void
+MlasValidateChannelLayout(
+    size_t Channels,
+    size_t BlockSize
+    )
+/*++
+
+Routine Description:
+
+    This routine validates the channel count and block size of a tensor
+    supplied to the normalization routines.
+
+Arguments:
+
+    Channels - Supplies the number of channels.
+
+    BlockSize - Supplies the channel block size of the layout.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    if (BlockSize != 1) {
+        if (BlockSize > MLAS_GROUPNORM_MAXIMUM_BLOCK_SIZE || (BlockSize % 4) != 0 ||
+            (Channels % BlockSize) != 0) {
+#ifdef MLAS_NO_EXCEPTION
+            abort();
+#else
+            throw std::runtime_error("unsupported channel block size");
+#endif
+        }
+    }
+}
+
+ptrdiff_t
+MlasGetNormalizationThreadCount(
+    size_t WorkCount,
+    size_t ElementCount,
+    MLAS_THREADPOOL* ThreadPool
+    )
+/*++
+
+Routine Description:
+
+    This routine computes the number of target threads given the complexity
+    of a normalization operation.
+
+Arguments:
+
+    WorkCount - Supplies the number of units of work.
+
+    ElementCount - Supplies the total number of elements.
+
+    ThreadPool - Supplies the thread pool object to use.
+
+Return Value:
+
+    Returns the number of target threads.
+
+--*/
+{
+    ptrdiff_t ThreadCount = MlasGetMaximumThreadCount(ThreadPool);
+
+    if (size_t(ThreadCount) > WorkCount) {
+        ThreadCount = ptrdiff_t(WorkCount);
+    }
+
+    //
+    // Keep each thread processing a minimum number of elements before using
+    // another thread.
+    //
+
+    constexpr size_t MinimumElementsPerThread = 16384;
+
+    size_t BlockCount = (ElementCount / MinimumElementsPerThread) + 1;
+
+    if (size_t(ThreadCount) > BlockCount) {
+        ThreadCount = ptrdiff_t(BlockCount);
+    }
+
+    return ThreadCount;
+}
+
+void
+MLASCALL
+MlasComputeScaleShift(
+    const float* Input,
+    const float* Scale,
+    const float* Shift,
+    float* Output,
+    size_t BatchCount,
+    size_t Channels,
+    size_t BlockSize,
+    size_t SpatialSize,
+    const MLAS_ACTIVATION* Activation,
+    MLAS_THREADPOOL* ThreadPool
+    )
+/*++
+
+Routine Description:
+
+    This routine scales and shifts each channel of the input and applies the
+    activation:
+
+        Output = Activation(Input * Scale[c] + Shift[c])
+
+    This implements inference batch normalization once the mean, variance and
+    epsilon have been folded into the scale and shift.
+
+    N.B. This implementation supports in place updates of the output buffer.
+
+Arguments:
+
+    Input - Supplies the input buffer.
+
+    Scale - Supplies the buffer of shape [Channels] with the scale of each
+        channel.
+
+    Shift - Supplies the buffer of shape [Channels] with the shift of each
+        channel.
+
+    Output - Supplies the output buffer.
+
+    BatchCount - Supplies the number of batches.
+
+    Channels - Supplies the number of channels.
+
+    BlockSize - Supplies one if the buffers use the NCHW layout, else the
+        NCHWc block size if the buffers use the NCHWc layout.
+
+    SpatialSize - Supplies the number of elements per channel.
+
+    Activation - Supplies the parameters for the activation to apply.
+
+    ThreadPool - Supplies the thread pool object to use, else nullptr if the
+        base library threading support should be used.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    MlasValidateChannelLayout(Channels, BlockSize);
+
+    const size_t WorkCount = BatchCount * (Channels / BlockSize);
+
+    if (WorkCount == 0 || SpatialSize == 0) {
+        return;
+    }
+
+    MLAS_GROUPNORM_WORK_BLOCK WorkBlock;
+
+    WorkBlock.Input = Input;
+    WorkBlock.Scale = Scale;
+    WorkBlock.Bias = Shift;
+    WorkBlock.Output = Output;
+    WorkBlock.Activation = Activation;
+    WorkBlock.BatchCount = BatchCount;
+    WorkBlock.Channels = Channels;
+    WorkBlock.BlockSize = BlockSize;
+    WorkBlock.SpatialSize = SpatialSize;
+    WorkBlock.GroupCount = 0;
+    WorkBlock.Epsilon = 0.0f;
+    WorkBlock.ThreadCount = MlasGetNormalizationThreadCount(WorkCount,
+        BatchCount * Channels * SpatialSize, ThreadPool);
+
+    MlasExecuteThreaded(MlasComputeScaleShiftThreaded, &WorkBlock, WorkBlock.ThreadCount, ThreadPool);
+}
+
+void
+MLASCALL
+MlasComputeGroupNorm(
+    const float* Input,
+    const float* Scale,
+    const float* Bias,
+    float* Output,
+    size_t BatchCount,
+    size_t Channels,
+    size_t BlockSize,
+    size_t SpatialSize,
+    size_t GroupCount,
+    float Epsilon,
+    const MLAS_ACTIVATION* Activation,
+    MLAS_THREADPOOL* ThreadPool
+    )
+/*++
+
+Routine Description:
+
+    This routine computes the group normalization of the input and applies
+    the activation:
+
+        Output = Activation((Input - Mean[g]) / Sqrt(Variance[g] + Epsilon) * Scale[c] + Bias[c])
+
+    where the statistics are computed over the channels of each group and the
+    spatial elements of each batch. Instance normalization is the special case
+    of one channel per group.
+
+    N.B. This implementation supports in place updates of the output buffer.
+
+Arguments:
+
+    Input - Supplies the input buffer.
+
+    Scale - Supplies the buffer of shape [Channels] with the scale of each
+        channel.
+
+    Bias - Supplies the buffer of shape [Channels] with the bias of each
+        channel.
+
+    Output - Supplies the output buffer.
+
+    BatchCount - Supplies the number of batches.
+
+    Channels - Supplies the number of channels.
+
+    BlockSize - Supplies one if the buffers use the NCHW layout, else the
+        NCHWc block size if the buffers use the NCHWc layout. For the NCHWc
+        layout, the number of channels per group must be a multiple or a
+        divisor of the block size.
+
+    SpatialSize - Supplies the number of elements per channel.
+
+    GroupCount - Supplies the number of groups.
+
+    Epsilon - Supplies the value added to the variance for numerical stability.
+
+    Activation - Supplies the parameters for the activation to apply.
+
+    ThreadPool - Supplies the thread pool object to use, else nullptr if the
+        base library threading support should be used.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    if (BatchCount == 0 || Channels == 0 || SpatialSize == 0) {
+        return;
+    }
+
+    MlasValidateChannelLayout(Channels, BlockSize);
+
+    if (GroupCount == 0 || (Channels % GroupCount) != 0) {
+#ifdef MLAS_NO_EXCEPTION
+        abort();
+#else
+        throw std::runtime_error("channels must be divisible by the group count");
+#endif
+    }
+
+    const size_t ChannelsPerGroup = Channels / GroupCount;
+
+    if ((ChannelsPerGroup % BlockSize) != 0 && (BlockSize % ChannelsPerGroup) != 0) {
+#ifdef MLAS_NO_EXCEPTION
+        abort();
+#else
+        throw std::runtime_error("unsupported group size for the channel block size");
+#endif
+    }
+
+    const size_t WorkCount = BatchCount * (Channels / std::max(ChannelsPerGroup, BlockSize));
+
+    MLAS_GROUPNORM_WORK_BLOCK WorkBlock;
+
+    WorkBlock.Input = Input;
+    WorkBlock.Scale = Scale;
+    WorkBlock.Bias = Bias;
+    WorkBlock.Output = Output;
+    WorkBlock.Activation = Activation;
+    WorkBlock.BatchCount = BatchCount;
+    WorkBlock.Channels = Channels;
+    WorkBlock.BlockSize = BlockSize;
+    WorkBlock.SpatialSize = SpatialSize;
+    WorkBlock.GroupCount = GroupCount;
+    WorkBlock.Epsilon = Epsilon;
+    WorkBlock.ThreadCount = MlasGetNormalizationThreadCount(WorkCount,
+        BatchCount * Channels * SpatialSize, ThreadPool);
+
+    MlasExecuteThreaded(MlasComputeGroupNormThreaded, &WorkBlock, WorkBlock.ThreadCount, ThreadPool);
+}
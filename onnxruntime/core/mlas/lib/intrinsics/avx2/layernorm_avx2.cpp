@@ -0,0 +1,165 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    layernorm_avx2.cpp
+
+Abstract:
+
+    This module implements the kernel to compute the layer normalization of a
+    single row with AVX2/FMA3 instructions.
+
+--*/
+
+#include "mlasi.h"
+
+void
+MLASCALL
+MlasComputeLayerNormF32KernelAvx2(
+    const float* Input,
+    const float* Skip,
+    const float* Bias,
+    const float* Gamma,
+    const float* Beta,
+    float* Output,
+    float* SumOutput,
+    size_t D,
+    float Epsilon,
+    bool Simplified,
+    float* Mean,
+    float* InvStdDev
+    )
+/*++
+
+Routine Description:
+
+    This routine implements the AVX2/FMA3 kernel to compute the layer
+    normalization of a single row.
+
+    See MlasComputeLayerNormF32Kernel for the description of the arguments.
+
+--*/
+{
+    float* Values = nullptr;
+
+    if (Skip != nullptr || Bias != nullptr) {
+        Values = (SumOutput != nullptr) ? SumOutput : Output;
+    }
+
+    __m256 SumVector0 = _mm256_setzero_ps();
+    __m256 SumVector1 = SumVector0;
+    __m256 SumSquareVector0 = SumVector0;
+    __m256 SumSquareVector1 = SumVector0;
+
+    size_t d = 0;
+
+    while (d + 16 <= D) {
+
+        __m256 Vector0 = _mm256_loadu_ps(Input + d);
+        __m256 Vector1 = _mm256_loadu_ps(Input + d + 8);
+
+        if (Skip != nullptr) {
+            Vector0 = _mm256_add_ps(Vector0, _mm256_loadu_ps(Skip + d));
+            Vector1 = _mm256_add_ps(Vector1, _mm256_loadu_ps(Skip + d + 8));
+        }
+
+        if (Bias != nullptr) {
+            Vector0 = _mm256_add_ps(Vector0, _mm256_loadu_ps(Bias + d));
+            Vector1 = _mm256_add_ps(Vector1, _mm256_loadu_ps(Bias + d + 8));
+        }
+
+        if (Values != nullptr) {
+            _mm256_storeu_ps(Values + d, Vector0);
+            _mm256_storeu_ps(Values + d + 8, Vector1);
+        }
+
+        SumVector0 = _mm256_add_ps(SumVector0, Vector0);
+        SumVector1 = _mm256_add_ps(SumVector1, Vector1);
+        SumSquareVector0 = _mm256_fmadd_ps(Vector0, Vector0, SumSquareVector0);
+        SumSquareVector1 = _mm256_fmadd_ps(Vector1, Vector1, SumSquareVector1);
+
+        d += 16;
+    }
+
+    SumVector0 = _mm256_add_ps(SumVector0, SumVector1);
+    SumSquareVector0 = _mm256_add_ps(SumSquareVector0, SumSquareVector1);
+
+    float Sum = MlasReduceAddFloat32x4(
+        _mm_add_ps(_mm256_castps256_ps128(SumVector0), _mm256_extractf128_ps(SumVector0, 1)));
+    float SumSquare = MlasReduceAddFloat32x4(
+        _mm_add_ps(_mm256_castps256_ps128(SumSquareVector0), _mm256_extractf128_ps(SumSquareVector0, 1)));
+
+    for (; d < D; d++) {
+
+        float Value = Input[d];
+
+        if (Skip != nullptr) {
+            Value += Skip[d];
+        }
+
+        if (Bias != nullptr) {
+            Value += Bias[d];
+        }
+
+        if (Values != nullptr) {
+            Values[d] = Value;
+        }
+
+        Sum += Value;
+        SumSquare += Value * Value;
+    }
+
+    float MeanValue = 0.0f;
+    float Variance;
+
+    if (Simplified) {
+        Variance = SumSquare / D;
+    } else {
+        MeanValue = Sum / D;
+        Variance = std::max(SumSquare / D - MeanValue * MeanValue, 0.0f);
+    }
+
+    const float InvStdDevValue = 1.0f / std::sqrt(Variance + Epsilon);
+
+    *Mean = MeanValue;
+    *InvStdDev = InvStdDevValue;
+
+    const float* Source = (Values != nullptr) ? Values : Input;
+
+    __m256 MeanVector = _mm256_set1_ps(MeanValue);
+    __m256 InvStdDevVector = _mm256_set1_ps(InvStdDevValue);
+
+    d = 0;
+
+    while (d + 8 <= D) {
+
+        __m256 Vector = _mm256_loadu_ps(Source + d);
+
+        Vector = _mm256_mul_ps(_mm256_sub_ps(Vector, MeanVector), InvStdDevVector);
+
+        if (Beta != nullptr) {
+            Vector = _mm256_fmadd_ps(Vector, _mm256_loadu_ps(Gamma + d), _mm256_loadu_ps(Beta + d));
+        } else {
+            Vector = _mm256_mul_ps(Vector, _mm256_loadu_ps(Gamma + d));
+        }
+
+        _mm256_storeu_ps(Output + d, Vector);
+
+        d += 8;
+    }
+
+    for (; d < D; d++) {
+
+        float Value = (Source[d] - MeanValue) * InvStdDevValue * Gamma[d];
+
+        if (Beta != nullptr) {
+            Value += Beta[d];
+        }
+
+        Output[d] = Value;
+    }
+}
@@ -0,0 +1,179 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    tree_avx2.cpp
+
+Abstract:
+
+    This module implements the kernel to find the leaves reached by a set of
+    rows in a perfect decision tree with AVX2 instructions.
+
+--*/
+
+#include "mlasi.h"
+
+template<int Predicate, size_t VectorCount>
+size_t
+MlasTreeTraversePerfectKernelAvx2Vectors(
+    const float* Input,
+    size_t InputStride,
+    size_t RowCount,
+    const int32_t* FeatureIds,
+    const float* Thresholds,
+    size_t Depth,
+    uint32_t* LeafIndices
+    )
+{
+    const __m256i RowOffsets = _mm256_mullo_epi32(_mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7),
+        _mm256_set1_epi32(int32_t(InputStride)));
+    const __m256i VectorOffset = _mm256_set1_epi32(int32_t(8 * InputStride));
+    const __m256i FirstLeaf = _mm256_set1_epi32(int32_t((uint32_t(1) << Depth) - 1));
+    const __m256i Two = _mm256_set1_epi32(2);
+
+    size_t RowsRemaining = RowCount;
+
+    while (RowsRemaining >= 8 * VectorCount) {
+
+        __m256i Index[VectorCount];
+        __m256i Offsets[VectorCount];
+
+        Offsets[0] = RowOffsets;
+
+        for (size_t v = 0; v < VectorCount; v++) {
+            Index[v] = _mm256_setzero_si256();
+            if (v > 0) {
+                Offsets[v] = _mm256_add_epi32(Offsets[v - 1], VectorOffset);
+            }
+        }
+
+        //
+        // The vectors are independent of each other, interleaving them hides
+        // the latency of the gathers of each level.
+        //
+
+        for (size_t d = 0; d < Depth; d++) {
+
+            for (size_t v = 0; v < VectorCount; v++) {
+
+                __m256i Feature = _mm256_i32gather_epi32(FeatureIds, Index[v], 4);
+                __m256 Threshold = _mm256_i32gather_ps(Thresholds, Index[v], 4);
+                __m256 Value = _mm256_i32gather_ps(Input, _mm256_add_epi32(Offsets[v], Feature), 4);
+
+                //
+                // The true child is 2*i+1 and the false child is 2*i+2. The
+                // mask of the comparison is -1 for the rows that take the true
+                // branch.
+                //
+
+                __m256i Mask = _mm256_castps_si256(_mm256_cmp_ps(Value, Threshold, Predicate));
+
+                Index[v] = _mm256_add_epi32(_mm256_add_epi32(Index[v], Index[v]), _mm256_add_epi32(Two, Mask));
+            }
+        }
+
+        for (size_t v = 0; v < VectorCount; v++) {
+            _mm256_storeu_si256((__m256i*)(LeafIndices + 8 * v), _mm256_sub_epi32(Index[v], FirstLeaf));
+        }
+
+        Input += 8 * VectorCount * InputStride;
+        LeafIndices += 8 * VectorCount;
+        RowsRemaining -= 8 * VectorCount;
+    }
+
+    return RowCount - RowsRemaining;
+}
+
+template<int Predicate>
+size_t
+MlasTreeTraversePerfectKernelAvx2Impl(
+    const float* Input,
+    size_t InputStride,
+    size_t RowCount,
+    const int32_t* FeatureIds,
+    const float* Thresholds,
+    size_t Depth,
+    uint32_t* LeafIndices
+    )
+{
+    size_t CountN = MlasTreeTraversePerfectKernelAvx2Vectors<Predicate, 4>(Input, InputStride, RowCount,
+        FeatureIds, Thresholds, Depth, LeafIndices);
+
+    CountN += MlasTreeTraversePerfectKernelAvx2Vectors<Predicate, 1>(Input + CountN * InputStride, InputStride,
+        RowCount - CountN, FeatureIds, Thresholds, Depth, LeafIndices + CountN);
+
+    return CountN;
+}
+
+void
+MLASCALL
+MlasTreeTraversePerfectKernelAvx2(
+    const float* Input,
+    size_t InputStride,
+    size_t RowCount,
+    const int32_t* FeatureIds,
+    const float* Thresholds,
+    size_t Depth,
+    MLAS_TREE_BRANCH_MODE BranchMode,
+    uint32_t* LeafIndices
+    )
+/*++
+
+Routine Description:
+
+    This routine implements the AVX2 kernel to find the leaves reached by a
+    set of rows in a perfect tree.
+
+    See MlasTreeTraversePerfectKernel for the description of the arguments.
+
+--*/
+{
+    size_t CountN = 0;
+
+    //
+    // The ordered predicates are false and the unordered predicate is true
+    // for NaN, matching the scalar comparison operators.
+    //
+
+    switch (BranchMode) {
+
+        case MlasTreeBranchLeq:
+            CountN = MlasTreeTraversePerfectKernelAvx2Impl<_CMP_LE_OQ>(Input, InputStride, RowCount, FeatureIds,
+                Thresholds, Depth, LeafIndices);
+            break;
+
+        case MlasTreeBranchLt:
+            CountN = MlasTreeTraversePerfectKernelAvx2Impl<_CMP_LT_OQ>(Input, InputStride, RowCount, FeatureIds,
+                Thresholds, Depth, LeafIndices);
+            break;
+
+        case MlasTreeBranchGte:
+            CountN = MlasTreeTraversePerfectKernelAvx2Impl<_CMP_GE_OQ>(Input, InputStride, RowCount, FeatureIds,
+                Thresholds, Depth, LeafIndices);
+            break;
+
+        case MlasTreeBranchGt:
+            CountN = MlasTreeTraversePerfectKernelAvx2Impl<_CMP_GT_OQ>(Input, InputStride, RowCount, FeatureIds,
+                Thresholds, Depth, LeafIndices);
+            break;
+
+        case MlasTreeBranchEq:
+            CountN = MlasTreeTraversePerfectKernelAvx2Impl<_CMP_EQ_OQ>(Input, InputStride, RowCount, FeatureIds,
+                Thresholds, Depth, LeafIndices);
+            break;
+
+        case MlasTreeBranchNeq:
+            CountN = MlasTreeTraversePerfectKernelAvx2Impl<_CMP_NEQ_UQ>(Input, InputStride, RowCount, FeatureIds,
+                Thresholds, Depth, LeafIndices);
+            break;
+    }
+
+    if (CountN < RowCount) {
+        MlasTreeTraversePerfectKernel(Input + CountN * InputStride, InputStride, RowCount - CountN,
+            FeatureIds, Thresholds, Depth, BranchMode, LeafIndices + CountN);
+    }
+}
@@ -0,0 +1,158 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    layernorm_avx512f.cpp
+
+Abstract:
+
+    This module implements the kernel to compute the layer normalization of a
+    single row with AVX512F instructions.
+
+--*/
+
+#include "mlasi.h"
+
+void
+MLASCALL
+MlasComputeLayerNormF32KernelAvx512F(
+    const float* Input,
+    const float* Skip,
+    const float* Bias,
+    const float* Gamma,
+    const float* Beta,
+    float* Output,
+    float* SumOutput,
+    size_t D,
+    float Epsilon,
+    bool Simplified,
+    float* Mean,
+    float* InvStdDev
+    )
+/*++
+
+Routine Description:
+
+    This routine implements the AVX512F kernel to compute the layer
+    normalization of a single row. The remainder of the row is handled with
+    masked loads and stores, so no scalar loops are needed.
+
+    See MlasComputeLayerNormF32Kernel for the description of the arguments.
+
+--*/
+{
+    float* Values = nullptr;
+
+    if (Skip != nullptr || Bias != nullptr) {
+        Values = (SumOutput != nullptr) ? SumOutput : Output;
+    }
+
+    __m512 SumVector0 = _mm512_setzero_ps();
+    __m512 SumVector1 = SumVector0;
+    __m512 SumSquareVector0 = SumVector0;
+    __m512 SumSquareVector1 = SumVector0;
+
+    size_t d = 0;
+
+    while (d + 32 <= D) {
+
+        __m512 Vector0 = _mm512_loadu_ps(Input + d);
+        __m512 Vector1 = _mm512_loadu_ps(Input + d + 16);
+
+        if (Skip != nullptr) {
+            Vector0 = _mm512_add_ps(Vector0, _mm512_loadu_ps(Skip + d));
+            Vector1 = _mm512_add_ps(Vector1, _mm512_loadu_ps(Skip + d + 16));
+        }
+
+        if (Bias != nullptr) {
+            Vector0 = _mm512_add_ps(Vector0, _mm512_loadu_ps(Bias + d));
+            Vector1 = _mm512_add_ps(Vector1, _mm512_loadu_ps(Bias + d + 16));
+        }
+
+        if (Values != nullptr) {
+            _mm512_storeu_ps(Values + d, Vector0);
+            _mm512_storeu_ps(Values + d + 16, Vector1);
+        }
+
+        SumVector0 = _mm512_add_ps(SumVector0, Vector0);
+        SumVector1 = _mm512_add_ps(SumVector1, Vector1);
+        SumSquareVector0 = _mm512_fmadd_ps(Vector0, Vector0, SumSquareVector0);
+        SumSquareVector1 = _mm512_fmadd_ps(Vector1, Vector1, SumSquareVector1);
+
+        d += 32;
+    }
+
+    while (d < D) {
+
+        const size_t Count = std::min(D - d, size_t(16));
+        const __mmask16 Mask = __mmask16((uint32_t(1) << Count) - uint32_t(1));
+
+        __m512 Vector = _mm512_maskz_loadu_ps(Mask, Input + d);
+
+        if (Skip != nullptr) {
+            Vector = _mm512_add_ps(Vector, _mm512_maskz_loadu_ps(Mask, Skip + d));
+        }
+
+        if (Bias != nullptr) {
+            Vector = _mm512_add_ps(Vector, _mm512_maskz_loadu_ps(Mask, Bias + d));
+        }
+
+        if (Values != nullptr) {
+            _mm512_mask_storeu_ps(Values + d, Mask, Vector);
+        }
+
+        SumVector0 = _mm512_add_ps(SumVector0, Vector);
+        SumSquareVector0 = _mm512_fmadd_ps(Vector, Vector, SumSquareVector0);
+
+        d += Count;
+    }
+
+    const float Sum = _mm512_reduce_add_ps(_mm512_add_ps(SumVector0, SumVector1));
+    const float SumSquare = _mm512_reduce_add_ps(_mm512_add_ps(SumSquareVector0, SumSquareVector1));
+
+    float MeanValue = 0.0f;
+    float Variance;
+
+    if (Simplified) {
+        Variance = SumSquare / D;
+    } else {
+        MeanValue = Sum / D;
+        Variance = std::max(SumSquare / D - MeanValue * MeanValue, 0.0f);
+    }
+
+    const float InvStdDevValue = 1.0f / std::sqrt(Variance + Epsilon);
+
+    *Mean = MeanValue;
+    *InvStdDev = InvStdDevValue;
+
+    const float* Source = (Values != nullptr) ? Values : Input;
+
+    __m512 MeanVector = _mm512_set1_ps(MeanValue);
+    __m512 InvStdDevVector = _mm512_set1_ps(InvStdDevValue);
+
+    d = 0;
+
+    while (d < D) {
+
+        const size_t Count = std::min(D - d, size_t(16));
+        const __mmask16 Mask = __mmask16((uint32_t(1) << Count) - uint32_t(1));
+
+        __m512 Vector = _mm512_maskz_loadu_ps(Mask, Source + d);
+
+        Vector = _mm512_mul_ps(_mm512_sub_ps(Vector, MeanVector), InvStdDevVector);
+
+        if (Beta != nullptr) {
+            Vector = _mm512_fmadd_ps(Vector, _mm512_maskz_loadu_ps(Mask, Gamma + d), _mm512_maskz_loadu_ps(Mask, Beta + d));
+        } else {
+            Vector = _mm512_mul_ps(Vector, _mm512_maskz_loadu_ps(Mask, Gamma + d));
+        }
+
+        _mm512_mask_storeu_ps(Output + d, Mask, Vector);
+
+        d += Count;
+    }
+}
@@ -0,0 +1,187 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    tree_avx512f.cpp
+
+Abstract:
+
+    This module implements the kernel to find the leaves reached by a set of
+    rows in a perfect decision tree with AVX512F instructions.
+
+--*/
+
+#include "mlasi.h"
+
+template<int Predicate, size_t VectorCount>
+size_t
+MlasTreeTraversePerfectKernelAvx512FVectors(
+    const float* Input,
+    size_t InputStride,
+    size_t RowCount,
+    const int32_t* FeatureIds,
+    const float* Thresholds,
+    size_t Depth,
+    uint32_t* LeafIndices
+    )
+{
+    const __m512i RowOffsets = _mm512_mullo_epi32(
+        _mm512_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15),
+        _mm512_set1_epi32(int32_t(InputStride)));
+    const __m512i VectorOffset = _mm512_set1_epi32(int32_t(16 * InputStride));
+    const __m512i FirstLeaf = _mm512_set1_epi32(int32_t((uint32_t(1) << Depth) - 1));
+    const __m512i Zero = _mm512_setzero_si512();
+    const __m512i One = _mm512_set1_epi32(1);
+    const __m512i Two = _mm512_set1_epi32(2);
+
+    size_t RowsRemaining = RowCount;
+
+    while (RowsRemaining >= 16 * VectorCount) {
+
+        __m512i Index[VectorCount];
+        __m512i Offsets[VectorCount];
+
+        Offsets[0] = RowOffsets;
+
+        for (size_t v = 0; v < VectorCount; v++) {
+            Index[v] = Zero;
+            if (v > 0) {
+                Offsets[v] = _mm512_add_epi32(Offsets[v - 1], VectorOffset);
+            }
+        }
+
+        //
+        // The vectors are independent of each other, interleaving them hides
+        // the latency of the gathers of each level.
+        //
+
+        for (size_t d = 0; d < Depth; d++) {
+
+            for (size_t v = 0; v < VectorCount; v++) {
+
+                __m512i Feature = _mm512_mask_i32gather_epi32(Zero, 0xFFFF, Index[v], FeatureIds, 4);
+                __m512 Threshold = _mm512_mask_i32gather_ps(_mm512_castsi512_ps(Zero), 0xFFFF, Index[v],
+                    Thresholds, 4);
+                __m512 Value = _mm512_mask_i32gather_ps(_mm512_castsi512_ps(Zero), 0xFFFF,
+                    _mm512_add_epi32(Offsets[v], Feature), Input, 4);
+
+                //
+                // The true child is 2*i+1 and the false child is 2*i+2.
+                //
+
+                __mmask16 Mask = _mm512_cmp_ps_mask(Value, Threshold, Predicate);
+
+                Index[v] = _mm512_add_epi32(_mm512_add_epi32(Index[v], Index[v]), Two);
+                Index[v] = _mm512_mask_sub_epi32(Index[v], Mask, Index[v], One);
+            }
+        }
+
+        for (size_t v = 0; v < VectorCount; v++) {
+            _mm512_storeu_si512(LeafIndices + 16 * v, _mm512_sub_epi32(Index[v], FirstLeaf));
+        }
+
+        Input += 16 * VectorCount * InputStride;
+        LeafIndices += 16 * VectorCount;
+        RowsRemaining -= 16 * VectorCount;
+    }
+
+    return RowCount - RowsRemaining;
+}
+
+template<int Predicate>
+size_t
+MlasTreeTraversePerfectKernelAvx512FImpl(
+    const float* Input,
+    size_t InputStride,
+    size_t RowCount,
+    const int32_t* FeatureIds,
+    const float* Thresholds,
+    size_t Depth,
+    uint32_t* LeafIndices
+    )
+{
+    size_t CountN = MlasTreeTraversePerfectKernelAvx512FVectors<Predicate, 2>(Input, InputStride, RowCount,
+        FeatureIds, Thresholds, Depth, LeafIndices);
+
+    CountN += MlasTreeTraversePerfectKernelAvx512FVectors<Predicate, 1>(Input + CountN * InputStride,
+        InputStride, RowCount - CountN, FeatureIds, Thresholds, Depth, LeafIndices + CountN);
+
+    return CountN;
+}
+
+void
+MLASCALL
+MlasTreeTraversePerfectKernelAvx512F(
+    const float* Input,
+    size_t InputStride,
+    size_t RowCount,
+    const int32_t* FeatureIds,
+    const float* Thresholds,
+    size_t Depth,
+    MLAS_TREE_BRANCH_MODE BranchMode,
+    uint32_t* LeafIndices
+    )
+/*++
+
+Routine Description:
+
+    This routine implements the AVX512F kernel to find the leaves reached by
+    a set of rows in a perfect tree.
+
+    See MlasTreeTraversePerfectKernel for the description of the arguments.
+
+--*/
+{
+    size_t CountN = 0;
+
+    //
+    // The ordered predicates are false and the unordered predicate is true
+    // for NaN, matching the scalar comparison operators.
+    //
+
+    switch (BranchMode) {
+
+        case MlasTreeBranchLeq:
+            CountN = MlasTreeTraversePerfectKernelAvx512FImpl<_CMP_LE_OQ>(Input, InputStride, RowCount, FeatureIds,
+                Thresholds, Depth, LeafIndices);
+            break;
+
+        case MlasTreeBranchLt:
+            CountN = MlasTreeTraversePerfectKernelAvx512FImpl<_CMP_LT_OQ>(Input, InputStride, RowCount, FeatureIds,
+                Thresholds, Depth, LeafIndices);
+            break;
+
+        case MlasTreeBranchGte:
+            CountN = MlasTreeTraversePerfectKernelAvx512FImpl<_CMP_GE_OQ>(Input, InputStride, RowCount, FeatureIds,
+                Thresholds, Depth, LeafIndices);
+            break;
+
+        case MlasTreeBranchGt:
+            CountN = MlasTreeTraversePerfectKernelAvx512FImpl<_CMP_GT_OQ>(Input, InputStride, RowCount, FeatureIds,
+                Thresholds, Depth, LeafIndices);
+            break;
+
+        case MlasTreeBranchEq:
+            CountN = MlasTreeTraversePerfectKernelAvx512FImpl<_CMP_EQ_OQ>(Input, InputStride, RowCount, FeatureIds,
+                Thresholds, Depth, LeafIndices);
+            break;
+
+        case MlasTreeBranchNeq:
+            CountN = MlasTreeTraversePerfectKernelAvx512FImpl<_CMP_NEQ_UQ>(Input, InputStride, RowCount, FeatureIds,
+                Thresholds, Depth, LeafIndices);
+            break;
+    }
+
+    //
+    // The remaining rows are routed eight at a time with AVX2 instructions.
+    //
+
+    if (CountN < RowCount) {
+        MlasTreeTraversePerfectKernelAvx2(Input + CountN * InputStride, InputStride, RowCount - CountN,
+            FeatureIds, Thresholds, Depth, BranchMode, LeafIndices + CountN);
+    }
+}
@@ -0,0 +1,431 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    layernorm.cpp
+
+Abstract:
+
+    This module implements routines to compute layer normalization, optionally
+    fused with the residual (skip) connection and bias that precede it in
+    transformer models, and the simplified (RMS) variant of layer normalization.
+
+    Each row is processed in a single pass over the input that accumulates the
+    sum and the sum of squares of the elements, followed by a single pass that
+    normalizes, scales and shifts the elements.
+
+    Our usage requires building platform specific versions of the algorithm to
+    target different instruction sets. The implementation below targets the
+    base instruction set (typically SSE2) while the intrinsics implementations
+    target newer instruction sets (such as FMA3 and AVX512F).
+
+--*/
+
+#include "mlasi.h"
+
+//
+// Structure to pass the layer normalization parameters to worker threads.
+//
+
+struct MLAS_LAYERNORM_WORK_BLOCK {
+    ptrdiff_t ThreadCountN;
+    const float* Input;
+    const float* Skip;
+    const float* Bias;
+    const float* Gamma;
+    const float* Beta;
+    float* Output;
+    float* SumOutput;
+    float* Mean;
+    float* InvStdDev;
+    size_t N;
+    size_t D;
+    float Epsilon;
+    bool Simplified;
+};
+
+void
+MLASCALL
+MlasComputeLayerNormF32Kernel(
+    const float* Input,
+    const float* Skip,
+    const float* Bias,
+    const float* Gamma,
+    const float* Beta,
+    float* Output,
+    float* SumOutput,
+    size_t D,
+    float Epsilon,
+    bool Simplified,
+    float* Mean,
+    float* InvStdDev
+    )
+/*++
+
+Routine Description:
+
+    This routine implements the generic kernel to compute the layer
+    normalization of a single row.
+
+Arguments:
+
+    Input - Supplies the input row.
+
+    Skip - Optionally supplies the skip row that is added to the input.
+
+    Bias - Optionally supplies the bias that is added to the input.
+
+    Gamma - Supplies the scale.
+
+    Beta - Optionally supplies the shift.
+
+    Output - Supplies the output row.
+
+    SumOutput - Optionally supplies the row that receives the sum of the
+        input, skip and bias.
+
+    D - Supplies the number of elements in the row.
+
+    Epsilon - Supplies the value added to the variance for numerical stability.
+
+    Simplified - Supplies true to compute the root mean square normalization
+        (the mean is not subtracted), else false.
+
+    Mean - Receives the mean of the row (zero if Simplified).
+
+    InvStdDev - Receives the reciprocal of the standard deviation of the row
+        (the reciprocal of the root mean square if Simplified).
+
+Return Value:
+
+    None.
+
+--*/
+{
+    //
+    // The sum of the input, skip and bias is needed again to produce the
+    // output, so keep it in the sum output if supplied, else in the output
+    // buffer itself.
+    //
+
+    float* Values = nullptr;
+
+    if (Skip != nullptr || Bias != nullptr) {
+        Values = (SumOutput != nullptr) ? SumOutput : Output;
+    }
+
+    MLAS_FLOAT32X4 SumVector0 = MlasZeroFloat32x4();
+    MLAS_FLOAT32X4 SumVector1 = SumVector0;
+    MLAS_FLOAT32X4 SumSquareVector0 = SumVector0;
+    MLAS_FLOAT32X4 SumSquareVector1 = SumVector0;
+
+    size_t d = 0;
+
+    while (d + 8 <= D) {
+
+        MLAS_FLOAT32X4 Vector0 = MlasLoadFloat32x4(Input + d);
+        MLAS_FLOAT32X4 Vector1 = MlasLoadFloat32x4(Input + d + 4);
+
+        if (Skip != nullptr) {
+            Vector0 = MlasAddFloat32x4(Vector0, MlasLoadFloat32x4(Skip + d));
+            Vector1 = MlasAddFloat32x4(Vector1, MlasLoadFloat32x4(Skip + d + 4));
+        }
+
+        if (Bias != nullptr) {
+            Vector0 = MlasAddFloat32x4(Vector0, MlasLoadFloat32x4(Bias + d));
+            Vector1 = MlasAddFloat32x4(Vector1, MlasLoadFloat32x4(Bias + d + 4));
+        }
+
+        if (Values != nullptr) {
+            MlasStoreFloat32x4(Values + d, Vector0);
+            MlasStoreFloat32x4(Values + d + 4, Vector1);
+        }
+
+        SumVector0 = MlasAddFloat32x4(SumVector0, Vector0);
+        SumVector1 = MlasAddFloat32x4(SumVector1, Vector1);
+        SumSquareVector0 = MlasMultiplyAddFloat32x4(Vector0, Vector0, SumSquareVector0);
+        SumSquareVector1 = MlasMultiplyAddFloat32x4(Vector1, Vector1, SumSquareVector1);
+
+        d += 8;
+    }
+
+    float Sum = MlasReduceAddFloat32x4(MlasAddFloat32x4(SumVector0, SumVector1));
+    float SumSquare = MlasReduceAddFloat32x4(MlasAddFloat32x4(SumSquareVector0, SumSquareVector1));
+
+    for (; d < D; d++) {
+
+        float Value = Input[d];
+
+        if (Skip != nullptr) {
+            Value += Skip[d];
+        }
+
+        if (Bias != nullptr) {
+            Value += Bias[d];
+        }
+
+        if (Values != nullptr) {
+            Values[d] = Value;
+        }
+
+        Sum += Value;
+        SumSquare += Value * Value;
+    }
+
+    //
+    // Compute the statistics of the row.
+    //
+
+    float MeanValue = 0.0f;
+    float Variance;
+
+    if (Simplified) {
+        Variance = SumSquare / D;
+    } else {
+        MeanValue = Sum / D;
+        Variance = std::max(SumSquare / D - MeanValue * MeanValue, 0.0f);
+    }
+
+    const float InvStdDevValue = 1.0f / std::sqrt(Variance + Epsilon);
+
+    *Mean = MeanValue;
+    *InvStdDev = InvStdDevValue;
+
+    //
+    // Normalize, scale and shift the row.
+    //
+
+    const float* Source = (Values != nullptr) ? Values : Input;
+
+    MLAS_FLOAT32X4 MeanVector = MlasBroadcastFloat32x4(MeanValue);
+    MLAS_FLOAT32X4 InvStdDevVector = MlasBroadcastFloat32x4(InvStdDevValue);
+
+    d = 0;
+
+    while (d + 4 <= D) {
+
+        MLAS_FLOAT32X4 Vector = MlasLoadFloat32x4(Source + d);
+
+        Vector = MlasMultiplyFloat32x4(MlasSubtractFloat32x4(Vector, MeanVector), InvStdDevVector);
+
+        if (Beta != nullptr) {
+            Vector = MlasMultiplyAddFloat32x4(Vector, MlasLoadFloat32x4(Gamma + d), MlasLoadFloat32x4(Beta + d));
+        } else {
+            Vector = MlasMultiplyFloat32x4(Vector, MlasLoadFloat32x4(Gamma + d));
+        }
+
+        MlasStoreFloat32x4(Output + d, Vector);
+
+        d += 4;
+    }
+
+    for (; d < D; d++) {
+
+        float Value = (Source[d] - MeanValue) * InvStdDevValue * Gamma[d];
+
+        if (Beta != nullptr) {
+            Value += Beta[d];
+        }
+
+        Output[d] = Value;
+    }
+}
+
+void
+MlasComputeLayerNormThreaded(
+    void* Context,
+    ptrdiff_t Index
+    )
+/*++
+
+Routine Description:
+
+    This routine is invoked from a worker thread to execute a segment of a
+    layer normalization operation.
+
+Arguments:
+
+    Context - Supplies the pointer to the context for the threaded operation.
+
+    ThreadId - Supplies the current index of the threaded operation.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    const auto* WorkBlock = (MLAS_LAYERNORM_WORK_BLOCK*)Context;
+
+    //
+    // Partition the operation along the N dimension.
+    //
+
+    size_t n;
+    size_t CountN;
+
+    MlasPartitionWork(Index, WorkBlock->ThreadCountN, WorkBlock->N, &n, &CountN);
+
+    const size_t D = WorkBlock->D;
+
+    for (size_t i = n; i < n + CountN; i++) {
+
+        float Mean;
+        float InvStdDev;
+
+#if defined(MLAS_TARGET_AMD64)
+        MlasPlatform.ComputeLayerNormF32Kernel(
+#else
+        MlasComputeLayerNormF32Kernel(
+#endif
+            WorkBlock->Input + i * D,
+            (WorkBlock->Skip != nullptr) ? WorkBlock->Skip + i * D : nullptr,
+            WorkBlock->Bias,
+            WorkBlock->Gamma,
+            WorkBlock->Beta,
+            WorkBlock->Output + i * D,
+            (WorkBlock->SumOutput != nullptr) ? WorkBlock->SumOutput + i * D : nullptr,
+            D,
+            WorkBlock->Epsilon,
+            WorkBlock->Simplified,
+            &Mean,
+            &InvStdDev);
+
+        if (WorkBlock->Mean != nullptr) {
+            WorkBlock->Mean[i] = Mean;
+        }
+
+        if (WorkBlock->InvStdDev != nullptr) {
+            WorkBlock->InvStdDev[i] = InvStdDev;
+        }
+    }
+}
+
+void
+MLASCALL
+MlasComputeLayerNorm(
+    const float* Input,
+    const float* Skip,
+    const float* Bias,
+    const float* Gamma,
+    const float* Beta,
+    float* Output,
+    float* SumOutput,
+    float* Mean,
+    float* InvStdDev,
+    size_t N,
+    size_t D,
+    float Epsilon,
+    bool Simplified,
+    MLAS_THREADPOOL* ThreadPool
+    )
+/*++
+
+Routine Description:
+
+    This routine computes the layer normalization of each row of the input:
+
+        Sum = Input + Skip + Bias
+        Output = (Sum - Mean(Sum)) / Sqrt(Variance(Sum) + Epsilon) * Gamma + Beta
+
+    or the simplified (root mean square) layer normalization:
+
+        Output = Sum / Sqrt(Mean(Sum * Sum) + Epsilon) * Gamma
+
+    N.B. This implementation supports in place updates of the output buffer.
+
+Arguments:
+
+    Input - Supplies the input buffer of shape [N, D].
+
+    Skip - Optionally supplies the skip buffer of shape [N, D].
+
+    Bias - Optionally supplies the bias buffer of shape [D].
+
+    Gamma - Supplies the scale buffer of shape [D].
+
+    Beta - Optionally supplies the shift buffer of shape [D].
+
+    Output - Supplies the output buffer of shape [N, D].
+
+    SumOutput - Optionally supplies the buffer of shape [N, D] that receives
+        the sum of the input, skip and bias (used by the next residual
+        connection).
+
+    Mean - Optionally supplies the buffer of shape [N] that receives the mean
+        of each row.
+
+    InvStdDev - Optionally supplies the buffer of shape [N] that receives the
+        reciprocal of the standard deviation of each row.
+
+    N - Supplies the number of rows to process.
+
+    D - Supplies the number of columns per row to process.
+
+    Epsilon - Supplies the value added to the variance for numerical stability.
+
+    Simplified - Supplies true to compute the simplified (root mean square)
+        layer normalization, else false.
+
+    ThreadPool - Supplies the thread pool object to use, else nullptr if the
+        base library threading support should be used.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    if (N == 0 || D == 0) {
+        return;
+    }
+
+    MLAS_LAYERNORM_WORK_BLOCK WorkBlock;
+
+    //
+    // Capture the layer normalization parameters to the work block.
+    //
+
+    WorkBlock.Input = Input;
+    WorkBlock.Skip = Skip;
+    WorkBlock.Bias = Bias;
+    WorkBlock.Gamma = Gamma;
+    WorkBlock.Beta = Beta;
+    WorkBlock.Output = Output;
+    WorkBlock.SumOutput = SumOutput;
+    WorkBlock.Mean = Mean;
+    WorkBlock.InvStdDev = InvStdDev;
+    WorkBlock.N = N;
+    WorkBlock.D = D;
+    WorkBlock.Epsilon = Epsilon;
+    WorkBlock.Simplified = Simplified;
+
+    //
+    // Compute the number of target threads given the complexity of the
+    // operation. Limit the number of threads to the number of rows and try to
+    // keep each thread processing a minimum number of elements before using
+    // another thread.
+    //
+
+    ptrdiff_t ThreadCountN = MlasGetMaximumThreadCount(ThreadPool);
+
+    if (size_t(ThreadCountN) > N) {
+        ThreadCountN = ptrdiff_t(N);
+    }
+
+    constexpr size_t MinimumElementsPerThread = 16384;
+
+    size_t BlockCount = ((N * D) / MinimumElementsPerThread) + 1;
+
+    if (size_t(ThreadCountN) > BlockCount) {
+        ThreadCountN = ptrdiff_t(BlockCount);
+    }
+
+    WorkBlock.ThreadCountN = ThreadCountN;
+
+    MlasExecuteThreaded(MlasComputeLayerNormThreaded, &WorkBlock, ThreadCountN, ThreadPool);
+}
@@ -139,6 +139,13 @@ Abstract:
 #define MLAS_DGEMM_STRIDEN_THREAD_ALIGN             8
 #define MLAS_QGEMM_STRIDEN_THREAD_ALIGN             16
 
+//
+// Define the maximum row stride of the decision tree kernels that gather the
+// features of up to 32 rows with 32-bit offsets.
+//
+
+#define MLAS_TREE_MAXIMUM_GATHER_STRIDE             (size_t(1) << 25)
+
 //
 // Define the prototypes of the platform optimized routines.
 //
@@ -413,6 +420,36 @@ void
     size_t N
     );
 
+typedef
+void
+(MLASCALL MLAS_COMPUTE_LAYERNORM_FLOAT_KERNEL)(
+    const float* Input,
+    const float* Skip,
+    const float* Bias,
+    const float* Gamma,
+    const float* Beta,
+    float* Output,
+    float* SumOutput,
+    size_t D,
+    float Epsilon,
+    bool Simplified,
+    float* Mean,
+    float* InvStdDev
+    );
+
+typedef
+void
+(MLASCALL MLAS_TREE_TRAVERSE_PERFECT_FLOAT_KERNEL)(
+    const float* Input,
+    size_t InputStride,
+    size_t RowCount,
+    const int32_t* FeatureIds,
+    const float* Thresholds,
+    size_t Depth,
+    MLAS_TREE_BRANCH_MODE BranchMode,
+    uint32_t* LeafIndices
+    );
+
 typedef
 void
 (MLASCALL MLAS_QLINEAR_BINARY_OP_S8_KERNEL)(
@@ -599,6 +636,18 @@ extern "C" {
     MLAS_REDUCE_MINIMUM_MAXIMUM_FLOAT_KERNEL MlasReduceMinimumMaximumF32KernelAvx;
 #endif
 
+    MLAS_COMPUTE_LAYERNORM_FLOAT_KERNEL MlasComputeLayerNormF32Kernel;
+#if defined(MLAS_TARGET_AMD64)
+    MLAS_COMPUTE_LAYERNORM_FLOAT_KERNEL MlasComputeLayerNormF32KernelAvx2;
+    MLAS_COMPUTE_LAYERNORM_FLOAT_KERNEL MlasComputeLayerNormF32KernelAvx512F;
+#endif
+
+    MLAS_TREE_TRAVERSE_PERFECT_FLOAT_KERNEL MlasTreeTraversePerfectKernel;
+#if defined(MLAS_TARGET_AMD64)
+    MLAS_TREE_TRAVERSE_PERFECT_FLOAT_KERNEL MlasTreeTraversePerfectKernelAvx2;
+    MLAS_TREE_TRAVERSE_PERFECT_FLOAT_KERNEL MlasTreeTraversePerfectKernelAvx512F;
+#endif
+
 }
 
 //
@@ -734,6 +783,8 @@ struct MLAS_PLATFORM {
     MLAS_COMPUTE_LOGSOFTMAX_OUTPUT_FLOAT_KERNEL* ComputeLogSoftmaxOutputF32Kernel;
     MLAS_REDUCE_MAXIMUM_FLOAT_KERNEL* ReduceMaximumF32Kernel;
     MLAS_REDUCE_MINIMUM_MAXIMUM_FLOAT_KERNEL* ReduceMinimumMaximumF32Kernel;
+    MLAS_COMPUTE_LAYERNORM_FLOAT_KERNEL* ComputeLayerNormF32Kernel;
+    MLAS_TREE_TRAVERSE_PERFECT_FLOAT_KERNEL* TreeTraversePerfectF32Kernel;
     MLAS_QUANTIZE_LINEAR_S8_KERNEL* QuantizeLinearS8Kernel;
     MLAS_QUANTIZE_LINEAR_U8_KERNEL* QuantizeLinearU8Kernel;
     uint32_t NchwcBlockSize;
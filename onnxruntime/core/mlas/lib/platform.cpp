@@ -149,6 +149,8 @@ Return Value:
     this->ComputeLogSoftmaxOutputF32Kernel = MlasComputeLogSoftmaxOutputF32Kernel;
     this->ReduceMaximumF32Kernel = MlasReduceMaximumF32Kernel;
     this->ReduceMinimumMaximumF32Kernel = MlasReduceMinimumMaximumF32Kernel;
+    this->ComputeLayerNormF32Kernel = MlasComputeLayerNormF32Kernel;
+    this->TreeTraversePerfectF32Kernel = MlasTreeTraversePerfectKernel;
     this->QLinearAddS8Kernel = MlasQLinearAddS8Kernel;
     this->QLinearAddU8Kernel = MlasQLinearAddU8Kernel;
     this->QuantizeLinearS8Kernel = MlasQuantizeLinearS8Kernel;
@@ -250,6 +252,8 @@ Return Value:
                 this->ConvDepthwiseU8S8Kernel = MlasConvDepthwiseKernelAvx2<int8_t>;
                 this->ConvDepthwiseU8U8Kernel = MlasConvDepthwiseKernelAvx2<uint8_t>;
                 this->ComputeSumExpF32Kernel = MlasComputeSumExpF32KernelFma3;
+                this->ComputeLayerNormF32Kernel = MlasComputeLayerNormF32KernelAvx2;
+                this->TreeTraversePerfectF32Kernel = MlasTreeTraversePerfectKernelAvx2;
 
                 //
                 // Check if the processor supports Hybrid core architecture.
@@ -303,6 +307,8 @@ Return Value:
 #if !defined(MLAS_AVX512F_INTRINSICS_UNSUPPORTED)
                     this->QuantizeLinearS8Kernel = MlasQuantizeLinearS8KernelAvx512F;
                     this->QuantizeLinearU8Kernel = MlasQuantizeLinearU8KernelAvx512F;
+                    this->ComputeLayerNormF32Kernel = MlasComputeLayerNormF32KernelAvx512F;
+                    this->TreeTraversePerfectF32Kernel = MlasTreeTraversePerfectKernelAvx512F;
 #endif
 
                     //
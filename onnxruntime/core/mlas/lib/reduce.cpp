@@ -0,0 +1,734 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    reduce.cpp
+
+Abstract:
+
+    This module implements routines to reduce the rows or the columns of a
+    matrix to the sum, the mean, the sum of squares, the maximum, the minimum
+    or the logarithm of the sum of exponentials of their elements.
+
+    These routines are the inner loops of the reduction operators: once the
+    adjacent reduced (and kept) axes of the input tensor have been coalesced,
+    any reduction is a sequence of row reductions (the reduced axes are the
+    innermost axes) or column reductions (the innermost axes are kept).
+
+--*/
+
+#include "mlasi.h"
+
+//
+// Abstraction for the sum reduction.
+//
+
+struct MLAS_SUM_REDUCTION
+{
+    static float Initial(float Value)
+    {
+        return Value;
+    }
+
+    static MLAS_FLOAT32X4 Initial(MLAS_FLOAT32X4 Value)
+    {
+        return Value;
+    }
+
+    static float Accumulate(float Reduction, float Value)
+    {
+        return Reduction + Value;
+    }
+
+    static MLAS_FLOAT32X4 Accumulate(MLAS_FLOAT32X4 Reduction, MLAS_FLOAT32X4 Value)
+    {
+        return MlasAddFloat32x4(Reduction, Value);
+    }
+
+    static MLAS_FLOAT32X4 Combine(MLAS_FLOAT32X4 Reduction1, MLAS_FLOAT32X4 Reduction2)
+    {
+        return MlasAddFloat32x4(Reduction1, Reduction2);
+    }
+
+    static float Combine(MLAS_FLOAT32X4 Reduction)
+    {
+        return MlasReduceAddFloat32x4(Reduction);
+    }
+};
+
+//
+// Abstraction for the sum of squares reduction.
+//
+
+struct MLAS_SUM_SQUARE_REDUCTION : MLAS_SUM_REDUCTION
+{
+    static float Initial(float Value)
+    {
+        return Value * Value;
+    }
+
+    static MLAS_FLOAT32X4 Initial(MLAS_FLOAT32X4 Value)
+    {
+        return MlasMultiplyFloat32x4(Value, Value);
+    }
+
+    static float Accumulate(float Reduction, float Value)
+    {
+        return Reduction + Value * Value;
+    }
+
+    static MLAS_FLOAT32X4 Accumulate(MLAS_FLOAT32X4 Reduction, MLAS_FLOAT32X4 Value)
+    {
+        return MlasMultiplyAddFloat32x4(Value, Value, Reduction);
+    }
+};
+
+//
+// Abstraction for the maximum reduction.
+//
+
+struct MLAS_MAXIMUM_REDUCTION
+{
+    static float Initial(float Value)
+    {
+        return Value;
+    }
+
+    static MLAS_FLOAT32X4 Initial(MLAS_FLOAT32X4 Value)
+    {
+        return Value;
+    }
+
+    static float Accumulate(float Reduction, float Value)
+    {
+        return Value > Reduction ? Value : Reduction;
+    }
+
+    static MLAS_FLOAT32X4 Accumulate(MLAS_FLOAT32X4 Reduction, MLAS_FLOAT32X4 Value)
+    {
+        return MlasMaximumFloat32x4(Reduction, Value);
+    }
+
+    static MLAS_FLOAT32X4 Combine(MLAS_FLOAT32X4 Reduction1, MLAS_FLOAT32X4 Reduction2)
+    {
+        return MlasMaximumFloat32x4(Reduction1, Reduction2);
+    }
+
+    static float Combine(MLAS_FLOAT32X4 Reduction)
+    {
+        return MlasReduceMaximumFloat32x4(Reduction);
+    }
+};
+
+//
+// Abstraction for the minimum reduction.
+//
+
+struct MLAS_MINIMUM_REDUCTION
+{
+    static float Initial(float Value)
+    {
+        return Value;
+    }
+
+    static MLAS_FLOAT32X4 Initial(MLAS_FLOAT32X4 Value)
+    {
+        return Value;
+    }
+
+    static float Accumulate(float Reduction, float Value)
+    {
+        return Value < Reduction ? Value : Reduction;
+    }
+
+    static MLAS_FLOAT32X4 Accumulate(MLAS_FLOAT32X4 Reduction, MLAS_FLOAT32X4 Value)
+    {
+        return MlasMinimumFloat32x4(Reduction, Value);
+    }
+
+    static MLAS_FLOAT32X4 Combine(MLAS_FLOAT32X4 Reduction1, MLAS_FLOAT32X4 Reduction2)
+    {
+        return MlasMinimumFloat32x4(Reduction1, Reduction2);
+    }
+
+    static float Combine(MLAS_FLOAT32X4 Reduction)
+    {
+        return MlasReduceMinimumFloat32x4(Reduction);
+    }
+};
+
+//
+// Number of columns processed at a time by the log-sum-exp column reduction.
+//
+
+#define MLAS_REDUCE_LOGSUMEXP_COLUMNS       64
+
+template<typename Reduction>
+float
+MlasReduceRowKernel(
+    const float* Input,
+    size_t N
+    )
+/*++
+
+Routine Description:
+
+    This routine reduces a row of elements.
+
+Arguments:
+
+    Input - Supplies the input row.
+
+    N - Supplies the number of elements in the row (at least one).
+
+Return Value:
+
+    Returns the reduction of the row.
+
+--*/
+{
+    float Value;
+
+    if (N >= 4) {
+
+        MLAS_FLOAT32X4 Reduction0 = Reduction::Initial(MlasLoadFloat32x4(Input));
+
+        Input += 4;
+        N -= 4;
+
+        //
+        // Use independent accumulators for long rows to hide the latency of
+        // the reduction operation.
+        //
+
+        if (N >= 12) {
+
+            MLAS_FLOAT32X4 Reduction1 = Reduction::Initial(MlasLoadFloat32x4(Input));
+            MLAS_FLOAT32X4 Reduction2 = Reduction::Initial(MlasLoadFloat32x4(Input + 4));
+            MLAS_FLOAT32X4 Reduction3 = Reduction::Initial(MlasLoadFloat32x4(Input + 8));
+
+            Input += 12;
+            N -= 12;
+
+            while (N >= 16) {
+
+                Reduction0 = Reduction::Accumulate(Reduction0, MlasLoadFloat32x4(Input));
+                Reduction1 = Reduction::Accumulate(Reduction1, MlasLoadFloat32x4(Input + 4));
+                Reduction2 = Reduction::Accumulate(Reduction2, MlasLoadFloat32x4(Input + 8));
+                Reduction3 = Reduction::Accumulate(Reduction3, MlasLoadFloat32x4(Input + 12));
+
+                Input += 16;
+                N -= 16;
+            }
+
+            Reduction0 = Reduction::Combine(Reduction0, Reduction1);
+            Reduction2 = Reduction::Combine(Reduction2, Reduction3);
+            Reduction0 = Reduction::Combine(Reduction0, Reduction2);
+        }
+
+        while (N >= 4) {
+
+            Reduction0 = Reduction::Accumulate(Reduction0, MlasLoadFloat32x4(Input));
+
+            Input += 4;
+            N -= 4;
+        }
+
+        Value = Reduction::Combine(Reduction0);
+
+    } else {
+
+        Value = Reduction::Initial(*Input);
+
+        Input += 1;
+        N -= 1;
+    }
+
+    while (N > 0) {
+
+        Value = Reduction::Accumulate(Value, *Input);
+
+        Input += 1;
+        N -= 1;
+    }
+
+    return Value;
+}
+
+template<typename Reduction>
+void
+MlasReduceColumnsKernel(
+    const float* Input,
+    float* Output,
+    size_t Rows,
+    size_t Columns,
+    size_t LeadingDimension
+    )
+/*++
+
+Routine Description:
+
+    This routine reduces the columns of a matrix.
+
+    The columns are processed in blocks that are kept in registers while the
+    rows of the block are streamed from memory, so each input element is read
+    once and each output element is written once.
+
+Arguments:
+
+    Input - Supplies the input matrix.
+
+    Output - Supplies the output row of Columns elements.
+
+    Rows - Supplies the number of rows of the matrix (at least one).
+
+    Columns - Supplies the number of columns of the matrix.
+
+    LeadingDimension - Supplies the number of elements between the start of
+        consecutive rows of the matrix.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    while (Columns >= 16) {
+
+        const float* input = Input;
+
+        MLAS_FLOAT32X4 Reduction0 = Reduction::Initial(MlasLoadFloat32x4(input));
+        MLAS_FLOAT32X4 Reduction1 = Reduction::Initial(MlasLoadFloat32x4(input + 4));
+        MLAS_FLOAT32X4 Reduction2 = Reduction::Initial(MlasLoadFloat32x4(input + 8));
+        MLAS_FLOAT32X4 Reduction3 = Reduction::Initial(MlasLoadFloat32x4(input + 12));
+
+        for (size_t r = 1; r < Rows; r++) {
+
+            input += LeadingDimension;
+
+            Reduction0 = Reduction::Accumulate(Reduction0, MlasLoadFloat32x4(input));
+            Reduction1 = Reduction::Accumulate(Reduction1, MlasLoadFloat32x4(input + 4));
+            Reduction2 = Reduction::Accumulate(Reduction2, MlasLoadFloat32x4(input + 8));
+            Reduction3 = Reduction::Accumulate(Reduction3, MlasLoadFloat32x4(input + 12));
+        }
+
+        MlasStoreFloat32x4(Output, Reduction0);
+        MlasStoreFloat32x4(Output + 4, Reduction1);
+        MlasStoreFloat32x4(Output + 8, Reduction2);
+        MlasStoreFloat32x4(Output + 12, Reduction3);
+
+        Input += 16;
+        Output += 16;
+        Columns -= 16;
+    }
+
+    while (Columns >= 4) {
+
+        const float* input = Input;
+
+        MLAS_FLOAT32X4 Reduction0 = Reduction::Initial(MlasLoadFloat32x4(input));
+
+        for (size_t r = 1; r < Rows; r++) {
+            input += LeadingDimension;
+            Reduction0 = Reduction::Accumulate(Reduction0, MlasLoadFloat32x4(input));
+        }
+
+        MlasStoreFloat32x4(Output, Reduction0);
+
+        Input += 4;
+        Output += 4;
+        Columns -= 4;
+    }
+
+    while (Columns > 0) {
+
+        const float* input = Input;
+
+        float Value = Reduction::Initial(*input);
+
+        for (size_t r = 1; r < Rows; r++) {
+            input += LeadingDimension;
+            Value = Reduction::Accumulate(Value, *input);
+        }
+
+        *Output = Value;
+
+        Input += 1;
+        Output += 1;
+        Columns -= 1;
+    }
+}
+
+float
+MlasReduceLogSumExpNonFinite(
+    const float* Input,
+    size_t N,
+    size_t Stride
+    )
+/*++
+
+Routine Description:
+
+    This routine computes the logarithm of the sum of the exponentials of a
+    vector that contains infinities or NaNs.
+
+    The elements are shifted by the largest finite element (instead of the
+    maximum element) before computing the exponentials, which is the
+    behavior of the reference implementation of the operator.
+
+Arguments:
+
+    Input - Supplies the input vector.
+
+    N - Supplies the number of elements in the vector (at least one).
+
+    Stride - Supplies the number of elements between consecutive elements of
+        the vector.
+
+Return Value:
+
+    Returns the logarithm of the sum of the exponentials of the vector.
+
+--*/
+{
+    float Shift = std::isinf(Input[0]) ? 0.0f : Input[0];
+
+    for (size_t n = 0; n < N; n++) {
+
+        float Value = Input[n * Stride];
+
+        if (!std::isinf(Value) && !std::isnan(Value) && !(Value < Shift)) {
+            Shift = Value;
+        }
+    }
+
+    float Accumulation = 0.0f;
+
+    for (size_t n = 0; n < N; n++) {
+        Accumulation += std::exp(Input[n * Stride] - Shift);
+    }
+
+    return std::log(Accumulation) + Shift;
+}
+
+float
+MlasReduceLogSumExpRow(
+    const float* Input,
+    size_t N
+    )
+/*++
+
+Routine Description:
+
+    This routine computes the logarithm of the sum of the exponentials of a
+    row of elements.
+
+Arguments:
+
+    Input - Supplies the input row.
+
+    N - Supplies the number of elements in the row (at least one).
+
+Return Value:
+
+    Returns the logarithm of the sum of the exponentials of the row.
+
+--*/
+{
+    float Maximum = MlasReduceRowKernel<MLAS_MAXIMUM_REDUCTION>(Input, N);
+
+    if (!std::isfinite(Maximum)) {
+        return MlasReduceLogSumExpNonFinite(Input, N, 1);
+    }
+
+    float NegativeMaximum = -Maximum;
+
+#if defined(MLAS_TARGET_AMD64)
+    float Accumulation = MlasPlatform.ComputeSumExpF32Kernel(Input, nullptr, N, &NegativeMaximum);
+#else
+    float Accumulation = MlasComputeSumExpF32Kernel(Input, nullptr, N, &NegativeMaximum);
+#endif
+
+    return std::log(Accumulation) + Maximum;
+}
+
+void
+MlasReduceLogSumExpColumns(
+    const float* Input,
+    float* Output,
+    size_t Rows,
+    size_t Columns,
+    size_t LeadingDimension
+    )
+/*++
+
+Routine Description:
+
+    This routine computes the logarithm of the sum of the exponentials of the
+    columns of a matrix.
+
+Arguments:
+
+    Input - Supplies the input matrix.
+
+    Output - Supplies the output row of Columns elements.
+
+    Rows - Supplies the number of rows of the matrix (at least one).
+
+    Columns - Supplies the number of columns of the matrix.
+
+    LeadingDimension - Supplies the number of elements between the start of
+        consecutive rows of the matrix.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    MLAS_DECLSPEC_ALIGN(float Buffer[MLAS_REDUCE_LOGSUMEXP_COLUMNS], sizeof(MLAS_FLOAT32X4));
+    MLAS_DECLSPEC_ALIGN(float Accumulation[MLAS_REDUCE_LOGSUMEXP_COLUMNS], sizeof(MLAS_FLOAT32X4));
+
+    while (Columns > 0) {
+
+        const size_t CountN = std::min(Columns, size_t(MLAS_REDUCE_LOGSUMEXP_COLUMNS));
+
+        //
+        // Find the maximum value of each column of the block, keeping it in
+        // the output buffer.
+        //
+
+        MlasReduceColumnsKernel<MLAS_MAXIMUM_REDUCTION>(Input, Output, Rows, CountN, LeadingDimension);
+
+        std::fill_n(Accumulation, CountN, 0.0f);
+
+        //
+        // Accumulate the exponentials of the rows of the block shifted by the
+        // maximum values.
+        //
+
+        const float* input = Input;
+
+        for (size_t r = 0; r < Rows; r++) {
+
+            size_t n = 0;
+
+            for (; n + 4 <= CountN; n += 4) {
+                MlasStoreAlignedFloat32x4(&Buffer[n],
+                    MlasSubtractFloat32x4(MlasLoadFloat32x4(input + n), MlasLoadFloat32x4(Output + n)));
+            }
+
+            for (; n < CountN; n++) {
+                Buffer[n] = input[n] - Output[n];
+            }
+
+            MlasComputeExp(Buffer, Buffer, CountN);
+
+            n = 0;
+
+            for (; n + 4 <= CountN; n += 4) {
+                MlasStoreAlignedFloat32x4(&Accumulation[n],
+                    MlasAddFloat32x4(MlasLoadFloat32x4(&Accumulation[n]), MlasLoadFloat32x4(&Buffer[n])));
+            }
+
+            for (; n < CountN; n++) {
+                Accumulation[n] += Buffer[n];
+            }
+
+            input += LeadingDimension;
+        }
+
+        for (size_t n = 0; n < CountN; n++) {
+
+            if (std::isfinite(Output[n])) {
+                Output[n] = std::log(Accumulation[n]) + Output[n];
+            } else {
+                Output[n] = MlasReduceLogSumExpNonFinite(Input + n, Rows, LeadingDimension);
+            }
+        }
+
+        Input += CountN;
+        Output += CountN;
+        Columns -= CountN;
+    }
+}
+
+void
+MLASCALL
+MlasReduceRows(
+    MLAS_REDUCTION_KIND ReductionKind,
+    const float* Input,
+    float* Output,
+    size_t Rows,
+    size_t Columns
+    )
+/*++
+
+Routine Description:
+
+    This routine reduces each row of a matrix to a single element.
+
+Arguments:
+
+    ReductionKind - Supplies the kind of reduction operation to perform.
+
+    Input - Supplies the input matrix of shape [Rows, Columns].
+
+    Output - Supplies the output buffer of shape [Rows].
+
+    Rows - Supplies the number of rows of the matrix.
+
+    Columns - Supplies the number of columns of the matrix (at least one).
+
+Return Value:
+
+    None.
+
+--*/
+{
+    for (size_t r = 0; r < Rows; r++) {
+
+        float Value;
+
+        switch (ReductionKind) {
+
+            case MlasSumReduction:
+            {
+                Value = MlasReduceRowKernel<MLAS_SUM_REDUCTION>(Input, Columns);
+                break;
+            }
+
+            case MlasMeanReduction:
+            {
+                Value = MlasReduceRowKernel<MLAS_SUM_REDUCTION>(Input, Columns) / float(Columns);
+                break;
+            }
+
+            case MlasSumSquareReduction:
+            {
+                Value = MlasReduceRowKernel<MLAS_SUM_SQUARE_REDUCTION>(Input, Columns);
+                break;
+            }
+
+            case MlasMaximumReduction:
+            {
+                Value = MlasReduceRowKernel<MLAS_MAXIMUM_REDUCTION>(Input, Columns);
+                break;
+            }
+
+            case MlasMinimumReduction:
+            {
+                Value = MlasReduceRowKernel<MLAS_MINIMUM_REDUCTION>(Input, Columns);
+                break;
+            }
+
+            case MlasLogSumExpReduction:
+            {
+                Value = MlasReduceLogSumExpRow(Input, Columns);
+                break;
+            }
+
+            default:
+#ifdef MLAS_NO_EXCEPTION
+                abort();
+#else
+                throw std::runtime_error("bad reduction kind");
+#endif
+        }
+
+        Output[r] = Value;
+        Input += Columns;
+    }
+}
+
+void
+MLASCALL
+MlasReduceColumns(
+    MLAS_REDUCTION_KIND ReductionKind,
+    const float* Input,
+    float* Output,
+    size_t Rows,
+    size_t Columns,
+    size_t LeadingDimension
+    )
+/*++
+
+Routine Description:
+
+    This routine reduces each column of a matrix to a single element.
+
+Arguments:
+
+    ReductionKind - Supplies the kind of reduction operation to perform.
+
+    Input - Supplies the input matrix of shape [Rows, Columns].
+
+    Output - Supplies the output buffer of shape [Columns].
+
+    Rows - Supplies the number of rows of the matrix (at least one).
+
+    Columns - Supplies the number of columns of the matrix.
+
+    LeadingDimension - Supplies the number of elements between the start of
+        consecutive rows of the matrix.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    switch (ReductionKind) {
+
+        case MlasSumReduction:
+        {
+            MlasReduceColumnsKernel<MLAS_SUM_REDUCTION>(Input, Output, Rows, Columns, LeadingDimension);
+            break;
+        }
+
+        case MlasMeanReduction:
+        {
+            MlasReduceColumnsKernel<MLAS_SUM_REDUCTION>(Input, Output, Rows, Columns, LeadingDimension);
+
+            for (size_t n = 0; n < Columns; n++) {
+                Output[n] /= float(Rows);
+            }
+            break;
+        }
+
+        case MlasSumSquareReduction:
+        {
+            MlasReduceColumnsKernel<MLAS_SUM_SQUARE_REDUCTION>(Input, Output, Rows, Columns, LeadingDimension);
+            break;
+        }
+
+        case MlasMaximumReduction:
+        {
+            MlasReduceColumnsKernel<MLAS_MAXIMUM_REDUCTION>(Input, Output, Rows, Columns, LeadingDimension);
+            break;
+        }
+
+        case MlasMinimumReduction:
+        {
+            MlasReduceColumnsKernel<MLAS_MINIMUM_REDUCTION>(Input, Output, Rows, Columns, LeadingDimension);
+            break;
+        }
+
+        case MlasLogSumExpReduction:
+        {
+            MlasReduceLogSumExpColumns(Input, Output, Rows, Columns, LeadingDimension);
+            break;
+        }
+
+        default:
+#ifdef MLAS_NO_EXCEPTION
+            abort();
+#else
+            throw std::runtime_error("bad reduction kind");
+#endif
+    }
+}
@@ -0,0 +1,212 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    tree.cpp
+
+Abstract:
+
+    This module implements routines to evaluate decision trees.
+
+    A perfect tree is a complete binary tree where every leaf is at the same
+    depth. Its decision nodes are stored in breadth-first order, so the true
+    and false children of node i are nodes 2*i+1 and 2*i+2 and the leaves can
+    be numbered from left to right. A row is then routed through the tree with
+    one branch-free step per level, which allows evaluating several rows at
+    once with gather instructions.
+
+    Our usage requires building platform specific versions of the algorithm to
+    target different instruction sets. The implementation below targets the
+    base instruction set (typically SSE2) while the intrinsics implementations
+    target newer instruction sets (such as AVX2 and AVX512F).
+
+--*/
+
+#include "mlasi.h"
+
+//
+// Number of rows routed together through the tree by the generic kernel.
+//
+
+constexpr size_t MLAS_TREE_ROW_BLOCK = 16;
+
+template<typename Compare>
+void
+MlasTreeTraversePerfectKernelImpl(
+    const float* Input,
+    size_t InputStride,
+    size_t RowCount,
+    const int32_t* FeatureIds,
+    const float* Thresholds,
+    size_t Depth,
+    uint32_t* LeafIndices,
+    Compare Cmp
+    )
+{
+    const uint32_t FirstLeaf = (uint32_t(1) << Depth) - 1;
+
+    while (RowCount > 0) {
+
+        const size_t CountN = std::min(RowCount, MLAS_TREE_ROW_BLOCK);
+        uint32_t Index[MLAS_TREE_ROW_BLOCK];
+
+        for (size_t n = 0; n < CountN; n++) {
+            Index[n] = 0;
+        }
+
+        //
+        // Move every row of the block one level down per pass: the loads of
+        // the rows are independent of each other.
+        //
+
+        for (size_t d = 0; d < Depth; d++) {
+
+            for (size_t n = 0; n < CountN; n++) {
+
+                const uint32_t i = Index[n];
+                const float Value = Input[n * InputStride + FeatureIds[i]];
+
+                Index[n] = 2 * i + (Cmp(Value, Thresholds[i]) ? 1 : 2);
+            }
+        }
+
+        for (size_t n = 0; n < CountN; n++) {
+            LeafIndices[n] = Index[n] - FirstLeaf;
+        }
+
+        Input += CountN * InputStride;
+        LeafIndices += CountN;
+        RowCount -= CountN;
+    }
+}
+
+void
+MLASCALL
+MlasTreeTraversePerfectKernel(
+    const float* Input,
+    size_t InputStride,
+    size_t RowCount,
+    const int32_t* FeatureIds,
+    const float* Thresholds,
+    size_t Depth,
+    MLAS_TREE_BRANCH_MODE BranchMode,
+    uint32_t* LeafIndices
+    )
+/*++
+
+Routine Description:
+
+    This routine implements the generic kernel to find the leaves reached by
+    a set of rows in a perfect tree.
+
+Arguments:
+
+    Input - Supplies the input rows.
+
+    InputStride - Supplies the number of elements between two rows.
+
+    RowCount - Supplies the number of rows.
+
+    FeatureIds - Supplies the feature index tested by each decision node, in
+        breadth-first order.
+
+    Thresholds - Supplies the threshold of each decision node, in
+        breadth-first order.
+
+    Depth - Supplies the depth of the tree.
+
+    BranchMode - Supplies the comparison of every decision node. The row
+        follows the true branch if the comparison of the feature with the
+        threshold is true.
+
+    LeafIndices - Returns the index of the leaf reached by each row, from 0
+        to 2^Depth-1 in left to right order.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    switch (BranchMode) {
+
+        case MlasTreeBranchLeq:
+            MlasTreeTraversePerfectKernelImpl(Input, InputStride, RowCount, FeatureIds, Thresholds, Depth,
+                LeafIndices, [](float v, float t) { return v <= t; });
+            break;
+
+        case MlasTreeBranchLt:
+            MlasTreeTraversePerfectKernelImpl(Input, InputStride, RowCount, FeatureIds, Thresholds, Depth,
+                LeafIndices, [](float v, float t) { return v < t; });
+            break;
+
+        case MlasTreeBranchGte:
+            MlasTreeTraversePerfectKernelImpl(Input, InputStride, RowCount, FeatureIds, Thresholds, Depth,
+                LeafIndices, [](float v, float t) { return v >= t; });
+            break;
+
+        case MlasTreeBranchGt:
+            MlasTreeTraversePerfectKernelImpl(Input, InputStride, RowCount, FeatureIds, Thresholds, Depth,
+                LeafIndices, [](float v, float t) { return v > t; });
+            break;
+
+        case MlasTreeBranchEq:
+            MlasTreeTraversePerfectKernelImpl(Input, InputStride, RowCount, FeatureIds, Thresholds, Depth,
+                LeafIndices, [](float v, float t) { return v == t; });
+            break;
+
+        case MlasTreeBranchNeq:
+            MlasTreeTraversePerfectKernelImpl(Input, InputStride, RowCount, FeatureIds, Thresholds, Depth,
+                LeafIndices, [](float v, float t) { return v != t; });
+            break;
+    }
+}
+
+void
+MLASCALL
+MlasTreeTraversePerfect(
+    const float* Input,
+    size_t InputStride,
+    size_t RowCount,
+    const int32_t* FeatureIds,
+    const float* Thresholds,
+    size_t Depth,
+    MLAS_TREE_BRANCH_MODE BranchMode,
+    uint32_t* LeafIndices
+    )
+/*++
+
+Routine Description:
+
+    This routine finds the leaves reached by a set of rows in a perfect tree.
+
+Arguments:
+
+    See MlasTreeTraversePerfectKernel for the description of the arguments.
+
+Return Value:
+
+    None.
+
+--*/
+{
+#if defined(MLAS_TARGET_AMD64)
+    //
+    // The intrinsics kernels gather the features of a group of rows with
+    // 32-bit offsets from the first row of the group.
+    //
+
+    if (InputStride <= MLAS_TREE_MAXIMUM_GATHER_STRIDE) {
+        MlasPlatform.TreeTraversePerfectF32Kernel(Input, InputStride, RowCount, FeatureIds, Thresholds,
+            Depth, BranchMode, LeafIndices);
+        return;
+    }
+#endif
+
+    MlasTreeTraversePerfectKernel(Input, InputStride, RowCount, FeatureIds, Thresholds, Depth,
+        BranchMode, LeafIndices);
+}
@@ -2,10 +2,13 @@
 // Licensed under the MIT License.
 
 #include "common_subexpression_elimination.h"
+#include "core/framework/tensorprotoutils.h"
 #include "core/optimizer/utils.h"
 #include "core/graph/graph_utils.h"
 
+#include <cstring>
 #include <memory>
+#include <string_view>
 #include <type_traits>
 #include <unordered_map>
 #include <unordered_set>
@@ -32,6 +35,12 @@
 // first every graph input, constant initializer and graph node output are assigned
 // an equivalence class, and then nodes that have the same operation and equivalent inputs
 // are collapsed.
+//
+// Constant initializers with the same type, shape and contents are merged before value numbering, so
+// that duplicated weights are only stored once and the nodes that consume them can be collapsed too.
+//
+// Subgraphs are processed with the value numbering of the enclosing graphs, so a node in a subgraph
+// that recomputes a value that is already available in an outer scope is replaced by that value.
 
 namespace onnxruntime {
 
@@ -129,8 +138,8 @@ class EquivalenceClass {
 
   // When the value is not an output of an operation, (i.e., a constant initializer or an input),
   // non_op_value is set to the corresponding NodeArg, and other fields are empty.
-  // Currently, different inputs/initializers are always considered different values, although we
-  // could merge equal initializers.
+  // Different inputs/initializers are always considered different values. Equal initializers are
+  // merged into one by DeduplicateInitializers before value numbering.
   const NodeArg* non_op_value_;
 
   // When an operation is not supported by the CSE optimization pass, we consider its
@@ -299,10 +308,12 @@ std::size_t EquivalenceClass::CalculateHash() const {
 // Representative of an equivalence class.
 // node_index and output_index define the node that produced the node_arg.
 // For inputs and constant initializers, output_index == kInvalidOutputIndex.
+// If outer_scope is true the node_arg belongs to an enclosing graph and node_index is not used.
 struct Representative {
   const NodeArg* node_arg;
   NodeIndex node_index;
   OutputIndex output_index;
+  bool outer_scope = false;
 };
 
 struct NodeArgPtrHash {
@@ -320,6 +331,132 @@ struct NodeArgPtrEquality {
 bool IsNodeSupported(const Node& node) {
   return !node.ContainsSubgraph() && optimizer_utils::IsOperationDeterministic(node.Domain(), node.OpType());
 }
+
+// Returns true if the value is an input, initializer or node output of the graph itself rather than
+// an outer scope value.
+bool IsDefinedInGraph(const Graph& graph, const std::string& name) {
+  const NodeArg* node_arg = graph.GetNodeArg(name);
+  return node_arg != nullptr &&
+         (graph.GetProducerNode(name) != nullptr || graph.IsInitializedTensor(name) ||
+          graph.IsInputsIncludingInitializers(node_arg));
+}
+
+// Contents of an initializer. Points to the raw data of the TensorProto if possible, otherwise to an unpacked copy.
+struct InitializerData {
+  const ONNX_NAMESPACE::TensorProto* tensor_proto;
+  std::unique_ptr<unsigned char[]> unpacked;
+  const char* data;
+  size_t size;
+
+  bool SameContents(const InitializerData& other) const {
+    return tensor_proto->data_type() == other.tensor_proto->data_type() &&
+           AreRangesEqual(tensor_proto->dims(), other.tensor_proto->dims()) &&
+           size == other.size && (size == 0 || std::memcmp(data, other.data, size) == 0);
+  }
+};
+
+bool GetInitializerData(const Graph& graph, const ONNX_NAMESPACE::TensorProto& tensor_proto, InitializerData& result) {
+  result.tensor_proto = &tensor_proto;
+  if (utils::HasRawData(tensor_proto)) {
+    result.data = tensor_proto.raw_data().data();
+    result.size = tensor_proto.raw_data().size();
+    return true;
+  }
+
+  if (!utils::UnpackInitializerData(tensor_proto, graph.ModelPath(), result.unpacked, result.size).IsOK()) {
+    return false;
+  }
+
+  result.data = reinterpret_cast<const char*>(result.unpacked.get());
+  return true;
+}
+
+// Merge constant initializers that have the same type, shape and contents, so that every consumer
+// uses the first of them and the others can be removed.
+bool DeduplicateInitializers(Graph& graph, const logging::Logger& logger) {
+  // values used by subgraphs are referenced by name from inside them, so leave those alone
+  std::unordered_set<std::string> implicit_inputs;
+  for (const auto& node : graph.Nodes()) {
+    for (const NodeArg* implicit_input : node.ImplicitInputDefs()) {
+      implicit_inputs.insert(implicit_input->Name());
+    }
+  }
+
+  // Group by type and shape first so only the contents of plausible duplicates are read.
+  std::unordered_map<std::string, std::vector<const ONNX_NAMESPACE::TensorProto*>> candidates;
+  for (const auto& entry : graph.GetAllInitializedTensors()) {
+    const ONNX_NAMESPACE::TensorProto& tensor_proto = *entry.second;
+    const NodeArg* node_arg = graph.GetNodeArg(entry.first);
+    if (tensor_proto.data_type() == ONNX_NAMESPACE::TensorProto_DataType_STRING ||
+        node_arg == nullptr || graph.IsOutput(node_arg) || implicit_inputs.count(entry.first) != 0 ||
+        !graph_utils::IsConstantInitializer(graph, entry.first, false)) {
+      continue;
+    }
+
+    std::string key = std::to_string(tensor_proto.data_type());
+    for (auto dim : tensor_proto.dims()) {
+      key += ',' + std::to_string(dim);
+    }
+    candidates[key].push_back(&tensor_proto);
+  }
+
+  bool modified = false;
+  for (auto& entry : candidates) {
+    auto& group = entry.second;
+    if (group.size() < 2) {
+      continue;
+    }
+
+    // the initializer map is unordered, so sort by name to pick a deterministic representative
+    std::sort(group.begin(), group.end(),
+              [](const ONNX_NAMESPACE::TensorProto* lhs, const ONNX_NAMESPACE::TensorProto* rhs) {
+                return lhs->name() < rhs->name();
+              });
+
+    std::unordered_map<std::size_t, std::vector<InitializerData>> representatives;
+    std::vector<std::pair<std::string, std::string>> replacements;
+    for (const ONNX_NAMESPACE::TensorProto* tensor_proto : group) {
+      InitializerData data;
+      if (!GetInitializerData(graph, *tensor_proto, data)) {
+        continue;
+      }
+
+      auto& same_hash = representatives[std::hash<std::string_view>{}(std::string_view(data.data, data.size))];
+      auto it = std::find_if(same_hash.begin(), same_hash.end(),
+                             [&data](const InitializerData& other) { return data.SameContents(other); });
+      if (it == same_hash.end()) {
+        same_hash.push_back(std::move(data));
+      } else {
+        replacements.emplace_back(tensor_proto->name(), it->tensor_proto->name());
+      }
+    }
+
+    for (const auto& replacement : replacements) {
+      const std::string& duplicate_name = replacement.first;
+      const std::string& representative_name = replacement.second;
+      NodeArg& representative_arg = *graph.GetNodeArg(representative_name);
+
+      for (Node* consumer : graph.GetMutableConsumerNodes(duplicate_name)) {
+        auto& input_defs = consumer->MutableInputDefs();
+        for (int i = 0, end = static_cast<int>(input_defs.size()); i < end; ++i) {
+          if (input_defs[i]->Name() == duplicate_name) {
+            graph_utils::ReplaceNodeInput(*consumer, i, representative_arg);
+          }
+        }
+
+        graph.RemoveConsumerNode(duplicate_name, consumer);
+        graph.AddConsumerNode(representative_name, consumer);
+      }
+
+      LOGS(logger, VERBOSE) << "Replacing initializer " << duplicate_name << " with identical initializer "
+                            << representative_name;
+      graph.RemoveInitializedTensor(duplicate_name);
+      modified = true;
+    }
+  }
+
+  return modified;
+}
 }  // namespace
 
 }  // namespace onnxruntime
@@ -335,7 +472,100 @@ struct hash<onnxruntime::EquivalenceClass> {
 
 namespace onnxruntime {
 
-Status CommonSubexpressionElimination::ApplyImpl(Graph& graph, bool& modified, int graph_level, const logging::Logger& logger) const {
+namespace {
+
+using ValueToRepresentativeMap = std::unordered_map<const EquivalenceClass*, Representative,
+                                                    DeepPointerHash, DeepPointerEquality>;
+
+using EquivalenceClassMap = std::unordered_map<const NodeArg*, const EquivalenceClass*,
+                                               NodeArgPtrHash, NodeArgPtrEquality>;
+
+// Value numbering state of a graph, visible to the subgraphs of its nodes while they are processed.
+struct Scope {
+  const Graph& graph;
+  const EquivalenceClassMap& equivalence_classes;
+  const ValueToRepresentativeMap& value_to_representative;
+  const Scope* parent;
+};
+
+// Find the equivalence class of an outer scope value.
+const EquivalenceClass* FindOuterScopeClass(const Scope* outer_scope, const std::string& name) {
+  for (const Scope* scope = outer_scope; scope != nullptr; scope = scope->parent) {
+    const NodeArg* node_arg = scope->graph.GetNodeArg(name);
+    if (node_arg != nullptr) {
+      auto it = scope->equivalence_classes.find(node_arg);
+      if (it != scope->equivalence_classes.end()) {
+        return it->second;
+      }
+    }
+
+    // values that are only passed through to subgraphs are not numbered in the scope that defines them
+    if (IsDefinedInGraph(scope->graph, name)) {
+      return nullptr;
+    }
+  }
+
+  return nullptr;
+}
+
+// Find a node output in an outer scope that computes the same value and is visible from graph,
+// i.e. no graph in between defines a value with the same name.
+const ValueToRepresentativeMap::value_type* FindOuterScopeRepresentative(const Graph& graph,
+                                                                         const Scope* outer_scope,
+                                                                         const EquivalenceClass* value) {
+  std::vector<const Graph*> inner_graphs{&graph};
+  for (const Scope* scope = outer_scope; scope != nullptr; scope = scope->parent) {
+    auto it = scope->value_to_representative.find(value);
+    if (it != scope->value_to_representative.end()) {
+      const Representative& representative = it->second;
+      if (representative.output_index == kInvalidOutputIndex) {
+        return nullptr;
+      }
+
+      const std::string& name = representative.node_arg->Name();
+      for (const Graph* inner_graph : inner_graphs) {
+        if (IsDefinedInGraph(*inner_graph, name)) {
+          return nullptr;
+        }
+      }
+
+      return &*it;
+    }
+
+    inner_graphs.push_back(&scope->graph);
+  }
+
+  return nullptr;
+}
+
+// Replace the output of node with a value of the same name from an outer scope.
+// Returns false if the output is consumed by a subgraph, as it is referenced by name there.
+bool ReplaceWithOuterScopeValue(Graph& graph, Node& node, OutputIndex output_idx, const NodeArg& outer_value) {
+  const auto output_edges = graph_utils::GraphEdge::GetNodeOutputEdges(node, output_idx);
+  for (const auto& output_edge : output_edges) {
+    if (static_cast<size_t>(output_edge.dst_arg_index) >= graph.GetNode(output_edge.dst_node)->InputDefs().size()) {
+      return false;
+    }
+  }
+
+  NodeArg& outer_arg = graph.GetOrCreateNodeArg(outer_value.Name(), outer_value.TypeAsProto());
+  graph_utils::GraphEdge::RemoveGraphEdges(graph, output_edges);
+  for (const auto& output_edge : output_edges) {
+    Node& consumer = *graph.GetNode(output_edge.dst_node);
+    graph_utils::ReplaceNodeInput(consumer, output_edge.dst_arg_index, outer_arg);
+    graph.RemoveConsumerNode(output_edge.arg_name, &consumer);
+    graph.AddConsumerNode(outer_arg.Name(), &consumer);
+  }
+
+  return true;
+}
+
+Status EliminateCommonSubexpressions(Graph& graph, const Scope* outer_scope, int& unique_discriminator,
+                                     bool& modified, const logging::Logger& logger) {
+  if (DeduplicateInitializers(graph, logger)) {
+    modified = true;
+  }
+
   GraphViewer graph_viewer(graph);
   const auto& node_topology_list = graph_viewer.GetNodesInTopologicalOrder();
 
@@ -344,43 +574,51 @@ Status CommonSubexpressionElimination::ApplyImpl(Graph& graph, bool& modified, i
   unique_equivalence_classes.reserve(graph.NumberOfNodes());
 
   // Maps an equivalence class of values to a representative NodeArg that belongs to this class.
-  std::unordered_map<
-      const EquivalenceClass*,
-      Representative,
-      DeepPointerHash, DeepPointerEquality>
-      value_to_representative;
+  ValueToRepresentativeMap value_to_representative;
 
   // Maps every NodeArg to its equivalence class of.
   // This is the inverse of the above mapping, except that different NodeArgs can belong to the same
   // equivalence class. In that case these NodeArgs will be "merged" into one.
-  std::unordered_map<const NodeArg*, const EquivalenceClass*, NodeArgPtrHash, NodeArgPtrEquality> equivalence_classes;
+  EquivalenceClassMap equivalence_classes;
 
-  int unique_discriminator = 1;
+  const Scope scope{graph, equivalence_classes, value_to_representative, outer_scope};
 
   for (NodeIndex node_index : node_topology_list) {
     Node* node = graph.GetNode(node_index);
     if (node == nullptr)
       continue;
 
-    ORT_RETURN_IF_ERROR(Recurse(*node, modified, graph_level, logger));
-
     std::vector<const EquivalenceClass*> input_values;
     input_values.reserve(node->InputDefs().size());
     for (const NodeArg* input_def : node->InputDefs()) {
       auto it = equivalence_classes.find(input_def);
       if (it == equivalence_classes.end()) {
         // Because nodes are processed in topological order, this will always be
-        // a non-op value (graph input or constant initializer).
-        auto value = std::make_unique<EquivalenceClass>(input_def);
-        const auto* raw_ptr = value.get();
-        unique_equivalence_classes.push_back(std::move(value));
-        value_to_representative.emplace(raw_ptr, Representative{input_def, 0, kInvalidOutputIndex});
-        it = equivalence_classes.emplace_hint(it, input_def, raw_ptr);
+        // a non-op value (graph input, constant initializer or outer scope value).
+        const EquivalenceClass* outer_value = nullptr;
+        if (outer_scope != nullptr && input_def->Exists() && !IsDefinedInGraph(graph, input_def->Name())) {
+          outer_value = FindOuterScopeClass(outer_scope, input_def->Name());
+        }
+
+        if (outer_value == nullptr) {
+          auto value = std::make_unique<EquivalenceClass>(input_def);
+          outer_value = value.get();
+          unique_equivalence_classes.push_back(std::move(value));
+          value_to_representative.emplace(outer_value, Representative{input_def, 0, kInvalidOutputIndex});
+        }
+
+        it = equivalence_classes.emplace_hint(it, input_def, outer_value);
       }
 
       input_values.push_back(it->second);
     }
 
+    // Subgraphs see the values computed so far, which are all available before this node runs.
+    for (auto& entry : node->GetAttributeNameToMutableSubgraphMap()) {
+      ORT_RETURN_IF_ERROR(EliminateCommonSubexpressions(*entry.second, &scope, unique_discriminator,
+                                                        modified, logger));
+    }
+
     int discriminator = 0;
     if (!IsNodeSupported(*node)) {
       discriminator = ++unique_discriminator;
@@ -394,9 +632,16 @@ Status CommonSubexpressionElimination::ApplyImpl(Graph& graph, bool& modified, i
 
       auto it = value_to_representative.find(raw_ptr);
       if (it == value_to_representative.end()) {
-        unique_equivalence_classes.push_back(std::move(equivalence_class));
-        it = value_to_representative.emplace_hint(it, raw_ptr,
-                                                  Representative{output_def, node_index, output_index});
+        const auto* outer_representative = FindOuterScopeRepresentative(graph, outer_scope, raw_ptr);
+        if (outer_representative != nullptr) {
+          Representative representative = outer_representative->second;
+          representative.outer_scope = true;
+          it = value_to_representative.emplace_hint(it, outer_representative->first, representative);
+        } else {
+          unique_equivalence_classes.push_back(std::move(equivalence_class));
+          it = value_to_representative.emplace_hint(it, raw_ptr,
+                                                    Representative{output_def, node_index, output_index});
+        }
       }
 
       equivalence_classes[output_def] = it->first;
@@ -432,6 +677,15 @@ Status CommonSubexpressionElimination::ApplyImpl(Graph& graph, bool& modified, i
         continue;
       }
 
+      if (representative.outer_scope) {
+        if (ReplaceWithOuterScopeValue(graph, *node, output_idx, *representative.node_arg)) {
+          LOGS(logger, VERBOSE) << "Replacing output " << output_def->Name() << " of node " << node->Name()
+                                << " with outer scope value " << representative.node_arg->Name();
+          node_output_replaced = true;
+        }
+        continue;
+      }
+
       Node& replacement = *graph.GetNode(representative.node_index);
       OutputIndex replacement_output_idx = representative.output_index;
       graph_utils::ReplaceDownstreamNodeInput(graph, *node, output_idx, replacement, replacement_output_idx);
@@ -449,4 +703,13 @@ Status CommonSubexpressionElimination::ApplyImpl(Graph& graph, bool& modified, i
   return Status::OK();
 }
 
+}  // namespace
+
+Status CommonSubexpressionElimination::ApplyImpl(Graph& graph, bool& modified, int /*graph_level*/,
+                                                 const logging::Logger& logger) const {
+  // Subgraphs are processed by EliminateCommonSubexpressions so that they can reuse values of the enclosing graphs.
+  int unique_discriminator = 1;
+  return EliminateCommonSubexpressions(graph, nullptr, unique_discriminator, modified, logger);
+}
+
 }  // namespace onnxruntime
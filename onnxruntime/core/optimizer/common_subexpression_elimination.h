@@ -10,6 +10,9 @@ namespace onnxruntime {
 /**
 @Class CommonSubexpressionElimination
 Merge nodes that always evaluate to the same result.
+
+Constant initializers with identical contents are merged first, and nodes in subgraphs that compute
+a value that is already available in an enclosing graph are replaced by that value.
 */
 class CommonSubexpressionElimination : public GraphTransformer {
  public:
@@ -2,11 +2,23 @@
 // Licensed under the MIT License.
 
 #include "core/optimizer/constant_folding.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+
+#include "onnxruntime_config.h"
+#include "core/common/optional.h"
 #include "core/optimizer/utils.h"
 #include "core/graph/graph_utils.h"
 #include "core/optimizer/optimizer_execution_frame.h"
+#include "core/framework/murmurhash3.h"
 #include "core/framework/op_kernel.h"
 #include "core/framework/tensorprotoutils.h"
+#include "core/platform/env.h"
 
 using namespace onnxruntime::common;
 
@@ -15,13 +27,226 @@ namespace onnxruntime {
 ConstantFolding::ConstantFolding(const IExecutionProvider& execution_provider,
                                  bool skip_dequantize_linear,
                                  const std::unordered_set<std::string>& compatible_execution_providers,
-                                 const std::unordered_set<std::string>& excluded_initializers) noexcept
+                                 const std::unordered_set<std::string>& excluded_initializers,
+                                 const ConstantFoldingOptions& options) noexcept
     : GraphTransformer("ConstantFolding", compatible_execution_providers),
       skip_dequantize_linear_(skip_dequantize_linear),
+      options_(options),
       excluded_initializers_(excluded_initializers),
       execution_provider_(execution_provider) {
 }
 
+bool ConstantFolding::ExceedsSizeLimits(const Node& node, size_t input_size_in_bytes,
+                                        size_t output_size_in_bytes) const {
+  if (options_.max_output_size_in_bytes != 0 && output_size_in_bytes > options_.max_output_size_in_bytes) {
+    return true;
+  }
+
+  // Expanding ops are cheap to compute at runtime, so keep them symbolic rather than storing a large expanded copy.
+  static const std::unordered_set<std::string> expanding_ops = {"Expand", "Tile", "ConstantOfShape"};
+  return options_.max_expansion_size_in_bytes != 0 &&
+         node.Domain() == kOnnxDomain &&
+         expanding_ops.count(node.OpType()) != 0 &&
+         output_size_in_bytes > options_.max_expansion_size_in_bytes &&
+         output_size_in_bytes > input_size_in_bytes;
+}
+
+namespace {
+
+// Returns the size of the node outputs if shape inferencing produced a complete shape and type for every output.
+optional<size_t> GetInferredOutputSizeInBytes(const Node& node) {
+  size_t total = 0;
+  for (const auto* output_def : node.OutputDefs()) {
+    const auto* type = output_def->TypeAsProto();
+    const auto* shape = output_def->Shape();
+    if (type == nullptr || !type->has_tensor_type() || shape == nullptr) {
+      return {};
+    }
+
+    const auto* tensor_type = DataTypeImpl::TensorTypeFromONNXEnum(type->tensor_type().elem_type());
+    if (tensor_type == nullptr) {
+      return {};
+    }
+
+    size_t size = tensor_type->GetElementType()->Size();
+    for (const auto& dim : shape->dim()) {
+      if (!utils::HasDimValue(dim) || dim.dim_value() < 0) {
+        return {};
+      }
+      size *= static_cast<size_t>(dim.dim_value());
+    }
+
+    total += size;
+  }
+
+  return total;
+}
+
+size_t GetInputSizeInBytes(const InitializedTensorSet& constant_inputs) {
+  size_t total = 0;
+  for (const auto& entry : constant_inputs) {
+    size_t size = 0;
+    if (utils::GetSizeInBytesFromTensorProto<0>(*entry.second, &size).IsOK()) {
+      total += size;
+    }
+  }
+
+  return total;
+}
+
+// Incremental 128-bit MurmurHash3 used to key the folded outputs of a node by its content.
+// Every chunk is hashed on its own, then its digest and length are hashed together with the current state, so
+// the whole 128 bits of state are carried from one chunk to the next.
+class ContentHasher {
+ public:
+  void Update(const void* data, size_t length) {
+    const auto* bytes = static_cast<const uint8_t*>(data);
+    // MurmurHash3 takes an int length, so hash large buffers in chunks
+    constexpr size_t kChunkSize = 1 << 30;
+    do {
+      const size_t chunk = std::min(length, kChunkSize);
+      uint32_t block[10];
+      std::memcpy(block, hash_, sizeof(hash_));
+      MurmurHash3::x86_128(bytes, static_cast<int>(chunk), 0, block + 4);
+      const uint64_t chunk_length = chunk;
+      std::memcpy(block + 8, &chunk_length, sizeof(chunk_length));
+      MurmurHash3::x86_128(block, static_cast<int>(sizeof(block)), 0, hash_);
+      bytes += chunk;
+      length -= chunk;
+    } while (length > 0);
+  }
+
+  void Update(const std::string& value) {
+    Update(value.data(), value.size());
+  }
+
+  std::string HexDigest() const {
+    std::ostringstream out;
+    for (uint32_t value : hash_) {
+      out << std::hex << std::setw(8) << std::setfill('0') << value;
+    }
+    return out.str();
+  }
+
+ private:
+  uint32_t hash_[4] = {0, 0, 0, 0};
+};
+
+// Compute a key identifying the node's computation: op, attributes and the contents of all its inputs.
+// `description` holds the op, the size of every input and the key. It is stored in the cache entry and
+// compared when loading, so an entry for another computation is never used, e.g. on a hash collision.
+// Returns false if the node can't be cached, e.g. because an input uses external data.
+bool ComputeCacheKey(const Node& node, const InitializedTensorSet& constant_inputs, std::string& key,
+                     std::string& description) {
+  std::ostringstream input_sizes;
+  ContentHasher hasher;
+  hasher.Update(std::string(ORT_VERSION));
+  hasher.Update(node.Domain());
+  hasher.Update(node.OpType());
+  hasher.Update(std::to_string(node.SinceVersion()));
+
+  // attributes are stored in an unordered map so sort them by name to get a stable key
+  const auto& attributes = node.GetAttributes();
+  std::vector<std::string> attribute_names;
+  attribute_names.reserve(attributes.size());
+  for (const auto& attribute : attributes) {
+    attribute_names.push_back(attribute.first);
+  }
+  std::sort(attribute_names.begin(), attribute_names.end());
+  for (const auto& name : attribute_names) {
+    hasher.Update(name);
+    hasher.Update(attributes.at(name).SerializeAsString());
+  }
+
+  for (const auto* input_def : node.InputDefs()) {
+    if (!input_def->Exists()) {
+      hasher.Update(std::string("<missing>"));
+      input_sizes << " -";
+      continue;
+    }
+
+    auto it = constant_inputs.find(input_def->Name());
+    if (it == constant_inputs.end() || utils::HasExternalData(*it->second)) {
+      return false;
+    }
+
+    const ONNX_NAMESPACE::TensorProto& tensor_proto = *it->second;
+    if (utils::HasRawData(tensor_proto)) {
+      const int32_t data_type = tensor_proto.data_type();
+      hasher.Update(&data_type, sizeof(data_type));
+      for (auto dim : tensor_proto.dims()) {
+        hasher.Update(&dim, sizeof(dim));
+      }
+      hasher.Update(tensor_proto.raw_data());
+      input_sizes << " " << tensor_proto.raw_data().size();
+    } else {
+      // the name depends on the model, not the content
+      ONNX_NAMESPACE::TensorProto unnamed = tensor_proto;
+      unnamed.clear_name();
+      const std::string serialized = unnamed.SerializeAsString();
+      hasher.Update(serialized);
+      input_sizes << " " << serialized.size();
+    }
+  }
+
+  key = hasher.HexDigest();
+  description = node.Domain() + ":" + node.OpType() + ":" + std::to_string(node.SinceVersion()) +
+                " inputs:" + input_sizes.str() + " key: " + key;
+  return true;
+}
+
+std::string GetCacheFilePath(const std::string& cache_dir, const std::string& key) {
+  return cache_dir + "/" + key + ".pb";
+}
+
+// Load previously folded outputs. Returns false if there is no valid cache entry for `description`.
+bool LoadFoldedOutputs(const std::string& path, const std::string& description, size_t num_outputs,
+                       std::vector<ONNX_NAMESPACE::TensorProto>& outputs) {
+  std::ifstream in(path, std::ios::in | std::ios::binary);
+  if (!in) {
+    return false;
+  }
+
+  ONNX_NAMESPACE::GraphProto cached;
+  if (!cached.ParseFromIstream(&in) || cached.doc_string() != description ||
+      static_cast<size_t>(cached.initializer_size()) != num_outputs) {
+    return false;
+  }
+
+  outputs.assign(cached.initializer().begin(), cached.initializer().end());
+  return true;
+}
+
+Status SaveFoldedOutputs(const std::string& cache_dir, const std::string& path, const std::string& description,
+                         const std::vector<ONNX_NAMESPACE::TensorProto>& outputs) {
+  if (!Env::Default().FolderExists(cache_dir)) {
+    ORT_RETURN_IF_ERROR(Env::Default().CreateFolder(cache_dir));
+  }
+
+  ONNX_NAMESPACE::GraphProto cached;
+  cached.set_name("ConstantFoldingCache");
+  cached.set_doc_string(description);
+  for (const auto& output : outputs) {
+    *cached.add_initializer() = output;
+  }
+
+  // write to a temporary file and rename it so concurrent sessions never read a partially written entry
+  const std::string temp_path = path + "." + std::to_string(Env::Default().GetSelfPid()) + ".tmp";
+  {
+    std::ofstream out(temp_path, std::ios::out | std::ios::binary | std::ios::trunc);
+    ORT_RETURN_IF_NOT(out && cached.SerializeToOstream(&out), "Failed to write ", temp_path);
+  }
+
+  if (std::rename(temp_path.c_str(), path.c_str()) != 0) {
+    std::remove(temp_path.c_str());
+    return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "Failed to rename ", temp_path, " to ", path);
+  }
+
+  return Status::OK();
+}
+
+}  // namespace
+
 // We need to handle a Shape node separately as the input doesn't need to be a constant initializer for
 // Shape to be able to be constant folded.
 static bool ConstantFoldShapeNode(Graph& graph, Node& node) {
@@ -110,73 +335,136 @@ Status ConstantFolding::ApplyImpl(Graph& graph, bool& modified, int graph_level,
         continue;
       }
 
-      // Create execution frame for executing constant nodes.
-      OptimizerExecutionFrame::Info info({node}, constant_inputs, graph.ModelPath(), execution_provider_);
-
-      std::vector<int> fetch_mlvalue_idxs;
-      for (const auto* node_out : node->OutputDefs()) {
-        fetch_mlvalue_idxs.push_back(info.GetMLValueIndex(node_out->Name()));
-      }
-
-      // override the EP assigned to the node so that it will use the CPU kernel for Compute.
-      if (!cpu_ep) {
-        node->SetExecutionProviderType(kCpuExecutionProvider);
+      const size_t input_size_in_bytes = GetInputSizeInBytes(constant_inputs);
+      const auto inferred_output_size = GetInferredOutputSizeInBytes(*node);
+      if (inferred_output_size.has_value() &&
+          ExceedsSizeLimits(*node, input_size_in_bytes, *inferred_output_size)) {
+        LOGS(logger, VERBOSE) << "Skipping constant folding of " << node->OpType() << " node '" << node->Name()
+                              << "' as its output size of " << *inferred_output_size << " bytes exceeds the limit.";
+        continue;
       }
 
-      auto kernel = info.CreateKernel(node);
+      std::string cache_key;
+      std::string cache_description;
+      const bool use_cache = !options_.cache_dir.empty() &&
+                             ComputeCacheKey(*node, constant_inputs, cache_key, cache_description);
+      const std::string cache_path = use_cache ? GetCacheFilePath(options_.cache_dir, cache_key) : std::string();
+
+      std::vector<ONNX_NAMESPACE::TensorProto> folded_outputs;
+      bool loaded_from_cache = use_cache && LoadFoldedOutputs(cache_path, cache_description,
+                                                              node->OutputDefs().size(), folded_outputs);
+
+      if (loaded_from_cache && !inferred_output_size.has_value()) {
+        // the entry may have been created with different limits
+        size_t output_size_in_bytes = 0;
+        for (const auto& output : folded_outputs) {
+          size_t size = 0;
+          ORT_RETURN_IF_ERROR(utils::GetSizeInBytesFromTensorProto<0>(output, &size));
+          output_size_in_bytes += size;
+        }
 
-      // undo the EP change to the value that was assigned at graph partitioning time
-      if (!cpu_ep) {
-        node->SetExecutionProviderType(ep_type);
+        if (ExceedsSizeLimits(*node, input_size_in_bytes, output_size_in_bytes)) {
+          continue;
+        }
       }
 
-      if (kernel == nullptr) {
-        LOGS(logger, WARNING) << "Could not find a CPU kernel and hence "
-                              << "can't constant fold " << node->OpType() << " node '" << node->Name() << "'";
+      if (!loaded_from_cache) {
+        // Create execution frame for executing constant nodes.
+        OptimizerExecutionFrame::Info info({node}, constant_inputs, graph.ModelPath(), execution_provider_);
 
-        // Move on to the next candidate node
-        continue;
-      }
+        std::vector<int> fetch_mlvalue_idxs;
+        for (const auto* node_out : node->OutputDefs()) {
+          fetch_mlvalue_idxs.push_back(info.GetMLValueIndex(node_out->Name()));
+        }
 
-      OptimizerExecutionFrame frame(info, fetch_mlvalue_idxs);
+        // override the EP assigned to the node so that it will use the CPU kernel for Compute.
+        if (!cpu_ep) {
+          node->SetExecutionProviderType(kCpuExecutionProvider);
+        }
 
-      OpKernelContext op_kernel_context(&frame, kernel.get(), nullptr, logger);
-      ORT_RETURN_IF_ERROR(kernel->Compute(&op_kernel_context));
+        auto kernel = info.CreateKernel(node);
 
-      std::vector<OrtValue> fetches;
-      ORT_RETURN_IF_ERROR(frame.GetOutputs(fetches));
+        // undo the EP change to the value that was assigned at graph partitioning time
+        if (!cpu_ep) {
+          node->SetExecutionProviderType(ep_type);
+        }
 
-      // Go over all output node args and substitute them with the newly computed tensors, which will be
-      // added to the graph as initializers.
-      ORT_ENFORCE(fetches.size() == node->OutputDefs().size());
-      converted_to_constant = true;
-      for (size_t fetch_idx = 0; fetch_idx < fetches.size(); ++fetch_idx) {
-        OrtValue& ort_value = fetches[fetch_idx];
-
-        if (!ort_value.IsTensor()) {
-          LOGS(logger, WARNING) << "Unsupported output type of " << ort_value.Type()
-                                << ". Can't constant fold " << node->OpType() << " node '" << node->Name() << "'";
-          converted_to_constant = false;
-          break;
+        if (kernel == nullptr) {
+          LOGS(logger, WARNING) << "Could not find a CPU kernel and hence "
+                                << "can't constant fold " << node->OpType() << " node '" << node->Name() << "'";
+
+          // Move on to the next candidate node
+          continue;
         }
-      }
 
-      if (converted_to_constant) {
+        OptimizerExecutionFrame frame(info, fetch_mlvalue_idxs);
+
+        OpKernelContext op_kernel_context(&frame, kernel.get(), nullptr, logger);
+        ORT_RETURN_IF_ERROR(kernel->Compute(&op_kernel_context));
+
+        std::vector<OrtValue> fetches;
+        ORT_RETURN_IF_ERROR(frame.GetOutputs(fetches));
+
+        // Go over all output node args and substitute them with the newly computed tensors, which will be
+        // added to the graph as initializers.
+        ORT_ENFORCE(fetches.size() == node->OutputDefs().size());
+        bool all_tensors = true;
+        size_t output_size_in_bytes = 0;
         for (size_t fetch_idx = 0; fetch_idx < fetches.size(); ++fetch_idx) {
           OrtValue& ort_value = fetches[fetch_idx];
-          // Build the TensorProto that corresponds to the computed OrtValue and add it as initializer to the graph.
-          auto* constant_arg_out = node->MutableOutputDefs()[fetch_idx];
-          const Tensor& out_tensor = ort_value.Get<Tensor>();
-          ONNX_NAMESPACE::TensorProto out_tensorproto = utils::TensorToTensorProto(out_tensor, constant_arg_out->Name());
-
-          ONNX_NAMESPACE::TensorShapeProto result_shape;
-          for (auto& dim : out_tensor.Shape().GetDims()) {
-            result_shape.add_dim()->set_dim_value(dim);
+
+          if (!ort_value.IsTensor()) {
+            LOGS(logger, WARNING) << "Unsupported output type of " << ort_value.Type()
+                                  << ". Can't constant fold " << node->OpType() << " node '" << node->Name() << "'";
+            all_tensors = false;
+            break;
+          }
+
+          output_size_in_bytes += ort_value.Get<Tensor>().SizeInBytes();
+        }
+
+        if (!all_tensors) {
+          continue;
+        }
+
+        // the output shape may not have been known before running the node
+        if (!inferred_output_size.has_value() &&
+            ExceedsSizeLimits(*node, input_size_in_bytes, output_size_in_bytes)) {
+          LOGS(logger, VERBOSE) << "Skipping constant folding of " << node->OpType() << " node '" << node->Name()
+                                << "' as its output size of " << output_size_in_bytes << " bytes exceeds the limit.";
+          continue;
+        }
+
+        for (size_t fetch_idx = 0; fetch_idx < fetches.size(); ++fetch_idx) {
+          // Build the TensorProto that corresponds to the computed OrtValue.
+          const Tensor& out_tensor = fetches[fetch_idx].Get<Tensor>();
+          folded_outputs.push_back(utils::TensorToTensorProto(out_tensor, node->OutputDefs()[fetch_idx]->Name()));
+        }
+
+        if (use_cache) {
+          auto status = SaveFoldedOutputs(options_.cache_dir, cache_path, cache_description, folded_outputs);
+          if (!status.IsOK()) {
+            LOGS(logger, WARNING) << "Failed to cache the constant folded outputs of " << node->OpType()
+                                  << " node '" << node->Name() << "': " << status.ErrorMessage();
           }
+        }
+      }
 
-          constant_arg_out->SetShape(result_shape);
-          graph.AddInitializedTensor(out_tensorproto);
+      converted_to_constant = true;
+      for (size_t output_idx = 0; output_idx < folded_outputs.size(); ++output_idx) {
+        // Add the folded output as an initializer to the graph. Cached entries were created with the names from
+        // another model so always use the name of the current output.
+        auto* constant_arg_out = node->MutableOutputDefs()[output_idx];
+        ONNX_NAMESPACE::TensorProto& out_tensorproto = folded_outputs[output_idx];
+        out_tensorproto.set_name(constant_arg_out->Name());
+
+        ONNX_NAMESPACE::TensorShapeProto result_shape;
+        for (auto dim : out_tensorproto.dims()) {
+          result_shape.add_dim()->set_dim_value(dim);
         }
+
+        constant_arg_out->SetShape(result_shape);
+        graph.AddInitializedTensor(out_tensorproto);
       }
     }
 
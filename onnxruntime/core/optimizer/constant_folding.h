@@ -10,6 +10,22 @@
 
 namespace onnxruntime {
 
+/** Options controlling how much memory constant folding may add to the model and whether folded results are cached. */
+struct ConstantFoldingOptions {
+  // Expand, Tile and ConstantOfShape outputs larger than this are kept in the graph by default.
+  static constexpr size_t kDefaultMaxExpansionSizeInBytes = 4 * 1024 * 1024;
+
+  // Nodes whose outputs need more bytes than this are not folded. 0 means no limit.
+  size_t max_output_size_in_bytes = 0;
+
+  // Expanding ops are cheap to run but can create huge initializers, so they are not folded if their outputs
+  // need more bytes than this and more bytes than their inputs. 0 means no limit.
+  size_t max_expansion_size_in_bytes = kDefaultMaxExpansionSizeInBytes;
+
+  // Directory used to cache folded outputs across sessions. The cache is disabled if empty.
+  std::string cache_dir;
+};
+
 /**
 @class ConstantFolding
 
@@ -21,16 +37,22 @@ class ConstantFolding : public GraphTransformer {
   /*! Constant folding will not be applied to nodes that have one of initializers from excluded_initializers as input.
       For pre-training, the trainable weights are those initializers to be excluded.
       \param execution_provider Execution provider instance to execute constant folding.
+      \param options Size limits and cache settings.
   */
   ConstantFolding(const IExecutionProvider& execution_provider,
                   bool skip_dequantize_linear,
                   const std::unordered_set<std::string>& compatible_execution_providers = {},
-                  const std::unordered_set<std::string>& excluded_initializers = {}) noexcept;
+                  const std::unordered_set<std::string>& excluded_initializers = {},
+                  const ConstantFoldingOptions& options = {}) noexcept;
 
  private:
   Status ApplyImpl(Graph& graph, bool& modified, int graph_level, const logging::Logger& logger) const override;
 
+  // Returns true if folding a node with the given input and output sizes would exceed the configured limits.
+  bool ExceedsSizeLimits(const Node& node, size_t input_size_in_bytes, size_t output_size_in_bytes) const;
+
   bool skip_dequantize_linear_;
+  const ConstantFoldingOptions options_;
   const std::unordered_set<std::string> excluded_initializers_;
   const IExecutionProvider& execution_provider_;
 };
@@ -4,74 +4,12 @@
 #include <deque>
 #include "core/graph/graph_utils.h"
 #include "core/optimizer/conv_activation_fusion.h"
-#include "core/optimizer/initializer.h"
+#include "core/optimizer/utils.h"
 
 using namespace ONNX_NAMESPACE;
 using namespace ::onnxruntime::common;
 namespace onnxruntime {
 
-namespace {
-// get min/max values from Clip if they are constant. Returns false if mutable and cannot be used
-static bool GetClipConstantMinMax(const Graph& graph, const Node& node, float& min, float& max) {
-  min = std::numeric_limits<float>::lowest();
-  max = std::numeric_limits<float>::max();
-
-  // Clip opset 6 has min and max as attributes. they're inputs from opset 11 on.
-  bool min_max_are_attributes = graph_utils::IsSupportedOptypeVersionAndDomain(node, "Clip", {6});
-  bool min_max_are_constant_values = true;
-
-  if (min_max_are_attributes) {
-    min = graph_utils::GetNodeAttribute(node, "min")->f();
-    max = graph_utils::GetNodeAttribute(node, "max")->f();
-  } else {
-    // update min/max if provided via a constant initializer
-    // return true if value is default or coming from a constant initializer and update 'value'
-    // return false if value is mutable
-    auto update_if_constant_value = [&graph](const Node& node, size_t input_idx, float& value) {
-      const auto& input_defs = node.InputDefs();
-      const NodeArg* input = (input_defs.size() > input_idx) ? input_defs[input_idx] : nullptr;
-
-      if (input == nullptr || !input->Exists()) {
-        // optional input not specified so using default value
-        return true;
-      }
-
-      bool is_constant = true;
-      const ONNX_NAMESPACE::TensorProto* initializer = graph_utils::GetConstantInitializer(graph, input->Name());
-      if (initializer) {
-        Initializer i(*initializer, graph.ModelPath());
-        switch (initializer->data_type()) {
-          case ONNX_NAMESPACE::TensorProto_DataType_FLOAT:
-            value = *i.data<float>();
-            break;
-          // double isn't currently supported
-          //case ONNX_NAMESPACE::TensorProto_DataType_DOUBLE:
-          //  value = static_cast<float>(*i.data<double>());
-          //  break;
-          case ONNX_NAMESPACE::TensorProto_DataType_FLOAT16:
-            value = math::halfToFloat(i.data<MLFloat16>()->val);
-            break;
-          default:
-            ORT_THROW("Unexpected data type for Clip input of ", initializer->data_type());
-        }
-      } else {
-        is_constant = false;
-      }
-
-      return is_constant;
-    };
-
-    // 'min' is input 1, 'max' is input 2. both are optional.
-    // if the input is constant, 'min' or 'max' is updated by the call to get_if_constant_value
-    min_max_are_constant_values = update_if_constant_value(node, 1, min) &&
-                                  update_if_constant_value(node, 2, max);
-  }
-
-  return min_max_are_constant_values;
-}
-
-}  // namespace
-
 Status ConvActivationFusion::ApplyImpl(Graph& graph, bool& modified, int graph_level, const logging::Logger& logger) const {
   GraphViewer graph_viewer(graph);
   const auto& order = graph_viewer.GetNodesInTopologicalOrder();
@@ -165,7 +103,7 @@ Status ConvActivationFusion::ApplyImpl(Graph& graph, bool& modified, int graph_l
           activation_params.push_back(graph_utils::GetNodeAttribute(next_node, "alpha")->f());
         } else if (graph_utils::IsSupportedOptypeVersionAndDomain(next_node, "Clip", {6, 11, 12, 13})) {
           float min, max;
-          if (GetClipConstantMinMax(graph, next_node, min, max)) {
+          if (optimizer_utils::GetClipConstantMinMax(graph, next_node, min, max)) {
             activation_params.push_back(min);
             activation_params.push_back(max);
           } else {
@@ -0,0 +1,324 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/optimizer/elementwise_fusion.h"
+
+#include "core/framework/tensorprotoutils.h"
+#include "core/graph/graph_utils.h"
+#include "core/graph/graph_viewer.h"
+#include "core/optimizer/utils.h"
+
+using namespace ONNX_NAMESPACE;
+using namespace ::onnxruntime::common;
+namespace onnxruntime {
+
+namespace {
+
+// Must stay in sync with FusedElementwise::kMaxSteps in contrib_ops/cpu/fused_elementwise.h
+constexpr size_t kMaxFusedNodes = 16;
+
+struct FusibleOp {
+  std::vector<ONNX_NAMESPACE::OperatorSetVersion> versions;
+  size_t num_inputs;
+};
+
+const FusibleOp* GetFusibleOp(const Node& node) {
+  static const std::unordered_map<std::string, FusibleOp> fusible_ops = {
+      {"Add", {{7, 13, 14}, 2}},
+      {"Sub", {{7, 13, 14}, 2}},
+      {"Mul", {{7, 13, 14}, 2}},
+      {"Div", {{7, 13, 14}, 2}},
+      {"Max", {{8, 12, 13}, 2}},
+      {"Min", {{8, 12, 13}, 2}},
+      {"Pow", {{7, 12, 13}, 2}},
+      {"Relu", {{6, 13, 14}, 1}},
+      {"Sigmoid", {{6, 13}, 1}},
+      {"Tanh", {{6, 13}, 1}},
+      {"Exp", {{6, 13}, 1}},
+      {"Log", {{6, 13}, 1}},
+      {"Neg", {{6, 13}, 1}},
+      {"Abs", {{6, 13}, 1}},
+      {"Sqrt", {{6, 13}, 1}},
+      {"Reciprocal", {{6, 13}, 1}},
+      {"Erf", {{9, 13}, 1}},
+  };
+
+  auto it = fusible_ops.find(node.OpType());
+  if (it == fusible_ops.end() ||
+      !graph_utils::IsSupportedOptypeVersionAndDomain(node, node.OpType(), it->second.versions) ||
+      node.InputDefs().size() != it->second.num_inputs) {
+    return nullptr;
+  }
+
+  return &it->second;
+}
+
+bool DimsAreEqual(const TensorShapeProto_Dimension& a, const TensorShapeProto_Dimension& b) {
+  if (utils::HasDimValue(a) && utils::HasDimValue(b)) {
+    return a.dim_value() == b.dim_value();
+  }
+
+  if (utils::HasDimParam(a) && utils::HasDimParam(b)) {
+    return a.dim_param() == b.dim_param();
+  }
+
+  return false;
+}
+
+bool ShapesAreEqual(const TensorShapeProto& a, const TensorShapeProto& b) {
+  if (a.dim_size() != b.dim_size()) {
+    return false;
+  }
+
+  for (int i = 0; i < a.dim_size(); ++i) {
+    if (!DimsAreEqual(a.dim(i), b.dim(i))) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+// Check that input can be consumed by FusedElementwise for an output of the given shape, i.e. it is a scalar
+// or, ignoring leading 1s, matches the trailing dimensions of the output.
+bool IsSupportedBroadcast(const NodeArg& input, const TensorShapeProto& output_shape) {
+  const auto* input_shape = input.Shape();
+  if (input_shape == nullptr) {
+    return false;
+  }
+
+  int first = 0;
+  while (first < input_shape->dim_size() &&
+         utils::HasDimValue(input_shape->dim(first)) && input_shape->dim(first).dim_value() == 1) {
+    ++first;
+  }
+
+  const int suffix_rank = input_shape->dim_size() - first;
+  if (suffix_rank > output_shape.dim_size()) {
+    return false;
+  }
+
+  const int output_offset = output_shape.dim_size() - suffix_rank;
+  for (int d = 0; d < suffix_rank; ++d) {
+    if (!DimsAreEqual(input_shape->dim(first + d), output_shape.dim(output_offset + d))) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+bool IsFloatTensor(const NodeArg& arg) {
+  const auto* type = arg.TypeAsProto();
+  return type != nullptr && type->has_tensor_type() &&
+         type->tensor_type().elem_type() == TensorProto_DataType_FLOAT;
+}
+
+bool ReadsConvOutput(const Graph& graph, const Node& node) {
+  for (const NodeArg* input : node.InputDefs()) {
+    const Node* producer = graph.GetProducerNode(input->Name());
+    if (producer != nullptr &&
+        (graph_utils::IsSupportedOptypeVersionAndDomain(*producer, "Conv", {1, 11}) ||
+         graph_utils::IsSupportedOptypeVersionAndDomain(*producer, "FusedConv", {1}, kMSDomain))) {
+      return true;
+    }
+  }
+  return false;
+}
+
+// The NCHWc transformer (Level3) folds an Add/Sum of a Conv output and a following activation into the Conv,
+// which is faster than any elementwise kernel, so these nodes are left alone: the nodes reading a Conv output
+// and the activations after an Add/Sum reading a Conv output.
+bool IsConvEpilogue(const Graph& graph, const Node& node) {
+  if (ReadsConvOutput(graph, node)) {
+    return true;
+  }
+
+  if (node.OpType() != "Relu" && node.OpType() != "Sigmoid" && node.OpType() != "Tanh") {
+    return false;
+  }
+  const Node* producer = graph.GetProducerNode(node.InputDefs()[0]->Name());
+  return producer != nullptr && (producer->OpType() == "Add" || producer->OpType() == "Sum") &&
+         ReadsConvOutput(graph, *producer);
+}
+
+bool IsFusibleNode(const Graph& graph, const Node& node,
+                   const std::unordered_set<std::string>& compatible_providers) {
+  if (GetFusibleOp(node) == nullptr ||
+      !graph_utils::IsSupportedProvider(node, compatible_providers) ||
+      node.OutputDefs().size() != 1) {
+    return false;
+  }
+
+  // The exponent of Pow may have another type than the base.
+  for (const NodeArg* input : node.InputDefs()) {
+    if (!IsFloatTensor(*input)) {
+      return false;
+    }
+  }
+  if (!IsFloatTensor(*node.OutputDefs()[0]) || IsConvEpilogue(graph, node)) {
+    return false;
+  }
+
+  return node.OutputDefs()[0]->Shape() != nullptr;
+}
+
+// All nodes but the last must only feed nodes inside the group, so that the last node is the single output.
+bool IsValidGroup(const Graph& graph, const std::vector<Node*>& group,
+                  const std::unordered_set<NodeIndex>& group_indices) {
+  for (size_t i = 0; i + 1 < group.size(); ++i) {
+    const Node& node = *group[i];
+    if (!graph.GetNodeOutputsInGraphOutputs(node).empty()) {
+      return false;
+    }
+
+    for (auto it = node.OutputEdgesBegin(), end = node.OutputEdgesEnd(); it != end; ++it) {
+      if (group_indices.count(it->GetNode().Index()) == 0) {
+        return false;
+      }
+    }
+  }
+
+  return true;
+}
+
+void FuseGroup(Graph& graph, const std::vector<Node*>& group) {
+  std::unordered_map<std::string, int64_t> operand_index;
+  std::unordered_set<std::string> group_outputs;
+  for (const Node* node : group) {
+    group_outputs.insert(node->OutputDefs()[0]->Name());
+  }
+
+  // external inputs come first, in order of first use
+  std::vector<NodeArg*> inputs;
+  for (Node* node : group) {
+    for (NodeArg* input : node->MutableInputDefs()) {
+      if (group_outputs.count(input->Name()) == 0 && operand_index.count(input->Name()) == 0) {
+        operand_index[input->Name()] = static_cast<int64_t>(inputs.size());
+        inputs.push_back(input);
+      }
+    }
+  }
+
+  std::vector<std::string> ops;
+  std::vector<int64_t> operands;
+  for (size_t i = 0; i < group.size(); ++i) {
+    const Node& node = *group[i];
+    const auto& input_defs = node.InputDefs();
+    ops.push_back(node.OpType());
+    operands.push_back(operand_index.at(input_defs[0]->Name()));
+    operands.push_back(input_defs.size() > 1 ? operand_index.at(input_defs[1]->Name()) : -1);
+    operand_index[node.OutputDefs()[0]->Name()] = static_cast<int64_t>(inputs.size() + i);
+  }
+
+  Node& last_node = *group.back();
+  Node& fused_node = graph.AddNode(graph.GenerateNodeName("FusedElementwise"),
+                                   "FusedElementwise",
+                                   "fused elementwise ops",
+                                   inputs,
+                                   {},
+                                   {},
+                                   kMSDomain);
+  fused_node.AddAttribute("ops", ops);
+  fused_node.AddAttribute("operands", operands);
+
+  // Assign provider to this new node. Provider should be same as the provider for old node.
+  fused_node.SetExecutionProviderType(last_node.GetExecutionProviderType());
+
+  std::vector<std::reference_wrapper<Node>> nodes_to_fuse;
+  for (Node* node : group) {
+    nodes_to_fuse.push_back(*node);
+  }
+
+  graph_utils::FinalizeNodeFusion(graph, nodes_to_fuse, fused_node);
+}
+
+}  // namespace
+
+Status ElementwiseFusion::ApplyImpl(Graph& graph, bool& modified, int graph_level, const logging::Logger& logger) const {
+  GraphViewer graph_viewer(graph);
+  const auto& node_topology_list = graph_viewer.GetNodesInTopologicalOrder();
+  const auto& compatible_providers = GetCompatibleExecutionProviders();
+
+  for (size_t position = 0; position < node_topology_list.size(); ++position) {
+    auto* node_ptr = graph.GetNode(node_topology_list[position]);
+    if (nullptr == node_ptr)
+      continue;  // node was removed
+
+    auto& node = *node_ptr;
+
+    ORT_RETURN_IF_ERROR(Recurse(node, modified, graph_level, logger));
+
+    if (!IsFusibleNode(graph, node, compatible_providers)) {
+      continue;
+    }
+
+    const TensorShapeProto& output_shape = *node.OutputDefs()[0]->Shape();
+    bool inputs_supported = true;
+    for (const NodeArg* input : node.InputDefs()) {
+      inputs_supported = inputs_supported && IsSupportedBroadcast(*input, output_shape);
+    }
+    if (!inputs_supported) {
+      continue;
+    }
+
+    // Grow the group in topological order through the consumers of its nodes.
+    std::vector<Node*> group{&node};
+    std::unordered_set<NodeIndex> group_indices{node.Index()};
+    std::unordered_set<NodeIndex> frontier;
+    for (auto it = node.OutputNodesBegin(), end = node.OutputNodesEnd(); it != end; ++it) {
+      frontier.insert(it->Index());
+    }
+
+    for (size_t next = position + 1;
+         next < node_topology_list.size() && !frontier.empty() && group.size() < kMaxFusedNodes;
+         ++next) {
+      if (frontier.erase(node_topology_list[next]) == 0) {
+        continue;
+      }
+
+      Node* candidate = graph.GetNode(node_topology_list[next]);
+      if (candidate == nullptr ||
+          !IsFusibleNode(graph, *candidate, compatible_providers) ||
+          candidate->GetExecutionProviderType() != node.GetExecutionProviderType() ||
+          !ShapesAreEqual(*candidate->OutputDefs()[0]->Shape(), output_shape)) {
+        continue;
+      }
+
+      bool can_add = true;
+      for (const NodeArg* input : candidate->InputDefs()) {
+        const Node* producer = graph.GetProducerNode(input->Name());
+        if (producer != nullptr && group_indices.count(producer->Index()) != 0) {
+          continue;
+        }
+        can_add = can_add && IsSupportedBroadcast(*input, output_shape);
+      }
+      if (!can_add) {
+        continue;
+      }
+
+      group.push_back(candidate);
+      group_indices.insert(candidate->Index());
+      for (auto it = candidate->OutputNodesBegin(), end = candidate->OutputNodesEnd(); it != end; ++it) {
+        frontier.insert(it->Index());
+      }
+    }
+
+    // Drop trailing nodes until every intermediate result stays inside the group.
+    while (group.size() > 1 && !IsValidGroup(graph, group, group_indices)) {
+      group_indices.erase(group.back()->Index());
+      group.pop_back();
+    }
+
+    if (group.size() < 2) {
+      continue;
+    }
+
+    FuseGroup(graph, group);
+    modified = true;
+  }
+
+  return Status::OK();
+}
+
+}  // namespace onnxruntime
@@ -0,0 +1,33 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include "core/optimizer/graph_transformer.h"
+
+namespace onnxruntime {
+
+/**
+@Class ElementwiseFusion
+
+Rewrite graph fusing chains of float elementwise operators (Add, Sub, Mul, Div, Max, Min, Pow, Relu,
+Sigmoid, Tanh, Exp, Log, Neg, Abs, Sqrt, Reciprocal, Erf) into a single FusedElementwise node.
+
+A group is fused when every node in it produces the same output shape, every intermediate result
+is only consumed inside the group, and every external input either has the output shape, is a
+scalar, or matches the trailing dimensions of the output. For example Add->Mul->Sigmoid->Mul
+becomes one node that streams the tensor through memory once instead of four times.
+
+This transformer should run after the pattern based fusions (Gelu, LayerNorm, ...) so that it
+only picks up the elementwise chains that they leave behind. Nodes reading the output of a Conv,
+and the Relu/Sigmoid/Tanh after such an Add or Sum, are left for the NCHWc Conv fusions.
+*/
+class ElementwiseFusion : public GraphTransformer {
+ public:
+  ElementwiseFusion(const std::unordered_set<std::string>& compatible_execution_providers = {}) noexcept
+      : GraphTransformer("ElementwiseFusion", compatible_execution_providers) {}
+
+  Status ApplyImpl(Graph& graph, bool& modified, int graph_level, const logging::Logger& logger) const override;
+};
+
+}  // namespace onnxruntime
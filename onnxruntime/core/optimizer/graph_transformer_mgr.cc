@@ -2,6 +2,11 @@
 // Licensed under the MIT License.
 
 #include "core/optimizer/graph_transformer_mgr.h"
+
+#include <algorithm>
+#include <sstream>
+
+#include "core/framework/tensorprotoutils.h"
 #include "core/optimizer/rule_based_graph_transformer.h"
 
 using namespace onnxruntime;
@@ -19,12 +24,27 @@ common::Status GraphTransformerManager::GetSteps(unsigned& steps) const {
   return Status::OK();
 }
 
+static int64_t GetInitializersSizeInBytes(const Graph& graph) {
+  int64_t total = 0;
+  for (const auto& entry : graph.GetAllInitializedTensors()) {
+    size_t size = 0;
+    if (utils::GetSizeInBytesFromTensorProto<0>(*entry.second, &size).IsOK()) {
+      total += static_cast<int64_t>(size);
+    }
+  }
+
+  return total;
+}
+
 common::Status GraphTransformerManager::ApplyTransformers(Graph& graph, TransformerLevel level, const logging::Logger& logger) const {
   const auto& transformers = level_to_transformer_map_.find(level);
   if (transformers == level_to_transformer_map_.end()) {
     return Status::OK();
   }
 
+  const bool profiling = profiler_ != nullptr && profiler_->IsEnabled();
+  const bool collect_statistics = collect_statistics_ || profiling;
+
   for (unsigned step = 0; step < steps_; ++step) {
     bool graph_changed = false;
     for (const auto& transformer : transformers->second) {
@@ -32,8 +52,53 @@ common::Status GraphTransformerManager::ApplyTransformers(Graph& graph, Transfor
         continue;
 
       bool modified = false;
+      if (!collect_statistics) {
+        ORT_RETURN_IF_ERROR(transformer->Apply(graph, modified, logger));
+        graph_changed = graph_changed || modified;
+        continue;
+      }
+
+      // node indexes are never reused, so the growth of MaxNodeIndex is the number of nodes added
+      const int num_nodes_before = graph.NumberOfNodes();
+      const int max_node_index_before = graph.MaxNodeIndex();
+      const int64_t initializer_bytes_before = GetInitializersSizeInBytes(graph);
+      const TimePoint start_time = std::chrono::high_resolution_clock::now();
+
       ORT_RETURN_IF_ERROR(transformer->Apply(graph, modified, logger));
       graph_changed = graph_changed || modified;
+
+      const auto duration = std::chrono::high_resolution_clock::now() - start_time;
+      const size_t nodes_added = static_cast<size_t>(graph.MaxNodeIndex() - max_node_index_before);
+      const size_t nodes_removed = nodes_added + num_nodes_before - graph.NumberOfNodes();
+      const int64_t initializer_bytes_delta = GetInitializersSizeInBytes(graph) - initializer_bytes_before;
+
+      auto index = statistics_index_.find(transformer->Name());
+      if (index == statistics_index_.end()) {
+        index = statistics_index_.emplace(transformer->Name(), statistics_.size()).first;
+        statistics_.push_back(GraphTransformerStatistics{});
+        statistics_.back().name = transformer->Name();
+        statistics_.back().level = level;
+      }
+
+      GraphTransformerStatistics& stats = statistics_[index->second];
+      ++stats.invocations;
+      stats.modifications += modified ? 1 : 0;
+      stats.duration += std::chrono::duration_cast<std::chrono::nanoseconds>(duration);
+      stats.nodes_added += nodes_added;
+      stats.nodes_removed += nodes_removed;
+      stats.initializer_bytes_delta += initializer_bytes_delta;
+
+      if (profiling) {
+        profiler_->EndTimeAndRecordEvent(profiling::SESSION_EVENT,
+                                         transformer->Name() + "_graph_transform",
+                                         start_time,
+                                         {{"level", std::to_string(static_cast<int>(level))},
+                                          {"step", std::to_string(step)},
+                                          {"modified", modified ? "1" : "0"},
+                                          {"nodes_added", std::to_string(nodes_added)},
+                                          {"nodes_removed", std::to_string(nodes_removed)},
+                                          {"initializer_bytes_delta", std::to_string(initializer_bytes_delta)}});
+      }
     }
     if (!graph_changed) {
       break;
@@ -43,6 +108,38 @@ common::Status GraphTransformerManager::ApplyTransformers(Graph& graph, Transfor
   return Status::OK();
 }
 
+std::string GraphTransformerManager::GetStatisticsReport() const {
+  std::vector<const GraphTransformerStatistics*> sorted;
+  sorted.reserve(statistics_.size());
+  for (const auto& stats : statistics_) {
+    sorted.push_back(&stats);
+  }
+
+  std::stable_sort(sorted.begin(), sorted.end(),
+                   [](const GraphTransformerStatistics* a, const GraphTransformerStatistics* b) {
+                     return a->duration > b->duration;
+                   });
+
+  std::ostringstream report;
+  report << "[";
+  for (size_t i = 0; i < sorted.size(); ++i) {
+    const auto& stats = *sorted[i];
+    report << (i == 0 ? "\n" : ",\n")
+           << "{\"name\": \"" << stats.name << "\""
+           << ", \"level\": " << static_cast<int>(stats.level)
+           << ", \"invocations\": " << stats.invocations
+           << ", \"modifications\": " << stats.modifications
+           << ", \"dur\": " << std::chrono::duration_cast<std::chrono::microseconds>(stats.duration).count()
+           << ", \"nodes_added\": " << stats.nodes_added
+           << ", \"nodes_removed\": " << stats.nodes_removed
+           << ", \"initializer_bytes_delta\": " << stats.initializer_bytes_delta
+           << "}";
+  }
+  report << "\n]\n";
+
+  return report.str();
+}
+
 common::Status GraphTransformerManager::Register(std::unique_ptr<GraphTransformer> transformer, TransformerLevel level) {
   const auto& name = transformer->Name();
   if (transformers_info_.find(name) != transformers_info_.end()) {
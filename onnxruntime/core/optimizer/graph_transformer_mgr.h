@@ -3,13 +3,31 @@
 
 #pragma once
 
+#include <chrono>
+
 #include "core/common/logging/logging.h"
+#include "core/common/profiler.h"
 #include "core/optimizer/graph_transformer.h"
 #include "core/optimizer/constant_folding.h"
 #include "core/optimizer/rewrite_rule.h"
 
 namespace onnxruntime {
 
+// Accumulated cost and effect of a graph transformer across all the steps it was applied in.
+// Node and initializer counts are measured on the graph passed to ApplyTransformers and do not include subgraphs.
+struct GraphTransformerStatistics {
+  std::string name;
+  TransformerLevel level;
+  // number of times the transformer was applied, and how many of those modified the graph
+  size_t invocations = 0;
+  size_t modifications = 0;
+  std::chrono::nanoseconds duration{0};
+  size_t nodes_added = 0;
+  size_t nodes_removed = 0;
+  // net change in the size of the initializers. negative if the transformer removed more than it created.
+  int64_t initializer_bytes_delta = 0;
+};
+
 // Manages a list of graph transformers. It is initialized with a list of graph
 // transformers. Each inference session can further register additional ones.
 class GraphTransformerManager {
@@ -29,6 +47,25 @@ class GraphTransformerManager {
   // Apply all transformers registered for the given level on the given graph
   common::Status ApplyTransformers(Graph& graph, TransformerLevel level, const logging::Logger& logger) const;
 
+  // Collect per transformer statistics in ApplyTransformers.
+  void EnableStatistics() {
+    collect_statistics_ = true;
+  }
+
+  // While the profiler is enabled, statistics are collected and an event is recorded for every application
+  // of a transformer.
+  void SetProfiler(profiling::Profiler* profiler) {
+    profiler_ = profiler;
+  }
+
+  // Statistics for every transformer applied so far, in the order they were first applied.
+  const std::vector<GraphTransformerStatistics>& GetStatistics() const {
+    return statistics_;
+  }
+
+  // JSON report of the statistics, sorted by the time spent in each transformer.
+  std::string GetStatisticsReport() const;
+
  private:
   ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(GraphTransformerManager);
 
@@ -47,5 +84,11 @@ class GraphTransformerManager {
 
   std::unordered_map<TransformerLevel, std::vector<std::unique_ptr<GraphTransformer>>, EnumHashKey> level_to_transformer_map_;
   std::unordered_map<std::string, GraphTransformer*> transformers_info_;
+
+  bool collect_statistics_{false};
+  profiling::Profiler* profiler_{nullptr};
+  // ApplyTransformers is const so the statistics are updated through mutable members
+  mutable std::vector<GraphTransformerStatistics> statistics_;
+  mutable std::unordered_map<std::string, size_t> statistics_index_;
 };
 }  // namespace onnxruntime
@@ -3,6 +3,9 @@
 
 #include "core/optimizer/graph_transformer_utils.h"
 
+#include <locale>
+#include <sstream>
+
 #include "core/mlas/inc/mlas.h"
 #include "core/optimizer/attention_fusion.h"
 #include "core/optimizer/bias_gelu_fusion.h"
@@ -17,6 +20,7 @@
 #include "core/optimizer/div_mul_fusion.h"
 #include "core/optimizer/dropout_elimination.h"
 #include "core/optimizer/dynamic_quantize_matmul_fusion.h"
+#include "core/optimizer/elementwise_fusion.h"
 #include "core/optimizer/embed_layer_norm_fusion.h"
 #include "core/optimizer/expand_elimination.h"
 #include "core/optimizer/fast_gelu_fusion.h"
@@ -25,6 +29,7 @@
 #include "core/optimizer/gelu_fusion.h"
 #include "core/optimizer/gemm_activation_fusion.h"
 #include "core/optimizer/gemm_transpose_fusion.h"
+#include "core/optimizer/group_norm_fusion.h"
 #include "core/optimizer/identity_elimination.h"
 #include "core/optimizer/layer_norm_fusion.h"
 #include "core/optimizer/matmul_add_fusion.h"
@@ -33,6 +38,7 @@
 #include "core/optimizer/nchwc_transformer.h"
 #include "core/optimizer/nhwc_transformer.h"
 #include "core/optimizer/noop_elimination.h"
+#include "core/optimizer/norm_activation_fusion.h"
 #include "core/optimizer/not_where_fusion.h"
 #include "core/optimizer/relu_clip_fusion.h"
 #include "core/optimizer/reshape_fusion.h"
@@ -48,12 +54,39 @@
 #include "core/session/onnxruntime_session_options_config_keys.h"
 #include "core/optimizer/matmul_transpose_fusion.h"
 #include "core/optimizer/bias_dropout_fusion.h"
+#include "core/optimizer/zipmap_elimination.h"
+#include "core/optimizer/scaler_linear_fusion.h"
 
 namespace onnxruntime {
 class IExecutionProvider;
 
 namespace optimizer_utils {
 
+static size_t GetSizeConfigOrDefault(const SessionOptions& session_options, const char* config_key,
+                                     size_t default_value) {
+  const std::string value = session_options.config_options.GetConfigOrDefault(config_key, "");
+  if (value.empty()) {
+    return default_value;
+  }
+
+  std::istringstream value_stream(value);
+  value_stream.imbue(std::locale::classic());
+  size_t result;
+  ORT_ENFORCE((value_stream >> result) && value_stream.eof(),
+              "Invalid value for session config ", config_key, ": ", value);
+  return result;
+}
+
+static ConstantFoldingOptions GetConstantFoldingOptions(const SessionOptions& session_options) {
+  ConstantFoldingOptions options;
+  options.max_output_size_in_bytes = GetSizeConfigOrDefault(
+      session_options, kOrtSessionOptionsConstantFoldingMaxOutputSize, options.max_output_size_in_bytes);
+  options.max_expansion_size_in_bytes = GetSizeConfigOrDefault(
+      session_options, kOrtSessionOptionsConstantFoldingMaxExpansionSize, options.max_expansion_size_in_bytes);
+  options.cache_dir = session_options.config_options.GetConfigOrDefault(kOrtSessionOptionsConstantFoldingCacheDir, "");
+  return options;
+}
+
 std::string GenerateRuleBasedTransformerName(TransformerLevel level) {
   return "Level" + std::to_string(static_cast<uint32_t>(level)) + "_RuleBasedTransformer";
 }
@@ -136,6 +169,7 @@ std::vector<std::unique_ptr<GraphTransformer>> GenerateTransformers(
   std::vector<std::unique_ptr<GraphTransformer>> transformers;
   std::unique_ptr<RuleBasedGraphTransformer> rule_transformer = nullptr;
   bool disable_quant_qdq = session_options.config_options.GetConfigOrDefault(kOrtSessionOptionsDisableQuantQDQ, "0") == "1";
+  bool strip_zipmap_outputs = session_options.config_options.GetConfigOrDefault(kOrtSessionOptionsStripZipMapOutputs, "0") == "1";
 #ifndef DISABLE_CONTRIB_OPS
   bool enable_gelu_approximation = session_options.config_options.GetConfigOrDefault(kOrtSessionOptionsEnableGeluApproximation, "0") == "1";
 #endif
@@ -144,12 +178,20 @@ std::vector<std::unique_ptr<GraphTransformer>> GenerateTransformers(
     case TransformerLevel::Level1: {
       // no filtering on execution provider for L1 optimizations as they only use official ONNX operators
       transformers.emplace_back(std::make_unique<CommonSubexpressionElimination>());
-      transformers.emplace_back(std::make_unique<ConstantFolding>(execution_provider, !disable_quant_qdq));
+      transformers.emplace_back(std::make_unique<ConstantFolding>(execution_provider, !disable_quant_qdq,
+                                                                  std::unordered_set<std::string>{},
+                                                                  std::unordered_set<std::string>{},
+                                                                  GetConstantFoldingOptions(session_options)));
       transformers.emplace_back(std::make_unique<MatMulAddFusion>());
       transformers.emplace_back(std::make_unique<ReshapeFusion>());
       transformers.emplace_back(std::make_unique<FreeDimensionOverrideTransformer>(
           session_options.free_dimension_overrides));
 
+      // ZipMapElimination changes the type of graph outputs so it needs to be requested by the caller.
+      if (strip_zipmap_outputs) {
+        transformers.emplace_back(std::make_unique<ZipMapElimination>());
+      }
+
       rule_transformer = GenerateRuleBasedGraphTransformer(level, rules_and_transformers_to_disable, {});
     } break;
 
@@ -159,6 +201,8 @@ std::vector<std::unique_ptr<GraphTransformer>> GenerateTransformers(
       // create rule based transformer consisting of all the level2 rewrite rules
       rule_transformer = GenerateRuleBasedGraphTransformer(level, rules_and_transformers_to_disable, cpu_ep);
 
+      transformers.emplace_back(std::make_unique<ScalerLinearFusion>(cpu_ep));
+
 #ifndef DISABLE_CONTRIB_OPS
       const std::unordered_set<std::string> cuda_rocm_eps = {onnxruntime::kCudaExecutionProvider,
                                                              onnxruntime::kRocmExecutionProvider};
@@ -183,6 +227,10 @@ std::vector<std::unique_ptr<GraphTransformer>> GenerateTransformers(
 
       transformers.emplace_back(std::make_unique<ConvActivationFusion>(cpu_cuda_rocm_acl_armnn_eps));
 
+      // GroupNormFusion runs first so that NormActivationFusion also fuses the activation after a GroupNorm subgraph.
+      transformers.emplace_back(std::make_unique<GroupNormFusion>(cpu_ep));
+      transformers.emplace_back(std::make_unique<NormActivationFusion>(cpu_ep));
+
       transformers.emplace_back(std::make_unique<GeluFusion>(cpu_cuda_rocm_eps));
       transformers.emplace_back(std::make_unique<LayerNormFusion>(cpu_cuda_rocm_eps));
       transformers.emplace_back(std::make_unique<SimplifiedLayerNormFusion>(cpu_cuda_rocm_eps));
@@ -206,6 +254,9 @@ std::vector<std::unique_ptr<GraphTransformer>> GenerateTransformers(
         transformers.emplace_back(std::make_unique<GeluApproximation>(cpu_cuda_rocm_eps));
       }
 
+      // ElementwiseFusion runs after the pattern based fusions so it only picks up the elementwise chains left over.
+      transformers.emplace_back(std::make_unique<ElementwiseFusion>(cpu_ep));
+
 #endif
     } break;
 
@@ -0,0 +1,234 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include <algorithm>
+
+#include "core/graph/graph_utils.h"
+#include "core/optimizer/initializer.h"
+#include "core/optimizer/group_norm_fusion.h"
+#include "core/optimizer/utils.h"
+
+using namespace ONNX_NAMESPACE;
+using namespace ::onnxruntime::common;
+namespace onnxruntime {
+
+namespace {
+
+// Returns true if the input of the node is a constant float initializer with all elements equal to value.
+bool IsConstantFilledWith(const Graph& graph, const NodeArg& input_arg, int64_t expected_size, float value) {
+  const auto* tensor_proto = graph_utils::GetConstantInitializer(graph, input_arg.Name());
+  if (tensor_proto == nullptr || tensor_proto->data_type() != ONNX_NAMESPACE::TensorProto_DataType_FLOAT) {
+    return false;
+  }
+
+  Initializer initializer{*tensor_proto, graph.ModelPath()};
+  if (initializer.size() != expected_size) {
+    return false;
+  }
+
+  const float* data = initializer.data<float>();
+  return std::all_of(data, data + expected_size, [value](float v) { return v == value; });
+}
+
+// Gets the values of a constant float initializer that broadcasts along axis 1 of a tensor with the given rank,
+// such as [C, 1, 1] or [1, C, 1, 1] for a 4D tensor.
+bool GetPerChannelConstant(const Graph& graph, const NodeArg& input_arg, int64_t channels, int rank,
+                           std::vector<float>& values) {
+  const auto* tensor_proto = graph_utils::GetConstantInitializer(graph, input_arg.Name());
+  if (tensor_proto == nullptr || tensor_proto->data_type() != ONNX_NAMESPACE::TensorProto_DataType_FLOAT) {
+    return false;
+  }
+
+  int axis;
+  if (tensor_proto->dims_size() == rank) {
+    axis = 1;
+  } else if (tensor_proto->dims_size() == rank - 1) {
+    axis = 0;
+  } else {
+    return false;
+  }
+
+  for (int i = 0; i < tensor_proto->dims_size(); i++) {
+    if (tensor_proto->dims(i) != (i == axis ? channels : 1)) {
+      return false;
+    }
+  }
+
+  Initializer initializer{*tensor_proto, graph.ModelPath()};
+  const float* data = initializer.data<float>();
+  values.assign(data, data + channels);
+  return true;
+}
+
+// Returns true if the shape input of the Reshape node restores the shape of X, either through Shape(X) or through a
+// constant that matches the known dimensions of X.
+bool IsReshapeToInputShape(const Graph& graph, const Node& reshape, const NodeArg& X,
+                           const ONNX_NAMESPACE::TensorShapeProto& X_shape, const Node*& shape_node) {
+  shape_node = graph_utils::GetInputNode(reshape, 1);
+  if (shape_node != nullptr) {
+    return graph_utils::IsSupportedOptypeVersionAndDomain(*shape_node, "Shape", {1, 13}) &&
+           shape_node->InputDefs()[0] == &X;
+  }
+
+  std::vector<int64_t> shape;
+  if (!optimizer_utils::AppendTensorFromInitializer(graph, *reshape.InputDefs()[1], shape) ||
+      static_cast<int>(shape.size()) != X_shape.dim_size()) {
+    return false;
+  }
+
+  for (int i = 0; i < X_shape.dim_size(); i++) {
+    const auto& dim = X_shape.dim(i);
+    // A zero copies the dimension from the reshaped input, which is only the batch for the leading dimension.
+    if (!(i == 0 && shape[i] == 0) && !(dim.has_dim_value() && dim.dim_value() == shape[i])) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+NodeArg& AddChannelInitializer(Graph& graph, const std::string& name, const std::vector<float>& values) {
+  ONNX_NAMESPACE::TensorProto tensor_proto;
+  tensor_proto.set_name(graph.GenerateNodeArgName(name));
+  tensor_proto.set_data_type(ONNX_NAMESPACE::TensorProto_DataType_FLOAT);
+  tensor_proto.add_dims(static_cast<int64_t>(values.size()));
+  tensor_proto.set_raw_data(values.data(), values.size() * sizeof(float));
+  return graph_utils::AddInitializer(graph, tensor_proto);
+}
+
+}  // namespace
+
+Status GroupNormFusion::ApplyImpl(Graph& graph, bool& modified, int graph_level, const logging::Logger& logger) const {
+  GraphViewer graph_viewer(graph);
+  const auto& order = graph_viewer.GetNodesInTopologicalOrder();
+
+  for (auto index : order) {
+    auto* node_ptr = graph.GetNode(index);
+    if (!node_ptr)
+      continue;  // node was removed
+
+    auto& node = *node_ptr;
+    ORT_RETURN_IF_ERROR(Recurse(node, modified, graph_level, logger));
+
+    // Match from the InstanceNormalization node at the center of the subgraph.
+    if (!graph_utils::IsSupportedOptypeVersionAndDomain(node, "InstanceNormalization", {6}) ||
+        !graph_utils::IsSupportedProvider(node, GetCompatibleExecutionProviders()) ||
+        !optimizer_utils::CheckOutputEdges(graph, node, 1)) {
+      continue;
+    }
+
+    // X --> Reshape([N, G, -1])
+    const Node* reshape_in = graph_utils::GetInputNode(node, 0);
+    if (reshape_in == nullptr ||
+        !graph_utils::IsSupportedOptypeVersionAndDomain(*reshape_in, "Reshape", {5, 13, 14}) ||
+        reshape_in->GetExecutionProviderType() != node.GetExecutionProviderType() ||
+        !optimizer_utils::CheckOutputEdges(graph, *reshape_in, 1)) {
+      continue;
+    }
+
+    const NodeArg& X = *reshape_in->InputDefs()[0];
+    const auto* X_type = X.TypeAsProto();
+    const auto* X_shape = X.Shape();
+    if (X_type == nullptr || X_type->tensor_type().elem_type() != ONNX_NAMESPACE::TensorProto_DataType_FLOAT ||
+        X_shape == nullptr || X_shape->dim_size() < 3 || !X_shape->dim(1).has_dim_value()) {
+      continue;
+    }
+
+    const int rank = X_shape->dim_size();
+    const int64_t channels = X_shape->dim(1).dim_value();
+
+    std::vector<int64_t> group_shape;
+    if (!optimizer_utils::AppendTensorFromInitializer(graph, *reshape_in->InputDefs()[1], group_shape) ||
+        group_shape.size() != 3 || group_shape[2] != -1) {
+      continue;
+    }
+
+    const int64_t groups = group_shape[1];
+    if (groups <= 0 || channels % groups != 0) {
+      continue;
+    }
+
+    if (group_shape[0] != 0 &&
+        !(X_shape->dim(0).has_dim_value() && X_shape->dim(0).dim_value() == group_shape[0])) {
+      continue;
+    }
+
+    // The InstanceNormalization only normalizes: the affine transform is applied per channel after the Reshape.
+    if (!IsConstantFilledWith(graph, *node.InputDefs()[1], groups, 1.0f) ||
+        !IsConstantFilledWith(graph, *node.InputDefs()[2], groups, 0.0f)) {
+      continue;
+    }
+
+    // Reshape(Shape(X)) --> Mul(gamma) --> Add(beta)
+    const Node& reshape_out = *node.OutputNodesBegin();
+    const Node* shape_node = nullptr;
+    if (!graph_utils::IsSupportedOptypeVersionAndDomain(reshape_out, "Reshape", {5, 13, 14}) ||
+        reshape_out.GetExecutionProviderType() != node.GetExecutionProviderType() ||
+        !optimizer_utils::CheckOutputEdges(graph, reshape_out, 1) ||
+        !IsReshapeToInputShape(graph, reshape_out, X, *X_shape, shape_node)) {
+      continue;
+    }
+
+    const Node& mul_node = *reshape_out.OutputNodesBegin();
+    if (!graph_utils::IsSupportedOptypeVersionAndDomain(mul_node, "Mul", {7, 13, 14}) ||
+        mul_node.GetExecutionProviderType() != node.GetExecutionProviderType() ||
+        !optimizer_utils::CheckOutputEdges(graph, mul_node, 1)) {
+      continue;
+    }
+
+    std::vector<float> gamma;
+    const int mul_input_index = optimizer_utils::IndexOfNodeInput(mul_node, *reshape_out.OutputDefs()[0]);
+    if (mul_input_index < 0 ||
+        !GetPerChannelConstant(graph, *mul_node.InputDefs()[1 - mul_input_index], channels, rank, gamma)) {
+      continue;
+    }
+
+    const Node& add_node = *mul_node.OutputNodesBegin();
+    if (!graph_utils::IsSupportedOptypeVersionAndDomain(add_node, "Add", {7, 13, 14}) ||
+        add_node.GetExecutionProviderType() != node.GetExecutionProviderType()) {
+      continue;
+    }
+
+    std::vector<float> beta;
+    const int add_input_index = optimizer_utils::IndexOfNodeInput(add_node, *mul_node.OutputDefs()[0]);
+    if (add_input_index < 0 ||
+        !GetPerChannelConstant(graph, *add_node.InputDefs()[1 - add_input_index], channels, rank, beta)) {
+      continue;
+    }
+
+    Node& reshape_in_node = *graph.GetNode(reshape_in->Index());
+    Node& instance_norm_node = node;
+    Node& reshape_out_node = *graph.GetNode(reshape_out.Index());
+    Node& mul = *graph.GetNode(mul_node.Index());
+    Node& add = *graph.GetNode(add_node.Index());
+
+    NodeArg& gamma_arg = AddChannelInitializer(graph, "GroupNormFusion_gamma", gamma);
+    NodeArg& beta_arg = AddChannelInitializer(graph, "GroupNormFusion_beta", beta);
+
+    Node& group_norm = graph.AddNode(graph.GenerateNodeName("GroupNorm"), "GroupNorm",
+                                     "fused GroupNorm subgraph of " + instance_norm_node.Name(),
+                                     {reshape_in_node.MutableInputDefs()[0], &gamma_arg, &beta_arg},
+                                     {}, &instance_norm_node.GetAttributes(), kMSDomain);
+    group_norm.AddAttribute("groups", groups);
+
+    // Assign provider to this new node. Provider should be same as the provider for old node.
+    group_norm.SetExecutionProviderType(instance_norm_node.GetExecutionProviderType());
+
+    // move output definitions and edges from the Add node to the GroupNorm node. delete the subgraph nodes.
+    graph_utils::FinalizeNodeFusion(graph, {reshape_in_node, instance_norm_node, reshape_out_node, mul, add},
+                                    group_norm);
+
+    // The Shape node may now be unused.
+    if (shape_node != nullptr) {
+      Node& shape = *graph.GetNode(shape_node->Index());
+      if (shape.GetOutputEdgesCount() == 0 && graph.GetNodeOutputsInGraphOutputs(shape).empty()) {
+        graph.RemoveNode(shape.Index());
+      }
+    }
+
+    modified = true;
+  }
+
+  return Status::OK();
+}
+}  // namespace onnxruntime
@@ -0,0 +1,30 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include "core/optimizer/graph_transformer.h"
+
+namespace onnxruntime {
+
+/**
+@Class GroupNormFusion
+
+Rewrite graph fusing the group normalization subgraph exported by frameworks without a GroupNorm operator
+into a single com.microsoft GroupNorm node:
+
+    X --> Reshape([N, G, -1]) --> InstanceNormalization(ones, zeros) --> Reshape(Shape(X)) --> Mul(gamma) --> Add(beta)
+
+The second Reshape may use a constant shape equal to the shape of X. The gamma and beta initializers are per channel
+tensors broadcast along axis 1 of X.
+*/
+class GroupNormFusion : public GraphTransformer {
+ public:
+  GroupNormFusion(const std::unordered_set<std::string>& compatible_execution_providers = {}) noexcept
+      : GraphTransformer("GroupNormFusion", compatible_execution_providers) {}
+
+ private:
+  Status ApplyImpl(Graph& graph, bool& modified, int graph_level, const logging::Logger& logger) const override;
+};
+
+}  // namespace onnxruntime
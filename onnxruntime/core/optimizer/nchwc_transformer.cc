@@ -120,6 +120,7 @@ class NchwcTransformerImpl {
   void TransformConcat(Node& node);
   void TransformActivation(Node& node);
   void TransformBatchNormalization(Node& node);
+  void TransformGroupNorm(Node& node);
   void TransformTransposeToNhwc(Node& node);
   void TransformResize(Node& node);
   void TrackTransposeFromNhwc(Node& node);
@@ -798,7 +799,8 @@ void NchwcTransformerImpl::TransformActivation(Node& node) {
     // Check if this is a single use NCHWc convolution that hasn't already
     // been fused with another activation.
     auto& nchwc_node = nchwc_input->output_node_;
-    if ((nchwc_node.OpType() == "Conv") && (nchwc_node.Domain() == kMSNchwcDomain) &&
+    if ((nchwc_node.OpType() == "Conv" || nchwc_node.OpType() == "GroupNorm") &&
+        (nchwc_node.Domain() == kMSNchwcDomain) &&
         (nchwc_input->starting_original_uses_ == 1) &&
         (graph_utils::GetNodeAttribute(nchwc_node, "activation") == nullptr)) {
       nchwc_node.AddAttribute("activation", node.OpType());
@@ -812,7 +814,8 @@ void NchwcTransformerImpl::TransformActivation(Node& node) {
 
 // Transform BatchNormalization to a depthwise separable 1x1 convolution. This
 // enables reuse of the existing NCHWc convolution operator and other fusions
-// such as BatchNormalization+Relu using Conv+Relu.
+// such as BatchNormalization+Relu using Conv+Relu. FusedBatchNormalization
+// carries its activation over to the convolution.
 void NchwcTransformerImpl::TransformBatchNormalization(Node& node) {
   auto& input_defs = node.MutableInputDefs();
   auto& output_defs = node.MutableOutputDefs();
@@ -924,6 +927,83 @@ void NchwcTransformerImpl::TransformBatchNormalization(Node& node) {
   nchwc_node.SetExecutionProviderType(kCpuExecutionProvider);
   nchwc_node.AddAttribute("group", nchwc_channels);
 
+  for (const char* attr_name : {"activation", "activation_params"}) {
+    const auto* attr = graph_utils::GetNodeAttribute(node, attr_name);
+    if (attr != nullptr) {
+      nchwc_node.AddAttribute(attr_name, *attr);
+    }
+  }
+
+  nchwc_input->remaining_original_uses_--;
+
+  CreateNchwcArgument(node, nchwc_node, static_cast<size_t>(channels), nchwc_input->shape_);
+  removed_nodes_.push_front(node.Index());
+}
+
+// Transform InstanceNormalization and GroupNorm to the NCHWc GroupNorm, which
+// computes the statistics of each group directly from the blocked channels.
+void NchwcTransformerImpl::TransformGroupNorm(Node& node) {
+  auto& input_defs = node.MutableInputDefs();
+  auto& output_defs = node.MutableOutputDefs();
+
+  // Don't transform the node if the input is not already in NCHWc format.
+  auto it = nchwc_args_.find(input_defs[0]);
+  if (it == nchwc_args_.end()) {
+    return;
+  }
+  auto* nchwc_input = it->second.get();
+
+  // The scale and bias are not padded, so require that the channel count is
+  // already aligned to the NCHWc block size.
+  const int64_t channels = nchwc_input->channels_;
+  const int64_t nchwc_block_size = static_cast<int64_t>(MlasNchwcGetBlockSize());
+  if ((channels % nchwc_block_size) != 0) {
+    return;
+  }
+
+  for (size_t i = 1; i < 3; i++) {
+    const auto* shape = input_defs[i]->Shape();
+    if (shape == nullptr || shape->dim_size() != 1 || !shape->dim(0).has_dim_value() ||
+        shape->dim(0).dim_value() != channels) {
+      return;
+    }
+  }
+
+  // InstanceNormalization normalizes each channel as its own group.
+  const bool is_instance_norm = (node.OpType() == "InstanceNormalization");
+  int64_t groups = channels;
+  if (!is_instance_norm) {
+    const auto* groups_attr = graph_utils::GetNodeAttribute(node, "groups");
+    if (groups_attr == nullptr || !utils::HasInt(*groups_attr)) {
+      return;
+    }
+    groups = groups_attr->i();
+  }
+
+  // Each group must span whole channel blocks or fit inside a single channel
+  // block.
+  if (groups <= 0 || (channels % groups) != 0) {
+    return;
+  }
+  const int64_t channels_per_group = channels / groups;
+  if ((channels_per_group % nchwc_block_size) != 0 && (nchwc_block_size % channels_per_group) != 0) {
+    return;
+  }
+
+  // Create the replacement node.
+  std::string nchwc_node_name = graph_.GenerateNodeName(output_defs[0]->Name() + "_nchwc");
+  Node& nchwc_node = graph_.AddNode(nchwc_node_name,
+                                    "GroupNorm",
+                                    nchwc_node_name,
+                                    {nchwc_input->nchwc_arg_, input_defs[1], input_defs[2]},
+                                    output_defs,
+                                    &node.GetAttributes(),
+                                    kMSNchwcDomain);
+  nchwc_node.SetExecutionProviderType(kCpuExecutionProvider);
+  if (is_instance_norm) {
+    nchwc_node.AddAttribute("groups", groups);
+  }
+
   nchwc_input->remaining_original_uses_--;
 
   CreateNchwcArgument(node, nchwc_node, static_cast<size_t>(channels), nchwc_input->shape_);
@@ -1181,8 +1261,12 @@ void NchwcTransformerImpl::Transform(Node& node) {
                graph_utils::IsSupportedOptypeVersionAndDomain(node, "Sigmoid", {6, 13}) ||
                graph_utils::IsSupportedOptypeVersionAndDomain(node, "Tanh", {6, 13})) {
       TransformActivation(node);
-    } else if (graph_utils::IsSupportedOptypeVersionAndDomain(node, "BatchNormalization", {7, 9, 14})) {
+    } else if (graph_utils::IsSupportedOptypeVersionAndDomain(node, "BatchNormalization", {7, 9, 14}) ||
+               graph_utils::IsSupportedOptypeVersionAndDomain(node, "FusedBatchNormalization", {1}, kMSDomain)) {
       TransformBatchNormalization(node);
+    } else if (graph_utils::IsSupportedOptypeVersionAndDomain(node, "InstanceNormalization", {6}) ||
+               graph_utils::IsSupportedOptypeVersionAndDomain(node, "GroupNorm", {1}, kMSDomain)) {
+      TransformGroupNorm(node);
     } else if (graph_utils::IsSupportedOptypeVersionAndDomain(node, "Transpose", {1, 13})) {
       TransformTransposeToNhwc(node);
     } else if (graph_utils::IsSupportedOptypeVersionAndDomain(node, "Upsample", {9, 13}) ||
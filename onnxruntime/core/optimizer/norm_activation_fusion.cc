@@ -0,0 +1,164 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/graph/graph_utils.h"
+#include "core/optimizer/norm_activation_fusion.h"
+#include "core/optimizer/utils.h"
+
+using namespace ONNX_NAMESPACE;
+using namespace ::onnxruntime::common;
+namespace onnxruntime {
+
+namespace {
+
+// Test if this is an activation that can be fused and also extract the activation's parameters.
+bool GetFusableActivation(const Graph& graph, const Node& node, std::vector<float>& activation_params) {
+  if (graph_utils::IsSupportedOptypeVersionAndDomain(node, "Relu", {6, 13, 14}) ||
+      graph_utils::IsSupportedOptypeVersionAndDomain(node, "Sigmoid", {6, 13}) ||
+      graph_utils::IsSupportedOptypeVersionAndDomain(node, "Tanh", {6, 13})) {
+    return true;
+  }
+
+  if (graph_utils::IsSupportedOptypeVersionAndDomain(node, "LeakyRelu", {6})) {
+    activation_params.push_back(graph_utils::GetNodeAttribute(node, "alpha")->f());
+    return true;
+  }
+
+  if (graph_utils::IsSupportedOptypeVersionAndDomain(node, "Clip", {6, 11, 12, 13})) {
+    float min, max;
+    if (optimizer_utils::GetClipConstantMinMax(graph, node, min, max)) {
+      activation_params.push_back(min);
+      activation_params.push_back(max);
+      return true;
+    }
+  }
+
+  return false;
+}
+
+bool IsFloatTensor(const NodeArg& arg) {
+  const auto* type = arg.TypeAsProto();
+  return type != nullptr && type->tensor_type().elem_type() == ONNX_NAMESPACE::TensorProto_DataType_FLOAT;
+}
+
+// BatchNormalization can be fused when it runs in inference mode with the per channel (spatial) statistics.
+bool IsFusableBatchNormalization(const Node& node) {
+  if (!graph_utils::IsSupportedOptypeVersionAndDomain(node, "BatchNormalization", {7, 9, 14})) {
+    return false;
+  }
+
+  const auto& output_defs = node.OutputDefs();
+  for (size_t i = 1; i < output_defs.size(); i++) {
+    if (output_defs[i]->Exists()) {
+      return false;
+    }
+  }
+
+  const auto* spatial_attr = graph_utils::GetNodeAttribute(node, "spatial");
+  if (spatial_attr != nullptr && spatial_attr->i() != 1) {
+    return false;
+  }
+
+  const auto* training_mode_attr = graph_utils::GetNodeAttribute(node, "training_mode");
+  return training_mode_attr == nullptr || training_mode_attr->i() == 0;
+}
+
+// Returns the number of channels of the InstanceNormalization node from the shape of its scale input.
+int64_t GetInstanceNormalizationChannels(const Node& node) {
+  const auto* scale_shape = node.InputDefs()[1]->Shape();
+  if (scale_shape == nullptr || scale_shape->dim_size() != 1 || !scale_shape->dim(0).has_dim_value()) {
+    return 0;
+  }
+  return scale_shape->dim(0).dim_value();
+}
+
+}  // namespace
+
+Status NormActivationFusion::ApplyImpl(Graph& graph, bool& modified, int graph_level,
+                                       const logging::Logger& logger) const {
+  GraphViewer graph_viewer(graph);
+  const auto& order = graph_viewer.GetNodesInTopologicalOrder();
+
+  for (auto index : order) {
+    auto* node_ptr = graph.GetNode(index);
+    if (!node_ptr)
+      continue;  // node was removed
+
+    auto& node = *node_ptr;
+    ORT_RETURN_IF_ERROR(Recurse(node, modified, graph_level, logger));
+
+    const bool is_batch_norm = IsFusableBatchNormalization(node);
+    const bool is_instance_norm = graph_utils::IsSupportedOptypeVersionAndDomain(node, "InstanceNormalization", {6});
+    const bool is_group_norm = graph_utils::IsSupportedOptypeVersionAndDomain(node, "GroupNorm", {1}, kMSDomain) &&
+                               graph_utils::GetNodeAttribute(node, "activation") == nullptr;
+
+    if ((!is_batch_norm && !is_instance_norm && !is_group_norm) ||
+        !graph_utils::IsSupportedProvider(node, GetCompatibleExecutionProviders()) ||
+        !optimizer_utils::CheckOutputEdges(graph, node, 1) ||
+        !IsFloatTensor(*node.InputDefs()[0])) {
+      continue;
+    }
+
+    const Node& next_node = *(node.OutputNodesBegin());
+    if (next_node.GetExecutionProviderType() != node.GetExecutionProviderType()) {
+      continue;
+    }
+
+    std::vector<float> activation_params;
+    if (!GetFusableActivation(graph, next_node, activation_params)) {
+      continue;
+    }
+
+    NodeAttributes fused_attributes;
+    std::string fused_op_type;
+    int64_t groups = 0;
+
+    if (is_batch_norm) {
+      fused_op_type = "FusedBatchNormalization";
+      const auto* epsilon_attr = graph_utils::GetNodeAttribute(node, "epsilon");
+      if (epsilon_attr != nullptr) {
+        fused_attributes["epsilon"] = *epsilon_attr;
+      }
+    } else if (is_instance_norm) {
+      // InstanceNormalization is GroupNorm with one channel per group.
+      groups = GetInstanceNormalizationChannels(node);
+      if (groups <= 0) {
+        continue;
+      }
+      fused_op_type = "GroupNorm";
+      fused_attributes = node.GetAttributes();
+    } else {
+      fused_op_type = "GroupNorm";
+      fused_attributes = node.GetAttributes();
+    }
+
+    Node& norm_node = node;
+    Node& act_node = *graph.GetNode(next_node.Index());  // get mutable reference
+
+    Node& fused_norm = graph.AddNode(graph.GenerateNodeName("fused " + norm_node.Name()), fused_op_type,
+                                     "fused " + norm_node.OpType() + " " + norm_node.Name() + " with activation " +
+                                         act_node.OpType(),
+                                     norm_node.MutableInputDefs(), {}, &fused_attributes, kMSDomain);
+
+    // Assign provider to this new node. Provider should be same as the provider for old node.
+    fused_norm.SetExecutionProviderType(norm_node.GetExecutionProviderType());
+
+    if (groups > 0) {
+      fused_norm.AddAttribute("groups", groups);
+    }
+
+    // Add attributes to specify the activation type and parameters.
+    fused_norm.AddAttribute("activation", act_node.OpType());
+    if (!activation_params.empty()) {
+      fused_norm.AddAttribute("activation_params", activation_params);
+    }
+
+    // move output definitions and edges from act_node to fused_norm. delete norm_node and act_node.
+    graph_utils::FinalizeNodeFusion(graph, {norm_node, act_node}, fused_norm);
+
+    modified = true;
+  }
+
+  return Status::OK();
+}
+}  // namespace onnxruntime
@@ -0,0 +1,31 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include "core/optimizer/graph_transformer.h"
+
+namespace onnxruntime {
+
+/**
+@Class NormActivationFusion
+
+Rewrite graph fusing a normalization node with the activation that follows it:
+
+    BatchNormalization + activation --> com.microsoft FusedBatchNormalization
+    InstanceNormalization + activation --> com.microsoft GroupNorm (one group per channel)
+    com.microsoft GroupNorm + activation --> com.microsoft GroupNorm with the activation attribute
+
+The supported activations are the ones handled by MLAS: Relu, Sigmoid, Tanh, LeakyRelu and Clip with constant
+min/max.
+*/
+class NormActivationFusion : public GraphTransformer {
+ public:
+  NormActivationFusion(const std::unordered_set<std::string>& compatible_execution_providers = {}) noexcept
+      : GraphTransformer("NormActivationFusion", compatible_execution_providers) {}
+
+ private:
+  Status ApplyImpl(Graph& graph, bool& modified, int graph_level, const logging::Logger& logger) const override;
+};
+
+}  // namespace onnxruntime
@@ -0,0 +1,115 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/optimizer/scaler_linear_fusion.h"
+#include "core/graph/graph_utils.h"
+
+using namespace ONNX_NAMESPACE;
+using namespace ::onnxruntime::common;
+namespace onnxruntime {
+
+namespace {
+// Number of outputs per row of a LinearClassifier or LinearRegressor, 0 if the attributes are invalid.
+int64_t GetTargetCount(const Node& linear_node, bool is_classifier, const std::vector<float>& intercepts) {
+  if (is_classifier) {
+    return static_cast<int64_t>(intercepts.size());
+  }
+  const auto* targets = graph_utils::GetNodeAttribute(linear_node, "targets");
+  return targets != nullptr && targets->has_i() ? targets->i() : 0;
+}
+}  // namespace
+
+Status ScalerLinearFusion::ApplyImpl(Graph& graph, bool& modified, int graph_level,
+                                     const logging::Logger& logger) const {
+  GraphViewer graph_viewer(graph);
+  const auto& order = graph_viewer.GetNodesInTopologicalOrder();
+
+  for (auto index : order) {
+    auto* node_ptr = graph.GetNode(index);
+    if (!node_ptr)
+      continue;  // node was removed
+
+    auto& node = *node_ptr;
+    ORT_RETURN_IF_ERROR(Recurse(node, modified, graph_level, logger));
+
+    if (!graph_utils::IsSupportedOptypeVersionAndDomain(node, "Scaler", {1}, kMLDomain) ||
+        !graph_utils::IsSupportedProvider(node, GetCompatibleExecutionProviders()) ||
+        node.GetOutputEdgesCount() != 1 || !graph.GetNodeOutputsInGraphOutputs(node).empty()) {
+      continue;
+    }
+
+    Node& linear_node = *graph.GetNode(node.OutputNodesBegin()->Index());  // get mutable reference
+    const bool is_classifier =
+        graph_utils::IsSupportedOptypeVersionAndDomain(linear_node, "LinearClassifier", {1}, kMLDomain);
+    if ((!is_classifier &&
+         !graph_utils::IsSupportedOptypeVersionAndDomain(linear_node, "LinearRegressor", {1}, kMLDomain)) ||
+        linear_node.GetExecutionProviderType() != node.GetExecutionProviderType()) {
+      continue;
+    }
+
+    // The linear model takes the input of the Scaler. The LinearClassifier kernel accepts every input type of the
+    // Scaler but the LinearRegressor kernel only accepts float.
+    const NodeArg& input = *node.InputDefs()[0];
+    const auto* input_type = input.TypeAsProto();
+    if (input_type == nullptr || !input_type->has_tensor_type() ||
+        (!is_classifier && input_type->tensor_type().elem_type() != TensorProto_DataType_FLOAT)) {
+      continue;
+    }
+
+    std::vector<float> scale;
+    std::vector<float> offset;
+    std::vector<float> coefficients;
+    std::vector<float> intercepts;
+    graph_utils::GetRepeatedNodeAttributeValues(node, "scale", scale);
+    graph_utils::GetRepeatedNodeAttributeValues(node, "offset", offset);
+    graph_utils::GetRepeatedNodeAttributeValues(linear_node, "coefficients", coefficients);
+    graph_utils::GetRepeatedNodeAttributeValues(linear_node, "intercepts", intercepts);
+
+    const int64_t num_targets = GetTargetCount(linear_node, is_classifier, intercepts);
+    if (num_targets <= 0 || coefficients.empty() || coefficients.size() % num_targets != 0) {
+      continue;
+    }
+    const size_t num_features = coefficients.size() / num_targets;
+    if (scale.empty() || scale.size() != offset.size() || (scale.size() != 1 && scale.size() != num_features)) {
+      continue;
+    }
+
+    // The Scaler fails on inputs whose number of features doesn't match its attributes, so the fusion requires
+    // the number of features to be known.
+    const auto* input_shape = input.Shape();
+    if (input_shape == nullptr || input_shape->dim_size() < 1 || input_shape->dim_size() > 2) {
+      continue;
+    }
+    const auto& feature_dim = input_shape->dim(input_shape->dim_size() - 1);
+    if (!feature_dim.has_dim_value() || feature_dim.dim_value() != static_cast<int64_t>(num_features)) {
+      continue;
+    }
+
+    // The LinearRegressor ignores intercepts of the wrong size.
+    if (!is_classifier && intercepts.size() != static_cast<size_t>(num_targets)) {
+      intercepts.assign(num_targets, 0.f);
+    }
+
+    for (int64_t target = 0; target < num_targets; ++target) {
+      float* weights = coefficients.data() + target * num_features;
+      double bias = intercepts[target];
+      for (size_t feature = 0; feature < num_features; ++feature) {
+        const size_t attr_index = scale.size() == 1 ? 0 : feature;
+        const double scaled_weight = static_cast<double>(weights[feature]) * scale[attr_index];
+        bias -= scaled_weight * offset[attr_index];
+        weights[feature] = static_cast<float>(scaled_weight);
+      }
+      intercepts[target] = static_cast<float>(bias);
+    }
+
+    linear_node.AddAttribute("coefficients", coefficients);
+    linear_node.AddAttribute("intercepts", intercepts);
+
+    // Connects the input of the Scaler to the linear model.
+    graph_utils::RemoveNode(graph, node);
+    modified = true;
+  }
+
+  return Status::OK();
+}
+}  // namespace onnxruntime
@@ -0,0 +1,28 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include "core/optimizer/graph_transformer.h"
+
+namespace onnxruntime {
+
+/**
+@Class ScalerLinearFusion
+
+Folds an ai.onnx.ml Scaler into the LinearClassifier or LinearRegressor consuming its output, which is how
+scikit-learn pipelines with a StandardScaler are converted:
+  LinearClassifier(Scaler(X, offset, scale), W, b) -> LinearClassifier(X, W * scale, b - W * (offset * scale))
+
+The weights are combined in double precision, but as the order of the operations changes the results may differ
+slightly from the unfused graph.
+*/
+class ScalerLinearFusion : public GraphTransformer {
+ public:
+  ScalerLinearFusion(const std::unordered_set<std::string>& compatible_execution_providers = {}) noexcept
+      : GraphTransformer("ScalerLinearFusion", compatible_execution_providers) {}
+
+  Status ApplyImpl(Graph& graph, bool& modified, int graph_level, const logging::Logger& logger) const override;
+};
+
+}  // namespace onnxruntime
@@ -101,5 +101,11 @@ bool CheckOutputEdges(const Graph& graph, const Node& node, size_t expected_outp
 
 bool IsOperationDeterministic(const std::string& domain, const std::string& op);
 
+/** Get the min and max values of a Clip node.
+@remarks min/max default to the float limits when not specified.
+@returns false when min or max is supplied by a non-constant input.
+*/
+bool GetClipConstantMinMax(const Graph& graph, const Node& node, float& min, float& max);
+
 }  // namespace optimizer_utils
 }  // namespace onnxruntime
@@ -0,0 +1,92 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/optimizer/zipmap_elimination.h"
+#include "core/graph/graph_utils.h"
+
+namespace onnxruntime {
+
+// Returns the class labels of a ZipMap as a 1-D initializer named `name`: int64 or string values depending on the
+// attribute the ZipMap uses. Returns false if the ZipMap has no labels.
+static bool MakeKeysInitializer(const Node& zipmap, const std::string& name, ONNX_NAMESPACE::TensorProto& keys) {
+  keys.set_name(name);
+  const auto* strings = graph_utils::GetNodeAttribute(zipmap, "classlabels_strings");
+  if (strings != nullptr && strings->strings_size() > 0) {
+    keys.set_data_type(ONNX_NAMESPACE::TensorProto_DataType_STRING);
+    keys.add_dims(strings->strings_size());
+    *keys.mutable_string_data() = strings->strings();
+    return true;
+  }
+  const auto* ints = graph_utils::GetNodeAttribute(zipmap, "classlabels_int64s");
+  if (ints != nullptr && ints->ints_size() > 0) {
+    keys.set_data_type(ONNX_NAMESPACE::TensorProto_DataType_INT64);
+    keys.add_dims(ints->ints_size());
+    *keys.mutable_int64_data() = ints->ints();
+    return true;
+  }
+  return false;
+}
+
+Status ZipMapElimination::ApplyImpl(Graph& graph, bool& modified, int graph_level,
+                                    const logging::Logger& logger) const {
+  ORT_UNUSED_PARAMETER(graph_level);
+
+  // The subgraphs are not visited: the types of their outputs are fixed by the node containing them.
+  GraphViewer graph_viewer(graph);
+  const auto& node_topology_list = graph_viewer.GetNodesInTopologicalOrder();
+
+  // The keys outputs are appended after the existing graph outputs so that their indices do not change.
+  std::vector<const NodeArg*> keys_outputs;
+  int count = 0;
+  for (auto node_index : node_topology_list) {
+    auto* p_node = graph.GetNode(node_index);
+    if (p_node == nullptr) continue;
+
+    Node& node = *p_node;
+    if (!graph_utils::IsSupportedOptypeVersionAndDomain(node, "ZipMap", {1}, kMLDomain) ||
+        node.GetOutputEdgesCount() != 0 ||
+        !graph.IsOutput(node.OutputDefs()[0])) {
+      continue;
+    }
+
+    const auto* input_type = node.InputDefs()[0]->TypeAsProto();
+    if (input_type == nullptr) {
+      continue;
+    }
+
+    // Column j of the probabilities belongs to the j-th class label, exposed as the graph output "<name>_keys".
+    NodeArg* output = node.MutableOutputDefs()[0];
+    std::string keys_name = output->Name() + "_keys";
+    if (graph.GetNodeArg(keys_name) != nullptr) {
+      keys_name = graph.GenerateNodeArgName(keys_name);
+    }
+    ONNX_NAMESPACE::TensorProto keys;
+    if (!MakeKeysInitializer(node, keys_name, keys)) {
+      continue;
+    }
+    keys_outputs.push_back(&graph_utils::AddInitializer(graph, keys));
+
+    // The graph output keeps its name and takes the type and shape of the probabilities.
+    graph.SetNodeArgType(*output, *input_type);
+
+    Node& identity = graph.AddNode(graph.GenerateNodeName("ZipMapElimination"), "Identity",
+                                   "Replaces a ZipMap producing a graph output",
+                                   node.MutableInputDefs(), node.MutableOutputDefs());
+    identity.SetExecutionProviderType(node.GetExecutionProviderType());
+
+    graph.RemoveNode(node.Index());
+    count++;
+  }
+
+  if (count > 0) {
+    std::vector<const NodeArg*> outputs = graph.GetOutputs();
+    outputs.insert(outputs.end(), keys_outputs.begin(), keys_outputs.end());
+    graph.SetOutputs(outputs);
+    modified = true;
+    LOGS(logger, INFO) << "Total ZipMap nodes removed: " << count;
+  }
+
+  return Status::OK();
+}
+
+}  // namespace onnxruntime
@@ -0,0 +1,26 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include "core/optimizer/graph_transformer.h"
+
+namespace onnxruntime {
+
+/**
+@Class ZipMapElimination
+
+Remove the ZipMap nodes producing a graph output, so that the output is the tensor of probabilities given to the
+ZipMap rather than a sequence with one map per row. Column j of the tensor holds the values of the j-th class label
+of the ZipMap, and the labels are added after the other graph outputs as a constant 1-D tensor named "<output>_keys"
+(int64 or string like the labels of the ZipMap). As the type of the graph outputs changes, the transformer is only
+enabled by the session option kOrtSessionOptionsStripZipMapOutputs.
+*/
+class ZipMapElimination : public GraphTransformer {
+ public:
+  ZipMapElimination() noexcept : GraphTransformer("ZipMapElimination") {}
+
+  Status ApplyImpl(Graph& graph, bool& modified, int graph_level, const logging::Logger& logger) const override;
+};
+
+}  // namespace onnxruntime
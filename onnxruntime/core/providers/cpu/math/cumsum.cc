@@ -2,49 +2,55 @@
 // Licensed under the MIT License.
 
 #include "cumsum.h"
+
+#include <algorithm>
+
 #include "core/providers/common.h"
-#include "core/providers/cpu/tensor/utils.h"
 #include "core/framework/op_kernel.h"
 #include "core/framework/tensorprotoutils.h"
+#include "core/platform/threadpool.h"
 
 using namespace onnxruntime;
 
 namespace {
 // static section
-std::vector<int64_t> GetStarts(int64_t rank, int64_t axis, int64_t index) {
-  std::vector<int64_t> starts(rank, 0);
-  starts[axis] = index;
-  return starts;
-}
+
+// Elements along the inner dimensions are processed in blocks of at most this many elements per unit of work
+constexpr int64_t kCumSumBlockSize = 1024;
+
+// Computes the running sums of the [begin, end) range of the inner dimensions for one index of the outer dimensions,
+// where input and output point at the first slice along the axis.
 template <typename T>
-void ZeroOutSliceAtIndex(Tensor& output, int64_t rank, int64_t axis, int64_t index,
-                         const std::vector<int64_t>& slice_dims, const std::vector<int64_t>& steps, const int64_t slice_size) {
-  T zero{};
-  auto output_starts(GetStarts(rank, axis, index));
-  WritableSliceIterator<T> output_iterator(output, output_starts, slice_dims, steps);
-  for (int64_t k = 0; k < slice_size; ++k, ++output_iterator) {
-    *output_iterator = zero;
+void CumSumBlock(const T* input, T* output, int64_t dim, int64_t inner_size, int64_t begin, int64_t end,
+                 bool exclusive, bool reverse) {
+  const int64_t step = reverse ? -inner_size : inner_size;
+  const int64_t first_slice = reverse ? (dim - 1) * inner_size : 0;
+  const T* input_slice = input + first_slice;
+  T* output_slice = output + first_slice;
+  int64_t num_slices = dim;
+
+  // If (exclusive == true) the first slice is always 0
+  if (exclusive) {
+    std::fill(output_slice + begin, output_slice + end, T{});
+    output_slice += step;
+    --num_slices;
   }
-}
-template <typename T>
-void CopySlices(const Tensor& input, Tensor& output,
-                const std::vector<int64_t>& input_starts, const std::vector<int64_t>& output_starts,
-                const std::vector<int64_t>& slice_dims, const std::vector<int64_t>& steps, const int64_t slice_size) {
-  SliceIterator<T> input_iterator(input, input_starts, slice_dims, steps);
-  WritableSliceIterator<T> output_iterator(output, output_starts, slice_dims, steps);
-  for (int64_t k = 0; k < slice_size; ++k, ++output_iterator, ++input_iterator) {
-    *output_iterator = *input_iterator;
+
+  if (num_slices == 0) {
+    return;
   }
-}
-template <typename T>
-void SumSlices(const Tensor& input, Tensor& output,
-               const std::vector<int64_t>& input_starts, const std::vector<int64_t>& output_starts, const std::vector<int64_t>& previous_output_starts,
-               const std::vector<int64_t>& slice_dims, const std::vector<int64_t>& steps, const int64_t slice_size) {
-  SliceIterator<T> input_iterator(input, input_starts, slice_dims, steps);
-  WritableSliceIterator<T> output_iterator(output, output_starts, slice_dims, steps);
-  SliceIterator<T> previous_output_iterator(output, previous_output_starts, slice_dims, steps);
-  for (int64_t k = 0; k < slice_size; ++k, ++output_iterator, ++input_iterator, ++previous_output_iterator) {
-    *output_iterator = *input_iterator + *previous_output_iterator;
+
+  // The next slice is a copy of the input (if exclusive == false then this is the first slice)
+  std::copy(input_slice + begin, input_slice + end, output_slice + begin);
+
+  // Each output slice is the sum of corresponding input slice and the previous output slice
+  for (int64_t index = 1; index < num_slices; ++index) {
+    const T* previous_slice = output_slice;
+    input_slice += step;
+    output_slice += step;
+    for (int64_t i = begin; i < end; ++i) {
+      output_slice[i] = input_slice[i] + previous_slice[i];
+    }
   }
 }
 }  // namespace
@@ -184,62 +190,33 @@ Status CumSum<T>::Compute(OpKernelContext* ctx) const {
   int64_t axis = 0;
   ORT_THROW_IF_ERROR(cumsum_op::GetAxis(axis_tensor, rank, axis));
 
-  auto dim(output_tensor.Shape()[axis]);    // dimension size for the axis
-  TensorShape slice_shape(input->Shape());  // the shape of one slice of input/output for the given value of the axis
-  slice_shape[axis] = 1;
-  auto slice_size(slice_shape.Size());     // total number of elements in each slice
-  auto slice_dims(slice_shape.GetDims());  // dim array for the slice
-
-  std::vector<int64_t> steps(rank, 1);  // steps for the slice -- always set to 1
-
-  if (!reverse_) {
-    int64_t index(0);  // the index we use as we walkthrough the given axis
-    // If (exclusive == true) the first slice is always 0
-    if (exclusive_) {
-      ::ZeroOutSliceAtIndex<T>(output_tensor, rank, axis, index, slice_dims, steps, slice_size);
-      ++index;
-    }
-    {
-      // The next slice is a copy of the input (if exclusive == false then this is the first slice)
-      auto input_starts(::GetStarts(rank, axis, 0));
-      auto output_starts(::GetStarts(rank, axis, index));
-      ::CopySlices<T>(*input, output_tensor, input_starts, output_starts, slice_dims, steps, slice_size);
-      ++index;
-    }
-
-    for (; index < dim; ++index) {
-      // Each output slice is the sum of corresponding input slice and the previous output slice
-      auto input_starts(::GetStarts(rank, axis, exclusive_ ? index - 1 : index));
-      auto output_starts(::GetStarts(rank, axis, index));
-      auto previous_starts(::GetStarts(rank, axis, index - 1));
-      ::SumSlices<T>(*input, output_tensor, input_starts, output_starts, previous_starts,
-                     slice_dims, steps, slice_size);
-    }
-  } else {
-    //_reverse == true
-    int64_t index(dim - 1);  // the index we use as we walkthrough the given axis
-    // If (exclusive == true) the first slice is always 0
-    if (exclusive_) {
-      ::ZeroOutSliceAtIndex<T>(output_tensor, rank, axis, index, slice_dims, steps, slice_size);
-      --index;
-    }
-    {
-      // The next slice is a copy of the input (if exclusive == false then this is the first slice)
-      auto input_starts(::GetStarts(rank, axis, dim - 1));
-      auto output_starts(::GetStarts(rank, axis, index));
-      ::CopySlices<T>(*input, output_tensor, input_starts, output_starts, slice_dims, steps, slice_size);
-      --index;
-    }
-
-    for (; index >= 0; --index) {
-      // Each output slice is the sum of corresponding input slice and the previous output slice
-      auto input_starts(::GetStarts(rank, axis, exclusive_ ? index + 1 : index));
-      auto output_starts(::GetStarts(rank, axis, index));
-      auto previous_starts(::GetStarts(rank, axis, index + 1));
-      ::SumSlices<T>(*input, output_tensor, input_starts, output_starts, previous_starts,
-                     slice_dims, steps, slice_size);
-    }
-  }
+  const int64_t dim = output_shape[axis];  // dimension size for the axis
+  const int64_t outer_size = output_shape.SizeToDimension(axis);
+  const int64_t inner_size = output_shape.SizeFromDimension(axis + 1);
+
+  // The sums along the axis are independent for every position in the other dimensions, so the work is split over
+  // the outer dimensions and blocks of the inner dimensions.
+  const int64_t block_size = std::min(inner_size, kCumSumBlockSize);
+  const int64_t blocks_per_outer = (inner_size + block_size - 1) / block_size;
+  const double block_bytes = static_cast<double>(dim * block_size * sizeof(T));
+
+  const T* input_data = input->template Data<T>();
+  T* output_data = output_tensor.template MutableData<T>();
+  const bool exclusive = exclusive_ != 0;
+  const bool reverse = reverse_ != 0;
+
+  concurrency::ThreadPool::TryParallelFor(
+      ctx->GetOperatorThreadPool(), outer_size * blocks_per_outer,
+      TensorOpCost{block_bytes, block_bytes, static_cast<double>(dim * block_size)},
+      [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+        for (std::ptrdiff_t unit = first; unit < last; ++unit) {
+          const int64_t outer = unit / blocks_per_outer;
+          const int64_t begin = (unit % blocks_per_outer) * block_size;
+          const int64_t offset = outer * dim * inner_size;
+          ::CumSumBlock<T>(input_data + offset, output_data + offset, dim, inner_size,
+                           begin, std::min(begin + block_size, inner_size), exclusive, reverse);
+        }
+      });
 
   return Status::OK();
 }
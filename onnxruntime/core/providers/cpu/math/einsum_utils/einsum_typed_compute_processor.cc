@@ -3,6 +3,8 @@
 
 #include "einsum_typed_compute_processor.h"
 
+#include <limits>
+
 namespace onnxruntime {
 
 template <typename T>
@@ -90,6 +92,14 @@ static bool IsTransposeReshapeForEinsum(const std::vector<size_t>& perm,
   return true;
 }
 
+// True if getting an operand of shape `input_dims` into the axes order given by `perm`
+// needs an actual Transpose (i.e.) it is neither a no-op nor a reshape
+static bool IsDataMovementRequired(const std::vector<size_t>& perm, const std::vector<int64_t>& input_dims) {
+  std::vector<int64_t> new_shape;
+  return EinsumOp::IsTransposeRequired(input_dims.size(), perm) &&
+         !IsTransposeReshapeForEinsum(perm, input_dims, new_shape);
+}
+
 template <typename T>
 std::unique_ptr<Tensor> EinsumTypedComputeProcessor<T>::PairwiseOperandProcess(const Tensor& left,
                                                                                const TensorShape& left_shape_override,
@@ -194,6 +204,8 @@ std::unique_ptr<Tensor> EinsumTypedComputeProcessor<T>::PairwiseOperandProcess(c
   }
 
   // Permutate the left operand so that the axes order go like this: [lro, lo, reduce_dims, ro]
+  // If that requires moving data but [lro, reduce_dims, lo, ro] doesn't, use the latter
+  // and let the MatMul consume the left operand as transposed instead
   std::vector<int64_t> reshaped_dims;
   std::vector<size_t> left_permutation;
   left_permutation.reserve(lro.size() + lo.size() + reduce_dims.size() + ro.size());
@@ -201,44 +213,75 @@ std::unique_ptr<Tensor> EinsumTypedComputeProcessor<T>::PairwiseOperandProcess(c
   left_permutation.insert(left_permutation.end(), lo.begin(), lo.end());
   left_permutation.insert(left_permutation.end(), reduce_dims.begin(), reduce_dims.end());
   left_permutation.insert(left_permutation.end(), ro.begin(), ro.end());
-  if (EinsumOp::IsTransposeRequired(current_left ? current_left->Shape().GetDims().size() : left_dims.size(),
-                                    left_permutation)) {
-    if (current_left && IsTransposeReshapeForEinsum(left_permutation,
-                                                    current_left->Shape().GetDims(),
-                                                    reshaped_dims)) {
+
+  const std::vector<int64_t>& current_left_dims = current_left ? current_left->Shape().GetDims() : left_dims;
+  bool trans_a = false;
+  if (IsDataMovementRequired(left_permutation, current_left_dims)) {
+    std::vector<size_t> left_permutation_transposed;
+    left_permutation_transposed.reserve(left_permutation.size());
+    left_permutation_transposed.insert(left_permutation_transposed.end(), lro.begin(), lro.end());
+    left_permutation_transposed.insert(left_permutation_transposed.end(), reduce_dims.begin(), reduce_dims.end());
+    left_permutation_transposed.insert(left_permutation_transposed.end(), lo.begin(), lo.end());
+    left_permutation_transposed.insert(left_permutation_transposed.end(), ro.begin(), ro.end());
+    if (!IsDataMovementRequired(left_permutation_transposed, current_left_dims)) {
+      left_permutation = std::move(left_permutation_transposed);
+      trans_a = true;
+    }
+  }
+
+  if (EinsumOp::IsTransposeRequired(current_left_dims.size(), left_permutation)) {
+    if (IsTransposeReshapeForEinsum(left_permutation, current_left_dims, reshaped_dims)) {
       // This can be done because curent_* tensors (if they exist) and output tensors are
       // intermediate tensors and cannot be input tensors to the Einsum node itself
       // (which are immutable).
+      // An input of the node is already laid out as required and the MatMul only looks at the shape override,
+      // so there is nothing to be done for it.
       // Covered by ExplicitEinsumAsTensorContractionReshapeLeft.
-      current_left->Reshape(reshaped_dims);
+      if (current_left) {
+        current_left->Reshape(reshaped_dims);
+      }
     } else {
       // Covered by ExplicitEinsumAsTensorContraction, DiagonalWithMatmul, ...
-      current_left = EinsumOp::Transpose(current_left ? *current_left : left,
-                                         current_left ? current_left->Shape().GetDims() : left_dims,
+      current_left = EinsumOp::Transpose(current_left ? *current_left : left, current_left_dims,
                                          left_permutation, allocator_, einsum_ep_assets_,
                                          device_transpose_func_);
     }
   }
 
   // Permutate the right operand so that the axes order go like this: [lro, reduce_dims, ro, lo]
+  // (or [lro, ro, reduce_dims, lo] with the MatMul consuming it as transposed if that avoids moving data)
   std::vector<size_t> right_permutation;
   right_permutation.reserve(lro.size() + lo.size() + reduce_dims.size() + ro.size());
   right_permutation.insert(right_permutation.end(), lro.begin(), lro.end());
   right_permutation.insert(right_permutation.end(), reduce_dims.begin(), reduce_dims.end());
   right_permutation.insert(right_permutation.end(), ro.begin(), ro.end());
   right_permutation.insert(right_permutation.end(), lo.begin(), lo.end());
-  if (EinsumOp::IsTransposeRequired(current_right ? current_right->Shape().GetDims().size() : right_dims.size(),
-                                    right_permutation)) {
-    if (current_right && IsTransposeReshapeForEinsum(right_permutation,
-                                                     current_right->Shape().GetDims(),
-                                                     reshaped_dims)) {
+
+  const std::vector<int64_t>& current_right_dims = current_right ? current_right->Shape().GetDims() : right_dims;
+  bool trans_b = false;
+  if (IsDataMovementRequired(right_permutation, current_right_dims)) {
+    std::vector<size_t> right_permutation_transposed;
+    right_permutation_transposed.reserve(right_permutation.size());
+    right_permutation_transposed.insert(right_permutation_transposed.end(), lro.begin(), lro.end());
+    right_permutation_transposed.insert(right_permutation_transposed.end(), ro.begin(), ro.end());
+    right_permutation_transposed.insert(right_permutation_transposed.end(), reduce_dims.begin(), reduce_dims.end());
+    right_permutation_transposed.insert(right_permutation_transposed.end(), lo.begin(), lo.end());
+    if (!IsDataMovementRequired(right_permutation_transposed, current_right_dims)) {
+      right_permutation = std::move(right_permutation_transposed);
+      trans_b = true;
+    }
+  }
+
+  if (EinsumOp::IsTransposeRequired(current_right_dims.size(), right_permutation)) {
+    if (IsTransposeReshapeForEinsum(right_permutation, current_right_dims, reshaped_dims)) {
       // See note following the previous call of function IsTransposeReshapeForEinsum.
       // Covered by ExplicitEinsumAsBatchedMatmulWithBroadcasting_1, ExplicitEinsumAsMatmul_2, ...
-      current_right->Reshape(reshaped_dims);
+      if (current_right) {
+        current_right->Reshape(reshaped_dims);
+      }
     } else {
       // Covered by DiagonalWithMatmul, ExplicitEinsumAsBatchedMatmul, ...
-      current_right = EinsumOp::Transpose(current_right ? *current_right : right,
-                                          current_right ? current_right->Shape().GetDims() : right_dims,
+      current_right = EinsumOp::Transpose(current_right ? *current_right : right, current_right_dims,
                                           right_permutation, allocator_, einsum_ep_assets_,
                                           device_transpose_func_);
     }
@@ -302,7 +345,7 @@ std::unique_ptr<Tensor> EinsumTypedComputeProcessor<T>::PairwiseOperandProcess(c
   // Multiply the mutated inputs
   auto output = EinsumOp::MatMul<T>(current_left ? *current_left : left, {lro_size, lo_size, reduced_size},
                                     current_right ? *current_right : right, {lro_size, reduced_size, ro_size},
-                                    allocator_, tp_, einsum_ep_assets_, device_matmul_func_);
+                                    trans_a, trans_b, allocator_, tp_, einsum_ep_assets_, device_matmul_func_);
 
   output->Reshape(output_dims);
 
@@ -394,26 +437,101 @@ Status EinsumTypedComputeProcessor<T>::Run() {
 
   // Process the operands in a pair-wise fashion
   {
-    bool is_final_pair = false;
-    // Keep processing each input pair-wise
+    const auto& subscript_indices_to_output_indices =
+        einsum_compute_preprocessor_.GetMappedSubscriptIndicesToOutputindices();
+
+    // The operands that are yet to be contracted.
+    // All of them (and all the intermediate results) have the same homogenized rank (num_subscript_labels).
+    struct Operand {
+      std::unique_ptr<const Tensor> owned;
+      const Tensor* tensor;
+      TensorShape shape;
+    };
+
+    std::vector<Operand> operands;
+    operands.reserve(num_inputs);
+    operands.push_back({nullptr, result ? result.get() : raw_inputs[0], result ? result->Shape() : homogenized_input_dims[0]});
+    operands[0].owned = std::move(result);
     for (int input = 1; input < num_inputs; ++input) {
-      std::vector<int64_t> reduced_dims;
-      reduced_dims.reserve(num_subscript_labels);  // num_subscript_labels is the upper bound. No harm in over-reserving by a small margin.
+      // Use either the preprocessed inputs (if it is available) or the corresponding raw inputs
+      operands.push_back({nullptr, preprocessed_inputs[input] ? preprocessed_inputs[input].get() : raw_inputs[input],
+                          homogenized_input_dims[input]});
+    }
+
+    // A dim that doesn't show up in the output can be reduced as part of contracting a pair
+    // as long as all the other remaining operands are broadcasted along it
+    auto get_reduce_dims = [&](size_t left, size_t right) {
+      std::vector<int64_t> reduce_dims;
+      reduce_dims.reserve(num_subscript_labels);  // num_subscript_labels is the upper bound. No harm in over-reserving by a small margin.
       for (int64_t dim = 0; dim < num_subscript_labels; ++dim) {
-        if (mapped_indices_to_last_input_index[dim] == input) {
-          // This is the last input we are seeing this dimension (and it doesn't occur in the output), so reduce along the dimension
-          reduced_dims.push_back(dim);
+        if (subscript_indices_to_output_indices[dim] != -1) {
+          continue;
+        }
+        bool is_reducible = true;
+        for (size_t i = 0; i < operands.size() && is_reducible; ++i) {
+          if (i != left && i != right && operands[i].shape[static_cast<size_t>(dim)] != 1) {
+            is_reducible = false;
+          }
+        }
+        if (is_reducible) {
+          reduce_dims.push_back(dim);
         }
       }
-      if (input == num_inputs - 1) {
-        is_final_pair = true;
+      return reduce_dims;
+    };
+
+    // Contract the operands pair-wise in a greedy order (similar to opt_einsum's "greedy" path):
+    // Always pick the pair whose contraction shrinks the total size of the live tensors the most
+    // and break ties with the cost of the contraction itself.
+    // The path depends on the dim values and is cheap to find relative to the contractions themselves,
+    // so it is computed afresh for every run.
+    while (operands.size() > 1) {
+      size_t best_left = 0;
+      size_t best_right = 1;
+      if (operands.size() > 2) {
+        double best_cost = std::numeric_limits<double>::max();
+        double best_flops = std::numeric_limits<double>::max();
+        for (size_t i = 0; i < operands.size(); ++i) {
+          for (size_t j = i + 1; j < operands.size(); ++j) {
+            const auto reduce_dims = get_reduce_dims(i, j);
+            double result_size = 1;
+            double flops = 1;
+            size_t reduce_dims_iter = 0;
+            for (int64_t dim = 0; dim < num_subscript_labels; ++dim) {
+              double dim_value = static_cast<double>(std::max(operands[i].shape[static_cast<size_t>(dim)],
+                                                              operands[j].shape[static_cast<size_t>(dim)]));
+              flops *= dim_value;
+              if (reduce_dims_iter < reduce_dims.size() && reduce_dims[reduce_dims_iter] == dim) {
+                ++reduce_dims_iter;
+              } else {
+                result_size *= dim_value;
+              }
+            }
+            double cost = result_size - static_cast<double>(operands[i].shape.Size()) -
+                          static_cast<double>(operands[j].shape.Size());
+            if (cost < best_cost || (cost == best_cost && flops < best_flops)) {
+              best_cost = cost;
+              best_flops = flops;
+              best_left = i;
+              best_right = j;
+            }
+          }
+        }
       }
-      // Use either the preprocessed inputs (if it is available) or the corresponding raw inputs
-      result = PairwiseOperandProcess(result ? *result : *raw_inputs[0],
-                                      result ? result->Shape() : homogenized_input_dims[0],
-                                      preprocessed_inputs[input] ? *preprocessed_inputs[input] : *raw_inputs[input],
-                                      homogenized_input_dims[input],
-                                      reduced_dims, is_final_pair);
+
+      bool is_final_pair = operands.size() == 2;
+      auto reduce_dims = get_reduce_dims(best_left, best_right);
+      std::unique_ptr<const Tensor> contracted = PairwiseOperandProcess(*operands[best_left].tensor,
+                                                                        operands[best_left].shape,
+                                                                        *operands[best_right].tensor,
+                                                                        operands[best_right].shape,
+                                                                        reduce_dims, is_final_pair);
+
+      // The result takes the place of the left operand
+      operands[best_left].tensor = contracted.get();
+      operands[best_left].shape = contracted->Shape();
+      operands[best_left].owned = std::move(contracted);
+      operands.erase(operands.begin() + best_right);
     }
   }
 
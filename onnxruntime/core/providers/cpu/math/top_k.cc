@@ -24,7 +24,10 @@
 #include "core/util/math_cpuonly.h"
 #include <queue>
 #include <algorithm>
+#include <array>
 #include <cmath>
+#include <cstring>
+#include <type_traits>
 
 using namespace std;
 namespace onnxruntime {
@@ -140,6 +143,293 @@ static void SelectTopK(const Comparator& comparer,
   // the data_holder now contains the indices of the top k elements in the first k elements
 }
 
+// Rows along the axis at least this long are split across threads when there are too few rows to parallelize by
+// row, and use the streaming or radix select paths below.
+static constexpr int64_t kMinLongRowSize = 32 * 1024;
+static constexpr int64_t kMinLongRowChunkSize = 8 * 1024;
+
+// Maps a value to an unsigned key that orders the same way, so the top k can be found one digit at a time.
+// -0 and +0 compare equal so map to the same key.
+template <typename T>
+struct RadixKey;
+
+template <>
+struct RadixKey<float> {
+  using KeyType = uint32_t;
+  static bool IsNaN(float value) { return std::isnan(value); }
+  static KeyType Get(float value) {
+    if (value == 0.f) {
+      value = 0.f;
+    }
+    KeyType bits;
+    memcpy(&bits, &value, sizeof(bits));
+    return (bits & 0x80000000u) ? ~bits : (bits | 0x80000000u);
+  }
+};
+
+template <>
+struct RadixKey<double> {
+  using KeyType = uint64_t;
+  static bool IsNaN(double value) { return std::isnan(value); }
+  static KeyType Get(double value) {
+    if (value == 0.) {
+      value = 0.;
+    }
+    KeyType bits;
+    memcpy(&bits, &value, sizeof(bits));
+    return (bits & 0x8000000000000000ull) ? ~bits : (bits | 0x8000000000000000ull);
+  }
+};
+
+template <>
+struct RadixKey<int32_t> {
+  using KeyType = uint32_t;
+  static bool IsNaN(int32_t) { return false; }
+  static KeyType Get(int32_t value) { return static_cast<KeyType>(value) ^ 0x80000000u; }
+};
+
+template <>
+struct RadixKey<int64_t> {
+  using KeyType = uint64_t;
+  static bool IsNaN(int64_t) { return false; }
+  static KeyType Get(int64_t value) { return static_cast<KeyType>(value) ^ 0x8000000000000000ull; }
+};
+
+// Key where the preferred value of the comparator is the largest key
+template <class Comparator>
+static typename RadixKey<typename Comparator::DataType>::KeyType GetRadixKey(typename Comparator::DataType value) {
+  using T = typename Comparator::DataType;
+  auto key = RadixKey<T>::Get(value);
+  return std::is_same<Comparator, GreaterValueCmp<T>>::value ? key : static_cast<decltype(key)>(~key);
+}
+
+// Selects the indices of the top k values in [begin, end) into 'top', in no particular order.
+// Values are compared against the current k-th value a block at a time without branching so the check can be
+// vectorized, and blocks with nothing better are skipped. Candidates accumulate in 'top' and are cut back
+// to k with nth_element, which also updates the k-th value.
+template <class Comparator>
+static void StreamingSelectTopK(const Comparator& comparer, const typename Comparator::DataType* input_data,
+                                int64_t begin, int64_t end, const unsigned k, vector<int64_t>& top) {
+  using T = typename Comparator::DataType;
+  constexpr int64_t block_size = 16;
+
+  top.clear();
+  const int64_t initial_end = std::min<int64_t>(end, begin + k);
+  for (int64_t i = begin; i < initial_end; ++i) {
+    top.push_back(i);
+  }
+
+  if (initial_end == end) {
+    return;
+  }
+
+  const size_t capacity = std::max<size_t>(2 * static_cast<size_t>(k), 64);
+  top.reserve(capacity + block_size);
+
+  // max_element with a 'better than' comparator returns the worst value
+  T threshold = input_data[*std::max_element(top.begin(), top.end(), comparer)];
+
+  int64_t i = initial_end;
+  for (; i + block_size <= end; i += block_size) {
+    const T* block = input_data + i;
+    int any_better = 0;
+    for (int64_t j = 0; j < block_size; ++j) {
+      any_better |= static_cast<int>(comparer.CompareValueOnly(block[j], threshold));
+    }
+
+    if (!any_better) {
+      continue;
+    }
+
+    // an equal value can't replace the k-th value as its index is higher
+    for (int64_t j = 0; j < block_size; ++j) {
+      if (comparer.CompareValueOnly(block[j], threshold)) {
+        top.push_back(i + j);
+      }
+    }
+
+    if (top.size() >= capacity) {
+      nth_element(top.begin(), top.begin() + (k - 1), top.end(), comparer);
+      top.resize(k);
+      threshold = input_data[top[k - 1]];
+    }
+  }
+
+  for (; i < end; ++i) {
+    if (comparer.CompareValueOnly(input_data[i], threshold)) {
+      top.push_back(i);
+    }
+  }
+
+  if (top.size() > k) {
+    nth_element(top.begin(), top.begin() + (k - 1), top.end(), comparer);
+    top.resize(k);
+  }
+}
+
+// Selects the indices of the top k values in [begin, end) into 'top', in no particular order, using a most
+// significant digit first radix select on the keys of the values. The histogram of the first digit and the
+// split of the row by that digit are done in parallel over num_chunks. The remaining digits are only processed for
+// the candidates that share the digits of the k-th value, and once all digits are processed the candidates are
+// equal so the lowest indices are picked.
+// Returns false if the row contains NaN, in which case the radix order does not match the comparator.
+template <class Comparator>
+static bool RadixSelectTopK(const typename Comparator::DataType* input_data, int64_t begin, int64_t end,
+                            const unsigned k, int64_t num_chunks, concurrency::ThreadPool* threadpool,
+                            vector<int64_t>& top) {
+  using T = typename Comparator::DataType;
+  using KeyType = typename RadixKey<T>::KeyType;
+  constexpr int digit_bits = 8;
+  constexpr int num_buckets = 1 << digit_bits;
+  constexpr int key_bits = static_cast<int>(sizeof(KeyType)) * 8;
+  using Histogram = std::array<int64_t, num_buckets>;
+
+  const int64_t n = end - begin;
+  std::vector<Histogram> chunk_histograms(num_chunks);
+  std::vector<uint8_t> chunk_has_nan(num_chunks, 0);
+
+  concurrency::ThreadPool::TrySimpleParallelFor(threadpool, num_chunks, [&](std::ptrdiff_t chunk) {
+    auto work = concurrency::ThreadPool::PartitionWork(chunk, num_chunks, n);
+    Histogram& histogram = chunk_histograms[chunk];
+    histogram.fill(0);
+    for (auto i = begin + work.start; i < begin + work.end; ++i) {
+      if (RadixKey<T>::IsNaN(input_data[i])) {
+        chunk_has_nan[chunk] = 1;
+        return;
+      }
+      ++histogram[GetRadixKey<Comparator>(input_data[i]) >> (key_bits - digit_bits)];
+    }
+  });
+
+  if (std::any_of(chunk_has_nan.begin(), chunk_has_nan.end(), [](uint8_t has_nan) { return has_nan != 0; })) {
+    return false;
+  }
+
+  // find the bucket the k-th value falls in, and how many values are still needed from it
+  const auto find_bucket = [&](const Histogram& histogram, int64_t& remaining) {
+    int bucket = num_buckets - 1;
+    for (; bucket > 0 && histogram[bucket] < remaining; --bucket) {
+      remaining -= histogram[bucket];
+    }
+    return bucket;
+  };
+
+  Histogram histogram{};
+  for (const auto& chunk_histogram : chunk_histograms) {
+    for (int b = 0; b < num_buckets; ++b) {
+      histogram[b] += chunk_histogram[b];
+    }
+  }
+
+  int64_t remaining = k;
+  const int first_bucket = find_bucket(histogram, remaining);
+
+  // values in higher buckets are in the top k. values in the k-th value's bucket are candidates.
+  std::vector<std::vector<int64_t>> chunk_selected(num_chunks);
+  std::vector<std::vector<int64_t>> chunk_candidates(num_chunks);
+  concurrency::ThreadPool::TrySimpleParallelFor(threadpool, num_chunks, [&](std::ptrdiff_t chunk) {
+    auto work = concurrency::ThreadPool::PartitionWork(chunk, num_chunks, n);
+    auto& selected = chunk_selected[chunk];
+    auto& candidates = chunk_candidates[chunk];
+    for (auto i = begin + work.start; i < begin + work.end; ++i) {
+      const int bucket = static_cast<int>(GetRadixKey<Comparator>(input_data[i]) >> (key_bits - digit_bits));
+      if (bucket > first_bucket) {
+        selected.push_back(i);
+      } else if (bucket == first_bucket) {
+        candidates.push_back(i);
+      }
+    }
+  });
+
+  top.clear();
+  top.reserve(k);
+  std::vector<int64_t> candidates;
+  for (int64_t chunk = 0; chunk < num_chunks; ++chunk) {
+    top.insert(top.end(), chunk_selected[chunk].begin(), chunk_selected[chunk].end());
+    candidates.insert(candidates.end(), chunk_candidates[chunk].begin(), chunk_candidates[chunk].end());
+  }
+
+  // candidates stay in index order so ties are resolved in favor of the lower index
+  std::vector<int64_t> next_candidates;
+  for (int shift = key_bits - 2 * digit_bits;
+       shift >= 0 && static_cast<int64_t>(candidates.size()) > remaining;
+       shift -= digit_bits) {
+    histogram.fill(0);
+    for (auto idx : candidates) {
+      ++histogram[(GetRadixKey<Comparator>(input_data[idx]) >> shift) & (num_buckets - 1)];
+    }
+
+    const int kth_bucket = find_bucket(histogram, remaining);
+
+    next_candidates.clear();
+    for (auto idx : candidates) {
+      const int bucket = static_cast<int>((GetRadixKey<Comparator>(input_data[idx]) >> shift) & (num_buckets - 1));
+      if (bucket > kth_bucket) {
+        top.push_back(idx);
+      } else if (bucket == kth_bucket) {
+        next_candidates.push_back(idx);
+      }
+    }
+
+    candidates.swap(next_candidates);
+  }
+
+  top.insert(top.end(), candidates.begin(), candidates.begin() + remaining);
+  return true;
+}
+
+// TopK along the innermost axis for a few long rows. Each row is split across the threads. A small k is selected
+// per chunk with StreamingSelectTopK and the chunk results merged. A large k uses RadixSelectTopK.
+template <class Comparator>
+static void FindTopKElementsInLongRows(const typename Comparator::DataType* input_data, int64_t rows, int64_t cols,
+                                       const unsigned k, bool sorted,
+                                       typename Comparator::DataType* values_data, int64_t* indices_data,
+                                       concurrency::ThreadPool* threadpool) {
+  const int64_t tp_threads = concurrency::ThreadPool::DegreeOfParallelism(threadpool);
+  const int64_t num_chunks = std::max<int64_t>(std::min(tp_threads, cols / kMinLongRowChunkSize), 1);
+  Comparator comparer(input_data);
+
+  // streaming keeps up to 2k candidates per chunk, so is best when k is a small fraction of the row
+  const bool use_radix_select = static_cast<int64_t>(k) * 64 > cols;
+
+  std::vector<std::vector<int64_t>> chunk_top(num_chunks);
+  std::vector<int64_t> top;
+
+  for (int64_t i = 0; i < rows; ++i) {
+    const int64_t row_offset = i * cols;
+
+    if (!use_radix_select ||
+        !RadixSelectTopK<Comparator>(input_data, row_offset, row_offset + cols, k, num_chunks, threadpool, top)) {
+      concurrency::ThreadPool::TrySimpleParallelFor(threadpool, num_chunks, [&](std::ptrdiff_t chunk) {
+        auto work = concurrency::ThreadPool::PartitionWork(chunk, num_chunks, cols);
+        StreamingSelectTopK(comparer, input_data, row_offset + work.start, row_offset + work.end, k,
+                            chunk_top[chunk]);
+      });
+
+      top.clear();
+      for (const auto& chunk_result : chunk_top) {
+        top.insert(top.end(), chunk_result.begin(), chunk_result.end());
+      }
+
+      if (top.size() > k) {
+        nth_element(top.begin(), top.begin() + (k - 1), top.end(), comparer);
+        top.resize(k);
+      }
+    }
+
+    if (sorted) {
+      std::sort(top.begin(), top.end(), comparer);
+    }
+
+    auto* row_values = values_data + i * k;
+    auto* row_indices = indices_data + i * k;
+    for (unsigned l = 0; l < k; ++l) {
+      row_values[l] = input_data[top[l]];
+      row_indices[l] = top[l] - row_offset;
+    }
+  }
+}
+
 // Given an input tensor 'input' and metadata values - 'k' and 'axis_parsed',
 // this method will extract the sorted top k largest/smallest elements and place them in the output tensor 'values'
 // along with the metadata output 'indices'
@@ -165,6 +455,13 @@ static void FindTopKElements(const Tensor* input, const TensorShape& input_shape
   const int64_t block_slice = reduced_cols / k;
 
   int64_t tp_threads = concurrency::ThreadPool::DegreeOfParallelism(threadpool);
+
+  // too few rows to use all the threads, so split each row instead
+  if (block_slice == 1 && num_blocks >= kMinLongRowSize && rows < std::max<int64_t>(tp_threads, 2)) {
+    FindTopKElementsInLongRows<Comparator>(input_data, rows, cols, k, sorted, values_data, indices_data, threadpool);
+    return;
+  }
+
   int64_t num_threads = std::min(tp_threads, rows);  // split on rows so can't have more threads than rows
 
   // rough attempt to make sure there's enough work for each thread. if there's insufficient work the usage of
@@ -2,9 +2,11 @@
 // Licensed under the MIT License.
 
 #pragma once
+#include <algorithm>
 #include <string>
 #include <vector>
 #include "core/common/common.h"
+#include "core/common/flat_hash_table.h"
 #include "core/framework/op_kernel.h"
 
 namespace onnxruntime {
@@ -16,24 +18,46 @@ class DictVectorizerOp final : public OpKernel {
     //In some stupid models, the vocabulary could have duplicated elements.
     //We must support that, otherwise some tests will be break.
     ORT_ENFORCE(info.GetAttrs(std::is_same<AttrType, std::string>::value ? "string_vocabulary" : "int64_vocabulary", vocabulary_).IsOK());
+
+    // Walk the vocabulary backwards so that each key ends up with its first position, chained to the others.
+    const int64_t vocabulary_size = static_cast<int64_t>(vocabulary_.size());
+    next_positions_.assign(vocabulary_.size(), -1);
+    positions_.Reserve(vocabulary_.size());
+    for (int64_t i = vocabulary_size - 1; i >= 0; --i) {
+      const int64_t* next_position = positions_.Find(vocabulary_[i]);
+      if (next_position != nullptr) {
+        next_positions_[i] = *next_position;
+      }
+      positions_.InsertOrAssign(vocabulary_[i], i);
+    }
   }
   common::Status Compute(OpKernelContext* ctx) const override {
     const auto* map = ctx->Input<std::map<AttrType, TargetType> >(0);
     auto* Y = ctx->Output(0, {1, static_cast<int64_t>(vocabulary_.size())});
     auto* y_data = Y->template MutableData<TargetType>();
-    for (size_t i = 0, end = vocabulary_.size(); i < end; ++i) {
-      auto index = map->find(vocabulary_[i]);
-      if (index != map->end()) {
-        *y_data++ = index->second;
-      } else {
-        //Any keys not present in the input dictionary, will be zero in the output array
-        *y_data++ = TargetType();
+
+    //Any keys not present in the input dictionary, will be zero in the output array.
+    //The input dictionaries are usually much smaller than the vocabulary, so only their entries are looked up.
+    std::fill_n(y_data, vocabulary_.size(), TargetType());
+    for (const auto& entry : *map) {
+      const int64_t* position = positions_.Find(entry.first);
+      if (position == nullptr) {
+        continue;
+      }
+      for (int64_t i = *position; i >= 0; i = next_positions_[i]) {
+        y_data[i] = entry.second;
       }
     }
     return Status::OK();
   }
 
   std::vector<AttrType> vocabulary_;
+
+ private:
+  // First position of each key of the vocabulary, and position of the next occurrence of the key at each position
+  // (-1 for the last one).
+  FlatHashTable<AttrType, int64_t> positions_;
+  std::vector<int64_t> next_positions_;
 };
 
 }  // namespace ml
@@ -3,6 +3,7 @@
 
 #include "core/providers/cpu/ml/linearclassifier.h"
 #include "core/providers/cpu/math/gemm.h"
+#include "core/platform/threadpool.h"
 
 namespace onnxruntime {
 namespace ml {
@@ -35,17 +36,24 @@ LinearClassifier::LinearClassifier(const OpKernelInfo& info)
 
   using_strings_ = !classlabels_strings_.empty();
   class_count_ = static_cast<int64_t>(intercepts_.size());
+  allow_sparse_input_ = AreLinearCoefficientsFinite(coefficients_);
+  if (class_count_ > 1 && allow_sparse_input_) {
+    transposed_coefficients_ = TransposeLinearCoefficients(coefficients_, class_count_);
+  }
 }
 
 // Use GEMM for the calculations, with broadcasting of intercepts
 // https://github.com/onnx/onnx/blob/master/docs/Operators.md#Gemm
 //
-// X: [num_batches, num_features]
+// X: [num_batches, num_features], the rows [first_batch, first_batch + num_batches) of the input
 // coefficients_: [num_targets, num_features]
 // intercepts_: [num_targets]
 // scores: X * coefficients_^T + intercepts_: [num_batches, num_targets]
+//
+// Rows that are mostly zeros, such as the outputs of DictVectorizer or OneHotEncoder, are computed from their
+// non-zero values instead.
 void LinearClassifier::ComputeImpl(const gsl::span<const float> input,
-                                   int64_t num_batches, int64_t num_features, int64_t num_targets,
+                                   int64_t first_batch, int64_t num_batches, int64_t num_features, int64_t num_targets,
                                    const std::vector<float>& coefficients,
                                    const std::vector<float>& intercepts,
                                    Tensor& labels_output, Tensor& scores_output,
@@ -53,26 +61,39 @@ void LinearClassifier::ComputeImpl(const gsl::span<const float> input,
                                    bool add_second_class,
                                    concurrency::ThreadPool* threadpool) const {
   const float* input_data = input.data();
-  auto scores_output_data = scores_output.MutableDataAsSpan<float>();
-  size_t scores_output_size = num_batches * num_targets * (add_second_class ? 2 : 1);
-  ORT_ENFORCE(scores_output_data.length() >= scores_output_size,
+  const int64_t scores_per_batch = num_targets * (add_second_class ? 2 : 1);
+  auto all_scores_output_data = scores_output.MutableDataAsSpan<float>();
+  size_t scores_output_size = (first_batch + num_batches) * scores_per_batch;
+  ORT_ENFORCE(all_scores_output_data.length() >= scores_output_size,
               "Scores output is incorrect size. Expected:", scores_output_size,
-              " Found:", scores_output_data.length());
-
-  TensorShape intercepts_shape({num_targets});
-  onnxruntime::Gemm<float>::ComputeGemm(CBLAS_TRANSPOSE::CblasNoTrans, CBLAS_TRANSPOSE::CblasTrans,
-                                        num_batches, num_targets, num_features,
-                                        1.f, input_data, coefficients.data(), 1.f,
-                                        intercepts.data(), &intercepts_shape,
-                                        scores_output_data.data(),
-                                        threadpool);
+              " Found:", all_scores_output_data.length());
+  auto scores_output_data = all_scores_output_data.subspan(first_batch * scores_per_batch,
+                                                           num_batches * scores_per_batch);
+
+  // With a single class the coefficients are already laid out by feature.
+  const bool use_sparse_input = allow_sparse_input_ && num_batches > 0 &&
+                                static_cast<int64_t>(coefficients.size()) == num_targets * num_features &&
+                                IsSparseLinearInput(input_data, num_features);
+  if (use_sparse_input) {
+    ComputeSparseLinearScores(input_data, num_batches, num_features,
+                              num_targets == 1 ? coefficients.data() : transposed_coefficients_.data(),
+                              intercepts.data(), num_targets, scores_output_data.data());
+  } else {
+    TensorShape intercepts_shape({num_targets});
+    onnxruntime::Gemm<float>::ComputeGemm(CBLAS_TRANSPOSE::CblasNoTrans, CBLAS_TRANSPOSE::CblasTrans,
+                                          num_batches, num_targets, num_features,
+                                          1.f, input_data, coefficients.data(), 1.f,
+                                          intercepts.data(), &intercepts_shape,
+                                          scores_output_data.data(),
+                                          threadpool);
+  }
 
   float* score = scores_output_data.data();
   float* end_scores = score + (num_batches * num_targets);  // we haven't added extra targets yet so iterate the original scores
 
   if (num_targets == 1) {
     if (using_strings_) {
-      std::string* y_out = labels_output.MutableData<std::string>();
+      std::string* y_out = labels_output.MutableData<std::string>() + first_batch;
       bool use_class_labels = classlabels_strings_.size() == 2;
       std::string positive_label = use_class_labels ? classlabels_strings_[1] : "1";
       std::string negative_label = use_class_labels ? classlabels_strings_[0] : "0";
@@ -82,7 +103,7 @@ void LinearClassifier::ComputeImpl(const gsl::span<const float> input,
                                   : negative_label;
       }
     } else {
-      int64_t* y_out = labels_output.MutableData<int64_t>();
+      int64_t* y_out = labels_output.MutableData<int64_t>() + first_batch;
       bool use_class_labels = classlabels_ints_.size() == 2;
       int64_t positive_label = use_class_labels ? classlabels_ints_[1] : 1;
       int64_t negative_label = use_class_labels ? classlabels_ints_[0] : 0;
@@ -93,7 +114,7 @@ void LinearClassifier::ComputeImpl(const gsl::span<const float> input,
       }
     }
   } else {
-    for (int64_t i = 0; i < num_batches; ++i) {
+    for (int64_t i = first_batch; i < first_batch + num_batches; ++i) {
       int maxclass = 0;
       float maxweight = *score++;
 
@@ -120,13 +141,8 @@ void LinearClassifier::ComputeImpl(const gsl::span<const float> input,
 }
 
 template <typename SrcType>
-static void CastInputToFloat(const Tensor& in, gsl::span<float>& out) {
-  size_t shape_size = static_cast<size_t>(in.Shape().Size());
-  ORT_ENFORCE(shape_size == out.length());
-
-  const SrcType* in_data = in.Data<SrcType>();
-  float* out_data = out.data();
-  for (size_t i = 0; i < shape_size; ++i) {
+static void CastInputToFloat(const SrcType* in_data, float* out_data, size_t size) {
+  for (size_t i = 0; i < size; ++i) {
     *out_data++ = static_cast<float>(*in_data++);
   }
 }
@@ -157,47 +173,67 @@ Status LinearClassifier::Compute(OpKernelContext* ctx) const {
 
   concurrency::ThreadPool* tp = ctx->GetOperatorThreadPool();
 
-  gsl::span<const float> input;
-  float* cast_buffer = nullptr;
-
   auto element_type = X.GetElementType();
   AllocatorPtr alloc;
 
-  if (element_type == ONNX_NAMESPACE::TensorProto_DataType_FLOAT) {
-    input = X.DataAsSpan<float>();
-  } else {
-    // at some point we need to convert to float as output Z has type 'tensor(float)'.
-    // we have a fast GEMM implementation for float, so convert the input to float so we can use that.
-    auto status = ctx->GetTempSpaceAllocator(&alloc);
-    auto num_elements = input_shape.Size();
-    cast_buffer = reinterpret_cast<float*>(alloc->AllocArray(num_elements, sizeof(float)));
-    auto cast_span = gsl::make_span<float>(cast_buffer, num_elements);
-
+  if (element_type != ONNX_NAMESPACE::TensorProto_DataType_FLOAT) {
     switch (element_type) {
-      case ONNX_NAMESPACE::TensorProto_DataType_INT32: {
-        CastInputToFloat<int32_t>(X, cast_span);
-        break;
-      }
-      case ONNX_NAMESPACE::TensorProto_DataType_INT64: {
-        CastInputToFloat<int64_t>(X, cast_span);
-        break;
-      }
-      case ONNX_NAMESPACE::TensorProto_DataType_DOUBLE: {
-        CastInputToFloat<double>(X, cast_span);
+      case ONNX_NAMESPACE::TensorProto_DataType_INT32:
+      case ONNX_NAMESPACE::TensorProto_DataType_INT64:
+      case ONNX_NAMESPACE::TensorProto_DataType_DOUBLE:
         break;
-      }
       default:
         return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "Unsupported input element type of ", element_type);
     }
-
-    input = cast_span;
+    ORT_RETURN_IF_ERROR(ctx->GetTempSpaceAllocator(&alloc));
   }
 
-  ComputeImpl(input, num_batches, num_features, class_count_, coefficients_, intercepts_,
-              *Y, *Z, post_transform_, add_second_class, tp);
+  // Computes the rows [first, last): converts them to float if needed, as output Z has type 'tensor(float)' and we
+  // have a fast GEMM implementation for float, then runs the GEMM, picks the labels and applies the post transform
+  // while the scores are still in the cache.
+  auto compute_rows = [&](std::ptrdiff_t first, std::ptrdiff_t last, concurrency::ThreadPool* gemm_threadpool) {
+    const int64_t num_rows = last - first;
+    const size_t num_elements = static_cast<size_t>(num_rows * num_features);
+
+    gsl::span<const float> input;
+    IAllocatorUniquePtr<float> cast_buffer;
+    if (element_type == ONNX_NAMESPACE::TensorProto_DataType_FLOAT) {
+      input = gsl::make_span(X.Data<float>() + first * num_features, num_elements);
+    } else {
+      cast_buffer = IAllocator::MakeUniquePtr<float>(alloc, num_elements);
+      const int64_t offset = first * num_features;
+      switch (element_type) {
+        case ONNX_NAMESPACE::TensorProto_DataType_INT32:
+          CastInputToFloat(X.Data<int32_t>() + offset, cast_buffer.get(), num_elements);
+          break;
+        case ONNX_NAMESPACE::TensorProto_DataType_INT64:
+          CastInputToFloat(X.Data<int64_t>() + offset, cast_buffer.get(), num_elements);
+          break;
+        default:
+          CastInputToFloat(X.Data<double>() + offset, cast_buffer.get(), num_elements);
+          break;
+      }
+      input = gsl::make_span<const float>(cast_buffer.get(), num_elements);
+    }
 
-  if (cast_buffer != nullptr) {
-    alloc->Free(cast_buffer);
+    ComputeImpl(input, first, num_rows, num_features, class_count_, coefficients_, intercepts_,
+                *Y, *Z, post_transform_, add_second_class, gemm_threadpool);
+  };
+
+  // With many rows every thread runs the whole computation on its own block of rows. With fewer rows than threads
+  // the threads split the GEMM instead.
+  if (num_batches < concurrency::ThreadPool::DegreeOfParallelism(tp)) {
+    compute_rows(0, num_batches, tp);
+  } else {
+    const double cost_per_row = static_cast<double>(num_features * class_count_ * 2 + output_classes * 8);
+    concurrency::ThreadPool::TryParallelFor(
+        tp, num_batches,
+        TensorOpCost{static_cast<double>(num_features * sizeof(float)),
+                     static_cast<double>(output_classes * sizeof(float)),
+                     cost_per_row},
+        [&compute_rows](std::ptrdiff_t first, std::ptrdiff_t last) {
+          compute_rows(first, last, nullptr);
+        });
   }
 
   return Status::OK();
@@ -17,7 +17,8 @@ class LinearClassifier final : public OpKernel {
   Status Compute(OpKernelContext* context) const override;
 
  private:
-  void ComputeImpl(const gsl::span<const float> input, int64_t num_batches, int64_t num_features, int64_t num_targets,
+  void ComputeImpl(const gsl::span<const float> input, int64_t first_batch, int64_t num_batches,
+                   int64_t num_features, int64_t num_targets,
                    const std::vector<float>& coefficients,
                    const std::vector<float>& intercepts,
                    Tensor& labels_output,
@@ -31,6 +32,10 @@ class LinearClassifier final : public OpKernel {
   POST_EVAL_TRANSFORM post_transform_;
   bool using_strings_;
   std::vector<float> coefficients_;
+  // [num_features, class_count_] copy of the coefficients for the sparse inputs, empty for a single class.
+  std::vector<float> transposed_coefficients_;
+  // False if a coefficient is Inf or NaN, in which case every row goes through GEMM.
+  bool allow_sparse_input_;
   std::vector<float> intercepts_;
   std::vector<std::string> classlabels_strings_;
   std::vector<int64_t> classlabels_ints_;
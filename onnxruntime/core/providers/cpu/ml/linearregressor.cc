@@ -3,6 +3,7 @@
 
 #include "core/providers/cpu/ml/linearregressor.h"
 #include "core/providers/cpu/math/gemm.h"
+#include "core/platform/threadpool.h"
 
 namespace onnxruntime {
 namespace ml {
@@ -25,6 +26,10 @@ LinearRegressor::LinearRegressor(const OpKernelInfo& info)
 
   // use the intercepts_ if they're valid
   use_intercepts_ = intercepts_.size() == static_cast<size_t>(num_targets_);
+  allow_sparse_input_ = AreLinearCoefficientsFinite(coefficients_);
+  if (num_targets_ > 1 && allow_sparse_input_) {
+    transposed_coefficients_ = TransposeLinearCoefficients(coefficients_, num_targets_);
+  }
 }
 
 // Use GEMM for the calculations, with broadcasting of intercepts
@@ -34,16 +39,24 @@ LinearRegressor::LinearRegressor(const OpKernelInfo& info)
 // coefficients_: [num_targets, num_features]
 // intercepts_: optional [num_targets].
 // Output: X * coefficients_^T + intercepts_: [num_batches, num_targets]
+//
+// Rows that are mostly zeros are computed from their non-zero values with transposed_coefficients
+// ([num_features, num_targets], empty with a single target as the coefficients are already laid out by feature),
+// unless allow_sparse_input is false because a coefficient is not finite.
 template <typename T>
-static Status ComputeImpl(const Tensor& input, int64_t num_batches, int64_t num_features, int64_t num_targets,
+static Status ComputeImpl(const T* input_data, int64_t num_batches, int64_t num_features, int64_t num_targets,
                           const std::vector<float>& coefficients,
-                          const std::vector<float>* intercepts, Tensor& output,
+                          const std::vector<float>& transposed_coefficients,
+                          bool allow_sparse_input, const std::vector<float>* intercepts, T* output_data,
                           POST_EVAL_TRANSFORM post_transform,
                           concurrency::ThreadPool* threadpool) {
-  const T* input_data = input.Data<T>();
-  T* output_data = output.MutableData<T>();
-
-  if (intercepts != nullptr) {
+  const auto& coefficients_by_feature = num_targets == 1 ? coefficients : transposed_coefficients;
+  if (allow_sparse_input && num_batches > 0 &&
+      static_cast<int64_t>(coefficients_by_feature.size()) == num_targets * num_features &&
+      IsSparseLinearInput(input_data, num_features)) {
+    ComputeSparseLinearScores(input_data, num_batches, num_features, coefficients_by_feature.data(),
+                              intercepts != nullptr ? intercepts->data() : nullptr, num_targets, output_data);
+  } else if (intercepts != nullptr) {
     TensorShape intercepts_shape({num_targets});
     onnxruntime::Gemm<T>::ComputeGemm(CBLAS_TRANSPOSE::CblasNoTrans, CBLAS_TRANSPOSE::CblasTrans,
                                       num_batches, num_targets, num_features,
@@ -88,9 +101,29 @@ Status LinearRegressor::Compute(OpKernelContext* ctx) const {
 
   switch (element_type) {
     case ONNX_NAMESPACE::TensorProto_DataType_FLOAT: {
-      status = ComputeImpl<float>(X, num_batches, num_features, num_targets_, coefficients_,
+      const float* input_data = X.Data<float>();
+      float* output_data = Y.MutableData<float>();
+      auto compute_rows = [&](std::ptrdiff_t first, std::ptrdiff_t last, concurrency::ThreadPool* gemm_threadpool) {
+        return ComputeImpl<float>(input_data + first * num_features, last - first, num_features, num_targets_,
+                                  coefficients_, transposed_coefficients_, allow_sparse_input_,
                                   use_intercepts_ ? &intercepts_ : nullptr,
-                                  Y, post_transform_, tp);
+                                  output_data + first * num_targets_, post_transform_, gemm_threadpool);
+      };
+
+      // With many rows every thread runs the GEMM and the post transform on its own block of rows, so the
+      // post transform reads the outputs from the cache. With fewer rows than threads the threads split the GEMM.
+      if (num_batches < concurrency::ThreadPool::DegreeOfParallelism(tp)) {
+        status = compute_rows(0, num_batches, tp);
+      } else {
+        concurrency::ThreadPool::TryParallelFor(
+            tp, num_batches,
+            TensorOpCost{static_cast<double>(num_features * sizeof(float)),
+                         static_cast<double>(num_targets_ * sizeof(float)),
+                         static_cast<double>(num_features * num_targets_ * 2 + num_targets_ * 8)},
+            [&compute_rows](std::ptrdiff_t first, std::ptrdiff_t last) {
+              ORT_THROW_IF_ERROR(compute_rows(first, last, nullptr));
+            });
+      }
 
       break;
     }
@@ -19,6 +19,10 @@ class LinearRegressor final : public OpKernel {
  private:
   int64_t num_targets_;
   std::vector<float> coefficients_;
+  // [num_features, num_targets_] copy of the coefficients for the sparse inputs, empty for a single target.
+  std::vector<float> transposed_coefficients_;
+  // False if a coefficient is Inf or NaN, in which case every row goes through GEMM.
+  bool allow_sparse_input_;
   std::vector<float> intercepts_;
   bool use_intercepts_;
   POST_EVAL_TRANSFORM post_transform_;
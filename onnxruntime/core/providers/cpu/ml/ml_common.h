@@ -2,9 +2,14 @@
 // Licensed under the MIT License.
 
 #pragma once
+#include <algorithm>
+#include <cmath>
+
 #include "core/common/common.h"
+#include "core/common/flat_hash_table.h"
 #include "core/common/safeint.h"
 #include "core/framework/op_kernel.h"
+#include "core/framework/string_tensor_view.h"
 #include "core/util/math.h"
 #include "core/util/math_cpuonly.h"
 #include "core/mlas/inc/mlas.h"
@@ -529,5 +534,102 @@ void batched_update_scores_inplace(gsl::span<T> scores, int64_t num_batches_in,
     }
   }
 }
+
+// Maps every input value through `table`, writing `default_value` for the values missing from the table.
+// The lookups are independent of each other so large inputs are split across the thread pool.
+template <typename TKey, typename TValue>
+void MapWithDefault(concurrency::ThreadPool* threadpool, const FlatHashTable<TKey, TValue>& table,
+                    gsl::span<const TKey> input, gsl::span<TValue> output, const TValue& default_value) {
+  assert(input.size() == output.size());
+  concurrency::ThreadPool::TryParallelFor(
+      threadpool, static_cast<std::ptrdiff_t>(input.size()),
+      TensorOpCost{static_cast<double>(sizeof(TKey)), static_cast<double>(sizeof(TValue)), 32.0},
+      [&table, &input, &output, &default_value](std::ptrdiff_t first, std::ptrdiff_t last) {
+        for (std::ptrdiff_t i = first; i < last; ++i) {
+          const TValue* value = table.Find(input[i]);
+          output[i] = value != nullptr ? *value : default_value;
+        }
+      });
+}
+
+// MapWithDefault for a string input in either string tensor layout. The strings are looked up as std::string_view,
+// without a copy of the key.
+template <typename TValue>
+void MapWithDefault(concurrency::ThreadPool* threadpool, const FlatHashTable<std::string, TValue>& table,
+                    const StringTensorView& input, gsl::span<TValue> output, const TValue& default_value) {
+  assert(input.Size() == output.size());
+  concurrency::ThreadPool::TryParallelFor(
+      threadpool, static_cast<std::ptrdiff_t>(input.Size()),
+      TensorOpCost{static_cast<double>(sizeof(std::string)), static_cast<double>(sizeof(TValue)), 32.0},
+      [&table, &input, &output, &default_value](std::ptrdiff_t first, std::ptrdiff_t last) {
+        for (std::ptrdiff_t i = first; i < last; ++i) {
+          const TValue* value = table.FindEquivalent(input[static_cast<size_t>(i)]);
+          output[i] = value != nullptr ? *value : default_value;
+        }
+      });
+}
+
+// Rows produced by DictVectorizer or OneHotEncoder have a few non-zero values among thousands of features. The
+// linear models compute such rows from their non-zero values instead of multiplying every feature in a GEMM.
+constexpr int64_t kSparseLinearMinFeatures = 128;
+constexpr int64_t kSparseLinearMaxDensity = 8;  // at most one non-zero value every 8 features
+
+// Returns true if a row is sparse enough for ComputeSparseLinearScores. The rows of an input tend to share their
+// sparsity so the linear models only check the first row of each block of rows.
+inline bool IsSparseLinearInput(const float* row, int64_t num_features) {
+  if (num_features < kSparseLinearMinFeatures) {
+    return false;
+  }
+  int64_t num_non_zeros = 0;
+  for (int64_t i = 0; i < num_features; ++i) {
+    num_non_zeros += row[i] != 0.f;
+  }
+  return num_non_zeros * kSparseLinearMaxDensity <= num_features;
+}
+
+// Skipping the zero values of a row is only exact if every coefficient is finite, as 0 * Inf and 0 * NaN are NaN.
+inline bool AreLinearCoefficientsFinite(const std::vector<float>& coefficients) {
+  return std::all_of(coefficients.cbegin(), coefficients.cend(), [](float c) { return std::isfinite(c); });
+}
+
+// Returns the [num_targets, num_features] coefficients of a linear model as [num_features, num_targets], so that
+// the weights of a feature for all the targets are contiguous.
+inline std::vector<float> TransposeLinearCoefficients(const std::vector<float>& coefficients, int64_t num_targets) {
+  if (num_targets <= 0 || coefficients.size() % num_targets != 0) {
+    return {};
+  }
+  const size_t num_features = coefficients.size() / num_targets;
+  std::vector<float> transposed(coefficients.size());
+  for (int64_t t = 0; t < num_targets; ++t) {
+    for (size_t f = 0; f < num_features; ++f) {
+      transposed[f * num_targets + t] = coefficients[t * num_features + f];
+    }
+  }
+  return transposed;
+}
+
+// scores[r][t] = intercepts[t] + the sum of input[r][f] * transposed_coefficients[f][t] over the non-zero input[r][f].
+// The intercepts are optional.
+inline void ComputeSparseLinearScores(const float* input, int64_t num_rows, int64_t num_features,
+                                      const float* transposed_coefficients, const float* intercepts,
+                                      int64_t num_targets, float* scores) {
+  for (int64_t r = 0; r < num_rows; ++r, input += num_features, scores += num_targets) {
+    if (intercepts != nullptr) {
+      std::copy_n(intercepts, num_targets, scores);
+    } else {
+      std::fill_n(scores, num_targets, 0.f);
+    }
+    for (int64_t f = 0; f < num_features; ++f) {
+      const float value = input[f];
+      if (value != 0.f) {
+        const float* weights = transposed_coefficients + f * num_targets;
+        for (int64_t t = 0; t < num_targets; ++t) {
+          scores[t] += value * weights[t];
+        }
+      }
+    }
+  }
+}
+
 }  // namespace ml
 }  // namespace onnxruntime
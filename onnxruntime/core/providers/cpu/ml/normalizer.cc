@@ -2,6 +2,7 @@
 // Licensed under the MIT License.
 
 #include "core/providers/cpu/ml/normalizer.h"
+#include "core/platform/threadpool.h"
 
 #include <algorithm>
 #include "gsl/gsl"
@@ -137,17 +138,18 @@ Status Normalizer::Normalize(OpKernelContext* context) const {
   const T* input = X.template Data<T>();
   float* output = Y->MutableData<float>();
 
+  void (*normalize)(const T*, float*, int64_t, int64_t);
   switch (normalization_) {
     case NORMALIZE::NMAX: {
-      NormalizeMax(input, output, num_batches, batch_size);
+      normalize = NormalizeMax<T>;
       break;
     }
     case NORMALIZE::L1: {
-      NormalizeL1(input, output, num_batches, batch_size);
+      normalize = NormalizeL1<T>;
       break;
     }
     case NORMALIZE::L2: {
-      NormalizeL2(input, output, num_batches, batch_size);
+      normalize = NormalizeL2<T>;
       break;
     }
     default: {
@@ -155,6 +157,15 @@ Status Normalizer::Normalize(OpKernelContext* context) const {
     }
   }
 
+  // The rows are normalized independently of each other.
+  concurrency::ThreadPool::TryParallelFor(
+      context->GetOperatorThreadPool(), num_batches,
+      TensorOpCost{static_cast<double>(batch_size * sizeof(T)), static_cast<double>(batch_size * sizeof(float)),
+                   static_cast<double>(batch_size * 4)},
+      [normalize, input, output, batch_size](std::ptrdiff_t first, std::ptrdiff_t last) {
+        normalize(input + first * batch_size, output + first * batch_size, last - first, batch_size);
+      });
+
   return Status::OK();
 }
 
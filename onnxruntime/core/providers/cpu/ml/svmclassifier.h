@@ -8,6 +8,7 @@
 #include "core/util/math_cpuonly.h"
 #include "ml_common.h"
 #include "core/providers/cpu/math/gemm.h"
+#include "core/platform/threadpool.h"
 
 namespace onnxruntime {
 namespace ml {
@@ -30,6 +31,20 @@ class SVMCommon {
   void set_kernel_type(KERNEL new_kernel_type) { kernel_type_ = new_kernel_type; }
   KERNEL get_kernel_type() const { return kernel_type_; }
 
+  // Caches the squared norms of the support vectors ([vector_count, feature_count]) for the RBF kernel.
+  void set_support_vectors(gsl::span<const float> support_vectors, int64_t vector_count, int64_t feature_count) {
+    support_vectors_norm_.clear();
+    if (kernel_type_ != KERNEL::RBF) {
+      return;
+    }
+    support_vectors_norm_.resize(static_cast<size_t>(vector_count));
+    for (int64_t i = 0; i < vector_count; ++i) {
+      auto vector = ConstEigenVectorMap<float>(support_vectors.data() + i * feature_count,
+                                               static_cast<size_t>(feature_count));
+      support_vectors_norm_[static_cast<size_t>(i)] = vector.squaredNorm();
+    }
+  }
+
   template <typename T>
   void batched_kernel_dot(const gsl::span<const T> a, const gsl::span<const T> b,
                           int64_t m, int64_t n, int64_t k,
@@ -38,65 +53,84 @@ class SVMCommon {
                           concurrency::ThreadPool* threadpool) const {
     assert(a.size() == size_t(m * k) && b.size() == size_t(k * n) && out.size() == size_t(m * n));
 
+    float alpha = 1.f;
+    float beta = 1.f;
+    static const TensorShape shape_C({1});
+    float c = scalar_C;  // scalar_C is used for LINEAR in the GEMM
+
     if (kernel_type_ == KERNEL::RBF) {
-      T* cur_out = out.data();
-      const T* cur_batch = a.data();
+      // |a - b|^2 = |a|^2 + |b|^2 - 2 a.b, the GEMM computes -2 a.b and the norms are added below.
+      assert(support_vectors_norm_.size() == size_t(n));
+      alpha = -2.f;
+      c = 0.f;
+    } else if (kernel_type_ != KERNEL::LINEAR) {
+      // kernel_type_ == POLY or SIGMOID
+      alpha = gamma_;
+      c = coef0_;
+    }
 
-      // each batch has 'k' features
-      for (int64_t batch = 0; batch < m; ++batch) {
-        const T* cur_support_vector = b.data();
+    onnxruntime::Gemm<T>::ComputeGemm(CBLAS_TRANSPOSE::CblasNoTrans, CBLAS_TRANSPOSE::CblasTrans,
+                                      m, n, k,
+                                      alpha, a.data(), b.data(), beta,
+                                      c != 0.f ? &c : nullptr, &shape_C,
+                                      out.data(),
+                                      threadpool);
 
-        // broadcast the support vectors against the k features in each batch. output is one value per support vector
-        for (int64_t support_vector = 0; support_vector < n; ++support_vector) {
-          T sum = 0.f;
-          const T* cur_input = cur_batch;
+    if (kernel_type_ == KERNEL::LINEAR) {
+      return;
+    }
 
-          for (int64_t feature = 0; feature < k; ++feature) {
-            T val = *cur_input++ - *cur_support_vector++;
-            sum += val * val;
-          }
+    // Apply the kernel function to the rows of the GEMM output in parallel.
+    auto apply_kernel = [this, &a, &b, k, n, &out](std::ptrdiff_t first, std::ptrdiff_t last) {
+      for (std::ptrdiff_t row = first; row < last; ++row) {
+        T* cur_out = out.data() + row * n;
 
-          *cur_out++ = std::exp(-gamma_ * sum);
-        }
+        if (kernel_type_ == KERNEL::RBF) {
+          const T* cur_input = a.data() + row * k;
+          const T input_norm = ConstEigenVectorMap<T>(cur_input, static_cast<size_t>(k)).squaredNorm();
 
-        cur_batch += k;  // move to start of next batch
-      }
-    } else {
-      float alpha = 1.f;
-      float beta = 1.f;
-      static const TensorShape shape_C({1});
-      float c = scalar_C;  // scalar_C is used for LINEAR in the GEMM
-
-      if (kernel_type_ != KERNEL::LINEAR) {
-        // kernel_type_ == POLY or SIGMOID
-        alpha = gamma_;
-        c = coef0_;
-      }
+          for (int64_t support_vector = 0; support_vector < n; ++support_vector) {
+            const T norms = input_norm + static_cast<T>(support_vectors_norm_[support_vector]);
+            T distance = cur_out[support_vector] + norms;
+
+            // The expansion loses most of its precision when the input is close to the support vector
+            // compared to their norms, which is also when the kernel value matters: compute it directly.
+            if (distance < norms * static_cast<T>(1.f / 1024)) {
+              auto diff = ConstEigenVectorMap<T>(cur_input, static_cast<size_t>(k)) -
+                          ConstEigenVectorMap<T>(b.data() + support_vector * k, static_cast<size_t>(k));
+              distance = diff.squaredNorm();
+            }
 
-      onnxruntime::Gemm<T>::ComputeGemm(CBLAS_TRANSPOSE::CblasNoTrans, CBLAS_TRANSPOSE::CblasTrans,
-                                        m, n, k,
-                                        alpha, a.data(), b.data(), beta,
-                                        c != 0.f ? &c : nullptr, &shape_C,
-                                        out.data(),
-                                        threadpool);
-
-      if (kernel_type_ == KERNEL::POLY) {
-        auto map_out = EigenVectorArrayMap<T>(out.data(), out.size());
-        if (degree_ == 2)
-          map_out = map_out.square();
-        else if (degree_ == 3)
-          map_out = map_out.cube();
-        else
-          map_out = map_out.pow(degree_);
-
-      } else if (kernel_type_ == KERNEL::SIGMOID) {
-        MlasComputeTanh(out.data(), out.data(), out.size());
+            cur_out[support_vector] = -gamma_ * distance;
+          }
+
+          MlasComputeExp(cur_out, cur_out, static_cast<size_t>(n));
+        } else if (kernel_type_ == KERNEL::POLY) {
+          auto map_out = EigenVectorArrayMap<T>(cur_out, static_cast<size_t>(n));
+          if (degree_ == 2)
+            map_out = map_out.square();
+          else if (degree_ == 3)
+            map_out = map_out.cube();
+          else
+            map_out = map_out.pow(degree_);
+
+        } else if (kernel_type_ == KERNEL::SIGMOID) {
+          MlasComputeTanh(cur_out, cur_out, static_cast<size_t>(n));
+        }
       }
-    }
+    };
+
+    const double cost_per_row = static_cast<double>(n) * (kernel_type_ == KERNEL::RBF ? 24.0 : 8.0);
+    concurrency::ThreadPool::TryParallelFor(threadpool, m,
+                                            TensorOpCost{static_cast<double>(n * sizeof(T)),
+                                                         static_cast<double>(n * sizeof(T)),
+                                                         cost_per_row},
+                                            apply_kernel);
   }
 
  private:
   KERNEL kernel_type_;
+  std::vector<float> support_vectors_norm_;
   float gamma_{0.f};
   float coef0_{0.f};
   float degree_{0.f};
@@ -106,6 +140,7 @@ class SVMClassifier final : public OpKernel, private SVMCommon {
   using SVMCommon::batched_kernel_dot;
   using SVMCommon::set_kernel_type;
   using SVMCommon::get_kernel_type;
+  using SVMCommon::set_support_vectors;
 
  public:
   SVMClassifier(const OpKernelInfo& info);
@@ -139,8 +139,8 @@ template <typename T>
 TreeEnsembleClassifier<T>::TreeEnsembleClassifier(const OpKernelInfo& info)
     : OpKernel(info),
       tree_ensemble_(
-          80,
-          50,
+          128,
+          64,
           info.GetAttrOrDefault<std::string>("aggregate_function", "SUM"),
           info.GetAttrsOrDefault<float>("base_values"),
           info.GetAttrsOrDefault<int64_t>("nodes_falsenodeids"),
@@ -3,6 +3,9 @@
 
 #pragma once
 
+#include <limits>
+#include <type_traits>
+
 #include "tree_ensemble_aggregator.h"
 #include "core/platform/ort_mutex.h"
 #include "core/platform/threadpool.h"
@@ -28,9 +31,43 @@ class TreeEnsembleCommon {
   int64_t n_trees_;
   bool same_mode_;
   bool has_missing_tracks_;
+  // The thresholds are tuned on the batched traversal (a few nanoseconds per row and tree) against the cost
+  // of dispatching work to the thread pool: parallel_N_ should stay a multiple of kRowBlockSize.
   int parallel_tree_;  // starts parallelizing the computing if n_tree >= parallel_tree_ and n_rows == 1
   int parallel_N_;     // starts parallelizing the computing if n_rows >= parallel_N_
 
+  // Number of rows traversed together through the same tree.
+  static constexpr int64_t kRowBlockSize = 32;
+
+  // Deepest tree evaluated with MlasTreeTraversePerfect.
+  static constexpr int64_t kMaxPerfectTreeDepth = 16;
+
+  // Flattened copy of the trees used for the traversal. Every tree is stored depth-first (the true branch
+  // first) in contiguous arrays holding one entry per decision node. A child index >= 0 refers to another
+  // decision node, a negative child index ~k refers to the leaf flat_leaves_[k]. The layout is not built
+  // when the trees share nodes or are not well formed, the traversal follows the node pointers in that case.
+  bool use_flat_layout_;
+  NODE_MODE flat_mode_;  // mode of every decision node when same_mode_ is true
+  std::vector<int32_t> flat_roots_;
+  std::vector<int32_t> flat_feature_ids_;
+  std::vector<OTYPE> flat_thresholds_;
+  std::vector<int32_t> flat_truenodes_;
+  std::vector<int32_t> flat_falsenodes_;
+  std::vector<NODE_MODE> flat_modes_;                // only filled when same_mode_ is false
+  std::vector<uint8_t> flat_missing_tracks_true_;    // only filled when has_missing_tracks_ is true
+  std::vector<const TreeNodeElement<OTYPE>*> flat_leaves_;
+
+  // Perfect trees (every leaf at the same depth, no missing value tracked to the true branch) with float
+  // inputs are also stored breadth-first for MlasTreeTraversePerfect, which routes the rows without branches.
+  // perfect_depths_[j] is 0 if tree j is not perfect.
+  MLAS_TREE_BRANCH_MODE perfect_mode_;
+  std::vector<int32_t> perfect_depths_;
+  std::vector<size_t> perfect_node_offsets_;
+  std::vector<size_t> perfect_leaf_offsets_;
+  std::vector<int32_t> perfect_feature_ids_;
+  std::vector<OTYPE> perfect_thresholds_;
+  std::vector<const TreeNodeElement<OTYPE>*> perfect_leaves_;
+
  public:
   TreeEnsembleCommon(int parallel_tree,
                      int parallel_N,
@@ -58,6 +95,20 @@ class TreeEnsembleCommon {
   TreeNodeElement<OTYPE>* ProcessTreeNodeLeave(
       TreeNodeElement<OTYPE>* root, const ITYPE* x_data) const;
 
+  // Finds the leaves reached in tree j by count rows (count <= kRowBlockSize) starting at x_data.
+  void ProcessTreeNodeLeaves(size_t j, const ITYPE* x_data, int64_t stride, int64_t count,
+                             const TreeNodeElement<OTYPE>** leaves) const;
+
+  template <typename CMP, bool missing_tracks>
+  void ProcessFlatTreeNodeLeaves(int32_t root, const ITYPE* x_data, int64_t stride, int64_t count,
+                                 const TreeNodeElement<OTYPE>** leaves, CMP cmp) const;
+
+  bool FlattenTree(const TreeNodeElement<OTYPE>* node, int64_t depth, size_t max_size, int32_t& index);
+
+  int64_t PerfectTreeDepth(int32_t index) const;
+
+  void FillPerfectTree(int32_t index, size_t position, int64_t depth, size_t node_offset, size_t leaf_offset);
+
   template <typename AGG>
   void ComputeAgg(concurrency::ThreadPool* ttp, const Tensor* X, Tensor* Z, Tensor* label, const AGG& agg) const;
 };
@@ -213,6 +264,156 @@ TreeEnsembleCommon<ITYPE, OTYPE>::TreeEnsembleCommon(int parallel_tree, int para
       break;
     }
   }
+
+  flat_mode_ = NODE_MODE::LEAF;
+  for (i = 0; i < static_cast<size_t>(n_nodes_); ++i) {
+    if (nodes_[i].is_not_leaf) {
+      flat_mode_ = nodes_[i].mode;
+      break;
+    }
+  }
+
+  // Builds the flattened layout. Trees sharing subtrees are expanded, the size limit
+  // keeps that expansion bounded.
+  const size_t max_flat_size = static_cast<size_t>(n_nodes_) * 4;
+  use_flat_layout_ = max_flat_size < static_cast<size_t>(std::numeric_limits<int32_t>::max());
+  flat_roots_.resize(roots_.size());
+  for (i = 0; i < roots_.size() && use_flat_layout_; ++i) {
+    use_flat_layout_ = FlattenTree(roots_[i], 0, max_flat_size, flat_roots_[i]);
+  }
+  if (!use_flat_layout_) {
+    flat_roots_.clear();
+    flat_feature_ids_.clear();
+    flat_thresholds_.clear();
+    flat_truenodes_.clear();
+    flat_falsenodes_.clear();
+    flat_modes_.clear();
+    flat_missing_tracks_true_.clear();
+    flat_leaves_.clear();
+  }
+
+  // Builds the breadth-first layout of the perfect trees.
+  perfect_mode_ = MlasTreeBranchLeq;
+  if (std::is_same<ITYPE, float>::value && std::is_same<OTYPE, float>::value && use_flat_layout_ && same_mode_) {
+    bool has_perfect_trees = true;
+    switch (flat_mode_) {
+      case NODE_MODE::BRANCH_LEQ:
+        perfect_mode_ = MlasTreeBranchLeq;
+        break;
+      case NODE_MODE::BRANCH_LT:
+        perfect_mode_ = MlasTreeBranchLt;
+        break;
+      case NODE_MODE::BRANCH_GTE:
+        perfect_mode_ = MlasTreeBranchGte;
+        break;
+      case NODE_MODE::BRANCH_GT:
+        perfect_mode_ = MlasTreeBranchGt;
+        break;
+      case NODE_MODE::BRANCH_EQ:
+        perfect_mode_ = MlasTreeBranchEq;
+        break;
+      case NODE_MODE::BRANCH_NEQ:
+        perfect_mode_ = MlasTreeBranchNeq;
+        break;
+      default:
+        has_perfect_trees = false;
+        break;
+    }
+
+    if (has_perfect_trees) {
+      perfect_depths_.resize(roots_.size());
+      perfect_node_offsets_.resize(roots_.size());
+      perfect_leaf_offsets_.resize(roots_.size());
+      for (i = 0; i < roots_.size(); ++i) {
+        int64_t depth = PerfectTreeDepth(flat_roots_[i]);
+        if (depth < 1 || depth > kMaxPerfectTreeDepth) {
+          perfect_depths_[i] = 0;
+          continue;
+        }
+        perfect_depths_[i] = static_cast<int32_t>(depth);
+        perfect_node_offsets_[i] = perfect_feature_ids_.size();
+        perfect_leaf_offsets_[i] = perfect_leaves_.size();
+        perfect_feature_ids_.resize(perfect_feature_ids_.size() + (size_t(1) << depth) - 1);
+        perfect_thresholds_.resize(perfect_feature_ids_.size());
+        perfect_leaves_.resize(perfect_leaves_.size() + (size_t(1) << depth));
+        FillPerfectTree(flat_roots_[i], 0, depth, perfect_node_offsets_[i], perfect_leaf_offsets_[i]);
+      }
+      if (perfect_leaves_.empty()) {
+        perfect_depths_.clear();
+      }
+    }
+  }
+}
+
+template <typename ITYPE, typename OTYPE>
+int64_t TreeEnsembleCommon<ITYPE, OTYPE>::PerfectTreeDepth(int32_t index) const {
+  if (index < 0) {
+    return 0;
+  }
+  if (has_missing_tracks_ && flat_missing_tracks_true_[index]) {
+    return -1;
+  }
+  int64_t depth = PerfectTreeDepth(flat_truenodes_[index]);
+  if (depth < 0 || depth >= kMaxPerfectTreeDepth || depth != PerfectTreeDepth(flat_falsenodes_[index])) {
+    return -1;
+  }
+  return depth + 1;
+}
+
+template <typename ITYPE, typename OTYPE>
+void TreeEnsembleCommon<ITYPE, OTYPE>::FillPerfectTree(int32_t index, size_t position, int64_t depth,
+                                                       size_t node_offset, size_t leaf_offset) {
+  // The children of node i are the nodes 2*i+1 (true) and 2*i+2 (false), the leaves follow the last level.
+  if (index < 0) {
+    perfect_leaves_[leaf_offset + position - ((size_t(1) << depth) - 1)] = flat_leaves_[~index];
+    return;
+  }
+  perfect_feature_ids_[node_offset + position] = flat_feature_ids_[index];
+  perfect_thresholds_[node_offset + position] = flat_thresholds_[index];
+  FillPerfectTree(flat_truenodes_[index], 2 * position + 1, depth, node_offset, leaf_offset);
+  FillPerfectTree(flat_falsenodes_[index], 2 * position + 2, depth, node_offset, leaf_offset);
+}
+
+template <typename ITYPE, typename OTYPE>
+bool TreeEnsembleCommon<ITYPE, OTYPE>::FlattenTree(const TreeNodeElement<OTYPE>* node, int64_t depth,
+                                                   size_t max_size, int32_t& index) {
+  if (flat_feature_ids_.size() + flat_leaves_.size() >= max_size) {
+    return false;
+  }
+
+  if (!node->is_not_leaf) {
+    index = ~static_cast<int32_t>(flat_leaves_.size());
+    flat_leaves_.push_back(node);
+    return true;
+  }
+
+  if (node->truenode == nullptr || node->falsenode == nullptr || depth >= max_tree_depth_) {
+    return false;
+  }
+
+  const size_t position = flat_feature_ids_.size();
+  index = static_cast<int32_t>(position);
+  flat_feature_ids_.push_back(node->feature_id);
+  flat_thresholds_.push_back(node->value);
+  flat_truenodes_.push_back(0);
+  flat_falsenodes_.push_back(0);
+  if (!same_mode_) {
+    flat_modes_.push_back(node->mode);
+  }
+  if (has_missing_tracks_) {
+    flat_missing_tracks_true_.push_back(node->is_missing_track_true ? 1 : 0);
+  }
+
+  int32_t child;
+  if (!FlattenTree(node->truenode, depth + 1, max_size, child)) {
+    return false;
+  }
+  flat_truenodes_[position] = child;
+  if (!FlattenTree(node->falsenode, depth + 1, max_size, child)) {
+    return false;
+  }
+  flat_falsenodes_[position] = child;
+  return true;
 }
 
 template <typename ITYPE, typename OTYPE>
@@ -264,20 +465,28 @@ void TreeEnsembleCommon<ITYPE, OTYPE>::ComputeAgg(concurrency::ThreadPool* ttp,
   int64_t* label_data = label == nullptr ? nullptr : label->template MutableData<int64_t>();
   auto max_num_threads = concurrency::ThreadPool::DegreeOfParallelism(ttp);
 
+  // Rows are processed in blocks of kRowBlockSize rows, every tree is evaluated for all the rows of a block
+  // before moving to the next tree. The trees are still visited in the same order for every row.
+  const int64_t n_blocks = (N + kRowBlockSize - 1) / kRowBlockSize;
+
   if (n_targets_or_classes_ == 1) {
     if (N == 1) {
       ScoreValue<OTYPE> score = {0, 0};
       if (n_trees_ <= parallel_tree_) { /* section A: 1 output, 1 row and not enough trees to parallelize */
+        const TreeNodeElement<OTYPE>* leaf;
         for (int64_t j = 0; j < n_trees_; ++j) {
-          agg.ProcessTreeNodePrediction1(score, *ProcessTreeNodeLeave(roots_[j], x_data));
+          ProcessTreeNodeLeaves(j, x_data, stride, 1, &leaf);
+          agg.ProcessTreeNodePrediction1(score, *leaf);
         }
       } else { /* section B: 1 output, 1 row and enough trees to parallelize */
         std::vector<ScoreValue<OTYPE>> scores(n_trees_, {0, 0});
         concurrency::ThreadPool::TryBatchParallelFor(
             ttp,
             SafeInt<int32_t>(n_trees_),
-            [this, &scores, &agg, x_data](ptrdiff_t j) {
-              agg.ProcessTreeNodePrediction1(scores[j], *ProcessTreeNodeLeave(roots_[j], x_data));
+            [this, &scores, &agg, x_data, stride](ptrdiff_t j) {
+              const TreeNodeElement<OTYPE>* leaf;
+              ProcessTreeNodeLeaves(j, x_data, stride, 1, &leaf);
+              agg.ProcessTreeNodePrediction1(scores[j], *leaf);
             },
             0);
 
@@ -287,17 +496,23 @@ void TreeEnsembleCommon<ITYPE, OTYPE>::ComputeAgg(concurrency::ThreadPool* ttp,
       }
       agg.FinalizeScores1(z_data, score, label_data);
     } else if (N <= parallel_N_) { /* section C: 1 output, 2+ rows but not enough rows to parallelize */
-      ScoreValue<OTYPE> score;
-      size_t j;
+      ScoreValue<OTYPE> scores[kRowBlockSize];
+      const TreeNodeElement<OTYPE>* leaves[kRowBlockSize];
 
-      for (int64_t i = 0; i < N; ++i) {
-        score = {0, 0};
-        for (j = 0; j < static_cast<size_t>(n_trees_); ++j) {
-          agg.ProcessTreeNodePrediction1(score, *ProcessTreeNodeLeave(roots_[j], x_data + i * stride));
+      for (int64_t i = 0; i < N; i += kRowBlockSize) {
+        int64_t count = std::min<int64_t>(kRowBlockSize, N - i);
+        std::fill(scores, scores + count, ScoreValue<OTYPE>({0, 0}));
+        for (int64_t j = 0; j < n_trees_; ++j) {
+          ProcessTreeNodeLeaves(j, x_data + i * stride, stride, count, leaves);
+          for (int64_t k = 0; k < count; ++k) {
+            agg.ProcessTreeNodePrediction1(scores[k], *leaves[k]);
+          }
         }
 
-        agg.FinalizeScores1(z_data + i, score,
-                            label_data == nullptr ? nullptr : (label_data + i));
+        for (int64_t k = 0; k < count; ++k) {
+          agg.FinalizeScores1(z_data + i + k, scores[k],
+                              label_data == nullptr ? nullptr : (label_data + i + k));
+        }
       }
     } else if (n_trees_ > max_num_threads) { /* section D: 1 output, 2+ rows and enough trees to parallelize */
       auto num_threads = std::min<int32_t>(max_num_threads, SafeInt<int32_t>(n_trees_));
@@ -306,13 +521,18 @@ void TreeEnsembleCommon<ITYPE, OTYPE>::ComputeAgg(concurrency::ThreadPool* ttp,
           ttp,
           num_threads,
           [this, &agg, &scores, num_threads, x_data, N, stride](ptrdiff_t batch_num) {
+            const TreeNodeElement<OTYPE>* leaves[kRowBlockSize];
             auto work = concurrency::ThreadPool::PartitionWork(batch_num, num_threads, this->n_trees_);
             for (int64_t i = 0; i < N; ++i) {
               scores[batch_num * N + i] = {0, 0};
             }
-            for (auto j = work.start; j < work.end; ++j) {
-              for (int64_t i = 0; i < N; ++i) {
-                agg.ProcessTreeNodePrediction1(scores[batch_num * N + i], *ProcessTreeNodeLeave(roots_[j], x_data + i * stride));
+            for (int64_t i = 0; i < N; i += kRowBlockSize) {
+              int64_t count = std::min<int64_t>(kRowBlockSize, N - i);
+              for (auto j = work.start; j < work.end; ++j) {
+                ProcessTreeNodeLeaves(j, x_data + i * stride, stride, count, leaves);
+                for (int64_t k = 0; k < count; ++k) {
+                  agg.ProcessTreeNodePrediction1(scores[batch_num * N + i + k], *leaves[k]);
+                }
               }
             }
           });
@@ -333,15 +553,24 @@ void TreeEnsembleCommon<ITYPE, OTYPE>::ComputeAgg(concurrency::ThreadPool* ttp,
     } else { /* section E: 1 output, 2+ rows, parallelization by rows */
       concurrency::ThreadPool::TryBatchParallelFor(
           ttp,
-          SafeInt<int32_t>(N),
-          [this, &agg, x_data, z_data, stride, label_data](ptrdiff_t i) {
-            ScoreValue<OTYPE> score = {0, 0};
-            for (size_t j = 0; j < static_cast<size_t>(n_trees_); ++j) {
-              agg.ProcessTreeNodePrediction1(score, *ProcessTreeNodeLeave(roots_[j], x_data + i * stride));
+          SafeInt<int32_t>(n_blocks),
+          [this, &agg, x_data, z_data, stride, label_data, N](ptrdiff_t block) {
+            ScoreValue<OTYPE> scores[kRowBlockSize];
+            const TreeNodeElement<OTYPE>* leaves[kRowBlockSize];
+            int64_t i = block * kRowBlockSize;
+            int64_t count = std::min<int64_t>(kRowBlockSize, N - i);
+            std::fill(scores, scores + count, ScoreValue<OTYPE>({0, 0}));
+            for (int64_t j = 0; j < n_trees_; ++j) {
+              ProcessTreeNodeLeaves(j, x_data + i * stride, stride, count, leaves);
+              for (int64_t k = 0; k < count; ++k) {
+                agg.ProcessTreeNodePrediction1(scores[k], *leaves[k]);
+              }
             }
 
-            agg.FinalizeScores1(z_data + i, score,
-                                label_data == nullptr ? nullptr : (label_data + i));
+            for (int64_t k = 0; k < count; ++k) {
+              agg.FinalizeScores1(z_data + i + k, scores[k],
+                                  label_data == nullptr ? nullptr : (label_data + i + k));
+            }
           },
           0);
     }
@@ -349,8 +578,10 @@ void TreeEnsembleCommon<ITYPE, OTYPE>::ComputeAgg(concurrency::ThreadPool* ttp,
     if (N == 1) {                       /* section A2: 2+ outputs, 1 row, not enough trees to parallelize */
       if (n_trees_ <= parallel_tree_) { /* section A2 */
         std::vector<ScoreValue<OTYPE>> scores(n_targets_or_classes_, {0, 0});
+        const TreeNodeElement<OTYPE>* leaf;
         for (int64_t j = 0; j < n_trees_; ++j) {
-          agg.ProcessTreeNodePrediction(scores, *ProcessTreeNodeLeave(roots_[j], x_data));
+          ProcessTreeNodeLeaves(j, x_data, stride, 1, &leaf);
+          agg.ProcessTreeNodePrediction(scores, *leaf);
         }
         agg.FinalizeScores(scores, z_data, -1, label_data);
       } else { /* section B2: 2+ outputs, 1 row, enough trees to parallelize */
@@ -359,11 +590,13 @@ void TreeEnsembleCommon<ITYPE, OTYPE>::ComputeAgg(concurrency::ThreadPool* ttp,
         concurrency::ThreadPool::TrySimpleParallelFor(
             ttp,
             num_threads,
-            [this, &agg, &scores, num_threads, x_data](ptrdiff_t batch_num) {
+            [this, &agg, &scores, num_threads, x_data, stride](ptrdiff_t batch_num) {
+              const TreeNodeElement<OTYPE>* leaf;
               scores[batch_num].resize(n_targets_or_classes_, {0, 0});
               auto work = concurrency::ThreadPool::PartitionWork(batch_num, num_threads, n_trees_);
               for (auto j = work.start; j < work.end; ++j) {
-                agg.ProcessTreeNodePrediction(scores[batch_num], *ProcessTreeNodeLeave(roots_[j], x_data));
+                ProcessTreeNodeLeaves(j, x_data, stride, 1, &leaf);
+                agg.ProcessTreeNodePrediction(scores[batch_num], *leaf);
               }
             });
         for (size_t i = 1; i < scores.size(); ++i) {
@@ -372,17 +605,26 @@ void TreeEnsembleCommon<ITYPE, OTYPE>::ComputeAgg(concurrency::ThreadPool* ttp,
         agg.FinalizeScores(scores[0], z_data, -1, label_data);
       }
     } else if (N <= parallel_N_) { /* section C2: 2+ outputs, 2+ rows, not enough rows to parallelize */
-      std::vector<ScoreValue<OTYPE>> scores(n_targets_or_classes_);
-      size_t j;
+      std::vector<std::vector<ScoreValue<OTYPE>>> scores(kRowBlockSize,
+                                                         std::vector<ScoreValue<OTYPE>>(n_targets_or_classes_));
+      const TreeNodeElement<OTYPE>* leaves[kRowBlockSize];
 
-      for (int64_t i = 0; i < N; ++i) {
-        std::fill(scores.begin(), scores.end(), ScoreValue<OTYPE>({0, 0}));
-        for (j = 0; j < roots_.size(); ++j) {
-          agg.ProcessTreeNodePrediction(scores, *ProcessTreeNodeLeave(roots_[j], x_data + i * stride));
+      for (int64_t i = 0; i < N; i += kRowBlockSize) {
+        int64_t count = std::min<int64_t>(kRowBlockSize, N - i);
+        for (int64_t k = 0; k < count; ++k) {
+          std::fill(scores[k].begin(), scores[k].end(), ScoreValue<OTYPE>({0, 0}));
+        }
+        for (int64_t j = 0; j < n_trees_; ++j) {
+          ProcessTreeNodeLeaves(j, x_data + i * stride, stride, count, leaves);
+          for (int64_t k = 0; k < count; ++k) {
+            agg.ProcessTreeNodePrediction(scores[k], *leaves[k]);
+          }
         }
 
-        agg.FinalizeScores(scores, z_data + i * n_targets_or_classes_, -1,
-                           label_data == nullptr ? nullptr : (label_data + i));
+        for (int64_t k = 0; k < count; ++k) {
+          agg.FinalizeScores(scores[k], z_data + (i + k) * n_targets_or_classes_, -1,
+                             label_data == nullptr ? nullptr : (label_data + i + k));
+        }
       }
     } else if (n_trees_ >= max_num_threads) { /* section: D2: 2+ outputs, 2+ rows, enough trees to parallelize*/
       auto num_threads = std::min<int32_t>(max_num_threads, SafeInt<int32_t>(n_trees_));
@@ -391,13 +633,18 @@ void TreeEnsembleCommon<ITYPE, OTYPE>::ComputeAgg(concurrency::ThreadPool* ttp,
           ttp,
           num_threads,
           [this, &agg, &scores, num_threads, x_data, N, stride](ptrdiff_t batch_num) {
+            const TreeNodeElement<OTYPE>* leaves[kRowBlockSize];
             auto work = concurrency::ThreadPool::PartitionWork(batch_num, num_threads, this->n_trees_);
             for (int64_t i = 0; i < N; ++i) {
               scores[batch_num * N + i].resize(n_targets_or_classes_, {0, 0});
             }
-            for (auto j = work.start; j < work.end; ++j) {
-              for (int64_t i = 0; i < N; ++i) {
-                agg.ProcessTreeNodePrediction(scores[batch_num * N + i], *ProcessTreeNodeLeave(roots_[j], x_data + i * stride));
+            for (int64_t i = 0; i < N; i += kRowBlockSize) {
+              int64_t count = std::min<int64_t>(kRowBlockSize, N - i);
+              for (auto j = work.start; j < work.end; ++j) {
+                ProcessTreeNodeLeaves(j, x_data + i * stride, stride, count, leaves);
+                for (int64_t k = 0; k < count; ++k) {
+                  agg.ProcessTreeNodePrediction(scores[batch_num * N + i + k], *leaves[k]);
+                }
               }
             }
           });
@@ -416,24 +663,34 @@ void TreeEnsembleCommon<ITYPE, OTYPE>::ComputeAgg(concurrency::ThreadPool* ttp,
             }
           });
     } else { /* section E2: 2+ outputs, 2+ rows, parallelization by rows */
-      auto num_threads = std::min<int32_t>(max_num_threads, SafeInt<int32_t>(N));
+      auto num_threads = std::min<int32_t>(max_num_threads, SafeInt<int32_t>(n_blocks));
       concurrency::ThreadPool::TrySimpleParallelFor(
           ttp,
           num_threads,
-          [this, &agg, num_threads, x_data, z_data, label_data, N, stride](ptrdiff_t batch_num) {
-            size_t j;
-            std::vector<ScoreValue<OTYPE>> scores(n_targets_or_classes_);
-            auto work = concurrency::ThreadPool::PartitionWork(batch_num, num_threads, N);
+          [this, &agg, num_threads, x_data, z_data, label_data, N, n_blocks, stride](ptrdiff_t batch_num) {
+            std::vector<std::vector<ScoreValue<OTYPE>>> scores(
+                kRowBlockSize, std::vector<ScoreValue<OTYPE>>(n_targets_or_classes_));
+            const TreeNodeElement<OTYPE>* leaves[kRowBlockSize];
+            auto work = concurrency::ThreadPool::PartitionWork(batch_num, num_threads, n_blocks);
 
-            for (auto i = work.start; i < work.end; ++i) {
-              std::fill(scores.begin(), scores.end(), ScoreValue<OTYPE>({0, 0}));
-              for (j = 0; j < roots_.size(); ++j) {
-                agg.ProcessTreeNodePrediction(scores, *ProcessTreeNodeLeave(roots_[j], x_data + i * stride));
+            for (auto block = work.start; block < work.end; ++block) {
+              int64_t i = block * kRowBlockSize;
+              int64_t count = std::min<int64_t>(kRowBlockSize, N - i);
+              for (int64_t k = 0; k < count; ++k) {
+                std::fill(scores[k].begin(), scores[k].end(), ScoreValue<OTYPE>({0, 0}));
+              }
+              for (int64_t j = 0; j < n_trees_; ++j) {
+                ProcessTreeNodeLeaves(j, x_data + i * stride, stride, count, leaves);
+                for (int64_t k = 0; k < count; ++k) {
+                  agg.ProcessTreeNodePrediction(scores[k], *leaves[k]);
+                }
               }
 
-              agg.FinalizeScores(scores,
-                                 z_data + i * n_targets_or_classes_, -1,
-                                 label_data == nullptr ? nullptr : (label_data + i));
+              for (int64_t k = 0; k < count; ++k) {
+                agg.FinalizeScores(scores[k],
+                                   z_data + (i + k) * n_targets_or_classes_, -1,
+                                   label_data == nullptr ? nullptr : (label_data + i + k));
+              }
             }
           });
     }
@@ -546,6 +803,146 @@ TreeEnsembleCommon<ITYPE, OTYPE>::ProcessTreeNodeLeave(
   return root;
 }
 
+template <typename ITYPE, typename OTYPE>
+template <typename CMP, bool missing_tracks>
+void TreeEnsembleCommon<ITYPE, OTYPE>::ProcessFlatTreeNodeLeaves(
+    int32_t root, const ITYPE* x_data, int64_t stride, int64_t count,
+    const TreeNodeElement<OTYPE>** leaves, CMP cmp) const {
+  // Every row moves down one level per pass so that the loads of the rows overlap.
+  int32_t positions[kRowBlockSize];
+  for (int64_t k = 0; k < count; ++k) {
+    positions[k] = root;
+  }
+
+  const int32_t* feature_ids = flat_feature_ids_.data();
+  const OTYPE* thresholds = flat_thresholds_.data();
+  const int32_t* truenodes = flat_truenodes_.data();
+  const int32_t* falsenodes = flat_falsenodes_.data();
+  const uint8_t* missing_tracks_true = flat_missing_tracks_true_.data();
+
+  for (bool active = root >= 0; active;) {
+    active = false;
+    for (int64_t k = 0; k < count; ++k) {
+      int32_t n = positions[k];
+      if (n < 0) {
+        continue;
+      }
+      ITYPE val = x_data[k * stride + feature_ids[n]];
+      bool go_true = cmp(n, val, thresholds[n]);
+      if (missing_tracks) {
+        go_true = go_true || (missing_tracks_true[n] && _isnan_(val));
+      }
+      n = go_true ? truenodes[n] : falsenodes[n];
+      positions[k] = n;
+      active = active || n >= 0;
+    }
+  }
+
+  for (int64_t k = 0; k < count; ++k) {
+    leaves[k] = flat_leaves_[~positions[k]];
+  }
+}
+
+#define TREE_FIND_LEAVES(CMP)                                                                          \
+  if (has_missing_tracks_) {                                                                           \
+    ProcessFlatTreeNodeLeaves<decltype(CMP), true>(root, x_data, stride, count, leaves, CMP);          \
+  } else {                                                                                             \
+    ProcessFlatTreeNodeLeaves<decltype(CMP), false>(root, x_data, stride, count, leaves, CMP);         \
+  }
+
+template <typename ITYPE, typename OTYPE>
+void TreeEnsembleCommon<ITYPE, OTYPE>::ProcessTreeNodeLeaves(
+    size_t j, const ITYPE* x_data, int64_t stride, int64_t count,
+    const TreeNodeElement<OTYPE>** leaves) const {
+  if (!use_flat_layout_) {
+    for (int64_t k = 0; k < count; ++k) {
+      leaves[k] = ProcessTreeNodeLeave(roots_[j], x_data + k * stride);
+    }
+    return;
+  }
+
+  if constexpr (std::is_same<ITYPE, float>::value && std::is_same<OTYPE, float>::value) {
+    if (!perfect_depths_.empty() && perfect_depths_[j] > 0) {
+      uint32_t leaf_indices[kRowBlockSize];
+      MlasTreeTraversePerfect(x_data, static_cast<size_t>(stride), static_cast<size_t>(count),
+                              perfect_feature_ids_.data() + perfect_node_offsets_[j],
+                              perfect_thresholds_.data() + perfect_node_offsets_[j],
+                              static_cast<size_t>(perfect_depths_[j]), perfect_mode_, leaf_indices);
+      const TreeNodeElement<OTYPE>* const* perfect_leaves = perfect_leaves_.data() + perfect_leaf_offsets_[j];
+      for (int64_t k = 0; k < count; ++k) {
+        leaves[k] = perfect_leaves[leaf_indices[k]];
+      }
+      return;
+    }
+  }
+
+  const int32_t root = flat_roots_[j];
+  if (same_mode_) {
+    switch (flat_mode_) {
+      case NODE_MODE::BRANCH_LEQ: {
+        auto cmp = [](int32_t, ITYPE val, OTYPE threshold) { return val <= threshold; };
+        TREE_FIND_LEAVES(cmp)
+        break;
+      }
+      case NODE_MODE::BRANCH_LT: {
+        auto cmp = [](int32_t, ITYPE val, OTYPE threshold) { return val < threshold; };
+        TREE_FIND_LEAVES(cmp)
+        break;
+      }
+      case NODE_MODE::BRANCH_GTE: {
+        auto cmp = [](int32_t, ITYPE val, OTYPE threshold) { return val >= threshold; };
+        TREE_FIND_LEAVES(cmp)
+        break;
+      }
+      case NODE_MODE::BRANCH_GT: {
+        auto cmp = [](int32_t, ITYPE val, OTYPE threshold) { return val > threshold; };
+        TREE_FIND_LEAVES(cmp)
+        break;
+      }
+      case NODE_MODE::BRANCH_EQ: {
+        auto cmp = [](int32_t, ITYPE val, OTYPE threshold) { return val == threshold; };
+        TREE_FIND_LEAVES(cmp)
+        break;
+      }
+      case NODE_MODE::BRANCH_NEQ: {
+        auto cmp = [](int32_t, ITYPE val, OTYPE threshold) { return val != threshold; };
+        TREE_FIND_LEAVES(cmp)
+        break;
+      }
+      case NODE_MODE::LEAF: {
+        // Every tree is a single leaf.
+        for (int64_t k = 0; k < count; ++k) {
+          leaves[k] = flat_leaves_[~root];
+        }
+        break;
+      }
+    }
+  } else {  // Different rules to compare to node thresholds.
+    const NODE_MODE* modes = flat_modes_.data();
+    auto cmp = [modes](int32_t n, ITYPE val, OTYPE threshold) {
+      switch (modes[n]) {
+        case NODE_MODE::BRANCH_LEQ:
+          return val <= threshold;
+        case NODE_MODE::BRANCH_LT:
+          return val < threshold;
+        case NODE_MODE::BRANCH_GTE:
+          return val >= threshold;
+        case NODE_MODE::BRANCH_GT:
+          return val > threshold;
+        case NODE_MODE::BRANCH_EQ:
+          return val == threshold;
+        case NODE_MODE::BRANCH_NEQ:
+          return val != threshold;
+        default:
+          return false;
+      }
+    };
+    TREE_FIND_LEAVES(cmp)
+  }
+}
+
+#undef TREE_FIND_LEAVES
+
 template <typename ITYPE, typename OTYPE>
 class TreeEnsembleCommonClassifier : TreeEnsembleCommon<ITYPE, OTYPE> {
  private:
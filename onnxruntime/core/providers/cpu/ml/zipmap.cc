@@ -2,7 +2,11 @@
 // Licensed under the MIT License.
 
 #include "core/providers/cpu/ml/zipmap.h"
+#include "core/platform/threadpool.h"
 #include "core/util/math_cpuonly.h"
+
+#include <algorithm>
+#include <numeric>
 /**
 https://github.com/onnx/onnx/blob/master/onnx/defs/traditionalml/defs.cc
 ONNX_OPERATOR_SCHEMA(ZipMap)
@@ -35,6 +39,54 @@ ONNX_CPU_OPERATOR_ML_KERNEL(
                                             DataTypeImpl::GetType<std::vector<std::map<std::int64_t, float>>>()}),
     ZipMapOp);
 
+namespace {
+
+template <typename TKey>
+std::vector<size_t> GetKeyPositions(const std::vector<TKey>& labels) {
+  std::vector<size_t> positions(labels.size());
+  std::iota(positions.begin(), positions.end(), size_t{0});
+  std::stable_sort(positions.begin(), positions.end(),
+                   [&labels](size_t a, size_t b) { return labels[a] < labels[b]; });
+
+  // Keep the last position of every label, the one whose value ends up in the map.
+  std::vector<size_t> key_positions;
+  key_positions.reserve(positions.size());
+  for (size_t position : positions) {
+    if (!key_positions.empty() && labels[key_positions.back()] == labels[position]) {
+      key_positions.back() = position;
+    } else {
+      key_positions.push_back(position);
+    }
+  }
+  return key_positions;
+}
+
+// Fills one map per row. The keys are inserted in increasing order at the end of the maps, which avoids
+// comparing them.
+template <typename TKey>
+void ZipRows(concurrency::ThreadPool* tp, const std::vector<TKey>& labels, const std::vector<size_t>& key_positions,
+             const float* x_data, int64_t batch_size, int64_t features_per_batch,
+             std::vector<std::map<TKey, float>>& y_data) {
+  y_data.resize(batch_size);
+  concurrency::ThreadPool::TryParallelFor(
+      tp, batch_size,
+      TensorOpCost{static_cast<double>(features_per_batch * sizeof(float)),
+                   static_cast<double>(features_per_batch * (sizeof(TKey) + 4 * sizeof(void*))),
+                   static_cast<double>(features_per_batch * 64)},
+      [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+        for (std::ptrdiff_t n = first; n < last; ++n) {
+          const float* row = x_data + n * features_per_batch;
+          auto& map = y_data[n];
+          map.clear();
+          for (size_t position : key_positions) {
+            map.emplace_hint(map.end(), labels[position], row[position]);
+          }
+        }
+      });
+}
+
+}  // namespace
+
 ZipMapOp::ZipMapOp(const OpKernelInfo& info)
     : OpKernel(info),
       classlabels_int64s_(info.GetAttrsOrDefault<int64_t>("classlabels_int64s")),
@@ -42,6 +94,7 @@ ZipMapOp::ZipMapOp(const OpKernelInfo& info)
   ORT_ENFORCE(classlabels_strings_.empty() ^ classlabels_int64s_.empty(),
               "Must provide classlabels_strings or classlabels_int64s but not both.");
   using_strings_ = !classlabels_strings_.empty();
+  key_positions_ = using_strings_ ? GetKeyPositions(classlabels_strings_) : GetKeyPositions(classlabels_int64s_);
 }
 
 common::Status ZipMapOp::Compute(OpKernelContext* context) const {
@@ -66,6 +119,7 @@ common::Status ZipMapOp::Compute(OpKernelContext* context) const {
   }
 
   const auto* x_data = X.template Data<float>();
+  concurrency::ThreadPool* tp = context->GetOperatorThreadPool();
 
   if (using_strings_) {
     if (features_per_batch != static_cast<int64_t>(classlabels_strings_.size())) {
@@ -77,17 +131,7 @@ common::Status ZipMapOp::Compute(OpKernelContext* context) const {
     auto* y_data = context->Output<std::vector<std::map<std::string, float>>>(0);
     if (y_data == nullptr) return Status(common::ONNXRUNTIME, common::FAIL, "input count mismatch");
 
-    //auto* y_data = Y->template MutableData<std::vector<std::map<std::string, float>>>();
-    y_data->resize(batch_size);
-    int64_t current_weight_0 = 0;
-    for (int64_t n = 0; n < batch_size; n++) {
-      std::map<std::string, float> map1;
-      for (int64_t j = 0; j < features_per_batch; j++) {
-        map1[classlabels_strings_[j]] = x_data[current_weight_0 + j];
-      }
-      current_weight_0 += features_per_batch;
-      (*y_data)[n] = std::move(map1);
-    }
+    ZipRows(tp, classlabels_strings_, key_positions_, x_data, batch_size, features_per_batch, *y_data);
   } else {
     if (features_per_batch != static_cast<int64_t>(classlabels_int64s_.size())) {
       return Status(ONNXRUNTIME,
@@ -97,17 +141,8 @@ common::Status ZipMapOp::Compute(OpKernelContext* context) const {
     }
     auto* y_data = context->Output<std::vector<std::map<std::int64_t, float>>>(0);
     if (y_data == nullptr) return Status(common::ONNXRUNTIME, common::FAIL, "input count mismatch");
-    //auto* y_data = Y->template MutableData<std::vector<std::map<int64_t, float>>>();
-    y_data->resize(batch_size);
-    int64_t current_weight_0 = 0;
-    for (int n = 0; n < batch_size; n++) {
-      std::map<int64_t, float> map2;
-      for (int j = 0; j < features_per_batch; j++) {
-        map2[classlabels_int64s_[j]] = x_data[current_weight_0 + j];
-      }
-      current_weight_0 += features_per_batch;
-      (*y_data)[n] = std::move(map2);
-    }
+
+    ZipRows(tp, classlabels_int64s_, key_positions_, x_data, batch_size, features_per_batch, *y_data);
   }
   return common::Status::OK();
 }
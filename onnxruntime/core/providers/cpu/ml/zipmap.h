@@ -16,6 +16,9 @@ class ZipMapOp final : public OpKernel {
   bool using_strings_;
   std::vector<int64_t> classlabels_int64s_;
   std::vector<std::string> classlabels_strings_;
+  // Positions of the class labels in the order of the keys of the maps. A label appearing several times takes the
+  // value at its last position.
+  std::vector<size_t> key_positions_;
 };
 
 }  // namespace ml
@@ -24,7 +24,9 @@
 #include "core/framework/tensor.h"
 #include "core/util/math_cpuonly.h"
 #include "core/providers/cpu/nn/batch_norm_helper.h"
+#include "core/mlas/inc/mlas.h"
 #include <safeint/SafeInt.hpp>
+#include <type_traits>
 
 namespace onnxruntime {
 
@@ -46,11 +48,15 @@ class BatchNorm : public OpKernel {
 #if defined(ENABLE_TRAINING)
     ORT_ENFORCE(!is_train_ || is_spatial_, "Training mode does not support non-spatial BN");
 
-    auto mt = op_kernel_info.GetAttr<float>("momentum", &momentum_);
-    ORT_ENFORCE(mt.IsOK(), mt.ErrorMessage());
+    if (is_train_) {
+      auto mt = op_kernel_info.GetAttr<float>("momentum", &momentum_);
+      ORT_ENFORCE(mt.IsOK(), mt.ErrorMessage());
+    }
 #else
     ORT_ENFORCE(!is_train_, "Training mode is not supported in this build.");
 #endif
+
+    activation_.ActivationKind = MlasIdentityActivation;
   }
 
   Status Compute(OpKernelContext* p_op_kernel_context) const override {
@@ -182,8 +188,14 @@ class BatchNorm : public OpKernel {
                            is_spatial_ ? N * C : N);
 
     if (is_spatial_) {  // spatial == 1
-      for (size_t nc = 0; nc < N * C; ++nc) {
-        Y_arr.col(nc) = X_arr.col(nc) * new_scale(nc % C) + new_bias(nc % C);
+      if constexpr (std::is_same<T, float>::value) {
+        MlasComputeScaleShift(X->template Data<float>(), new_scale.data(), new_bias.data(),
+                              Y->template MutableData<float>(), N, C, 1, sample_size, &activation_,
+                              p_op_kernel_context->GetOperatorThreadPool());
+      } else {
+        for (size_t nc = 0; nc < N * C; ++nc) {
+          Y_arr.col(nc) = X_arr.col(nc) * new_scale(nc % C) + new_bias(nc % C);
+        }
       }
     } else {  // spatial == 0
       for (size_t n = 0; n < N; ++n) {
@@ -198,5 +210,8 @@ class BatchNorm : public OpKernel {
   float momentum_{0};
   const bool is_spatial_;
   int64_t is_train_;
+
+  // Activation applied to the output by the fused variant of the operator (float spatial mode only).
+  MLAS_ACTIVATION activation_;
 };
 }  // namespace onnxruntime
@@ -3,7 +3,9 @@
 
 #include "string_normalizer.h"
 #include "core/common/common.h"
+#include "core/framework/string_tensor_view.h"
 #include "core/framework/tensor.h"
+#include "core/platform/threadpool.h"
 
 #ifdef _MSC_VER
 #include <codecvt>
@@ -15,8 +17,10 @@
 #include <iconv.h>
 #endif  // _MSC_VER
 
+#include <algorithm>
 #include <locale>
 #include <functional>
+#include <string_view>
 #include <unordered_set>
 
 namespace onnxruntime {
@@ -192,53 +196,29 @@ const std::string default_locale("en_US.UTF-8");  // All non-MS
 
 #endif  // MS_VER
 
-template <class ForwardIter>
-Status CopyCaseAction(ForwardIter first, ForwardIter end, OpKernelContext* ctx,
-                      const Locale& loc,
-                      Utf8Converter& converter,
-                      size_t N, size_t C,
-                      StringNormalizer::CaseAction caseaction) {
-  std::vector<int64_t> output_dims;
-  if (N == 1) {
-    output_dims.push_back(1);
-  }
+// Strings are processed in blocks of consecutive strings of at least this many bytes, as smaller blocks take less
+// time than handing them to another thread of the pool.
+constexpr size_t kMinBytesPerBlock = 8 * 1024;
 
-  // Empty output case
-  if (C == 0) {
-    output_dims.push_back(1);
-    TensorShape output_shape(output_dims);
-    // This will create one empty string
-    ctx->Output(0, output_shape);
-    return Status::OK();
+bool IsAscii(std::string_view s) {
+  unsigned char bits = 0;
+  for (const char c : s) {
+    bits |= static_cast<unsigned char>(c);
   }
+  return bits < 0x80;
+}
 
-  output_dims.push_back(C);
-
-  TensorShape output_shape(output_dims);
-  auto output_tensor = ctx->Output(0, output_shape);
-  auto const output_data = output_tensor->template MutableData<std::string>();
-
-  size_t output_idx = 0;
-  while (first != end) {
-    auto& s = *first;
-    if (caseaction == StringNormalizer::LOWER || caseaction == StringNormalizer::UPPER) {
-      std::wstring wstr = converter.from_bytes(s);
-      if (wstr == wconv_error) {
-        return Status(common::ONNXRUNTIME, common::INVALID_ARGUMENT,
-                      "Input contains invalid utf8 chars at: " + static_cast<const std::string&>(s));
-      }
-      // In place transform
-      loc.ChangeCase(caseaction, wstr);
-      *(output_data + output_idx) = converter.to_bytes(wstr);
-    } else {
-      assert(caseaction == StringNormalizer::NONE);
-      // Simple copy or move if the iterator points to a non-const string
-      *(output_data + output_idx) = std::move(s);
-    }
-    ++output_idx;
-    ++first;
+// Converts the case of an ASCII string with the conversion table of the ASCII characters.
+void ChangeCaseAscii(const std::string& table, std::string_view s, std::string& output) {
+  output.resize(s.size());
+  for (size_t i = 0; i < s.size(); ++i) {
+    output[i] = table[static_cast<unsigned char>(s[i])];
   }
-  return Status::OK();
+}
+
+Status InvalidUtf8(std::string_view s) {
+  return Status(common::ONNXRUNTIME, common::INVALID_ARGUMENT,
+                "Input contains invalid utf8 chars at: " + std::string(s));
 }
 }  // namespace string_normalizer
 
@@ -271,26 +251,47 @@ StringNormalizer::StringNormalizer(const OpKernelInfo& info) : OpKernel(info),
     compare_caseaction_ = (case_change_action_ == UPPER) ? UPPER : LOWER;
   }
 
-  locale_name_ = info.GetAttrOrDefault("locale", default_locale);
-  Locale locale(locale_name_);
+  locale_ = std::make_unique<Locale>(info.GetAttrOrDefault("locale", default_locale));
   Utf8Converter converter(conv_error, wconv_error);
 
+  // Most strings are ASCII: they are converted with a table rather than through wide characters, unless the
+  // locale converts some ASCII characters to non-ASCII ones.
+  std::wstring ascii_lower(128, L'\0');
+  for (size_t c = 0; c < ascii_lower.size(); ++c) {
+    ascii_lower[c] = static_cast<wchar_t>(c);
+  }
+  std::wstring ascii_upper(ascii_lower);
+  locale_->ChangeCase(LOWER, ascii_lower);
+  locale_->ChangeCase(UPPER, ascii_upper);
+  auto is_ascii = [](wchar_t ch) { return static_cast<uint32_t>(ch) < 0x80; };
+  if (std::all_of(ascii_lower.cbegin(), ascii_lower.cend(), is_ascii) &&
+      std::all_of(ascii_upper.cbegin(), ascii_upper.cend(), is_ascii)) {
+    ascii_lower_.resize(ascii_lower.size());
+    ascii_upper_.resize(ascii_upper.size());
+    for (size_t c = 0; c < ascii_lower.size(); ++c) {
+      ascii_lower_[c] = static_cast<char>(ascii_lower[c]);
+      ascii_upper_[c] = static_cast<char>(ascii_upper[c]);
+    }
+  }
+
   std::vector<std::string> swords = info.GetAttrsOrDefault<std::string>("stopwords");
   for (const auto& sw : swords) {
     ORT_ENFORCE(!sw.empty(), "Empty stopwords not allowed");
     if (is_case_sensitive_) {
-      auto p = stopwords_.insert(sw);
-      ORT_ENFORCE(p.second, "Duplicate stopwords not allowed");
+      ORT_ENFORCE(stopwords_.Insert(sw, true), "Duplicate stopwords not allowed");
     } else {
       std::wstring wstr = converter.from_bytes(sw);
       ORT_ENFORCE(wstr != wconv_error, "Stopword contains invalid utf8 chars");
-      locale.ChangeCase(compare_caseaction_, wstr);
+      locale_->ChangeCase(compare_caseaction_, wstr);
       auto p = wstopwords_.insert(wstr);
       ORT_ENFORCE(p.second, "Duplicate stopwords not allowed");
+      stopwords_.Insert(converter.to_bytes(wstr), true);
     }
   }
 }
 
+StringNormalizer::~StringNormalizer() = default;
+
 Status StringNormalizer::Compute(OpKernelContext* ctx) const {
   using namespace string_normalizer;
 
@@ -318,70 +319,111 @@ Status StringNormalizer::Compute(OpKernelContext* ctx) const {
                   "Input dimensions are either[C > 0] or [1][C > 0] allowed");
   }
 
-  Status status;
-  Locale locale(locale_name_);
-  Utf8Converter converter(conv_error, wconv_error);
-  auto const input_data = X->template Data<std::string>();
-  using StrRef = std::reference_wrapper<const std::string>;
-  if (is_case_sensitive_) {
-    if (!stopwords_.empty()) {
-      std::vector<StrRef> filtered_strings;
-      filtered_strings.reserve(C);
-      auto first = input_data;
-      auto const last = input_data + C;
-      while (first != last) {
-        const std::string& s = *first;
-        if (0 == stopwords_.count(s)) {
-          filtered_strings.push_back(std::cref(s));
-        }
-        ++first;
-      }
-      status = CopyCaseAction(filtered_strings.cbegin(), filtered_strings.cend(), ctx, locale, converter,
-                              N, filtered_strings.size(), case_change_action_);
-    } else {
-      // Nothing to filter. Copy input to output and change case if needed
-      status = CopyCaseAction(input_data, input_data + C, ctx, locale, converter, N, C, case_change_action_);
+  // The input may be in either string tensor layout, the strings are read as std::string_view.
+  const StringTensorView input_data(*X);
+  const bool ascii_tables = !ascii_lower_.empty();
+
+  // The strings are split in blocks of consecutive strings, processed in parallel. The first error, in the order
+  // of the strings, is returned.
+  const size_t total_bytes = input_data.TotalLength();
+  concurrency::ThreadPool* tp = ctx->GetOperatorThreadPool();
+  const std::ptrdiff_t block_count = std::min<std::ptrdiff_t>(
+      {static_cast<std::ptrdiff_t>(C),
+       static_cast<std::ptrdiff_t>(total_bytes / kMinBytesPerBlock + 1),
+       static_cast<std::ptrdiff_t>(concurrency::ThreadPool::DegreeOfParallelism(tp))});
+  std::vector<Status> block_status(block_count);
+  auto for_each_block = [&](const std::function<Status(std::ptrdiff_t block, size_t first, size_t last)>& fn) {
+    concurrency::ThreadPool::TrySimpleParallelFor(tp, block_count, [&](std::ptrdiff_t block) {
+      auto work = concurrency::ThreadPool::PartitionWork(block, block_count, static_cast<std::ptrdiff_t>(C));
+      block_status[block] = fn(block, static_cast<size_t>(work.start), static_cast<size_t>(work.end));
+    });
+    for (const auto& status : block_status) {
+      ORT_RETURN_IF_ERROR(status);
     }
-  } else {
-    if (!wstopwords_.empty()) {
-      // Filter input. When no case action is required
-      // we simply store original string references.
-      // Otherwise, we store converted strings.
-      std::vector<StrRef> filtered_orignal_strings;
-      std::vector<std::string> filtered_cased_strings;
-      filtered_orignal_strings.reserve(C);
-      filtered_cased_strings.reserve(C);
-      auto first = input_data;
-      auto const last = input_data + C;
-      while (first != last) {
-        const std::string& s = *first;
-        std::wstring wstr = converter.from_bytes(s);
-        if (wstr == wconv_error) {
-          return Status(common::ONNXRUNTIME, common::INVALID_ARGUMENT,
-                        "Input contains invalid utf8 chars at: " + s);
-        }
-        locale.ChangeCase(compare_caseaction_, wstr);
-        if (0 == wstopwords_.count(wstr)) {
-          if (case_change_action_ == NONE) {
-            filtered_orignal_strings.push_back(std::cref(s));
-          } else {
-            filtered_cased_strings.push_back(converter.to_bytes(wstr));
+    return Status::OK();
+  };
+
+  // Filter the stopwords out. ASCII strings are compared after a case conversion with the tables, other strings
+  // after a conversion to wide characters.
+  std::vector<uint8_t> keep;
+  std::vector<size_t> block_output_offsets;
+  size_t output_count = C;
+  if (!stopwords_.Empty()) {
+    keep.resize(C);
+    ORT_RETURN_IF_ERROR(for_each_block([&](std::ptrdiff_t, size_t first, size_t last) {
+      Utf8Converter converter(conv_error, wconv_error);
+      std::string cased;
+      for (size_t i = first; i < last; ++i) {
+        const std::string_view s = input_data[i];
+        if (is_case_sensitive_) {
+          keep[i] = stopwords_.FindEquivalent(s) == nullptr;
+        } else if (ascii_tables && IsAscii(s)) {
+          ChangeCaseAscii(compare_caseaction_ == UPPER ? ascii_upper_ : ascii_lower_, s, cased);
+          keep[i] = stopwords_.Find(cased) == nullptr;
+        } else {
+          std::wstring wstr = converter.from_bytes(std::string(s));
+          if (wstr == wconv_error) {
+            return InvalidUtf8(s);
           }
+          locale_->ChangeCase(compare_caseaction_, wstr);
+          keep[i] = wstopwords_.count(wstr) == 0;
         }
-        ++first;
       }
+      return Status::OK();
+    }));
+
+    output_count = 0;
+    block_output_offsets.resize(block_count);
+    for (std::ptrdiff_t block = 0; block < block_count; ++block) {
+      block_output_offsets[block] = output_count;
+      auto work = concurrency::ThreadPool::PartitionWork(block, block_count, static_cast<std::ptrdiff_t>(C));
+      output_count += static_cast<size_t>(std::count(keep.cbegin() + work.start, keep.cbegin() + work.end, uint8_t{1}));
+    }
+  }
+
+  std::vector<int64_t> output_dims;
+  if (N == 1) {
+    output_dims.push_back(1);
+  }
+
+  // Empty output case
+  if (output_count == 0) {
+    output_dims.push_back(1);
+    TensorShape output_shape(output_dims);
+    // This will create one empty string
+    ctx->Output(0, output_shape);
+    return Status::OK();
+  }
+
+  output_dims.push_back(output_count);
+  TensorShape output_shape(output_dims);
+  auto output_tensor = ctx->Output(0, output_shape);
+  auto const output_data = output_tensor->template MutableData<std::string>();
+
+  // Every block writes its strings directly to their position in the output.
+  return for_each_block([&](std::ptrdiff_t block, size_t first, size_t last) {
+    Utf8Converter converter(conv_error, wconv_error);
+    std::string* output = output_data + (keep.empty() ? first : block_output_offsets[block]);
+    for (size_t i = first; i < last; ++i) {
+      if (!keep.empty() && !keep[i]) {
+        continue;
+      }
+      const std::string_view s = input_data[i];
       if (case_change_action_ == NONE) {
-        status = CopyCaseAction(filtered_orignal_strings.cbegin(), filtered_orignal_strings.cend(), ctx, locale, converter,
-                                N, filtered_orignal_strings.size(), NONE);
+        output->assign(s.data(), s.size());
+      } else if (ascii_tables && IsAscii(s)) {
+        ChangeCaseAscii(case_change_action_ == UPPER ? ascii_upper_ : ascii_lower_, s, *output);
       } else {
-        status = CopyCaseAction(filtered_cased_strings.begin(), filtered_cased_strings.end(), ctx, locale, converter,
-                                N, filtered_cased_strings.size(), NONE);
+        std::wstring wstr = converter.from_bytes(std::string(s));
+        if (wstr == wconv_error) {
+          return InvalidUtf8(s);
+        }
+        locale_->ChangeCase(case_change_action_, wstr);
+        *output = converter.to_bytes(wstr);
       }
-    } else {
-      // Nothing to filter. Copy input to output and change case if needed
-      status = CopyCaseAction(input_data, input_data + C, ctx, locale, converter, N, C, case_change_action_);
+      ++output;
     }
-  }
-  return status;
+    return Status::OK();
+  });
 }
 }  // namespace onnxruntime
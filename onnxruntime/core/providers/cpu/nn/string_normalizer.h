@@ -3,13 +3,18 @@
 
 #pragma once
 
+#include "core/common/flat_hash_table.h"
 #include "core/framework/op_kernel.h"
 
 #include <locale>
+#include <memory>
 #include <string>
 #include <unordered_set>
 
 namespace onnxruntime {
+namespace string_normalizer {
+class Locale;
+}  // namespace string_normalizer
 
 class StringNormalizer : public OpKernel {
  public:
@@ -20,7 +25,7 @@ class StringNormalizer : public OpKernel {
   };
 
   explicit StringNormalizer(const OpKernelInfo& info);
-  ~StringNormalizer() override = default;
+  ~StringNormalizer() override;
 
   Status Compute(OpKernelContext* ctx) const override;
 
@@ -28,9 +33,14 @@ class StringNormalizer : public OpKernel {
   bool is_case_sensitive_;
   CaseAction case_change_action_;
   CaseAction compare_caseaction_;  // used for case-insensitive compare
-  std::string locale_name_;
-  // Either if these are populated but not both
-  std::unordered_set<std::string> stopwords_;
+  std::unique_ptr<string_normalizer::Locale> locale_;
+  // Case conversion tables of the ASCII characters, empty if the locale converts some of them to
+  // non-ASCII characters.
+  std::string ascii_lower_;
+  std::string ascii_upper_;
+  // Stopwords converted to compare_caseaction_ if case-insensitive, as UTF-8 strings for the
+  // ASCII inputs and as wide strings for the others. The UTF-8 strings are looked up as std::string_view.
+  FlatHashTable<std::string, bool> stopwords_;
   std::unordered_set<std::wstring> wstopwords_;
 };
 
@@ -3,11 +3,12 @@
 
 #include "tfidfvectorizer.h"
 #include "core/common/common.h"
+#include "core/common/flat_hash_table.h"
+#include "core/framework/string_tensor_view.h"
 #include "core/framework/tensor.h"
 #include "core/platform/threadpool.h"
 
-#include <functional>
-#include <unordered_map>
+#include <algorithm>
 
 namespace onnxruntime {
 
@@ -23,60 +24,64 @@ ONNX_CPU_OPERATOR_KERNEL(
 
 namespace ngram_details {
 
-// NgrampPart implements a Trie like structure
-// for a unigram (1) it would insert into a root map with a valid id.
-// for (1,2,3) node 2 would be a child of 1 but have id == 0
-// because (1,2) does not exists. Node 3 would have a valid id.
-template <class T>
-struct NgramPart;
-
-template <>
-struct NgramPart<int64_t>;
-
-template <>
-struct NgramPart<std::string>;
-
-using NgramPartInt = NgramPart<int64_t>;
-using NgramPartString = NgramPart<std::string>;
-
-// Avoid recursive class definitions using unique_ptr + forward declaration
-using IntMap = std::unordered_map<int64_t, std::unique_ptr<NgramPartInt>>;
-
-using StrMap = std::unordered_map<std::reference_wrapper<const std::string>, std::unique_ptr<NgramPartString>,
-                                  std::hash<std::string>, std::equal_to<std::string>>;
-
-template <>
-struct NgramPart<int64_t> {
-  size_t id_;  // 0 - means no entry, search for a bigger N
-  IntMap leafs_;
-  explicit NgramPart(size_t id) : id_(id) {}
+// The n-grams of the pool are sequences of token ids: the int64 pool values, or the ids of the distinct pool strings.
+// They are indexed in one flat hash table together with all their prefixes, so that the n-grams of an input row
+// starting at a given position are matched one token at a time, stopping at the first prefix missing from the pool.
+//
+// The hash of a sequence is computed incrementally from the hash of its prefix. The keys point to their tokens so
+// that a hash collision is resolved by comparing the tokens. The tokens of an input n-gram are `stride` apart,
+// following the skip distance.
+struct NgramKey {
+  uint64_t hash = 0;
+  const int64_t* tokens = nullptr;
+  int64_t size = 0;
+  int64_t stride = 1;
+
+  bool operator==(const NgramKey& other) const {
+    if (hash != other.hash || size != other.size) {
+      return false;
+    }
+    for (int64_t i = 0; i < size; ++i) {
+      if (tokens[i * stride] != other.tokens[i * other.stride]) {
+        return false;
+      }
+    }
+    return true;
+  }
 };
 
-template <>
-struct NgramPart<std::string> {
-  size_t id_;  // 0 - means no entry, search for a bigger N
-  StrMap leafs_;
-  explicit NgramPart(size_t id) : id_(id) {}
+struct NgramKeyHash {
+  uint64_t operator()(const NgramKey& key) const { return key.hash; }
 };
 
-// Returns next ngram_id
-template <class K, class ForwardIter, class Map>
-inline size_t PopulateGrams(ForwardIter first, size_t ngrams, size_t ngram_size, size_t ngram_id,
-                            Map& c) {
-  for (; ngrams > 0; --ngrams) {
-    size_t n = 1;
-    Map* m = &c;
-    while (true) {
-      auto p = m->emplace(*first, std::make_unique<NgramPart<K>>(0));
-      ++first;
-      if (n == ngram_size) {
-        ORT_ENFORCE(p.first->second->id_ == 0, "Duplicate ngram detected, size: ", ngram_size, " id: ", ngram_id);
-        p.first->second->id_ = ngram_id;
-        ++ngram_id;
-        break;
+constexpr uint64_t kNgramHashSeed = 0x243f6a8885a308d3ULL;
+
+inline uint64_t NextNgramHash(uint64_t prefix_hash, int64_t token) {
+  return FlatHashMix(prefix_hash ^ (static_cast<uint64_t>(token) * 0x9e3779b97f4a7c15ULL));
+}
+
+// Maps an n-gram to its position in ngram_indexes, or to -1 for a prefix that is not an n-gram of the pool.
+using NgramTable = FlatHashTable<NgramKey, int64_t, NgramKeyHash>;
+
+// Adds `ngrams` consecutive n-grams of `ngram_size` tokens starting at `first`, with their prefixes.
+// Returns the position of the next n-gram in ngram_indexes.
+inline int64_t PopulateGrams(const int64_t* first, size_t ngrams, size_t ngram_size, int64_t ngram_id,
+                             NgramTable& table) {
+  for (; ngrams > 0; --ngrams, first += ngram_size, ++ngram_id) {
+    uint64_t hash = kNgramHashSeed;
+    for (size_t n = 1; n <= ngram_size; ++n) {
+      hash = NextNgramHash(hash, first[n - 1]);
+      const NgramKey key{hash, first, static_cast<int64_t>(n), 1};
+      const int64_t* existing = table.Find(key);
+      if (n < ngram_size) {
+        if (existing == nullptr) {
+          table.Insert(key, -1);
+        }
+      } else {
+        ORT_ENFORCE(existing == nullptr || *existing < 0,
+                    "Duplicate ngram detected, size: ", ngram_size, " id: ", ngram_id + 1);
+        table.InsertOrAssign(key, ngram_id);
       }
-      ++n;
-      m = &p.first->second->leafs_;
     }
   }
   return ngram_id;
@@ -89,10 +94,6 @@ using namespace onnxruntime::ngram_details;
 
 namespace onnxruntime {
 
-inline const void* AdvanceElementPtr(const void* p, size_t elements, size_t element_size) {
-  return reinterpret_cast<const uint8_t*>(p) + elements * element_size;
-}
-
 // The weighting criteria.
 // "TF"(term frequency),
 //    the counts are propagated to output
@@ -127,11 +128,13 @@ struct TfIdfVectorizer::Impl {
   gsl::span<const int64_t> ngram_indexes_;
   gsl::span<const float>   weights_;
 
-  // This map contains references to pool_string_ entries
-  // of pool_strings attribute
-  StrMap str_map_;
-  // This map contains pool_int64s entries
-  IntMap int64_map_;
+  // Maps the distinct pool_strings entries to token ids,
+  // the n-grams of strings are indexed by token id in ngrams_
+  bool pool_is_string_ = false;
+  FlatHashTable<std::string, int64_t> str_ids_;
+  // The pool_int64s entries or the string token ids, referenced by the keys of ngrams_
+  std::vector<int64_t> pool_tokens_;
+  NgramTable ngrams_;
 
   size_t output_size_ = 0;
 
@@ -139,16 +142,6 @@ struct TfIdfVectorizer::Impl {
   ~Impl() = default;
   Impl(const Impl&) = delete;
   Impl& operator=(const Impl&) = delete;
-
-  void IncrementCount(size_t ngram_id, size_t row_num,
-                      std::vector<uint32_t>& frequencies) const {
-    assert(ngram_id != 0);
-    --ngram_id;
-    assert(ngram_id < ngram_indexes_.size());
-    auto output_idx = row_num * output_size_ + ngram_indexes_[ngram_id];
-    assert(static_cast<size_t>(output_idx) < frequencies.size());
-    ++frequencies[output_idx];
-  }
 };
 
 TfIdfVectorizer::TfIdfVectorizer(const OpKernelInfo& info) : OpKernel(info), impl_(new Impl) {
@@ -217,12 +210,27 @@ TfIdfVectorizer::TfIdfVectorizer(const OpKernelInfo& info) : OpKernel(info), imp
     ORT_ENFORCE(status.IsOK() && !pool_int64s.empty(), "non-empty pool_int64s is required if pool_strings not provided");
   }
 
+  // Hash every distinct string once: the input strings are converted to token ids before matching n-grams.
+  if (!pool_strings.empty()) {
+    impl_->pool_is_string_ = true;
+    impl_->str_ids_.Reserve(pool_strings.size());
+    impl_->pool_tokens_.reserve(pool_strings.size());
+    for (const std::string& str : pool_strings) {
+      impl_->str_ids_.Insert(str, static_cast<int64_t>(impl_->str_ids_.Size()));
+      impl_->pool_tokens_.push_back(*impl_->str_ids_.Find(str));
+    }
+  } else {
+    impl_->pool_tokens_.assign(pool_int64s.begin(), pool_int64s.end());
+  }
+
   // Iterator via the pool. Insert 1 item for 1-grams, 2 items for 2-grams, etc.
-  const auto total_items = (pool_strings.empty()) ? pool_int64s.size() : pool_strings.size();
-  size_t ngram_id = 1;  // start with 1, 0 - means no n-gram
+  const auto total_items = impl_->pool_tokens_.size();
+  int64_t ngram_id = 0;
   // Load into dictionary only required gram sizes
   const size_t min_gram_length = impl_->min_gram_length_;
   const size_t max_gram_length = impl_->max_gram_length_;
+  // The keys point into pool_tokens_ which must not move anymore.
+  impl_->ngrams_.Reserve(total_items);
   size_t ngram_size = 1;
   for (size_t i = 0; i < impl_->ngram_counts_.size(); ++i) {
     size_t start_idx = impl_->ngram_counts_[i];
@@ -236,11 +244,8 @@ TfIdfVectorizer::TfIdfVectorizer(const OpKernelInfo& info) : OpKernel(info), imp
       auto ngrams = items / ngram_size;
       // Skip loading into hash_set ngrams that are not in the range of [min_gram_length-max_gram_length]
       if (ngram_size >= min_gram_length && ngram_size <= max_gram_length) {
-        if (pool_strings.empty()) {
-          ngram_id = PopulateGrams<int64_t>(pool_int64s.begin() + start_idx, ngrams, ngram_size, ngram_id, impl_->int64_map_);
-        } else {
-          ngram_id = PopulateGrams<std::string>(pool_strings.begin() + start_idx, ngrams, ngram_size, ngram_id, impl_->str_map_);
-        }
+        ngram_id = PopulateGrams(impl_->pool_tokens_.data() + start_idx, ngrams, ngram_size, ngram_id,
+                                 impl_->ngrams_);
       } else {
         ngram_id += ngrams;
       }
@@ -251,56 +256,28 @@ TfIdfVectorizer::TfIdfVectorizer(const OpKernelInfo& info) : OpKernel(info), imp
 
 TfIdfVectorizer::~TfIdfVectorizer() = default;
 
-void TfIdfVectorizer::OutputResult(OpKernelContext* ctx, size_t B, const std::vector<uint32_t>& frequences) const {
+void TfIdfVectorizer::ApplyWeights(float* output_row) const {
   const Impl& impl = *impl_;
-  std::vector<int64_t> output_dims;
-  if (B == 0) {
-    output_dims.push_back(impl.output_size_);
-    B = 1;  // For use in the loops below
-  } else {
-    output_dims.push_back(B);
-    output_dims.push_back(impl.output_size_);
-  }
-
   const auto row_size = impl.output_size_;
-
-  TensorShape output_shape(output_dims);
-  assert(frequences.size() == static_cast<size_t>(output_shape.Size()));
-
-  auto Y = ctx->Output(0, output_shape);
-  auto output_data = Y->MutableData<float>();
   const auto& w = impl.weights_;
   switch (impl.weighting_criteria_) {
-    case kTF: {
-      for (auto f : frequences) {
-        *output_data++ = static_cast<float>(f);
-      }
-    } break;
+    case kTF:
+      break;
     case kIDF: {
       if (!w.empty()) {
-        const auto* freqs = frequences.data();
-        for (size_t batch = 0; batch < B; ++batch) {
-          for (size_t i = 0; i < row_size; ++i) {
-            *output_data++ = (*freqs++ > 0) ? w[i] : 0;
-          }
+        for (size_t i = 0; i < row_size; ++i) {
+          output_row[i] = (output_row[i] > 0) ? w[i] : 0;
         }
       } else {
-        for (auto f : frequences) {
-          *output_data++ = (f > 0) ? 1.0f : 0;
+        for (size_t i = 0; i < row_size; ++i) {
+          output_row[i] = (output_row[i] > 0) ? 1.0f : 0;
         }
       }
     } break;
     case kTFIDF: {
       if (!w.empty()) {
-        const auto* freqs = frequences.data();
-        for (size_t batch = 0; batch < B; ++batch) {
-          for (size_t i = 0; i < row_size; ++i) {
-            *output_data++ = *freqs++ * w[i];
-          }
-        }
-      } else {
-        for (auto f : frequences) {
-          *output_data++ = static_cast<float>(f);
+        for (size_t i = 0; i < row_size; ++i) {
+          output_row[i] *= w[i];
         }
       }
     } break;
@@ -310,68 +287,59 @@ void TfIdfVectorizer::OutputResult(OpKernelContext* ctx, size_t B, const std::ve
   }
 }
 
-void TfIdfVectorizer::ComputeImpl(OpKernelContext* ctx, ptrdiff_t row_num, size_t row_size,
-                                  std::vector<uint32_t>& frequencies) const {
-  auto X = ctx->Input<Tensor>(0);
-  const auto elem_size = X->DataType()->Size();
+void TfIdfVectorizer::ComputeImpl(const Tensor& X, ptrdiff_t row_num, size_t row_size,
+                                  std::vector<int64_t>& row_tokens, float* output_row) const {
+  const auto& impl = *impl_;
 
-  const void* const row_begin = AdvanceElementPtr(X->DataRaw(), row_num * row_size, elem_size);
-  const void* const row_end = AdvanceElementPtr(row_begin, row_size, elem_size);
+  // Convert the row to int64 tokens (token ids for strings, -1 if the string is not in the pool)
+  // so that every string is hashed once.
+  const int64_t* row_begin = nullptr;
+  if (X.IsDataType<int64_t>()) {
+    row_begin = X.Data<int64_t>() + row_num * row_size;
+  } else {
+    row_tokens.resize(row_size);
+    if (X.IsDataTypeString()) {
+      const StringTensorView strings(X);
+      const size_t row_offset = static_cast<size_t>(row_num) * row_size;
+      for (size_t i = 0; i < row_size; ++i) {
+        const int64_t* id = impl.str_ids_.FindEquivalent(strings[row_offset + i]);
+        row_tokens[i] = id != nullptr ? *id : -1;
+      }
+    } else {
+      const int32_t* row = X.Data<int32_t>() + row_num * row_size;
+      std::copy(row, row + row_size, row_tokens.begin());
+    }
+    row_begin = row_tokens.data();
+  }
 
-  const auto& impl = *impl_;
   const auto max_gram_length = impl.max_gram_length_;
   const auto max_skip_distance = impl.max_skip_count_ + 1;  // Convert to distance
   auto start_ngram_size = impl.min_gram_length_;
 
-  for (auto skip_distance = 1; skip_distance <= max_skip_distance; ++skip_distance) {
-    auto ngram_start = row_begin;
-    auto const ngram_row_end = row_end;
-
-    while (ngram_start < ngram_row_end) {
+  // The counts are accumulated in the output row, the weights are applied once the row is complete.
+  const auto row_length = static_cast<int64_t>(row_size);
+  for (int64_t skip_distance = 1; skip_distance <= max_skip_distance; ++skip_distance) {
+    for (int64_t ngram_start = 0; ngram_start < row_length; ++ngram_start) {
       // We went far enough so no n-grams of any size can be gathered
-      auto at_least_this = AdvanceElementPtr(ngram_start, skip_distance * (start_ngram_size - 1), elem_size);
-      if (at_least_this >= ngram_row_end) {
+      if (ngram_start + skip_distance * (start_ngram_size - 1) >= row_length) {
         break;
       }
 
-      auto ngram_item = ngram_start;
-      if (X->IsDataTypeString()) {
-        const std::string* str_item = reinterpret_cast<const std::string*>(ngram_item);
-        const StrMap* str_map = &impl.str_map_;
-        for (auto ngram_size = 1;
-             !str_map->empty() &&
-             ngram_size <= max_gram_length &&
-             str_item < ngram_row_end;
-             ++ngram_size, str_item += skip_distance) {
-          auto hit = str_map->find(*str_item);
-          if (hit == str_map->end()) {
-            break;
-          }
-          if (ngram_size >= start_ngram_size && hit->second->id_ != 0) {
-            impl.IncrementCount(hit->second->id_, row_num, frequencies);
-          }
-          str_map = &hit->second->leafs_;
+      uint64_t hash = kNgramHashSeed;
+      for (int64_t ngram_size = 1, ngram_item = ngram_start;
+           ngram_size <= max_gram_length &&
+           ngram_item < row_length;
+           ++ngram_size, ngram_item += skip_distance) {
+        hash = NextNgramHash(hash, row_begin[ngram_item]);
+        const int64_t* ngram_id = impl.ngrams_.Find(NgramKey{hash, row_begin + ngram_start, ngram_size, skip_distance});
+        if (ngram_id == nullptr) {
+          break;
         }
-      } else {
-        const IntMap* int_map = &impl.int64_map_;
-        for (auto ngram_size = 1;
-             !int_map->empty() &&
-             ngram_size <= max_gram_length &&
-             ngram_item < ngram_row_end;
-             ++ngram_size, ngram_item = AdvanceElementPtr(ngram_item, skip_distance, elem_size)) {
-          int64_t val = (X->IsDataType<int32_t>()) ? int64_t{*reinterpret_cast<const int32_t*>(ngram_item)} : *reinterpret_cast<const int64_t*>(ngram_item);
-          auto hit = int_map->find(val);
-          if (hit == int_map->end()) {
-            break;
-          }
-          if (ngram_size >= start_ngram_size && hit->second->id_ != 0) {
-            impl.IncrementCount(hit->second->id_, row_num, frequencies);
-          }
-          int_map = &hit->second->leafs_;
+        if (ngram_size >= start_ngram_size && *ngram_id >= 0) {
+          assert(static_cast<size_t>(*ngram_id) < impl.ngram_indexes_.size());
+          output_row[impl.ngram_indexes_[*ngram_id]] += 1.0f;
         }
       }
-      // Sliding window shift
-      ngram_start = AdvanceElementPtr(ngram_start, 1, elem_size);
     }
     // We count UniGrams only once since they are not affected
     // by skip distance
@@ -379,6 +347,8 @@ void TfIdfVectorizer::ComputeImpl(OpKernelContext* ctx, ptrdiff_t row_num, size_
       break;
     }
   }
+
+  ApplyWeights(output_row);
 }
 
 Status TfIdfVectorizer::Compute(OpKernelContext* ctx) const {
@@ -411,30 +381,39 @@ Status TfIdfVectorizer::Compute(OpKernelContext* ctx) const {
   }
 
   assert((num_rows * C) == total_items);
-  // Frequency holder allocate [B..output_size_]
-  // and init all to zero
-  std::vector<uint32_t> frequencies;
-  frequencies.resize(num_rows * impl_->output_size_, 0);
-
-  if (total_items == 0 ||
-      (X->IsDataTypeString() && impl_->str_map_.empty()) ||
-      ((X->IsDataType<int32_t>() || X->IsDataType<int64_t>()) && impl_->int64_map_.empty())) {
+  const size_t output_size = impl_->output_size_;
+  std::vector<int64_t> output_dims;
+  if (B == 0) {
+    output_dims.push_back(output_size);
+  } else {
+    output_dims.push_back(B);
+    output_dims.push_back(output_size);
+  }
+  auto Y = ctx->Output(0, output_dims);
+  float* output_data = Y->MutableData<float>();
+  std::fill_n(output_data, num_rows * output_size, 0.0f);
+
+  if (total_items == 0 || impl_->ngrams_.Empty() || X->IsDataTypeString() != impl_->pool_is_string_) {
     // TfidfVectorizer may receive an empty input when it follows a Tokenizer
     // (for example for a string containing only stopwords).
     // TfidfVectorizer returns a zero tensor of shape
     // {b_dim, output_size} when b_dim is the number of received observations
     // and output_size the is the maximum value in ngram_indexes attribute plus 1.
-    OutputResult(ctx, B, frequencies);
     return Status::OK();
   }
 
-  std::function<void(ptrdiff_t)> fn = [this, ctx, C, &frequencies](ptrdiff_t row_num) {
-    ComputeImpl(ctx, row_num, C, frequencies);
-  };
-
-  concurrency::ThreadPool::TryBatchParallelFor(ctx->GetOperatorThreadPool(), num_rows, std::move(fn), 0);
-
-  OutputResult(ctx, B, frequencies);
+  // The rows are independent: each one is counted and weighted in its own slice of the output.
+  const double ngram_lookups = static_cast<double>(C * (impl_->max_skip_count_ + 1) * impl_->max_gram_length_);
+  concurrency::ThreadPool::TryParallelFor(
+      ctx->GetOperatorThreadPool(), num_rows,
+      TensorOpCost{static_cast<double>(C * sizeof(int64_t)), static_cast<double>(output_size * sizeof(float)),
+                   ngram_lookups * 16},
+      [this, X, C, output_data, output_size](std::ptrdiff_t first, std::ptrdiff_t last) {
+        std::vector<int64_t> row_tokens;
+        for (std::ptrdiff_t row_num = first; row_num < last; ++row_num) {
+          ComputeImpl(*X, row_num, C, row_tokens, output_data + row_num * output_size);
+        }
+      });
 
   return Status::OK();
 }
@@ -19,12 +19,12 @@ class TfIdfVectorizer final : public OpKernel {
   Status Compute(OpKernelContext* ctx) const override;
 
  private:
+  // Counts the n-grams of a row into its output row and applies the weights.
+  void ComputeImpl(const Tensor& X, ptrdiff_t row_num, size_t row_size, std::vector<int64_t>& row_tokens,
+                   float* output_row) const;
 
-  void ComputeImpl(OpKernelContext* ctx, ptrdiff_t row_num, size_t row_size,
-                     std::vector<uint32_t>& frequencies) const;
-
-  // Apply weighing criteria and output
-  void OutputResult(OpKernelContext* ctx, size_t b_dim, const std::vector<uint32_t>& frequences) const;
+  // Apply weighing criteria to the counts of an output row
+  void ApplyWeights(float* output_row) const;
 
   struct Impl;
   std::unique_ptr<Impl> impl_;
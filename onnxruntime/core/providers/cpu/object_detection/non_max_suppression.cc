@@ -13,8 +13,12 @@ limitations under the License.
 
 #include "non_max_suppression.h"
 #include "non_max_suppression_helper.h"
+#include "core/platform/threadpool.h"
+#include <cmath>
+#include <limits>
 #include <queue>
 #include <utility>
+#include <vector>
 //TODO:fix the warnings
 #ifdef _MSC_VER
 #pragma warning(disable : 4244)
@@ -114,6 +118,175 @@ Status NonMaxSuppressionBase::GetThresholdsFromInputs(const PrepareContext& pc,
   return Status::OK();
 }
 
+namespace {
+
+// Selections per class above which the boxes selected so far are bucketed into a spatial grid, so that a
+// candidate is only compared with the selected boxes it can overlap.
+constexpr int64_t kMinSelectedForGrid = 64;
+constexpr int kGridDim = 8;
+
+// Number of selected boxes a candidate is compared with before checking whether it was suppressed.
+constexpr size_t kIOUBlockSize = 16;
+
+// Corner coordinates of all boxes in structure-of-arrays layout. Boxes that can never overlap another box
+// (empty, inverted or NaN coordinates) have an area of 0, matching SuppressByIOU which never suppresses
+// them or suppresses anything with them.
+struct CornerBoxes {
+  explicit CornerBoxes(size_t count)
+      : x_min(count), y_min(count), x_max(count), y_max(count), area(count) {}
+
+  std::vector<float> x_min;
+  std::vector<float> y_min;
+  std::vector<float> x_max;
+  std::vector<float> y_max;
+  std::vector<float> area;
+};
+
+// Uniform grid over the extent of the valid boxes of one batch.
+struct SpatialGrid {
+  int dim = 1;
+  float x_origin = 0.f;
+  float y_origin = 0.f;
+  float x_scale = 0.f;
+  float y_scale = 0.f;
+
+  // Monotonic in value, so two boxes that share any point share at least one cell.
+  int XCell(float x) const { return Cell((x - x_origin) * x_scale); }
+  int YCell(float y) const { return Cell((y - y_origin) * y_scale); }
+
+ private:
+  int Cell(float scaled) const {
+    if (dim == 1) {
+      return 0;
+    }
+    return static_cast<int>(std::min(std::max(scaled, 0.f), static_cast<float>(dim - 1)));
+  }
+};
+
+// Selected boxes of one grid cell.
+struct SelectedBoxes {
+  void Clear() {
+    x_min.clear();
+    y_min.clear();
+    x_max.clear();
+    y_max.clear();
+    area.clear();
+  }
+
+  void Add(const CornerBoxes& boxes, size_t index) {
+    x_min.push_back(boxes.x_min[index]);
+    y_min.push_back(boxes.y_min[index]);
+    x_max.push_back(boxes.x_max[index]);
+    y_max.push_back(boxes.y_max[index]);
+    area.push_back(boxes.area[index]);
+  }
+
+  std::vector<float> x_min;
+  std::vector<float> y_min;
+  std::vector<float> x_max;
+  std::vector<float> y_max;
+  std::vector<float> area;
+};
+
+void ConvertBoxes(const float* boxes_data, int64_t center_point_box, int64_t begin, int64_t end,
+                  CornerBoxes& boxes) {
+  for (int64_t i = begin; i < end; ++i) {
+    const float* box = boxes_data + 4 * i;
+    float x_min, y_min, x_max, y_max;
+    if (0 == center_point_box) {
+      // boxes data format [y1, x1, y2, x2]
+      MaxMin(box[1], box[3], x_min, x_max);
+      MaxMin(box[0], box[2], y_min, y_max);
+    } else {
+      // boxes data format [x_center, y_center, width, height]
+      const float width_half = box[2] / 2;
+      const float height_half = box[3] / 2;
+      x_min = box[0] - width_half;
+      x_max = box[0] + width_half;
+      y_min = box[1] - height_half;
+      y_max = box[1] + height_half;
+    }
+
+    const float area = (x_max - x_min) * (y_max - y_min);
+    const bool valid = x_max > x_min && y_max > y_min && area > .0f;
+    boxes.x_min[i] = x_min;
+    boxes.y_min[i] = y_min;
+    boxes.x_max[i] = x_max;
+    boxes.y_max[i] = y_max;
+    boxes.area[i] = valid ? area : .0f;
+  }
+}
+
+SpatialGrid MakeGrid(const CornerBoxes& boxes, int64_t begin, int64_t end) {
+  SpatialGrid grid;
+  float x_lo = std::numeric_limits<float>::max();
+  float y_lo = std::numeric_limits<float>::max();
+  float x_hi = std::numeric_limits<float>::lowest();
+  float y_hi = std::numeric_limits<float>::lowest();
+  for (int64_t i = begin; i < end; ++i) {
+    if (boxes.area[i] > .0f) {
+      x_lo = std::min(x_lo, boxes.x_min[i]);
+      y_lo = std::min(y_lo, boxes.y_min[i]);
+      x_hi = std::max(x_hi, boxes.x_max[i]);
+      y_hi = std::max(y_hi, boxes.y_max[i]);
+    }
+  }
+
+  const float x_scale = kGridDim / (x_hi - x_lo);
+  const float y_scale = kGridDim / (y_hi - y_lo);
+  if (x_hi > x_lo && y_hi > y_lo && std::isfinite(x_scale) && std::isfinite(y_scale) && x_scale > 0 && y_scale > 0) {
+    grid.dim = kGridDim;
+    grid.x_origin = x_lo;
+    grid.y_origin = y_lo;
+    grid.x_scale = x_scale;
+    grid.y_scale = y_scale;
+  }
+
+  return grid;
+}
+
+// Same arithmetic as nms_helpers::SuppressByIOU for a valid box against each of the selected boxes. The inner
+// loop is branch free so it can be vectorized, and we only exit between blocks.
+bool SuppressedBySelected(const SelectedBoxes& selected, const CornerBoxes& boxes, size_t index,
+                          float iou_threshold) {
+  const float x_min = boxes.x_min[index];
+  const float y_min = boxes.y_min[index];
+  const float x_max = boxes.x_max[index];
+  const float y_max = boxes.y_max[index];
+  const float area = boxes.area[index];
+
+  const float* s_x_min = selected.x_min.data();
+  const float* s_y_min = selected.y_min.data();
+  const float* s_x_max = selected.x_max.data();
+  const float* s_y_max = selected.y_max.data();
+  const float* s_area = selected.area.data();
+  const size_t count = selected.area.size();
+
+  for (size_t block_start = 0; block_start < count; block_start += kIOUBlockSize) {
+    const size_t block_end = std::min(count, block_start + kIOUBlockSize);
+    int suppressed = 0;
+    for (size_t i = block_start; i < block_end; ++i) {
+      const float intersection_width = std::min(x_max, s_x_max[i]) - std::max(x_min, s_x_min[i]);
+      const float intersection_height = std::min(y_max, s_y_max[i]) - std::max(y_min, s_y_min[i]);
+      const float intersection_area = intersection_width * intersection_height;
+      const float union_area = area + s_area[i] - intersection_area;
+      suppressed |= static_cast<int>(intersection_width > .0f) &
+                    static_cast<int>(intersection_height > .0f) &
+                    static_cast<int>(intersection_area > .0f) &
+                    static_cast<int>(union_area > .0f) &
+                    static_cast<int>(intersection_area / union_area > iou_threshold);
+    }
+
+    if (suppressed) {
+      return true;
+    }
+  }
+
+  return false;
+}
+
+}  // namespace
+
 Status NonMaxSuppression::Compute(OpKernelContext* ctx) const {
   PrepareContext pc;
   ORT_RETURN_IF_ERROR(PrepareCompute(ctx, pc));
@@ -144,62 +317,112 @@ Status NonMaxSuppression::Compute(OpKernelContext* ctx) const {
   };
 
   const auto center_point_box = GetCenterPointBox();
-
-  std::vector<SelectedIndex> selected_indices;
-  std::vector<BoxInfoPtr> selected_boxes_inside_class;
-  selected_boxes_inside_class.reserve(std::min<size_t>(static_cast<size_t>(max_output_boxes_per_class), pc.num_boxes_));
-
-  for (int64_t batch_index = 0; batch_index < pc.num_batches_; ++batch_index) {
-    for (int64_t class_index = 0; class_index < pc.num_classes_; ++class_index) {
-      int64_t box_score_offset = (batch_index * pc.num_classes_ + class_index) * pc.num_boxes_;
-      const float* batch_boxes = boxes_data + (batch_index * pc.num_boxes_ * 4);
-      std::vector<BoxInfoPtr> candidate_boxes;
-      candidate_boxes.reserve(pc.num_boxes_);
-
-      // Filter by score_threshold_
-      const auto* class_scores = scores_data + box_score_offset;
-      if (pc.score_threshold_ != nullptr) {
-        for (int64_t box_index = 0; box_index < pc.num_boxes_; ++box_index, ++class_scores) {
-          if (*class_scores > score_threshold) {
-            candidate_boxes.emplace_back(*class_scores, box_index);
+  const int64_t num_boxes = pc.num_boxes_;
+  const bool use_grid = max_output_boxes_per_class >= kMinSelectedForGrid;
+  concurrency::ThreadPool* tp = ctx->GetOperatorThreadPool();
+
+  // Convert the boxes of each batch once, rather than on every IOU check of every class.
+  CornerBoxes boxes(static_cast<size_t>(pc.num_batches_ * num_boxes));
+  std::vector<SpatialGrid> grids(static_cast<size_t>(pc.num_batches_));
+  concurrency::ThreadPool::TrySimpleParallelFor(tp, pc.num_batches_, [&](std::ptrdiff_t batch_index) {
+    const int64_t begin = batch_index * num_boxes;
+    ConvertBoxes(boxes_data, center_point_box, begin, begin + num_boxes, boxes);
+    if (use_grid) {
+      grids[batch_index] = MakeGrid(boxes, begin, begin + num_boxes);
+    }
+  });
+
+  // Every (batch, class) pair is independent. The selections are concatenated afterwards so the output order
+  // is the same as processing the pairs serially.
+  const int64_t num_tasks = pc.num_batches_ * pc.num_classes_;
+  std::vector<std::vector<int64_t>> selected_per_task(static_cast<size_t>(num_tasks));
+  const double task_cost = static_cast<double>(num_boxes) * 8;
+  concurrency::ThreadPool::TryParallelFor(
+      tp, num_tasks, TensorOpCost{static_cast<double>(num_boxes) * sizeof(float), 0, task_cost},
+      [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+        std::vector<SelectedBoxes> cells;
+
+        for (std::ptrdiff_t task = first; task < last; ++task) {
+          const int64_t batch_index = task / pc.num_classes_;
+          const int64_t box_offset = batch_index * num_boxes;
+          const SpatialGrid& grid = grids[batch_index];
+          cells.resize(static_cast<size_t>(grid.dim) * grid.dim);
+          for (auto& cell : cells) {
+            cell.Clear();
           }
-        }
-      } else {
-        for (int64_t box_index = 0; box_index < pc.num_boxes_; ++box_index, ++class_scores) {
-          candidate_boxes.emplace_back(*class_scores, box_index);
-        }
-      }
-      std::priority_queue<BoxInfoPtr, std::vector<BoxInfoPtr>> sorted_boxes(std::less<BoxInfoPtr>(), std::move(candidate_boxes));
-
-      selected_boxes_inside_class.clear();
-      // Get the next box with top score, filter by iou_threshold
-      while (!sorted_boxes.empty() && static_cast<int64_t>(selected_boxes_inside_class.size()) < max_output_boxes_per_class) {
-        const BoxInfoPtr& next_top_score = sorted_boxes.top();
-
-        bool selected = true;
-        // Check with existing selected boxes for this class, suppress if exceed the IOU (Intersection Over Union) threshold
-        for (const auto& selected_index : selected_boxes_inside_class) {
-          if (SuppressByIOU(batch_boxes, next_top_score.index_, selected_index.index_, center_point_box, iou_threshold)) {
-            selected = false;
-            break;
+
+          std::vector<BoxInfoPtr> candidate_boxes;
+          candidate_boxes.reserve(num_boxes);
+
+          // Filter by score_threshold_
+          const auto* class_scores = scores_data + task * num_boxes;
+          if (pc.score_threshold_ != nullptr) {
+            for (int64_t box_index = 0; box_index < num_boxes; ++box_index, ++class_scores) {
+              if (*class_scores > score_threshold) {
+                candidate_boxes.emplace_back(*class_scores, box_index);
+              }
+            }
+          } else {
+            for (int64_t box_index = 0; box_index < num_boxes; ++box_index, ++class_scores) {
+              candidate_boxes.emplace_back(*class_scores, box_index);
+            }
           }
+          std::priority_queue<BoxInfoPtr, std::vector<BoxInfoPtr>> sorted_boxes(std::less<BoxInfoPtr>(),
+                                                                                 std::move(candidate_boxes));
+
+          auto& selected_indices = selected_per_task[task];
+          // Get the next box with top score, filter by iou_threshold
+          while (!sorted_boxes.empty() && static_cast<int64_t>(selected_indices.size()) < max_output_boxes_per_class) {
+            const int64_t box_index = sorted_boxes.top().index_;
+            sorted_boxes.pop();
+
+            const size_t index = static_cast<size_t>(box_offset + box_index);
+            if (boxes.area[index] > .0f) {
+              const int x_first = grid.XCell(boxes.x_min[index]);
+              const int x_last = grid.XCell(boxes.x_max[index]);
+              const int y_first = grid.YCell(boxes.y_min[index]);
+              const int y_last = grid.YCell(boxes.y_max[index]);
+
+              bool selected = true;
+              for (int y = y_first; y <= y_last && selected; ++y) {
+                for (int x = x_first; x <= x_last && selected; ++x) {
+                  selected = !SuppressedBySelected(cells[y * grid.dim + x], boxes, index, iou_threshold);
+                }
+              }
+
+              if (!selected) {
+                continue;
+              }
+
+              for (int y = y_first; y <= y_last; ++y) {
+                for (int x = x_first; x <= x_last; ++x) {
+                  cells[y * grid.dim + x].Add(boxes, index);
+                }
+              }
+            }
+
+            selected_indices.push_back(box_index);
+          }  //while
         }
+      });
 
-        if (selected) {
-          selected_boxes_inside_class.push_back(next_top_score);
-          selected_indices.emplace_back(batch_index, class_index, next_top_score.index_);
-        }
-        sorted_boxes.pop();
-      }  //while
-    }    //for class_index
-  }      //for batch_index
+  size_t num_selected = 0;
+  for (const auto& selected_indices : selected_per_task) {
+    num_selected += selected_indices.size();
+  }
 
   const auto last_dim = 3;
-  const auto num_selected = selected_indices.size();
   Tensor* output = ctx->Output(0, {static_cast<int64_t>(num_selected), last_dim});
   ORT_ENFORCE(output != nullptr);
   static_assert(last_dim * sizeof(int64_t) == sizeof(SelectedIndex), "Possible modification of SelectedIndex");
-  memcpy(output->MutableData<int64_t>(), selected_indices.data(), num_selected * sizeof(SelectedIndex));
+  auto* output_data = reinterpret_cast<SelectedIndex*>(output->MutableData<int64_t>());
+  for (int64_t task = 0; task < num_tasks; ++task) {
+    const int64_t batch_index = task / pc.num_classes_;
+    const int64_t class_index = task % pc.num_classes_;
+    for (int64_t box_index : selected_per_task[task]) {
+      *output_data++ = SelectedIndex(batch_index, class_index, box_index);
+    }
+  }
 
   return Status::OK();
 }
@@ -267,6 +267,18 @@ static void ValidateFastReduceKRK(const std::vector<int64_t>& fast_shape, const
   ORT_ENFORCE(fast_shape[0] * fast_shape[2] == output.Shape().Size(), "Output size mismatch.");
 }
 
+static void ValidateFastReduceMulti(const std::vector<int64_t>& fast_shape, const std::vector<int64_t>& fast_axes,
+                                    const Tensor& output) {
+  ORT_ENFORCE(fast_shape.size() > 2 && !fast_axes.empty(), "At least two groups of reduced dimensions are expected.");
+  int64_t kept_size = 1;
+  for (size_t i = 0; i < fast_shape.size(); ++i) {
+    if (std::find(fast_axes.begin(), fast_axes.end(), static_cast<int64_t>(i)) == fast_axes.end()) {
+      kept_size *= fast_shape[i];
+    }
+  }
+  ORT_ENFORCE(kept_size == output.Shape().Size(), "Output size mismatch.");
+}
+
 void ReduceAggregatorBase::FastReduceKR(const Tensor&, const std::vector<int64_t>&, Tensor&, concurrency::ThreadPool*) {
   ValidateMustBeOverloaded();
 }
@@ -276,6 +288,10 @@ void ReduceAggregatorBase::FastReduceRK(const Tensor&, const std::vector<int64_t
 void ReduceAggregatorBase::FastReduceKRK(const Tensor&, const std::vector<int64_t>&, Tensor&, concurrency::ThreadPool*) {
   ValidateMustBeOverloaded();
 }
+void ReduceAggregatorBase::FastReduceMulti(const Tensor&, const std::vector<int64_t>&, const std::vector<int64_t>&,
+                                           Tensor&, concurrency::ThreadPool*) {
+  ValidateMustBeOverloaded();
+}
 
 TensorOpCost ParallelReduceFastCost(int64_t n_row, int64_t n_col, int64_t element_size, int n_ops) {
   return TensorOpCost{static_cast<double>(n_row * n_col * element_size),
@@ -283,6 +299,84 @@ TensorOpCost ParallelReduceFastCost(int64_t n_row, int64_t n_col, int64_t elemen
                       static_cast<double>(n_row * n_col * element_size * n_ops)};
 }
 
+void ReduceKRKMlas(MLAS_REDUCTION_KIND kind, const float* data, float* out,
+                   int64_t d0, int64_t d1, int64_t d2, concurrency::ThreadPool* tp) {
+  if (d2 == 1) {
+    concurrency::ThreadPool::TryParallelFor(
+        tp, d0, ParallelReduceFastCost(1, d1, sizeof(float), 6),
+        [kind, data, out, d1](std::ptrdiff_t first, std::ptrdiff_t last) {
+          MlasReduceRows(kind, data + first * d1, out + first,
+                         static_cast<size_t>(last - first), static_cast<size_t>(d1));
+        });
+    return;
+  }
+
+  // The output elements are split into blocks of the innermost dimension,
+  // each block is the column reduction of a [d1, block size] matrix.
+  concurrency::ThreadPool::TryParallelFor(
+      tp, d0 * d2, ParallelReduceFastCost(1, d1, sizeof(float), 6),
+      [kind, data, out, d1, d2](std::ptrdiff_t first, std::ptrdiff_t last) {
+        for (std::ptrdiff_t begin = first; begin < last;) {
+          const int64_t i = begin / d2;
+          const int64_t j0 = begin % d2;
+          const int64_t j1 = std::min<int64_t>(d2, j0 + (last - begin));
+          MlasReduceColumns(kind, data + i * d1 * d2 + j0, out + i * d2 + j0,
+                            static_cast<size_t>(d1), static_cast<size_t>(j1 - j0), static_cast<size_t>(d2));
+          begin += j1 - j0;
+        }
+      });
+}
+
+void FastReduceMultiMlas(MLAS_REDUCTION_KIND kind, MLAS_REDUCTION_KIND combine_kind,
+                         const Tensor& input, const std::vector<int64_t>& fast_shape,
+                         const std::vector<int64_t>& fast_axes, Tensor& output, concurrency::ThreadPool* tp) {
+  std::vector<int64_t> shape(fast_shape);
+  std::vector<bool> reduced(shape.size(), false);
+  for (auto a : fast_axes) {
+    reduced[a] = true;
+  }
+
+  const float* data = input.Data<float>();
+  std::vector<float> buffers[2];
+  for (size_t pass = 0;; ++pass) {
+    // The innermost reduced dimension splits the current shape into [d0, d1, d2].
+    size_t axis = shape.size() - 1;
+    while (!reduced[axis]) {
+      --axis;
+    }
+    int64_t d0 = 1;
+    bool last_pass = true;
+    for (size_t i = 0; i < axis; ++i) {
+      d0 *= shape[i];
+      last_pass &= !reduced[i];
+    }
+    const int64_t d1 = shape[axis];
+    const int64_t d2 = axis + 1 < shape.size() ? shape[axis + 1] : 1;
+
+    float* out;
+    if (last_pass) {
+      out = output.MutableData<float>();
+    } else {
+      buffers[pass % 2].resize(SafeInt<size_t>(d0) * d2);
+      out = buffers[pass % 2].data();
+    }
+    ReduceKRKMlas(pass == 0 ? kind : combine_kind, data, out, d0, d1, d2, tp);
+    if (last_pass) {
+      return;
+    }
+
+    // The kept dimensions around the reduced one are now adjacent.
+    if (axis + 1 < shape.size()) {
+      shape[axis - 1] *= shape[axis + 1];
+      shape.erase(shape.begin() + axis + 1);
+      reduced.erase(reduced.begin() + axis + 1);
+    }
+    shape.erase(shape.begin() + axis);
+    reduced.erase(reduced.begin() + axis);
+    data = out;
+  }
+}
+
 void NoTransposePrepareForReduce(const TensorShape& new_input_shape,
                                  const std::vector<int64_t>& reduced_axes,
                                  ResultsNoTransposePrepareForReduce& results) {
@@ -636,7 +730,7 @@ FastReduceKind OptimizeShapeForFastReduce(const std::vector<int64_t>& input_shap
   if (fast_shape.size() == 3 && !reduce[0]) {
     return FastReduceKind::kKRK;
   }
-  return FastReduceKind::kNone;
+  return FastReduceKind::kMulti;
 }
 
 void ValidateCommonFastReduce(const Tensor* axes_tensor) {
@@ -669,6 +763,10 @@ bool CommonFastReduceCopy(OpKernelContext* ctx, std::vector<int64_t>& input_axes
 typedef void fast_reduce_fct(const Tensor& input, const std::vector<int64_t>& fast_shape,
                              Tensor& output, concurrency::ThreadPool* tp);
 
+typedef void fast_reduce_multi_fct(const Tensor& input, const std::vector<int64_t>& fast_shape,
+                                   const std::vector<int64_t>& fast_axes, Tensor& output,
+                                   concurrency::ThreadPool* tp);
+
 bool CommonFastReduceSwitch(OpKernelContext* ctx,
                             const std::vector<int64_t>& axes_,
                             int64_t keepdims_,
@@ -680,7 +778,8 @@ bool CommonFastReduceSwitch(OpKernelContext* ctx,
                             FastReduceKind which_fast_reduce,
                             fast_reduce_fct* case_kr,
                             fast_reduce_fct* case_rk,
-                            fast_reduce_fct* case_krk) {
+                            fast_reduce_fct* case_krk,
+                            fast_reduce_multi_fct* case_multi) {
   std::vector<int64_t> axes;
   const Tensor* input = ctx->Input<Tensor>(0);
   auto reduced_dims = input->Shape().GetDims();
@@ -704,26 +803,22 @@ bool CommonFastReduceSwitch(OpKernelContext* ctx,
           return true;
         }
         case FastReduceKind::kRK: {
+          // The RK and KRK implementations are parallelized over the kept elements of
+          // the innermost dimension, they do not depend on the size of the outer dimensions.
           ValidateFastReduceRK(fast_shape, *output);
-          if ((fast_shape[0] > concurrency::ThreadPool::DegreeOfParallelism(ctx->GetOperatorThreadPool()) * 16) &&
-              (std::max(fast_shape[0], fast_shape[1]) >
-               concurrency::ThreadPool::DegreeOfParallelism(ctx->GetOperatorThreadPool()) * 256)) {
-            // See benchmarks in PR #7719.
-            case_rk(*input, fast_shape, *output, ctx->GetOperatorThreadPool());
-            return true;
-          } else {
-            break;
-          }
+          case_rk(*input, fast_shape, *output, ctx->GetOperatorThreadPool());
+          return true;
         }
-        case FastReduceKind::kKRK:
+        case FastReduceKind::kKRK: {
           ValidateFastReduceKRK(fast_shape, *output);
-          if (fast_shape[0] >= std::max(2, concurrency::ThreadPool::DegreeOfParallelism(ctx->GetOperatorThreadPool()))) {
-            // See benchmarks in PR #7719.
-            case_krk(*input, fast_shape, *output, ctx->GetOperatorThreadPool());
-            return true;
-          } else {
-            break;
-          }
+          case_krk(*input, fast_shape, *output, ctx->GetOperatorThreadPool());
+          return true;
+        }
+        case FastReduceKind::kMulti: {
+          ValidateFastReduceMulti(fast_shape, fast_axes, *output);
+          case_multi(*input, fast_shape, fast_axes, *output, ctx->GetOperatorThreadPool());
+          return true;
+        }
         case FastReduceKind::kR:
         case FastReduceKind::kK:
         case FastReduceKind::kNone:
@@ -745,9 +840,18 @@ bool CommonFastReduce(OpKernelContext* ctx,
                       std::vector<int64_t>& fast_shape,
                       std::vector<int64_t>& output_shape,
                       std::vector<int64_t>& fast_axes) {
+  if (AGG::WhichFastReduce() == FastReduceKind::kNone) {
+    // No specialized implementation, the generic ones only rely on the aggregator's update methods.
+    return CommonFastReduceSwitch(ctx, axes_, keepdims_, noop_with_empty_axes,
+                                  fast_kind, fast_shape, output_shape, fast_axes,
+                                  FastReduceKind::kKR | FastReduceKind::kRK | FastReduceKind::kKRK,
+                                  &GenericFastReduceKR<AGG>, &GenericFastReduceRK<AGG>, &GenericFastReduceKRK<AGG>,
+                                  &ReduceAggregatorBase::FastReduceMulti);
+  }
   return CommonFastReduceSwitch(ctx, axes_, keepdims_, noop_with_empty_axes,
                                 fast_kind, fast_shape, output_shape, fast_axes,
-                                AGG::WhichFastReduce(), &AGG::FastReduceKR, &AGG::FastReduceRK, &AGG::FastReduceKRK);
+                                AGG::WhichFastReduce(), &AGG::FastReduceKR, &AGG::FastReduceRK, &AGG::FastReduceKRK,
+                                &AGG::FastReduceMulti);
 }
 
 static void ValidateKeepDims(const TensorShape& shape, int64_t keepdims) {
@@ -915,25 +1019,21 @@ std::unique_ptr<Tensor> ReduceSum<T>::Impl(const Tensor& input, const std::vecto
         ReduceAggregatorSum<T>::FastReduceKR(input, fast_shape, *output, tp);
         return output;
       }
-      case FastReduceKind::kRK:
+      case FastReduceKind::kRK: {
         ValidateFastReduceRK(fast_shape, *output);
-        if (std::max(fast_shape[0], fast_shape[1]) >
-            concurrency::ThreadPool::DegreeOfParallelism(tp) * 256) {
-          // See benchmarks in PR #7719.
-          ReduceAggregatorSum<T>::FastReduceRK(input, fast_shape, *output, tp);
-          return output;
-        } else {
-          break;
-        }
-      case FastReduceKind::kKRK:
+        ReduceAggregatorSum<T>::FastReduceRK(input, fast_shape, *output, tp);
+        return output;
+      }
+      case FastReduceKind::kKRK: {
         ValidateFastReduceKRK(fast_shape, *output);
-        if (fast_shape[0] >= std::max(2, concurrency::ThreadPool::DegreeOfParallelism(tp))) {
-          // See benchmarks in PR #7719.
-          ReduceAggregatorSum<T>::FastReduceKRK(input, fast_shape, *output, tp);
-          return output;
-        } else {
-          break;
-        }
+        ReduceAggregatorSum<T>::FastReduceKRK(input, fast_shape, *output, tp);
+        return output;
+      }
+      case FastReduceKind::kMulti: {
+        ValidateFastReduceMulti(fast_shape, fast_axes, *output);
+        ReduceAggregatorSum<T>::FastReduceMulti(input, fast_shape, fast_axes, *output, tp);
+        return output;
+      }
       case FastReduceKind::kR:
       case FastReduceKind::kK:
       case FastReduceKind::kNone:
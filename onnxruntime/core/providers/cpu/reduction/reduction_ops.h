@@ -10,6 +10,7 @@
 #include "core/framework/op_kernel.h"
 #include "core/providers/cpu/containers.h"
 #include "core/util/math.h"
+#include "core/mlas/inc/mlas.h"
 #endif
 #include "core/util/math_cpuonly.h"
 #include "core/platform/threadpool.h"
@@ -25,7 +26,8 @@ enum FastReduceKind {
   kKR = 4,     // kept dim, reduced dim
   kRK = 8,     // reduced dim, kept dim
   kKRK = 16,   // kept dim, reduced dim, kept dim
-  kEmpty = 32  // empty reduce
+  kEmpty = 32,  // empty reduce
+  kMulti = 64   // any other alternation of kept and reduced dims (RKR, KRKR, ...)
 };
 
 FastReduceKind operator|(FastReduceKind a, FastReduceKind b);
@@ -40,17 +42,19 @@ bool IsFastReduceKindAvailable(FastReduceKind scenario, FastReduceKind available
 TensorOpCost ParallelReduceFastCost(int64_t n_row, int64_t n_col, int64_t element_size, int n_ops);
 
 /**
-  This only improves reduce function when reduced axes are contiguous:
-  if len(shape) == 4, any single axis is ok, axes=(0, 1) or (1, 2) or (2, 3) is ok,
-  axes=(0, 2) is not covered by this change, former implementation prevails.
-  In that case, the shape can be compressed into three cases: 
+  Adjacent axes which are both reduced or both kept are coalesced.
+  When the reduced axes are contiguous, the shape can be compressed into three cases
   (K = axis not reduced, R = reduced axis):
 
   *  KR - reduction on the last dimensions
   *  RK - reduction on the first dimensions
   *  KRK - reduction on the middle dimensions.
-   
-  For these three configuration, the reduction may be optimized
+
+  Any other set of axes (axes=(0, 2) on a 4D tensor for example) leads to an alternation
+  of kept and reduced dimensions (kMulti) which some aggregators reduce in several passes,
+  one per group of reduced dimensions.
+
+  For these configurations, the reduction may be optimized
   with vectors operations. Method WhichFastReduce() returns which case
   case be optimized for which aggregator.
 */
@@ -145,12 +149,113 @@ inline bool reduce_isnan<int64_t>(int64_t) { return false; }
 class ReduceAggregatorBase {
  public:
   // Fast reduction: see OptimizeShapeForFastReduce's comment.
+  // Aggregators without specialized implementations use the generic ones (see GenericFastReduceKR).
   static inline FastReduceKind WhichFastReduce() { return FastReduceKind::kNone; }
   static void FastReduceKR(const Tensor&, const std::vector<int64_t>&, Tensor&, concurrency::ThreadPool*);
   static void FastReduceRK(const Tensor&, const std::vector<int64_t>&, Tensor&, concurrency::ThreadPool*);
   static void FastReduceKRK(const Tensor&, const std::vector<int64_t>&, Tensor&, concurrency::ThreadPool*);
+  static void FastReduceMulti(const Tensor&, const std::vector<int64_t>&, const std::vector<int64_t>&, Tensor&,
+                              concurrency::ThreadPool*);
+  // True if the aggregator needs a first pass over the data calling update0 (ReduceLogSumExp).
+  static inline bool two_loops() { return false; }
 };
 
+/* Reduces the float tensor `data` viewed as [d0, d1, d2] along d1 (KR if d2 == 1, RK if d0 == 1)
+   with the MLAS row or column reductions. */
+void ReduceKRKMlas(MLAS_REDUCTION_KIND kind, const float* data, float* out,
+                   int64_t d0, int64_t d1, int64_t d2, concurrency::ThreadPool* tp);
+
+/* Reduces a float tensor with any alternation of kept and reduced dimensions (kMulti) in several passes,
+   each pass reducing the innermost group of reduced dimensions of the previous result.
+   `kind` is used by the first pass, `combine_kind` by the next ones to combine the partial results. */
+void FastReduceMultiMlas(MLAS_REDUCTION_KIND kind, MLAS_REDUCTION_KIND combine_kind,
+                         const Tensor& input, const std::vector<int64_t>& fast_shape,
+                         const std::vector<int64_t>& fast_axes, Tensor& output, concurrency::ThreadPool* tp);
+
+/* Reduces `data` viewed as [d0, d1, d2] along d1 with any aggregator, based on its update methods.
+   If d2 > 1, every output element of a block of the innermost dimension gets its own aggregator
+   so that the reduced rows are read sequentially. */
+template <typename AGG>
+void ReduceKRKGeneric(const typename AGG::input_type* data, typename AGG::value_type* out,
+                      int64_t d0, int64_t d1, int64_t d2, concurrency::ThreadPool* tp) {
+  typedef typename AGG::input_type T;
+  if (d2 == 1) {
+    concurrency::ThreadPool::TryParallelFor(
+        tp, d0, ParallelReduceFastCost(1, d1, sizeof(T), 6),
+        [data, out, d1](std::ptrdiff_t first, std::ptrdiff_t last) {
+          for (std::ptrdiff_t i = first; i < last; ++i) {
+            const T* p = data + i * d1;
+            AGG agg(d1, p[0]);
+            if (AGG::two_loops()) {
+              for (int64_t j = 0; j < d1; ++j) {
+                agg.update0(p[j]);
+              }
+            }
+            for (int64_t j = 0; j < d1; ++j) {
+              agg.update(p[j]);
+            }
+            out[i] = agg.get_value();
+          }
+        });
+    return;
+  }
+
+  concurrency::ThreadPool::TryParallelFor(
+      tp, d0 * d2, ParallelReduceFastCost(1, d1, sizeof(T), 6),
+      [data, out, d1, d2](std::ptrdiff_t first, std::ptrdiff_t last) {
+        std::vector<AGG> aggs;
+        for (std::ptrdiff_t begin = first; begin < last;) {
+          const int64_t i = begin / d2;
+          const int64_t j0 = begin % d2;
+          const int64_t j1 = std::min<int64_t>(d2, j0 + (last - begin));
+          const T* p = data + i * d1 * d2;
+          aggs.clear();
+          for (int64_t j = j0; j < j1; ++j) {
+            aggs.emplace_back(d1, p[j]);
+          }
+          if (AGG::two_loops()) {
+            for (int64_t r = 0; r < d1; ++r) {
+              const T* row = p + r * d2;
+              for (int64_t j = j0; j < j1; ++j) {
+                aggs[j - j0].update0(row[j]);
+              }
+            }
+          }
+          for (int64_t r = 0; r < d1; ++r) {
+            const T* row = p + r * d2;
+            for (int64_t j = j0; j < j1; ++j) {
+              aggs[j - j0].update(row[j]);
+            }
+          }
+          for (int64_t j = j0; j < j1; ++j) {
+            out[i * d2 + j] = aggs[j - j0].get_value();
+          }
+          begin += j1 - j0;
+        }
+      });
+}
+
+template <typename AGG>
+void GenericFastReduceKR(const Tensor& input, const std::vector<int64_t>& fast_shape,
+                         Tensor& output, concurrency::ThreadPool* tp) {
+  ReduceKRKGeneric<AGG>(input.Data<typename AGG::input_type>(), output.MutableData<typename AGG::value_type>(),
+                        fast_shape[0], fast_shape[1], 1, tp);
+}
+
+template <typename AGG>
+void GenericFastReduceRK(const Tensor& input, const std::vector<int64_t>& fast_shape,
+                         Tensor& output, concurrency::ThreadPool* tp) {
+  ReduceKRKGeneric<AGG>(input.Data<typename AGG::input_type>(), output.MutableData<typename AGG::value_type>(),
+                        1, fast_shape[0], fast_shape[1], tp);
+}
+
+template <typename AGG>
+void GenericFastReduceKRK(const Tensor& input, const std::vector<int64_t>& fast_shape,
+                          Tensor& output, concurrency::ThreadPool* tp) {
+  ReduceKRKGeneric<AGG>(input.Data<typename AGG::input_type>(), output.MutableData<typename AGG::value_type>(),
+                        fast_shape[0], fast_shape[1], fast_shape[2], tp);
+}
+
 template <typename T, typename TVAL = T>
 class ReduceAggregator : public ReduceAggregatorBase {
  public:
@@ -183,11 +288,17 @@ class ReduceAggregatorSum : public ReduceAggregator<T, TVAL> {
 
   // Fast reduction
   static inline FastReduceKind WhichFastReduce() {
-    return FastReduceKind::kKR | FastReduceKind::kRK | FastReduceKind::kKRK;
+    return FastReduceKind::kKR | FastReduceKind::kRK | FastReduceKind::kKRK |
+           (std::is_same<T, float>::value ? FastReduceKind::kMulti : FastReduceKind::kNone);
   }
 
   static void FastReduceKR(const Tensor& input, const std::vector<int64_t>& fast_shape,
                            Tensor& output, concurrency::ThreadPool* tp) {
+    if constexpr (std::is_same<T, float>::value) {
+      ReduceKRKMlas(MlasSumReduction, input.Data<float>(), output.MutableData<float>(),
+                    fast_shape[0], fast_shape[1], 1, tp);
+      return;
+    }
     const T* data = input.Data<T>();
     T* out = output.MutableData<T>();
     int64_t stridei = fast_shape[1];
@@ -202,6 +313,11 @@ class ReduceAggregatorSum : public ReduceAggregator<T, TVAL> {
 
   static void FastReduceRK(const Tensor& input, const std::vector<int64_t>& fast_shape,
                            Tensor& output, concurrency::ThreadPool* tp) {
+    if constexpr (std::is_same<T, float>::value) {
+      ReduceKRKMlas(MlasSumReduction, input.Data<float>(), output.MutableData<float>(),
+                    1, fast_shape[0], fast_shape[1], tp);
+      return;
+    }
     int64_t N = fast_shape[1];
     const T* data = input.Data<T>();
     T* out = output.MutableData<T>();
@@ -220,19 +336,21 @@ class ReduceAggregatorSum : public ReduceAggregator<T, TVAL> {
 
   static void FastReduceKRK(const Tensor& input, const std::vector<int64_t>& fast_shape,
                             Tensor& output, concurrency::ThreadPool* tp) {
-    int64_t N = fast_shape[2];
-    const T* data = input.Data<T>();
-    int64_t stridei = fast_shape[1] * fast_shape[2];
-    int64_t strideo = fast_shape[2];
-    T* out = output.MutableData<T>();
-    std::vector<T> one(fast_shape[1], 1);
-    concurrency::ThreadPool::TryParallelFor(
-        tp, fast_shape[0], ParallelReduceFastCost(fast_shape[1], fast_shape[2], sizeof(T), 6),
-        [one, data, fast_shape, stridei, strideo, out, N](ptrdiff_t begin, ptrdiff_t last) {
-          for (ptrdiff_t d = begin; d < last; ++d) {
-            math::MatMul<T>(1, N, fast_shape[1], one.data(), data + stridei * d, out + strideo * d, nullptr);
-          }
-        });
+    if constexpr (std::is_same<T, float>::value) {
+      ReduceKRKMlas(MlasSumReduction, input.Data<float>(), output.MutableData<float>(),
+                    fast_shape[0], fast_shape[1], fast_shape[2], tp);
+    } else {
+      GenericFastReduceKRK<ReduceAggregatorSum<T, TVAL>>(input, fast_shape, output, tp);
+    }
+  }
+
+  static void FastReduceMulti(const Tensor& input, const std::vector<int64_t>& fast_shape,
+                              const std::vector<int64_t>& fast_axes, Tensor& output, concurrency::ThreadPool* tp) {
+    if constexpr (std::is_same<T, float>::value) {
+      FastReduceMultiMlas(MlasSumReduction, MlasSumReduction, input, fast_shape, fast_axes, output, tp);
+    } else {
+      ReduceAggregatorBase::FastReduceMulti(input, fast_shape, fast_axes, output, tp);
+    }
   }
 };
 
@@ -244,6 +362,52 @@ class ReduceAggregatorSumSquare : public ReduceAggregator<T, TVAL> {
     return Eigen::Map<const Eigen::Matrix<T, Eigen::Dynamic, 1>>(from_data, this->N_).squaredNorm();
   }
   inline void update(const T& v) { this->accumulator_ += v * v; }
+
+  // Fast reduction
+  static inline FastReduceKind WhichFastReduce() {
+    return FastReduceKind::kKR | FastReduceKind::kRK | FastReduceKind::kKRK |
+           (std::is_same<T, float>::value ? FastReduceKind::kMulti : FastReduceKind::kNone);
+  }
+
+  static void FastReduceKR(const Tensor& input, const std::vector<int64_t>& fast_shape,
+                           Tensor& output, concurrency::ThreadPool* tp) {
+    if constexpr (std::is_same<T, float>::value) {
+      ReduceKRKMlas(MlasSumSquareReduction, input.Data<float>(), output.MutableData<float>(),
+                    fast_shape[0], fast_shape[1], 1, tp);
+    } else {
+      GenericFastReduceKR<ReduceAggregatorSumSquare<T, TVAL>>(input, fast_shape, output, tp);
+    }
+  }
+
+  static void FastReduceRK(const Tensor& input, const std::vector<int64_t>& fast_shape,
+                           Tensor& output, concurrency::ThreadPool* tp) {
+    if constexpr (std::is_same<T, float>::value) {
+      ReduceKRKMlas(MlasSumSquareReduction, input.Data<float>(), output.MutableData<float>(),
+                    1, fast_shape[0], fast_shape[1], tp);
+    } else {
+      GenericFastReduceRK<ReduceAggregatorSumSquare<T, TVAL>>(input, fast_shape, output, tp);
+    }
+  }
+
+  static void FastReduceKRK(const Tensor& input, const std::vector<int64_t>& fast_shape,
+                            Tensor& output, concurrency::ThreadPool* tp) {
+    if constexpr (std::is_same<T, float>::value) {
+      ReduceKRKMlas(MlasSumSquareReduction, input.Data<float>(), output.MutableData<float>(),
+                    fast_shape[0], fast_shape[1], fast_shape[2], tp);
+    } else {
+      GenericFastReduceKRK<ReduceAggregatorSumSquare<T, TVAL>>(input, fast_shape, output, tp);
+    }
+  }
+
+  static void FastReduceMulti(const Tensor& input, const std::vector<int64_t>& fast_shape,
+                              const std::vector<int64_t>& fast_axes, Tensor& output, concurrency::ThreadPool* tp) {
+    if constexpr (std::is_same<T, float>::value) {
+      // The partial sums of squares are summed.
+      FastReduceMultiMlas(MlasSumSquareReduction, MlasSumReduction, input, fast_shape, fast_axes, output, tp);
+    } else {
+      ReduceAggregatorBase::FastReduceMulti(input, fast_shape, fast_axes, output, tp);
+    }
+  }
 };
 
 template <typename T, typename TVAL = T>
@@ -260,8 +424,12 @@ class ReduceAggregatorMean : public ReduceAggregatorSum<T, TVAL> {
 
   static void FastReduceKR(const Tensor& input, const std::vector<int64_t>& fast_shape,
                            Tensor& output, concurrency::ThreadPool* tp) {
+    if constexpr (std::is_same<T, float>::value) {
+      ReduceKRKMlas(MlasMeanReduction, input.Data<float>(), output.MutableData<float>(),
+                    fast_shape[0], fast_shape[1], 1, tp);
+      return;
+    }
     ReduceAggregatorSum<T, TVAL>::FastReduceKR(input, fast_shape, output, tp);
-    // TODO: use MLAS or BLAS
     T* out = output.MutableData<T>();
     T* end = out + fast_shape[0];
     for (; out != end; ++out) {
@@ -271,8 +439,12 @@ class ReduceAggregatorMean : public ReduceAggregatorSum<T, TVAL> {
 
   static void FastReduceRK(const Tensor& input, const std::vector<int64_t>& fast_shape,
                            Tensor& output, concurrency::ThreadPool* tp) {
+    if constexpr (std::is_same<T, float>::value) {
+      ReduceKRKMlas(MlasMeanReduction, input.Data<float>(), output.MutableData<float>(),
+                    1, fast_shape[0], fast_shape[1], tp);
+      return;
+    }
     ReduceAggregatorSum<T, TVAL>::FastReduceRK(input, fast_shape, output, tp);
-    // TODO: use MLAS or BLAS
     T* out = output.MutableData<T>();
     T* end = out + fast_shape[1];
     for (; out != end; ++out) {
@@ -282,6 +454,11 @@ class ReduceAggregatorMean : public ReduceAggregatorSum<T, TVAL> {
 
   static void FastReduceKRK(const Tensor& input, const std::vector<int64_t>& fast_shape,
                             Tensor& output, concurrency::ThreadPool* tp) {
+    if constexpr (std::is_same<T, float>::value) {
+      ReduceKRKMlas(MlasMeanReduction, input.Data<float>(), output.MutableData<float>(),
+                    fast_shape[0], fast_shape[1], fast_shape[2], tp);
+      return;
+    }
     ReduceAggregatorSum<T, TVAL>::FastReduceKRK(input, fast_shape, output, tp);
     int64_t strideo = fast_shape[2];
     T* out = output.MutableData<T>();
@@ -296,6 +473,16 @@ class ReduceAggregatorMean : public ReduceAggregatorSum<T, TVAL> {
       }
     }
   }
+
+  static void FastReduceMulti(const Tensor& input, const std::vector<int64_t>& fast_shape,
+                              const std::vector<int64_t>& fast_axes, Tensor& output, concurrency::ThreadPool* tp) {
+    if constexpr (std::is_same<T, float>::value) {
+      // Every pass averages groups of the same size so the mean of the partial means is the mean.
+      FastReduceMultiMlas(MlasMeanReduction, MlasMeanReduction, input, fast_shape, fast_axes, output, tp);
+    } else {
+      ReduceAggregatorBase::FastReduceMulti(input, fast_shape, fast_axes, output, tp);
+    }
+  }
 };
 
 template <typename T, typename TVAL = T>
@@ -309,11 +496,17 @@ class ReduceAggregatorMax : public ReduceAggregator<T, TVAL> {
 
   // Fast reduction
   static inline FastReduceKind WhichFastReduce() {
-    return FastReduceKind::kKR | FastReduceKind::kRK | FastReduceKind::kKRK;
+    return FastReduceKind::kKR | FastReduceKind::kRK | FastReduceKind::kKRK |
+           (std::is_same<T, float>::value ? FastReduceKind::kMulti : FastReduceKind::kNone);
   }
 
   static void FastReduceKR(const Tensor& input, const std::vector<int64_t>& fast_shape,
                            Tensor& output, concurrency::ThreadPool* tp) {
+    if constexpr (std::is_same<T, float>::value) {
+      ReduceKRKMlas(MlasMaximumReduction, input.Data<float>(), output.MutableData<float>(),
+                    fast_shape[0], fast_shape[1], 1, tp);
+      return;
+    }
     const T* data = input.Data<T>();
     T* out = output.MutableData<T>();
     int64_t stridei = fast_shape[1];
@@ -329,6 +522,11 @@ class ReduceAggregatorMax : public ReduceAggregator<T, TVAL> {
 
   static void FastReduceRK(const Tensor& input, const std::vector<int64_t>& fast_shape,
                            Tensor& output, concurrency::ThreadPool* tp) {
+    if constexpr (std::is_same<T, float>::value) {
+      ReduceKRKMlas(MlasMaximumReduction, input.Data<float>(), output.MutableData<float>(),
+                    1, fast_shape[0], fast_shape[1], tp);
+      return;
+    }
     int64_t n_rows = fast_shape[0];
     int64_t N = fast_shape[1];
     const T* data = input.Data<T>();
@@ -350,21 +548,21 @@ class ReduceAggregatorMax : public ReduceAggregator<T, TVAL> {
 
   static void FastReduceKRK(const Tensor& input, const std::vector<int64_t>& fast_shape,
                             Tensor& output, concurrency::ThreadPool* tp) {
-    const T* data = input.Data<T>();
-    T* out = output.MutableData<T>();
-    int64_t stridei = fast_shape[1] * fast_shape[2];
-    int64_t strideo = fast_shape[2];
-    concurrency::ThreadPool::TryParallelFor(
-        tp, fast_shape[0], ParallelReduceFastCost(fast_shape[1], fast_shape[2], sizeof(T), 6),
-        [data, fast_shape, stridei, strideo, out](ptrdiff_t begin, ptrdiff_t end) {
-          for (ptrdiff_t j = begin; j < end; ++j) {
-            EigenVectorMap<T>(out + j * strideo, strideo) =
-                ConstEigenMatrixMap<T>(
-                    data + j * stridei, fast_shape[2], fast_shape[1])
-                    .rowwise()
-                    .maxCoeff();
-          }
-        });
+    if constexpr (std::is_same<T, float>::value) {
+      ReduceKRKMlas(MlasMaximumReduction, input.Data<float>(), output.MutableData<float>(),
+                    fast_shape[0], fast_shape[1], fast_shape[2], tp);
+    } else {
+      GenericFastReduceKRK<ReduceAggregatorMax<T, TVAL>>(input, fast_shape, output, tp);
+    }
+  }
+
+  static void FastReduceMulti(const Tensor& input, const std::vector<int64_t>& fast_shape,
+                              const std::vector<int64_t>& fast_axes, Tensor& output, concurrency::ThreadPool* tp) {
+    if constexpr (std::is_same<T, float>::value) {
+      FastReduceMultiMlas(MlasMaximumReduction, MlasMaximumReduction, input, fast_shape, fast_axes, output, tp);
+    } else {
+      ReduceAggregatorBase::FastReduceMulti(input, fast_shape, fast_axes, output, tp);
+    }
   }
 };
 
@@ -468,11 +666,17 @@ class ReduceAggregatorMin : public ReduceAggregator<T, TVAL> {
 
   // Fast reduction
   static inline FastReduceKind WhichFastReduce() {
-    return FastReduceKind::kKR | FastReduceKind::kRK | FastReduceKind::kKRK;
+    return FastReduceKind::kKR | FastReduceKind::kRK | FastReduceKind::kKRK |
+           (std::is_same<T, float>::value ? FastReduceKind::kMulti : FastReduceKind::kNone);
   }
 
   static void FastReduceKR(const Tensor& input, const std::vector<int64_t>& fast_shape,
                            Tensor& output, concurrency::ThreadPool* tp) {
+    if constexpr (std::is_same<T, float>::value) {
+      ReduceKRKMlas(MlasMinimumReduction, input.Data<float>(), output.MutableData<float>(),
+                    fast_shape[0], fast_shape[1], 1, tp);
+      return;
+    }
     const T* data = input.Data<T>();
     T* out = output.MutableData<T>();
     int64_t stridei = fast_shape[1];
@@ -488,6 +692,11 @@ class ReduceAggregatorMin : public ReduceAggregator<T, TVAL> {
 
   static void FastReduceRK(const Tensor& input, const std::vector<int64_t>& fast_shape,
                            Tensor& output, concurrency::ThreadPool* tp) {
+    if constexpr (std::is_same<T, float>::value) {
+      ReduceKRKMlas(MlasMinimumReduction, input.Data<float>(), output.MutableData<float>(),
+                    1, fast_shape[0], fast_shape[1], tp);
+      return;
+    }
     int64_t n_rows = fast_shape[0];
     int64_t N = fast_shape[1];
     const T* data = input.Data<T>();
@@ -509,21 +718,21 @@ class ReduceAggregatorMin : public ReduceAggregator<T, TVAL> {
 
   static void FastReduceKRK(const Tensor& input, const std::vector<int64_t>& fast_shape,
                             Tensor& output, concurrency::ThreadPool* tp) {
-    const T* data = input.Data<T>();
-    T* out = output.MutableData<T>();
-    int64_t stridei = fast_shape[1] * fast_shape[2];
-    int64_t strideo = fast_shape[2];
-    concurrency::ThreadPool::TryParallelFor(
-        tp, fast_shape[0], ParallelReduceFastCost(fast_shape[1], fast_shape[2], sizeof(T), 6),
-        [data, fast_shape, stridei, strideo, out](ptrdiff_t begin, ptrdiff_t end) {
-          for (ptrdiff_t j = begin; j < end; ++j) {
-            EigenVectorMap<T>(out + j * strideo, strideo) =
-                ConstEigenMatrixMap<T>(
-                    data + j * stridei, fast_shape[2], fast_shape[1])
-                    .rowwise()
-                    .minCoeff();
-          }
-        });
+    if constexpr (std::is_same<T, float>::value) {
+      ReduceKRKMlas(MlasMinimumReduction, input.Data<float>(), output.MutableData<float>(),
+                    fast_shape[0], fast_shape[1], fast_shape[2], tp);
+    } else {
+      GenericFastReduceKRK<ReduceAggregatorMin<T, TVAL>>(input, fast_shape, output, tp);
+    }
+  }
+
+  static void FastReduceMulti(const Tensor& input, const std::vector<int64_t>& fast_shape,
+                              const std::vector<int64_t>& fast_axes, Tensor& output, concurrency::ThreadPool* tp) {
+    if constexpr (std::is_same<T, float>::value) {
+      FastReduceMultiMlas(MlasMinimumReduction, MlasMinimumReduction, input, fast_shape, fast_axes, output, tp);
+    } else {
+      ReduceAggregatorBase::FastReduceMulti(input, fast_shape, fast_axes, output, tp);
+    }
   }
 };
 
@@ -590,6 +799,53 @@ class ReduceAggregatorLogSumExp : public ReduceAggregator<T, TVAL> {
   }
   inline void update(const T& v) { this->accumulator_ += reduce_exp(v - max_); }
   inline TVAL get_value() { return reduce_log<T>(this->accumulator_) + max_; }
+  // Fast reduction
+  static inline bool two_loops() { return true; }
+
+  static inline FastReduceKind WhichFastReduce() {
+    return FastReduceKind::kKR | FastReduceKind::kRK | FastReduceKind::kKRK |
+           (std::is_same<T, float>::value ? FastReduceKind::kMulti : FastReduceKind::kNone);
+  }
+
+  static void FastReduceKR(const Tensor& input, const std::vector<int64_t>& fast_shape,
+                           Tensor& output, concurrency::ThreadPool* tp) {
+    if constexpr (std::is_same<T, float>::value) {
+      ReduceKRKMlas(MlasLogSumExpReduction, input.Data<float>(), output.MutableData<float>(),
+                    fast_shape[0], fast_shape[1], 1, tp);
+    } else {
+      GenericFastReduceKR<ReduceAggregatorLogSumExp<T, TVAL>>(input, fast_shape, output, tp);
+    }
+  }
+
+  static void FastReduceRK(const Tensor& input, const std::vector<int64_t>& fast_shape,
+                           Tensor& output, concurrency::ThreadPool* tp) {
+    if constexpr (std::is_same<T, float>::value) {
+      ReduceKRKMlas(MlasLogSumExpReduction, input.Data<float>(), output.MutableData<float>(),
+                    1, fast_shape[0], fast_shape[1], tp);
+    } else {
+      GenericFastReduceRK<ReduceAggregatorLogSumExp<T, TVAL>>(input, fast_shape, output, tp);
+    }
+  }
+
+  static void FastReduceKRK(const Tensor& input, const std::vector<int64_t>& fast_shape,
+                            Tensor& output, concurrency::ThreadPool* tp) {
+    if constexpr (std::is_same<T, float>::value) {
+      ReduceKRKMlas(MlasLogSumExpReduction, input.Data<float>(), output.MutableData<float>(),
+                    fast_shape[0], fast_shape[1], fast_shape[2], tp);
+    } else {
+      GenericFastReduceKRK<ReduceAggregatorLogSumExp<T, TVAL>>(input, fast_shape, output, tp);
+    }
+  }
+
+  static void FastReduceMulti(const Tensor& input, const std::vector<int64_t>& fast_shape,
+                              const std::vector<int64_t>& fast_axes, Tensor& output, concurrency::ThreadPool* tp) {
+    if constexpr (std::is_same<T, float>::value) {
+      // The log-sum-exp of the partial log-sum-exps is the log-sum-exp.
+      FastReduceMultiMlas(MlasLogSumExpReduction, MlasLogSumExpReduction, input, fast_shape, fast_axes, output, tp);
+    } else {
+      ReduceAggregatorBase::FastReduceMulti(input, fast_shape, fast_axes, output, tp);
+    }
+  }
 };
 
 void NoTransposePrepareForReduce(const TensorShape& new_input_shape,
@@ -174,7 +174,27 @@ using namespace rnn::detail;
 
 // LSTM details
 
-Status DeepCpuLstmOp::TryPackWeights(const Tensor& weights, PackedWeights& packed_weights, bool& is_packed, AllocatorPtr& alloc) {
+// Pack R[iofc] for one direction as a sequence of independent packed B matrices. Tile t contains the rows for the
+// i, o, f and c gates of hidden units [t * tile_size, (t + 1) * tile_size) so the recurrent GEMM for a range of
+// hidden units produces all the inputs the gate computations for that range need.
+static void PackRecurrentWeightTiles(const float* weights_data, size_t hidden_size, size_t tile_size,
+                                     size_t packed_tile_size, uint8_t* packed_data) {
+  std::vector<float> tile_rows(4 * tile_size * hidden_size);
+
+  for (size_t start = 0; start < hidden_size; start += tile_size) {
+    const size_t count = std::min(tile_size, hidden_size - start);
+    for (size_t gate = 0; gate < 4; ++gate) {
+      std::copy_n(weights_data + (gate * hidden_size + start) * hidden_size, count * hidden_size,
+                  tile_rows.data() + gate * count * hidden_size);
+    }
+
+    MlasGemmPackB(CblasTrans, 4 * count, hidden_size, tile_rows.data(), hidden_size, packed_data);
+    packed_data += packed_tile_size;
+  }
+}
+
+Status DeepCpuLstmOp::TryPackWeights(const Tensor& weights, PackedWeights& packed_weights, bool& is_packed,
+                                     AllocatorPtr& alloc, size_t hidden_tile_size) {
   const auto& shape = weights.Shape();
   if (shape.NumDimensions() != 3) {
     return Status::OK();
@@ -189,11 +209,20 @@ Status DeepCpuLstmOp::TryPackWeights(const Tensor& weights, PackedWeights& packe
     return Status::OK();
   }
 
-  const size_t packed_weights_size = MlasGemmPackBSize(N, K);
-  if (packed_weights_size == 0) {
+  // the tiled layout needs the [hidden_size, hidden_size] blocks of the recurrence weights
+  const size_t hidden_size = static_cast<size_t>(hidden_size_);
+  if (K != hidden_size) {
+    hidden_tile_size = 0;
+  }
+
+  hidden_tile_size = std::min(hidden_tile_size, hidden_size);
+  const size_t num_tiles = hidden_tile_size != 0 ? (hidden_size + hidden_tile_size - 1) / hidden_tile_size : 1;
+  const size_t packed_tile_size = MlasGemmPackBSize(hidden_tile_size != 0 ? 4 * hidden_tile_size : N, K);
+  if (packed_tile_size == 0) {
     return Status::OK();
   }
 
+  const size_t packed_weights_size = SafeInt<size_t>(packed_tile_size) * num_tiles;
   size_t packed_weights_data_size = SafeInt<size_t>(packed_weights_size) * num_directions_;
   auto* packed_weights_data = alloc->Alloc(packed_weights_data_size);
 
@@ -206,10 +235,17 @@ Status DeepCpuLstmOp::TryPackWeights(const Tensor& weights, PackedWeights& packe
   packed_weights.buffer_size_ = packed_weights_data_size;
   packed_weights.weights_size_ = packed_weights_size;
   packed_weights.shape_ = shape;
+  packed_weights.hidden_tile_size_ = hidden_tile_size;
 
   const auto* weights_data = weights.Data<float>();
   for (int i = 0; i < num_directions_; i++) {
-    MlasGemmPackB(CblasTrans, N, K, weights_data, K, packed_weights_data);
+    if (hidden_tile_size != 0) {
+      PackRecurrentWeightTiles(weights_data, hidden_size, hidden_tile_size, packed_tile_size,
+                               static_cast<uint8_t*>(packed_weights_data));
+    } else {
+      MlasGemmPackB(CblasTrans, N, K, weights_data, K, packed_weights_data);
+    }
+
     packed_weights_data = static_cast<uint8_t*>(packed_weights_data) + packed_weights_size;
     weights_data += N * K;
   }
@@ -238,7 +274,7 @@ Status DeepCpuLstmOp::PrePack(const Tensor& tensor, int input_idx,
         prepacked_weights->buffer_sizes_.push_back(packed_W_.buffer_size_);
       }
     } else if (input_idx == 2) {
-      ORT_RETURN_IF_ERROR(TryPackWeights(tensor, packed_R_, is_packed, alloc));
+      ORT_RETURN_IF_ERROR(TryPackWeights(tensor, packed_R_, is_packed, alloc, kRecurrentWeightsTileSize));
 
       bool share_prepacked_weights = (prepacked_weights != nullptr);
       if (is_packed && share_prepacked_weights) {
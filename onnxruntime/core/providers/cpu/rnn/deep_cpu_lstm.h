@@ -32,13 +32,17 @@ class DeepCpuLstmOp final : public OpKernel, public LSTMBase {
 
  private:
   Status TryPackWeights(const Tensor& weights, rnn::detail::PackedWeights& packed_weights,
-                        bool& is_packed, AllocatorPtr& alloc);
+                        bool& is_packed, AllocatorPtr& alloc, size_t hidden_tile_size = 0);
 
   template <typename T>
   Status ComputeImpl(OpKernelContext& context) const;
 
   rnn::detail::PackedWeights packed_W_;
   rnn::detail::PackedWeights packed_R_;
+
+  // number of hidden units per tile when packing R[iofc]. each step of the LSTM runs the recurrent GEMM and the
+  // gate computations one tile at a time so the GEMM output is consumed while it is still in cache.
+  static constexpr size_t kRecurrentWeightsTileSize = 16;
 };
 
 }  // namespace onnxruntime
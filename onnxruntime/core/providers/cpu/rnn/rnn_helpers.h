@@ -166,6 +166,9 @@ struct PackedWeights {
   size_t buffer_size_;
   size_t weights_size_;
   TensorShape shape_;
+  // if non-zero the weights were packed as independent tiles of this many hidden units, with the rows of all
+  // four gates for the tile packed together. see DeepCpuLstmOp::PrePack.
+  size_t hidden_tile_size_{0};
 };
 
 struct QuantizationParameter {
@@ -205,14 +208,17 @@ struct GemmWeights {
     if (packed_weights.buffer_) {
       is_prepacked_ = true;
       buffer_ = static_cast<uint8_t*>(packed_weights.buffer_.get()) + packed_weights.weights_size_ * idx;
+      hidden_tile_size_ = packed_weights.hidden_tile_size_;
     } else {
       is_prepacked_ = false;
       buffer_ = weights_data + weights_size * idx;
+      hidden_tile_size_ = 0;
     }
   }
 
   bool is_prepacked_{false};
   const void* buffer_{nullptr};
+  size_t hidden_tile_size_{0};
   QuantizationParameter* quant_para_{nullptr};
 };
 
@@ -261,7 +267,7 @@ const T* SafeRawConstPointer(typename gsl::span<T>::const_iterator cur,
 template <typename T>
 const T* SafeRawConstPointer(gsl::span<T> span, size_t offset, size_t size) {
   ORT_ENFORCE(offset + size <= size_t(span.size()));
-  return span.data();
+  return span.data() + offset;
 }
 
 // helper to convert a span to a raw pointer
@@ -273,6 +273,23 @@ void UniDirectionalLstm<T>::Compute(const gsl::span<const T>& inputs_arg,
 
   AllocateQuantizeBuffers<WeightT>(max_sequence_length);
 
+  // When R[iofc] was packed in tiles of hidden units (see DeepCpuLstmOp::PrePack) each step runs the recurrent GEMM
+  // for one tile and then immediately evaluates the gates for the same hidden units, instead of finishing the whole
+  // GEMM before starting on the gates. Tiles are independent so they are also the unit of parallelism within a step.
+  const int hidden_tile_size = std::is_same<WeightT, float>::value && recurrent_weights.is_prepacked_
+                                   ? static_cast<int>(std::min<size_t>(recurrent_weights.hidden_tile_size_, hidden_size_))
+                                   : 0;
+  const bool tiled_step = hidden_tile_size > 0;
+  const int num_tiles = tiled_step ? (hidden_size_ + hidden_tile_size - 1) / hidden_tile_size : 0;
+  const size_t packed_tile_size = tiled_step ? MlasGemmPackBSize(4 * hidden_tile_size, hidden_size_) : 0;
+  if (tiled_step) {
+    recurrent_tiles_ = Allocate(allocator_, batch_size_ * hidden_size_x4, recurrent_tiles_ptr_);
+  }
+
+  // A tile writes its part of Ht while other tiles may still be reading Ht-1. If the outputs of each step are not
+  // kept, alternate between final_hidden_state and batched_hidden0_ so Ht-1 is never overwritten during a step.
+  const bool alternate_hidden_state = tiled_step && !output_sequence;
+
   // apply the weights to all the inputs and save to output_IOFC
   ComputeGemm(total_rows, hidden_size_x4, input_size_, alpha, inputs.cbegin(), inputs.cend(),
               input_weights,
@@ -323,19 +340,7 @@ void UniDirectionalLstm<T>::Compute(const gsl::span<const T>& inputs_arg,
 #endif
 
       span_T_iter step_out_IOFC = output_iofc_.begin() + (step * batch_size_ + seq_start) * hidden_size_x4;
-
-      // calculate Xt*(W[iofc]^T) + Ht-t*R[iofc]
-      // Do it sequentially to avoid nested parallelism
-      ComputeGemm(num_seq_to_compute_adjusted, hidden_size_x4, hidden_size_, alpha,
-                  previous_state, previous_state_end,       // Ht-1
-                  recurrent_weights,                        // R[iofc]
-                  beta, step_out_IOFC, output_iofc_.end(),  // input contains Xt*(W[iofc]^T)
-                  hidden_size_x4,
-                  quantized_input_or_a_.begin() + (seq_start * hidden_size_),
-                  quantized_C_buffer_.begin() + (seq_start * hidden_size_x4),
-                  ttp);
-
-      DumpMatrix("Xt*(W[iofc]^T) + Ht-t*R[iofc]" + row_str, &*step_out_IOFC, num_seq_to_compute_adjusted, hidden_size_x4);
+      span_T_iter step_out_IOFC_end = step_out_IOFC + num_seq_to_compute_adjusted * hidden_size_x4;
 
       span_T_iter batched_output;
       span_T_iter batched_output_end;
@@ -343,15 +348,71 @@ void UniDirectionalLstm<T>::Compute(const gsl::span<const T>& inputs_arg,
         batched_output = outputs.begin() + step * output_step_length;
         batched_output_end = outputs.end();
 
+      } else if (alternate_hidden_state && (step % 2) != 0) {
+        batched_output = batched_hidden0_.begin();
+        batched_output_end = batched_hidden0_.end();
       } else {
         batched_output = final_hidden_state.begin();
         batched_output_end = final_hidden_state.end();
       }
 
-      span_T_iter step_out_IOFC_end = step_out_IOFC + num_seq_to_compute_adjusted * hidden_size_x4;
-      GateComputations(step_out_IOFC, step_out_IOFC_end, c_prev, C_prev_end, c_prev_clipped, C_prev_clipped_end,
-                       batched_output, batched_output_end, sequence_lengths, min_sequence_length, step, seq_start,
-                       num_seq_to_compute_adjusted, output_sequence);
+      if (tiled_step) {
+        const float* H_prev = SafeRawConstPointer<T>(previous_state, previous_state_end,
+                                                     num_seq_to_compute_adjusted * hidden_size_);
+        float* recurrent_tiles = SafeRawPointer<T>(recurrent_tiles_, seq_start * hidden_size_x4,
+                                                   num_seq_to_compute_adjusted * hidden_size_x4);
+
+        auto compute_tile = [&](std::ptrdiff_t tile) {
+          const int col = static_cast<int>(tile) * hidden_tile_size;
+          const int num_cols = std::min(hidden_tile_size, hidden_size_ - col);
+          const int tile_x4 = 4 * num_cols;
+
+          // Ht-1*R[iofc] for the tile, with the output ordered as [row][gate][hidden unit in tile]
+          float* tile_out = recurrent_tiles + num_seq_to_compute_adjusted * 4 * col;
+          MlasGemm(CblasNoTrans, num_seq_to_compute_adjusted, tile_x4, hidden_size_, alpha,
+                   H_prev, hidden_size_,
+                   static_cast<const uint8_t*>(recurrent_weights.buffer_) + tile * packed_tile_size, 0.0f,
+                   tile_out, tile_x4, nullptr);
+
+          // add to Xt*(W[iofc]^T)
+          for (int r = 0; r < num_seq_to_compute_adjusted; ++r) {
+            float* out_row = &*(step_out_IOFC + r * hidden_size_x4) + col;
+            for (int gate = 0; gate < 4; ++gate) {
+              deepcpu::add_bias_into(tile_out + (r * 4 + gate) * num_cols, out_row + gate * hidden_size_, num_cols);
+            }
+          }
+
+          GateComputations(step_out_IOFC, step_out_IOFC_end, c_prev, C_prev_end, c_prev_clipped, C_prev_clipped_end,
+                           batched_output, batched_output_end, sequence_lengths, min_sequence_length, step, seq_start,
+                           num_seq_to_compute_adjusted, output_sequence, col, num_cols);
+        };
+
+        const double tile_cost = static_cast<double>(num_seq_to_compute_adjusted) * hidden_tile_size *
+                                 (4.0 * hidden_size_ + 32.0);
+        concurrency::ThreadPool::TryParallelFor(ttp, num_tiles, tile_cost,
+                                                [&compute_tile](std::ptrdiff_t first, std::ptrdiff_t last) {
+                                                  for (std::ptrdiff_t tile = first; tile < last; ++tile) {
+                                                    compute_tile(tile);
+                                                  }
+                                                });
+      } else {
+        // calculate Xt*(W[iofc]^T) + Ht-t*R[iofc]
+        // Do it sequentially to avoid nested parallelism
+        ComputeGemm(num_seq_to_compute_adjusted, hidden_size_x4, hidden_size_, alpha,
+                    previous_state, previous_state_end,       // Ht-1
+                    recurrent_weights,                        // R[iofc]
+                    beta, step_out_IOFC, output_iofc_.end(),  // input contains Xt*(W[iofc]^T)
+                    hidden_size_x4,
+                    quantized_input_or_a_.begin() + (seq_start * hidden_size_),
+                    quantized_C_buffer_.begin() + (seq_start * hidden_size_x4),
+                    ttp);
+
+        DumpMatrix("Xt*(W[iofc]^T) + Ht-t*R[iofc]" + row_str, &*step_out_IOFC, num_seq_to_compute_adjusted, hidden_size_x4);
+
+        GateComputations(step_out_IOFC, step_out_IOFC_end, c_prev, C_prev_end, c_prev_clipped, C_prev_clipped_end,
+                         batched_output, batched_output_end, sequence_lengths, min_sequence_length, step, seq_start,
+                         num_seq_to_compute_adjusted, output_sequence, 0, hidden_size_);
+      }
 
       // copy last row to final_cell_state
       for (int lrow = seq_start; lrow < seq_start + num_seq_to_compute_adjusted; ++lrow) {
@@ -400,6 +461,10 @@ void UniDirectionalLstm<T>::Compute(const gsl::span<const T>& inputs_arg,
       auto src = outputs.subspan((seq_len - 1) * output_step_length + i * hidden_size_, hidden_size_);
       auto dest = final_hidden_state.subspan(i * hidden_size_, hidden_size_);
       gsl::copy(src, dest);
+    } else if (alternate_hidden_state && ((seq_len - 1) % 2) != 0) {  // last step wrote to batched_hidden0_
+      auto src = batched_hidden0_.subspan(i * hidden_size_, hidden_size_);
+      auto dest = final_hidden_state.subspan(i * hidden_size_, hidden_size_);
+      gsl::copy(src, dest);
     }
   }
 
@@ -424,22 +489,25 @@ void UniDirectionalLstm<T>::Compute(const gsl::span<const T>& inputs_arg,
 
 // #define PREVIOUS_BROKEN_VERSION
 
-// This function can't use session thread pool
+// This function can't use session thread pool.
+// Only the hidden units [col, col + num_cols) of each row are computed so the gates of a tile of hidden units can be
+// evaluated as soon as the recurrent GEMM for the tile is done.
 template <typename T>
 void UniDirectionalLstm<T>::GateComputations(
     span_T_iter& out, span_T_iter& out_end, span_T_iter& C_prev,
     const span_T_iter& C_prev_end,  // Ct-1 value not 'ct'. using 'C' for clarity
     span_T_iter& C_prev_clipped, const span_T_iter& C_prev_clipped_end, span_T_iter& batched_output,
     span_T_iter& batched_output_end, const gsl::span<const int>& seq_lengths, const int min_sequence_length,
-    const int step, const int row, const int local_fused_hidden_rows, bool output_sequence) {
+    const int step, const int row, const int local_fused_hidden_rows, bool output_sequence,
+    const int col, const int num_cols) {
   int hidden_size_x4 = 4 * hidden_size_;
 
   // Activation gates.
   for (int b = 0; b < local_fused_hidden_rows; b++) {
     if (step >= min_sequence_length && step >= seq_lengths[row + b]) {
       if (output_sequence) {
-        auto fill_output = batched_output + (row + b) * hidden_size_;
-        std::fill(fill_output, fill_output + hidden_size_, T{});
+        auto fill_output = batched_output + (row + b) * hidden_size_ + col;
+        std::fill(fill_output, fill_output + num_cols, T{});
       }
 
       continue;
@@ -448,7 +516,7 @@ void UniDirectionalLstm<T>::GateComputations(
     // std::string row_str = " row[" + std::to_string(row + b) + "]";
 
     // check that we have hidden_size_x4 left starting at cur_out + b * hidden_size_x4, and get a raw pointer to that
-    float* pi = SafeRawPointer<T>(out + b * hidden_size_x4, out_end, hidden_size_x4);
+    float* pi = SafeRawPointer<T>(out + b * hidden_size_x4, out_end, hidden_size_x4) + col;
     float* po = pi + hidden_size_;
     float* pf = po + hidden_size_;
     float* pc = pf + hidden_size_;
@@ -456,42 +524,42 @@ void UniDirectionalLstm<T>::GateComputations(
 #ifdef PREVIOUS_BROKEN_VERSION
     float* pCprev_hidden_size = SafeRawPointer<T>(C_prev, C_prev_end, hidden_size_);
 #else
-    float* pCprev_hidden_size = SafeRawPointer<T>(C_prev + b * hidden_size_, C_prev_end, hidden_size_);
+    float* pCprev_hidden_size = SafeRawPointer<T>(C_prev + b * hidden_size_ + col, C_prev_end, num_cols);
 #endif
 
     // DumpMatrix("C_prev" + row_str, pCprev_hidden_size, 1, hidden_size_);
 
     // Input Gate
     if (use_peepholes_) {
-      deepcpu::elementwise_product(pCprev_hidden_size, SafeRawConstPointer<const T>(peephole_i_, 0, hidden_size_), pi,
-                                   hidden_size_);
+      deepcpu::elementwise_product(pCprev_hidden_size, SafeRawConstPointer<const T>(peephole_i_, col, num_cols), pi,
+                                   num_cols);
     }
 
-    const float* pBi = use_bias_ ? SafeRawConstPointer<T>(bias_WRi_, 0, hidden_size_) : nullptr;
-    clip_with_bias_ptr_(clip_, pBi, pi, hidden_size_);  // post: pi has input to f() to calculate i
-    activation_f_.func(pi, hidden_size_, activation_f_.alpha, activation_f_.beta);
+    const float* pBi = use_bias_ ? SafeRawConstPointer<T>(bias_WRi_, col, num_cols) : nullptr;
+    clip_with_bias_ptr_(clip_, pBi, pi, num_cols);  // post: pi has input to f() to calculate i
+    activation_f_.func(pi, num_cols, activation_f_.alpha, activation_f_.beta);
     // DumpMatrix("i" + row_str, pi, 1, hidden_size_);
 
     // Forget Gate
     if (input_forget_) {
-      for (int i = 0; i < hidden_size_; i++) pf[i] = 1.0f - pi[i];
+      for (int i = 0; i < num_cols; i++) pf[i] = 1.0f - pi[i];
     } else {
       if (use_peepholes_) {
-        deepcpu::elementwise_product(pCprev_hidden_size, SafeRawConstPointer<const T>(peephole_f_, 0, hidden_size_), pf,
-                                     hidden_size_);
+        deepcpu::elementwise_product(pCprev_hidden_size, SafeRawConstPointer<const T>(peephole_f_, col, num_cols), pf,
+                                     num_cols);
       }
 
-      const float* pBf = use_bias_ ? SafeRawConstPointer<T>(bias_WRf_, 0, hidden_size_) : nullptr;
-      clip_with_bias_ptr_(clip_, pBf, pf, hidden_size_);
-      activation_f_.func(pf, hidden_size_, activation_f_.alpha, activation_f_.beta);
+      const float* pBf = use_bias_ ? SafeRawConstPointer<T>(bias_WRf_, col, num_cols) : nullptr;
+      clip_with_bias_ptr_(clip_, pBf, pf, num_cols);
+      activation_f_.func(pf, num_cols, activation_f_.alpha, activation_f_.beta);
     }
 
     // DumpMatrix("f" + row_str, pf, 1, hidden_size_);
 
     // Block Gate
-    const float* pBc = use_bias_ ? SafeRawConstPointer<T>(bias_WRc_, 0, hidden_size_) : nullptr;
-    clip_with_bias_ptr_(clip_, pBc, pc, hidden_size_);
-    activation_g_.func(pc, hidden_size_, activation_g_.alpha, activation_g_.beta);
+    const float* pBc = use_bias_ ? SafeRawConstPointer<T>(bias_WRc_, col, num_cols) : nullptr;
+    clip_with_bias_ptr_(clip_, pBc, pc, num_cols);
+    activation_g_.func(pc, num_cols, activation_g_.alpha, activation_g_.beta);
 
     // DumpMatrix("c" + row_str, pc, 1, hidden_size_);
 
@@ -502,24 +570,24 @@ void UniDirectionalLstm<T>::GateComputations(
                                         pCprev_hidden_size + b * hidden_size_, hidden_size_);
     // DumpMatrix("C", pCprev_hidden_size + b * hidden_size_, 1, hidden_size_);
 #else
-    deepcpu::merge_lstm_gates_to_memory(pCprev_hidden_size, pi, pf, pc, pC_cur, hidden_size_);
+    deepcpu::merge_lstm_gates_to_memory(pCprev_hidden_size, pi, pf, pc, pC_cur, num_cols);
     // DumpMatrix("C", pC_cur, 1, hidden_size_);
 #endif
 
     // Output Gate
     if (use_peepholes_)
-      deepcpu::elementwise_product(pCprev_hidden_size, SafeRawConstPointer<const T>(peephole_o_, 0, hidden_size_), po,
-                                   hidden_size_);
+      deepcpu::elementwise_product(pCprev_hidden_size, SafeRawConstPointer<const T>(peephole_o_, col, num_cols), po,
+                                   num_cols);
 
     // calculate 'ot'
-    const float* pBo = use_bias_ ? SafeRawConstPointer<T>(bias_WRo_, 0, hidden_size_) : nullptr;
-    clip_with_bias_ptr_(clip_, pBo, po, hidden_size_);
-    activation_f_.func(po, hidden_size_, activation_f_.alpha, activation_f_.beta);
+    const float* pBo = use_bias_ ? SafeRawConstPointer<T>(bias_WRo_, col, num_cols) : nullptr;
+    clip_with_bias_ptr_(clip_, pBo, po, num_cols);
+    activation_f_.func(po, num_cols, activation_f_.alpha, activation_f_.beta);
     // DumpMatrix("o" + row_str, po, 1, hidden_size_);
 
     // calculate 'Ht'
-    float* pH =
-        SafeRawPointer<T>(batched_output + row * hidden_size_ + b * hidden_size_, batched_output_end, hidden_size_);
+    float* pH = SafeRawPointer<T>(batched_output + row * hidden_size_ + b * hidden_size_ + col, batched_output_end,
+                                  num_cols);
 
     // the C_prev_clipped location is not actually used as input - it's temporary storage for writing
     // the clipped Ct value to, before calling h(). As such a) it could just be a local variable
@@ -528,14 +596,15 @@ void UniDirectionalLstm<T>::GateComputations(
 #ifdef PREVIOUS_BROKEN_VERSION
     float* pC_prev_clipped = SafeRawPointer<T>(C_prev_clipped, C_prev_clipped_end, hidden_size_);
 #else
-    float* pC_prev_clipped = SafeRawPointer<T>(C_prev_clipped + b * hidden_size_, C_prev_clipped_end, hidden_size_);
+    float* pC_prev_clipped = SafeRawPointer<T>(C_prev_clipped + b * hidden_size_ + col, C_prev_clipped_end, num_cols);
 #endif
 
-    activation_h_.func(pC_cur, pC_prev_clipped, po, pH, hidden_size_, activation_h_.alpha, activation_h_.beta);
+    activation_h_.func(pC_cur, pC_prev_clipped, po, pH, num_cols, activation_h_.alpha, activation_h_.beta);
 
     // DumpMatrix("H" + row_str, pH, 1, hidden_size_);
   }
 
+#if defined(DUMP_MATRIXES)
   auto num_rows = local_fused_hidden_rows - row;
   std::string rows_str = " rows[" + std::to_string(row) + ".." + std::to_string(num_rows) + "]";
 
@@ -545,6 +614,7 @@ void UniDirectionalLstm<T>::GateComputations(
   DumpMatrix("c" + rows_str, &*out, num_rows, hidden_size_, 3 * hidden_size_, hidden_size_x4);
   DumpMatrix("C" + rows_str, &*C_prev, num_rows, hidden_size_);  // Ct overwrites the input C_prev value
   DumpMatrix("H" + rows_str, &*batched_output, num_rows, hidden_size_);
+#endif
 }
 
 template <typename T>
@@ -49,7 +49,8 @@ class UniDirectionalLstm {
                         const span_T_iter& C_prev_end,  // Ct-1 value not 'ct'. using 'C' for clarity
                         span_T_iter& C_prev_clipped, const span_T_iter& C_prev_clipped_end, span_T_iter& batched_output,
                         span_T_iter& batched_output_end, const gsl::span<const int>& seq_lengths,
-                        int min_sequence_length, int step, int row, int local_fused_hidden_rows, bool output_sequence);
+                        int min_sequence_length, int step, int row, int local_fused_hidden_rows, bool output_sequence,
+                        int col, int num_cols);
 
   void AllocateBuffers();
 
@@ -80,6 +81,10 @@ class UniDirectionalLstm {
   IAllocatorUniquePtr<T> output_iofc_ptr_;
   IAllocatorUniquePtr<T> hidden0_ptr_, batched_hidden0_ptr_;
   gsl::span<T> output_iofc_;
+
+  // Ht-1*R[iofc] for each tile of hidden units when the recurrence weights were packed in tiles
+  IAllocatorUniquePtr<T> recurrent_tiles_ptr_;
+  gsl::span<T> recurrent_tiles_;
   gsl::span<T> hidden0_, batched_hidden0_;
 
   IAllocatorUniquePtr<T> internal_memory_prev_ptr_, batched_internal_memory_prev_ptr_;
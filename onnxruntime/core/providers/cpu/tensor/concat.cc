@@ -3,6 +3,7 @@
 
 #include "core/providers/cpu/tensor/concat.h"
 #include "core/providers/common.h"
+#include "core/providers/cpu/tensor/copy.h"
 #include "core/framework/TensorSeq.h"
 
 namespace onnxruntime {
@@ -211,10 +212,11 @@ Status ConcatBase::PrepareForCompute(OpKernelContext* ctx,
 }
 
 // This method computes the output tensor for Concat/ConcatFromSequence ops
-Status ConcatBase::ComputeImpl(Prepare& p) const {
+Status ConcatBase::ComputeImpl(Prepare& p, OpKernelContext* ctx) const {
   int input_count = static_cast<int>(p.inputs.size());
   int64_t initial_output_offset = 0;  // initial offset for each input
   auto element_bytes = p.output_tensor->DataType()->Size();
+  concurrency::ThreadPool* tp = ctx->GetOperatorThreadPool();
   for (int input_index = 0; input_index < input_count; input_index++) {
     const auto& prep = p.inputs[input_index];
 
@@ -228,30 +230,30 @@ Status ConcatBase::ComputeImpl(Prepare& p) const {
     auto input_size = prep.num_elements;
 
     // Copy the data across. For every 'input_axis_pitch' values copied, we move over by the 'output_axis_pitch'
-    // TODO: Optimization possibility: There are cases where we simply need to "merge" raw buffers and this
-    // could be done without the pointer house-keeping as below. Some scenarios whether this is possible are:
-    // 1) Concatenating on input axis = 0
-    // 2) Stacking on output axis = 0
-    // 3) Stacking scalars
     uint8_t* output = static_cast<uint8_t*>(p.output_tensor->MutableDataRaw());
-    int64_t cur_out_offset = 0;
-    int64_t cur_in_offset = 0;
-    for (size_t idx_copy = 0, end = input_size / input_axis_pitch; idx_copy < end; ++idx_copy) {
-      if (p.is_string_type) {
+    const int64_t num_copies = input_size / input_axis_pitch;
+    if (p.is_string_type) {
+      int64_t cur_out_offset = 0;
+      int64_t cur_in_offset = 0;
+      for (int64_t idx_copy = 0; idx_copy < num_copies; ++idx_copy) {
         size_t out = initial_output_offset + cur_out_offset;
         for (int idx_item = 0; idx_item < input_axis_pitch; ++idx_item) {
           reinterpret_cast<std::string*>(output)[out + idx_item] =
               reinterpret_cast<const std::string*>(input)[cur_in_offset + idx_item];
         }
-      } else {
-        memcpy(
-            output + (initial_output_offset + cur_out_offset) * element_bytes,
-            input + cur_in_offset * element_bytes,
-            input_axis_pitch * element_bytes);
-      }
 
-      cur_out_offset += p.output_axis_pitch;
-      cur_in_offset += input_axis_pitch;
+        cur_out_offset += p.output_axis_pitch;
+        cur_in_offset += input_axis_pitch;
+      }
+    } else {
+      // When concatenating on the outermost axis there is a single block per input
+      uint8_t* output_base = output + initial_output_offset * element_bytes;
+      const size_t input_block_bytes = input_axis_pitch * element_bytes;
+      const size_t output_block_bytes = p.output_axis_pitch * element_bytes;
+      ParallelCopyBlocks(tp, num_copies, input_block_bytes,
+                         [output_base, input, input_block_bytes, output_block_bytes](std::ptrdiff_t i) {
+                           return std::make_pair(output_base + i * output_block_bytes, input + i * input_block_bytes);
+                         });
     }
 
     initial_output_offset += input_axis_pitch;
@@ -283,7 +285,7 @@ Status Concat::Compute(OpKernelContext* ctx) const {
     return Status::OK();
 
   // Compute values to be placed in the output tensor
-  return ComputeImpl(p);
+  return ComputeImpl(p, ctx);
 }
 
 }  // namespace onnxruntime
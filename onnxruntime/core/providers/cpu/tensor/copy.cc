@@ -0,0 +1,59 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/providers/cpu/tensor/copy.h"
+
+#include <cstring>
+
+#include "core/common/common.h"
+
+#if defined(_M_X64) || defined(__x86_64__)
+#include <emmintrin.h>
+#define ORT_NON_TEMPORAL_COPY
+#endif
+
+namespace onnxruntime {
+
+void CopyBytes(void* dst, const void* src, size_t num_bytes, bool non_temporal) {
+#if defined(ORT_NON_TEMPORAL_COPY)
+  constexpr size_t vector_bytes = sizeof(__m128i);
+  if (non_temporal && num_bytes >= 4 * vector_bytes) {
+    auto* d = static_cast<uint8_t*>(dst);
+    const auto* s = static_cast<const uint8_t*>(src);
+
+    // streaming stores need an aligned destination
+    const size_t head = (vector_bytes - (reinterpret_cast<uintptr_t>(d) & (vector_bytes - 1))) & (vector_bytes - 1);
+    memcpy(d, s, head);
+    d += head;
+    s += head;
+    num_bytes -= head;
+
+    const size_t body = num_bytes & ~(4 * vector_bytes - 1);
+    for (size_t i = 0; i < body; i += 4 * vector_bytes) {
+      const __m128i v0 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(s + i));
+      const __m128i v1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(s + i + vector_bytes));
+      const __m128i v2 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(s + i + 2 * vector_bytes));
+      const __m128i v3 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(s + i + 3 * vector_bytes));
+      _mm_stream_si128(reinterpret_cast<__m128i*>(d + i), v0);
+      _mm_stream_si128(reinterpret_cast<__m128i*>(d + i + vector_bytes), v1);
+      _mm_stream_si128(reinterpret_cast<__m128i*>(d + i + 2 * vector_bytes), v2);
+      _mm_stream_si128(reinterpret_cast<__m128i*>(d + i + 3 * vector_bytes), v3);
+    }
+
+    memcpy(d + body, s + body, num_bytes - body);
+    return;
+  }
+#else
+  ORT_UNUSED_PARAMETER(non_temporal);
+#endif
+
+  memcpy(dst, src, num_bytes);
+}
+
+void NonTemporalCopyFence() {
+#if defined(ORT_NON_TEMPORAL_COPY)
+  _mm_sfence();
+#endif
+}
+
+}  // namespace onnxruntime
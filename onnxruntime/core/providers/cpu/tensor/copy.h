@@ -0,0 +1,71 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+
+#include "core/platform/threadpool.h"
+
+namespace onnxruntime {
+
+// Outputs of at least this many bytes are written with non-temporal stores where supported, as they will not fit
+// in the cache anyway and would otherwise evict the data of the ops around them.
+constexpr size_t kNonTemporalCopyThresholdBytes = 32 * 1024 * 1024;
+
+// Blocks are split into chunks of at most this many bytes so that a few large blocks are still spread across threads.
+constexpr size_t kParallelCopyChunkBytes = 64 * 1024;
+
+// Copy num_bytes from src to dst. The ranges must not overlap.
+// If non_temporal is true the stores bypass the cache where supported, and NonTemporalCopyFence must be called
+// before the data is read by another thread.
+void CopyBytes(void* dst, const void* src, size_t num_bytes, bool non_temporal);
+
+// Orders the non-temporal stores of CopyBytes made by this thread before any later stores.
+void NonTemporalCopyFence();
+
+// Copies num_blocks blocks of block_bytes each, where get_block(i) returns the (uint8_t* dst, const uint8_t* src)
+// pair for block i. The blocks must not overlap each other or their sources. The work is split across the thread
+// pool by the number of bytes copied.
+template <typename GetBlockFn>
+void ParallelCopyBlocks(concurrency::ThreadPool* tp, std::ptrdiff_t num_blocks, size_t block_bytes,
+                        const GetBlockFn& get_block) {
+  if (num_blocks <= 0 || block_bytes == 0) {
+    return;
+  }
+
+  const bool non_temporal = static_cast<size_t>(num_blocks) * block_bytes >= kNonTemporalCopyThresholdBytes;
+  const size_t chunk_bytes = std::min(block_bytes, kParallelCopyChunkBytes);
+  const std::ptrdiff_t chunks_per_block = static_cast<std::ptrdiff_t>((block_bytes + chunk_bytes - 1) / chunk_bytes);
+
+  concurrency::ThreadPool::TryParallelFor(
+      tp, num_blocks * chunks_per_block,
+      TensorOpCost{static_cast<double>(chunk_bytes), static_cast<double>(chunk_bytes),
+                   static_cast<double>(chunk_bytes) / 16},
+      [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+        for (std::ptrdiff_t i = first; i < last; ++i) {
+          const auto block = get_block(i / chunks_per_block);
+          const size_t offset = static_cast<size_t>(i % chunks_per_block) * chunk_bytes;
+          CopyBytes(block.first + offset, block.second + offset, std::min(chunk_bytes, block_bytes - offset),
+                    non_temporal);
+        }
+
+        if (non_temporal) {
+          NonTemporalCopyFence();
+        }
+      });
+}
+
+// Copies num_bytes from src to dst across the thread pool. The ranges must not overlap.
+inline void ParallelCopy(concurrency::ThreadPool* tp, void* dst, const void* src, size_t num_bytes) {
+  auto* dst_bytes = static_cast<uint8_t*>(dst);
+  const auto* src_bytes = static_cast<const uint8_t*>(src);
+  ParallelCopyBlocks(tp, 1, num_bytes, [dst_bytes, src_bytes](std::ptrdiff_t) {
+    return std::make_pair(dst_bytes, src_bytes);
+  });
+}
+
+}  // namespace onnxruntime
@@ -27,7 +27,8 @@ ONNX_CPU_OPERATOR_VERSIONED_KERNEL(
     10,
     KernelDefBuilder()
         .TypeConstraint("T", DataTypeImpl::AllTensorTypes())
-        .TypeConstraint("Tind", BuildKernelDefConstraintsFromTypeList<IndexTypes>(), BuildKernelDefConstraintsFromTypeList<EnabledIndexTypes>()),
+        .TypeConstraint("Tind", BuildKernelDefConstraintsFromTypeList<IndexTypes>(), BuildKernelDefConstraintsFromTypeList<EnabledIndexTypes>())
+        .MayView(0, 0),
     Gather);
 
 ONNX_CPU_OPERATOR_VERSIONED_KERNEL(
@@ -36,7 +37,8 @@ ONNX_CPU_OPERATOR_VERSIONED_KERNEL(
     12,
     KernelDefBuilder()
         .TypeConstraint("T", DataTypeImpl::AllTensorTypes())
-        .TypeConstraint("Tind", BuildKernelDefConstraintsFromTypeList<IndexTypes>(), BuildKernelDefConstraintsFromTypeList<EnabledIndexTypes>()),
+        .TypeConstraint("Tind", BuildKernelDefConstraintsFromTypeList<IndexTypes>(), BuildKernelDefConstraintsFromTypeList<EnabledIndexTypes>())
+        .MayView(0, 0),
     Gather);
 
 ONNX_CPU_OPERATOR_KERNEL(
@@ -44,7 +46,8 @@ ONNX_CPU_OPERATOR_KERNEL(
     13,
     KernelDefBuilder()
         .TypeConstraint("T", DataTypeImpl::AllTensorTypes())
-        .TypeConstraint("Tind", BuildKernelDefConstraintsFromTypeList<IndexTypes>(), BuildKernelDefConstraintsFromTypeList<EnabledIndexTypes>()),
+        .TypeConstraint("Tind", BuildKernelDefConstraintsFromTypeList<IndexTypes>(), BuildKernelDefConstraintsFromTypeList<EnabledIndexTypes>())
+        .MayView(0, 0),
     Gather);
 
 Status GatherBase::PrepareForCompute(OpKernelContext* context, Prepare& p) const {
@@ -121,7 +124,56 @@ Status GatherCopyData(const Tensor* indices_tensor, const uint8_t* src_base, uin
   return Status::OK();
 }
 
+// A single index selects one contiguous block of the input if all the dims before the axis are 1,
+// so the output can be a view of the input if the allocation plan allows it.
+// Returns false if the output needs to be gathered, including when the index is invalid so the error is reported there.
+static bool TryGatherAsView(OpKernelContext* context, int64_t axis_attr) {
+  const auto& input_tensor = *context->Input<Tensor>(0);
+  const auto& indices_tensor = *context->Input<Tensor>(1);
+  const TensorShape& input_data_shape = input_tensor.Shape();
+  const TensorShape& indices_shape = indices_tensor.Shape();
+
+  const auto input_rank = input_data_shape.NumDimensions();
+  if (input_rank == 0 || indices_shape.Size() != 1) {
+    return false;
+  }
+
+  const auto axis = HandleNegativeAxis(axis_attr, input_rank);
+  const int64_t block = input_data_shape.SizeFromDimension(axis + 1);
+  if (input_data_shape.SizeToDimension(axis) != 1 || block == 0) {
+    return false;
+  }
+
+  int64_t idx = 0;
+  if (utils::HasType<EnabledIndexTypes, int32_t>() && indices_tensor.IsDataType<int32_t>()) {
+    idx = *indices_tensor.Data<int32_t>();
+  } else if (utils::HasType<EnabledIndexTypes, int64_t>() && indices_tensor.IsDataType<int64_t>()) {
+    idx = *indices_tensor.Data<int64_t>();
+  } else {
+    return false;
+  }
+
+  const auto axis_dim_limit = input_data_shape[axis];
+  if (idx < -axis_dim_limit || idx >= axis_dim_limit) {
+    return false;
+  }
+
+  idx = idx < 0 ? idx + axis_dim_limit : idx;
+
+  std::vector<int64_t> shape(input_data_shape.GetDims().begin(), input_data_shape.GetDims().begin() + axis);
+  const auto& indices_dims = indices_shape.GetDims();
+  shape.insert(shape.end(), indices_dims.begin(), indices_dims.end());
+  shape.insert(shape.end(), input_data_shape.GetDims().begin() + axis + 1, input_data_shape.GetDims().end());
+
+  const auto byte_offset = idx * block * static_cast<int64_t>(input_tensor.DataType()->Size());
+  return context->OutputView(0, TensorShape(std::move(shape)), 0, byte_offset) != nullptr;
+}
+
 Status Gather::Compute(OpKernelContext* context) const {
+  if (TryGatherAsView(context, Axis())) {
+    return Status::OK();
+  }
+
   Prepare p;
   ORT_RETURN_IF_ERROR(PrepareForCompute(context, p));
 
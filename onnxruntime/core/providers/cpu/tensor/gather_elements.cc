@@ -2,7 +2,11 @@
 // Licensed under the MIT License.
 
 #include "gather_elements.h"
-#include "onnxruntime_config.h"
+
+#include <algorithm>
+#include <type_traits>
+
+#include "core/platform/threadpool.h"
 
 namespace onnxruntime {
 
@@ -25,25 +29,26 @@ ONNX_CPU_OPERATOR_KERNEL(
                                                         DataTypeImpl::GetTensorType<int64_t>()}),
     GatherElements);
 
-static constexpr int kParallelizationThreshold = 10 * 1000;
+// Rows of the output along the innermost axis are processed in blocks of at most this many elements, so that both
+// many short rows and a few long ones are spread across threads
+static constexpr int64_t kBlockSize = 4096;
 
 // Some helpers needed for GatherElements op -
 
-// The following method computes the offset in the flattened array
-// using every axis except the inner dimension (as the offset is just 1)
-// and the axis that 'GatherElements' is processing for as that requires the corresponding
-// 'indices' value
+// The following method computes the offset in the flattened input of the given row of 'indices', where a row is
+// a chunk of 'inner dimension' length, using every axis except the inner dimension (as the offset is just 1)
+// and the axis that 'GatherElements' is processing for as that requires the corresponding 'indices' value.
 // This prevents the need to compute this offset for every element within the same 'inner_dimension' chunk
-// as this value just differs by 1 for the chunk elements and we can have this cached and re-use as needed
-static inline int64_t compute_base_offset(const std::vector<int64_t>& shape, const TensorPitches& pitches, int64_t skip_axis) {
+// as this value just differs by 1 for the chunk elements.
+static inline int64_t compute_base_offset(int64_t row, const TensorShape& indices_shape, const TensorPitches& pitches,
+                                          int64_t skip_axis) {
   // in this context, rank can never be < 1, so saving checking overhead
-  auto loop_size = static_cast<int64_t>(shape.size()) - 1;
-
   int64_t base_offset = 0;
 
-  for (int64_t i = 0; i < loop_size; ++i) {
+  for (auto i = static_cast<int64_t>(indices_shape.NumDimensions()) - 2; i >= 0; --i) {
     if (i != skip_axis)
-      base_offset += (shape[i] * pitches[i]);
+      base_offset += (row % indices_shape[i]) * pitches[i];
+    row /= indices_shape[i];
   }
 
   return base_offset;
@@ -58,74 +63,12 @@ static int64_t calculate_num_inner_dim(const TensorShape& dims) {
   return dims.SizeToDimension(dims.NumDimensions() - 1);
 }
 
-// This method computes increments over an 'inner_dimension'
-// Example 1: current_dims = [0, x] tensor_dims = [3, 1], then current_dims = [1, x]
-//            current_dims = [1, x] tensor_dims = [3, 1], then current_dims = [2, x]
-//            current_dims = [2, x] tensor_dims = [3, 1], then current_dims = [0, x]
-
-// Example 2: current_dims = [0, 0, x] tensor_dims = [1, 2, 2], then current_dims = [0, 1, x]
-//            current_dims = [0, 1, x] tensor_dims = [1, 2, 2], then current_dims = [0, 0, x]
-static inline void increment_over_inner_dim(std::vector<int64_t>& current_dims, const TensorShape& tensor_dims) {
-  // in this context, rank can never be < 1, so saving checking overhead
-  int64_t rank = static_cast<int64_t>(current_dims.size());
-
-  // 'reset' innermost dimension value
-  current_dims[rank - 1] = 0;
-
-  // nothing to increment over
-  if (rank == 1) {
-    return;
-  }
-
-  int64_t current_axis = rank - 2;
-
-  while (current_axis >= 0) {
-    if (++current_dims[current_axis] != tensor_dims[current_axis])
-      return;
-
-    current_dims[current_axis] = 0;
-    --current_axis;
-  }
-}
-
-template <typename Tin>
-static inline int64_t GetNegativeIndexAdjustedValue(const Tin* indices_data, Tin index, int64_t axis,
-                                                    const TensorShape& input_shape) {
-  int64_t retval = -1;
-  if (indices_data[index] < 0) {
-    retval = static_cast<int64_t>(indices_data[index] + input_shape[axis]);
-  } else {
-    retval = static_cast<int64_t>(indices_data[index]);
-  }
-  return retval;
-}
-
-#ifdef __GNUC__
-#pragma GCC diagnostic push
-#ifdef HAS_CLASS_MEMACCESS
-#pragma GCC diagnostic ignored "-Wclass-memaccess"
-#endif
-#endif
-template <bool is_string, typename T, typename Tin>
+// T is the type the elements are copied as: std::string, or an unsigned integer of the element size
+template <typename T, typename Tin>
 static void core_impl(const Tensor* input_tensor, const Tensor* indices_tensor,
                       Tensor* output_tensor, int64_t axis, concurrency::ThreadPool* ttp) {
-  // get pointer to input data
-  // optimizer will remove the redundant if/else block based on 'is_string' template parameter
-  const T* input_data = nullptr;
-  if (is_string) {
-    input_data = input_tensor->Data<T>();
-  } else {
-    input_data = reinterpret_cast<const T*>(input_tensor->DataRaw());
-  }
-
-  // get pointer to output data
-  // optimizer will remove the redundant if/else block based on 'is_string' template parameter
-  T* output_data = nullptr;
-  if (is_string) {
-    output_data = output_tensor->MutableData<T>();
-  } else {
-    output_data = reinterpret_cast<T*>(output_tensor->MutableDataRaw());
-  }
+  const T* input_data = static_cast<const T*>(input_tensor->DataRaw());
+  T* output_data = static_cast<T*>(output_tensor->MutableDataRaw());
 
   const int64_t input_rank = static_cast<int64_t>(input_tensor->Shape().NumDimensions());
   const TensorPitches input_shape_pitches(*input_tensor);
@@ -149,96 +92,66 @@ static void core_impl(const Tensor* input_tensor, const Tensor* indices_tensor,
     validation_fn(i);
   }
 
-  int64_t num_inner_dim = calculate_num_inner_dim(indices_shape);
-  int64_t inner_dim_size = indices_shape[input_rank - 1];
-  bool processing_inner_dim = (axis == input_rank - 1) ? true : false;
-
-  int64_t base_offset = 0;
-  Tin indices_counter = 0;
-  size_t element_size = input_tensor->DataType()->Size();
-
-  std::vector<int64_t> process_dims(input_rank, 0);
-  int64_t output_counter = 0;
-
-  auto conditional_batch_call = [ttp, inner_dim_size](std::function<void(ptrdiff_t)> f) {
-    if (inner_dim_size < kParallelizationThreshold) {  // TODO: tune this, arbitrary threshold
-      for (int64_t i = 0; i < inner_dim_size; ++i) {
-        f(i);
-      }
-    } else {
-      concurrency::ThreadPool::TryBatchParallelFor(ttp, inner_dim_size, f, 0);
-    }
-  };
+  const int64_t num_inner_dim = calculate_num_inner_dim(indices_shape);
+  const int64_t inner_dim_size = indices_shape[input_rank - 1];
+  const bool processing_inner_dim = axis == input_rank - 1;
+  const int64_t axis_dim = input_shape[axis];
+  const int64_t axis_pitch = input_shape_pitches[axis];
+
+  const int64_t block_size = std::min(inner_dim_size, kBlockSize);
+  const int64_t blocks_per_row = (inner_dim_size + block_size - 1) / block_size;
+  const TensorOpCost cost{static_cast<double>(block_size * (sizeof(T) + sizeof(Tin))),
+                          static_cast<double>(block_size * sizeof(T)),
+                          static_cast<double>(block_size) * (std::is_same<T, std::string>::value ? 32.0 : 2.0)};
+
+  concurrency::ThreadPool::TryParallelFor(
+      ttp, num_inner_dim * blocks_per_row, cost, [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+        for (std::ptrdiff_t unit = first; unit < last; ++unit) {
+          const int64_t row = unit / blocks_per_row;
+          const int64_t begin = (unit % blocks_per_row) * block_size;
+          const int64_t end = std::min(begin + block_size, inner_dim_size);
+
+          const T* row_input = input_data + compute_base_offset(row, indices_shape, input_shape_pitches, axis);
+          const Tin* row_indices = indices_data + row * inner_dim_size;
+          T* row_output = output_data + row * inner_dim_size;
+
+          // we special-case inner dim as we can weed-out some unnecessary computations in element offset calculations
+          if (processing_inner_dim) {
+            // for innermost axis, input_shape_pitches[axis] = 1 (so no need to multiply)
+            for (int64_t i = begin; i < end; ++i) {
+              const int64_t index = static_cast<int64_t>(row_indices[i]);
+              row_output[i] = row_input[index < 0 ? index + axis_dim : index];
+            }
+          } else {
+            for (int64_t i = begin; i < end; ++i) {
+              const int64_t index = static_cast<int64_t>(row_indices[i]);
+              row_output[i] = row_input[(index < 0 ? index + axis_dim : index) * axis_pitch + i];
+            }
+          }
+        }
+      });
+}
 
-  if (!processing_inner_dim) {
-    while (num_inner_dim-- != 0) {
-      base_offset = compute_base_offset(process_dims, input_shape_pitches, axis);
-
-      // process 1 chunk of 'inner dimension' length
-      // optimizer will remove the redundant if/else block based on 'is_string' template parameter
-      if (is_string) {
-        auto fn = [input_data, output_data, base_offset, input_shape_pitches,
-                   indices_data, indices_counter, axis, input_shape, output_counter](ptrdiff_t i) {
-          output_data[i + output_counter] =
-              input_data[base_offset +
-                         (GetNegativeIndexAdjustedValue<Tin>(indices_data, static_cast<Tin>(i) + indices_counter, axis, input_shape) *
-                          input_shape_pitches[axis]) +
-                         i];
-        };
-        conditional_batch_call(fn);
-        output_counter += inner_dim_size;
-      } else {
-        auto fn = [input_data, output_data, base_offset, input_shape_pitches, element_size,
-                   indices_data, indices_counter, axis, input_shape](ptrdiff_t i) {
-          memcpy(output_data + (i * element_size),
-                 input_data + (base_offset + (GetNegativeIndexAdjustedValue<Tin>(indices_data, static_cast<Tin>(i) + indices_counter, axis, input_shape) * input_shape_pitches[axis]) + i) * element_size,
-                 element_size);
-        };
-        conditional_batch_call(fn);
-        output_data += inner_dim_size * element_size;
-      }
-      indices_counter += static_cast<Tin>(inner_dim_size);
-      increment_over_inner_dim(process_dims, indices_shape);
-    }
-  }
-  // we special-case inner dim as we can weed-out some unnecessary computations in element offset calculations
-  else {
-    while (num_inner_dim-- != 0) {
-      base_offset = compute_base_offset(process_dims, input_shape_pitches, axis);
-
-      // process 1 chunk of 'inner dimension' length
-      if (is_string) {
-        auto fn = [input_data, output_data, base_offset,
-                   indices_data, indices_counter, axis, input_shape, output_counter](ptrdiff_t i) {
-          // for innermost axis, input_shape_pitches[axis] = 1 (so no need to multiply)
-          output_data[i + output_counter] =
-              input_data[base_offset +
-                         GetNegativeIndexAdjustedValue<Tin>(indices_data, static_cast<Tin>(i) + indices_counter, axis, input_shape)];
-        };
-        conditional_batch_call(fn);
-        output_counter += inner_dim_size;
-      } else {
-        // for innermost axis, input_shape_pitches[axis] = 1 (so no need to multiply)
-        auto fn = [input_data, output_data, base_offset, element_size,
-                   indices_data, indices_counter, axis, input_shape](ptrdiff_t i) {
-          memcpy(output_data + (i * element_size),
-                 input_data + (base_offset +
-                               GetNegativeIndexAdjustedValue<Tin>(indices_data, static_cast<Tin>(i) + indices_counter, axis, input_shape)) *
-                                  element_size,
-                 element_size);
-        };
-        conditional_batch_call(fn);
-        output_data += inner_dim_size * element_size;
-      }
-
-      indices_counter += static_cast<Tin>(inner_dim_size);
-      increment_over_inner_dim(process_dims, indices_shape);
-    }
+template <typename Tin>
+static void core_impl_for_element_size(const Tensor* input_tensor, const Tensor* indices_tensor,
+                                       Tensor* output_tensor, int64_t axis, concurrency::ThreadPool* ttp) {
+  switch (input_tensor->DataType()->Size()) {
+    case sizeof(uint8_t):
+      core_impl<uint8_t, Tin>(input_tensor, indices_tensor, output_tensor, axis, ttp);
+      break;
+    case sizeof(uint16_t):
+      core_impl<uint16_t, Tin>(input_tensor, indices_tensor, output_tensor, axis, ttp);
+      break;
+    case sizeof(uint32_t):
+      core_impl<uint32_t, Tin>(input_tensor, indices_tensor, output_tensor, axis, ttp);
+      break;
+    case sizeof(uint64_t):
+      core_impl<uint64_t, Tin>(input_tensor, indices_tensor, output_tensor, axis, ttp);
+      break;
+    default:
+      ORT_THROW("GatherElements op: Unsupported element size ", input_tensor->DataType()->Size());
   }
 }
-#ifdef __GNUC__
-#pragma GCC diagnostic pop
-#endif
 
 Status GatherElements::ValidateInputShapes(const TensorShape& input_data_shape,
                                            const TensorShape& indices_shape,
@@ -301,14 +214,14 @@ Status GatherElements::Compute(OpKernelContext* context) const {
   auto* ttp = context->GetOperatorThreadPool();
   if (input_tensor->IsDataTypeString()) {
     if (indices_tensor->IsDataType<int32_t>())
-      core_impl<true, std::string, int32_t>(input_tensor, indices_tensor, output_tensor, axis, ttp);
+      core_impl<std::string, int32_t>(input_tensor, indices_tensor, output_tensor, axis, ttp);
     else
-      core_impl<true, std::string, int64_t>(input_tensor, indices_tensor, output_tensor, axis, ttp);
+      core_impl<std::string, int64_t>(input_tensor, indices_tensor, output_tensor, axis, ttp);
   } else {
     if (indices_tensor->IsDataType<int32_t>())
-      core_impl<false, int8_t, int32_t>(input_tensor, indices_tensor, output_tensor, axis, ttp);
+      core_impl_for_element_size<int32_t>(input_tensor, indices_tensor, output_tensor, axis, ttp);
     else
-      core_impl<false, int8_t, int64_t>(input_tensor, indices_tensor, output_tensor, axis, ttp);
+      core_impl_for_element_size<int64_t>(input_tensor, indices_tensor, output_tensor, axis, ttp);
   }
 
   return Status::OK();
@@ -20,6 +20,8 @@ class GatherBase {
     ORT_ENFORCE(info.GetAttr<int64_t>("axis", &axis_).IsOK(), "Missing/Invalid 'axis' attribute value");
   }
 
+  int64_t Axis() const { return axis_; }
+
  private:
   int64_t axis_;
 };
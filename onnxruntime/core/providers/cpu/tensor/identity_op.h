@@ -12,6 +12,7 @@
 #pragma warning(pop)
 #endif
 #include "core/framework/op_kernel.h"
+#include "core/framework/string_tensor_view.h"
 #include "core/framework/TensorSeq.h"
 
 namespace onnxruntime {
@@ -37,6 +38,13 @@ class IdentityOp final : public OpKernel {
       if (target != source) {
         if (!X->IsDataTypeString()) {
           memcpy(target, source, shape.Size() * X_type->Size());
+        } else if (X->IsStringBuffer()) {
+          // the output has std::string elements
+          const StringTensorView src(*X);
+          auto* dst = Y->template MutableData<std::string>();
+          for (size_t i = 0; i < src.Size(); ++i) {
+            dst[i].assign(src[i].data(), src[i].size());
+          }
         } else {
           // handle std::string
           const auto* src = X->template Data<std::string>();
@@ -3,6 +3,9 @@
 
 #include "core/providers/cpu/tensor/pad.h"
 
+#include <algorithm>
+
+#include "core/platform/threadpool.h"
 #include "core/providers/cpu/tensor/utils.h"
 #include "core/providers/op_kernel_type_control.h"
 #include "core/providers/op_kernel_type_control_utils.h"
@@ -124,26 +127,31 @@ ONNX_CPU_OPERATOR_KERNEL(
             BuildKernelDefConstraintsFromTypeList<EnabledPad13Types>()),
     Pad);
 
-// This is the general padding method to n-dimensionally do edge or reflection padding (based on the inputDelta values)
-template <typename T>
-static void PadAxis(T* output, T* input, ptrdiff_t input_delta, ptrdiff_t input_pitch,
-                    size_t block_size, size_t block_count) {
-  for (size_t block_index = 0; block_index < block_count; block_index++) {
-    for (size_t i = 0; i < block_size; i++) {
-      *output++ = *input;
-      input += input_delta;
-    }
-    input += input_pitch;
+// Maps a coordinate along an axis of the output, relative to the first output position that is copied from the input,
+// to the coordinate within the input extent it takes its value from. Returns -1 if the value is the padding constant.
+// Reflection is repeated for pads that are larger than the extent, matching numpy.
+static inline int64_t MapPadCoordinate(int64_t coordinate, int64_t extent, Mode mode) {
+  if (coordinate >= 0 && coordinate < extent) {
+    return coordinate;
   }
-}
 
-// These are optimizations of PadAxis. The inner loop is removed since the innermost axis has a blockSize of 1,
-// and inputPitch and inputDelta are just a single value added each iteration.
-template <typename T>
-static void PadInnermostAxis(T* output, T* input, ptrdiff_t input_delta, size_t block_count) {
-  for (size_t block_index = 0; block_index < block_count; block_index++) {
-    *output++ = *input;
-    input += input_delta;
+  switch (mode) {
+    case Mode::Edge:
+      return coordinate < 0 ? 0 : extent - 1;
+    case Mode::Reflect: {
+      if (extent == 1) {
+        return 0;
+      }
+
+      const int64_t period = 2 * (extent - 1);
+      coordinate %= period;
+      if (coordinate < 0) {
+        coordinate += period;
+      }
+      return coordinate < extent ? coordinate : period - coordinate;
+    }
+    default:
+      return -1;
   }
 }
 
@@ -318,131 +326,88 @@ static Status PadImpl(OpKernelContext* ctx,
     return PadInputWithDimValueOfZero(ctx, mode, orig_input_shape, output_dims, value);
   }
 
-  TensorShape input_shape(reshaped_input_dims);
-  SliceIterator<T> input(input_tensor, input_shape, input_starts, input_extents, {});
-
   // output_shape need to keep original.
   TensorShape output_shape(output_dims);
   auto& output_tensor = *ctx->Output(0, output_shape);
-  auto* output = reinterpret_cast<T*>(output_tensor.MutableDataRaw());
-
-  TensorPitches output_pitches(reshaped_output_dims);
-  size_t alignSkip = 0;  // Amount to skip to align to where the next input tensor data needs to be written
-
-  // Initial skip, sum up the begin padding on each axis
-  for (size_t i = 0; i < new_dims_count; i++)
-    alignSkip += reshaped_pad[i] * output_pitches[i];
-
-  ExtentAxisCounters input_counters(input_extents);
+  if (output_shape.Size() == 0) {
+    return Status::OK();
+  }
 
-  switch (mode) {
-    case Mode::Constant:
-      // Loop over the output tensor, writing out padding between the blocks of copied data
-      // On loop entry, 'pad' is already set to the first continuous block of padding, and
-      // after every pass through the inner loop it gets set to the next continuous pad size.
-      while (input_counters) {
-        output += alignSkip;
-        {
-          T* axisStart = output;
-          output = input.CopyInnermostAxisSolitaryInnerStep(output);
-
-          int64_t prePad = reshaped_pad[inner_axis];
-          int64_t postPad = reshaped_pad[inner_axis + new_dims_count];
-          PadAxisConstant(axisStart - prePad, value, prePad);
-          PadAxisConstant(output, value, postPad);
-          output += postPad;
-          alignSkip = prePad;
-        }
-        // Calculate the size of the next block of padding (skipping over the innermost axis since that's already done)
-        while (input_counters.Increment()) {
-          ptrdiff_t inner_pitch = output_pitches[input_counters.Axis()];
-          T* axisStart = output - inner_pitch * input_extents[input_counters.Axis()];
-          int64_t prePad = reshaped_pad[input_counters.Axis()];
-          int64_t postPad = reshaped_pad[input_counters.Axis() + new_dims_count];
-          PadAxisConstant(axisStart - prePad * inner_pitch, value, prePad * inner_pitch);
-          PadAxisConstant(output, value, postPad * inner_pitch);
-          output += inner_pitch * postPad;
-          alignSkip += inner_pitch * prePad;
-        }
+  if (mode != Mode::Constant) {
+    for (size_t i = 0; i < new_dims_count; i++) {
+      if (input_extents[i] <= 0) {
+        return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL,
+                               "Cannot use 'edge' or 'reflect' mode to pad a dimension that has no input values left "
+                               "after applying the negative pads. Input shape:", orig_input_shape);
       }
-      break;
+    }
+  }
 
-    case Mode::Edge:
-      // Loop over the output tensor, writing out padding between the blocks of copied data
-      // On loop entry, 'pad' is already set to the first continuous block of padding, and
-      // after every pass through the inner loop it gets set to the next continuous pad size.
-      while (input_counters) {
-        output += alignSkip;
-        {
-          T* axisStart = output;
-          output = input.CopyInnermostAxisSolitaryInnerStep(output);
-
-          int64_t prePad = reshaped_pad[inner_axis];
-          int64_t postPad = reshaped_pad[inner_axis + new_dims_count];
-          if (inner_no_pad_size == 1) {
-            PadAxisConstant(axisStart - prePad, *axisStart, prePad);
-            PadAxisConstant(output, *(output - 1), postPad);
-          } else {
-            // When inner_most axis(es) do not need pad, above PadAxisConstant() do not fit for Edge mode.
-            // Also general loop below after handling first pad axis with non-pad axis works fine.
-            PadAxis(axisStart - prePad, axisStart, 1, -ptrdiff_t(inner_no_pad_size), inner_no_pad_size, pads[inner_axis]);
-            PadAxis(output, output - inner_no_pad_size, 1, -ptrdiff_t(inner_no_pad_size), inner_no_pad_size, pads[inner_axis + data_rank]);
+  auto* output = reinterpret_cast<T*>(output_tensor.MutableDataRaw());
+  const auto* input = reinterpret_cast<const T*>(input_tensor.DataRaw());
+  TensorPitches input_pitches(reshaped_input_dims);
+
+  // Every row of the output along the (flattened) innermost axis is produced independently: the coordinates on the
+  // outer axes select the input row it is copied from, or whether it is all padding, and the padding on the innermost
+  // axis is written around the copied values. Edge and reflect padding on the innermost axis work in units of
+  // inner_no_pad_size values, as that many values were flattened into each position of the original axis.
+  const int64_t output_row_size = reshaped_output_dims[inner_axis];
+  const int64_t num_rows = output_shape.Size() / output_row_size;
+  const int64_t inner_extent = input_extents[inner_axis];
+  const int64_t pre_pad = reshaped_pad[inner_axis];
+  const int64_t post_pad = reshaped_pad[inner_axis + new_dims_count];
+  const int64_t unit_size = static_cast<int64_t>(inner_no_pad_size);
+  const int64_t unit_extent = inner_extent / unit_size;
+
+  concurrency::ThreadPool::TryParallelFor(
+      ctx->GetOperatorThreadPool(), num_rows,
+      TensorOpCost{static_cast<double>(inner_extent * sizeof(T)), static_cast<double>(output_row_size * sizeof(T)),
+                   static_cast<double>(output_row_size)},
+      [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+        for (std::ptrdiff_t row = first; row < last; ++row) {
+          T* output_row = output + row * output_row_size;
+
+          int64_t remaining = row;
+          const T* input_row = input;
+          bool is_pad_row = false;
+          for (size_t axis = inner_axis; axis-- > 0;) {
+            const int64_t coordinate = remaining % reshaped_output_dims[axis];
+            remaining /= reshaped_output_dims[axis];
+            const int64_t mapped = MapPadCoordinate(coordinate - reshaped_pad[axis], input_extents[axis], mode);
+            if (mapped < 0) {
+              is_pad_row = true;
+              break;
+            }
+            input_row += (input_starts[axis] + mapped) * input_pitches[axis];
           }
-          output += postPad;
-          alignSkip = prePad;
-        }
-        // Calculate the size of the next block of padding (skipping over the innermost axis since that's already done)
-        while (input_counters.Increment()) {
-          ptrdiff_t inner_pitch = output_pitches[input_counters.Axis()];
-          T* axisStart = output - inner_pitch * input_extents[input_counters.Axis()];
-          int64_t prePad = reshaped_pad[input_counters.Axis()];
-          int64_t postPad = reshaped_pad[input_counters.Axis() + new_dims_count];
-          PadAxis(axisStart - prePad * inner_pitch, axisStart, 1, -inner_pitch, inner_pitch, prePad);
-          PadAxis(output, output - inner_pitch, 1, -inner_pitch, inner_pitch, postPad);
-          output += inner_pitch * postPad;
-          alignSkip += inner_pitch * prePad;
-        }
-      }
-      break;
 
-    case Mode::Reflect:
-      // Loop over the output tensor, writing out padding between the blocks of copied data
-      // On loop entry, 'pad' is already set to the first continuous block of padding, and
-      // after every pass through the inner loop it gets set to the next continuous pad size.
-      while (input_counters) {
-        output += alignSkip;
-        {
-          T* axisStart = output;
-          output = input.CopyInnermostAxisSolitaryInnerStep(output);
-
-          int64_t prePad = reshaped_pad[inner_axis];
-          int64_t postPad = reshaped_pad[inner_axis + new_dims_count];
-          if (inner_no_pad_size == 1) {
-            PadInnermostAxis(axisStart - prePad, axisStart + prePad, -1 /* inputDelta */, prePad);
-            PadInnermostAxis(output, output - 2, -1 /* inputDelta */, postPad);
+          if (is_pad_row) {
+            PadAxisConstant(output_row, value, static_cast<size_t>(output_row_size));
+            continue;
+          }
+
+          input_row += input_starts[inner_axis];
+          T* output_values = output_row + pre_pad;
+          std::copy_n(input_row, inner_extent, output_values);
+          T* output_post_pad = output_values + inner_extent;
+
+          if (mode == Mode::Constant) {
+            PadAxisConstant(output_row, value, static_cast<size_t>(pre_pad));
+            PadAxisConstant(output_post_pad, value, static_cast<size_t>(post_pad));
           } else {
-            // When inner_most axis(es) do not need pad, Above PadInnermostAxis() do not fit for Reflect mode.
-            PadAxis(axisStart - prePad, axisStart + prePad, 1, -ptrdiff_t(inner_no_pad_size * 2), inner_no_pad_size, pads[inner_axis]);
-            PadAxis(output, output - 2 * inner_no_pad_size, 1, -ptrdiff_t(inner_no_pad_size * 2), inner_no_pad_size, pads[inner_axis + data_rank]);
+            const int64_t pre_pad_units = pre_pad / unit_size;
+            for (int64_t unit = 0; unit < pre_pad_units; ++unit) {
+              const int64_t mapped = MapPadCoordinate(unit - pre_pad_units, unit_extent, mode);
+              std::copy_n(input_row + mapped * unit_size, unit_size, output_row + unit * unit_size);
+            }
+
+            for (int64_t unit = 0, end = post_pad / unit_size; unit < end; ++unit) {
+              const int64_t mapped = MapPadCoordinate(unit_extent + unit, unit_extent, mode);
+              std::copy_n(input_row + mapped * unit_size, unit_size, output_post_pad + unit * unit_size);
+            }
           }
-          output += postPad;
-          alignSkip = prePad;
         }
-        // Calculate the size of the next block of padding (skipping over the innermost axis since that's already done)
-        while (input_counters.Increment()) {
-          ptrdiff_t inner_pitch = output_pitches[input_counters.Axis()];
-          T* axisStart = output - inner_pitch * input_extents[input_counters.Axis()];
-          int64_t prePad = reshaped_pad[input_counters.Axis()];
-          int64_t postPad = reshaped_pad[input_counters.Axis() + new_dims_count];
-          PadAxis(axisStart - prePad * inner_pitch, axisStart + prePad * inner_pitch, 1, -inner_pitch * 2,
-                  inner_pitch, prePad);
-          PadAxis(output, output - 2 * inner_pitch, 1, -inner_pitch * 2, inner_pitch, postPad);
-          output += inner_pitch * postPad;
-          alignSkip += inner_pitch * prePad;
-        }
-      }
-      break;
-  }
+      });
 
   return Status::OK();
 }
@@ -10,6 +10,8 @@
 #include "core/framework/element_type_lists.h"
 #include "core/framework/op_kernel.h"
 #include "core/providers/common.h"
+#include "core/providers/cpu/tensor/copy.h"
+#include "core/providers/cpu/tensor/utils.h"
 #include "core/providers/op_kernel_type_control.h"
 #include "core/providers/op_kernel_type_control_utils.h"
 #if defined(ENABLE_TRAINING) || defined(ENABLE_TRAINING_OPS)
@@ -125,7 +127,7 @@ template <class Tdata, typename FuncT>
 Status CopyScatterData(
     const FuncT& func,
     const Tensor* data_input, const std::vector<int64_t>& indices_data, const Tensor* updates_input, int64_t axis,
-    Tensor* data_output) {
+    Tensor* data_output, concurrency::ThreadPool* tp) {
   const TensorShape& input_data_shape = data_input->Shape();
 
   const auto input_elements = input_data_shape.Size();
@@ -145,39 +147,31 @@ Status CopyScatterData(
       auto* dst = data_output->template MutableData<std::string>();
       std::copy(str_begin, str_end, dst);
     } else {
-      memcpy(static_cast<void*>(dst_base), static_cast<const void*>(src_base), total_input_bytes);
+      ParallelCopy(tp, dst_base, src_base, total_input_bytes);
     }
   }
 
+  if (num_indices == 0) {
+    return Status::OK();
+  }
+
   // Now poke updates
 
   const auto& upd_shape = updates_input->Shape();
   const auto num_dims = input_data_shape.NumDimensions();
   assert(num_dims > 0);
 
-  // Allocate and zero out counts. The input/output is of the same rank as
-  // indices/updates but the actual dimensions of indices/updates must be less or equal
-  // than that of input/output because we can update no more elements than
-  // the input contains. As we walk through the indices/updates
-  // we maintain dimension count as we will need to use it
-  // to compute output offset but using input/output dim values.
-  // We treat the whole array as a number where each element having
-  // different cardinality according to the upd_shape dimensions.
-  // As each counter reaches its max (upd_shape) it resets to zero
-  // and we carry to the more significant dim (right to left)
-  std::vector<int64_t> dim_counters(num_dims);
-
   // This vector contains number of elements under the dimension.
   // For example, for the dimensions of [4, 2, 3] the vector
   // would contain [6, 3, 1] since for each count of dim 1 it
   // contains 3 elements of dim 2.
   // For each count of dim 0 we would have 2x3=6 elements.
   // The last value is always 1.
-  // We use it to compute output element offset. For a given value of
-  // counters we multiple each counter value per corresponding entry of dim_block_size value
+  // We use it to compute output element offset. For a given update
+  // we multiple each of its coordinates per corresponding entry of dim_block_size value
   // and add up resulting the output element offset. However, for dimensions
   // that are equal to the specified axis value we take indices_data[index]
-  // instead of the counter value.
+  // instead of the coordinate.
   // E.g. for 3-dim and axis=0
   //    output[indices[i][j][k]][j][k] = updates[i][j][k]
   // for axis 1
@@ -194,51 +188,52 @@ Status CopyScatterData(
     }
   }
 
-  const auto* update_data = static_cast<const Tdata*>(updates_input->DataRaw());
-  // For every update we compute the destination offset and copy it there
-  for (int64_t index = 0; index < num_indices;) {
-    const auto axis_idx = indices_data[index];
-
-    // Compute the offset
-    // See comments above for dim_block_size
-    size_t dst_offset = 0;
-    for (size_t i = 0; i < num_dims; ++i) {
-      if (i == size_t(axis)) {
-        // replace the counter with the update index for this dim
-        dst_offset += axis_idx * dim_block_size[i];
-      } else {
-        dst_offset += dim_counters[i] * dim_block_size[i];
-      }
-    }
+  // The updates that only differ in their coordinate along the axis form a line. Lines write to disjoint output
+  // elements so they are processed in parallel, while the updates of a line are applied in order so that duplicate
+  // indices resolve the same way as they would in a single pass over the updates.
+  const TensorPitches upd_pitches(upd_shape);
+  const int64_t line_length = upd_shape[axis];
+  const int64_t num_lines = num_indices / line_length;
 
-    func(dst_base + dst_offset, update_data + index);
+  const auto* update_data = static_cast<const Tdata*>(updates_input->DataRaw());
+  const double line_bytes = static_cast<double>(line_length * sizeof(Tdata));
+  concurrency::ThreadPool::TryParallelFor(
+      tp, num_lines,
+      TensorOpCost{line_bytes + static_cast<double>(line_length * sizeof(int64_t)), line_bytes,
+                   static_cast<double>(line_length) * (std::is_same<Tdata, std::string>::value ? 32.0 : 2.0)},
+      [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+        for (std::ptrdiff_t line = first; line < last; ++line) {
+          // Compute the offsets of the first update of the line and of its output element with the axis coordinate
+          // left out. See comments above for dim_block_size
+          int64_t remaining = line;
+          int64_t update_offset = 0;
+          int64_t dst_offset = 0;
+          for (auto i = int64_t(num_dims - 1); i >= 0; --i) {
+            if (i == axis) {
+              continue;
+            }
+            const int64_t coordinate = remaining % upd_shape[i];
+            remaining /= upd_shape[i];
+            update_offset += coordinate * upd_pitches[i];
+            dst_offset += coordinate * dim_block_size[i];
+          }
+
+          for (int64_t k = 0; k < line_length; ++k) {
+            const int64_t index = update_offset + k * upd_pitches[axis];
+            func(dst_base + dst_offset + indices_data[index] * dim_block_size[axis], update_data + index);
+          }
+        }
+      });
 
-    if (++index == num_indices) {
-      break;
-    }
-    // Increment counters
-    // See comments for dim_counters above
-    for (auto i = int64_t(num_dims - 1); i >= 0; --i) {
-      auto v = ++dim_counters[i];
-      assert(v <= upd_shape[i]);
-      if (v < upd_shape[i]) {
-        // No carry, done
-        break;
-      }
-      // No carry for the most significant dim
-      assert(i > 0);
-      dim_counters[i] = 0;
-    }
-  }
   return Status::OK();
 }
 
 template <typename TData>
 struct CopyScatterDataDispatchTarget {
   Status operator()(const Tensor* data_input, const std::vector<int64_t>& indices_data, const Tensor* updates_input, int64_t axis,
-                    Tensor* data_output) const {
+                    Tensor* data_output, concurrency::ThreadPool* tp) const {
     return CopyScatterData<TData>(
-        Func_Assignment<TData>(), data_input, indices_data, updates_input, axis, data_output);
+        Func_Assignment<TData>(), data_input, indices_data, updates_input, axis, data_output, tp);
   }
 };
 
@@ -308,7 +303,7 @@ Status Scatter<EnabledDataTypes>::Compute(OpKernelContext* context) const {
 
   utils::MLTypeCallDispatcherFromTypeList<EnabledDataTypes> dispatcher{data_type};
   status = dispatcher.template InvokeRet<Status, CopyScatterDataDispatchTarget>(
-      data_input, indices_data, updates_input, axis, data_output);
+      data_input, indices_data, updates_input, axis, data_output, context->GetOperatorThreadPool());
 
   return status;
 }
@@ -329,7 +324,8 @@ Status GatherElementsGradImpl(const Tensor* indices_input, const Tensor* updates
                               const int64_t axis, Tensor* data_output) {
   std::vector<int64_t> indices_data{};
   ORT_RETURN_IF_ERROR(GetIndices<Tin>(*data_output, *indices_input, axis, indices_data));
-  return CopyScatterData<Tdata>(Func_Add<Tdata>(), data_output, indices_data, updates_input, axis, data_output);
+  return CopyScatterData<Tdata>(Func_Add<Tdata>(), data_output, indices_data, updates_input, axis, data_output,
+                                nullptr);
 }
 
 #define GATHER_ELEMENTS_GRAD_IMPL_SPECIALIZED(Tin, Tdata)         \
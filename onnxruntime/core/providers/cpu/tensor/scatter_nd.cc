@@ -7,6 +7,7 @@
 #include "core/platform/threadpool.h"
 #include "core/providers/op_kernel_type_control.h"
 #include "core/providers/op_kernel_type_control_utils.h"
+#include "core/providers/cpu/tensor/copy.h"
 #include "core/providers/cpu/tensor/utils.h"
 
 namespace onnxruntime {
@@ -120,7 +121,7 @@ Status ScatterNDBase::PrepareForCompute(OpKernelContext* context, Prepare& p) co
       auto* dst = output_tensor->template MutableData<std::string>();
       std::copy(str_begin, str_end, dst);
     } else {
-      memcpy(dst_base, src_base, input_tensor->SizeInBytes());
+      ParallelCopy(context->GetOperatorThreadPool(), dst_base, src_base, input_tensor->SizeInBytes());
     }
   }
 
@@ -181,9 +182,11 @@ Status ScatterND::ScatterNumber(const Prepare& p, concurrency::ThreadPool* tp) c
            p.input_base + i * p.bytes_to_copy,
            p.bytes_to_copy);
   };
-  concurrency::ThreadPool::TryParallelFor(tp, p.element_offsets.size(), static_cast<double>(p.bytes_to_copy),
+  const double bytes_to_copy = static_cast<double>(p.bytes_to_copy);
+  concurrency::ThreadPool::TryParallelFor(tp, p.element_offsets.size(),
+                                          TensorOpCost{bytes_to_copy, bytes_to_copy, bytes_to_copy / 16},
                                           [&lambda](ptrdiff_t first, ptrdiff_t last) {
-                                            for (int i = static_cast<int>(first), end = static_cast<int>(last); i < end; ++i) {
+                                            for (ptrdiff_t i = first; i < last; ++i) {
                                               lambda(i);
                                             }
                                           });
@@ -200,9 +203,12 @@ Status ScatterND::ScatterString(const Prepare& p, concurrency::ThreadPool* tp) c
       p.output_str_base[p.element_offsets[i] + j] = p.input_str_base[i * p.element_to_copy + j];
     }
   };
-  concurrency::ThreadPool::TryParallelFor(tp, p.element_offsets.size(), static_cast<double>(p.element_to_copy),
+  const double bytes_to_copy = static_cast<double>(p.element_to_copy * sizeof(std::string));
+  concurrency::ThreadPool::TryParallelFor(tp, p.element_offsets.size(),
+                                          TensorOpCost{bytes_to_copy, bytes_to_copy,
+                                                       static_cast<double>(p.element_to_copy) * 32},
                                           [&lambda](ptrdiff_t first, ptrdiff_t last) {
-                                            for (int i = static_cast<int>(first), end = static_cast<int>(last); i < end; ++i) {
+                                            for (ptrdiff_t i = first; i < last; ++i) {
                                               lambda(i);
                                             }
                                           });
@@ -44,7 +44,9 @@ using EnabledIndicesTypes = ORT_OP_KERNEL_ARG_ENABLED_TYPE_LIST_ALL_OPSETS(kCpuE
 ONNX_CPU_OPERATOR_VERSIONED_KERNEL(
     Slice,
     1, 9,
-    KernelDefBuilder().TypeConstraint("T", BuildKernelDefConstraintsFromTypeList<DataTypes>(), BuildKernelDefConstraintsFromTypeList<EnabledDataTypes>()),
+    KernelDefBuilder()
+        .TypeConstraint("T", BuildKernelDefConstraintsFromTypeList<DataTypes>(), BuildKernelDefConstraintsFromTypeList<EnabledDataTypes>())
+        .MayView(0, 0),
     Slice1);
 
 ONNX_CPU_OPERATOR_VERSIONED_KERNEL(
@@ -52,7 +54,8 @@ ONNX_CPU_OPERATOR_VERSIONED_KERNEL(
     10, 10,
     KernelDefBuilder()
         .TypeConstraint("T", BuildKernelDefConstraintsFromTypeList<DataTypes>(), BuildKernelDefConstraintsFromTypeList<EnabledDataTypes>())
-        .TypeConstraint("Tind", BuildKernelDefConstraintsFromTypeList<IndicesTypes>(), BuildKernelDefConstraintsFromTypeList<EnabledIndicesTypes>()),
+        .TypeConstraint("Tind", BuildKernelDefConstraintsFromTypeList<IndicesTypes>(), BuildKernelDefConstraintsFromTypeList<EnabledIndicesTypes>())
+        .MayView(0, 0),
     Slice10);
 
 ONNX_CPU_OPERATOR_VERSIONED_KERNEL(
@@ -61,7 +64,8 @@ ONNX_CPU_OPERATOR_VERSIONED_KERNEL(
     12,
     KernelDefBuilder()
         .TypeConstraint("T", BuildKernelDefConstraintsFromTypeList<DataTypes>(), BuildKernelDefConstraintsFromTypeList<EnabledDataTypes>())
-        .TypeConstraint("Tind", BuildKernelDefConstraintsFromTypeList<IndicesTypes>(), BuildKernelDefConstraintsFromTypeList<EnabledIndicesTypes>()),
+        .TypeConstraint("Tind", BuildKernelDefConstraintsFromTypeList<IndicesTypes>(), BuildKernelDefConstraintsFromTypeList<EnabledIndicesTypes>())
+        .MayView(0, 0),
     Slice10);
 
 ONNX_CPU_OPERATOR_KERNEL(
@@ -69,7 +73,8 @@ ONNX_CPU_OPERATOR_KERNEL(
     13,
     KernelDefBuilder()
         .TypeConstraint("T", BuildKernelDefConstraintsFromTypeList<DataTypes>(), BuildKernelDefConstraintsFromTypeList<EnabledDataTypes>())
-        .TypeConstraint("Tind", BuildKernelDefConstraintsFromTypeList<IndicesTypes>(), BuildKernelDefConstraintsFromTypeList<EnabledIndicesTypes>()),
+        .TypeConstraint("Tind", BuildKernelDefConstraintsFromTypeList<IndicesTypes>(), BuildKernelDefConstraintsFromTypeList<EnabledIndicesTypes>())
+        .MayView(0, 0),
     Slice10);
 
 // Check if it's possible to combine innermost dimensions so we copy larger blocks.
@@ -200,6 +205,54 @@ Status SliceBase::FillVectorsFromInput(const Tensor& start_tensor,
   return Status::OK();
 }
 
+// Check if the slice selects a single contiguous range of the input, so the output can be a view of it.
+// That is the case if, going outwards, the slice keeps all the data of the innermost dims, takes a range with
+// step 1 from the next dim, and a single index from all the dims outside of that.
+// Sets element_offset to the offset of the first selected element if it is.
+static bool IsContiguousSlice(const std::vector<int64_t>& input_dimensions,
+                              const SliceOp::PrepareForComputeMetadata& compute_metadata,
+                              int64_t& element_offset) {
+  // starts and steps match the flattened output dims if the innermost dims were combined
+  const auto& output_dims = compute_metadata.p_flattened_output_dims_ ? *compute_metadata.p_flattened_output_dims_
+                                                                      : compute_metadata.output_dims_;
+  const auto& starts = compute_metadata.starts_;
+  const auto& steps = compute_metadata.steps_;
+  const size_t num_dims = output_dims.size();
+
+  // the combined innermost dim (if any) keeps all its data so the input has the same size for it
+  auto input_dim = [&](size_t i) {
+    return i + 1 == num_dims ? (compute_metadata.p_flattened_output_dims_ ? output_dims[i] : input_dimensions[i])
+                             : input_dimensions[i];
+  };
+
+  size_t axis = num_dims;
+  while (axis > 0 && steps[axis - 1] == 1 && output_dims[axis - 1] == input_dim(axis - 1)) {
+    --axis;
+  }
+
+  if (axis > 0) {
+    --axis;
+    if (steps[axis] != 1 && output_dims[axis] != 1) {
+      return false;
+    }
+
+    for (size_t i = 0; i < axis; ++i) {
+      if (output_dims[i] != 1) {
+        return false;
+      }
+    }
+  }
+
+  element_offset = 0;
+  int64_t pitch = 1;
+  for (size_t i = num_dims; i-- > 0;) {
+    element_offset += starts[i] * pitch;
+    pitch *= input_dim(i);
+  }
+
+  return true;
+}
+
 template <typename T>
 static Status SliceImpl(OpKernelContext* ctx,
                         const Tensor& input_tensor,
@@ -290,6 +343,14 @@ Status SliceBase::Compute(OpKernelContext* ctx) const {
     ORT_RETURN_IF_ERROR(PrepareForCompute(attr_starts_, attr_ends_, attr_axes_, compute_metadata));
   }
 
+  // if the output is a contiguous range of the input and the allocation plan allows it, return a view of the input
+  int64_t element_offset = 0;
+  TensorShape output_shape(compute_metadata.output_dims_);
+  if (output_shape.Size() > 0 && IsContiguousSlice(input_dimensions, compute_metadata, element_offset) &&
+      ctx->OutputView(0, output_shape, 0, element_offset * input_tensor.DataType()->Size()) != nullptr) {
+    return Status::OK();
+  }
+
   Status status = Status::OK();
 
   bool supported = false;
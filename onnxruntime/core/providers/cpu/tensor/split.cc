@@ -31,9 +31,11 @@ ONNX_CPU_OPERATOR_VERSIONED_KERNEL(
     Split,
     2,
     10,
-    KernelDefBuilder().TypeConstraint("T",
-                                      BuildKernelDefConstraintsFromTypeList<SplitDataTypes>(),
-                                      BuildKernelDefConstraintsFromTypeList<EnabledSplitDataTypes>()),
+    KernelDefBuilder()
+        .TypeConstraint("T",
+                        BuildKernelDefConstraintsFromTypeList<SplitDataTypes>(),
+                        BuildKernelDefConstraintsFromTypeList<EnabledSplitDataTypes>())
+        .VariadicMayView(0, 0),
     Split);
 
 // Opset 11 starts to support Neg Axis.
@@ -41,18 +43,22 @@ ONNX_CPU_OPERATOR_VERSIONED_KERNEL(
     Split,
     11,
     12,
-    KernelDefBuilder().TypeConstraint("T",
-                                      BuildKernelDefConstraintsFromTypeList<SplitDataTypes>(),
-                                      BuildKernelDefConstraintsFromTypeList<EnabledSplitDataTypes>()),
+    KernelDefBuilder()
+        .TypeConstraint("T",
+                        BuildKernelDefConstraintsFromTypeList<SplitDataTypes>(),
+                        BuildKernelDefConstraintsFromTypeList<EnabledSplitDataTypes>())
+        .VariadicMayView(0, 0),
     Split);
 
 // Opset 13 starts to supports 'split' as optional input.
 ONNX_CPU_OPERATOR_KERNEL(
     Split,
     13,
-    KernelDefBuilder().TypeConstraint("T",
-                                      BuildKernelDefConstraintsFromTypeList<SplitDataTypes>(),
-                                      BuildKernelDefConstraintsFromTypeList<EnabledSplitDataTypes>()),
+    KernelDefBuilder()
+        .TypeConstraint("T",
+                        BuildKernelDefConstraintsFromTypeList<SplitDataTypes>(),
+                        BuildKernelDefConstraintsFromTypeList<EnabledSplitDataTypes>())
+        .VariadicMayView(0, 0),
     Split);
 
 Status SplitBase::PrepareForCompute(const TensorShape& input_shape, int num_outputs, int64_t& axis, int& before_dims,
@@ -171,7 +177,16 @@ Status Split::ComputeImpl(OpKernelContext& context, const Tensor& input) const {
     auto split_size = gsl::narrow<int>(split_sizes[i]);
     output_dimensions[axis] = split_size;
 
-    Tensor* output = context.Output(i, TensorShape{output_dimensions});
+    // if there's nothing before the split axis the output is a contiguous range of the input,
+    // so it can be a view of the input if the allocation plan allows it
+    TensorShape output_shape{output_dimensions};
+    if (before_dims == 1 && split_size > 0 &&
+        context.OutputView(i, output_shape, 0, input_offset * static_cast<int64_t>(sizeof(T))) != nullptr) {
+      input_offset += split_size * after_dims_excluding_split;
+      continue;
+    }
+
+    Tensor* output = context.Output(i, output_shape);
     T* output_data = output->template MutableData<T>();
 
     ::onnxruntime::math::CopyMatrix<T>(
@@ -11,6 +11,7 @@
 
 #include "gsl/gsl"
 #include "core/providers/cpu/tensor/tile.h"
+#include "core/providers/cpu/tensor/copy.h"
 #include "core/providers/cpu/tensor/utils.h"
 
 #ifdef _MSC_VER
@@ -56,46 +57,59 @@ ONNX_CPU_OPERATOR_KERNEL(
         .TypeConstraint("T1", DataTypeImpl::GetTensorType<int64_t>()),
     Tile);
 
-Status TileCoreForFixedSizeTypes(const Tensor& input_tensor, Tensor& output_tensor, const int64_t* repeats, TensorAxisCounters& input_counters, const TensorPitches& output_pitches, size_t element_size) {
+Status TileCoreForFixedSizeTypes(const Tensor& input_tensor, Tensor& output_tensor, const int64_t* repeats,
+                                 const TensorPitches& output_pitches, size_t element_size,
+                                 concurrency::ThreadPool* tp) {
   const auto& input_shape = input_tensor.Shape().GetDims();
   const size_t dimension_count = input_shape.size();
 
   const auto* input = reinterpret_cast<const uint8_t*>(input_tensor.DataRaw());
   auto* output = reinterpret_cast<uint8_t*>(output_tensor.MutableDataRaw());
 
-  // some helper variables that will be used along the way
-  size_t block_size = 0;
-  int64_t num_repeats = 0;
-  const uint8_t* copy = nullptr;
-  const int64_t innermost_dim = input_shape[dimension_count - 1];
-
-  while (input_counters) {
-    // Copy the input data over
-    block_size = innermost_dim * element_size;
-    memcpy(output, input, block_size);
-    output += block_size;
-    input += block_size;
-
-    // Tile data for the innermost axis
-    copy = output - block_size;
-    num_repeats = repeats[dimension_count - 1] - 1;
-    for (int64_t repeat = 0; repeat < num_repeats; ++repeat) {
-      memcpy(output, copy, block_size);
-      output += block_size;
+  // Output offset (in elements) of the first tile of the given input index over the axes [0, num_axes)
+  auto first_tile_offset = [&input_shape, &output_pitches](int64_t index, size_t num_axes) {
+    int64_t offset = 0;
+    for (size_t axis = num_axes; axis-- > 0;) {
+      offset += (index % input_shape[axis]) * output_pitches[axis];
+      index /= input_shape[axis];
     }
-
-    // Tile data for other axes
-    while (input_counters.Increment()) {
-      ptrdiff_t pitch = output_pitches[input_counters.Axis()] * input_shape[input_counters.Axis()];
-      block_size = pitch * element_size;
-      copy = output - block_size;
-      num_repeats = repeats[input_counters.Axis()] - 1;
-      for (int64_t repeat = 0; repeat < num_repeats; ++repeat) {
-        memcpy(output, copy, block_size);
-        output += block_size;
-      }
+    return offset;
+  };
+
+  // Place every innermost row of the input in its first tile, repeated along the innermost axis
+  const int64_t innermost_repeats = repeats[dimension_count - 1];
+  const size_t row_bytes = input_shape[dimension_count - 1] * element_size;
+  const int64_t num_rows = input_tensor.Shape().SizeToDimension(dimension_count - 1);
+  const double row_output_bytes = static_cast<double>(row_bytes * innermost_repeats);
+  concurrency::ThreadPool::TryParallelFor(
+      tp, num_rows, TensorOpCost{static_cast<double>(row_bytes), row_output_bytes, row_output_bytes / 16},
+      [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+        for (std::ptrdiff_t row = first; row < last; ++row) {
+          uint8_t* dst = output + first_tile_offset(row, dimension_count - 1) * element_size;
+          const uint8_t* src = input + row * row_bytes;
+          for (int64_t repeat = 0; repeat < innermost_repeats; ++repeat) {
+            memcpy(dst, src, row_bytes);
+            dst += row_bytes;
+          }
+        }
+      });
+
+  // Tile data for other axes, innermost first. The first tile of each axis is complete once all the axes inside it
+  // have been tiled, so it can be copied to the remaining tiles of that axis.
+  for (size_t axis = dimension_count - 1; axis-- > 0;) {
+    const int64_t num_repeats = repeats[axis] - 1;
+    if (num_repeats == 0) {
+      continue;
     }
+
+    const size_t block_size = input_shape[axis] * output_pitches[axis] * element_size;
+    const int64_t num_blocks = input_tensor.Shape().SizeToDimension(axis);
+    ParallelCopyBlocks(tp, num_blocks * num_repeats, block_size, [&](std::ptrdiff_t i) {
+      uint8_t* copy = output + first_tile_offset(i / num_repeats, axis) * element_size;
+      return std::make_pair(copy + (i % num_repeats + 1) * block_size, static_cast<const uint8_t*>(copy));
+    });
   }
+
   return Status::OK();
 }
 
@@ -169,12 +183,14 @@ Status Tile::Compute(OpKernelContext* ctx) const {
     return Status::OK();
   }
 
+  concurrency::ThreadPool* tp = ctx->GetOperatorThreadPool();
+
   // Repeat tensor has all 1s in it
   if (output_shape == input_shape) {
     // TODO: Handle string copies when the kernel eventually supports string type.
     // For now, it shouldn't throw in the enforce as the kernel doesn't claim string support
     ORT_ENFORCE(!input_tensor.IsDataType<std::string>(), "Tile doesn't support string type yet");
-    memcpy(output_tensor.MutableDataRaw(), input_tensor.DataRaw(), input_tensor.SizeInBytes());
+    ParallelCopy(tp, output_tensor.MutableDataRaw(), input_tensor.DataRaw(), input_tensor.SizeInBytes());
     return Status::OK();
   }
 
@@ -193,48 +209,37 @@ Status Tile::Compute(OpKernelContext* ctx) const {
     // For now, it shouldn't throw in the enforce as the kernel doesn't claim string support
     ORT_ENFORCE(!input_tensor.IsDataType<std::string>(), "Tile doesn't support string type yet");
 
-    int8_t* output_data_casted = reinterpret_cast<int8_t*>(output_tensor.MutableDataRaw());
-    const int8_t* input_data_casted = reinterpret_cast<const int8_t*>(input_tensor.DataRaw());
-    const void* input_data_raw = input_tensor.DataRaw();
+    uint8_t* output_data_casted = reinterpret_cast<uint8_t*>(output_tensor.MutableDataRaw());
+    const uint8_t* input_data_casted = reinterpret_cast<const uint8_t*>(input_tensor.DataRaw());
 
     if (!is_batched_memcpy) {
       size_t copy_bytes = input_tensor.SizeInBytes();
-      // TODO: Add multi-threading logic if num_of_copies_per_batch is large enough
-      for (size_t i = 0; i < num_of_copies_per_batch; ++i) {
-        memcpy(static_cast<void*>(output_data_casted), input_data_raw, copy_bytes);
-        output_data_casted += copy_bytes;
-      }
+      ParallelCopyBlocks(tp, static_cast<std::ptrdiff_t>(num_of_copies_per_batch), copy_bytes, [&](std::ptrdiff_t i) {
+        return std::make_pair(output_data_casted + i * copy_bytes, input_data_casted);
+      });
     } else {
       size_t copy_bytes = num_of_elements_per_batch * input_tensor.DataType()->Size();
       size_t batch_count = static_cast<size_t>(input_tensor.Shape()[0]);  // The tensor is atleast 1-D- this is safe
+      const std::ptrdiff_t copies_per_batch = static_cast<std::ptrdiff_t>(num_of_copies_per_batch);
 
-      // TODO: Multi-thread if needed
-      for (size_t batch = 0; batch < batch_count; ++batch) {
-        for (size_t i = 0; i < num_of_copies_per_batch; ++i) {
-          memcpy(static_cast<void*>(output_data_casted), static_cast<const void*>(input_data_casted), copy_bytes);
-          output_data_casted += copy_bytes;
-        }
-        input_data_casted += copy_bytes;
-      }
+      ParallelCopyBlocks(tp, static_cast<std::ptrdiff_t>(batch_count) * copies_per_batch, copy_bytes, [&](std::ptrdiff_t i) {
+        return std::make_pair(output_data_casted + i * copy_bytes,
+                              input_data_casted + (i / copies_per_batch) * copy_bytes);
+      });
 
       // Now account for batch dim repeat
       if (num_of_batch_copies > 1) {
-        // reset some values
-        output_data_casted = reinterpret_cast<int8_t*>(output_tensor.MutableDataRaw());
         copy_bytes *= num_of_copies_per_batch * batch_count;
-        int8_t* copy_ptr = output_data_casted + copy_bytes;
-
-        for (size_t i = 1; i < num_of_batch_copies; ++i) {
-          memcpy(static_cast<void*>(copy_ptr), static_cast<const void*>(output_data_casted), copy_bytes);
-          copy_ptr += copy_bytes;
-        }
+        ParallelCopyBlocks(tp, static_cast<std::ptrdiff_t>(num_of_batch_copies - 1), copy_bytes, [&](std::ptrdiff_t i) {
+          return std::make_pair(output_data_casted + (i + 1) * copy_bytes,
+                                static_cast<const uint8_t*>(output_data_casted));
+        });
       }
     }
 
     return Status::OK();
   }
 
-  TensorAxisCounters input_counters(input_tensor);
   TensorPitches output_pitches(output_tensor);
 
   static_assert(sizeof(float) == sizeof(int32_t), "Float and Int32 are of different sizes");
@@ -243,21 +248,21 @@ Status Tile::Compute(OpKernelContext* ctx) const {
   if (input_tensor.IsDataType<float>() ||
       input_tensor.IsDataType<int32_t>() ||
       input_tensor.IsDataType<uint32_t>())
-    return TileCoreForFixedSizeTypes(input_tensor, output_tensor, repeats, input_counters, output_pitches, sizeof(float));
+    return TileCoreForFixedSizeTypes(input_tensor, output_tensor, repeats, output_pitches, sizeof(float), tp);
 
   if (input_tensor.IsDataType<double>() || input_tensor.IsDataType<int64_t>() ||
       input_tensor.IsDataType<uint64_t>())
-    return TileCoreForFixedSizeTypes(input_tensor, output_tensor, repeats, input_counters, output_pitches, sizeof(double));
+    return TileCoreForFixedSizeTypes(input_tensor, output_tensor, repeats, output_pitches, sizeof(double), tp);
 
   else if (input_tensor.IsDataType<int8_t>() ||
            input_tensor.IsDataType<uint8_t>())
-    return TileCoreForFixedSizeTypes(input_tensor, output_tensor, repeats, input_counters, output_pitches, sizeof(int8_t));
+    return TileCoreForFixedSizeTypes(input_tensor, output_tensor, repeats, output_pitches, sizeof(int8_t), tp);
 
   if (input_tensor.IsDataType<int16_t>() || input_tensor.IsDataType<uint16_t>())
-    return TileCoreForFixedSizeTypes(input_tensor, output_tensor, repeats, input_counters, output_pitches, sizeof(int16_t));
+    return TileCoreForFixedSizeTypes(input_tensor, output_tensor, repeats, output_pitches, sizeof(int16_t), tp);
 
   else if (input_tensor.IsDataType<bool>())
-    return TileCoreForFixedSizeTypes(input_tensor, output_tensor, repeats, input_counters, output_pitches, sizeof(bool));
+    return TileCoreForFixedSizeTypes(input_tensor, output_tensor, repeats, output_pitches, sizeof(bool), tp);
 
   // TODO: Support 'string' and 'float16' types for completeness
   else
@@ -395,131 +395,297 @@ static Status UpsampleLinear(const T* input,
 }
 */
 
-struct BilinearParams {
-  std::vector<float> x_original;
-  std::vector<float> y_original;
-
-  BufferUniquePtr idx_scale_data_buffer_holder;
-
-  int64_t* input_width_mul_y1;
-  int64_t* input_width_mul_y2;
-
-  int64_t* in_x1;
-  int64_t* in_x2;
-
-  float* dx1;
-  float* dx2;
-
-  float* dy1;
-  float* dy2;
+// Per axis interpolation table shared by the bilinear and bicubic paths.
+// For every output coordinate along the axis it holds the `taps` input coordinates that contribute to it
+// (clamped to the input range) along with their weights, and whether the original coordinate falls outside
+// the input (in which case the extrapolation value is used when extrapolation is enabled).
+// The tables are built once per Compute call and shared by all the batches and channels.
+struct ResizeAxisTable {
+  size_t taps;
+  std::vector<int64_t> index;    // output_size * taps
+  std::vector<float> weight;     // output_size * taps
+  std::vector<uint8_t> outside;  // output_size
 };
 
-// The following method supports a 4-D input in 'Linear mode'
-// that amounts to 'Bilinear' Upsampling/Resizing in the sense that it assumes
-// the scale values for the outermost 2 dimensions are 1.
-// This is the common use-case where the 4-D input (batched multi-channel images)
-// is usually of shape [N, C, H, W] and the scales are [1.0, 1.0, height_scale, width_scale]
-static BilinearParams SetupUpsampleBilinear(int64_t input_height,
-                                            int64_t input_width,
-                                            int64_t output_height,
-                                            int64_t output_width,
-                                            float height_scale,
-                                            float width_scale,
-                                            const std::vector<float>& roi,
-                                            AllocatorPtr& alloc,
-                                            const GetOriginalCoordinateFunc& get_original_coordinate) {
-  BilinearParams p;
+static float GetOriginalCoordinateForAxis(int64_t output_coordinate,
+                                          int64_t input_size,
+                                          int64_t output_size,
+                                          float scale,
+                                          float roi_start,
+                                          float roi_end,
+                                          const GetOriginalCoordinateFunc& get_original_coordinate) {
+  return scale == 1 ? static_cast<float>(output_coordinate)
+                    : get_original_coordinate(static_cast<float>(output_coordinate), scale,
+                                              static_cast<float>(output_size),
+                                              static_cast<float>(input_size),
+                                              roi_start, roi_end);
+}
 
-  p.x_original.reserve(output_width);
-  p.y_original.reserve(output_height);
+static ResizeAxisTable SetupLinearAxisTable(int64_t input_size,
+                                            int64_t output_size,
+                                            float scale,
+                                            float roi_start,
+                                            float roi_end,
+                                            const GetOriginalCoordinateFunc& get_original_coordinate) {
+  ResizeAxisTable table;
+  table.taps = 2;
+  table.index.resize(SafeInt<size_t>(output_size) * 2);
+  table.weight.resize(SafeInt<size_t>(output_size) * 2);
+  table.outside.resize(static_cast<size_t>(output_size));
+
+  for (int64_t o = 0; o < output_size; ++o) {
+    float in = GetOriginalCoordinateForAxis(o, input_size, output_size, scale, roi_start, roi_end,
+                                            get_original_coordinate);
+    table.outside[o] = (in < 0 || in > static_cast<float>(input_size - 1)) ? 1 : 0;
+    in = std::max(0.0f, std::min(in, static_cast<float>(input_size - 1)));
+
+    const int64_t in_1 = std::min(static_cast<int64_t>(in), input_size - 1);
+    const int64_t in_2 = std::min(in_1 + 1, input_size - 1);
+    float d_1 = std::fabs(in - in_1);
+    float d_2 = std::fabs(in - in_2);
+    if (in_1 == in_2) {
+      d_1 = 0.5f;
+      d_2 = 0.5f;
+    }
 
-  // For each index in the output height and output width, cache its corresponding indices in the input
-  // while multiplying it with the input stride for that dimension (cache because we don't have to re-compute
-  // each time we come across the output width/ output height value while iterating the output image tensor
-  SafeInt<size_t> idx_buffer_size = SafeInt<size_t>(2) * sizeof(int64_t) * (output_height + output_width);
+    // the weight of an input coordinate is the distance to the other one
+    table.index[2 * o] = in_1;
+    table.index[2 * o + 1] = in_2;
+    table.weight[2 * o] = d_2;
+    table.weight[2 * o + 1] = d_1;
+  }
 
-  // For each index in the output height and output width, cache its corresponding "weights/scales" for its
-  // corresponding indices in the input which proportionately indicates how much they will influence the final
-  // pixel value in the output
-  // (cache because we don't have to re-compute each time we come across the output width/output height
-  // value while iterating the output image tensor
-  SafeInt<size_t> scale_buffer_size = SafeInt<size_t>(2) * sizeof(float_t) * (output_height + output_width);
+  return table;
+}
 
-  // Limit number of allocations to just 1
-  auto inx_scale_data_buffer = alloc->Alloc(idx_buffer_size + scale_buffer_size);
-  p.idx_scale_data_buffer_holder = BufferUniquePtr(inx_scale_data_buffer, BufferDeleter(alloc));
+// Returns the rows of the input that contribute to the output given the table of the height axis, and fills
+// `row_slot` with the position of each such row in the returned list (-1 for the rows that are never used)
+static std::vector<int64_t> GetContributingRows(const ResizeAxisTable& y_table,
+                                                int64_t input_height,
+                                                bool use_extrapolation,
+                                                std::vector<int64_t>& row_slot) {
+  row_slot.assign(static_cast<size_t>(input_height), -1);
+  for (size_t y = 0, end = y_table.outside.size(); y < end; ++y) {
+    if (use_extrapolation && y_table.outside[y]) {
+      continue;
+    }
+    for (size_t t = 0; t < y_table.taps; ++t) {
+      row_slot[static_cast<size_t>(y_table.index[y * y_table.taps + t])] = 0;
+    }
+  }
 
-  // Get pointers to appropriate memory locations in the scratch buffer
-  auto* idx_data = static_cast<int64_t*>(p.idx_scale_data_buffer_holder.get());
+  std::vector<int64_t> rows;
+  for (int64_t r = 0; r < input_height; ++r) {
+    if (row_slot[r] == 0) {
+      row_slot[r] = static_cast<int64_t>(rows.size());
+      rows.push_back(r);
+    }
+  }
+  return rows;
+}
 
-  // input_width is the stride for the height dimension
-  p.input_width_mul_y1 = idx_data;
-  p.input_width_mul_y2 = p.input_width_mul_y1 + output_height;
+// Interpolates a single input row of `input_width` pixels of `pixel_size` elements along the width axis
+template <size_t Taps, typename T>
+static void InterpolateRowHorizontally(const T* input_row,
+                                       int64_t output_width,
+                                       int64_t pixel_size,
+                                       const ResizeAxisTable& x_table,
+                                       float* output_row) {
+  const int64_t* index = x_table.index.data();
+  const float* weight = x_table.weight.data();
+
+  if (pixel_size == 1) {
+    for (int64_t x = 0; x < output_width; ++x, index += Taps, weight += Taps) {
+      float result = 0;
+      for (size_t t = 0; t < Taps; ++t) {
+        result += weight[t] * input_row[index[t]];
+      }
+      output_row[x] = result;
+    }
+    return;
+  }
 
-  // stride for width is 1 (no multiplication needed)
-  p.in_x1 = p.input_width_mul_y1 + 2 * output_height;
-  p.in_x2 = p.in_x1 + output_width;
+  // channels last: every tap is a contiguous pixel so vectorize over the channels
+  for (int64_t x = 0; x < output_width; ++x, index += Taps, weight += Taps) {
+    float* output_pixel = output_row + x * pixel_size;
+    const T* input_pixel = input_row + index[0] * pixel_size;
+    for (int64_t c = 0; c < pixel_size; ++c) {
+      output_pixel[c] = weight[0] * input_pixel[c];
+    }
+    for (size_t t = 1; t < Taps; ++t) {
+      input_pixel = input_row + index[t] * pixel_size;
+      for (int64_t c = 0; c < pixel_size; ++c) {
+        output_pixel[c] += weight[t] * input_pixel[c];
+      }
+    }
+  }
+}
 
-  auto* scale_data = reinterpret_cast<float*>(p.in_x2 + output_width);
+// Resizes the two innermost spatial axes of `num_planes` planes of [input_height, input_width, pixel_size]
+// elements with separable interpolation: every input row that contributes to the output is interpolated along
+// the width axis into a scratch buffer, then every output row is a weighted sum of `taps` of these rows.
+// `pixel_size` is 1 for NCHW data (a plane per channel) and the number of channels for NHWC data (a plane per
+// batch), in which case the inner loops run over the contiguous channels of a pixel.
+template <size_t Taps>
+static void SeparableResize2D(int64_t num_planes,
+                              int64_t input_height,
+                              int64_t input_width,
+                              int64_t pixel_size,
+                              int64_t output_height,
+                              int64_t output_width,
+                              const ResizeAxisTable& y_table,
+                              const ResizeAxisTable& x_table,
+                              bool use_extrapolation,
+                              float extrapolation_value,
+                              const float* XdataBase,
+                              float* YdataBase,
+                              AllocatorPtr& alloc,
+                              concurrency::ThreadPool* tp) {
+  std::vector<int64_t> row_slot;
+  const std::vector<int64_t> rows = GetContributingRows(y_table, input_height, use_extrapolation, row_slot);
+  const int64_t num_rows = static_cast<int64_t>(rows.size());
+
+  const int64_t input_row_size = input_width * pixel_size;
+  const int64_t output_row_size = output_width * pixel_size;
+
+  float* scratch = nullptr;
+  BufferUniquePtr scratch_buffer_holder;
+  if (num_rows > 0) {
+    scratch = static_cast<float*>(alloc->Alloc(SafeInt<size_t>(sizeof(float)) * num_planes * num_rows *
+                                               output_row_size));
+    scratch_buffer_holder = BufferUniquePtr(scratch, BufferDeleter(alloc));
+  }
 
-  p.dy1 = scale_data;
-  p.dy2 = p.dy1 + output_height;
+  // horizontal pass over the contributing rows of every plane
+  concurrency::ThreadPool::TryParallelFor(
+      tp, static_cast<std::ptrdiff_t>(num_planes * num_rows),
+      TensorOpCost{static_cast<double>(Taps * output_row_size * sizeof(float)),
+                   static_cast<double>(output_row_size * sizeof(float)),
+                   static_cast<double>(2 * Taps * output_row_size)},
+      [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+        for (std::ptrdiff_t i = first; i < last; ++i) {
+          const int64_t plane = i / num_rows;
+          const int64_t row = rows[i % num_rows];
+          InterpolateRowHorizontally<Taps>(XdataBase + (plane * input_height + row) * input_row_size,
+                                           output_width, pixel_size, x_table, scratch + i * output_row_size);
+        }
+      });
+
+  // vertical pass over the output rows of every plane
+  concurrency::ThreadPool::TryParallelFor(
+      tp, static_cast<std::ptrdiff_t>(num_planes * output_height),
+      TensorOpCost{static_cast<double>(Taps * output_row_size * sizeof(float)),
+                   static_cast<double>(output_row_size * sizeof(float)),
+                   static_cast<double>(2 * Taps * output_row_size)},
+      [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+        for (std::ptrdiff_t i = first; i < last; ++i) {
+          const int64_t plane = i / output_height;
+          const int64_t y = i % output_height;
+          float* Ydata = YdataBase + i * output_row_size;
+
+          if (use_extrapolation && y_table.outside[y]) {
+            std::fill_n(Ydata, output_row_size, extrapolation_value);
+            continue;
+          }
 
-  p.dx1 = p.dy1 + 2 * output_height;
-  p.dx2 = p.dx1 + output_width;
+          const float* source[Taps];
+          float weight[Taps];
+          for (size_t t = 0; t < Taps; ++t) {
+            source[t] = scratch + (plane * num_rows + row_slot[y_table.index[y * Taps + t]]) * output_row_size;
+            weight[t] = y_table.weight[y * Taps + t];
+          }
 
-  // Start processing
-  auto roi_y_start = roi.size() / 2 - 2;
-  auto roi_y_end = roi.size() - 2;
-  for (int64_t y = 0; y < output_height; ++y) {
-    float in_y = height_scale == 1 ? static_cast<float>(y)
-                                   : get_original_coordinate(static_cast<float>(y), height_scale,
-                                                             static_cast<float>(output_height),
-                                                             static_cast<float>(input_height),
-                                                             roi[roi_y_start], roi[roi_y_end]);
-    p.y_original.emplace_back(in_y);
-    in_y = std::max(0.0f, std::min(in_y, static_cast<float>(input_height - 1)));
+          for (int64_t j = 0; j < output_row_size; ++j) {
+            float result = weight[0] * source[0][j];
+            for (size_t t = 1; t < Taps; ++t) {
+              result += weight[t] * source[t][j];
+            }
+            Ydata[j] = result;
+          }
 
-    const int64_t in_y1 = std::min(static_cast<int64_t>(in_y), input_height - 1);
-    const int64_t in_y2 = std::min(in_y1 + 1, input_height - 1);
-    p.dy1[y] = std::fabs(in_y - in_y1);
-    p.dy2[y] = std::fabs(in_y - in_y2);
+          if (use_extrapolation) {
+            for (int64_t x = 0; x < output_width; ++x) {
+              if (x_table.outside[x]) {
+                std::fill_n(Ydata + x * pixel_size, pixel_size, extrapolation_value);
+              }
+            }
+          }
+        }
+      });
+}
 
-    if (in_y1 == in_y2) {
-      p.dy1[y] = 0.5f;
-      p.dy2[y] = 0.5f;
-    }
+// Bilinear resize of integer data. Each output element is computed directly from its 4 neighbors in the same
+// order as the float reference so that truncation to the integer type gives the same results.
+template <typename T>
+static void BilinearResize2DDirect(int64_t num_planes,
+                                   int64_t input_height,
+                                   int64_t input_width,
+                                   int64_t pixel_size,
+                                   int64_t output_height,
+                                   int64_t output_width,
+                                   const ResizeAxisTable& y_table,
+                                   const ResizeAxisTable& x_table,
+                                   bool use_extrapolation,
+                                   float extrapolation_value,
+                                   const T* XdataBase,
+                                   T* YdataBase,
+                                   concurrency::ThreadPool* tp) {
+  const int64_t input_row_size = input_width * pixel_size;
+  const int64_t output_row_size = output_width * pixel_size;
+
+  concurrency::ThreadPool::TryParallelFor(
+      tp, static_cast<std::ptrdiff_t>(num_planes * output_height),
+      TensorOpCost{static_cast<double>(4 * output_row_size * sizeof(T)),
+                   static_cast<double>(output_row_size * sizeof(T)),
+                   static_cast<double>(12 * output_row_size)},
+      [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+        for (std::ptrdiff_t i = first; i < last; ++i) {
+          const int64_t plane = i / output_height;
+          const int64_t y = i % output_height;
+          T* Ydata = YdataBase + i * output_row_size;
+
+          if (use_extrapolation && y_table.outside[y]) {
+            std::fill_n(Ydata, output_row_size, static_cast<T>(extrapolation_value));
+            continue;
+          }
 
-    p.input_width_mul_y1[y] = input_width * in_y1;
-    p.input_width_mul_y2[y] = input_width * in_y2;
-  }
+          const T* Xdata = XdataBase + plane * input_height * input_row_size;
+          const T* row_1 = Xdata + y_table.index[2 * y] * input_row_size;
+          const T* row_2 = Xdata + y_table.index[2 * y + 1] * input_row_size;
+          const float dy2 = y_table.weight[2 * y];
+          const float dy1 = y_table.weight[2 * y + 1];
 
-  auto roi_x_start = roi.size() / 2 - 1;
-  auto roi_x_end = roi.size() - 1;
-  for (int64_t x = 0; x < output_width; ++x) {
-    float in_x = width_scale == 1 ? static_cast<float>(x)
-                                  : get_original_coordinate(static_cast<float>(x),
-                                                            width_scale,
-                                                            static_cast<float>(output_width),
-                                                            static_cast<float>(input_width),
-                                                            roi[roi_x_start], roi[roi_x_end]);
-    p.x_original.emplace_back(in_x);
-    in_x = std::max(0.0f, std::min(in_x, static_cast<float>(input_width - 1)));
+          for (int64_t x = 0; x < output_width; ++x) {
+            T* output_pixel = Ydata + x * pixel_size;
 
-    p.in_x1[x] = std::min(static_cast<int64_t>(in_x), input_width - 1);
-    p.in_x2[x] = std::min(p.in_x1[x] + 1, input_width - 1);
+            if (use_extrapolation && x_table.outside[x]) {
+              std::fill_n(output_pixel, pixel_size, static_cast<T>(extrapolation_value));
+              continue;
+            }
 
-    p.dx1[x] = std::fabs(in_x - p.in_x1[x]);
-    p.dx2[x] = std::fabs(in_x - p.in_x2[x]);
-    if (p.in_x1[x] == p.in_x2[x]) {
-      p.dx1[x] = 0.5f;
-      p.dx2[x] = 0.5f;
-    }
-  }
+            const int64_t in_x1 = x_table.index[2 * x] * pixel_size;
+            const int64_t in_x2 = x_table.index[2 * x + 1] * pixel_size;
+            const float dx2 = x_table.weight[2 * x];
+            const float dx1 = x_table.weight[2 * x + 1];
 
-  return p;
+            for (int64_t c = 0; c < pixel_size; ++c) {
+              output_pixel[c] = static_cast<T>(dx2 * dy2 * row_1[in_x1 + c] +
+                                               dx1 * dy2 * row_1[in_x2 + c] +
+                                               dx2 * dy1 * row_2[in_x1 + c] +
+                                               dx1 * dy1 * row_2[in_x2 + c]);
+            }
+          }
+        }
+      });
 }
 
+// The following method supports a 4-D input in 'Linear mode'
+// that amounts to 'Bilinear' Upsampling/Resizing in the sense that it assumes
+// the scale values for the outermost 2 dimensions are 1.
+// This is the common use-case where the 4-D input (batched multi-channel images)
+// is usually of shape [N, C, H, W] and the scales are [1.0, 1.0, height_scale, width_scale].
+// Channels last inputs of shape [N, H, W, C] with scales [1.0, height_scale, width_scale, 1.0] are supported
+// too (`is_nhwc`), which is the common layout of image preprocessing graphs.
 template <typename T>
 void UpsampleBilinear(int64_t batch_size,
                       int64_t num_channels,
@@ -530,6 +696,7 @@ void UpsampleBilinear(int64_t batch_size,
                       float height_scale,
                       float width_scale,
                       const std::vector<float>& roi,
+                      bool is_nhwc,
                       bool use_extrapolation,
                       float extrapolation_value,
                       const T* XdataBase,
@@ -537,41 +704,27 @@ void UpsampleBilinear(int64_t batch_size,
                       AllocatorPtr& alloc,
                       const GetOriginalCoordinateFunc& get_original_coordinate,
                       concurrency::ThreadPool* tp) {
-  BilinearParams p = SetupUpsampleBilinear(input_height, input_width, output_height, output_width,
-                                           height_scale, width_scale, roi,
-                                           alloc, get_original_coordinate);
-
-  for (int64_t n = 0; n < batch_size; ++n) {
-    concurrency::ThreadPool::TrySimpleParallelFor(
-        tp, num_channels,
-        [&](std::ptrdiff_t c) {
-          const T* Xdata = XdataBase + (n * num_channels + c) * (input_height * input_width);
-          T* Ydata = YdataBase + (n * num_channels + c) * (output_height * output_width);
-          for (int64_t y = 0; y < output_height; ++y) {
-            for (int64_t x = 0; x < output_width; ++x) {
-              // when use_extrapolation is set and original index of x or y is out of the dim range
-              // then use extrapolation_value as the output value.
-              if (use_extrapolation &&
-                  ((p.y_original[y] < 0 || p.y_original[y] > static_cast<float>(input_height - 1)) ||
-                   (p.x_original[x] < 0 || p.x_original[x] > static_cast<float>(input_width - 1)))) {
-                Ydata[output_width * y + x] = static_cast<T>(extrapolation_value);
-                continue;
-              }
-
-              T X11 = Xdata[p.input_width_mul_y1[y] + p.in_x1[x]];
-              T X21 = Xdata[p.input_width_mul_y1[y] + p.in_x2[x]];
-              T X12 = Xdata[p.input_width_mul_y2[y] + p.in_x1[x]];
-              T X22 = Xdata[p.input_width_mul_y2[y] + p.in_x2[x]];
-
-              Ydata[output_width * y + x] = static_cast<T>(p.dx2[x] * p.dy2[y] * X11 +
-                                                           p.dx1[x] * p.dy2[y] * X21 +
-                                                           p.dx2[x] * p.dy1[y] * X12 +
-                                                           p.dx1[x] * p.dy1[y] * X22);
-            }
-          }
-          Xdata += input_height * input_width;
-          Ydata += output_width * output_height;
-        });
+  const size_t rank = roi.size() / 2;
+  const size_t height_axis = is_nhwc ? rank - 3 : rank - 2;
+  const size_t width_axis = height_axis + 1;
+
+  const ResizeAxisTable y_table = SetupLinearAxisTable(input_height, output_height, height_scale,
+                                                       roi[height_axis], roi[rank + height_axis],
+                                                       get_original_coordinate);
+  const ResizeAxisTable x_table = SetupLinearAxisTable(input_width, output_width, width_scale,
+                                                       roi[width_axis], roi[rank + width_axis],
+                                                       get_original_coordinate);
+
+  const int64_t num_planes = is_nhwc ? batch_size : batch_size * num_channels;
+  const int64_t pixel_size = is_nhwc ? num_channels : 1;
+
+  if constexpr (std::is_same<T, float>::value) {
+    SeparableResize2D<2>(num_planes, input_height, input_width, pixel_size, output_height, output_width,
+                         y_table, x_table, use_extrapolation, extrapolation_value, XdataBase, YdataBase, alloc, tp);
+  } else {
+    ORT_UNUSED_PARAMETER(alloc);
+    BilinearResize2DDirect(num_planes, input_height, input_width, pixel_size, output_height, output_width,
+                           y_table, x_table, use_extrapolation, extrapolation_value, XdataBase, YdataBase, tp);
   }
 }
 
@@ -829,50 +982,53 @@ std::array<float, CubicModeGridLength> GetCubicCoeffs(float s, float cubic_coeff
   return coeffs;
 }
 
-// Get the tensor data at the requested coordinate
-template <typename T>
-T GetDataForCoordinate(const T* Xdata,
-                       int64_t x, int64_t y,
-                       int64_t input_height, int64_t input_width) {
-  x = std::max(static_cast<int64_t>(0), std::min(x, input_width - 1));
-  y = std::max(static_cast<int64_t>(0), std::min(y, input_height - 1));
-  return Xdata[y * input_width + x];
-}
-
-// Computes cubic convolution interpolation in 1D
-template <typename T>
-float CubicInterpolation1D(const T* Xdata,
-                           int64_t x,
-                           int64_t y,
-                           int64_t input_height,
-                           int64_t input_width,
-                           std::array<float, CubicModeGridLength>& coeff_array,
-                           float coeff_sum,
-                           std::unordered_map<int64_t, float>& cache) {
-  // When calculating cubic interpolation we move the 4*4 grid across the original data and therefore there is
-  // opportunity to cache the results for previously seen combinations.
-  // Check if the result is already available in the cache
-  auto grid_start_pos = (y)*input_width + (x - 1);
-  if (cache.find(grid_start_pos) != cache.end()) {
-    return cache[grid_start_pos];
-  }
+static ResizeAxisTable SetupCubicAxisTable(int64_t input_size,
+                                           int64_t output_size,
+                                           float scale,
+                                           float roi_start,
+                                           float roi_end,
+                                           float cubic_coeff_a,
+                                           bool exclude_outside,
+                                           const GetOriginalCoordinateFunc& get_original_coordinate) {
+  ResizeAxisTable table;
+  table.taps = CubicModeGridLength;
+  table.index.resize(SafeInt<size_t>(output_size) * CubicModeGridLength);
+  table.weight.resize(SafeInt<size_t>(output_size) * CubicModeGridLength);
+  table.outside.resize(static_cast<size_t>(output_size));
+
+  for (int64_t o = 0; o < output_size; ++o) {
+    float in = GetOriginalCoordinateForAxis(o, input_size, output_size, scale, roi_start, roi_end,
+                                            get_original_coordinate);
+    table.outside[o] = (in < 0 || in > static_cast<float>(input_size - 1)) ? 1 : 0;
+
+    // for 1D cubic interpolation 4 samples are used. 2 on the left and 2 on the right of `in`
+    const auto in_int = static_cast<int64_t>(std::floor(in));
+    auto coeffs = GetCubicCoeffs(in - in_int, cubic_coeff_a);
+
+    float coeff_sum = 1;
+    if (exclude_outside) {
+      // When true, the weight of sampling locations outside the grid will be set to 0
+      // and the weight will be renormalized so that their sum is 1.0
+      coeff_sum = 0;
+      for (int64_t i = 0, val = in_int - 1; i < static_cast<int64_t>(CubicModeGridLength); ++i, ++val) {
+        if (val < 0 || val >= input_size) {
+          coeffs[i] = 0.0f;
+        }
+        coeff_sum += coeffs[i];
+      }
+    }
 
-  // get the neighbors in 1D and find interpolation for this dimension
-  // for 1D cubic interpolation 4 samples are used. 2 on the left and 2 on the right of x
-  float result = 0;
-  for (int i = 0, j = -1; i < static_cast<int>(CubicModeGridLength); i++, j++) {
-    auto orig_data = GetDataForCoordinate(Xdata, x + j, y, input_height, input_width);
-    result += coeff_array[i] / coeff_sum * orig_data;
+    for (int64_t i = 0, val = in_int - 1; i < static_cast<int64_t>(CubicModeGridLength); ++i, ++val) {
+      table.index[o * CubicModeGridLength + i] = std::max(static_cast<int64_t>(0), std::min(val, input_size - 1));
+      table.weight[o * CubicModeGridLength + i] = coeffs[i] / coeff_sum;
+    }
   }
-  cache[grid_start_pos] = result;
 
-  return result;
+  return table;
 }
-#if defined(_MSC_VER)
-#pragma warning(push)
-#pragma warning(disable : 6001)
-#endif
-template <typename T>
+
+// Bicubic resize of 2-D inputs or 4-D inputs with the corresponding outermost 2 scale values being 1
+// (or the outermost and innermost scale values for channels last inputs, see `is_nhwc`)
 void ResizeBiCubic(int64_t batch_size,
                    int64_t num_channels,
                    int64_t input_height,
@@ -886,140 +1042,28 @@ void ResizeBiCubic(int64_t batch_size,
                    float extrapolation_value,
                    bool exclude_outside,
                    const std::vector<float>& roi,
-                   const T* Xdata,
-                   T* Ydata,
-                   const GetOriginalCoordinateFunc& get_original_coordinate) {
-  std::vector<float> y_original;
-  y_original.reserve(output_height);
-
-  std::vector<float> x_original;
-  x_original.reserve(output_width);
-
-  std::unordered_map<float, std::array<float, CubicModeGridLength>> cubic_coeffs;
-  std::unordered_map<float, std::unordered_map<int64_t, float>> coeff_to_1Dinterpolation_map;
-  auto roi_y_start = roi.size() / 2 - 2;
-  auto roi_y_end = roi.size() - 2;
-  auto roi_x_start = roi.size() / 2 - 1;
-  auto roi_x_end = roi.size() - 1;
-
-  // generate coefficients in y direction
-  for (int64_t y = 0; y < output_height; ++y) {
-    float in_y = height_scale == 1 ? static_cast<float>(y)
-                                   : get_original_coordinate(static_cast<float>(y), height_scale,
-                                                             static_cast<float>(output_height),
-                                                             static_cast<float>(input_height),
-                                                             roi[roi_y_start], roi[roi_y_end]);
-    y_original.emplace_back(in_y);
-    auto s = y_original[y] - std::floor(y_original[y]);
-    if (cubic_coeffs.find(s) == cubic_coeffs.end()) {
-      cubic_coeffs[s] = GetCubicCoeffs(s, cubic_coeff_a);
-      coeff_to_1Dinterpolation_map[s] = {};
-    }
-  }
-
-  // generate coefficients in x direction
-  for (int64_t x = 0; x < output_width; ++x) {
-    float in_x = width_scale == 1 ? static_cast<float>(x)
-                                  : get_original_coordinate(static_cast<float>(x),
-                                                            width_scale,
-                                                            static_cast<float>(output_width),
-                                                            static_cast<float>(input_width),
-                                                            roi[roi_x_start], roi[roi_x_end]);
-    x_original.emplace_back(in_x);
-    auto s = x_original[x] - std::floor(x_original[x]);
-    if (cubic_coeffs.find(s) == cubic_coeffs.end()) {
-      cubic_coeffs[s] = GetCubicCoeffs(s, cubic_coeff_a);
-      coeff_to_1Dinterpolation_map[s] = {};
-    }
-  }
-
-  // setup up temp arrays to hold coefficients when exclude_outside is set to true
-  std::array<float, CubicModeGridLength> y_coeff_holder;
-  std::array<float, CubicModeGridLength> x_coeff_holder;
-  float y_coeff_sum = 1;
-  float x_coeff_sum = 1;
-
-  for (int64_t n = 0; n < batch_size; n++) {
-    for (int64_t c = 0; c < num_channels; c++) {
-      for (int64_t y = 0; y < output_height; ++y) {
-        auto in_y = y_original[y];
-
-        // when use_extrapolation is set and original index is out of the dim range
-        // then use extrapolation_value as the output value.
-        if (use_extrapolation && (in_y < 0 || in_y > static_cast<float>(input_height - 1))) {
-          for (int64_t x = 0; x < output_width; ++x) {
-            Ydata[y * output_width + x] = extrapolation_value;
-          }
-          continue;
-        }
-
-        auto y_int = static_cast<int64_t>(std::floor(in_y));
-        auto& coeff_y = exclude_outside ? y_coeff_holder : cubic_coeffs[in_y - y_int];
-        y_coeff_sum = 1;
-
-        if (exclude_outside) {
-          // When true, the weight of sampling locations outside the grid will be set to 0
-          // and the weight will be renormalized so that their sum is 1.0
-          y_coeff_sum = 0;
-          auto& orig_y_coeffs = cubic_coeffs[in_y - y_int];
-          for (int64_t i = 0, y_val = y_int - 1; y_val <= y_int + 2; y_val++, i++) {
-            y_coeff_holder[i] = (y_val < 0 || y_val >= static_cast<float>(input_height)) ? 0.0f : orig_y_coeffs[i];
-            y_coeff_sum += y_coeff_holder[i];
-          }
-        }
-
-        for (int64_t x = 0; x < output_width; ++x) {
-          auto in_x = x_original[x];
-
-          // when use_extrapolation is set and original index is out of the dim range
-          // then use extrapolation_value as the output value.
-          if (use_extrapolation && (in_x < 0 || in_x > static_cast<float>(input_width - 1))) {
-            Ydata[y * output_width + x] = extrapolation_value;
-            continue;
-          }
-
-          auto x_int = static_cast<int64_t>(std::floor(in_x));
-          auto s_x = static_cast<float>(in_x - x_int);
-          auto& coeff_x = exclude_outside ? x_coeff_holder : cubic_coeffs[s_x];
-          x_coeff_sum = 1;
-
-          if (exclude_outside) {
-            // When true, the weight of sampling locations outside the grid will be set to 0
-            // and the weight will be renormalized so that their sum is 1.0
-            x_coeff_sum = 0;
-            auto& orig_x_coeff = cubic_coeffs[s_x];
-            for (int64_t i = 0, x_val = x_int - 1; x_val <= x_int + 2; x_val++, i++) {
-              x_coeff_holder[i] = (x_val < 0 || x_val >= static_cast<float>(input_width)) ? 0.0f : orig_x_coeff[i];
-              x_coeff_sum += x_coeff_holder[i];
-            }
-          }
-
-          // Compute cubic interpolation in x dimension using the x coefficients.
-          // From the result of cubic interpolation in x dim, compute cubic interpolation in y dimension
-          auto& interpolation_result_cache = coeff_to_1Dinterpolation_map[s_x];
-          float result = 0;
-          for (int64_t y_val = y_int - 1, i = 0; y_val <= y_int + 2; y_val++, i++) {
-            auto x_interpolation_result = CubicInterpolation1D(Xdata, x_int, y_val,
-                                                               input_height, input_width, coeff_x, x_coeff_sum,
-                                                               interpolation_result_cache);
-            result += x_interpolation_result * coeff_y[i] / y_coeff_sum;
-          }
-
-          Ydata[y * output_width + x] = static_cast<T>(result);
-        }
-      }
-
-      Xdata += input_height * input_width;
-      Ydata += output_height * output_width;
-
-      // clear the cache when moving to the next channel
-      coeff_to_1Dinterpolation_map.clear();
-    }
-  }
+                   bool is_nhwc,
+                   const float* Xdata,
+                   float* Ydata,
+                   AllocatorPtr& alloc,
+                   const GetOriginalCoordinateFunc& get_original_coordinate,
+                   concurrency::ThreadPool* tp) {
+  const size_t rank = roi.size() / 2;
+  const size_t height_axis = is_nhwc ? rank - 3 : rank - 2;
+  const size_t width_axis = height_axis + 1;
+
+  const ResizeAxisTable y_table = SetupCubicAxisTable(input_height, output_height, height_scale,
+                                                      roi[height_axis], roi[rank + height_axis],
+                                                      cubic_coeff_a, exclude_outside, get_original_coordinate);
+  const ResizeAxisTable x_table = SetupCubicAxisTable(input_width, output_width, width_scale,
+                                                      roi[width_axis], roi[rank + width_axis],
+                                                      cubic_coeff_a, exclude_outside, get_original_coordinate);
+
+  SeparableResize2D<CubicModeGridLength>(is_nhwc ? batch_size : batch_size * num_channels,
+                                         input_height, input_width, is_nhwc ? num_channels : 1,
+                                         output_height, output_width, y_table, x_table,
+                                         use_extrapolation, extrapolation_value, Xdata, Ydata, alloc, tp);
 }
-#if defined(_MSC_VER)
-#pragma warning(pop)
-#endif
 
 template <typename T>
 Status Upsample<T>::BaseCompute(OpKernelContext* context,
@@ -1068,19 +1112,23 @@ Status Upsample<T>::BaseCompute(OpKernelContext* context,
       //'bilinear' == 2-D input or 4-D input with outermost 2 scales as 1
       if (dims.size() == 2 || dims.size() == 4) {
         bool is_2D = dims.size() == 2;
+        bool is_nhwc = IsChannelsLastResize(scales);
 
         const int64_t batch_size = is_2D ? 1 : dims[0];
-        const int64_t num_channels = is_2D ? 1 : dims[1];
-        const int64_t input_height = is_2D ? dims[0] : dims[2];
-        const int64_t input_width = is_2D ? dims[1] : dims[3];
+        const int64_t num_channels = is_2D ? 1 : (is_nhwc ? dims[3] : dims[1]);
+        const int64_t input_height = is_2D ? dims[0] : (is_nhwc ? dims[1] : dims[2]);
+        const int64_t input_width = is_2D ? dims[1] : (is_nhwc ? dims[2] : dims[3]);
+
+        const int64_t output_height = is_2D ? output_dims[0] : (is_nhwc ? output_dims[1] : output_dims[2]);
+        const int64_t output_width = is_2D ? output_dims[1] : (is_nhwc ? output_dims[2] : output_dims[3]);
 
-        const int64_t output_height = is_2D ? output_dims[0] : output_dims[2];
-        const int64_t output_width = is_2D ? output_dims[1] : output_dims[3];
+        const float height_scale = is_2D ? scales[0] : (is_nhwc ? scales[1] : scales[2]);
+        const float width_scale = is_2D ? scales[1] : (is_nhwc ? scales[2] : scales[3]);
 
         AllocatorPtr alloc;
         ORT_RETURN_IF_ERROR(context->GetTempSpaceAllocator(&alloc));
         UpsampleBilinear(batch_size, num_channels, input_height, input_width, output_height, output_width,
-                         is_2D ? scales[0] : scales[2], is_2D ? scales[1] : scales[3], roi,
+                         height_scale, width_scale, roi, is_nhwc,
                          use_extrapolation_, extrapolation_value_, X->Data<T>(),
                          Y->MutableData<T>(), alloc, get_original_coordinate_,
                          output_height * output_width > 64 ? context->GetOperatorThreadPool() : nullptr);
@@ -1127,17 +1175,23 @@ Status Upsample<T>::BaseCompute(OpKernelContext* context,
       }
 
       bool is_2D = dims.size() == 2;
+      bool is_nhwc = IsChannelsLastResize(scales);
       const int64_t batch_size = is_2D ? 1 : dims[0];
-      const int64_t num_channels = is_2D ? 1 : dims[1];
-      const int64_t input_height = is_2D ? dims[0] : dims[2];
-      const int64_t input_width = is_2D ? dims[1] : dims[3];
-      const int64_t output_height = is_2D ? output_dims[0] : output_dims[2];
-      const int64_t output_width = is_2D ? output_dims[1] : output_dims[3];
-
+      const int64_t num_channels = is_2D ? 1 : (is_nhwc ? dims[3] : dims[1]);
+      const int64_t input_height = is_2D ? dims[0] : (is_nhwc ? dims[1] : dims[2]);
+      const int64_t input_width = is_2D ? dims[1] : (is_nhwc ? dims[2] : dims[3]);
+      const int64_t output_height = is_2D ? output_dims[0] : (is_nhwc ? output_dims[1] : output_dims[2]);
+      const int64_t output_width = is_2D ? output_dims[1] : (is_nhwc ? output_dims[2] : output_dims[3]);
+      const float height_scale = is_2D ? scales[0] : (is_nhwc ? scales[1] : scales[2]);
+      const float width_scale = is_2D ? scales[1] : (is_nhwc ? scales[2] : scales[3]);
+
+      AllocatorPtr alloc;
+      ORT_RETURN_IF_ERROR(context->GetTempSpaceAllocator(&alloc));
       ResizeBiCubic(batch_size, num_channels, input_height, input_width, output_height, output_width,
-                    is_2D ? scales[0] : scales[2], is_2D ? scales[1] : scales[3], cubic_coeff_a_, use_extrapolation_,
-                    extrapolation_value_, exclude_outside_, roi, X->Data<float>(),
-                    Y->MutableData<float>(), get_original_coordinate_);
+                    height_scale, width_scale, cubic_coeff_a_, use_extrapolation_,
+                    extrapolation_value_, exclude_outside_, roi, is_nhwc, X->Data<float>(),
+                    Y->MutableData<float>(), alloc, get_original_coordinate_,
+                    output_height * output_width > 64 ? context->GetOperatorThreadPool() : nullptr);
       return Status::OK();
     }
     default:
@@ -290,21 +290,30 @@ class UpsampleBase {
     if (UpsampleMode::LINEAR == mode) {
       ORT_ENFORCE(scales.size() == 2 ||
                       (scales.size() == 4 && scales[0] == 1 && scales[1] == 1) ||
+                      IsChannelsLastResize(scales) ||
                       scales.size() == 3 ||
                       (scales.size() == 5 && scales[0] == 1 && scales[1] == 1),
                   "'Linear' mode only support 2-D inputs or 3-D inputs ('Bilinear', 'Trilinear') "
-                  "or 4-D inputs or 5-D inputs with the corresponding outermost 2 scale values being 1 in the ",
+                  "or 4-D inputs or 5-D inputs with the corresponding outermost 2 scale values being 1 "
+                  "(or the outermost and innermost scale values of 4-D channels last inputs) in the ",
                   is_resize_ ? "Resize operator" : "Upsample operator");
     }
 
     else if (UpsampleMode::CUBIC == mode) {
-      ORT_ENFORCE(scales.size() == 2 || (scales.size() == 4 && scales[0] == 1 && scales[1] == 1),
+      ORT_ENFORCE(scales.size() == 2 || (scales.size() == 4 && scales[0] == 1 && scales[1] == 1) ||
+                      IsChannelsLastResize(scales),
                   "'Cubic' mode only support 2-D inputs ('Bicubic') or 4-D inputs "
-                  "with the corresponding outermost 2 scale values being 1 in the ",
+                  "with the corresponding outermost 2 scale values being 1 "
+                  "(or the outermost and innermost scale values of channels last inputs) in the ",
                   is_resize_ ? "Resize operator" : "Upsample operator");
     }
   }
 
+  // 4-D inputs that are resized along the 2 middle axes only are treated as [N, H, W, C] images
+  static bool IsChannelsLastResize(const std::vector<float>& scales) {
+    return scales.size() == 4 && scales[0] == 1 && scales[1] != 1 && scales[3] == 1;
+  }
+
   void
   ParseScalesData(const Tensor* scale, std::vector<float>& scales) const {
     const auto* scale_data = scale->template Data<float>();
@@ -5,6 +5,7 @@
 #include "gsl/gsl"
 
 #ifndef SHARED_PROVIDER
+#include "core/framework/string_tensor_view.h"
 #include "core/framework/utils.h"
 #endif
 #include "core/common/safeint.h"
@@ -367,6 +368,15 @@ inline void CopyCpuTensor(const Tensor* src, Tensor* tgt) {
   if (target != source) {
     auto is_string_type = utils::IsDataTypeString(src->DataType());
     if (is_string_type) {
+#ifndef SHARED_PROVIDER
+      // the target has std::string elements, the source may be in the string buffer layout
+      if (src->IsStringBuffer()) {
+        const StringTensorView strings(*src);
+        for (size_t i = 0; i < strings.Size(); ++i)
+          static_cast<std::string*>(target)[i].assign(strings[i].data(), strings[i].size());
+        return;
+      }
+#endif
       for (int64_t i = 0; i < src->Shape().Size(); ++i)
         static_cast<std::string*>(target)[i] = static_cast<const std::string*>(source)[i];
     } else {
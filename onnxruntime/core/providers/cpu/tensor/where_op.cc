@@ -197,7 +197,7 @@ using AllocTensorFunc = std::unique_ptr<Tensor> (*)(const TensorAllocator& alloc
 
 static std::unique_ptr<Tensor> UntypedSelect(OpKernelContext& context, bool target,
                                              const TensorAllocator& allocator, AllocTensorFunc allocate_tensor,
-                                             const ProcessBroadcastSpanFuncs& functors) {
+                                             const ProcessBroadcastSpanFuncs& functors, double unit_cost) {
   const auto& condition = *context.Input<Tensor>(0);
   // select the X input (input 1) for 'true', and Y input (input 2) for 'false'
   const auto& values = *context.Input<Tensor>(target ? 1 : 2);
@@ -208,7 +208,8 @@ static std::unique_ptr<Tensor> UntypedSelect(OpKernelContext& context, bool targ
   OutputBroadcaster output_broadcaster(input_broadcaster.GetSpanSize(), *selection_tensor);
 
   // store value of 'target' directly in void* for user_data so it's accessible in the state-less functors
-  BroadcastHelper broadcast_helper(input_broadcaster, output_broadcaster, reinterpret_cast<void*>(target));
+  BroadcastHelper broadcast_helper(input_broadcaster, output_broadcaster, reinterpret_cast<void*>(target),
+                                   context.GetOperatorThreadPool(), unit_cost);
 
   BroadcastLooper(broadcast_helper, functors);
 
@@ -217,12 +218,13 @@ static std::unique_ptr<Tensor> UntypedSelect(OpKernelContext& context, bool targ
 
 static void UntypedMerge(OpKernelContext& context,
                          const Tensor& X_selection_tensor, const Tensor& Y_selection_tensor,
-                         const ProcessBroadcastSpanFuncs& functors) {
+                         const ProcessBroadcastSpanFuncs& functors, double unit_cost) {
   InputBroadcaster merge_broadcaster{X_selection_tensor, Y_selection_tensor};
   Tensor& output = *context.Output(0, merge_broadcaster.GetOutputShape());
 
   OutputBroadcaster output_broadcaster{merge_broadcaster.GetSpanSize(), output};
-  BroadcastHelper broadcast_helper(merge_broadcaster, output_broadcaster);
+  BroadcastHelper broadcast_helper(merge_broadcaster, output_broadcaster, nullptr,
+                                   context.GetOperatorThreadPool(), unit_cost);
 
   BroadcastLooper(broadcast_helper, functors);
 }
@@ -251,10 +253,13 @@ Status Where<T>::Compute(OpKernelContext* context) const {
   //   output = (X_selection != default value) ? X_selection : Y_selection
   //
   // The merging is handled within UntypedMerge.
-  auto X_selection_tensor = UntypedSelect(*context, true, tensor_allocator, typed_tensor_allocation, funcs);
-  auto Y_selection_tensor = UntypedSelect(*context, false, tensor_allocator, typed_tensor_allocation, funcs);
+  //
+  // Each step is parallelized when its output is covered by a single span, i.e. when no broadcasting is needed.
+  const double unit_cost = std::is_same<T, std::string>::value ? 8.0 : 1.0;
+  auto X_selection_tensor = UntypedSelect(*context, true, tensor_allocator, typed_tensor_allocation, funcs, unit_cost);
+  auto Y_selection_tensor = UntypedSelect(*context, false, tensor_allocator, typed_tensor_allocation, funcs, unit_cost);
 
-  UntypedMerge(*context, *X_selection_tensor, *Y_selection_tensor, MergeBroadcastFuncs<T>());
+  UntypedMerge(*context, *X_selection_tensor, *Y_selection_tensor, MergeBroadcastFuncs<T>(), unit_cost);
 
   return Status::OK();
 }
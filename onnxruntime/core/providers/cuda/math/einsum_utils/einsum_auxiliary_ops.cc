@@ -46,25 +46,27 @@ Status Transpose(const std::vector<size_t>& permutation, const Tensor& input,
 template <typename T>
 Status MatMul(const T* input_1_data, const T* input_2_data, T* output_data,
               size_t left_stride, size_t right_stride, size_t output_stride,
-              size_t num_batches, size_t M, size_t K, size_t N, concurrency::ThreadPool* /*tp*/,
+              size_t num_batches, size_t M, size_t K, size_t N, bool trans_a, bool trans_b,
+              concurrency::ThreadPool* /*tp*/,
               void* einsum_cuda_assets) {
   typedef typename cuda::ToCudaType<T>::MappedType CudaT;
 
   CudaT one = cuda::ToCudaType<T>::FromFloat(1.0f);
   CudaT zero = cuda::ToCudaType<T>::FromFloat(0.0f);
 
+  // cuBLAS is column-major, so the row-major output is computed as output^T = op(input_2)^T * op(input_1)^T
   CUBLAS_RETURN_IF_ERROR(cublasGemmStridedBatchedHelper(static_cast<EinsumCudaAssets*>(einsum_cuda_assets)->cublas_handle_,
-                                                        CUBLAS_OP_N,
-                                                        CUBLAS_OP_N,
+                                                        trans_b ? CUBLAS_OP_T : CUBLAS_OP_N,
+                                                        trans_a ? CUBLAS_OP_T : CUBLAS_OP_N,
                                                         static_cast<int>(N),
                                                         static_cast<int>(M),
                                                         static_cast<int>(K),
                                                         &one,
                                                         reinterpret_cast<const CudaT*>(input_2_data),
-                                                        static_cast<int>(N),
+                                                        static_cast<int>(trans_b ? K : N),
                                                         static_cast<int>(right_stride),
                                                         reinterpret_cast<const CudaT*>(input_1_data),
-                                                        static_cast<int>(K),
+                                                        static_cast<int>(trans_a ? M : K),
                                                         static_cast<int>(left_stride),
                                                         &zero,
                                                         reinterpret_cast<CudaT*>(output_data),
@@ -151,7 +153,8 @@ std::unique_ptr<Tensor> Diagonal(const Tensor& input, int64_t dim_1, int64_t dim
 template Status DeviceHelpers::CudaDeviceHelpers::MatMul<float>(
     const float* input_1_data, const float* input_2_data, float* output_data,
     size_t left_stride, size_t right_stride, size_t output_stride,
-    size_t num_batches, size_t M, size_t K, size_t N, concurrency::ThreadPool* tp,
+    size_t num_batches, size_t M, size_t K, size_t N, bool trans_a, bool trans_b,
+    concurrency::ThreadPool* tp,
     void* einsum_cuda_assets);
 
 template std::unique_ptr<Tensor> DeviceHelpers::CudaDeviceHelpers::ReduceSum<float>(
@@ -164,7 +167,8 @@ template std::unique_ptr<Tensor> DeviceHelpers::CudaDeviceHelpers::ReduceSum<flo
 template Status DeviceHelpers::CudaDeviceHelpers::MatMul<double>(
     const double* input_1_data, const double* input_2_data, double* output_data,
     size_t left_stride, size_t right_stride, size_t output_stride,
-    size_t num_batches, size_t M, size_t K, size_t N, concurrency::ThreadPool* tp,
+    size_t num_batches, size_t M, size_t K, size_t N, bool trans_a, bool trans_b,
+    concurrency::ThreadPool* tp,
     void* einsum_cuda_assets);
 
 template std::unique_ptr<Tensor> DeviceHelpers::CudaDeviceHelpers::ReduceSum<double>(
@@ -177,7 +181,8 @@ template std::unique_ptr<Tensor> DeviceHelpers::CudaDeviceHelpers::ReduceSum<dou
 template Status DeviceHelpers::CudaDeviceHelpers::MatMul<MLFloat16>(
     const MLFloat16* input_1_data, const MLFloat16* input_2_data, MLFloat16* output_data,
     size_t left_stride, size_t right_stride, size_t output_stride,
-    size_t num_batches, size_t M, size_t K, size_t N, concurrency::ThreadPool* tp,
+    size_t num_batches, size_t M, size_t K, size_t N, bool trans_a, bool trans_b,
+    concurrency::ThreadPool* tp,
     void* einsum_cuda_assets);
 
 template std::unique_ptr<Tensor> DeviceHelpers::CudaDeviceHelpers::ReduceSum<MLFloat16>(
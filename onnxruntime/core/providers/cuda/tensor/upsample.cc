@@ -57,6 +57,11 @@ Status Upsample<T>::BaseCompute(OpKernelContext* context,
     return Status(ONNXRUNTIME, INVALID_ARGUMENT,
                   "Resize: size of roi array should be 2 * N where N is the rank of input tensor X.");
 
+  if (mode_ != UpsampleMode::NN && IsChannelsLastResize(scales))
+    return ORT_MAKE_STATUS(ONNXRUNTIME, NOT_IMPLEMENTED,
+                           is_resize_ ? "Resize" : "Upsample",
+                           ": 'Linear' and 'Cubic' modes of channels last 4-D inputs are not supported.");
+
   Tensor* Y = context->Output(0, output_dims);
 
   // Return early if the output tensor is going to be of size 0
@@ -4,6 +4,7 @@
 #include "core/graph/onnx_protobuf.h"
 #include "core/session/inference_session.h"
 
+#include <fstream>
 #include <memory>
 #include <sstream>
 #include <unordered_set>
@@ -212,6 +213,12 @@ void InferenceSession::ConstructorCommon(const SessionOptions& session_options,
 #if !defined(ORT_MINIMAL_BUILD)
   // Update the number of steps for the graph transformer manager using the "finalized" session options
   ORT_ENFORCE(graph_transformation_mgr_.SetSteps(session_options_.max_num_graph_transformation_steps).IsOK());
+
+  // record the cost of each graph transformer when profiling, or when a report was requested
+  graph_transformation_mgr_.SetProfiler(&session_profiler_);
+  if (!session_options_.config_options.GetConfigOrDefault(kOrtSessionOptionsGraphTransformerReportFile, "").empty()) {
+    graph_transformation_mgr_.EnableStatistics();
+  }
 #endif
 
   bool set_denormal_as_zero =
@@ -1260,6 +1267,16 @@ common::Status InferenceSession::Initialize() {
 
       // Update temporary copies of metadata, input- and output definitions to the same state as the resolved graph
       ORT_RETURN_IF_ERROR_SESSIONID_(SaveModelMetadata(*model_));
+
+      const std::string transformer_report_file =
+          session_options_.config_options.GetConfigOrDefault(kOrtSessionOptionsGraphTransformerReportFile, "");
+      if (!transformer_report_file.empty()) {
+        std::ofstream report_stream(transformer_report_file, std::ios::out | std::ios::trunc);
+        report_stream << graph_transformation_mgr_.GetStatisticsReport();
+        if (!report_stream) {
+          LOGS(*session_logger_, WARNING) << "Failed to write graph transformer report to " << transformer_report_file;
+        }
+      }
     } else
 #endif  // !defined(ORT_MINIMAL_BUILD)
     {
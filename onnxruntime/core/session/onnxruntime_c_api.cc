@@ -9,6 +9,7 @@
 #include "core/framework/error_code_helper.h"
 #include "core/framework/execution_provider.h"
 #include "core/framework/utils.h"
+#include <algorithm>
 #include <cassert>
 #include <cstring>
 #include <functional>
@@ -23,6 +24,7 @@
 #include "core/framework/allocator.h"
 #include "core/framework/tensor.h"
 #include "core/framework/ml_value.h"
+#include "core/framework/string_tensor_view.h"
 #include "core/providers/get_execution_providers.h"
 #include "core/session/environment.h"
 #include "core/framework/callback.h"
@@ -818,14 +820,9 @@ ORT_API_STATUS_IMPL(OrtApis::FillStringTensorElement, _Inout_ OrtValue* value, _
 
 ORT_API_STATUS_IMPL(OrtApis::GetStringTensorDataLength, _In_ const OrtValue* value, _Out_ size_t* out) {
   TENSOR_READ_API_BEGIN
-  const auto* src = tensor.Data<std::string>();
   int64_t len = tensor.Shape().Size();
   if (len >= 0) {
-    size_t ret = 0;
-    for (int64_t i = 0; i != len; ++i) {
-      ret += src[i].size();
-    }
-    *out = ret;
+    *out = StringTensorView(tensor).TotalLength();
   } else
     return OrtApis::CreateStatus(ORT_INVALID_ARGUMENT, "shape is invalid");
   return nullptr;
@@ -834,8 +831,8 @@ ORT_API_STATUS_IMPL(OrtApis::GetStringTensorDataLength, _In_ const OrtValue* val
 
 ORT_API_STATUS_IMPL(OrtApis::GetStringTensorElementLength, _In_ const OrtValue* value, size_t index, _Out_ size_t* out) {
   TENSOR_READ_API_BEGIN
-  const auto* src = tensor.Data<std::string>();
-  auto len = static_cast<size_t>(tensor.Shape().Size());
+  const StringTensorView src(tensor);
+  auto len = src.Size();
   if (index < len) {
     *out = src[index].size();
   } else
@@ -847,19 +844,13 @@ ORT_API_STATUS_IMPL(OrtApis::GetStringTensorElementLength, _In_ const OrtValue*
 ORT_API_STATUS_IMPL(OrtApis::GetStringTensorContent, _In_ const OrtValue* value, _Out_writes_bytes_all_(s_len) void* s,
                     size_t s_len, _Out_writes_all_(offsets_len) size_t* offsets, size_t offsets_len) {
   TENSOR_READ_API_BEGIN
-  const auto* input = tensor.Data<std::string>();
-  auto len = static_cast<size_t>(tensor.Shape().Size());
+  const StringTensorView input(tensor);
+  auto len = input.Size();
   if (offsets_len != len) {
     return OrtApis::CreateStatus(ORT_FAIL, "offsets buffer is not equal to tensor size");
   }
-  {
-    size_t ret = 0;
-    for (size_t i = 0; i != len; ++i) {
-      ret += input[i].size();
-    }
-    if (s_len < ret) {
-      return OrtApis::CreateStatus(ORT_FAIL, "output buffer is too small");
-    }
+  if (s_len < input.TotalLength()) {
+    return OrtApis::CreateStatus(ORT_FAIL, "output buffer is too small");
   }
   size_t f = 0;
   char* p = static_cast<char*>(s);
@@ -875,8 +866,8 @@ ORT_API_STATUS_IMPL(OrtApis::GetStringTensorContent, _In_ const OrtValue* value,
 
 ORT_API_STATUS_IMPL(OrtApis::GetStringTensorElement, _In_ const OrtValue* value, size_t s_len, size_t index, _Out_writes_bytes_all_(s_len) void* s) {
   TENSOR_READ_API_BEGIN
-  const auto* input = tensor.Data<std::string>();
-  auto len = static_cast<size_t>(tensor.Shape().Size());
+  const StringTensorView input(tensor);
+  auto len = input.Size();
 
   if (index >= len) {
     return OrtApis::CreateStatus(ORT_INVALID_ARGUMENT, "element index is out of bounds");
@@ -893,6 +884,49 @@ ORT_API_STATUS_IMPL(OrtApis::GetStringTensorElement, _In_ const OrtValue* value,
   API_IMPL_END
 }
 
+ORT_API_STATUS_IMPL(OrtApis::CreateStringTensorWithBuffer, _Inout_ OrtAllocator* allocator,
+                    _In_ const int64_t* shape, size_t shape_len,
+                    _In_reads_bytes_(s_len) const void* s, size_t s_len,
+                    _In_reads_(offsets_len) const size_t* offsets, size_t offsets_len,
+                    _Outptr_ OrtValue** out) {
+  API_IMPL_BEGIN
+  std::vector<int64_t> shapes(shape_len);
+  size_t elem_count = 1;
+  for (size_t i = 0; i != shape_len; ++i) {
+    if (shape[i] < 0)
+      return OrtApis::CreateStatus(ORT_INVALID_ARGUMENT, "tried creating tensor with negative value in shape");
+    elem_count *= static_cast<size_t>(shape[i]);
+    shapes[i] = shape[i];
+  }
+  if (offsets_len != elem_count) {
+    return OrtApis::CreateStatus(ORT_INVALID_ARGUMENT, "offsets buffer is not equal to tensor size");
+  }
+  for (size_t i = 0; i != offsets_len; ++i) {
+    const size_t end = i + 1 < offsets_len ? offsets[i + 1] : s_len;
+    if (offsets[i] > end || end > s_len) {
+      return OrtApis::CreateStatus(ORT_INVALID_ARGUMENT, "offsets are not increasing or exceed the data length");
+    }
+  }
+
+  std::shared_ptr<IAllocator> alloc_ptr = std::make_shared<onnxruntime::AllocatorWrapper>(allocator);
+  auto tensor = Tensor::CreateStringBuffer(onnxruntime::TensorShape(shapes), s_len, alloc_ptr);
+  size_t* dst_offsets = tensor->MutableStringBufferOffsets();
+  std::copy(offsets, offsets + offsets_len, dst_offsets);
+  dst_offsets[offsets_len] = s_len;
+  if (s_len > 0) {
+    memcpy(tensor->MutableStringBufferData(), s, s_len);
+  }
+
+  auto value = std::make_unique<OrtValue>();
+  auto ml_tensor = DataTypeImpl::GetType<Tensor>();
+  value->Init(tensor.release(),
+              ml_tensor,
+              ml_tensor->GetDeleteFunc());
+  *out = value.release();
+  return nullptr;
+  API_IMPL_END
+}
+
 #define ORT_C_API_RETURN_IF_ERROR(expr)                 \
   do {                                                  \
     auto _status = (expr);                              \
@@ -2275,6 +2309,7 @@ static constexpr OrtApi ort_api_1_to_9 = {
     &OrtApis::UpdateTensorRTProviderOptions,
     &OrtApis::GetTensorRTProviderOptionsAsString,
     &OrtApis::ReleaseTensorRTProviderOptions,
+    &OrtApis::CreateStringTensorWithBuffer,
 };
 
 // Assert to do a limited check to ensure Version 1 of OrtApi never changes (will detect an addition or deletion but not if they cancel out each other)
@@ -285,4 +285,9 @@ ORT_API_STATUS_IMPL(UpdateTensorRTProviderOptions, _Inout_ OrtTensorRTProviderOp
                     size_t num_keys);
 ORT_API_STATUS_IMPL(GetTensorRTProviderOptionsAsString, _In_ const OrtTensorRTProviderOptionsV2* tensorrt_options, _Inout_ OrtAllocator* allocator, _Outptr_ char** ptr);
 ORT_API(void, ReleaseTensorRTProviderOptions, _Frees_ptr_opt_ OrtTensorRTProviderOptionsV2*);
+ORT_API_STATUS_IMPL(CreateStringTensorWithBuffer, _Inout_ OrtAllocator* allocator,
+                    _In_ const int64_t* shape, size_t shape_len,
+                    _In_reads_bytes_(s_len) const void* s, size_t s_len,
+                    _In_reads_(offsets_len) const size_t* offsets, size_t offsets_len,
+                    _Outptr_ OrtValue** out);
 }  // namespace OrtApis
@@ -0,0 +1,100 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/common/flat_hash_table.h"
+#include "gtest/gtest.h"
+
+#include <limits>
+#include <random>
+#include <unordered_map>
+
+namespace onnxruntime {
+namespace test {
+
+TEST(FlatHashTableTest, Empty) {
+  FlatHashTable<std::string, int64_t> table;
+  EXPECT_TRUE(table.Empty());
+  EXPECT_EQ(table.Find(""), nullptr);
+  EXPECT_EQ(table.Find("a"), nullptr);
+}
+
+TEST(FlatHashTableTest, InsertAndAssign) {
+  FlatHashTable<std::string, int64_t> table;
+  EXPECT_TRUE(table.Insert("", 1));
+  EXPECT_TRUE(table.Insert("a", 2));
+  EXPECT_FALSE(table.Insert("a", 3));
+  EXPECT_EQ(*table.Find("a"), 2);
+  table.InsertOrAssign("a", 4);
+  EXPECT_EQ(*table.Find("a"), 4);
+  EXPECT_EQ(*table.Find(""), 1);
+  EXPECT_EQ(table.Find("b"), nullptr);
+  EXPECT_EQ(table.Size(), 2u);
+}
+
+TEST(FlatHashTableTest, StringKeysMatchUnorderedMap) {
+  // Short (inline) and long keys, sharing prefixes, with the table growing from its minimum capacity.
+  std::mt19937 gen(7);
+  std::uniform_int_distribution<int> length_dist(0, 40);
+  std::uniform_int_distribution<int> char_dist('a', 'd');
+  auto random_string = [&]() {
+    std::string s(length_dist(gen), 'a');
+    for (auto& c : s) c = static_cast<char>(char_dist(gen));
+    return s;
+  };
+
+  FlatHashTable<std::string, int64_t> table;
+  std::unordered_map<std::string, int64_t> expected;
+  for (int64_t i = 0; i < 5000; ++i) {
+    auto key = random_string();
+    table.InsertOrAssign(key, i);
+    expected[key] = i;
+  }
+  ASSERT_EQ(table.Size(), expected.size());
+
+  for (const auto& entry : expected) {
+    const int64_t* value = table.Find(entry.first);
+    ASSERT_NE(value, nullptr) << entry.first;
+    EXPECT_EQ(*value, entry.second);
+  }
+  for (int i = 0; i < 5000; ++i) {
+    auto key = random_string();
+    const int64_t* value = table.Find(key);
+    auto it = expected.find(key);
+    ASSERT_EQ(value != nullptr, it != expected.end()) << key;
+    if (value != nullptr) {
+      EXPECT_EQ(*value, it->second);
+    }
+  }
+}
+
+TEST(FlatHashTableTest, IntegerKeys) {
+  // Consecutive and strided keys stress the distribution of the probe positions.
+  FlatHashTable<int64_t, std::string> table(3000);
+  for (int64_t i = 0; i < 1000; ++i) {
+    table.Insert(i, std::to_string(i));
+    table.Insert(i << 32, std::to_string(i << 32));
+    table.Insert(-i * 1024, std::to_string(-i * 1024));
+  }
+  EXPECT_EQ(table.Size(), 2998u);  // 0 is inserted three times
+  for (int64_t i = 0; i < 1000; ++i) {
+    EXPECT_EQ(*table.Find(i), std::to_string(i));
+    EXPECT_EQ(*table.Find(i << 32), std::to_string(i << 32));
+    EXPECT_EQ(*table.Find(-i * 1024), std::to_string(-i * 1024));
+  }
+  EXPECT_EQ(table.Find(1000), nullptr);
+  EXPECT_EQ(table.Find(-1), nullptr);
+}
+
+TEST(FlatHashTableTest, FloatKeys) {
+  FlatHashTable<float, int64_t> table;
+  table.Insert(0.f, 1);
+  table.Insert(1.5f, 2);
+  table.Insert(std::numeric_limits<float>::quiet_NaN(), 3);
+  EXPECT_EQ(*table.Find(-0.f), 1);
+  EXPECT_EQ(*table.Find(1.5f), 2);
+  // NaN never compares equal to itself.
+  EXPECT_EQ(table.Find(std::numeric_limits<float>::quiet_NaN()), nullptr);
+}
+
+}  // namespace test
+}  // namespace onnxruntime
@@ -0,0 +1,90 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include <cmath>
+
+#include "gtest/gtest.h"
+#include "test/common/tensor_op_test_utils.h"
+#include "test/providers/provider_test_utils.h"
+
+namespace onnxruntime {
+namespace test {
+
+// y = m * sigmoid(m) where m = (x + bias) * scale.
+// The row length is not a multiple of the kernel block size so the bias is gathered across block boundaries.
+TEST(FusedElementwiseTest, AddMulSigmoidMul) {
+  const int64_t rows = 3;
+  const int64_t cols = 300;
+
+  RandomValueGenerator random{};
+  std::vector<float> x = random.Uniform<float>({rows, cols}, -2.0f, 2.0f);
+  std::vector<float> bias = random.Uniform<float>({cols}, -1.0f, 1.0f);
+  const float scale = 1.702f;
+
+  std::vector<float> y(x.size());
+  for (size_t i = 0; i < x.size(); ++i) {
+    float m = (x[i] + bias[i % cols]) * scale;
+    y[i] = m / (1.0f + std::exp(-m));
+  }
+
+  OpTester test("FusedElementwise", 1, kMSDomain);
+  test.AddAttribute("ops", std::vector<std::string>{"Add", "Mul", "Sigmoid", "Mul"});
+  test.AddAttribute("operands", std::vector<int64_t>{0, 1, 3, 2, 4, -1, 4, 5});
+  test.AddInput<float>("X", {rows, cols}, x);
+  test.AddInput<float>("B", {cols}, bias);
+  test.AddInput<float>("S", {}, {scale});
+  test.AddOutput<float>("Y", {rows, cols}, y);
+  test.Run();
+}
+
+TEST(FusedElementwiseTest, UnaryChainWithLeadingBroadcast) {
+  std::vector<float> x = {-4.0f, -1.0f, 0.0f, 1.0f, 4.0f, 9.0f};
+  std::vector<float> scale = {2.0f, 0.5f, -1.0f};
+
+  // y = sqrt(abs(x * scale)) - x
+  std::vector<float> y(x.size());
+  for (size_t i = 0; i < x.size(); ++i) {
+    y[i] = std::sqrt(std::abs(x[i] * scale[i % 3])) - x[i];
+  }
+
+  OpTester test("FusedElementwise", 1, kMSDomain);
+  test.AddAttribute("ops", std::vector<std::string>{"Mul", "Abs", "Sqrt", "Sub"});
+  test.AddAttribute("operands", std::vector<int64_t>{0, 1, 2, -1, 3, -1, 4, 0});
+  test.AddInput<float>("X", {2, 3}, x);
+  test.AddInput<float>("S", {1, 3}, scale);
+  test.AddOutput<float>("Y", {2, 3}, y);
+  test.Run();
+}
+
+TEST(FusedElementwiseTest, PowWithScalarExponent) {
+  std::vector<float> x = {0.0f, 0.5f, 1.0f, 2.0f, 4.0f, 9.0f};
+
+  // y = (2 * x) ^ 1.5
+  std::vector<float> y(x.size());
+  for (size_t i = 0; i < x.size(); ++i) {
+    y[i] = std::pow(2.0f * x[i], 1.5f);
+  }
+
+  OpTester test("FusedElementwise", 1, kMSDomain);
+  test.AddAttribute("ops", std::vector<std::string>{"Mul", "Pow"});
+  test.AddAttribute("operands", std::vector<int64_t>{0, 1, 3, 2});
+  test.AddInput<float>("X", {2, 3}, x);
+  test.AddInput<float>("S", {}, {2.0f});
+  test.AddInput<float>("E", {}, {1.5f});
+  test.AddOutput<float>("Y", {2, 3}, y);
+  test.Run();
+}
+
+TEST(FusedElementwiseTest, InvalidOperand) {
+  OpTester test("FusedElementwise", 1, kMSDomain);
+  test.AddAttribute("ops", std::vector<std::string>{"Add", "Relu"});
+  // Relu refers to its own result
+  test.AddAttribute("operands", std::vector<int64_t>{0, 1, 3, -1});
+  test.AddInput<float>("A", {2}, {1.0f, 2.0f});
+  test.AddInput<float>("B", {2}, {1.0f, 2.0f});
+  test.AddOutput<float>("Y", {2}, {2.0f, 4.0f});
+  test.Run(OpTester::ExpectResult::kExpectFailure, "Invalid operand for step 1");
+}
+
+}  // namespace test
+}  // namespace onnxruntime
@@ -0,0 +1,131 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include <algorithm>
+#include <cmath>
+
+#include "gtest/gtest.h"
+#include "test/providers/provider_test_utils.h"
+
+namespace onnxruntime {
+namespace test {
+
+// Reference group normalization of an input with shape [N, C, spatial_size].
+static std::vector<float> ComputeGroupNorm(const std::vector<float>& X, const std::vector<float>& gamma,
+                                           const std::vector<float>& beta, int64_t N, int64_t C,
+                                           int64_t spatial_size, int64_t groups, float epsilon) {
+  std::vector<float> Y(X.size());
+  const int64_t group_size = (C / groups) * spatial_size;
+
+  for (int64_t n = 0; n < N; n++) {
+    for (int64_t g = 0; g < groups; g++) {
+      const float* x = X.data() + (n * groups + g) * group_size;
+      double sum = 0.0;
+      double sum_square = 0.0;
+      for (int64_t i = 0; i < group_size; i++) {
+        sum += x[i];
+        sum_square += static_cast<double>(x[i]) * x[i];
+      }
+      const double mean = sum / group_size;
+      const double variance = sum_square / group_size - mean * mean;
+      const float inv_std_dev = static_cast<float>(1.0 / std::sqrt(variance + epsilon));
+
+      for (int64_t i = 0; i < group_size; i++) {
+        const int64_t c = g * (C / groups) + i / spatial_size;
+        Y[(n * groups + g) * group_size + i] =
+            (x[i] - static_cast<float>(mean)) * inv_std_dev * gamma[c] + beta[c];
+      }
+    }
+  }
+
+  return Y;
+}
+
+static void RunGroupNormTest(int64_t N, int64_t C, int64_t H, int64_t W, int64_t groups, const char* activation) {
+  std::vector<float> X(static_cast<size_t>(N * C * H * W));
+  for (size_t i = 0; i < X.size(); i++) {
+    X[i] = static_cast<float>((i * 7) % 13) * 0.5f - 3.0f;
+  }
+
+  std::vector<float> gamma(static_cast<size_t>(C));
+  std::vector<float> beta(static_cast<size_t>(C));
+  for (int64_t c = 0; c < C; c++) {
+    gamma[c] = 0.5f + static_cast<float>(c % 3) * 0.25f;
+    beta[c] = static_cast<float>(c % 4) * 0.5f - 0.75f;
+  }
+
+  constexpr float epsilon = 1e-5f;
+  std::vector<float> Y = ComputeGroupNorm(X, gamma, beta, N, C, H * W, groups, epsilon);
+
+  OpTester test("GroupNorm", 1, onnxruntime::kMSDomain);
+  test.AddAttribute<float>("epsilon", epsilon);
+  test.AddAttribute<int64_t>("groups", groups);
+  if (activation != nullptr) {
+    test.AddAttribute<std::string>("activation", activation);
+    if (std::string(activation) == "Relu") {
+      std::transform(Y.begin(), Y.end(), Y.begin(), [](float v) { return std::max(v, 0.0f); });
+    }
+  }
+  test.AddInput<float>("X", {N, C, H, W}, X);
+  test.AddInput<float>("gamma", {C}, gamma);
+  test.AddInput<float>("beta", {C}, beta);
+  test.AddOutput<float>("Y", {N, C, H, W}, Y);
+  test.Run();
+}
+
+TEST(GroupNormTest, GroupNorm) {
+  RunGroupNormTest(2, 6, 3, 5, 3, nullptr);
+  RunGroupNormTest(1, 32, 7, 7, 8, nullptr);
+}
+
+TEST(GroupNormTest, GroupNorm_InstanceNorm) {
+  // One channel per group is instance normalization.
+  RunGroupNormTest(2, 5, 4, 3, 5, nullptr);
+}
+
+TEST(GroupNormTest, GroupNorm_Relu) {
+  RunGroupNormTest(2, 8, 5, 5, 2, "Relu");
+}
+
+TEST(GroupNormTest, GroupNorm_InvalidGroups) {
+  OpTester test("GroupNorm", 1, onnxruntime::kMSDomain);
+  test.AddAttribute<int64_t>("groups", 4);
+  test.AddInput<float>("X", {1, 6, 2}, std::vector<float>(12, 1.0f));
+  test.AddInput<float>("gamma", {6}, std::vector<float>(6, 1.0f));
+  test.AddInput<float>("beta", {6}, std::vector<float>(6, 0.0f));
+  test.AddOutput<float>("Y", {1, 6, 2}, std::vector<float>(12, 0.0f));
+  test.Run(OpTester::ExpectResult::kExpectFailure, "is not divisible by the number of groups");
+}
+
+TEST(FusedBatchNormalizationTest, LeakyRelu) {
+  OpTester test("FusedBatchNormalization", 1, onnxruntime::kMSDomain);
+  const float epsilon = 1e-5f;
+  const float alpha = 0.1f;
+  test.AddAttribute<float>("epsilon", epsilon);
+  test.AddAttribute<std::string>("activation", "LeakyRelu");
+  test.AddAttribute<std::vector<float>>("activation_params", {alpha});
+
+  std::vector<float> X{-1.0f, 2.0f, 0.5f, -3.0f, 4.0f, 1.5f, -0.5f, 2.5f};
+  std::vector<float> scale{0.5f, 2.0f};
+  std::vector<float> B{0.25f, -1.0f};
+  std::vector<float> mean{0.5f, 1.0f};
+  std::vector<float> var{1.0f, 4.0f};
+
+  std::vector<float> Y(X.size());
+  for (size_t i = 0; i < X.size(); i++) {
+    const size_t c = (i / 2) % 2;
+    const float value = (X[i] - mean[c]) / std::sqrt(var[c] + epsilon) * scale[c] + B[c];
+    Y[i] = value >= 0.0f ? value : value * alpha;
+  }
+
+  test.AddInput<float>("X", {2, 2, 2}, X);
+  test.AddInput<float>("scale", {2}, scale);
+  test.AddInput<float>("B", {2}, B);
+  test.AddInput<float>("mean", {2}, mean);
+  test.AddInput<float>("var", {2}, var);
+  test.AddOutput<float>("Y", {2, 2, 2}, Y);
+  test.Run();
+}
+
+}  // namespace test
+}  // namespace onnxruntime
@@ -1,6 +1,8 @@
 // Copyright (c) Microsoft Corporation. All rights reserved.
 // Licensed under the MIT License.
 
+#include <cmath>
+
 #include "gtest/gtest.h"
 #include "test/common/tensor_op_test_utils.h"
 #include "test/common/cuda_op_test_utils.h"
@@ -275,5 +277,132 @@ TEST(SkipLayerNormTest, SkipLayerNormBatch2_Bias) {
           hidden_size);
 }
 
+// The hidden size is not a multiple of the vector width so both the vectorized and remainder paths of the
+// CPU kernel are covered, and the optional sum of the input, skip and bias is requested from every provider.
+TEST(SkipLayerNormTest, SkipLayerNormBatch1_Bias_InputSkipBiasSum) {
+  int batch_size = 1;
+  int sequence_length = 2;
+  int hidden_size = 19;
+
+  std::vector<int64_t> input_dims = {batch_size, sequence_length, hidden_size};
+  std::vector<int64_t> param_dims = {hidden_size};
+
+  std::vector<float> input_data = {
+      -0.5f, 0.2f, -0.2f, 0.5f, 0.1f, -0.3f, 0.4f, 0.0f, -0.4f, 0.3f, -0.1f, -0.5f, 0.2f, -0.2f, 0.5f, 0.1f,
+      -0.3f, 0.4f, 0.0f, -0.4f, 0.3f, -0.1f, -0.5f, 0.2f, -0.2f, 0.5f, 0.1f, -0.3f, 0.4f, 0.0f, -0.4f, 0.3f,
+      -0.1f, -0.5f, 0.2f, -0.2f, 0.5f, 0.1f};
+
+  std::vector<float> skip_data = {
+      -0.3f, -0.05f, 0.2f, -0.2f, 0.05f, 0.3f, -0.1f, 0.15f, -0.25f, 0.0f, 0.25f, -0.15f, 0.1f, -0.3f, -0.05f,
+      0.2f, -0.2f, 0.05f, 0.3f, -0.1f, 0.15f, -0.25f, 0.0f, 0.25f, -0.15f, 0.1f, -0.3f, -0.05f, 0.2f, -0.2f,
+      0.05f, 0.3f, -0.1f, 0.15f, -0.25f, 0.0f, 0.25f, -0.15f};
+
+  std::vector<float> gamma_data = {
+      0.5f, 0.8f, 1.1f, 0.7f, 1.0f, 0.6f, 0.9f, 0.5f, 0.8f, 1.1f, 0.7f, 1.0f, 0.6f, 0.9f, 0.5f, 0.8f,
+      1.1f, 0.7f, 1.0f};
+
+  std::vector<float> beta_data = {
+      -0.2f, 0.0f, 0.2f, -0.1f, 0.1f, -0.2f, 0.0f, 0.2f, -0.1f, 0.1f, -0.2f, 0.0f, 0.2f, -0.1f, 0.1f, -0.2f,
+      0.0f, 0.2f, -0.1f};
+
+  std::vector<float> bias_data = {
+      -0.1f, 0.0f, 0.1f, -0.1f, 0.0f, 0.1f, -0.1f, 0.0f, 0.1f, -0.1f, 0.0f, 0.1f, -0.1f, 0.0f, 0.1f, -0.1f,
+      0.0f, 0.1f, -0.1f};
+
+  std::vector<float> output_data = {
+      -1.364717f, 0.2979509f, 0.4681558f, 0.2507695f, 0.4724387f, -0.05373319f, 0.4509894f, 0.3862193f,
+      -1.243048f, 0.6512093f, 0.06070705f, -1.42881f, 0.5006596f, -1.270135f, 0.8008619f, 0.2008795f,
+      -1.430165f, 1.181207f, 0.4010993f, -0.9219675f, 0.9209963f, -0.4367623f, -1.110754f, 1.251245f,
+      -0.5473249f, 1.147343f, -0.0276474f, -0.5630999f, 1.502308f, -0.5187063f, -0.5788748f, 0.9648953f,
+      -0.5097653f, -0.1894374f, -0.4653718f, -0.5008243f, 1.69792f, -0.4317148f};
+
+  std::vector<float> sum_data = {
+      -0.9f, 0.15f, 0.1f, 0.2f, 0.15f, 0.1f, 0.2f, 0.15f, -0.55f, 0.2f, 0.15f, -0.55f, 0.2f, -0.5f, 0.55f,
+      0.2f, -0.5f, 0.55f, 0.2f, -0.6f, 0.45f, -0.25f, -0.6f, 0.45f, -0.25f, 0.5f, -0.2f, -0.25f, 0.5f, -0.2f,
+      -0.25f, 0.5f, -0.2f, -0.25f, -0.15f, -0.2f, 0.85f, -0.15f};
+
+  OpTester test("SkipLayerNormalization", 1, onnxruntime::kMSDomain);
+  test.AddInput<float>("input", input_dims, input_data);
+  test.AddInput<float>("skip", input_dims, skip_data);
+  test.AddInput<float>("gamma", param_dims, gamma_data);
+  test.AddInput<float>("beta", param_dims, beta_data);
+  test.AddInput<float>("bias", param_dims, bias_data);
+  test.AddAttribute("epsilon", epsilon_);
+  test.AddOutput<float>("output", input_dims, output_data);
+  test.AddMissingOptionalOutput<float>();
+  test.AddMissingOptionalOutput<float>();
+  test.AddOutput<float>("input_skip_bias_sum", input_dims, sum_data);
+  test.Run();
+}
+
+// A hidden size above 128 that is not 384 takes the CUDA kernel that loops over the row, which also writes the
+// sum of the input, skip and bias. The expected values are computed here from generated inputs.
+TEST(SkipLayerNormTest, SkipLayerNormBatch2_LargeHidden_InputSkipBiasSum) {
+  int batch_size = 2;
+  int sequence_length = 3;
+  int hidden_size = 259;
+
+  std::vector<int64_t> input_dims = {batch_size, sequence_length, hidden_size};
+  std::vector<int64_t> param_dims = {hidden_size};
+
+  const size_t row_count = static_cast<size_t>(batch_size * sequence_length);
+  const size_t element_count = row_count * hidden_size;
+
+  std::vector<float> input_data(element_count);
+  std::vector<float> skip_data(element_count);
+  for (size_t i = 0; i < element_count; ++i) {
+    input_data[i] = static_cast<float>(static_cast<int>(i * 37 % 101) - 50) / 50.0f;
+    skip_data[i] = static_cast<float>(static_cast<int>(i * 53 % 67) - 33) / 100.0f;
+  }
+
+  std::vector<float> gamma_data(hidden_size);
+  std::vector<float> beta_data(hidden_size);
+  std::vector<float> bias_data(hidden_size);
+  for (int i = 0; i < hidden_size; ++i) {
+    gamma_data[i] = 0.5f + static_cast<float>(i % 11) / 10.0f;
+    beta_data[i] = static_cast<float>(i % 7 - 3) / 10.0f;
+    bias_data[i] = static_cast<float>(i % 5 - 2) / 20.0f;
+  }
+
+  std::vector<float> sum_data(element_count);
+  std::vector<float> output_data(element_count);
+  for (size_t row = 0; row < row_count; ++row) {
+    const size_t offset = row * hidden_size;
+
+    double mean = 0.0;
+    for (int i = 0; i < hidden_size; ++i) {
+      sum_data[offset + i] = input_data[offset + i] + skip_data[offset + i] + bias_data[i];
+      mean += sum_data[offset + i];
+    }
+    mean /= hidden_size;
+
+    double variance = 0.0;
+    for (int i = 0; i < hidden_size; ++i) {
+      const double deviation = sum_data[offset + i] - mean;
+      variance += deviation * deviation;
+    }
+    variance /= hidden_size;
+
+    const double inv_std_dev = 1.0 / std::sqrt(variance + epsilon_);
+    for (int i = 0; i < hidden_size; ++i) {
+      output_data[offset + i] =
+          static_cast<float>((sum_data[offset + i] - mean) * inv_std_dev * gamma_data[i] + beta_data[i]);
+    }
+  }
+
+  OpTester test("SkipLayerNormalization", 1, onnxruntime::kMSDomain);
+  test.AddInput<float>("input", input_dims, input_data);
+  test.AddInput<float>("skip", input_dims, skip_data);
+  test.AddInput<float>("gamma", param_dims, gamma_data);
+  test.AddInput<float>("beta", param_dims, beta_data);
+  test.AddInput<float>("bias", param_dims, bias_data);
+  test.AddAttribute("epsilon", epsilon_);
+  test.AddOutput<float>("output", input_dims, output_data);
+  test.AddMissingOptionalOutput<float>();
+  test.AddMissingOptionalOutput<float>();
+  test.AddOutput<float>("input_skip_bias_sum", input_dims, sum_data);
+  test.Run();
+}
+
 }  // namespace test
 }  // namespace onnxruntime
@@ -677,6 +677,67 @@ TEST(ContribOpTest, TokenizerWithSeparators_MixCharCommonPrefixC) {
   test.Run(OpTester::ExpectResult::kExpectSuccess);
 }  // namespace test
 
+TEST(ContribOpTest, TokenizerWithSeparators_RowsOfDifferentLengthsNoMarkersNC) {
+  // Every row is padded to the longest one, including the rows without any token
+  // [N][C] dimensions
+  // Output [N][C][D]
+  std::vector<std::string> separators = {
+      u8" ",
+      u8","};
+
+  OpTester test("Tokenizer", opset_ver, domain);
+  InitTestAttr(test, false, separators, 1);
+
+  std::vector<int64_t> dims{2, 2};
+  std::vector<std::string> input{u8"a b,c", u8"d", u8"", u8"e,f g h"};
+  test.AddInput<std::string>("T", dims, input);
+
+  std::vector<int64_t> output_dims(dims);
+  output_dims.push_back(int64_t(4));
+  std::vector<std::string> output{
+      u8"a", u8"b", u8"c", padval,
+      u8"d", padval, padval, padval,
+      padval, padval, padval, padval,
+      u8"e", u8"f", u8"g", u8"h"};
+
+  test.AddOutput<std::string>("Y", output_dims, output);
+  test.Run(OpTester::ExpectResult::kExpectSuccess);
+}
+
+TEST(ContribOpTest, TokenizerWithSeparators_ManyRowsWithMarkersNC) {
+  // Enough strings to be tokenized by several threads
+  // [N][C] dimensions
+  // Output [N][C][D]
+  OpTester test("Tokenizer", opset_ver, domain);
+  InitTestAttr(test, true, {u8" "}, 1);
+
+  const int64_t N = 64;
+  const int64_t C = 32;
+  std::vector<std::string> input;
+  std::vector<std::string> output;
+  for (int64_t i = 0; i < N * C; ++i) {
+    // Rows of 0 to 3 tokens
+    const int64_t tokens = i % 4;
+    std::string s;
+    output.push_back(start_mark);
+    for (int64_t t = 0; t < tokens; ++t) {
+      const std::string token = u8"tok" + std::to_string(i) + u8"_" + std::to_string(t);
+      s += token + u8" ";
+      output.push_back(token);
+    }
+    output.push_back(end_mark);
+    for (int64_t t = tokens; t < 3; ++t) {
+      output.push_back(padval);
+    }
+    input.push_back(s);
+  }
+
+  std::vector<int64_t> dims{N, C};
+  test.AddInput<std::string>("T", dims, input);
+  test.AddOutput<std::string>("Y", {N, C, 3 + 2}, output);
+  test.Run(OpTester::ExpectResult::kExpectSuccess);
+}
+
 TEST(ContribOpTest, TokenizerExpression_RegEx) {
   OpTester test("Tokenizer", opset_ver, domain);
   const std::string tokenexp(u8"a.");
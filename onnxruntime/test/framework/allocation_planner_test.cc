@@ -157,6 +157,7 @@ class PlannerTest : public ::testing::Test {
   std::unique_ptr<::onnxruntime::KernelDef> std_kernel_;       // a unary kernel with no-aliasing and no-in-place
   std::unique_ptr<::onnxruntime::KernelDef> in_place_kernel_;  // a unary kernel with in-place
   std::unique_ptr<::onnxruntime::KernelDef> external_outputs_kernel_; // an unary kernel with external outputs
+  std::unique_ptr<::onnxruntime::KernelDef> view_kernel_;      // a unary kernel whose output may be a view
 
   std::unordered_map<std::string, onnxruntime::NodeArg*> name_to_arg_;
   std::vector<std::unique_ptr<UnaryNode>> nodes_;
@@ -181,6 +182,8 @@ class PlannerTest : public ::testing::Test {
         KernelDefBuilder().SetName("Relu").Provider(kCpuExecutionProvider).SinceVersion(1, 10).MayInplace(0, 0).Build();
     external_outputs_kernel_ =
         KernelDefBuilder().SetName("Tanh").Provider(kCpuExecutionProvider).SinceVersion(1, 10).ExternalOutputs().Build();
+    view_kernel_ =
+        KernelDefBuilder().SetName("Floor").Provider(kCpuExecutionProvider).SinceVersion(1, 10).MayView(0, 0).Build();
     CPUExecutionProviderInfo epi;
     auto execution_provider = std::make_unique<CPUExecutionProvider>(epi);
     execution_providers_.Add("CPUExecutionProvider", std::move(execution_provider));
@@ -216,6 +219,10 @@ class PlannerTest : public ::testing::Test {
     return AddNode(*external_outputs_kernel_, input, output);
   }
 
+  onnxruntime::Node* AddViewNode(std::string& input, std::string& output) {
+    return AddNode(*view_kernel_, input, output);
+  }
+
   void BindKernel(onnxruntime::Node* p_node, ::onnxruntime::KernelDef& kernel_def, KernelRegistry* reg,
                   std::unordered_map<NodeIndex, gsl::not_null<const KernelCreateInfo*>>& kernel_create_info_map) {
     const IExecutionProvider* ep = execution_providers_.Get(*p_node);
@@ -439,6 +446,45 @@ TEST_F(PlannerTest, ExternalOutputsTest) {
   CheckFreed(2, {X3});
 }
 
+TEST_F(PlannerTest, ViewTest) {
+  // tensor variables:
+  std::string X1("X1"), X2("X2"), X3("X3"), X4("X4"), X5("X5");
+
+  // graph structure:
+  AddNormalNode(X1, X2);   // no in-place operator; X1: input; X2: temporary
+  AddViewNode(X2, X3);     // may-view operator; X3: view into X2
+  AddInplaceNode(X3, X4);  // may-in-place operator; X4: reuses the view as X2 has no other uses
+  AddNormalNode(X4, X5);   // no in-place operator; X5: output
+
+  // simulate shape-inference results:
+  Shape shape1{"M", "N"};
+  auto shape = &shape1.value;
+  SetShape({{X1, shape}, {X2, shape}, {X3, shape}, {X4, shape}, {X5, shape}});
+
+  CreatePlan();
+
+  // check allocation kind:
+  CheckAllocKind(X1, AllocKind::kPreExisting);
+  CheckAllocKind(X2, AllocKind::kAllocate);
+  CheckAllocKind(X3, AllocKind::kView);
+  CheckAllocKind(X4, AllocKind::kReuse);
+  CheckAllocKind(X5, AllocKind::kAllocateOutput);
+
+  // the view refers to X2, and X4 must reuse the data of the view rather than the start of X2
+  int x2_index, x3_index, x4_index;
+  index(X2, x2_index);
+  index(X3, x3_index);
+  index(X4, x4_index);
+  EXPECT_EQ(GetPlan().allocation_plan[x3_index].reused_buffer, x2_index);
+  EXPECT_EQ(GetPlan().allocation_plan[x4_index].reused_buffer, x3_index);
+
+  // the view is released together with the buffer it refers to
+  CheckFreed(0, {});
+  CheckFreed(1, {});
+  CheckFreed(2, {});
+  CheckFreed(3, {X2, X3});
+}
+
 // InPlaceSizeMismatchTest: Check that Inplace reuse is not allowed when sizes don't match.
 // Also tests reuse of disjoint lifetime tensors.
 TEST_F(PlannerTest, InPlaceSizeMismatchTest) {
@@ -16,11 +16,13 @@ TEST(MemPatternPlannerTest, TraceAllocaitonTest) {
 
   auto pattern = planner.GenerateMemPattern();
 
+  // all values are live, so the blocks are laid out largest first
   EXPECT_EQ(pattern.PeakSize(), 1024u + 256u + 512u + 1024u);
+  EXPECT_EQ(pattern.NaiveSize(), 1024u + 256u + 512u + 1024u);
   EXPECT_EQ(pattern.GetBlock(0)->offset_, 0u);
-  EXPECT_EQ(pattern.GetBlock(1)->offset_, 1024u);
-  EXPECT_EQ(pattern.GetBlock(2)->offset_, 1024 + 256u);
-  EXPECT_EQ(pattern.GetBlock(3)->offset_, 1024u + 256u + 512u);
+  EXPECT_EQ(pattern.GetBlock(3)->offset_, 1024u);
+  EXPECT_EQ(pattern.GetBlock(2)->offset_, 1024u + 1024u);
+  EXPECT_EQ(pattern.GetBlock(1)->offset_, 1024u + 1024u + 512u);
 
   planner.TraceFree(1);
   planner.TraceAllocation(4, 512);
@@ -30,10 +32,18 @@ TEST(MemPatternPlannerTest, TraceAllocaitonTest) {
 
   pattern = planner.GenerateMemPattern();
 
-  EXPECT_EQ(pattern.PeakSize(), 1024u + 256u + 512u + 1024u + 512u);
-  EXPECT_EQ(pattern.GetBlock(4)->offset_, 1024u + 256u + 512u + 1024u);
-  EXPECT_EQ(pattern.GetBlock(5)->offset_, 1024u + 256u + 512u);
-  EXPECT_EQ(pattern.GetBlock(6)->offset_, 1024u);
+  // the peak is reached when 0, 2, 3 and 4 are live
+  EXPECT_EQ(pattern.PeakSize(), 1024u + 512u + 1024u + 512u);
+  EXPECT_EQ(pattern.NaiveSize(), 1024u + 256u + 512u + 1024u + 512u + 600u + 200u);
+  EXPECT_EQ(pattern.GetBlock(0)->offset_, 0u);
+  EXPECT_EQ(pattern.GetBlock(3)->offset_, 1024u);
+  // 5 is allocated after 3 was freed so it reuses its memory
+  EXPECT_EQ(pattern.GetBlock(5)->offset_, 1024u);
+  EXPECT_EQ(pattern.GetBlock(2)->offset_, 2048u);
+  EXPECT_EQ(pattern.GetBlock(4)->offset_, 2560u);
+  EXPECT_EQ(pattern.GetBlock(1)->offset_, 2560u);
+  // best fit in the gap between 5 and 2
+  EXPECT_EQ(pattern.GetBlock(6)->offset_, 1024u + 600u);
 }
 }  // namespace test
 }  // namespace onnxruntime
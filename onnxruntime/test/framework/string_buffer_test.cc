@@ -0,0 +1,119 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include <cstring>
+
+#include "core/framework/string_tensor_view.h"
+#include "core/graph/model.h"
+#include "core/session/inference_session.h"
+#include "test/optimizer/graph_transform_test_builder.h"
+#include "test/test_environment.h"
+#include "asserts.h"
+#include "gtest/gtest.h"
+
+namespace onnxruntime {
+namespace test {
+
+namespace {
+// Returns an OrtValue holding a string tensor in the string buffer layout.
+OrtValue CreateStringBufferValue(const std::vector<int64_t>& dims, const std::vector<std::string>& strings) {
+  size_t total_bytes = 0;
+  for (const auto& s : strings) {
+    total_bytes += s.size();
+  }
+
+  auto tensor = Tensor::CreateStringBuffer(TensorShape(dims), total_bytes,
+                                           TestCPUExecutionProvider()->GetAllocator(0, OrtMemTypeDefault));
+  size_t* offsets = tensor->MutableStringBufferOffsets();
+  char* data = tensor->MutableStringBufferData();
+  for (size_t i = 0; i < strings.size(); ++i) {
+    offsets[i + 1] = offsets[i] + strings[i].size();
+    memcpy(data + offsets[i], strings[i].data(), strings[i].size());
+  }
+
+  OrtValue value;
+  auto ml_tensor = DataTypeImpl::GetType<Tensor>();
+  value.Init(tensor.release(), ml_tensor, ml_tensor->GetDeleteFunc());
+  return value;
+}
+
+std::vector<std::string> ReadStrings(const OrtValue& value) {
+  const StringTensorView strings(value.Get<Tensor>());
+  std::vector<std::string> result;
+  for (size_t i = 0; i < strings.Size(); ++i) {
+    result.emplace_back(strings[i]);
+  }
+  return result;
+}
+
+template <typename T>
+std::vector<T> ReadValues(const OrtValue& value) {
+  const auto values = value.Get<Tensor>().DataAsSpan<T>();
+  return std::vector<T>(values.begin(), values.end());
+}
+}  // namespace
+
+// A string input in the string buffer layout goes through the kernels that read strings, and through the
+// kernels whose output is an alias of, or a copy of, their input.
+TEST(StringBufferTest, SessionReadsStringBufferInput) {
+  const std::vector<std::string> strings{"ab", "", "Cde", "ab"};
+
+  std::unordered_map<std::string, int> domain_to_version{{kOnnxDomain, 13}, {kMLDomain, 2}};
+  Model model("StringBufferTest", false, ModelMetaData(), PathString(), IOnnxRuntimeOpSchemaRegistryList(),
+              domain_to_version, {}, DefaultLoggingManager().DefaultLogger());
+  ModelTestBuilder helper(model.MainGraph());
+
+  auto* input = helper.MakeInput<std::string>({2, 2}, strings);
+  auto* identity_out = helper.MakeOutput();
+  auto* reshape_out = helper.MakeOutput();
+  auto* normalizer_out = helper.MakeOutput();
+  auto* label_encoder_out = helper.MakeOutput();
+  auto* category_mapper_out = helper.MakeOutput();
+
+  helper.AddNode("Identity", {input}, {identity_out});
+  helper.AddNode("Reshape", {input, helper.Make1DInitializer<int64_t>({4})}, {reshape_out});
+
+  auto& normalizer = helper.AddNode("StringNormalizer", {reshape_out}, {normalizer_out});
+  normalizer.AddAttribute("case_change_action", std::string("UPPER"));
+  normalizer.AddAttribute("is_case_sensitive", int64_t(1));
+  normalizer.AddAttribute("stopwords", std::vector<std::string>{"ab"});
+
+  auto& label_encoder = helper.AddNode("LabelEncoder", {input}, {label_encoder_out}, kMLDomain);
+  label_encoder.AddAttribute("keys_strings", std::vector<std::string>{"ab", "Cde"});
+  label_encoder.AddAttribute("values_int64s", std::vector<int64_t>{1, 2});
+  label_encoder.AddAttribute("default_int64", int64_t(-1));
+
+  auto& category_mapper = helper.AddNode("CategoryMapper", {reshape_out}, {category_mapper_out}, kMLDomain);
+  category_mapper.AddAttribute("cats_strings", std::vector<std::string>{"Cde", "ab"});
+  category_mapper.AddAttribute("cats_int64s", std::vector<int64_t>{7, 8});
+  category_mapper.AddAttribute("default_int64", int64_t(0));
+
+  helper.SetGraphOutputs();
+  ASSERT_STATUS_OK(model.MainGraph().Resolve());
+
+  std::string model_data;
+  model.ToProto().SerializeToString(&model_data);
+
+  SessionOptions so;
+  so.session_logid = "StringBufferTest";
+  InferenceSession session{so, GetEnvironment()};
+  ASSERT_STATUS_OK(session.Load(model_data.data(), static_cast<int>(model_data.size())));
+  ASSERT_STATUS_OK(session.Initialize());
+
+  // feed the strings in the string buffer layout instead of the std::string tensor made by the builder
+  NameMLValMap feeds{{input->Name(), CreateStringBufferValue({2, 2}, strings)}};
+  std::vector<OrtValue> fetches;
+  ASSERT_STATUS_OK(session.Run(RunOptions(), feeds, helper.output_names_, &fetches));
+  ASSERT_EQ(fetches.size(), 5u);
+
+  EXPECT_EQ(fetches[0].Get<Tensor>().Shape(), TensorShape({2, 2}));
+  EXPECT_EQ(ReadStrings(fetches[0]), strings);
+  EXPECT_EQ(fetches[1].Get<Tensor>().Shape(), TensorShape({4}));
+  EXPECT_EQ(ReadStrings(fetches[1]), strings);
+  EXPECT_EQ(ReadStrings(fetches[2]), (std::vector<std::string>{"", "CDE"}));
+  EXPECT_EQ(ReadValues<int64_t>(fetches[3]), (std::vector<int64_t>{1, -1, 2, 1}));
+  EXPECT_EQ(ReadValues<int64_t>(fetches[4]), (std::vector<int64_t>{8, 0, 7, 8}));
+}
+
+}  // namespace test
+}  // namespace onnxruntime
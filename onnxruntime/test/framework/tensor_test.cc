@@ -3,11 +3,15 @@
 
 #include "core/framework/tensor.h"
 #include "core/framework/allocatormgr.h"
+#include "core/framework/data_transfer.h"
+#include "core/framework/string_tensor_view.h"
 #include "test_utils.h"
 
 #include "gmock/gmock.h"
 #include "gtest/gtest.h"
 
+#include <algorithm>
+#include <cstring>
 #include <sstream>
 
 namespace onnxruntime {
@@ -178,6 +182,64 @@ TEST(TensorTest, StringTensorTest) {
   }
 }
 
+TEST(TensorTest, StringBufferTensorTest) {
+  const std::string strings[] = {"a", "", "a string longer than the small string buffer", "b"};
+  TensorShape shape({2, 2});
+  auto alloc = TestCPUExecutionProvider()->GetAllocator(0, OrtMemTypeDefault);
+  size_t total_bytes = 0;
+  for (const auto& s : strings) {
+    total_bytes += s.size();
+  }
+
+  auto t = Tensor::CreateStringBuffer(shape, total_bytes, alloc);
+  EXPECT_TRUE(t->IsDataTypeString());
+  EXPECT_TRUE(t->IsStringBuffer());
+  size_t* offsets = t->MutableStringBufferOffsets();
+  char* data = t->MutableStringBufferData();
+  for (size_t i = 0; i < 4; ++i) {
+    offsets[i + 1] = offsets[i] + strings[i].size();
+    memcpy(data + offsets[i], strings[i].data(), strings[i].size());
+  }
+  EXPECT_EQ(t->SizeInBytes(), 5 * sizeof(size_t) + total_bytes);
+
+  // the tensor is moved as is
+  Tensor moved = std::move(*t);
+  EXPECT_TRUE(moved.IsStringBuffer());
+  EXPECT_FALSE(t->IsStringBuffer());
+
+  StringTensorView view(moved);
+  ASSERT_EQ(view.Size(), 4u);
+  EXPECT_EQ(view.TotalLength(), total_bytes);
+  for (size_t i = 0; i < 4; ++i) {
+    EXPECT_EQ(view[i], strings[i]);
+  }
+  EXPECT_THROW(moved.Data<std::string>(), OnnxRuntimeException);
+
+  // an alias with another shape of the same size reads the same buffer
+  auto alias = Tensor::CreateStringBufferAlias(TensorShape({4}), moved);
+  EXPECT_TRUE(alias->IsStringBuffer());
+  EXPECT_FALSE(alias->OwnsBuffer());
+  EXPECT_EQ(alias->DataRaw(), moved.DataRaw());
+  StringTensorView alias_view(*alias);
+  for (size_t i = 0; i < 4; ++i) {
+    EXPECT_EQ(alias_view[i], strings[i]);
+  }
+  EXPECT_THROW(Tensor::CreateStringBufferAlias(TensorShape({3}), moved), OnnxRuntimeException);
+
+  // a copy has std::string elements
+  Tensor copy(DataTypeImpl::GetType<std::string>(), TensorShape({4}), alloc);
+  ASSERT_TRUE(CPUDataTransfer().CopyTensor(moved, copy).IsOK());
+  EXPECT_FALSE(copy.IsStringBuffer());
+  EXPECT_TRUE(std::equal(std::begin(strings), std::end(strings), copy.Data<std::string>()));
+
+  // the view reads the std::string layout too
+  Tensor string_tensor(DataTypeImpl::GetType<std::string>(), shape, alloc);
+  std::copy(std::begin(strings), std::end(strings), string_tensor.MutableData<std::string>());
+  StringTensorView string_view(string_tensor);
+  EXPECT_EQ(string_view.TotalLength(), total_bytes);
+  EXPECT_EQ(string_view[2], strings[2]);
+}
+
 TEST(TensorTest, ConvertToString) {
   TensorShape shape({2, 3, 4});
 
@@ -0,0 +1,224 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include <functional>
+
+#include "core/framework/customregistry.h"
+#include "core/framework/op_kernel.h"
+#include "core/framework/session_state.h"
+#include "core/graph/model.h"
+#include "test/optimizer/graph_transform_test_builder.h"
+#include "test/test_environment.h"
+#include "test/util/include/inference_session_wrapper.h"
+#include "asserts.h"
+#include "gtest/gtest.h"
+
+using namespace ONNX_NAMESPACE;
+
+namespace onnxruntime {
+namespace test {
+
+// Test kernel that reports where its first input is located in the buffer of its second input.
+// The output is the byte offset of the first input into the second, or -1 if it is a separate buffer.
+struct ViewOffsetOp {
+  static constexpr const char* OpName = "ViewOffset";
+  static constexpr const char* OpDomain = "testing";
+
+  static ONNX_NAMESPACE::OpSchema OpSchema() {
+    ONNX_NAMESPACE::OpSchema schema;
+    schema.SetDoc("Return the byte offset of the view into the source, or -1 if it is not a view of the source.")
+        .SetName(OpName)
+        .SetDomain(OpDomain)
+        .SinceVersion(10)
+        .Input(0, "view", "Tensor that may be a view.", "T", OpSchema::Single)
+        .Input(1, "source", "Tensor the view may refer to.", "T", OpSchema::Single)
+        .Output(0, "offset", "Byte offset of the view into the source, or -1.", "tensor(int64)", OpSchema::Single)
+        .TypeConstraint("T", {"tensor(float)"}, "Type of the view and the source");
+    return schema;
+  }
+
+  class OpKernelImpl final : public OpKernel {
+   public:
+    OpKernelImpl(const OpKernelInfo& info) : OpKernel{info} {}
+
+    Status Compute(OpKernelContext* ctx) const override {
+      const Tensor& view = *ctx->Input<Tensor>(0);
+      const Tensor& source = *ctx->Input<Tensor>(1);
+      const auto view_address = reinterpret_cast<uintptr_t>(view.DataRaw());
+      const auto source_address = reinterpret_cast<uintptr_t>(source.DataRaw());
+
+      int64_t offset = -1;
+      if (view_address >= source_address && view_address < source_address + source.SizeInBytes()) {
+        offset = static_cast<int64_t>(view_address - source_address);
+      }
+
+      *ctx->Output(0, TensorShape({}))->MutableData<int64_t>() = offset;
+      return Status::OK();
+    }
+  };
+
+  static KernelDefBuilder KernelDef() {
+    KernelDefBuilder def;
+    def.SetName(OpName)
+        .SetDomain(OpDomain)
+        .SinceVersion(10)
+        .TypeConstraint("T", DataTypeImpl::GetTensorType<float>())
+        .Provider(onnxruntime::kCpuExecutionProvider);
+
+    return def;
+  }
+};
+
+// Build a model with build_test_case, which returns the output that may be a view and the input it may refer to.
+// A ViewOffset node is added for the pair, so the model's last output is where the kernel put the output at run time.
+// The model's first output is checked against expected_output, and the output must have been planned as a view.
+static void RunViewTest(const std::function<std::pair<NodeArg*, NodeArg*>(ModelTestBuilder& helper)>& build_test_case,
+                        const std::vector<float>& expected_output,
+                        int64_t expected_offset) {
+  auto registry = std::make_shared<CustomRegistry>();
+  std::vector<OpSchema> schemas{ViewOffsetOp::OpSchema()};
+  ASSERT_STATUS_OK(registry->RegisterOpSet(schemas, ViewOffsetOp::OpDomain, 10, 11));
+  KernelCreateFn kernel_create_fn = [](const OpKernelInfo& info) { return new ViewOffsetOp::OpKernelImpl(info); };
+  auto kernel_def = ViewOffsetOp::KernelDef();
+  ASSERT_STATUS_OK(registry->RegisterCustomKernel(kernel_def, kernel_create_fn));
+
+  IOnnxRuntimeOpSchemaRegistryList custom_schema_registries = {registry->GetOpschemaRegistry()};
+  std::unordered_map<std::string, int> domain_to_version{{kOnnxDomain, 13}, {ViewOffsetOp::OpDomain, 10}};
+  Model model("ViewOutputTest", false, ModelMetaData(), PathString(), custom_schema_registries, domain_to_version,
+              {}, DefaultLoggingManager().DefaultLogger());
+  ModelTestBuilder helper(model.MainGraph());
+  auto view_and_source = build_test_case(helper);
+  NodeArg* view = view_and_source.first;
+  helper.AddNode(ViewOffsetOp::OpName, {view, view_and_source.second}, {helper.MakeOutput()}, ViewOffsetOp::OpDomain);
+  helper.SetGraphOutputs();
+  ASSERT_STATUS_OK(model.MainGraph().Resolve());
+
+  std::string model_data;
+  model.ToProto().SerializeToString(&model_data);
+
+  SessionOptions so;
+  so.graph_optimization_level = TransformerLevel::Default;  // keep the nodes as they were built
+  InferenceSessionWrapper session{so, GetEnvironment()};
+  ASSERT_STATUS_OK(session.RegisterCustomRegistry(registry));
+  ASSERT_STATUS_OK(session.Load(model_data.data(), static_cast<int>(model_data.size())));
+  ASSERT_STATUS_OK(session.Initialize());
+
+  const SessionState& session_state = session.GetSessionState();
+  int view_index;
+  ASSERT_STATUS_OK(session_state.GetOrtValueNameIdxMap().GetIdx(view->Name(), view_index));
+  EXPECT_EQ(session_state.GetExecutionPlan()->allocation_plan[view_index].alloc_kind, AllocKind::kView);
+
+  std::vector<OrtValue> fetches;
+  ASSERT_STATUS_OK(session.Run(RunOptions(), helper.feeds_, helper.output_names_, &fetches));
+  ASSERT_EQ(fetches.size(), 2u);
+
+  const Tensor& output = fetches[0].Get<Tensor>();
+  ASSERT_EQ(static_cast<size_t>(output.Shape().Size()), expected_output.size());
+  const float* output_data = output.Data<float>();
+  for (size_t i = 0; i < expected_output.size(); ++i) {
+    EXPECT_EQ(output_data[i], expected_output[i]) << "i=" << i;
+  }
+
+  EXPECT_EQ(*fetches[1].Get<Tensor>().Data<int64_t>(), expected_offset);
+}
+
+TEST(ViewOutputTest, SliceOuterAxisToRelu) {
+  RunViewTest(
+      [](ModelTestBuilder& helper) {
+        auto* input = helper.MakeInput<float>({4, 3}, {-6, -5, -4, -3, -2, -1, 0, 1, 2, 3, 4, 5});
+        auto* slice_out = helper.MakeIntermediate();
+        helper.AddNode("Slice",
+                       {input, helper.Make1DInitializer<int64_t>({1}), helper.Make1DInitializer<int64_t>({3}),
+                        helper.Make1DInitializer<int64_t>({0})},
+                       {slice_out});
+        helper.AddNode("Relu", {slice_out}, {helper.MakeOutput()});
+        return std::make_pair(slice_out, input);
+      },
+      {0, 0, 0, 0, 1, 2},
+      // rows 1 and 2 are contiguous and start at the second row, 3 floats in
+      12);
+}
+
+TEST(ViewOutputTest, SliceInnerAxisToRelu) {
+  RunViewTest(
+      [](ModelTestBuilder& helper) {
+        auto* input = helper.MakeInput<float>({4, 3}, {-6, -5, -4, -3, -2, -1, 0, 1, 2, 3, 4, 5});
+        auto* slice_out = helper.MakeIntermediate();
+        helper.AddNode("Slice",
+                       {input, helper.Make1DInitializer<int64_t>({1}), helper.Make1DInitializer<int64_t>({3}),
+                        helper.Make1DInitializer<int64_t>({1})},
+                       {slice_out});
+        helper.AddNode("Relu", {slice_out}, {helper.MakeOutput()});
+        return std::make_pair(slice_out, input);
+      },
+      {0, 0, 0, 0, 1, 2, 4, 5},
+      // columns 1 and 2 of each row are not contiguous, so the kernel must copy them
+      -1);
+}
+
+TEST(ViewOutputTest, SplitOuterAxisToAdd) {
+  RunViewTest(
+      [](ModelTestBuilder& helper) {
+        auto* input = helper.MakeInput<float>({4, 3}, {-6, -5, -4, -3, -2, -1, 0, 1, 2, 3, 4, 5});
+        auto* relu_out = helper.MakeIntermediate();
+        auto* split_out_0 = helper.MakeIntermediate();
+        auto* split_out_1 = helper.MakeIntermediate();
+        helper.AddNode("Relu", {input}, {relu_out});
+        helper.AddNode("Split", {relu_out}, {split_out_0, split_out_1}).AddAttribute("axis", int64_t(0));
+        helper.AddNode("Add", {split_out_0, split_out_1}, {helper.MakeOutput()});
+        return std::make_pair(split_out_1, relu_out);
+      },
+      {0, 1, 2, 3, 4, 5},
+      // the second half starts after the first two rows, 6 floats in
+      24);
+}
+
+TEST(ViewOutputTest, SplitInnerAxisToAdd) {
+  RunViewTest(
+      [](ModelTestBuilder& helper) {
+        auto* input = helper.MakeInput<float>({2, 4}, {-4, -3, -2, -1, 0, 1, 2, 3});
+        auto* relu_out = helper.MakeIntermediate();
+        auto* split_out_0 = helper.MakeIntermediate();
+        auto* split_out_1 = helper.MakeIntermediate();
+        helper.AddNode("Relu", {input}, {relu_out});
+        helper.AddNode("Split", {relu_out}, {split_out_0, split_out_1}).AddAttribute("axis", int64_t(1));
+        helper.AddNode("Add", {split_out_0, split_out_1}, {helper.MakeOutput()});
+        return std::make_pair(split_out_1, relu_out);
+      },
+      {0, 0, 2, 4},
+      // each half has a block in both rows, so the kernel must copy them
+      -1);
+}
+
+TEST(ViewOutputTest, GatherOuterAxisToMul) {
+  RunViewTest(
+      [](ModelTestBuilder& helper) {
+        auto* input = helper.MakeInput<float>({3, 4}, {-6, -5, -4, -3, -2, -1, 0, 1, 2, 3, 4, 5});
+        auto* gather_out = helper.MakeIntermediate();
+        helper.AddNode("Gather", {input, helper.MakeScalarInitializer<int64_t>(1)}, {gather_out})
+            .AddAttribute("axis", int64_t(0));
+        helper.AddNode("Mul", {gather_out, gather_out}, {helper.MakeOutput()});
+        return std::make_pair(gather_out, input);
+      },
+      {4, 1, 0, 1},
+      // row 1 is a single contiguous block, 4 floats in
+      16);
+}
+
+TEST(ViewOutputTest, GatherInnerAxisToMul) {
+  RunViewTest(
+      [](ModelTestBuilder& helper) {
+        auto* input = helper.MakeInput<float>({3, 4}, {-6, -5, -4, -3, -2, -1, 0, 1, 2, 3, 4, 5});
+        auto* gather_out = helper.MakeIntermediate();
+        helper.AddNode("Gather", {input, helper.MakeScalarInitializer<int64_t>(2)}, {gather_out})
+            .AddAttribute("axis", int64_t(1));
+        helper.AddNode("Mul", {gather_out, gather_out}, {helper.MakeOutput()});
+        return std::make_pair(gather_out, input);
+      },
+      {16, 0, 16},
+      // column 2 has an element in every row, so the kernel must gather them
+      -1);
+}
+
+}  // namespace test
+}  // namespace onnxruntime
@@ -0,0 +1,203 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "test_util.h"
+
+template <bool Threaded>
+class MlasGroupNormTest : public MlasTestBase {
+ private:
+  MatrixGuardBuffer<float> BufferInput;
+  MatrixGuardBuffer<float> BufferScale;
+  MatrixGuardBuffer<float> BufferBias;
+  MatrixGuardBuffer<float> BufferOutput;
+  MatrixGuardBuffer<float> BufferOutputReference;
+  MLAS_THREADPOOL* threadpool_;
+
+  //
+  // Offset of element s of channel c of batch n, for the NCHW layout (BlockSize of one) or the NCHWc layout.
+  //
+
+  static size_t ElementOffset(size_t n, size_t c, size_t s, size_t Channels, size_t BlockSize, size_t SpatialSize) {
+    const size_t Block = c / BlockSize;
+    return ((n * (Channels / BlockSize) + Block) * SpatialSize + s) * BlockSize + (c % BlockSize);
+  }
+
+  static float ReferenceActivation(const MLAS_ACTIVATION& Activation, float Value) {
+    return (Activation.ActivationKind == MlasReluActivation) ? (std::max)(Value, 0.0f) : Value;
+  }
+
+  //
+  // Compute the mean in a first pass and the variance of the deviations from it in a second pass.
+  //
+
+  void ReferenceGroupNorm(const float* Input, const float* Scale, const float* Bias, float* Output,
+                          size_t BatchCount, size_t Channels, size_t BlockSize, size_t SpatialSize, size_t GroupCount,
+                          float Epsilon, const MLAS_ACTIVATION& Activation) {
+    const size_t ChannelsPerGroup = Channels / GroupCount;
+    const double GroupElements = double(ChannelsPerGroup * SpatialSize);
+
+    for (size_t n = 0; n < BatchCount; n++) {
+      for (size_t g = 0; g < GroupCount; g++) {
+        const size_t FirstChannel = g * ChannelsPerGroup;
+
+        double Mean = 0.0;
+        for (size_t c = FirstChannel; c < FirstChannel + ChannelsPerGroup; c++) {
+          for (size_t s = 0; s < SpatialSize; s++) {
+            Mean += Input[ElementOffset(n, c, s, Channels, BlockSize, SpatialSize)];
+          }
+        }
+        Mean /= GroupElements;
+
+        double Variance = 0.0;
+        for (size_t c = FirstChannel; c < FirstChannel + ChannelsPerGroup; c++) {
+          for (size_t s = 0; s < SpatialSize; s++) {
+            double Deviation = Input[ElementOffset(n, c, s, Channels, BlockSize, SpatialSize)] - Mean;
+            Variance += Deviation * Deviation;
+          }
+        }
+        Variance /= GroupElements;
+
+        const double InvStdDev = 1.0 / std::sqrt(Variance + Epsilon);
+
+        for (size_t c = FirstChannel; c < FirstChannel + ChannelsPerGroup; c++) {
+          for (size_t s = 0; s < SpatialSize; s++) {
+            size_t Offset = ElementOffset(n, c, s, Channels, BlockSize, SpatialSize);
+            double Value = (Input[Offset] - Mean) * InvStdDev * Scale[c] + Bias[c];
+            Output[Offset] = ReferenceActivation(Activation, float(Value));
+          }
+        }
+      }
+    }
+  }
+
+  void ReferenceScaleShift(const float* Input, const float* Scale, const float* Shift, float* Output,
+                           size_t BatchCount, size_t Channels, size_t BlockSize, size_t SpatialSize,
+                           const MLAS_ACTIVATION& Activation) {
+    for (size_t n = 0; n < BatchCount; n++) {
+      for (size_t c = 0; c < Channels; c++) {
+        for (size_t s = 0; s < SpatialSize; s++) {
+          size_t Offset = ElementOffset(n, c, s, Channels, BlockSize, SpatialSize);
+          Output[Offset] = ReferenceActivation(Activation, Input[Offset] * Scale[c] + Shift[c]);
+        }
+      }
+    }
+  }
+
+  void FillParameters(float* Scale, float* Bias, size_t Channels) {
+    std::default_random_engine generator(static_cast<unsigned>(Channels));
+    std::uniform_real_distribution<float> scale_distribution(0.5f, 1.5f);
+    std::uniform_real_distribution<float> bias_distribution(-1.0f, 1.0f);
+
+    for (size_t c = 0; c < Channels; c++) {
+      Scale[c] = scale_distribution(generator);
+      Bias[c] = bias_distribution(generator);
+    }
+  }
+
+  void Test(size_t BatchCount, size_t Channels, size_t BlockSize, size_t SpatialSize, size_t GroupCount,
+            float Mean, float StdDev, float AbsoluteTolerance) {
+    const size_t ElementCount = BatchCount * Channels * SpatialSize;
+
+    float* Input = BufferInput.GetBuffer(ElementCount);
+    float* Scale = BufferScale.GetBuffer(Channels);
+    float* Bias = BufferBias.GetBuffer(Channels);
+    float* Output = BufferOutput.GetBuffer(ElementCount);
+    float* OutputReference = BufferOutputReference.GetBuffer(ElementCount);
+
+    std::default_random_engine generator(static_cast<unsigned>(ElementCount));
+    std::normal_distribution<float> distribution(Mean, StdDev);
+
+    for (size_t i = 0; i < ElementCount; i++) {
+      Input[i] = distribution(generator);
+    }
+
+    FillParameters(Scale, Bias, Channels);
+
+    for (auto kind : {MlasIdentityActivation, MlasReluActivation}) {
+      MLAS_ACTIVATION Activation;
+      Activation.ActivationKind = kind;
+
+      constexpr float Epsilon = 1e-5f;
+
+      MlasComputeGroupNorm(Input, Scale, Bias, Output, BatchCount, Channels, BlockSize, SpatialSize, GroupCount,
+                           Epsilon, &Activation, threadpool_);
+      ReferenceGroupNorm(Input, Scale, Bias, OutputReference, BatchCount, Channels, BlockSize, SpatialSize,
+                         GroupCount, Epsilon, Activation);
+
+      for (size_t i = 0; i < ElementCount; i++) {
+        float diff = std::fabs(Output[i] - OutputReference[i]);
+        ASSERT_TRUE(diff <= AbsoluteTolerance)
+            << "GroupNorm @" << i << " of " << BatchCount << "x" << Channels << "x" << SpatialSize
+            << " block " << BlockSize << " groups " << GroupCount << " mean " << Mean << " stddev " << StdDev
+            << ", got: " << Output[i] << ", expecting: " << OutputReference[i];
+      }
+
+      MlasComputeScaleShift(Input, Scale, Bias, Output, BatchCount, Channels, BlockSize, SpatialSize,
+                            &Activation, threadpool_);
+      ReferenceScaleShift(Input, Scale, Bias, OutputReference, BatchCount, Channels, BlockSize, SpatialSize,
+                          Activation);
+
+      for (size_t i = 0; i < ElementCount; i++) {
+        float diff = std::fabs(Output[i] - OutputReference[i]);
+        ASSERT_TRUE(diff <= 1e-6f || diff <= std::fabs(OutputReference[i]) * 1e-6f)
+            << "ScaleShift @" << i << " of " << BatchCount << "x" << Channels << "x" << SpatialSize
+            << " block " << BlockSize << ", got: " << Output[i] << ", expecting: " << OutputReference[i];
+      }
+    }
+  }
+
+ public:
+  static const char* GetTestSuiteName() {
+    static const std::string suite_name(Threaded ? "GroupNorm_Threaded" : "GroupNorm_SingleThread");
+    return suite_name.c_str();
+  }
+
+  MlasGroupNormTest() : threadpool_(Threaded ? GetMlasThreadPool() : nullptr) {}
+
+  void ExecuteShort(void) override {
+    //
+    // NCHW layout: single element groups, odd spatial sizes, instance normalization and a single group.
+    //
+
+    Test(1, 1, 1, 1, 1, 0.f, 1.f, 1e-4f);
+    Test(2, 6, 1, 13, 3, 0.f, 1.f, 1e-4f);
+    Test(3, 8, 1, 49, 8, 2.f, 3.f, 1e-4f);
+    Test(2, 32, 1, 7, 1, -1.f, 0.5f, 1e-4f);
+    Test(1, 4, 1, 1000, 2, 0.f, 1.f, 1e-4f);
+
+    //
+    // NCHWc layout: groups that are the block, span several blocks, or divide the block.
+    //
+
+    for (size_t GroupCount : {1, 2, 4, 16}) {
+      Test(2, 16, 8, 9, GroupCount, 0.f, 1.f, 1e-4f);
+    }
+    for (size_t GroupCount : {2, 8, 32}) {
+      Test(1, 32, 16, 25, GroupCount, 1.f, 2.f, 1e-4f);
+    }
+    Test(3, 12, 4, 5, 6, 0.f, 1.f, 1e-4f);
+
+    //
+    // Large mean and small variance: a single pass E[x^2] - E[x]^2 loses every significant digit of the variance
+    // here. The tolerance covers the rounding of the mean itself, which is scaled up by the small deviation.
+    //
+
+    Test(2, 6, 1, 300, 3, 1000.f, 0.1f, 2e-3f);
+    Test(1, 16, 8, 75, 2, 1000.f, 0.1f, 2e-3f);
+    Test(1, 16, 8, 75, 8, -1000.f, 0.1f, 2e-3f);
+  }
+};
+
+template <> MlasGroupNormTest<false>* MlasTestFixture<MlasGroupNormTest<false>>::mlas_tester(nullptr);
+template <> MlasGroupNormTest<true>* MlasTestFixture<MlasGroupNormTest<true>>::mlas_tester(nullptr);
+
+static UNUSED_VARIABLE bool added_to_main = AddTestRegister([](bool is_short_execute) {
+  size_t count = 0;
+  if (is_short_execute) {
+    count += MlasDirectShortExecuteTests<MlasGroupNormTest<false>>::RegisterShortExecute();
+    if (GetMlasThreadPool() != nullptr) {
+      count += MlasDirectShortExecuteTests<MlasGroupNormTest<true>>::RegisterShortExecute();
+    }
+  }
+  return count;
+});
@@ -0,0 +1,229 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "test_util.h"
+
+template <bool Threaded>
+class MlasLayerNormTest : public MlasTestBase {
+ private:
+  MatrixGuardBuffer<float> BufferInput;
+  MatrixGuardBuffer<float> BufferSkip;
+  MatrixGuardBuffer<float> BufferBias;
+  MatrixGuardBuffer<float> BufferGamma;
+  MatrixGuardBuffer<float> BufferBeta;
+  MatrixGuardBuffer<float> BufferOutput;
+  MatrixGuardBuffer<float> BufferSumOutput;
+  MatrixGuardBuffer<float> BufferMean;
+  MatrixGuardBuffer<float> BufferInvStdDev;
+  MatrixGuardBuffer<float> BufferOutputReference;
+  MatrixGuardBuffer<float> BufferSumOutputReference;
+  MatrixGuardBuffer<float> BufferMeanReference;
+  MatrixGuardBuffer<float> BufferInvStdDevReference;
+  MLAS_THREADPOOL* threadpool_;
+
+  //
+  // Sum the input, skip and bias of each row, then compute the mean in a first pass and the variance of the
+  // deviations from it in a second pass.
+  //
+
+  static void ReferenceLayerNorm(const float* Input, const float* Skip, const float* Bias, const float* Gamma,
+                                 const float* Beta, float* Output, float* SumOutput, float* Mean, float* InvStdDev,
+                                 size_t N, size_t D, float Epsilon, bool Simplified) {
+    for (size_t n = 0; n < N; n++) {
+      for (size_t d = 0; d < D; d++) {
+        float Value = Input[n * D + d];
+        if (Skip != nullptr) {
+          Value += Skip[n * D + d];
+        }
+        if (Bias != nullptr) {
+          Value += Bias[d];
+        }
+        SumOutput[n * D + d] = Value;
+      }
+
+      const float* Row = SumOutput + n * D;
+
+      double MeanValue = 0.0;
+      if (!Simplified) {
+        for (size_t d = 0; d < D; d++) {
+          MeanValue += Row[d];
+        }
+        MeanValue /= double(D);
+      }
+
+      double Variance = 0.0;
+      for (size_t d = 0; d < D; d++) {
+        double Deviation = Row[d] - MeanValue;
+        Variance += Deviation * Deviation;
+      }
+      Variance /= double(D);
+
+      const double InvStdDevValue = 1.0 / std::sqrt(Variance + Epsilon);
+
+      for (size_t d = 0; d < D; d++) {
+        double Value = (Row[d] - MeanValue) * InvStdDevValue * Gamma[d];
+        if (Beta != nullptr) {
+          Value += Beta[d];
+        }
+        Output[n * D + d] = float(Value);
+      }
+
+      Mean[n] = float(MeanValue);
+      InvStdDev[n] = float(InvStdDevValue);
+    }
+  }
+
+  static void Fill(float* Buffer, size_t Count, float MinimumValue, float MaximumValue, unsigned Seed) {
+    std::default_random_engine generator(Seed);
+    std::uniform_real_distribution<float> distribution(MinimumValue, MaximumValue);
+
+    for (size_t i = 0; i < Count; i++) {
+      Buffer[i] = distribution(generator);
+    }
+  }
+
+  static bool IsClose(float Value, float Reference, float Tolerance) {
+    const float Difference = std::fabs(Value - Reference);
+    return Difference <= Tolerance || Difference <= std::fabs(Reference) * Tolerance;
+  }
+
+  //
+  // Run the kernel with or without each optional input and output. InPlace passes the output buffer as the input,
+  // which then holds a copy of the input.
+  //
+
+  void Test(size_t N, size_t D, bool HasSkip, bool HasBias, bool HasBeta, bool HasStatistics, bool HasSumOutput,
+            bool Simplified, bool InPlace) {
+    constexpr float Epsilon = 1e-5f;
+    constexpr float Tolerance = 1e-4f;
+
+    const size_t ElementCount = N * D;
+
+    float* Input = BufferInput.GetBuffer(ElementCount);
+    float* Skip = HasSkip ? BufferSkip.GetBuffer(ElementCount) : nullptr;
+    float* Bias = HasBias ? BufferBias.GetBuffer(D) : nullptr;
+    float* Gamma = BufferGamma.GetBuffer(D);
+    float* Beta = HasBeta ? BufferBeta.GetBuffer(D) : nullptr;
+    float* Output = BufferOutput.GetBuffer(ElementCount);
+    float* SumOutput = HasSumOutput ? BufferSumOutput.GetBuffer(ElementCount) : nullptr;
+    float* Mean = HasStatistics ? BufferMean.GetBuffer(N) : nullptr;
+    float* InvStdDev = HasStatistics ? BufferInvStdDev.GetBuffer(N) : nullptr;
+    float* OutputReference = BufferOutputReference.GetBuffer(ElementCount);
+    float* SumOutputReference = BufferSumOutputReference.GetBuffer(ElementCount);
+    float* MeanReference = BufferMeanReference.GetBuffer(N);
+    float* InvStdDevReference = BufferInvStdDevReference.GetBuffer(N);
+
+    const unsigned Seed = static_cast<unsigned>(ElementCount);
+
+    Fill(Input, ElementCount, -2.f, 2.f, Seed);
+    if (Skip != nullptr) {
+      Fill(Skip, ElementCount, -1.f, 1.f, Seed + 1);
+    }
+    if (Bias != nullptr) {
+      Fill(Bias, D, -0.5f, 0.5f, Seed + 2);
+    }
+    Fill(Gamma, D, 0.5f, 1.5f, Seed + 3);
+    if (Beta != nullptr) {
+      Fill(Beta, D, -1.f, 1.f, Seed + 4);
+    }
+
+    ReferenceLayerNorm(Input, Skip, Bias, Gamma, Beta, OutputReference, SumOutputReference, MeanReference,
+                       InvStdDevReference, N, D, Epsilon, Simplified);
+
+    const float* KernelInput = Input;
+    if (InPlace) {
+      std::copy_n(Input, ElementCount, Output);
+      KernelInput = Output;
+    }
+
+    MlasComputeLayerNorm(KernelInput, Skip, Bias, Gamma, Beta, Output, SumOutput, Mean, InvStdDev, N, D, Epsilon,
+                         Simplified, threadpool_);
+
+    std::ostringstream Description;
+    Description << N << "x" << D << (HasSkip ? " skip" : "") << (HasBias ? " bias" : "") << (HasBeta ? " beta" : "")
+                << (HasStatistics ? " statistics" : "") << (HasSumOutput ? " sum" : "")
+                << (Simplified ? " simplified" : "") << (InPlace ? " in place" : "");
+
+    for (size_t i = 0; i < ElementCount; i++) {
+      ASSERT_TRUE(IsClose(Output[i], OutputReference[i], Tolerance))
+          << "Output @" << i << " of " << Description.str() << ", got: " << Output[i]
+          << ", expecting: " << OutputReference[i];
+    }
+
+    //
+    // The sum is only produced when there is something to add to the input.
+    //
+
+    if (SumOutput != nullptr && (HasSkip || HasBias)) {
+      for (size_t i = 0; i < ElementCount; i++) {
+        ASSERT_EQ(SumOutput[i], SumOutputReference[i])
+            << "SumOutput @" << i << " of " << Description.str();
+      }
+    }
+
+    if (HasStatistics) {
+      for (size_t n = 0; n < N; n++) {
+        ASSERT_TRUE(IsClose(Mean[n], MeanReference[n], Tolerance))
+            << "Mean @" << n << " of " << Description.str() << ", got: " << Mean[n]
+            << ", expecting: " << MeanReference[n];
+        ASSERT_TRUE(IsClose(InvStdDev[n], InvStdDevReference[n], Tolerance))
+            << "InvStdDev @" << n << " of " << Description.str() << ", got: " << InvStdDev[n]
+            << ", expecting: " << InvStdDevReference[n];
+      }
+    }
+  }
+
+ public:
+  static const char* GetTestSuiteName() {
+    static const std::string suite_name(Threaded ? "LayerNorm_Threaded" : "LayerNorm_SingleThread");
+    return suite_name.c_str();
+  }
+
+  MlasLayerNormTest() : threadpool_(Threaded ? GetMlasThreadPool() : nullptr) {}
+
+  void ExecuteShort(void) override {
+    //
+    // Every row length up to a few vectors of each width, so the vector loops and every scalar or masked tail
+    // are covered, with each optional input and output.
+    //
+
+    for (size_t D = 1; D < 70; D++) {
+      for (size_t N : {1, 3}) {
+        for (bool Simplified : {false, true}) {
+          Test(N, D, false, false, true, false, false, Simplified, false);
+          Test(N, D, true, true, true, true, true, Simplified, false);
+          Test(N, D, true, false, false, true, false, Simplified, false);
+          Test(N, D, false, true, true, false, true, Simplified, false);
+        }
+      }
+    }
+
+    //
+    // The BERT hidden sizes and enough rows to be split across threads, in place and not.
+    //
+
+    for (size_t D : {256, 384, 768, 1027}) {
+      for (bool Simplified : {false, true}) {
+        for (bool InPlace : {false, true}) {
+          Test(7, D, true, true, true, true, true, Simplified, InPlace);
+          Test(64, D, true, true, true, true, false, Simplified, InPlace);
+          Test(33, D, false, false, false, false, false, Simplified, InPlace);
+        }
+      }
+    }
+  }
+};
+
+template <> MlasLayerNormTest<false>* MlasTestFixture<MlasLayerNormTest<false>>::mlas_tester(nullptr);
+template <> MlasLayerNormTest<true>* MlasTestFixture<MlasLayerNormTest<true>>::mlas_tester(nullptr);
+
+static UNUSED_VARIABLE bool added_to_main = AddTestRegister([](bool is_short_execute) {
+  size_t count = 0;
+  if (is_short_execute) {
+    count += MlasDirectShortExecuteTests<MlasLayerNormTest<false>>::RegisterShortExecute();
+    if (GetMlasThreadPool() != nullptr) {
+      count += MlasDirectShortExecuteTests<MlasLayerNormTest<true>>::RegisterShortExecute();
+    }
+  }
+  return count;
+});
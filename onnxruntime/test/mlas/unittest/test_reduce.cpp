@@ -0,0 +1,283 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "test_util.h"
+
+class MlasReduceTest : public MlasTestBase {
+ private:
+  MatrixGuardBuffer<float> BufferInput;
+  MatrixGuardBuffer<float> BufferPass;
+  MatrixGuardBuffer<float> BufferOutput;
+  MatrixGuardBuffer<float> BufferOutputReference;
+  MatrixGuardBuffer<float> BufferOutputTolerance;
+
+  static const char* KindName(MLAS_REDUCTION_KIND ReductionKind) {
+    static const char* const Names[] = {"Sum", "Mean", "SumSquare", "Maximum", "Minimum", "LogSumExp"};
+    return Names[ReductionKind];
+  }
+
+  //
+  // Reduce N elements that are Stride elements apart. The tolerance is scaled by the magnitude of the terms,
+  // so a sum that cancels out is still compared against the rounding error of its terms.
+  //
+
+  static void ReferenceReduce(MLAS_REDUCTION_KIND ReductionKind, const float* Input, size_t N, size_t Stride,
+                              float* Output, float* Tolerance) {
+    constexpr double RelativeTolerance = 1e-5;
+
+    double Value = 0.0;
+    double Magnitude = 0.0;
+
+    switch (ReductionKind) {
+      case MlasSumReduction:
+      case MlasMeanReduction: {
+        for (size_t n = 0; n < N; n++) {
+          Value += Input[n * Stride];
+          Magnitude += std::fabs(Input[n * Stride]);
+        }
+        if (ReductionKind == MlasMeanReduction) {
+          Value /= double(N);
+          Magnitude /= double(N);
+        }
+        break;
+      }
+
+      case MlasSumSquareReduction: {
+        for (size_t n = 0; n < N; n++) {
+          Value += double(Input[n * Stride]) * double(Input[n * Stride]);
+        }
+        Magnitude = Value;
+        break;
+      }
+
+      case MlasMaximumReduction:
+      case MlasMinimumReduction: {
+        Value = Input[0];
+        for (size_t n = 1; n < N; n++) {
+          double Element = Input[n * Stride];
+          Value = (ReductionKind == MlasMaximumReduction) ? (std::max)(Value, Element) : (std::min)(Value, Element);
+        }
+        Magnitude = 0.0;
+        break;
+      }
+
+      case MlasLogSumExpReduction: {
+        // NaN wins, then +inf. -inf elements contribute nothing, so a row of only -inf reduces to -inf.
+        double Maximum = -std::numeric_limits<double>::infinity();
+        bool HasNaN = false;
+        for (size_t n = 0; n < N; n++) {
+          double Element = Input[n * Stride];
+          HasNaN |= std::isnan(Element);
+          if (Element > Maximum) {
+            Maximum = Element;
+          }
+        }
+        if (HasNaN) {
+          Value = std::numeric_limits<double>::quiet_NaN();
+        } else if (std::isinf(Maximum)) {
+          Value = Maximum;
+        } else {
+          double Sum = 0.0;
+          for (size_t n = 0; n < N; n++) {
+            Sum += std::exp(double(Input[n * Stride]) - Maximum);
+          }
+          Value = std::log(Sum) + Maximum;
+        }
+        Magnitude = std::isfinite(Value) ? std::fabs(Value) + 1.0 : 0.0;
+        break;
+      }
+
+      default:
+        break;
+    }
+
+    *Output = float(Value);
+    *Tolerance = float(RelativeTolerance * (std::max)(1.0, Magnitude));
+  }
+
+  static bool IsClose(float Value, float Reference, float Tolerance) {
+    if (std::isnan(Reference)) {
+      return std::isnan(Value);
+    }
+    if (std::isinf(Reference)) {
+      return Value == Reference;
+    }
+    return std::fabs(Value - Reference) <= Tolerance;
+  }
+
+  void FillInput(float* Input, size_t Count, float MinimumValue, float MaximumValue) {
+    std::default_random_engine generator(static_cast<unsigned>(Count));
+    std::uniform_real_distribution<float> distribution(MinimumValue, MaximumValue);
+
+    for (size_t i = 0; i < Count; i++) {
+      Input[i] = distribution(generator);
+    }
+  }
+
+  //
+  // Replace one element of each row with Special, at a position that moves between the vector body and the
+  // scalar tail from row to row.
+  //
+
+  static void InjectSpecial(float* Input, size_t Rows, size_t Columns, size_t LeadingDimension, float Special) {
+    for (size_t r = 0; r < Rows; r++) {
+      Input[r * LeadingDimension + (r * 7 + Columns - 1) % Columns] = Special;
+    }
+  }
+
+  void TestRows(MLAS_REDUCTION_KIND ReductionKind, const float* Input, size_t Rows, size_t Columns) {
+    float* Output = BufferOutput.GetBuffer(Rows);
+    float* OutputReference = BufferOutputReference.GetBuffer(Rows);
+    float* OutputTolerance = BufferOutputTolerance.GetBuffer(Rows);
+
+    MlasReduceRows(ReductionKind, Input, Output, Rows, Columns);
+
+    for (size_t r = 0; r < Rows; r++) {
+      ReferenceReduce(ReductionKind, Input + r * Columns, Columns, 1, &OutputReference[r], &OutputTolerance[r]);
+    }
+
+    for (size_t r = 0; r < Rows; r++) {
+      ASSERT_TRUE(IsClose(Output[r], OutputReference[r], OutputTolerance[r]))
+          << KindName(ReductionKind) << " rows @" << r << " of " << Rows << "x" << Columns
+          << ", got: " << Output[r] << ", expecting: " << OutputReference[r];
+    }
+  }
+
+  void TestColumns(MLAS_REDUCTION_KIND ReductionKind, const float* Input, size_t Rows, size_t Columns,
+                   size_t LeadingDimension) {
+    float* Output = BufferOutput.GetBuffer(Columns);
+    float* OutputReference = BufferOutputReference.GetBuffer(Columns);
+    float* OutputTolerance = BufferOutputTolerance.GetBuffer(Columns);
+
+    MlasReduceColumns(ReductionKind, Input, Output, Rows, Columns, LeadingDimension);
+
+    for (size_t c = 0; c < Columns; c++) {
+      ReferenceReduce(ReductionKind, Input + c, Rows, LeadingDimension, &OutputReference[c], &OutputTolerance[c]);
+    }
+
+    for (size_t c = 0; c < Columns; c++) {
+      ASSERT_TRUE(IsClose(Output[c], OutputReference[c], OutputTolerance[c]))
+          << KindName(ReductionKind) << " columns @" << c << " of " << Rows << "x" << Columns
+          << " (ld " << LeadingDimension << "), got: " << Output[c] << ", expecting: " << OutputReference[c];
+    }
+  }
+
+  void Test(size_t Rows, size_t Columns, float MinimumValue, float MaximumValue) {
+    float* Input = BufferInput.GetBuffer(Rows * Columns);
+    FillInput(Input, Rows * Columns, MinimumValue, MaximumValue);
+
+    for (int kind = 0; kind < MlasReductionKindCount; kind++) {
+      TestRows(MLAS_REDUCTION_KIND(kind), Input, Rows, Columns);
+    }
+
+    //
+    // Also reduce all but the last column, so the leading dimension is larger than the number of columns.
+    //
+
+    for (int kind = 0; kind < MlasReductionKindCount; kind++) {
+      TestColumns(MLAS_REDUCTION_KIND(kind), Input, Rows, Columns, Columns);
+      if (Columns > 1) {
+        TestColumns(MLAS_REDUCTION_KIND(kind), Input, Rows, Columns - 1, Columns);
+      }
+    }
+  }
+
+  void TestNonFinite(size_t Rows, size_t Columns, float Special) {
+    float* Input = BufferInput.GetBuffer(Rows * Columns);
+    FillInput(Input, Rows * Columns, -10.f, 10.f);
+    InjectSpecial(Input, Rows, Columns, Columns, Special);
+
+    TestRows(MlasLogSumExpReduction, Input, Rows, Columns);
+    TestColumns(MlasLogSumExpReduction, Input, Rows, Columns, Columns);
+
+    //
+    // The ordering of NaN with the other elements is not defined for the maximum and the minimum.
+    //
+
+    if (!std::isnan(Special)) {
+      for (auto kind : {MlasSumReduction, MlasMaximumReduction, MlasMinimumReduction}) {
+        TestRows(kind, Input, Rows, Columns);
+        TestColumns(kind, Input, Rows, Columns, Columns);
+      }
+    }
+  }
+
+  void TestAllNegativeInfinity(size_t Rows, size_t Columns) {
+    float* Input = BufferInput.GetBuffer(Rows * Columns);
+    std::fill_n(Input, Rows * Columns, -std::numeric_limits<float>::infinity());
+
+    TestRows(MlasLogSumExpReduction, Input, Rows, Columns);
+    TestColumns(MlasLogSumExpReduction, Input, Rows, Columns, Columns);
+  }
+
+  //
+  // Reduce the outer and the inner axes of a [D0, D1, D2] tensor in two passes, the way the ReduceMean operator
+  // reduces axes that are not adjacent: the rows of D2 elements first, then the columns of the [D0, D1] means.
+  // The mean of the partial means is the mean, as every partial mean averages the same number of elements.
+  //
+
+  void TestMeanTwoPass(size_t D0, size_t D1, size_t D2) {
+    float* Input = BufferInput.GetBuffer(D0 * D1 * D2);
+    float* Pass = BufferPass.GetBuffer(D0 * D1);
+    float* Output = BufferOutput.GetBuffer(D1);
+
+    FillInput(Input, D0 * D1 * D2, 5.f, 15.f);
+
+    MlasReduceRows(MlasMeanReduction, Input, Pass, D0 * D1, D2);
+    MlasReduceColumns(MlasMeanReduction, Pass, Output, D0, D1, D1);
+
+    for (size_t j = 0; j < D1; j++) {
+      double Sum = 0.0;
+      for (size_t i = 0; i < D0; i++) {
+        for (size_t k = 0; k < D2; k++) {
+          Sum += Input[(i * D1 + j) * D2 + k];
+        }
+      }
+      float Reference = float(Sum / double(D0 * D2));
+
+      ASSERT_TRUE(std::fabs(Output[j] - Reference) <= 1e-5f * std::fabs(Reference))
+          << "two pass mean @" << j << " of " << D0 << "x" << D1 << "x" << D2
+          << ", got: " << Output[j] << ", expecting: " << Reference;
+    }
+  }
+
+ public:
+  static const char* GetTestSuiteName() {
+    static const std::string suite_name("Reduce");
+    return suite_name.c_str();
+  }
+
+  void ExecuteShort(void) override {
+    for (size_t Columns = 1; Columns < 40; Columns++) {
+      for (size_t Rows : {1, 2, 3, 7}) {
+        Test(Rows, Columns, -10.f, 10.f);
+      }
+    }
+
+    // Blocks of the log-sum-exp column reduction and large values that overflow without the shift.
+    Test(5, 67, -10.f, 10.f);
+    Test(3, 130, 80.f, 100.f);
+    Test(17, 131, -100.f, -80.f);
+
+    for (size_t Columns : {1, 3, 4, 5, 16, 19, 67}) {
+      for (size_t Rows : {1, 3, 5}) {
+        TestNonFinite(Rows, Columns, std::numeric_limits<float>::infinity());
+        TestNonFinite(Rows, Columns, -std::numeric_limits<float>::infinity());
+        TestNonFinite(Rows, Columns, std::numeric_limits<float>::quiet_NaN());
+        TestAllNegativeInfinity(Rows, Columns);
+      }
+    }
+
+    TestMeanTwoPass(1, 1, 1);
+    TestMeanTwoPass(3, 5, 7);
+    TestMeanTwoPass(7, 19, 33);
+    TestMeanTwoPass(13, 67, 5);
+  }
+};
+
+template <> MlasReduceTest* MlasTestFixture<MlasReduceTest>::mlas_tester(nullptr);
+
+static UNUSED_VARIABLE bool added_to_main = AddTestRegister([](bool is_short_execute) {
+  // no long execute needed
+  return is_short_execute ? MlasDirectShortExecuteTests<MlasReduceTest>::RegisterShortExecute() : 0;
+});
@@ -0,0 +1,296 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include <benchmark/benchmark.h>
+#include <core/graph/onnx_protobuf.h>
+#include <core/session/onnxruntime_c_api.h>
+#include <core/session/ort_env.h>
+
+#include <cstring>
+#include <functional>
+#include <numeric>
+#include <random>
+#include <string>
+#include <vector>
+
+extern OrtEnv* env;
+extern const OrtApi* g_ort;
+
+#define ORT_BREAK_ON_ERROR(expr)                                \
+  do {                                                          \
+    OrtStatus* onnx_status = (expr);                            \
+    if (onnx_status != NULL) {                                  \
+      state.SkipWithError(g_ort->GetErrorMessage(onnx_status)); \
+      g_ort->ReleaseStatus(onnx_status);                        \
+      return;                                                   \
+    }                                                           \
+  } while (0);
+
+namespace {
+
+struct BenchmarkInput {
+  std::string name;
+  ONNX_NAMESPACE::TensorProto_DataType type;
+  std::vector<int64_t> shape;
+  std::vector<uint8_t> data;
+};
+
+int64_t NumElements(const std::vector<int64_t>& shape) {
+  return std::accumulate(shape.begin(), shape.end(), int64_t{1}, std::multiplies<int64_t>());
+}
+
+template <typename T>
+BenchmarkInput MakeInput(const char* name, ONNX_NAMESPACE::TensorProto_DataType type, std::vector<int64_t> shape,
+                         const std::function<T(int64_t)>& value) {
+  const int64_t size = NumElements(shape);
+  BenchmarkInput input{name, type, std::move(shape), std::vector<uint8_t>(static_cast<size_t>(size) * sizeof(T))};
+  auto* data = reinterpret_cast<T*>(input.data.data());
+  for (int64_t i = 0; i < size; ++i) {
+    data[i] = value(i);
+  }
+  return input;
+}
+
+BenchmarkInput RandomFloatInput(const char* name, std::vector<int64_t> shape) {
+  std::mt19937 gen(42);
+  std::uniform_real_distribution<float> dist(-1.f, 1.f);
+  return MakeInput<float>(name, ONNX_NAMESPACE::TensorProto_DataType_FLOAT, std::move(shape),
+                          [&](int64_t) { return dist(gen); });
+}
+
+BenchmarkInput RandomIndicesInput(const char* name, std::vector<int64_t> shape, int64_t limit) {
+  std::mt19937 gen(7);
+  std::uniform_int_distribution<int64_t> dist(0, limit - 1);
+  return MakeInput<int64_t>(name, ONNX_NAMESPACE::TensorProto_DataType_INT64, std::move(shape),
+                            [&](int64_t) { return dist(gen); });
+}
+
+BenchmarkInput Int64Input(const char* name, const std::vector<int64_t>& values) {
+  return MakeInput<int64_t>(name, ONNX_NAMESPACE::TensorProto_DataType_INT64,
+                            {static_cast<int64_t>(values.size())}, [&](int64_t i) { return values[i]; });
+}
+
+// Runs a model with a single node of the given op taking all inputs from the graph inputs.
+void RunSingleNodeModel(benchmark::State& state, const char* op_type, int opset,
+                        const std::function<void(ONNX_NAMESPACE::NodeProto&)>& add_attributes,
+                        const std::vector<BenchmarkInput>& inputs, int num_threads) {
+  ONNX_NAMESPACE::ModelProto model_proto;
+  model_proto.set_ir_version(ONNX_NAMESPACE::IR_VERSION);
+  auto* opset_import = model_proto.add_opset_import();
+  opset_import->set_domain("");
+  opset_import->set_version(opset);
+
+  auto* graph = model_proto.mutable_graph();
+  graph->set_name(op_type);
+  auto* node = graph->add_node();
+  node->set_op_type(op_type);
+  if (add_attributes) {
+    add_attributes(*node);
+  }
+
+  std::vector<const char*> input_names;
+  for (const auto& input : inputs) {
+    node->add_input(input.name);
+    auto* value_info = graph->add_input();
+    value_info->set_name(input.name);
+    value_info->mutable_type()->mutable_tensor_type()->set_elem_type(input.type);
+    input_names.push_back(input.name.c_str());
+  }
+
+  node->add_output("output");
+  auto* output_info = graph->add_output();
+  output_info->set_name("output");
+  output_info->mutable_type()->mutable_tensor_type()->set_elem_type(
+      op_type == std::string("Where") ? inputs[1].type : inputs[0].type);
+
+  const std::string model = model_proto.SerializeAsString();
+  OrtSessionOptions* session_options;
+  ORT_BREAK_ON_ERROR(g_ort->CreateSessionOptions(&session_options));
+  ORT_BREAK_ON_ERROR(g_ort->SetIntraOpNumThreads(session_options, num_threads));
+  OrtSession* session;
+  ORT_BREAK_ON_ERROR(g_ort->CreateSessionFromArray(env, model.data(), model.size(), session_options, &session));
+
+  OrtMemoryInfo* memory_info;
+  ORT_BREAK_ON_ERROR(g_ort->CreateCpuMemoryInfo(OrtArenaAllocator, OrtMemTypeDefault, &memory_info));
+  std::vector<OrtValue*> input_values(inputs.size(), nullptr);
+  for (size_t i = 0; i < inputs.size(); ++i) {
+    auto& input = inputs[i];
+    ORT_BREAK_ON_ERROR(g_ort->CreateTensorWithDataAsOrtValue(
+        memory_info, const_cast<uint8_t*>(input.data.data()), input.data.size(), input.shape.data(),
+        input.shape.size(), static_cast<ONNXTensorElementDataType>(input.type), &input_values[i]));
+  }
+
+  const char* output_names[] = {"output"};
+  for (auto _ : state) {
+    OrtValue* output_value = nullptr;
+    ORT_BREAK_ON_ERROR(g_ort->Run(session, nullptr, input_names.data(), input_values.data(), input_values.size(),
+                                  output_names, 1, &output_value));
+    g_ort->ReleaseValue(output_value);
+  }
+
+  for (OrtValue* value : input_values) {
+    g_ort->ReleaseValue(value);
+  }
+  g_ort->ReleaseMemoryInfo(memory_info);
+  g_ort->ReleaseSession(session);
+  g_ort->ReleaseSessionOptions(session_options);
+}
+
+void AddIntAttribute(ONNX_NAMESPACE::NodeProto& node, const char* name, int64_t value) {
+  auto* attr = node.add_attribute();
+  attr->set_name(name);
+  attr->set_type(ONNX_NAMESPACE::AttributeProto_AttributeType_INT);
+  attr->set_i(value);
+}
+
+void AddStringAttribute(ONNX_NAMESPACE::NodeProto& node, const char* name, const char* value) {
+  auto* attr = node.add_attribute();
+  attr->set_name(name);
+  attr->set_type(ONNX_NAMESPACE::AttributeProto_AttributeType_STRING);
+  attr->set_s(value);
+}
+
+}  // namespace
+
+// All benchmarks take the number of intra op threads as their last argument (0 for default).
+
+// Concatenating the hidden states of two encoders: 2 x [32, 128, 1024] along axis 1 and 2.
+static void BM_Concat(benchmark::State& state) {
+  const int64_t axis = state.range(0);
+  std::vector<BenchmarkInput> inputs{RandomFloatInput("a", {32, 128, 1024}), RandomFloatInput("b", {32, 128, 1024})};
+  RunSingleNodeModel(
+      state, "Concat", 13, [axis](ONNX_NAMESPACE::NodeProto& node) { AddIntAttribute(node, "axis", axis); },
+      inputs, static_cast<int>(state.range(1)));
+}
+
+BENCHMARK(BM_Concat)
+    ->UseRealTime()
+    ->Unit(benchmark::TimeUnit::kMillisecond)
+    ->Args({1, 1})
+    ->Args({1, 0})
+    ->Args({2, 1})
+    ->Args({2, 0});
+
+// Padding the spatial dims of a [8, 64, 112, 112] feature map by 1 (mode 0: constant, 1: edge, 2: reflect).
+static void BM_Pad(benchmark::State& state) {
+  static const char* modes[] = {"constant", "edge", "reflect"};
+  const char* mode = modes[state.range(0)];
+  std::vector<BenchmarkInput> inputs{RandomFloatInput("data", {8, 64, 112, 112}),
+                                     Int64Input("pads", {0, 0, 1, 1, 0, 0, 1, 1})};
+  RunSingleNodeModel(
+      state, "Pad", 13, [mode](ONNX_NAMESPACE::NodeProto& node) { AddStringAttribute(node, "mode", mode); },
+      inputs, static_cast<int>(state.range(1)));
+}
+
+BENCHMARK(BM_Pad)
+    ->UseRealTime()
+    ->Unit(benchmark::TimeUnit::kMillisecond)
+    ->Args({0, 1})
+    ->Args({0, 0})
+    ->Args({1, 1})
+    ->Args({1, 0})
+    ->Args({2, 1})
+    ->Args({2, 0});
+
+// Broadcasting an embedding table over the batch ([1, 128, 1024] x [32, 1, 1]) and a general tiling of
+// [64, 32, 64] by [1, 4, 4].
+static void BM_Tile(benchmark::State& state) {
+  const bool general = state.range(0) != 0;
+  std::vector<BenchmarkInput> inputs;
+  if (general) {
+    inputs.push_back(RandomFloatInput("input", {64, 32, 64}));
+    inputs.push_back(Int64Input("repeats", {1, 4, 4}));
+  } else {
+    inputs.push_back(RandomFloatInput("input", {1, 128, 1024}));
+    inputs.push_back(Int64Input("repeats", {32, 1, 1}));
+  }
+  RunSingleNodeModel(state, "Tile", 13, nullptr, inputs, static_cast<int>(state.range(1)));
+}
+
+BENCHMARK(BM_Tile)
+    ->UseRealTime()
+    ->Unit(benchmark::TimeUnit::kMillisecond)
+    ->Args({0, 1})
+    ->Args({0, 0})
+    ->Args({1, 1})
+    ->Args({1, 0});
+
+// Scattering 16 values into each row of a [4096, 1024] tensor.
+static void BM_ScatterElements(benchmark::State& state) {
+  std::vector<BenchmarkInput> inputs{RandomFloatInput("data", {4096, 1024}),
+                                     RandomIndicesInput("indices", {4096, 16}, 1024),
+                                     RandomFloatInput("updates", {4096, 16})};
+  RunSingleNodeModel(
+      state, "ScatterElements", 13, [](ONNX_NAMESPACE::NodeProto& node) { AddIntAttribute(node, "axis", 1); },
+      inputs, static_cast<int>(state.range(0)));
+}
+
+BENCHMARK(BM_ScatterElements)
+    ->UseRealTime()
+    ->Unit(benchmark::TimeUnit::kMillisecond)
+    ->Arg(1)
+    ->Arg(0);
+
+// Updating 10000 rows of a [100000, 256] embedding table.
+static void BM_ScatterND(benchmark::State& state) {
+  std::vector<BenchmarkInput> inputs{RandomFloatInput("data", {100000, 256}),
+                                     RandomIndicesInput("indices", {10000, 1}, 100000),
+                                     RandomFloatInput("updates", {10000, 256})};
+  RunSingleNodeModel(state, "ScatterND", 13, nullptr, inputs, static_cast<int>(state.range(0)));
+}
+
+BENCHMARK(BM_ScatterND)
+    ->UseRealTime()
+    ->Unit(benchmark::TimeUnit::kMillisecond)
+    ->Arg(1)
+    ->Arg(0);
+
+// Gathering along the last axis (axis 1) and along the rows (axis 0) of a [4096, 1024] tensor.
+static void BM_GatherElements(benchmark::State& state) {
+  const int64_t axis = state.range(0);
+  std::vector<BenchmarkInput> inputs{RandomFloatInput("data", {4096, 1024}),
+                                     RandomIndicesInput("indices", {4096, 1024}, axis == 0 ? 4096 : 1024)};
+  RunSingleNodeModel(
+      state, "GatherElements", 13, [axis](ONNX_NAMESPACE::NodeProto& node) { AddIntAttribute(node, "axis", axis); },
+      inputs, static_cast<int>(state.range(1)));
+}
+
+BENCHMARK(BM_GatherElements)
+    ->UseRealTime()
+    ->Unit(benchmark::TimeUnit::kMillisecond)
+    ->Args({0, 1})
+    ->Args({0, 0})
+    ->Args({1, 1})
+    ->Args({1, 0});
+
+// Masking a [64, 512, 512] tensor of attention scores.
+static void BM_Where(benchmark::State& state) {
+  std::mt19937 gen(3);
+  std::bernoulli_distribution dist(0.5);
+  std::vector<BenchmarkInput> inputs{
+      MakeInput<bool>("condition", ONNX_NAMESPACE::TensorProto_DataType_BOOL, {64, 512, 512},
+                      [&](int64_t) { return dist(gen); }),
+      RandomFloatInput("x", {64, 512, 512}),
+      RandomFloatInput("y", {64, 512, 512})};
+  RunSingleNodeModel(state, "Where", 9, nullptr, inputs, static_cast<int>(state.range(0)));
+}
+
+BENCHMARK(BM_Where)
+    ->UseRealTime()
+    ->Unit(benchmark::TimeUnit::kMillisecond)
+    ->Arg(1)
+    ->Arg(0);
+
+// Running sums over axis 1 (strided) and 2 (contiguous) of a [64, 512, 512] tensor.
+static void BM_CumSum(benchmark::State& state) {
+  std::vector<BenchmarkInput> inputs{RandomFloatInput("x", {64, 512, 512}), Int64Input("axis", {state.range(0)})};
+  RunSingleNodeModel(state, "CumSum", 14, nullptr, inputs, static_cast<int>(state.range(1)));
+}
+
+BENCHMARK(BM_CumSum)
+    ->UseRealTime()
+    ->Unit(benchmark::TimeUnit::kMillisecond)
+    ->Args({1, 1})
+    ->Args({1, 0})
+    ->Args({2, 1})
+    ->Args({2, 0});
@@ -0,0 +1,153 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include <benchmark/benchmark.h>
+#include <core/graph/onnx_protobuf.h>
+#include <core/session/onnxruntime_c_api.h>
+#include <core/session/ort_env.h>
+
+#include <random>
+#include <string>
+#include <vector>
+
+extern OrtEnv* env;
+extern const OrtApi* g_ort;
+
+#define ORT_BREAK_ON_ERROR(expr)                                \
+  do {                                                          \
+    OrtStatus* onnx_status = (expr);                            \
+    if (onnx_status != NULL) {                                  \
+      state.SkipWithError(g_ort->GetErrorMessage(onnx_status)); \
+      g_ort->ReleaseStatus(onnx_status);                        \
+      return;                                                   \
+    }                                                           \
+  } while (0);
+
+namespace {
+
+std::vector<float> RandomFloats(size_t size, float range, uint32_t seed) {
+  std::mt19937 gen(seed);
+  std::uniform_real_distribution<float> dist(-range, range);
+  std::vector<float> values(size);
+  for (auto& value : values) {
+    value = dist(gen);
+  }
+  return values;
+}
+
+void AddInitializer(ONNX_NAMESPACE::GraphProto& graph, const char* name, const std::vector<int64_t>& shape,
+                    const std::vector<float>& values) {
+  auto* tensor = graph.add_initializer();
+  tensor->set_name(name);
+  tensor->set_data_type(ONNX_NAMESPACE::TensorProto_DataType_FLOAT);
+  for (int64_t dim : shape) {
+    tensor->add_dims(dim);
+  }
+  tensor->set_raw_data(values.data(), values.size() * sizeof(float));
+}
+
+// Runs a forward LSTM with constant W, R and B (so the weights are pre-packed) over X of shape
+// [seq_length, batch_size, input_size], fetching either Y or only Y_h.
+void RunLstm(benchmark::State& state, int64_t seq_length, int64_t batch_size, int64_t input_size,
+             int64_t hidden_size, bool output_sequence, int num_threads) {
+  ONNX_NAMESPACE::ModelProto model_proto;
+  model_proto.set_ir_version(ONNX_NAMESPACE::IR_VERSION);
+  auto* opset_import = model_proto.add_opset_import();
+  opset_import->set_domain("");
+  opset_import->set_version(14);
+
+  auto* graph = model_proto.mutable_graph();
+  graph->set_name("LSTM");
+  auto* node = graph->add_node();
+  node->set_op_type("LSTM");
+  auto* attr = node->add_attribute();
+  attr->set_name("hidden_size");
+  attr->set_type(ONNX_NAMESPACE::AttributeProto_AttributeType_INT);
+  attr->set_i(hidden_size);
+
+  const float range = 1.f / static_cast<float>(hidden_size);
+  AddInitializer(*graph, "W", {1, 4 * hidden_size, input_size},
+                 RandomFloats(static_cast<size_t>(4 * hidden_size * input_size), range, 1));
+  AddInitializer(*graph, "R", {1, 4 * hidden_size, hidden_size},
+                 RandomFloats(static_cast<size_t>(4 * hidden_size * hidden_size), range, 2));
+  AddInitializer(*graph, "B", {1, 8 * hidden_size}, RandomFloats(static_cast<size_t>(8 * hidden_size), range, 3));
+
+  for (const char* name : {"X", "W", "R", "B"}) {
+    node->add_input(name);
+  }
+
+  auto* input_info = graph->add_input();
+  input_info->set_name("X");
+  input_info->mutable_type()->mutable_tensor_type()->set_elem_type(ONNX_NAMESPACE::TensorProto_DataType_FLOAT);
+
+  const char* output_name = output_sequence ? "Y" : "Y_h";
+  node->add_output(output_sequence ? "Y" : "");
+  if (!output_sequence) {
+    node->add_output("Y_h");
+  }
+  auto* output_info = graph->add_output();
+  output_info->set_name(output_name);
+  output_info->mutable_type()->mutable_tensor_type()->set_elem_type(ONNX_NAMESPACE::TensorProto_DataType_FLOAT);
+
+  const std::string model = model_proto.SerializeAsString();
+  OrtSessionOptions* session_options;
+  ORT_BREAK_ON_ERROR(g_ort->CreateSessionOptions(&session_options));
+  ORT_BREAK_ON_ERROR(g_ort->SetIntraOpNumThreads(session_options, num_threads));
+  OrtSession* session;
+  ORT_BREAK_ON_ERROR(g_ort->CreateSessionFromArray(env, model.data(), model.size(), session_options, &session));
+
+  std::vector<float> X = RandomFloats(static_cast<size_t>(seq_length * batch_size * input_size), 1.f, 4);
+  std::vector<int64_t> X_shape{seq_length, batch_size, input_size};
+  OrtMemoryInfo* memory_info;
+  ORT_BREAK_ON_ERROR(g_ort->CreateCpuMemoryInfo(OrtArenaAllocator, OrtMemTypeDefault, &memory_info));
+  OrtValue* input_value = nullptr;
+  ORT_BREAK_ON_ERROR(g_ort->CreateTensorWithDataAsOrtValue(memory_info, X.data(), X.size() * sizeof(float),
+                                                           X_shape.data(), X_shape.size(),
+                                                           ONNX_TENSOR_ELEMENT_DATA_TYPE_FLOAT, &input_value));
+
+  const char* input_names[] = {"X"};
+  const char* output_names[] = {output_name};
+  for (auto _ : state) {
+    OrtValue* output_value = nullptr;
+    ORT_BREAK_ON_ERROR(g_ort->Run(session, nullptr, input_names, &input_value, 1, output_names, 1, &output_value));
+    g_ort->ReleaseValue(output_value);
+  }
+
+  g_ort->ReleaseValue(input_value);
+  g_ort->ReleaseMemoryInfo(memory_info);
+  g_ort->ReleaseSession(session);
+  g_ort->ReleaseSessionOptions(session_options);
+}
+
+}  // namespace
+
+// Streaming speech style LSTM: a single sequence of 100 frames with 80 features.
+// Args: hidden size, output the full sequence (1) or only Y_h (0), number of intra op threads (0 for default).
+static void BM_LstmSingleSequence(benchmark::State& state) {
+  RunLstm(state, 100, 1, 80, state.range(0), state.range(1) != 0, static_cast<int>(state.range(2)));
+}
+
+BENCHMARK(BM_LstmSingleSequence)
+    ->UseRealTime()
+    ->Unit(benchmark::TimeUnit::kMillisecond)
+    ->Args({256, 1, 1})
+    ->Args({256, 1, 0})
+    ->Args({512, 1, 1})
+    ->Args({512, 1, 0})
+    ->Args({512, 0, 0})
+    ->Args({1024, 1, 1})
+    ->Args({1024, 1, 0});
+
+// Small and large batches of 50 step sequences with 256 features.
+// Args: batch size, hidden size, number of intra op threads (0 for default).
+static void BM_LstmBatch(benchmark::State& state) {
+  RunLstm(state, 50, state.range(0), 256, state.range(1), true, static_cast<int>(state.range(2)));
+}
+
+BENCHMARK(BM_LstmBatch)
+    ->UseRealTime()
+    ->Unit(benchmark::TimeUnit::kMillisecond)
+    ->Args({4, 512, 0})
+    ->Args({32, 256, 1})
+    ->Args({32, 256, 0})
+    ->Args({32, 512, 0});
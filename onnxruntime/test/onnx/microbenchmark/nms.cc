@@ -0,0 +1,150 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include <benchmark/benchmark.h>
+#include <core/graph/onnx_protobuf.h>
+#include <core/session/onnxruntime_c_api.h>
+#include <core/session/ort_env.h>
+
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+extern OrtEnv* env;
+extern const OrtApi* g_ort;
+
+#define ORT_BREAK_ON_ERROR(expr)                                \
+  do {                                                          \
+    OrtStatus* onnx_status = (expr);                            \
+    if (onnx_status != NULL) {                                  \
+      state.SkipWithError(g_ort->GetErrorMessage(onnx_status)); \
+      g_ort->ReleaseStatus(onnx_status);                        \
+      return;                                                   \
+    }                                                           \
+  } while (0);
+
+// A model with a single NonMaxSuppression node taking all inputs from the graph inputs.
+static std::string CreateNonMaxSuppressionModel() {
+  ONNX_NAMESPACE::ModelProto model;
+  model.set_ir_version(ONNX_NAMESPACE::IR_VERSION);
+  auto* opset = model.add_opset_import();
+  opset->set_domain("");
+  opset->set_version(11);
+
+  auto* graph = model.mutable_graph();
+  graph->set_name("nms");
+  auto* node = graph->add_node();
+  node->set_op_type("NonMaxSuppression");
+
+  const auto add_value_info = [](ONNX_NAMESPACE::ValueInfoProto* value_info, const char* name, int elem_type) {
+    value_info->set_name(name);
+    value_info->mutable_type()->mutable_tensor_type()->set_elem_type(elem_type);
+  };
+
+  const std::pair<const char*, int> inputs[] = {
+      {"boxes", ONNX_NAMESPACE::TensorProto_DataType_FLOAT},
+      {"scores", ONNX_NAMESPACE::TensorProto_DataType_FLOAT},
+      {"max_output_boxes_per_class", ONNX_NAMESPACE::TensorProto_DataType_INT64},
+      {"iou_threshold", ONNX_NAMESPACE::TensorProto_DataType_FLOAT},
+      {"score_threshold", ONNX_NAMESPACE::TensorProto_DataType_FLOAT}};
+  for (const auto& input : inputs) {
+    node->add_input(input.first);
+    add_value_info(graph->add_input(), input.first, input.second);
+  }
+
+  node->add_output("selected_indices");
+  add_value_info(graph->add_output(), "selected_indices", ONNX_NAMESPACE::TensorProto_DataType_INT64);
+
+  return model.SerializeAsString();
+}
+
+// Args: number of anchors, number of classes, max_output_boxes_per_class, intra op threads (0 for default).
+// Boxes are normalized [y1, x1, y2, x2] with detector like sizes, and most scores are close to 0 like the
+// output of a sigmoid/softmax head.
+static void BM_NonMaxSuppression(benchmark::State& state) {
+  const int64_t num_boxes = state.range(0);
+  const int64_t num_classes = state.range(1);
+  int64_t max_output_boxes_per_class = state.range(2);
+  const int num_threads = static_cast<int>(state.range(3));
+  float iou_threshold = 0.45f;
+  float score_threshold = 0.05f;
+
+  std::mt19937 gen(42);
+  std::uniform_real_distribution<float> center_dist(0.f, 1.f);
+  std::uniform_real_distribution<float> size_dist(0.02f, 0.3f);
+  std::uniform_real_distribution<float> score_dist(0.f, 1.f);
+  std::vector<float> boxes(static_cast<size_t>(num_boxes * 4));
+  for (int64_t i = 0; i < num_boxes; ++i) {
+    const float y = center_dist(gen);
+    const float x = center_dist(gen);
+    const float h = size_dist(gen) / 2;
+    const float w = size_dist(gen) / 2;
+    boxes[4 * i] = y - h;
+    boxes[4 * i + 1] = x - w;
+    boxes[4 * i + 2] = y + h;
+    boxes[4 * i + 3] = x + w;
+  }
+  std::vector<float> scores(static_cast<size_t>(num_classes * num_boxes));
+  for (auto& score : scores) {
+    const float s = score_dist(gen);
+    score = s * s * s * s;
+  }
+
+  const std::string model = CreateNonMaxSuppressionModel();
+  OrtSessionOptions* session_options;
+  ORT_BREAK_ON_ERROR(g_ort->CreateSessionOptions(&session_options));
+  ORT_BREAK_ON_ERROR(g_ort->SetIntraOpNumThreads(session_options, num_threads));
+  OrtSession* session;
+  ORT_BREAK_ON_ERROR(g_ort->CreateSessionFromArray(env, model.data(), model.size(), session_options, &session));
+
+  OrtMemoryInfo* memory_info;
+  ORT_BREAK_ON_ERROR(g_ort->CreateCpuMemoryInfo(OrtArenaAllocator, OrtMemTypeDefault, &memory_info));
+  const int64_t boxes_shape[] = {1, num_boxes, 4};
+  const int64_t scores_shape[] = {1, num_classes, num_boxes};
+  OrtValue* input_values[5] = {};
+  ORT_BREAK_ON_ERROR(g_ort->CreateTensorWithDataAsOrtValue(memory_info, boxes.data(), boxes.size() * sizeof(float),
+                                                           boxes_shape, 3, ONNX_TENSOR_ELEMENT_DATA_TYPE_FLOAT,
+                                                           &input_values[0]));
+  ORT_BREAK_ON_ERROR(g_ort->CreateTensorWithDataAsOrtValue(memory_info, scores.data(), scores.size() * sizeof(float),
+                                                           scores_shape, 3, ONNX_TENSOR_ELEMENT_DATA_TYPE_FLOAT,
+                                                           &input_values[1]));
+  ORT_BREAK_ON_ERROR(g_ort->CreateTensorWithDataAsOrtValue(memory_info, &max_output_boxes_per_class, sizeof(int64_t),
+                                                           nullptr, 0, ONNX_TENSOR_ELEMENT_DATA_TYPE_INT64,
+                                                           &input_values[2]));
+  ORT_BREAK_ON_ERROR(g_ort->CreateTensorWithDataAsOrtValue(memory_info, &iou_threshold, sizeof(float),
+                                                           nullptr, 0, ONNX_TENSOR_ELEMENT_DATA_TYPE_FLOAT,
+                                                           &input_values[3]));
+  ORT_BREAK_ON_ERROR(g_ort->CreateTensorWithDataAsOrtValue(memory_info, &score_threshold, sizeof(float),
+                                                           nullptr, 0, ONNX_TENSOR_ELEMENT_DATA_TYPE_FLOAT,
+                                                           &input_values[4]));
+
+  const char* input_names[] = {"boxes", "scores", "max_output_boxes_per_class", "iou_threshold", "score_threshold"};
+  const char* output_names[] = {"selected_indices"};
+  for (auto _ : state) {
+    OrtValue* output_value = nullptr;
+    ORT_BREAK_ON_ERROR(g_ort->Run(session, nullptr, input_names, input_values, 5, output_names, 1, &output_value));
+    g_ort->ReleaseValue(output_value);
+  }
+
+  for (OrtValue* value : input_values) {
+    g_ort->ReleaseValue(value);
+  }
+  g_ort->ReleaseMemoryInfo(memory_info);
+  g_ort->ReleaseSession(session);
+  g_ort->ReleaseSessionOptions(session_options);
+}
+
+// SSD MobileNet (1917 anchors, 91 classes), YOLOv3 at 416x416 (10647 anchors, 80 classes) and
+// YOLOv5 at 640x640 (25200 anchors, 80 classes).
+BENCHMARK(BM_NonMaxSuppression)
+    ->UseRealTime()
+    ->Unit(benchmark::TimeUnit::kMillisecond)
+    ->Args({1917, 91, 100, 1})
+    ->Args({1917, 91, 100, 0})
+    ->Args({10647, 80, 100, 1})
+    ->Args({10647, 80, 100, 0})
+    ->Args({25200, 80, 100, 1})
+    ->Args({25200, 80, 100, 0})
+    ->Args({25200, 80, 1000, 1})
+    ->Args({25200, 80, 1000, 0});
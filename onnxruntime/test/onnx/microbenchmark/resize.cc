@@ -0,0 +1,164 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include <benchmark/benchmark.h>
+#include <core/graph/onnx_protobuf.h>
+#include <core/session/onnxruntime_c_api.h>
+#include <core/session/ort_env.h>
+
+#include <random>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+extern OrtEnv* env;
+extern const OrtApi* g_ort;
+
+#define ORT_BREAK_ON_ERROR(expr)                                \
+  do {                                                          \
+    OrtStatus* onnx_status = (expr);                            \
+    if (onnx_status != NULL) {                                  \
+      state.SkipWithError(g_ort->GetErrorMessage(onnx_status)); \
+      g_ort->ReleaseStatus(onnx_status);                        \
+      return;                                                   \
+    }                                                           \
+  } while (0);
+
+namespace {
+
+void AddFloatInitializer(ONNX_NAMESPACE::GraphProto& graph, const char* name, const std::vector<float>& values) {
+  auto* tensor = graph.add_initializer();
+  tensor->set_name(name);
+  tensor->set_data_type(ONNX_NAMESPACE::TensorProto_DataType_FLOAT);
+  tensor->add_dims(static_cast<int64_t>(values.size()));
+  for (float value : values) {
+    tensor->add_float_data(value);
+  }
+}
+
+// Resizes the spatial axes of an image batch by `scale` with constant scales (so they are cached by the kernel).
+// The input is [batch, channels, height, width] or [batch, height, width, channels] if `nhwc` is set.
+template <typename T>
+void RunResize(benchmark::State& state, const char* mode, bool nhwc, int64_t batch, int64_t channels,
+               int64_t height, int64_t width, float scale) {
+  constexpr auto elem_type = std::is_same<T, float>::value ? ONNX_NAMESPACE::TensorProto_DataType_FLOAT
+                                                           : ONNX_NAMESPACE::TensorProto_DataType_UINT8;
+  constexpr auto ort_elem_type = std::is_same<T, float>::value ? ONNX_TENSOR_ELEMENT_DATA_TYPE_FLOAT
+                                                               : ONNX_TENSOR_ELEMENT_DATA_TYPE_UINT8;
+
+  ONNX_NAMESPACE::ModelProto model_proto;
+  model_proto.set_ir_version(ONNX_NAMESPACE::IR_VERSION);
+  auto* opset_import = model_proto.add_opset_import();
+  opset_import->set_domain("");
+  opset_import->set_version(13);
+
+  auto* graph = model_proto.mutable_graph();
+  graph->set_name("Resize");
+  auto* node = graph->add_node();
+  node->set_op_type("Resize");
+  auto* attr = node->add_attribute();
+  attr->set_name("mode");
+  attr->set_type(ONNX_NAMESPACE::AttributeProto_AttributeType_STRING);
+  attr->set_s(mode);
+
+  AddFloatInitializer(*graph, "roi", {});
+  AddFloatInitializer(*graph, "scales", nhwc ? std::vector<float>{1.f, scale, scale, 1.f}
+                                             : std::vector<float>{1.f, 1.f, scale, scale});
+
+  for (const char* name : {"X", "roi", "scales"}) {
+    node->add_input(name);
+  }
+  node->add_output("Y");
+
+  auto* input_info = graph->add_input();
+  input_info->set_name("X");
+  input_info->mutable_type()->mutable_tensor_type()->set_elem_type(elem_type);
+  auto* output_info = graph->add_output();
+  output_info->set_name("Y");
+  output_info->mutable_type()->mutable_tensor_type()->set_elem_type(elem_type);
+
+  const std::string model = model_proto.SerializeAsString();
+  OrtSessionOptions* session_options;
+  ORT_BREAK_ON_ERROR(g_ort->CreateSessionOptions(&session_options));
+  OrtSession* session;
+  ORT_BREAK_ON_ERROR(g_ort->CreateSessionFromArray(env, model.data(), model.size(), session_options, &session));
+
+  std::mt19937 gen(1);
+  std::uniform_int_distribution<int> dist(0, 255);
+  std::vector<T> X(static_cast<size_t>(batch * channels * height * width));
+  for (auto& value : X) {
+    value = static_cast<T>(dist(gen));
+  }
+  std::vector<int64_t> X_shape = nhwc ? std::vector<int64_t>{batch, height, width, channels}
+                                      : std::vector<int64_t>{batch, channels, height, width};
+  OrtMemoryInfo* memory_info;
+  ORT_BREAK_ON_ERROR(g_ort->CreateCpuMemoryInfo(OrtArenaAllocator, OrtMemTypeDefault, &memory_info));
+  OrtValue* input_value = nullptr;
+  ORT_BREAK_ON_ERROR(g_ort->CreateTensorWithDataAsOrtValue(memory_info, X.data(), X.size() * sizeof(T),
+                                                           X_shape.data(), X_shape.size(), ort_elem_type,
+                                                           &input_value));
+
+  const char* input_names[] = {"X"};
+  const char* output_names[] = {"Y"};
+  for (auto _ : state) {
+    OrtValue* output_value = nullptr;
+    ORT_BREAK_ON_ERROR(g_ort->Run(session, nullptr, input_names, &input_value, 1, output_names, 1, &output_value));
+    g_ort->ReleaseValue(output_value);
+  }
+
+  g_ort->ReleaseValue(input_value);
+  g_ort->ReleaseMemoryInfo(memory_info);
+  g_ort->ReleaseSession(session);
+  g_ort->ReleaseSessionOptions(session_options);
+}
+
+}  // namespace
+
+// Segmentation decoder style upsampling of a feature map.
+// Args: channels, input height and width, scale.
+static void BM_ResizeBilinearNCHW(benchmark::State& state) {
+  RunResize<float>(state, "linear", false, 1, state.range(0), state.range(1), state.range(1),
+                   static_cast<float>(state.range(2)));
+}
+
+BENCHMARK(BM_ResizeBilinearNCHW)
+    ->UseRealTime()
+    ->Unit(benchmark::TimeUnit::kMicrosecond)
+    ->Args({3, 224, 2})
+    ->Args({21, 64, 8})
+    ->Args({256, 32, 2});
+
+static void BM_ResizeBicubicNCHW(benchmark::State& state) {
+  RunResize<float>(state, "cubic", false, 1, state.range(0), state.range(1), state.range(1),
+                   static_cast<float>(state.range(2)));
+}
+
+BENCHMARK(BM_ResizeBicubicNCHW)
+    ->UseRealTime()
+    ->Unit(benchmark::TimeUnit::kMicrosecond)
+    ->Args({3, 224, 2})
+    ->Args({21, 64, 8});
+
+// Image preprocessing style resize of interleaved RGB images.
+// Args: input height and width, scale in percent.
+static void BM_ResizeBilinearNHWCUint8(benchmark::State& state) {
+  RunResize<uint8_t>(state, "linear", true, 1, 3, state.range(0), state.range(0),
+                     static_cast<float>(state.range(1)) / 100.f);
+}
+
+BENCHMARK(BM_ResizeBilinearNHWCUint8)
+    ->UseRealTime()
+    ->Unit(benchmark::TimeUnit::kMicrosecond)
+    ->Args({1024, 25})
+    ->Args({224, 200});
+
+static void BM_ResizeBilinearNHWC(benchmark::State& state) {
+  RunResize<float>(state, "linear", true, 1, 3, state.range(0), state.range(0),
+                   static_cast<float>(state.range(1)) / 100.f);
+}
+
+BENCHMARK(BM_ResizeBilinearNHWC)
+    ->UseRealTime()
+    ->Unit(benchmark::TimeUnit::kMicrosecond)
+    ->Args({1024, 25})
+    ->Args({224, 200});
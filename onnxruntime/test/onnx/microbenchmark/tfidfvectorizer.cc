@@ -0,0 +1,171 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include <benchmark/benchmark.h>
+#include <core/graph/onnx_protobuf.h>
+#include <core/session/onnxruntime_c_api.h>
+#include <core/session/ort_env.h>
+
+#include <random>
+#include <string>
+#include <vector>
+
+extern OrtEnv* env;
+extern const OrtApi* g_ort;
+
+#define ORT_BREAK_ON_ERROR(expr)                                \
+  do {                                                          \
+    OrtStatus* onnx_status = (expr);                            \
+    if (onnx_status != NULL) {                                  \
+      state.SkipWithError(g_ort->GetErrorMessage(onnx_status)); \
+      g_ort->ReleaseStatus(onnx_status);                        \
+      return;                                                   \
+    }                                                           \
+  } while (0);
+
+namespace {
+
+constexpr int64_t kVocabularySize = 50000;
+constexpr int64_t kRowLength = 256;
+
+void AddAttribute(ONNX_NAMESPACE::NodeProto& node, const char* name, const std::vector<int64_t>& values) {
+  auto* attr = node.add_attribute();
+  attr->set_name(name);
+  attr->set_type(ONNX_NAMESPACE::AttributeProto_AttributeType_INTS);
+  for (auto value : values) attr->add_ints(value);
+}
+
+void AddAttribute(ONNX_NAMESPACE::NodeProto& node, const char* name, int64_t value) {
+  auto* attr = node.add_attribute();
+  attr->set_name(name);
+  attr->set_type(ONNX_NAMESPACE::AttributeProto_AttributeType_INT);
+  attr->set_i(value);
+}
+
+// Text classification style vectorizer: every token of the vocabulary is a uni-gram of the pool, followed by
+// `n_bigrams` random bi-grams.
+std::string CreateTfIdfVectorizerModel(int64_t n_bigrams, int64_t max_skip_count, const std::string& mode) {
+  std::vector<int64_t> pool;
+  pool.reserve(static_cast<size_t>(kVocabularySize + 2 * n_bigrams));
+  for (int64_t token = 0; token < kVocabularySize; ++token) {
+    pool.push_back(token);
+  }
+  // Duplicated bi-grams are rejected by the kernel: the i-th bi-gram pairs a scattered token with the token
+  // (1 + i / kVocabularySize) positions after it, so no two bi-grams are equal.
+  for (int64_t i = 0; i < n_bigrams; ++i) {
+    const int64_t first = (i * 7919) % kVocabularySize;
+    pool.push_back(first);
+    pool.push_back((first + 1 + i / kVocabularySize) % kVocabularySize);
+  }
+  const int64_t n_ngrams = kVocabularySize + n_bigrams;
+  std::vector<int64_t> ngram_indexes(static_cast<size_t>(n_ngrams));
+  for (int64_t i = 0; i < n_ngrams; ++i) {
+    ngram_indexes[i] = i;
+  }
+
+  ONNX_NAMESPACE::ModelProto model_proto;
+  model_proto.set_ir_version(ONNX_NAMESPACE::IR_VERSION);
+  auto* opset_import = model_proto.add_opset_import();
+  opset_import->set_domain("");
+  opset_import->set_version(9);
+
+  auto* graph = model_proto.mutable_graph();
+  graph->set_name("TfIdfVectorizer");
+  auto* node = graph->add_node();
+  node->set_op_type("TfIdfVectorizer");
+  node->add_input("X");
+  node->add_output("Y");
+
+  auto* attr = node->add_attribute();
+  attr->set_name("mode");
+  attr->set_type(ONNX_NAMESPACE::AttributeProto_AttributeType_STRING);
+  attr->set_s(mode);
+  AddAttribute(*node, "min_gram_length", static_cast<int64_t>(1));
+  AddAttribute(*node, "max_gram_length", static_cast<int64_t>(2));
+  AddAttribute(*node, "max_skip_count", max_skip_count);
+  AddAttribute(*node, "ngram_counts", std::vector<int64_t>{0, kVocabularySize});
+  AddAttribute(*node, "ngram_indexes", ngram_indexes);
+  AddAttribute(*node, "pool_int64s", pool);
+  if (mode != "TF") {
+    attr = node->add_attribute();
+    attr->set_name("weights");
+    attr->set_type(ONNX_NAMESPACE::AttributeProto_AttributeType_FLOATS);
+    std::mt19937 gen(1);
+    std::uniform_real_distribution<float> weight_dist(0.5f, 2.f);
+    for (int64_t i = 0; i < n_ngrams; ++i) attr->add_floats(weight_dist(gen));
+  }
+
+  auto* input_info = graph->add_input();
+  input_info->set_name("X");
+  input_info->mutable_type()->mutable_tensor_type()->set_elem_type(ONNX_NAMESPACE::TensorProto_DataType_INT64);
+  auto* output_info = graph->add_output();
+  output_info->set_name("Y");
+  output_info->mutable_type()->mutable_tensor_type()->set_elem_type(ONNX_NAMESPACE::TensorProto_DataType_FLOAT);
+
+  return model_proto.SerializeAsString();
+}
+
+void RunTfIdfVectorizer(benchmark::State& state, const std::string& mode) {
+  const int64_t n_bigrams = state.range(0);
+  const int64_t max_skip_count = state.range(1);
+  const int64_t N = state.range(2);
+
+  const std::string model = CreateTfIdfVectorizerModel(n_bigrams, max_skip_count, mode);
+  OrtSessionOptions* session_options;
+  ORT_BREAK_ON_ERROR(g_ort->CreateSessionOptions(&session_options));
+  OrtSession* session;
+  ORT_BREAK_ON_ERROR(g_ort->CreateSessionFromArray(env, model.data(), model.size(), session_options, &session));
+
+  std::mt19937 gen(2);
+  std::uniform_int_distribution<int64_t> token_dist(0, kVocabularySize - 1);
+  std::vector<int64_t> X(static_cast<size_t>(N * kRowLength));
+  for (auto& value : X) {
+    value = token_dist(gen);
+  }
+  std::vector<int64_t> X_shape{N, kRowLength};
+  OrtMemoryInfo* memory_info;
+  ORT_BREAK_ON_ERROR(g_ort->CreateCpuMemoryInfo(OrtArenaAllocator, OrtMemTypeDefault, &memory_info));
+  OrtValue* input_value = nullptr;
+  ORT_BREAK_ON_ERROR(g_ort->CreateTensorWithDataAsOrtValue(memory_info, X.data(), X.size() * sizeof(int64_t),
+                                                           X_shape.data(), X_shape.size(),
+                                                           ONNX_TENSOR_ELEMENT_DATA_TYPE_INT64, &input_value));
+
+  const char* input_names[] = {"X"};
+  const char* output_names[] = {"Y"};
+  for (auto _ : state) {
+    OrtValue* output_value = nullptr;
+    ORT_BREAK_ON_ERROR(g_ort->Run(session, nullptr, input_names, &input_value, 1, output_names, 1, &output_value));
+    g_ort->ReleaseValue(output_value);
+  }
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * N * kRowLength);
+
+  g_ort->ReleaseValue(input_value);
+  g_ort->ReleaseMemoryInfo(memory_info);
+  g_ort->ReleaseSession(session);
+  g_ort->ReleaseSessionOptions(session_options);
+}
+
+}  // namespace
+
+// Args: number of bi-grams in the pool, max_skip_count, number of rows of kRowLength tokens.
+static void BM_TfIdfVectorizerTF(benchmark::State& state) {
+  RunTfIdfVectorizer(state, "TF");
+}
+
+BENCHMARK(BM_TfIdfVectorizerTF)
+    ->UseRealTime()
+    ->Unit(benchmark::TimeUnit::kMicrosecond)
+    ->Args({100000, 0, 1})
+    ->Args({100000, 0, 16})
+    ->Args({100000, 0, 256})
+    ->Args({100000, 2, 16});
+
+static void BM_TfIdfVectorizerTFIDF(benchmark::State& state) {
+  RunTfIdfVectorizer(state, "TFIDF");
+}
+
+BENCHMARK(BM_TfIdfVectorizerTFIDF)
+    ->UseRealTime()
+    ->Unit(benchmark::TimeUnit::kMicrosecond)
+    ->Args({100000, 0, 16})
+    ->Args({100000, 2, 256});
@@ -0,0 +1,206 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include <benchmark/benchmark.h>
+#include <core/graph/onnx_protobuf.h>
+#include <core/session/onnxruntime_c_api.h>
+#include <core/session/ort_env.h>
+
+#include <random>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+extern OrtEnv* env;
+extern const OrtApi* g_ort;
+
+#define ORT_BREAK_ON_ERROR(expr)                                \
+  do {                                                          \
+    OrtStatus* onnx_status = (expr);                            \
+    if (onnx_status != NULL) {                                  \
+      state.SkipWithError(g_ort->GetErrorMessage(onnx_status)); \
+      g_ort->ReleaseStatus(onnx_status);                        \
+      return;                                                   \
+    }                                                           \
+  } while (0);
+
+namespace {
+
+constexpr int64_t kFeatureCount = 32;
+
+template <typename T>
+void AddAttribute(ONNX_NAMESPACE::NodeProto& node, const char* name, const std::vector<T>& values) {
+  auto* attr = node.add_attribute();
+  attr->set_name(name);
+  if constexpr (std::is_same<T, int64_t>::value) {
+    attr->set_type(ONNX_NAMESPACE::AttributeProto_AttributeType_INTS);
+    for (auto value : values) attr->add_ints(value);
+  } else if constexpr (std::is_same<T, float>::value) {
+    attr->set_type(ONNX_NAMESPACE::AttributeProto_AttributeType_FLOATS);
+    for (auto value : values) attr->add_floats(value);
+  } else {
+    attr->set_type(ONNX_NAMESPACE::AttributeProto_AttributeType_STRINGS);
+    for (const auto& value : values) attr->add_strings(value);
+  }
+}
+
+// Random gradient boosting style regressor: `n_trees` trees of depth `depth` splitting on kFeatureCount features.
+// The trees are perfect (every leaf at the same depth) unless `perfect` is false, in which case a branch stops
+// early with a probability of 1/4.
+std::string CreateTreeEnsembleRegressorModel(int64_t n_trees, int64_t depth, bool perfect) {
+  std::mt19937 gen(1);
+  std::uniform_int_distribution<int64_t> feature_dist(0, kFeatureCount - 1);
+  std::uniform_real_distribution<float> value_dist(-1.f, 1.f);
+
+  std::vector<int64_t> truenodeids, falsenodeids, treeids, nodeids, featureids;
+  std::vector<int64_t> target_treeids, target_nodeids, target_ids;
+  std::vector<float> values, target_weights;
+  std::vector<std::string> modes;
+
+  for (int64_t tree = 0; tree < n_trees; ++tree) {
+    // The nodes are created depth-first, a node becomes a leaf or gets its two children when it is popped.
+    int64_t next_id = 0;
+    auto add_node = [&](int64_t node_depth) {
+      treeids.push_back(tree);
+      nodeids.push_back(next_id++);
+      truenodeids.push_back(0);
+      falsenodeids.push_back(0);
+      featureids.push_back(feature_dist(gen));
+      values.push_back(value_dist(gen));
+      modes.push_back("BRANCH_LEQ");
+      return std::make_pair(static_cast<int64_t>(nodeids.size()) - 1, node_depth);
+    };
+    std::vector<std::pair<int64_t, int64_t>> stack{add_node(0)};  // (position in the attributes, depth)
+    while (!stack.empty()) {
+      auto [position, node_depth] = stack.back();
+      stack.pop_back();
+      const bool leaf = node_depth == depth || (!perfect && node_depth > 0 && gen() % 4 == 0);
+      if (leaf) {
+        modes[position] = "LEAF";
+        target_treeids.push_back(tree);
+        target_nodeids.push_back(nodeids[position]);
+        target_ids.push_back(0);
+        target_weights.push_back(value_dist(gen));
+        continue;
+      }
+      auto true_child = add_node(node_depth + 1);
+      auto false_child = add_node(node_depth + 1);
+      truenodeids[position] = nodeids[true_child.first];
+      falsenodeids[position] = nodeids[false_child.first];
+      stack.push_back(false_child);
+      stack.push_back(true_child);
+    }
+  }
+
+  ONNX_NAMESPACE::ModelProto model_proto;
+  model_proto.set_ir_version(ONNX_NAMESPACE::IR_VERSION);
+  auto* opset_import = model_proto.add_opset_import();
+  opset_import->set_domain("");
+  opset_import->set_version(13);
+  opset_import = model_proto.add_opset_import();
+  opset_import->set_domain("ai.onnx.ml");
+  opset_import->set_version(1);
+
+  auto* graph = model_proto.mutable_graph();
+  graph->set_name("TreeEnsembleRegressor");
+  auto* node = graph->add_node();
+  node->set_op_type("TreeEnsembleRegressor");
+  node->set_domain("ai.onnx.ml");
+  node->add_input("X");
+  node->add_output("Y");
+
+  AddAttribute(*node, "nodes_truenodeids", truenodeids);
+  AddAttribute(*node, "nodes_falsenodeids", falsenodeids);
+  AddAttribute(*node, "nodes_treeids", treeids);
+  AddAttribute(*node, "nodes_nodeids", nodeids);
+  AddAttribute(*node, "nodes_featureids", featureids);
+  AddAttribute(*node, "nodes_values", values);
+  AddAttribute(*node, "nodes_modes", modes);
+  AddAttribute(*node, "target_treeids", target_treeids);
+  AddAttribute(*node, "target_nodeids", target_nodeids);
+  AddAttribute(*node, "target_ids", target_ids);
+  AddAttribute(*node, "target_weights", target_weights);
+  auto* attr = node->add_attribute();
+  attr->set_name("n_targets");
+  attr->set_type(ONNX_NAMESPACE::AttributeProto_AttributeType_INT);
+  attr->set_i(1);
+
+  auto* input_info = graph->add_input();
+  input_info->set_name("X");
+  input_info->mutable_type()->mutable_tensor_type()->set_elem_type(ONNX_NAMESPACE::TensorProto_DataType_FLOAT);
+  auto* output_info = graph->add_output();
+  output_info->set_name("Y");
+  output_info->mutable_type()->mutable_tensor_type()->set_elem_type(ONNX_NAMESPACE::TensorProto_DataType_FLOAT);
+
+  return model_proto.SerializeAsString();
+}
+
+void RunTreeEnsembleRegressor(benchmark::State& state, bool perfect) {
+  const int64_t n_trees = state.range(0);
+  const int64_t depth = state.range(1);
+  const int64_t N = state.range(2);
+
+  const std::string model = CreateTreeEnsembleRegressorModel(n_trees, depth, perfect);
+  OrtSessionOptions* session_options;
+  ORT_BREAK_ON_ERROR(g_ort->CreateSessionOptions(&session_options));
+  OrtSession* session;
+  ORT_BREAK_ON_ERROR(g_ort->CreateSessionFromArray(env, model.data(), model.size(), session_options, &session));
+
+  std::mt19937 gen(2);
+  std::uniform_real_distribution<float> dist(-1.f, 1.f);
+  std::vector<float> X(static_cast<size_t>(N * kFeatureCount));
+  for (auto& value : X) {
+    value = dist(gen);
+  }
+  std::vector<int64_t> X_shape{N, kFeatureCount};
+  OrtMemoryInfo* memory_info;
+  ORT_BREAK_ON_ERROR(g_ort->CreateCpuMemoryInfo(OrtArenaAllocator, OrtMemTypeDefault, &memory_info));
+  OrtValue* input_value = nullptr;
+  ORT_BREAK_ON_ERROR(g_ort->CreateTensorWithDataAsOrtValue(memory_info, X.data(), X.size() * sizeof(float),
+                                                           X_shape.data(), X_shape.size(),
+                                                           ONNX_TENSOR_ELEMENT_DATA_TYPE_FLOAT, &input_value));
+
+  const char* input_names[] = {"X"};
+  const char* output_names[] = {"Y"};
+  for (auto _ : state) {
+    OrtValue* output_value = nullptr;
+    ORT_BREAK_ON_ERROR(g_ort->Run(session, nullptr, input_names, &input_value, 1, output_names, 1, &output_value));
+    g_ort->ReleaseValue(output_value);
+  }
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * N * n_trees);
+
+  g_ort->ReleaseValue(input_value);
+  g_ort->ReleaseMemoryInfo(memory_info);
+  g_ort->ReleaseSession(session);
+  g_ort->ReleaseSessionOptions(session_options);
+}
+
+}  // namespace
+
+// Args: number of trees, depth, number of rows.
+// The row counts span the serial and parallel sections of TreeEnsembleCommon::ComputeAgg.
+static void BM_TreeEnsembleRegressorPerfect(benchmark::State& state) {
+  RunTreeEnsembleRegressor(state, true);
+}
+
+BENCHMARK(BM_TreeEnsembleRegressorPerfect)
+    ->UseRealTime()
+    ->Unit(benchmark::TimeUnit::kMicrosecond)
+    ->Args({100, 8, 1})
+    ->Args({500, 6, 1})
+    ->Args({100, 8, 32})
+    ->Args({100, 8, 64})
+    ->Args({100, 8, 128})
+    ->Args({100, 8, 4096});
+
+static void BM_TreeEnsembleRegressorUnbalanced(benchmark::State& state) {
+  RunTreeEnsembleRegressor(state, false);
+}
+
+BENCHMARK(BM_TreeEnsembleRegressorUnbalanced)
+    ->UseRealTime()
+    ->Unit(benchmark::TimeUnit::kMicrosecond)
+    ->Args({100, 8, 1})
+    ->Args({100, 8, 64})
+    ->Args({100, 8, 4096});
@@ -277,8 +277,7 @@ TEST(CseTests, MergeConstants) {
                   .IsOK());
   Graph& graph = model->MainGraph();
   GraphTransformerManager graph_transformation_mgr(1);
-  // In current implementation, equal constants are not merged. So CSE must precede constant folding, otherwise we end up
-  // with multiple copies of the same constant.
+  // CSE precedes constant folding so that the duplicated Add nodes are merged before they are folded.
   std::unique_ptr<CPUExecutionProvider> e = std::make_unique<CPUExecutionProvider>(CPUExecutionProviderInfo());
   ASSERT_TRUE(
       graph_transformation_mgr.Register(std::make_unique<CommonSubexpressionElimination>(), TransformerLevel::Level1).IsOK());
@@ -293,5 +292,126 @@ TEST(CseTests, MergeConstants) {
   ASSERT_EQ(op_count["Add"], 2);
 }
 
+TEST(CseTests, MergeIdenticalInitializers) {
+  const auto& logger = DefaultLoggingManager().DefaultLogger();
+  Model model("MergeIdenticalInitializers", false, ModelMetaData(), PathString(), IOnnxRuntimeOpSchemaRegistryList(),
+              {{kOnnxDomain, 12}}, {}, logger);
+  auto& graph = model.MainGraph();
+
+  auto add_initializer = [&graph](const std::string& name, const std::vector<int64_t>& dims) {
+    ONNX_NAMESPACE::TensorProto tensor;
+    tensor.set_name(name);
+    tensor.set_data_type(ONNX_NAMESPACE::TensorProto_DataType_FLOAT);
+    for (auto dim : dims) {
+      tensor.add_dims(dim);
+    }
+    for (int i = 0; i < 4; ++i) {
+      tensor.add_float_data(static_cast<float>(i));
+    }
+    graph.AddInitializedTensor(tensor);
+  };
+
+  // w1 and w2 are identical, w3 has the same data but a different shape
+  add_initializer("w1", {2, 2});
+  add_initializer("w2", {2, 2});
+  add_initializer("w3", {4});
+
+  ONNX_NAMESPACE::TypeProto float_type;
+  float_type.mutable_tensor_type()->set_elem_type(ONNX_NAMESPACE::TensorProto_DataType_FLOAT);
+  auto& x = graph.GetOrCreateNodeArg("x", &float_type);
+  auto& w1 = graph.GetOrCreateNodeArg("w1", &float_type);
+  auto& w2 = graph.GetOrCreateNodeArg("w2", &float_type);
+  auto& w3 = graph.GetOrCreateNodeArg("w3", &float_type);
+  auto& add1 = graph.GetOrCreateNodeArg("add1", &float_type);
+  auto& add2 = graph.GetOrCreateNodeArg("add2", &float_type);
+  auto& add3 = graph.GetOrCreateNodeArg("add3", &float_type);
+  auto& result = graph.GetOrCreateNodeArg("Result", &float_type);
+  graph.AddNode("add_1", "Add", "", {&x, &w1}, {&add1});
+  graph.AddNode("add_2", "Add", "", {&x, &w2}, {&add2});
+  graph.AddNode("add_3", "Add", "", {&x, &w3}, {&add3});
+  graph.AddNode("sum", "Sum", "", {&add1, &add2, &add3}, {&result});
+  ASSERT_TRUE(graph.Resolve().IsOK());
+
+  ApplyCse(model);
+
+  ASSERT_EQ(graph.GetAllInitializedTensors().size(), 2U);
+  ASSERT_TRUE(graph.IsInitializedTensor("w1"));
+  ASSERT_TRUE(graph.IsInitializedTensor("w3"));
+
+  auto op_count = CountOpsInGraph(graph);
+  ASSERT_EQ(op_count["Add"], 2);
+}
+
+// A value recomputed inside a subgraph is replaced by the value of the enclosing graph.
+TEST(CseTests, SubgraphUsesOuterScopeValue) {
+  const auto& logger = DefaultLoggingManager().DefaultLogger();
+
+  ONNX_NAMESPACE::TypeProto float_type;
+  float_type.mutable_tensor_type()->set_elem_type(ONNX_NAMESPACE::TensorProto_DataType_FLOAT);
+  ONNX_NAMESPACE::TypeProto bool_type;
+  bool_type.mutable_tensor_type()->set_elem_type(ONNX_NAMESPACE::TensorProto_DataType_BOOL);
+  bool_type.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(1);
+
+  // then: Neg(Relu(x)), else: Neg(relu_out)
+  auto create_subgraph = [&](bool recompute, ONNX_NAMESPACE::GraphProto& graph_proto) {
+    Model model("SubgraphUsesOuterScopeValue_subgraph", false, ModelMetaData(), PathString(),
+                IOnnxRuntimeOpSchemaRegistryList(), {{kOnnxDomain, 12}}, {}, logger);
+    auto& graph = model.MainGraph();
+    auto& neg_in = graph.GetOrCreateNodeArg(recompute ? "relu_in_subgraph" : "relu_out", &float_type);
+    if (recompute) {
+      auto& x = graph.GetOrCreateNodeArg("x", &float_type);
+      graph.AddOuterScopeNodeArg("x");
+      graph.AddNode("subgraph_relu", "Relu", "", {&x}, {&neg_in});
+    } else {
+      graph.AddOuterScopeNodeArg("relu_out");
+    }
+
+    auto& out = graph.GetOrCreateNodeArg(recompute ? "then_out" : "else_out", &float_type);
+    graph.AddNode("subgraph_neg", "Neg", "", {&neg_in}, {&out});
+    ASSERT_TRUE(graph.Resolve().IsOK());
+    graph_proto = graph.ToGraphProto();
+  };
+
+  Model model("SubgraphUsesOuterScopeValue", false, ModelMetaData(), PathString(), IOnnxRuntimeOpSchemaRegistryList(),
+              {{kOnnxDomain, 12}}, {}, logger);
+  auto& graph = model.MainGraph();
+  auto& x = graph.GetOrCreateNodeArg("x", &float_type);
+  auto& cond = graph.GetOrCreateNodeArg("cond", &bool_type);
+  auto& relu_out = graph.GetOrCreateNodeArg("relu_out", &float_type);
+  auto& if_out = graph.GetOrCreateNodeArg("if_out", &float_type);
+  auto& result = graph.GetOrCreateNodeArg("Result", &float_type);
+  graph.AddNode("relu", "Relu", "", {&x}, {&relu_out});
+  auto& if_node = graph.AddNode("if", "If", "", {&cond}, {&if_out});
+  graph.AddNode("add", "Add", "", {&relu_out, &if_out}, {&result});
+
+  ONNX_NAMESPACE::GraphProto then_branch;
+  ONNX_NAMESPACE::GraphProto else_branch;
+  create_subgraph(true, then_branch);
+  create_subgraph(false, else_branch);
+  if_node.AddAttribute("then_branch", then_branch);
+  if_node.AddAttribute("else_branch", else_branch);
+  ASSERT_TRUE(graph.Resolve().IsOK());
+
+  ApplyCse(model);
+
+  auto op_count = CountOpsInGraph(graph, false);
+  ASSERT_EQ(op_count["Relu"], 1);
+
+  const Graph* then_graph = nullptr;
+  for (const auto& node : graph.Nodes()) {
+    if (node.OpType() == "If") {
+      then_graph = node.GetGraphAttribute("then_branch");
+    }
+  }
+
+  ASSERT_NE(then_graph, nullptr);
+  if (then_graph) {
+    ASSERT_EQ(CountOpsInGraph(*then_graph)["Relu"], 0);
+    for (const auto& node : then_graph->Nodes()) {
+      ASSERT_EQ(node.InputDefs()[0]->Name(), "relu_out");
+    }
+  }
+}
+
 }  // namespace test
 }  // namespace onnxruntime
@@ -0,0 +1,143 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "graph_transform_test_builder.h"
+
+#include "core/graph/graph.h"
+
+namespace onnxruntime {
+namespace test {
+
+#ifndef DISABLE_CONTRIB_OPS
+
+TEST(ElementwiseFusionTests, AddMulSigmoidMul) {
+  auto build_test_case = [&](ModelTestBuilder& builder) {
+    auto* input_arg = builder.MakeInput<float>({2, 3, 64}, -1.f, 1.f);
+    auto* bias_arg = builder.MakeInitializer<float>({64}, -1.f, 1.f);
+    auto* scale_arg = builder.MakeScalarInitializer<float>(1.702f);
+    auto* add_out = builder.MakeIntermediate();
+    auto* mul_out = builder.MakeIntermediate();
+    auto* sigmoid_out = builder.MakeIntermediate();
+    auto* output_arg = builder.MakeOutput();
+
+    builder.AddNode("Add", {input_arg, bias_arg}, {add_out});
+    builder.AddNode("Mul", {add_out, scale_arg}, {mul_out});
+    builder.AddNode("Sigmoid", {mul_out}, {sigmoid_out});
+    builder.AddNode("Mul", {mul_out, sigmoid_out}, {output_arg});
+  };
+
+  auto check_graph = [&](InferenceSessionWrapper& session) {
+    auto op_to_count = CountOpsInGraph(session.GetGraph());
+    EXPECT_EQ(op_to_count["com.microsoft.FusedElementwise"], 1);
+    EXPECT_EQ(op_to_count["Add"], 0);
+    EXPECT_EQ(op_to_count["Mul"], 0);
+    EXPECT_EQ(op_to_count["Sigmoid"], 0);
+  };
+
+  TransformerTester(build_test_case,
+                    check_graph,
+                    TransformerLevel::Level1,
+                    TransformerLevel::Level2,
+                    13, 1e-5, 1e-5);
+}
+
+// An intermediate result that is consumed outside of the chain must not be fused away.
+TEST(ElementwiseFusionTests, IntermediateWithExternalConsumer) {
+  auto build_test_case = [&](ModelTestBuilder& builder) {
+    auto* input_arg = builder.MakeInput<float>({4, 300}, -1.f, 1.f);
+    auto* bias_arg = builder.MakeInitializer<float>({300}, -1.f, 1.f);
+    auto* add_out = builder.MakeIntermediate();
+    auto* relu_out = builder.MakeIntermediate();
+    auto* output_arg = builder.MakeOutput();
+    auto* mean_arg = builder.MakeOutput();
+
+    builder.AddNode("Add", {input_arg, bias_arg}, {add_out});
+    builder.AddNode("ReduceMean", {add_out}, {mean_arg});
+    builder.AddNode("Relu", {add_out}, {relu_out});
+    builder.AddNode("Neg", {relu_out}, {output_arg});
+  };
+
+  auto check_graph = [&](InferenceSessionWrapper& session) {
+    auto op_to_count = CountOpsInGraph(session.GetGraph());
+    EXPECT_EQ(op_to_count["com.microsoft.FusedElementwise"], 1);
+    EXPECT_EQ(op_to_count["Add"], 1);
+    EXPECT_EQ(op_to_count["ReduceMean"], 1);
+    EXPECT_EQ(op_to_count["Relu"], 0);
+    EXPECT_EQ(op_to_count["Neg"], 0);
+  };
+
+  TransformerTester(build_test_case,
+                    check_graph,
+                    TransformerLevel::Level1,
+                    TransformerLevel::Level2,
+                    13);
+}
+
+TEST(ElementwiseFusionTests, MulPowSub) {
+  auto build_test_case = [&](ModelTestBuilder& builder) {
+    auto* input_arg = builder.MakeInput<float>({2, 3, 64}, 0.1f, 2.f);
+    auto* scale_arg = builder.MakeInitializer<float>({64}, 0.5f, 1.5f);
+    auto* exponent_arg = builder.MakeScalarInitializer<float>(1.5f);
+    auto* mul_out = builder.MakeIntermediate();
+    auto* pow_out = builder.MakeIntermediate();
+    auto* output_arg = builder.MakeOutput();
+
+    builder.AddNode("Mul", {input_arg, scale_arg}, {mul_out});
+    builder.AddNode("Pow", {mul_out, exponent_arg}, {pow_out});
+    builder.AddNode("Sub", {pow_out, input_arg}, {output_arg});
+  };
+
+  auto check_graph = [&](InferenceSessionWrapper& session) {
+    auto op_to_count = CountOpsInGraph(session.GetGraph());
+    EXPECT_EQ(op_to_count["com.microsoft.FusedElementwise"], 1);
+    EXPECT_EQ(op_to_count["Mul"], 0);
+    EXPECT_EQ(op_to_count["Pow"], 0);
+    EXPECT_EQ(op_to_count["Sub"], 0);
+  };
+
+  TransformerTester(build_test_case,
+                    check_graph,
+                    TransformerLevel::Level1,
+                    TransformerLevel::Level2,
+                    13, 1e-5, 1e-5);
+}
+
+// Conv+Add+Relu is left to the NCHWc transformer, which folds the Add and the Relu into the Conv.
+TEST(ElementwiseFusionTests, ConvAddReluIsNotFused) {
+  auto build_test_case = [&](ModelTestBuilder& builder) {
+    auto* input_arg = builder.MakeInput<float>({1, 8, 10, 10}, -1.f, 1.f);
+    auto* residual_arg = builder.MakeInput<float>({1, 8, 8, 8}, -1.f, 1.f);
+    auto* weights_arg = builder.MakeInitializer<float>({8, 8, 3, 3}, -1.f, 1.f);
+    auto* conv_out = builder.MakeIntermediate();
+    auto* add_out = builder.MakeIntermediate();
+    auto* relu_out = builder.MakeIntermediate();
+    auto* output_arg = builder.MakeOutput();
+
+    builder.AddConvNode(input_arg, weights_arg, conv_out);
+    builder.AddNode("Add", {conv_out, residual_arg}, {add_out});
+    builder.AddNode("Relu", {add_out}, {relu_out});
+    builder.AddNode("Neg", {relu_out}, {output_arg});
+  };
+
+  auto check_graph = [&](InferenceSessionWrapper& session) {
+    auto op_to_count = CountOpsInGraph(session.GetGraph());
+    EXPECT_EQ(op_to_count["com.microsoft.FusedElementwise"], 0);
+    EXPECT_EQ(op_to_count["Add"], 1);
+    EXPECT_EQ(op_to_count["Relu"], 1);
+    EXPECT_EQ(op_to_count["Neg"], 1);
+  };
+
+  TransformerTester(build_test_case,
+                    check_graph,
+                    TransformerLevel::Level1,
+                    TransformerLevel::Level2,
+                    13);
+}
+
+#endif  // DISABLE_CONTRIB_OPS
+
+}  // namespace test
+}  // namespace onnxruntime
@@ -5,6 +5,7 @@
 #pragma warning(disable : 4244)
 #endif
 
+#include <fstream>
 #include <random>
 #include "core/graph/onnx_protobuf.h"
 
@@ -61,6 +62,7 @@
 #include "core/optimizer/propagate_cast_ops.h"
 #include "core/optimizer/utils.h"
 #include "core/platform/env.h"
+#include "core/platform/path_lib.h"
 #include "core/session/inference_session.h"
 #include "core/session/onnxruntime_session_options_config_keys.h"
 #include "core/util/math.h"
@@ -249,6 +251,37 @@ TEST_F(GraphTransformationTests, ConstantFolding) {
   ASSERT_TRUE(op_to_count["Unsqueeze"] == 0);
 }
 
+TEST_F(GraphTransformationTests, GraphTransformerStatistics) {
+  auto model_uri = MODEL_FOLDER "fusion/fuse-conv-bn-mul-add-unsqueeze.onnx";
+  std::shared_ptr<Model> model;
+  ASSERT_STATUS_OK(Model::Load(model_uri, model, nullptr, *logger_));
+  Graph& graph = model->MainGraph();
+  std::unique_ptr<CPUExecutionProvider> e =
+      std::make_unique<CPUExecutionProvider>(CPUExecutionProviderInfo());
+  onnxruntime::GraphTransformerManager graph_transformation_mgr{5};
+  graph_transformation_mgr.EnableStatistics();
+  ASSERT_STATUS_OK(graph_transformation_mgr.Register(
+      std::make_unique<ConstantFolding>(*e.get(), false /*skip_dequantize_linear*/), TransformerLevel::Level1));
+
+  ASSERT_STATUS_OK(graph_transformation_mgr.ApplyTransformers(graph, TransformerLevel::Level1, *logger_));
+
+  const auto& statistics = graph_transformation_mgr.GetStatistics();
+  ASSERT_EQ(statistics.size(), 1u);
+  const auto& stats = statistics[0];
+  EXPECT_EQ(stats.name, "ConstantFolding");
+  EXPECT_EQ(stats.level, TransformerLevel::Level1);
+  // the second step finds nothing left to fold and stops the loop
+  EXPECT_EQ(stats.invocations, 2u);
+  EXPECT_EQ(stats.modifications, 1u);
+  EXPECT_EQ(stats.nodes_added, 0u);
+  EXPECT_EQ(stats.nodes_removed, 2u);
+  EXPECT_GT(stats.initializer_bytes_delta, 0);
+
+  const std::string report = graph_transformation_mgr.GetStatisticsReport();
+  EXPECT_NE(report.find("\"name\": \"ConstantFolding\""), std::string::npos);
+  EXPECT_NE(report.find("\"nodes_removed\": 2"), std::string::npos);
+}
+
 TEST_F(GraphTransformationTests, ConstantFoldingNodesOnDifferentEP) {
   auto model_uri = MODEL_FOLDER "fusion/fuse-conv-bn-mul-add-unsqueeze.onnx";
   std::shared_ptr<Model> model;
@@ -406,6 +439,152 @@ TEST_F(GraphTransformationTests, ConstantFoldingWithScalarShapeToInitializer) {
   ASSERT_TRUE(op_to_count["Add"] == 1);
 }
 
+// Build a graph with Expand(data, shape) + x where data and shape are initializers, so Expand can be constant folded.
+static void BuildExpandAddGraph(Graph& graph, int64_t rows) {
+  TensorProto data_tensor;
+  data_tensor.set_name("data");
+  data_tensor.set_data_type(TensorProto_DataType_FLOAT);
+  data_tensor.add_dims(4);
+  for (int i = 0; i < 4; ++i) {
+    data_tensor.add_float_data(static_cast<float>(i));
+  }
+  graph.AddInitializedTensor(data_tensor);
+
+  TensorProto shape_tensor;
+  shape_tensor.set_name("shape");
+  shape_tensor.set_data_type(TensorProto_DataType_INT64);
+  shape_tensor.add_dims(2);
+  shape_tensor.add_int64_data(rows);
+  shape_tensor.add_int64_data(4);
+  graph.AddInitializedTensor(shape_tensor);
+
+  TypeProto float_type;
+  float_type.mutable_tensor_type()->set_elem_type(TensorProto_DataType_FLOAT);
+  TypeProto int64_type;
+  int64_type.mutable_tensor_type()->set_elem_type(TensorProto_DataType_INT64);
+
+  auto& data_arg = graph.GetOrCreateNodeArg("data", &float_type);
+  auto& shape_arg = graph.GetOrCreateNodeArg("shape", &int64_type);
+  auto& input_arg = graph.GetOrCreateNodeArg("x", &float_type);
+  auto& expand_out = graph.GetOrCreateNodeArg("expand_out", &float_type);
+  auto& output_arg = graph.GetOrCreateNodeArg("y", &float_type);
+
+  graph.AddNode("expand", "Expand", "Expand data to shape.", {&data_arg, &shape_arg}, {&expand_out});
+  graph.AddNode("add", "Add", "Add graph input.", {&expand_out, &input_arg}, {&output_arg});
+}
+
+TEST_F(GraphTransformationTests, ConstantFoldingExpansionSizeLimit) {
+  std::unique_ptr<CPUExecutionProvider> e =
+      std::make_unique<CPUExecutionProvider>(CPUExecutionProviderInfo());
+
+  // output of Expand is 1024 * 4 floats = 16KB
+  auto fold = [&](const ConstantFoldingOptions& options) {
+    Model model("ConstantFoldingExpansionSizeLimit", false, ModelMetaData(), PathString(),
+                IOnnxRuntimeOpSchemaRegistryList(), {{kOnnxDomain, 12}}, {}, *logger_);
+    auto& graph = model.MainGraph();
+    BuildExpandAddGraph(graph, 1024);
+    EXPECT_STATUS_OK(graph.Resolve());
+
+    onnxruntime::GraphTransformerManager graph_transformation_mgr{5};
+    EXPECT_STATUS_OK(graph_transformation_mgr.Register(
+        std::make_unique<ConstantFolding>(*e.get(), false /*skip_dequantize_linear*/,
+                                          std::unordered_set<std::string>{}, std::unordered_set<std::string>{},
+                                          options),
+        TransformerLevel::Level1));
+    EXPECT_STATUS_OK(graph_transformation_mgr.ApplyTransformers(graph, TransformerLevel::Level1, *logger_));
+    return CountOpsInGraph(graph)["Expand"];
+  };
+
+  // within the default limit
+  EXPECT_EQ(fold(ConstantFoldingOptions{}), 0);
+
+  ConstantFoldingOptions options;
+  options.max_expansion_size_in_bytes = 8 * 1024;
+  EXPECT_EQ(fold(options), 1);
+
+  // the generic output limit applies to Expand too
+  options.max_expansion_size_in_bytes = 0;
+  options.max_output_size_in_bytes = 8 * 1024;
+  EXPECT_EQ(fold(options), 1);
+
+  options.max_output_size_in_bytes = 0;
+  EXPECT_EQ(fold(options), 0);
+}
+
+TEST_F(GraphTransformationTests, ConstantFoldingCache) {
+  TemporaryDirectory temp_dir{ORT_TSTR("constant_folding_cache_test_dir")};
+  ConstantFoldingOptions options;
+  options.cache_dir = ToMBString(temp_dir.Path()) + "/cache";
+
+  std::unique_ptr<CPUExecutionProvider> e =
+      std::make_unique<CPUExecutionProvider>(CPUExecutionProviderInfo());
+
+  auto fold = [&](std::vector<float>& folded_values) {
+    Model model("ConstantFoldingCache", false, ModelMetaData(), PathString(),
+                IOnnxRuntimeOpSchemaRegistryList(), {{kOnnxDomain, 12}}, {}, *logger_);
+    auto& graph = model.MainGraph();
+    BuildExpandAddGraph(graph, 2);
+    ASSERT_STATUS_OK(graph.Resolve());
+
+    onnxruntime::GraphTransformerManager graph_transformation_mgr{5};
+    ASSERT_STATUS_OK(graph_transformation_mgr.Register(
+        std::make_unique<ConstantFolding>(*e.get(), false /*skip_dequantize_linear*/,
+                                          std::unordered_set<std::string>{}, std::unordered_set<std::string>{},
+                                          options),
+        TransformerLevel::Level1));
+    ASSERT_STATUS_OK(graph_transformation_mgr.ApplyTransformers(graph, TransformerLevel::Level1, *logger_));
+    ASSERT_EQ(CountOpsInGraph(graph)["Expand"], 0);
+
+    const auto* folded = graph_utils::GetConstantInitializer(graph, "expand_out");
+    ASSERT_NE(folded, nullptr);
+    Initializer initializer{*folded, graph.ModelPath()};
+    folded_values.assign(initializer.data<float>(), initializer.data<float>() + initializer.size());
+  };
+
+  std::vector<float> folded_values;
+  fold(folded_values);
+  ASSERT_EQ(folded_values, std::vector<float>({0.f, 1.f, 2.f, 3.f, 0.f, 1.f, 2.f, 3.f}));
+
+  std::vector<std::string> cache_files;
+  LoopDir(ToPathString(options.cache_dir), [&](const ORTCHAR_T* filename, OrtFileType f_type) -> bool {
+    const std::string name = ToMBString(PathString(filename));
+    if (f_type == OrtFileType::TYPE_REG && name.size() > 3 && name.compare(name.size() - 3, 3, ".pb") == 0) {
+      cache_files.push_back(options.cache_dir + "/" + name);
+    }
+    return true;
+  });
+  ASSERT_EQ(cache_files.size(), 1u);
+
+  // modify the cached entry to check that the next session uses it instead of running the node
+  GraphProto cached;
+  {
+    std::ifstream in(cache_files[0], std::ios::in | std::ios::binary);
+    ASSERT_TRUE(cached.ParseFromIstream(&in));
+  }
+  ASSERT_EQ(cached.initializer_size(), 1);
+  std::vector<float> modified_values(8, 42.f);
+  cached.mutable_initializer(0)->set_raw_data(modified_values.data(), modified_values.size() * sizeof(float));
+  cached.mutable_initializer(0)->clear_float_data();
+  {
+    std::ofstream out(cache_files[0], std::ios::out | std::ios::binary | std::ios::trunc);
+    ASSERT_TRUE(cached.SerializeToOstream(&out));
+  }
+
+  fold(folded_values);
+  ASSERT_EQ(folded_values, modified_values);
+
+  // an entry describing another computation, e.g. after a hash collision, is ignored
+  ASSERT_FALSE(cached.doc_string().empty());
+  cached.set_doc_string("ai.onnx:Expand:8 inputs: 32 32 key: " + std::string(32, '0'));
+  {
+    std::ofstream out(cache_files[0], std::ios::out | std::ios::binary | std::ios::trunc);
+    ASSERT_TRUE(cached.SerializeToOstream(&out));
+  }
+
+  fold(folded_values);
+  ASSERT_EQ(folded_values, std::vector<float>({0.f, 1.f, 2.f, 3.f, 0.f, 1.f, 2.f, 3.f}));
+}
+
 static void VerifyConstantFoldingWithDequantizeLinear(int quantize_linear_count,
                                                       int dequantize_linear_count,
                                                       int conv_count,
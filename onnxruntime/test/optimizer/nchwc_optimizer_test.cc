@@ -1118,6 +1118,52 @@ TEST(NchwcOptimizerTests, BatchNormalization) {
 #endif
 }
 
+TEST(NchwcOptimizerTests, InstanceNormalization) {
+  auto test_case = [&](int64_t channels) {
+    auto build_test_case = [&](NchwcTestHelper& helper) {
+      auto* input_arg = helper.MakeInput<float>({1, 16, 25, 21});
+      auto* conv_output_arg = helper.MakeIntermediate();
+      auto* norm_output_arg = helper.MakeIntermediate();
+      auto* output_arg = helper.MakeOutput();
+
+      helper.AddConvNode(input_arg, conv_output_arg, {channels, 16, 3, 3});
+
+      std::vector<float> scale(static_cast<size_t>(channels));
+      std::vector<float> bias(static_cast<size_t>(channels));
+      for (int64_t i = 0; i < channels; i++) {
+        scale[i] = static_cast<float>((i % 5) + 1) * 0.25f;
+        bias[i] = static_cast<float>(i % 7) * 0.125f - 0.5f;
+      }
+
+      helper.AddNode("InstanceNormalization", {conv_output_arg, helper.Make1DInitializer(scale),
+                                               helper.Make1DInitializer(bias)},
+                     {norm_output_arg});
+      helper.AddNode("Relu", {norm_output_arg}, {output_arg});
+
+      // The NCHWc kernel accumulates the statistics in a different order.
+      helper.per_sample_tolerance_ = .00025;
+    };
+
+    auto check_nchwc_graph = [&](InferenceSessionWrapper& session) {
+      auto op_to_count = CountOpsInGraph(session.GetGraph());
+      const bool aligned = (channels % static_cast<int64_t>(MlasNchwcGetBlockSize())) == 0;
+      EXPECT_EQ(op_to_count["com.microsoft.nchwc.Conv"], 1);
+      EXPECT_EQ(op_to_count["com.microsoft.nchwc.GroupNorm"], aligned ? 1 : 0);
+      EXPECT_EQ(op_to_count["com.microsoft.GroupNorm"], aligned ? 0 : 1);
+      EXPECT_EQ(op_to_count["InstanceNormalization"], 0);
+      EXPECT_EQ(op_to_count["Relu"], 0);
+    };
+
+    NchwcOptimizerTester(build_test_case, check_nchwc_graph);
+  };
+
+  // Verify that an instance normalization node and its activation are
+  // converted to the NCHWc group normalization if the input tensor is already
+  // in NCHWc format and the channel count is aligned to the block size.
+  test_case(64);
+  test_case(34);
+}
+
 TEST(NchwcOptimizerTests, ConvReorderInputNhwc) {
   auto test_case = [&](int64_t channels) {
     auto build_test_case = [&](NchwcTestHelper& helper) {
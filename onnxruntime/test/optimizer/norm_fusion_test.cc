@@ -0,0 +1,156 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "graph_transform_test_builder.h"
+
+#include "core/graph/graph.h"
+
+namespace onnxruntime {
+namespace test {
+
+#ifndef DISABLE_CONTRIB_OPS
+
+// Group normalization as exported by frameworks without a GroupNorm operator, followed by an activation.
+TEST(NormFusionTests, GroupNormSubgraphRelu) {
+  auto build_test_case = [&](ModelTestBuilder& builder) {
+    auto* input_arg = builder.MakeInput<float>({2, 8, 5, 5}, -1.f, 1.f);
+    auto* group_shape_arg = builder.Make1DInitializer<int64_t>({0, 4, -1});
+    auto* ones_arg = builder.Make1DInitializer<float>({1.f, 1.f, 1.f, 1.f});
+    auto* zeros_arg = builder.Make1DInitializer<float>({0.f, 0.f, 0.f, 0.f});
+    auto* gamma_arg = builder.MakeInitializer<float>({8, 1, 1}, 0.5f, 1.5f);
+    auto* beta_arg = builder.MakeInitializer<float>({8, 1, 1}, -0.5f, 0.5f);
+    auto* reshape1_out = builder.MakeIntermediate();
+    auto* norm_out = builder.MakeIntermediate();
+    auto* shape_out = builder.MakeIntermediate();
+    auto* reshape2_out = builder.MakeIntermediate();
+    auto* mul_out = builder.MakeIntermediate();
+    auto* add_out = builder.MakeIntermediate();
+    auto* output_arg = builder.MakeOutput();
+
+    builder.AddNode("Reshape", {input_arg, group_shape_arg}, {reshape1_out});
+    builder.AddNode("InstanceNormalization", {reshape1_out, ones_arg, zeros_arg}, {norm_out});
+    builder.AddNode("Shape", {input_arg}, {shape_out});
+    builder.AddNode("Reshape", {norm_out, shape_out}, {reshape2_out});
+    builder.AddNode("Mul", {reshape2_out, gamma_arg}, {mul_out});
+    builder.AddNode("Add", {mul_out, beta_arg}, {add_out});
+    builder.AddNode("Relu", {add_out}, {output_arg});
+  };
+
+  auto check_graph = [&](InferenceSessionWrapper& session) {
+    auto op_to_count = CountOpsInGraph(session.GetGraph());
+    EXPECT_EQ(op_to_count["com.microsoft.GroupNorm"], 1);
+    EXPECT_EQ(op_to_count["InstanceNormalization"], 0);
+    EXPECT_EQ(op_to_count["Reshape"], 0);
+    EXPECT_EQ(op_to_count["Shape"], 0);
+    EXPECT_EQ(op_to_count["Mul"], 0);
+    EXPECT_EQ(op_to_count["Add"], 0);
+    EXPECT_EQ(op_to_count["Relu"], 0);
+  };
+
+  TransformerTester(build_test_case,
+                    check_graph,
+                    TransformerLevel::Level1,
+                    TransformerLevel::Level2,
+                    13, 1e-5, 1e-5);
+}
+
+// The subgraph is not fused if the InstanceNormalization applies its own scale.
+TEST(NormFusionTests, GroupNormSubgraphWithScale) {
+  auto build_test_case = [&](ModelTestBuilder& builder) {
+    auto* input_arg = builder.MakeInput<float>({2, 8, 5, 5}, -1.f, 1.f);
+    auto* group_shape_arg = builder.Make1DInitializer<int64_t>({0, 4, -1});
+    auto* scale_arg = builder.Make1DInitializer<float>({1.f, 2.f, 1.f, 1.f});
+    auto* zeros_arg = builder.Make1DInitializer<float>({0.f, 0.f, 0.f, 0.f});
+    auto* output_shape_arg = builder.Make1DInitializer<int64_t>({2, 8, 5, 5});
+    auto* gamma_arg = builder.MakeInitializer<float>({1, 8, 1, 1}, 0.5f, 1.5f);
+    auto* beta_arg = builder.MakeInitializer<float>({1, 8, 1, 1}, -0.5f, 0.5f);
+    auto* reshape1_out = builder.MakeIntermediate();
+    auto* norm_out = builder.MakeIntermediate();
+    auto* reshape2_out = builder.MakeIntermediate();
+    auto* mul_out = builder.MakeIntermediate();
+    auto* output_arg = builder.MakeOutput();
+
+    builder.AddNode("Reshape", {input_arg, group_shape_arg}, {reshape1_out});
+    builder.AddNode("InstanceNormalization", {reshape1_out, scale_arg, zeros_arg}, {norm_out});
+    builder.AddNode("Reshape", {norm_out, output_shape_arg}, {reshape2_out});
+    builder.AddNode("Mul", {reshape2_out, gamma_arg}, {mul_out});
+    builder.AddNode("Add", {mul_out, beta_arg}, {output_arg});
+  };
+
+  auto check_graph = [&](InferenceSessionWrapper& session) {
+    auto op_to_count = CountOpsInGraph(session.GetGraph());
+    EXPECT_EQ(op_to_count["com.microsoft.GroupNorm"], 0);
+    EXPECT_EQ(op_to_count["InstanceNormalization"], 1);
+    EXPECT_EQ(op_to_count["Reshape"], 2);
+  };
+
+  TransformerTester(build_test_case,
+                    check_graph,
+                    TransformerLevel::Level1,
+                    TransformerLevel::Level2,
+                    13, 1e-5, 1e-5);
+}
+
+TEST(NormFusionTests, BatchNormalizationClip) {
+  auto build_test_case = [&](ModelTestBuilder& builder) {
+    auto* input_arg = builder.MakeInput<float>({2, 16, 7, 7}, -2.f, 2.f);
+    auto* scale_arg = builder.MakeInitializer<float>({16}, 0.5f, 1.5f);
+    auto* bias_arg = builder.MakeInitializer<float>({16}, -0.5f, 0.5f);
+    auto* mean_arg = builder.MakeInitializer<float>({16}, -0.5f, 0.5f);
+    auto* var_arg = builder.MakeInitializer<float>({16}, 0.5f, 1.5f);
+    auto* min_arg = builder.MakeScalarInitializer<float>(0.f);
+    auto* max_arg = builder.MakeScalarInitializer<float>(6.f);
+    auto* bn_out = builder.MakeIntermediate();
+    auto* output_arg = builder.MakeOutput();
+
+    builder.AddNode("BatchNormalization", {input_arg, scale_arg, bias_arg, mean_arg, var_arg}, {bn_out});
+    builder.AddNode("Clip", {bn_out, min_arg, max_arg}, {output_arg});
+  };
+
+  auto check_graph = [&](InferenceSessionWrapper& session) {
+    auto op_to_count = CountOpsInGraph(session.GetGraph());
+    EXPECT_EQ(op_to_count["com.microsoft.FusedBatchNormalization"], 1);
+    EXPECT_EQ(op_to_count["BatchNormalization"], 0);
+    EXPECT_EQ(op_to_count["Clip"], 0);
+  };
+
+  TransformerTester(build_test_case,
+                    check_graph,
+                    TransformerLevel::Level1,
+                    TransformerLevel::Level2,
+                    13, 1e-5, 1e-5);
+}
+
+TEST(NormFusionTests, InstanceNormalizationRelu) {
+  auto build_test_case = [&](ModelTestBuilder& builder) {
+    auto* input_arg = builder.MakeInput<float>({2, 6, 9}, -2.f, 2.f);
+    auto* scale_arg = builder.MakeInitializer<float>({6}, 0.5f, 1.5f);
+    auto* bias_arg = builder.MakeInitializer<float>({6}, -0.5f, 0.5f);
+    auto* norm_out = builder.MakeIntermediate();
+    auto* output_arg = builder.MakeOutput();
+
+    builder.AddNode("InstanceNormalization", {input_arg, scale_arg, bias_arg}, {norm_out});
+    builder.AddNode("Relu", {norm_out}, {output_arg});
+  };
+
+  auto check_graph = [&](InferenceSessionWrapper& session) {
+    auto op_to_count = CountOpsInGraph(session.GetGraph());
+    EXPECT_EQ(op_to_count["com.microsoft.GroupNorm"], 1);
+    EXPECT_EQ(op_to_count["InstanceNormalization"], 0);
+    EXPECT_EQ(op_to_count["Relu"], 0);
+  };
+
+  TransformerTester(build_test_case,
+                    check_graph,
+                    TransformerLevel::Level1,
+                    TransformerLevel::Level2,
+                    13, 1e-5, 1e-5);
+}
+
+#endif  // DISABLE_CONTRIB_OPS
+
+}  // namespace test
+}  // namespace onnxruntime
@@ -0,0 +1,120 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "test/framework/test_utils.h"
+#include "test/test_environment.h"
+#include "core/graph/graph_utils.h"
+#include "core/graph/model.h"
+#include "core/optimizer/graph_transformer_mgr.h"
+#include "core/optimizer/scaler_linear_fusion.h"
+
+#include "gtest/gtest.h"
+
+#include <string>
+#include <vector>
+
+namespace onnxruntime {
+namespace test {
+
+namespace {
+void ApplyScalerLinearFusion(Model& model) {
+  GraphTransformerManager graph_transformation_mgr(1);
+  ASSERT_TRUE(
+      graph_transformation_mgr.Register(std::make_unique<ScalerLinearFusion>(), TransformerLevel::Level2).IsOK());
+  ASSERT_TRUE(
+      graph_transformation_mgr.ApplyTransformers(model.MainGraph(), TransformerLevel::Level2, DefaultLoggingManager().DefaultLogger()).IsOK());
+}
+
+// X [N, 2] -> Scaler -> scaled -> `linear_op_type` -> Y (and Z for a LinearClassifier).
+void BuildScalerLinearGraph(Graph& graph, ONNX_NAMESPACE::TensorProto_DataType input_type,
+                            const std::string& linear_op_type) {
+  ONNX_NAMESPACE::TypeProto x_type;
+  x_type.mutable_tensor_type()->set_elem_type(input_type);
+  x_type.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_param("N");
+  x_type.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(2);
+
+  auto& x = graph.GetOrCreateNodeArg("X", &x_type);
+  auto& scaled = graph.GetOrCreateNodeArg("scaled", nullptr);
+  auto& y = graph.GetOrCreateNodeArg("Y", nullptr);
+  auto& scaler = graph.AddNode("scaler", "Scaler", "", {&x}, {&scaled}, nullptr, kMLDomain);
+  scaler.AddAttribute("offset", std::vector<float>{1.f, -2.f});
+  scaler.AddAttribute("scale", std::vector<float>{0.5f, 4.f});
+
+  if (linear_op_type == "LinearClassifier") {
+    auto& z = graph.GetOrCreateNodeArg("Z", nullptr);
+    auto& linear = graph.AddNode("linear", linear_op_type, "", {&scaled}, {&y, &z}, nullptr, kMLDomain);
+    linear.AddAttribute("coefficients", std::vector<float>{1.f, 2.f, -3.f, 0.25f});
+    linear.AddAttribute("intercepts", std::vector<float>{0.5f, -1.f});
+    linear.AddAttribute("classlabels_ints", std::vector<int64_t>{7, 8});
+  } else {
+    auto& linear = graph.AddNode("linear", linear_op_type, "", {&scaled}, {&y}, nullptr, kMLDomain);
+    linear.AddAttribute("coefficients", std::vector<float>{1.f, 2.f, -3.f, 0.25f});
+    linear.AddAttribute("targets", static_cast<int64_t>(2));
+  }
+}
+}  // namespace
+
+TEST(ScalerLinearFusionTests, LinearClassifier) {
+  const auto& logger = DefaultLoggingManager().DefaultLogger();
+  Model model("ScalerLinearClassifier", false, ModelMetaData(), PathString(), IOnnxRuntimeOpSchemaRegistryList(),
+              {{kOnnxDomain, 13}, {kMLDomain, 1}}, {}, logger);
+  auto& graph = model.MainGraph();
+  BuildScalerLinearGraph(graph, ONNX_NAMESPACE::TensorProto_DataType_INT64, "LinearClassifier");
+  ASSERT_TRUE(graph.Resolve().IsOK());
+
+  ApplyScalerLinearFusion(model);
+  ASSERT_TRUE(graph.Resolve().IsOK());
+
+  auto op_count = CountOpsInGraph(graph);
+  ASSERT_EQ(op_count["ai.onnx.ml.Scaler"], 0);
+  ASSERT_EQ(op_count["ai.onnx.ml.LinearClassifier"], 1);
+
+  const Node& linear = *graph.Nodes().begin();
+  ASSERT_EQ(linear.InputDefs()[0]->Name(), "X");
+
+  // coefficients * scale, intercepts - coefficients * scale * offset
+  std::vector<float> coefficients;
+  std::vector<float> intercepts;
+  ASSERT_TRUE(graph_utils::GetRepeatedNodeAttributeValues(linear, "coefficients", coefficients));
+  ASSERT_TRUE(graph_utils::GetRepeatedNodeAttributeValues(linear, "intercepts", intercepts));
+  ASSERT_EQ(coefficients, (std::vector<float>{0.5f, 8.f, -1.5f, 1.f}));
+  ASSERT_EQ(intercepts, (std::vector<float>{0.5f - (0.5f - 16.f), -1.f - (-1.5f - 2.f)}));
+}
+
+TEST(ScalerLinearFusionTests, LinearRegressorWithoutIntercepts) {
+  const auto& logger = DefaultLoggingManager().DefaultLogger();
+  Model model("ScalerLinearRegressor", false, ModelMetaData(), PathString(), IOnnxRuntimeOpSchemaRegistryList(),
+              {{kOnnxDomain, 13}, {kMLDomain, 1}}, {}, logger);
+  auto& graph = model.MainGraph();
+  BuildScalerLinearGraph(graph, ONNX_NAMESPACE::TensorProto_DataType_FLOAT, "LinearRegressor");
+  ASSERT_TRUE(graph.Resolve().IsOK());
+
+  ApplyScalerLinearFusion(model);
+
+  auto op_count = CountOpsInGraph(graph);
+  ASSERT_EQ(op_count["ai.onnx.ml.Scaler"], 0);
+  ASSERT_EQ(op_count["ai.onnx.ml.LinearRegressor"], 1);
+
+  std::vector<float> intercepts;
+  ASSERT_TRUE(graph_utils::GetRepeatedNodeAttributeValues(*graph.Nodes().begin(), "intercepts", intercepts));
+  ASSERT_EQ(intercepts, (std::vector<float>{15.5f, 3.5f}));
+}
+
+// The LinearRegressor kernel only takes float inputs, so the Scaler converting a double input is kept.
+TEST(ScalerLinearFusionTests, LinearRegressorDoubleInputIsNotFused) {
+  const auto& logger = DefaultLoggingManager().DefaultLogger();
+  Model model("ScalerLinearRegressorDouble", false, ModelMetaData(), PathString(),
+              IOnnxRuntimeOpSchemaRegistryList(), {{kOnnxDomain, 13}, {kMLDomain, 1}}, {}, logger);
+  auto& graph = model.MainGraph();
+  BuildScalerLinearGraph(graph, ONNX_NAMESPACE::TensorProto_DataType_DOUBLE, "LinearRegressor");
+  ASSERT_TRUE(graph.Resolve().IsOK());
+
+  ApplyScalerLinearFusion(model);
+
+  auto op_count = CountOpsInGraph(graph);
+  ASSERT_EQ(op_count["ai.onnx.ml.Scaler"], 1);
+  ASSERT_EQ(op_count["ai.onnx.ml.LinearRegressor"], 1);
+}
+
+}  // namespace test
+}  // namespace onnxruntime
@@ -0,0 +1,198 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "test/framework/test_utils.h"
+#include "test/test_environment.h"
+#include "test/util/include/asserts.h"
+#include "core/graph/model.h"
+#include "core/optimizer/graph_transformer_mgr.h"
+#include "core/optimizer/zipmap_elimination.h"
+#include "core/session/inference_session.h"
+#include "core/session/onnxruntime_session_options_config_keys.h"
+
+#include "gtest/gtest.h"
+
+#include <string>
+#include <vector>
+
+namespace onnxruntime {
+namespace test {
+
+namespace {
+void ApplyZipMapElimination(Model& model) {
+  GraphTransformerManager graph_transformation_mgr(1);
+  ASSERT_TRUE(
+      graph_transformation_mgr.Register(std::make_unique<ZipMapElimination>(), TransformerLevel::Level1).IsOK());
+  ASSERT_TRUE(
+      graph_transformation_mgr.ApplyTransformers(model.MainGraph(), TransformerLevel::Level1, DefaultLoggingManager().DefaultLogger()).IsOK());
+}
+
+// X -> Softmax -> Y -> ZipMap -> Z, Z is a graph output only if `zipmap_output_is_graph_output` is true.
+void BuildClassifierGraph(Graph& graph, bool zipmap_output_is_graph_output) {
+  ONNX_NAMESPACE::TypeProto float_type;
+  float_type.mutable_tensor_type()->set_elem_type(ONNX_NAMESPACE::TensorProto_DataType_FLOAT);
+  float_type.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_param("N");
+  float_type.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(3);
+
+  auto& x = graph.GetOrCreateNodeArg("X", &float_type);
+  auto& y = graph.GetOrCreateNodeArg("Y", &float_type);
+  auto& z = graph.GetOrCreateNodeArg("Z", nullptr);
+  graph.AddNode("softmax", "Softmax", "", {&x}, {&y});
+  auto& zipmap = graph.AddNode("zipmap", "ZipMap", "", {&y}, {&z}, nullptr, kMLDomain);
+  zipmap.AddAttribute("classlabels_strings", std::vector<std::string>{"a", "b", "c"});
+
+  if (zipmap_output_is_graph_output) {
+    graph.SetOutputs({&y, &z});
+  } else {
+    graph.SetOutputs({&y});
+  }
+}
+
+// X -> LinearClassifier -> (label, scores), scores -> ZipMap -> probabilities, with the class labels 10, 20 and 30.
+// The scores of a row of X are [x0, x1 + 0.5, x0 + x1 - 1] as there is no post transform.
+void RunLinearClassifierZipMap(bool strip_zipmap_outputs, const std::vector<std::string>& output_names,
+                               std::vector<OrtValue>& fetches) {
+  const auto& logger = DefaultLoggingManager().DefaultLogger();
+  Model model("LinearClassifierZipMap", false, ModelMetaData(), PathString(), IOnnxRuntimeOpSchemaRegistryList(),
+              {{kOnnxDomain, 13}, {kMLDomain, 1}}, {}, logger);
+  auto& graph = model.MainGraph();
+
+  ONNX_NAMESPACE::TypeProto float_type;
+  float_type.mutable_tensor_type()->set_elem_type(ONNX_NAMESPACE::TensorProto_DataType_FLOAT);
+  float_type.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_param("N");
+  float_type.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(2);
+
+  auto& x = graph.GetOrCreateNodeArg("X", &float_type);
+  auto& label = graph.GetOrCreateNodeArg("label", nullptr);
+  auto& scores = graph.GetOrCreateNodeArg("scores", nullptr);
+  auto& probabilities = graph.GetOrCreateNodeArg("probabilities", nullptr);
+
+  auto& classifier = graph.AddNode("classifier", "LinearClassifier", "", {&x}, {&label, &scores}, nullptr,
+                                   kMLDomain);
+  classifier.AddAttribute("coefficients", std::vector<float>{1.f, 0.f, 0.f, 1.f, 1.f, 1.f});
+  classifier.AddAttribute("intercepts", std::vector<float>{0.f, 0.5f, -1.f});
+  classifier.AddAttribute("classlabels_ints", std::vector<int64_t>{10, 20, 30});
+  auto& zipmap = graph.AddNode("zipmap", "ZipMap", "", {&scores}, {&probabilities}, nullptr, kMLDomain);
+  zipmap.AddAttribute("classlabels_int64s", std::vector<int64_t>{10, 20, 30});
+
+  graph.SetOutputs({&label, &probabilities});
+  ASSERT_STATUS_OK(graph.Resolve());
+
+  std::string model_data;
+  model.ToProto().SerializeToString(&model_data);
+
+  SessionOptions so;
+  so.session_logid = "ZipMapEliminationTests";
+  if (strip_zipmap_outputs) {
+    ASSERT_STATUS_OK(so.config_options.AddConfigEntry(kOrtSessionOptionsStripZipMapOutputs, "1"));
+  }
+  InferenceSession session{so, GetEnvironment()};
+  ASSERT_STATUS_OK(session.Load(model_data.data(), static_cast<int>(model_data.size())));
+  ASSERT_STATUS_OK(session.Initialize());
+
+  OrtValue input;
+  CreateMLValue<float>(TestCPUExecutionProvider()->GetAllocator(0, OrtMemTypeDefault), {2, 2},
+                       {1.f, 2.f, -1.f, 0.5f}, &input);
+  NameMLValMap feeds{{"X", input}};
+
+  ASSERT_STATUS_OK(session.Run(RunOptions(), feeds, output_names, &fetches));
+  ASSERT_EQ(fetches.size(), output_names.size());
+}
+
+const std::vector<float> kLinearClassifierScores{1.f, 2.5f, 2.f, -1.f, 1.f, -1.5f};
+}  // namespace
+
+TEST(ZipMapEliminationTests, GraphOutputBecomesTensor) {
+  const auto& logger = DefaultLoggingManager().DefaultLogger();
+  Model model("ZipMapGraphOutput", false, ModelMetaData(), PathString(), IOnnxRuntimeOpSchemaRegistryList(),
+              {{kOnnxDomain, 13}, {kMLDomain, 1}}, {}, logger);
+  auto& graph = model.MainGraph();
+  BuildClassifierGraph(graph, true);
+  ASSERT_TRUE(graph.Resolve().IsOK());
+  ASSERT_TRUE(graph.GetNodeArg("Z")->TypeAsProto()->has_sequence_type());
+
+  ApplyZipMapElimination(model);
+  ASSERT_TRUE(graph.Resolve().IsOK());
+
+  auto op_count = CountOpsInGraph(graph);
+  ASSERT_EQ(op_count["ai.onnx.ml.ZipMap"], 0);
+  ASSERT_EQ(op_count["Identity"], 1);
+  ASSERT_EQ(op_count["Softmax"], 1);
+
+  // The output keeps its name and now holds the probabilities.
+  const auto& outputs = graph.GetOutputs();
+  ASSERT_EQ(outputs.size(), 3U);
+  ASSERT_EQ(outputs[1]->Name(), "Z");
+  const auto* z_type = outputs[1]->TypeAsProto();
+  ASSERT_TRUE(z_type->has_tensor_type());
+  ASSERT_EQ(z_type->tensor_type().elem_type(), ONNX_NAMESPACE::TensorProto_DataType_FLOAT);
+  ASSERT_EQ(z_type->tensor_type().shape().dim_size(), 2);
+
+  // The class labels of the columns are added as a constant output.
+  ASSERT_EQ(outputs[2]->Name(), "Z_keys");
+  const ONNX_NAMESPACE::TensorProto* keys = nullptr;
+  ASSERT_TRUE(graph.GetInitializedTensor("Z_keys", keys));
+  ASSERT_EQ(keys->data_type(), ONNX_NAMESPACE::TensorProto_DataType_STRING);
+  ASSERT_EQ(keys->dims_size(), 1);
+  ASSERT_EQ(keys->dims(0), 3);
+  ASSERT_EQ(std::vector<std::string>(keys->string_data().begin(), keys->string_data().end()),
+            (std::vector<std::string>{"a", "b", "c"}));
+}
+
+TEST(ZipMapEliminationTests, ZipMapNotProducingGraphOutputIsKept) {
+  const auto& logger = DefaultLoggingManager().DefaultLogger();
+  Model model("ZipMapNotGraphOutput", false, ModelMetaData(), PathString(), IOnnxRuntimeOpSchemaRegistryList(),
+              {{kOnnxDomain, 13}, {kMLDomain, 1}}, {}, logger);
+  auto& graph = model.MainGraph();
+  BuildClassifierGraph(graph, false);
+  ASSERT_TRUE(graph.Resolve().IsOK());
+
+  ApplyZipMapElimination(model);
+
+  auto op_count = CountOpsInGraph(graph);
+  ASSERT_EQ(op_count["ai.onnx.ml.ZipMap"], 1);
+  ASSERT_EQ(op_count["Identity"], 0);
+}
+
+TEST(ZipMapEliminationTests, SessionStripsZipMapOutput) {
+  std::vector<OrtValue> fetches;
+  RunLinearClassifierZipMap(true, {"label", "probabilities", "probabilities_keys"}, fetches);
+
+  const auto& label = fetches[0].Get<Tensor>();
+  ASSERT_EQ(label.Shape(), TensorShape({2}));
+  EXPECT_EQ(std::vector<int64_t>(label.Data<int64_t>(), label.Data<int64_t>() + 2), (std::vector<int64_t>{20, 20}));
+
+  // The probabilities are the scores given to the ZipMap, one column per class label.
+  ASSERT_TRUE(fetches[1].IsTensor());
+  const auto& probabilities = fetches[1].Get<Tensor>();
+  ASSERT_EQ(probabilities.Shape(), TensorShape({2, 3}));
+  EXPECT_EQ(std::vector<float>(probabilities.Data<float>(), probabilities.Data<float>() + 6), kLinearClassifierScores);
+
+  const auto& keys = fetches[2].Get<Tensor>();
+  ASSERT_EQ(keys.Shape(), TensorShape({3}));
+  EXPECT_EQ(std::vector<int64_t>(keys.Data<int64_t>(), keys.Data<int64_t>() + 3), (std::vector<int64_t>{10, 20, 30}));
+}
+
+TEST(ZipMapEliminationTests, SessionKeepsZipMapOutputByDefault) {
+  std::vector<OrtValue> fetches;
+  RunLinearClassifierZipMap(false, {"label", "probabilities"}, fetches);
+
+  const auto& label = fetches[0].Get<Tensor>();
+  EXPECT_EQ(std::vector<int64_t>(label.Data<int64_t>(), label.Data<int64_t>() + 2), (std::vector<int64_t>{20, 20}));
+
+  // Without the option the output is still the sequence of maps from the class label to the score.
+  ASSERT_FALSE(fetches[1].IsTensor());
+  const auto& probabilities = fetches[1].Get<VectorMapInt64ToFloat>();
+  ASSERT_EQ(probabilities.size(), 2U);
+  const std::vector<int64_t> class_labels{10, 20, 30};
+  for (size_t row = 0; row < probabilities.size(); ++row) {
+    ASSERT_EQ(probabilities[row].size(), class_labels.size());
+    for (size_t j = 0; j < class_labels.size(); ++j) {
+      EXPECT_EQ(probabilities[row].at(class_labels[j]), kLinearClassifierScores[row * 3 + j])
+          << "row " << row << ", class " << class_labels[j];
+    }
+  }
+}
+
+}  // namespace test
+}  // namespace onnxruntime
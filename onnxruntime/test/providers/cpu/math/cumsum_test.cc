@@ -218,5 +218,35 @@ TEST(CumSumTest, _1DTestdouble_WithInt64Axis) {
   test.AddOutput<double>("y", {5}, {1., 3., 6., 10., 15.});
   test.Run(OpTester::ExpectResult::kExpectSuccess, "", {kTensorrtExecutionProvider});
 }
+// The inner dimensions span more than one block of work, so each block has to be summed independently.
+TEST(CumSumTest, _3DTestAxis1LargeInner) {
+  const int64_t outer = 2;
+  const int64_t dim = 3;
+  const int64_t inner = 2500;
+  std::vector<int64_t> x(outer * dim * inner);
+  for (size_t i = 0; i < x.size(); ++i) {
+    x[i] = static_cast<int64_t>(i % 7);
+  }
+
+  std::vector<int64_t> y(x.size());
+  for (int64_t o = 0; o < outer; ++o) {
+    for (int64_t i = 0; i < inner; ++i) {
+      int64_t sum = 0;
+      for (int64_t d = dim - 1; d >= 0; --d) {
+        const int64_t index = (o * dim + d) * inner + i;
+        y[index] = sum;
+        sum += x[index];
+      }
+    }
+  }
+
+  OpTester test("CumSum", 11, onnxruntime::kOnnxDomain);
+  test.AddAttribute<int64_t>("reverse", 1);
+  test.AddAttribute<int64_t>("exclusive", 1);
+  test.AddInput<int64_t>("x", {outer, dim, inner}, x);
+  test.AddInput<int32_t>("axis", {1}, {1});
+  test.AddOutput<int64_t>("y", {outer, dim, inner}, y);
+  test.Run(OpTester::ExpectResult::kExpectSuccess, "", {kTensorrtExecutionProvider});
+}
 }  // namespace test
 }  // namespace onnxruntime
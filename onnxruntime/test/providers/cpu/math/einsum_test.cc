@@ -254,6 +254,75 @@ TEST(Einsum, ExplicitEinsumAsMatmul_2) {
   test.Run();
 }
 
+// The left operand is consumed by the MatMul as transposed instead of being transposed up-front
+TEST(Einsum, ExplicitEinsumAsMatmul_TransposedLeft) {
+  OpTester test("Einsum", 12, onnxruntime::kOnnxDomain);
+  test.AddAttribute<std::string>("equation", "ji,jk->ik");
+  test.AddInput<float>("x", {3, 2}, {1.f, 2.f, 3.f, 4.f, 5.f, 6.f});
+  test.AddInput<float>("y", {3, 2}, {1.f, 2.f, 3.f, 4.f, 5.f, 6.f});
+  test.AddOutput<float>("o", {2, 2}, {35.f, 44.f, 44.f, 56.f});
+  test.Run();
+}
+
+TEST(Einsum, ExplicitEinsumAsMatmul_TransposedLeft_double) {
+  OpTester test("Einsum", 12, onnxruntime::kOnnxDomain);
+  test.AddAttribute<std::string>("equation", "ji,jk->ik");
+  test.AddInput<double>("x", {3, 2}, {1., 2., 3., 4., 5., 6.});
+  test.AddInput<double>("y", {3, 2}, {1., 2., 3., 4., 5., 6.});
+  test.AddOutput<double>("o", {2, 2}, {35., 44., 44., 56.});
+  test.Run();
+}
+
+TEST(Einsum, ExplicitEinsumAsMatmul_TransposedLeft_int64) {
+  OpTester test("Einsum", 12, onnxruntime::kOnnxDomain);
+  test.AddAttribute<std::string>("equation", "ji,jk->ik");
+  test.AddInput<int64_t>("x", {3, 2}, {1, 2, 3, 4, 5, 6});
+  test.AddInput<int64_t>("y", {3, 2}, {1, 2, 3, 4, 5, 6});
+  test.AddOutput<int64_t>("o", {2, 2}, {35, 44, 44, 56});
+  test.Run();
+}
+
+// The right operand is consumed by the MatMul as transposed instead of being transposed up-front
+TEST(Einsum, ExplicitEinsumAsMatmul_TransposedRight) {
+  OpTester test("Einsum", 12, onnxruntime::kOnnxDomain);
+  test.AddAttribute<std::string>("equation", "ijk,jk->ij");
+  test.AddInput<float>("x", {2, 1, 3}, {1.f, 2.f, 3.f, 4.f, 5.f, 6.f});
+  test.AddInput<float>("y", {2, 3}, {1.f, -1.f, 2.f, 0.f, 3.f, -2.f});
+  test.AddOutput<float>("o", {2, 2}, {5.f, 0.f, 11.f, 3.f});
+  test.Run();
+}
+
+TEST(Einsum, ExplicitEinsumAsMatmul_TransposedRight_int32) {
+  OpTester test("Einsum", 12, onnxruntime::kOnnxDomain);
+  test.AddAttribute<std::string>("equation", "ijk,jk->ij");
+  test.AddInput<int32_t>("x", {2, 1, 3}, {1, 2, 3, 4, 5, 6});
+  test.AddInput<int32_t>("y", {2, 3}, {1, -1, 2, 0, 3, -2});
+  test.AddOutput<int32_t>("o", {2, 2}, {5, 0, 11, 3});
+  test.Run();
+}
+
+// The operands are not contracted left to right: y and z are contracted first as that yields the smallest intermediate
+TEST(Einsum, ExplicitEinsumAsMatmul_Multi_Input_ContractionOrder) {
+  OpTester test("Einsum", 12, onnxruntime::kOnnxDomain);
+  test.AddAttribute<std::string>("equation", "ij,jk,kl->il");
+  test.AddInput<float>("x", {8, 2}, {-2.f, -1.f, 0.f, 1.f, 2.f, -2.f, -1.f, 0.f, 1.f, 2.f, -2.f, -1.f, 0.f, 1.f, 2.f, -2.f});
+  test.AddInput<float>("y", {2, 8}, {-1.f, 0.f, 1.f, -1.f, 0.f, 1.f, -1.f, 0.f, 1.f, -1.f, 0.f, 1.f, -1.f, 0.f, 1.f, -1.f});
+  test.AddInput<float>("z", {8, 1}, {0.f, 1.f, 2.f, 3.f, 0.f, 1.f, 2.f, 3.f});
+  test.AddOutput<float>("o", {8, 1}, {3.f, 1.f, -6.f, 2.f, 0.f, 3.f, 1.f, -6.f});
+  test.Run();
+}
+
+TEST(Einsum, ExplicitEinsumAsMatmul_Multi_Input_ContractionOrder_1) {
+  OpTester test("Einsum", 12, onnxruntime::kOnnxDomain);
+  test.AddAttribute<std::string>("equation", "ab,bc,cd,d->a");
+  test.AddInput<float>("w", {2, 2}, {1.f, 2.f, 3.f, 4.f});
+  test.AddInput<float>("x", {2, 3}, {1.f, 0.f, 2.f, 1.f, 0.f, 3.f});
+  test.AddInput<float>("y", {3, 2}, {1.f, 2.f, 3.f, 1.f, -1.f, 0.f});
+  test.AddInput<float>("z", {2}, {2.f, 1.f});
+  test.AddOutput<float>("o", {2}, {-4.f, -8.f});
+  test.Run();
+}
+
 // Implicit
 TEST(Einsum, ImplicitEinsumAsMatmul) {
   OpTester test("Einsum", 12, onnxruntime::kOnnxDomain);
@@ -842,5 +842,51 @@ TEST(TopKOperator, SelectTopKThreaded) {
   TestThreaded<double>(k, n, batch_size);
 }
 
+// rows long enough to be split across threads. values have many duplicates to check ties pick the lowest index.
+template <typename T>
+static void TestLongRows(int64_t k, int64_t largest, int64_t sorted) {
+  const int64_t rows = 2;
+  const int64_t cols = 100000;
+  std::vector<T> input_vals(rows * cols);
+  for (int64_t i = 0; i < rows * cols; ++i) {
+    input_vals[i] = static_cast<T>((i * 7919) % 5003) - static_cast<T>(2500);
+  }
+
+  std::vector<T> expected_vals;
+  std::vector<int64_t> expected_indices;
+  for (int64_t r = 0; r < rows; ++r) {
+    const T* row = input_vals.data() + r * cols;
+    std::vector<int64_t> order(cols);
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(), [row, largest](int64_t a, int64_t b) {
+      return largest ? row[a] > row[b] : row[a] < row[b];
+    });
+    for (int64_t l = 0; l < k; ++l) {
+      expected_vals.push_back(row[order[l]]);
+      expected_indices.push_back(order[l]);
+    }
+  }
+
+  RunTest(11, k, input_vals, {rows, cols}, expected_vals, expected_indices, {rows, k}, false, -1, largest, sorted);
+}
+
+TEST(TopKOperator, LongRowsSmallK) {
+  TestLongRows<float>(10, 1, 1);
+  TestLongRows<float>(10, 0, 1);
+  TestLongRows<float>(100, 1, 0);
+  TestLongRows<double>(10, 1, 1);
+  TestLongRows<int32_t>(10, 0, 1);
+  TestLongRows<int64_t>(10, 1, 1);
+}
+
+TEST(TopKOperator, LongRowsLargeK) {
+  TestLongRows<float>(5000, 1, 1);
+  TestLongRows<float>(5000, 0, 1);
+  TestLongRows<float>(20000, 1, 0);
+  TestLongRows<double>(5000, 1, 1);
+  TestLongRows<int32_t>(5000, 0, 1);
+  TestLongRows<int64_t>(5000, 1, 1);
+}
+
 }  // namespace test
 }  // namespace onnxruntime
@@ -42,5 +42,23 @@ TEST(MLOpTest, DictVectorizerInt64Input) {
   test.Run();
 }
 
+// Keys missing from the vocabulary are ignored and a duplicated vocabulary entry gets the value at every position.
+TEST(MLOpTest, DictVectorizerDuplicatedVocabulary) {
+  OpTester test("DictVectorizer", 1, onnxruntime::kMLDomain);
+
+  test.AddAttribute("string_vocabulary", std::vector<std::string>{"a", "b", "a", "c", "b"});
+
+  std::map<std::string, float> map;
+  map["b"] = 1.5f;
+  map["c"] = 2.f;
+  map["z"] = 3.f;
+
+  test.AddInput<std::string, float>("X", map);
+
+  std::vector<int64_t> dims{1, 5};
+  test.AddOutput<float>("Y", dims, {0.f, 1.5f, 0.f, 2.f, 1.5f});
+  test.Run();
+}
+
 }  // namespace test
 }  // namespace onnxruntime
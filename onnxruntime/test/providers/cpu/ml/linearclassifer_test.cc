@@ -126,6 +126,84 @@ TEST(MLOpTest, LinearClassifierBinaryWithLabels) {
   test.Run();
 }
 
+// Enough rows for the kernel to split them between threads, each thread writing its own slice of the outputs.
+TEST(MLOpTest, LinearClassifierBinaryWithLabelsManyRows) {
+  OpTester test("LinearClassifier", 1, onnxruntime::kMLDomain);
+
+  constexpr int64_t repeats = 200;
+  std::vector<float> coefficients = {0.00085401f, -0.00314063f};
+  std::vector<float> intercepts = {0.03930598f};
+  std::vector<std::string> labels = {"not_so_good", "pretty_good"};
+  const std::vector<float> X_rows = {1.f, 0.f, 3.f, 44.f, 23.f, 11.3f};
+  const std::vector<std::string> predicted_class_rows = {"pretty_good", "not_so_good", "pretty_good"};
+  const std::vector<float> scores_rows = {0.959840000f, 0.0401599929f, 1.09631968f, -0.0963197052f,
+                                          0.976540923f, 0.0234590918f};
+
+  std::vector<float> X;
+  std::vector<std::string> predicted_class;
+  std::vector<float> scores;
+  for (int64_t i = 0; i < repeats; ++i) {
+    X.insert(X.end(), X_rows.begin(), X_rows.end());
+    predicted_class.insert(predicted_class.end(), predicted_class_rows.begin(), predicted_class_rows.end());
+    scores.insert(scores.end(), scores_rows.begin(), scores_rows.end());
+  }
+
+  test.AddAttribute("coefficients", coefficients);
+  test.AddAttribute("intercepts", intercepts);
+  test.AddAttribute("classlabels_strings", labels);
+
+  test.AddInput<float>("X", {3 * repeats, 2}, X);
+  test.AddOutput<std::string>("Y", {3 * repeats}, predicted_class);
+  test.AddOutput<float>("Z", {3 * repeats, 2}, scores);
+  test.Run();
+}
+
+// Rows with few non-zero values among many features, as produced by DictVectorizer, skip the GEMM.
+TEST(MLOpTest, LinearClassifierMulticlassSparseRows) {
+  OpTester test("LinearClassifier", 1, onnxruntime::kMLDomain);
+
+  constexpr int64_t num_features = 300;
+  constexpr int64_t num_rows = 4;
+  constexpr int64_t num_classes = 3;
+  std::vector<float> coefficients(num_classes * num_features);
+  for (size_t i = 0; i < coefficients.size(); ++i) {
+    coefficients[i] = static_cast<float>(static_cast<int64_t>(i % 7) - 3) * 0.25f;
+  }
+  std::vector<float> intercepts = {0.5f, -1.f, 0.25f};
+  std::vector<int64_t> classes = {10, 20, 30};
+
+  std::vector<float> X(num_rows * num_features, 0.f);
+  X[0 * num_features + 3] = 1.f;
+  X[0 * num_features + 250] = 2.f;
+  X[1 * num_features + 17] = -4.f;
+  X[3 * num_features + 299] = 0.5f;
+  X[3 * num_features + 100] = 1.5f;
+  X[3 * num_features + 101] = -1.f;
+
+  std::vector<float> scores(num_rows * num_classes);
+  std::vector<int64_t> predicted_class(num_rows);
+  for (int64_t r = 0; r < num_rows; ++r) {
+    for (int64_t c = 0; c < num_classes; ++c) {
+      float score = intercepts[c];
+      for (int64_t f = 0; f < num_features; ++f) {
+        score += X[r * num_features + f] * coefficients[c * num_features + f];
+      }
+      scores[r * num_classes + c] = score;
+    }
+    auto* row_scores = scores.data() + r * num_classes;
+    predicted_class[r] = classes[std::max_element(row_scores, row_scores + num_classes) - row_scores];
+  }
+
+  test.AddAttribute("coefficients", coefficients);
+  test.AddAttribute("intercepts", intercepts);
+  test.AddAttribute("classlabels_ints", classes);
+
+  test.AddInput<float>("X", {num_rows, num_features}, X);
+  test.AddOutput<int64_t>("Y", {num_rows}, predicted_class);
+  test.AddOutput<float>("Z", {num_rows, num_classes}, scores);
+  test.Run();
+}
+
 template <typename T>
 void LinearClassifierMulticlass() {
   OpTester test("LinearClassifier", 1, onnxruntime::kMLDomain);
@@ -1,6 +1,8 @@
 // Copyright (c) Microsoft Corporation. All rights reserved.
 // Licensed under the MIT License.
 
+#include <limits>
+
 #include "gtest/gtest.h"
 #include "test/providers/provider_test_utils.h"
 
@@ -85,5 +87,27 @@ INSTANTIATE_TEST_SUITE_P(
                     LinearRegressorParam("SOFTMAX_ZERO", {3.442477e-14f, 1.f, 1.670142e-05f, 1.f, 1.0f, 0.f}, 2)
 
                         ));
+
+// The zeros of a sparse row still multiply an infinite coefficient, so the target using it is NaN as with GEMM.
+TEST(LinearRegressorTest, SparseRowsWithInfiniteCoefficient) {
+  OpTester test("LinearRegressor", 1, onnxruntime::kMLDomain);
+
+  constexpr int64_t num_features = 200;
+  constexpr int64_t num_rows = 2;
+  std::vector<float> coefficients(2 * num_features, 0.5f);
+  coefficients[5] = std::numeric_limits<float>::infinity();
+  std::vector<float> X(num_rows * num_features, 0.f);
+  X[0] = 1.f;
+  X[num_features + 150] = -2.f;
+
+  test.AddAttribute("coefficients", coefficients);
+  test.AddAttribute("intercepts", std::vector<float>{0.f, 1.f});
+  test.AddAttribute("targets", int64_t{2});
+  test.AddInput<float>("X", {num_rows, num_features}, X);
+  test.AddOutput<float>("Y", {num_rows, 2},
+                        {std::numeric_limits<float>::quiet_NaN(), 1.5f,
+                         std::numeric_limits<float>::quiet_NaN(), 0.f});
+  test.Run();
+}
 }  // namespace test
 }  // namespace onnxruntime
@@ -57,6 +57,39 @@ TEST(MLOpTest, SVMRegressorNuSVC) {
   test.Run();
 }
 
+TEST(MLOpTest, SVMRegressorSVCNearSupportVectors) {
+  // Inputs equal or close to support vectors with large norms, the RBF kernel must not lose the small distances.
+  OpTester test("SVMRegressor", 1, onnxruntime::kMLDomain);
+
+  std::vector<float> dual_coefficients = {1.f, -0.5f, 2.f, 0.25f};
+  std::vector<float> support_vectors = {1000.f, -2000.f, 500.f,
+                                        1000.5f, -2000.f, 500.f,
+                                        3.f, 4.f, 5.f,
+                                        -10.f, 20.f, 30.f};
+  std::vector<float> rho = {0.1f};
+  std::vector<float> kernel_params = {0.01f, 0.f, 3.f};  //gamma, coef0, degree
+
+  std::vector<float> X = {1000.f, -2000.f, 500.f,
+                          1000.25f, -2000.f, 500.f,
+                          3.f, 4.f, 5.5f,
+                          0.f, 0.f, 0.f,
+                          1000.f, -1999.f, 500.f,
+                          -10.f, 20.f, 29.f};
+  std::vector<float> predictions = {0.6012484f, 0.5996876f, 2.095015f, 1.313062f, 0.5962609f, 0.3476024f};
+
+  test.AddAttribute("kernel_type", std::string("RBF"));
+  test.AddAttribute("coefficients", dual_coefficients);
+  test.AddAttribute("support_vectors", support_vectors);
+  test.AddAttribute("rho", rho);
+  test.AddAttribute("kernel_params", kernel_params);
+  test.AddAttribute("n_supports", static_cast<int64_t>(4));
+
+  test.AddInput<float>("X", {6, 3}, X);
+  test.AddOutput<float>("Y", {6, 1}, predictions);
+
+  test.Run();
+}
+
 TEST(MLOpTest, SVMRegressorNuSVCPolyKernel) {
   OpTester test("SVMRegressor", 1, onnxruntime::kMLDomain);
 
@@ -308,7 +308,7 @@ TEST(MLOpTest, TreeRegressorSingleTargetBatchTreeA) {
 }
 
 TEST(MLOpTest, TreeRegressorSingleTargetBatchTreeB) {
-  GenTreeAndRunTest1("AVERAGE", true, 3, 30);  // section B
+  GenTreeAndRunTest1("AVERAGE", true, 3, 50);  // section B
 }
 
 TEST(MLOpTest, TreeRegressorSingleTargetBatchTreeC) {
@@ -339,5 +339,68 @@ TEST(MLOpTest, TreeRegressorSingleTargetMax) {
   GenTreeAndRunTest1("MAX", true);
 }
 
+TEST(MLOpTest, TreeRegressorMixedModesMissingTracksBatch) {
+  // Mixed modes, a missing value tracked to the true branch, a leaf shared by two nodes
+  // and a tree reduced to one leaf, for a number of rows which is not a multiple of the row block.
+  OpTester test("TreeEnsembleRegressor", 1, onnxruntime::kMLDomain);
+
+  test.AddAttribute("nodes_truenodeids", std::vector<int64_t>{1, 0, 3, 0, 0});
+  test.AddAttribute("nodes_falsenodeids", std::vector<int64_t>{2, 0, 1, 0, 0});
+  test.AddAttribute("nodes_treeids", std::vector<int64_t>{0, 0, 0, 0, 1});
+  test.AddAttribute("nodes_nodeids", std::vector<int64_t>{0, 1, 2, 3, 0});
+  test.AddAttribute("nodes_featureids", std::vector<int64_t>{0, 0, 1, 0, 0});
+  test.AddAttribute("nodes_values", std::vector<float>{1.f, 0.f, 2.f, 0.f, 0.f});
+  test.AddAttribute("nodes_modes", std::vector<std::string>{"BRANCH_LT", "LEAF", "BRANCH_GTE", "LEAF", "LEAF"});
+  test.AddAttribute("nodes_missing_value_tracks_true", std::vector<int64_t>{1, 0, 0, 0, 0});
+  test.AddAttribute("target_treeids", std::vector<int64_t>{0, 0, 1});
+  test.AddAttribute("target_nodeids", std::vector<int64_t>{1, 3, 0});
+  test.AddAttribute("target_ids", std::vector<int64_t>{0, 0, 0});
+  test.AddAttribute("target_weights", std::vector<float>{1.f, 10.f, 1000.f});
+  test.AddAttribute("n_targets", (int64_t)1);
+
+  const float nan = std::numeric_limits<float>::quiet_NaN();
+  std::vector<float> X = {0.f, 0.f, nan, 5.f, 3.f, 5.f, 1.f, 5.f, 3.f, nan};
+  std::vector<float> results = {1001.f, 1001.f, 1010.f, 1010.f, 1001.f};
+  _multiply_update_array(X, 4);
+  _multiply_update_array(results, 4);
+
+  test.AddInput<float>("X", {20, 2}, X);
+  test.AddOutput<float>("Y", {20, 1}, results);
+  test.Run();
+}
+
+TEST(MLOpTest, TreeRegressorPerfectTreesBatch) {
+  // Two complete trees of depth 2 (every leaf at the same depth) share one mode and are evaluated
+  // without branches, missing values must follow the false branch of BRANCH_LT.
+  OpTester test("TreeEnsembleRegressor", 1, onnxruntime::kMLDomain);
+
+  test.AddAttribute("nodes_truenodeids", std::vector<int64_t>{1, 3, 5, 0, 0, 0, 0, 1, 3, 5, 0, 0, 0, 0});
+  test.AddAttribute("nodes_falsenodeids", std::vector<int64_t>{2, 4, 6, 0, 0, 0, 0, 2, 4, 6, 0, 0, 0, 0});
+  test.AddAttribute("nodes_treeids", std::vector<int64_t>{0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 1, 1, 1});
+  test.AddAttribute("nodes_nodeids", std::vector<int64_t>{0, 1, 2, 3, 4, 5, 6, 0, 1, 2, 3, 4, 5, 6});
+  test.AddAttribute("nodes_featureids", std::vector<int64_t>{0, 1, 2, 0, 0, 0, 0, 2, 0, 0, 0, 0, 0, 0});
+  test.AddAttribute("nodes_values", std::vector<float>{0.f, 1.f, -1.f, 0.f, 0.f, 0.f, 0.f,
+                                                       5.f, 2.f, 3.f, 0.f, 0.f, 0.f, 0.f});
+  test.AddAttribute("nodes_modes", std::vector<std::string>{"BRANCH_LT", "BRANCH_LT", "BRANCH_LT", "LEAF", "LEAF",
+                                                            "LEAF", "LEAF", "BRANCH_LT", "BRANCH_LT", "BRANCH_LT",
+                                                            "LEAF", "LEAF", "LEAF", "LEAF"});
+  test.AddAttribute("target_treeids", std::vector<int64_t>{0, 0, 0, 0, 1, 1, 1, 1});
+  test.AddAttribute("target_nodeids", std::vector<int64_t>{3, 4, 5, 6, 3, 4, 5, 6});
+  test.AddAttribute("target_ids", std::vector<int64_t>{0, 0, 0, 0, 0, 0, 0, 0});
+  test.AddAttribute("target_weights", std::vector<float>{1.f, 2.f, 3.f, 4.f, 10.f, 20.f, 30.f, 40.f});
+  test.AddAttribute("n_targets", (int64_t)1);
+
+  const float nan = std::numeric_limits<float>::quiet_NaN();
+  std::vector<float> X = {-1.f, 0.f, 0.f, -1.f, 2.f, 9.f, 1.f, 0.f, -2.f, 1.f, 0.f, 0.f,
+                          nan, 0.f, 0.f, -1.f, nan, nan, 4.f, 4.f, 4.f};
+  std::vector<float> results = {11.f, 32.f, 13.f, 14.f, 24.f, 32.f, 24.f};
+  _multiply_update_array(X, 11);
+  _multiply_update_array(results, 11);
+
+  test.AddInput<float>("X", {77, 3}, X);
+  test.AddOutput<float>("Y", {77, 1}, results);
+  test.Run();
+}
+
 }  // namespace test
 }  // namespace onnxruntime
@@ -1,8 +1,5 @@
 ﻿// Copyright (c) Microsoft Corporation. All rights reserved.
 // Licensed under the MIT License.
-#if ((__cplusplus >= 201703L) || (defined(_MSVC_LANG) && (_MSVC_LANG >= 201703L)))
-//TODO: handle the u8string.
-#else
 #include "gtest/gtest.h"
 #include "test/providers/provider_test_utils.h"
 
@@ -38,6 +35,9 @@ void InitTestAttr(OpTester& test, const std::string& case_change_action,
 
 using namespace str_normalizer_test;
 
+#if ((__cplusplus >= 201703L) || (defined(_MSVC_LANG) && (_MSVC_LANG >= 201703L)))
+//TODO: handle the u8string.
+#else
 TEST(ContribOpTest, StringNormalizerTest) {
   // - casesensitive approach
   // - no stopwords.
@@ -201,7 +201,97 @@ TEST(ContribOpTest, StringNormalizerTest) {
     test.Run(OpTester::ExpectResult::kExpectSuccess);
   }
 }
+#endif
+
+// The strings below are UTF-8 written with escapes so that they do not depend on u8 literals.
+// ASCII strings go through the case tables of the kernel, the others through wide characters.
+TEST(ContribOpTest, StringNormalizerMixedAsciiCaseChange) {
+  const std::vector<std::string> input = {"Hello World",
+                                          "Besan\xC3\xA7on",  // Besançon
+                                          "\xC3\x89" "cole",  // École
+                                          "\xD0\x9F\xD1\x80\xD0\xB8\xD0\xB2\xD0\xB5\xD1\x82",  // Привет
+                                          "MiXeD 123",
+                                          "\xE4\xB8\xAD\xE6\x96\x87"};  // 中文, no case
+  const std::vector<std::string> lower = {"hello world",
+                                          "besan\xC3\xA7on",
+                                          "\xC3\xA9" "cole",
+                                          "\xD0\xBF\xD1\x80\xD0\xB8\xD0\xB2\xD0\xB5\xD1\x82",
+                                          "mixed 123",
+                                          "\xE4\xB8\xAD\xE6\x96\x87"};
+  const std::vector<std::string> upper = {"HELLO WORLD",
+                                          "BESAN\xC3\x87" "ON",
+                                          "\xC3\x89" "COLE",
+                                          "\xD0\x9F\xD0\xA0\xD0\x98\xD0\x92\xD0\x95\xD0\xA2",
+                                          "MIXED 123",
+                                          "\xE4\xB8\xAD\xE6\x96\x87"};
+
+  auto run = [&](const std::string& case_change_action, const std::vector<std::string>& output) {
+    OpTester test("StringNormalizer", opset_ver, domain);
+    InitTestAttr(test, case_change_action, true, {}, test_locale);
+    test.AddInput<std::string>("T", {static_cast<int64_t>(input.size())}, input);
+    test.AddOutput<std::string>("Y", {static_cast<int64_t>(output.size())}, output);
+    test.Run(OpTester::ExpectResult::kExpectSuccess);
+  };
+
+  run("NONE", input);
+  run("LOWER", lower);
+  run("UPPER", upper);
+}
+
+TEST(ContribOpTest, StringNormalizerCaseInsensitiveNonAsciiStopwords) {
+  const std::vector<std::string> stopwords = {"\xC3\xA9" "cole",  // école
+                                              "\xD0\x9F\xD0\xA0\xD0\x98\xD0\x92\xD0\x95\xD0\xA2",  // ПРИВЕТ
+                                              "Monday"};
+  const std::vector<std::string> input = {"\xC3\x89" "COLE",  // ÉCOLE
+                                          "Besan\xC3\xA7on",
+                                          "\xD0\x9F\xD1\x80\xD0\xB8\xD0\xB2\xD0\xB5\xD1\x82",  // Привет
+                                          "MONDAY",
+                                          "\xC3\xA9" "coles",  // écoles
+                                          "monday"};  // LOWER compares the lower case strings.
+  {
+    OpTester test("StringNormalizer", opset_ver, domain);
+    InitTestAttr(test, "NONE", false, stopwords, test_locale);
+    test.AddInput<std::string>("T", {1, 6}, input);
+    test.AddOutput<std::string>("Y", {1, 2}, {"Besan\xC3\xA7on", "\xC3\xA9" "coles"});
+    test.Run(OpTester::ExpectResult::kExpectSuccess);
+  }
+  // UPPER compares the upper case strings.
+  {
+    OpTester test("StringNormalizer", opset_ver, domain);
+    InitTestAttr(test, "UPPER", false, stopwords, test_locale);
+    test.AddInput<std::string>("T", {1, 6}, input);
+    test.AddOutput<std::string>("Y", {1, 2}, {"BESAN\xC3\x87" "ON", "\xC3\x89" "COLES"});
+    test.Run(OpTester::ExpectResult::kExpectSuccess);
+  }
+}
+
+// Enough strings for several blocks of the kernel, with the stopwords spread over all of them.
+TEST(ContribOpTest, StringNormalizerManyBlocks) {
+  const std::string stopword = "stop\xC3\xA9";  // stopé
+  std::vector<std::string> input;
+  std::vector<std::string> output;
+  for (int i = 0; i < 6000; ++i) {
+    const std::string n = std::to_string(i);
+    if (i % 7 == 0) {
+      input.push_back("STOP\xC3\x89");  // STOPÉ
+    } else if (i % 5 == 0) {
+      input.push_back("Stop");
+      output.push_back("STOP");
+    } else if (i % 2 == 0) {
+      input.push_back("word " + n);
+      output.push_back("WORD " + n);
+    } else {
+      input.push_back("\xC3\xA9t\xC3\xA9 " + n);  // été
+      output.push_back("\xC3\x89T\xC3\x89 " + n);
+    }
+  }
+
+  OpTester test("StringNormalizer", opset_ver, domain);
+  InitTestAttr(test, "UPPER", false, {stopword}, test_locale);
+  test.AddInput<std::string>("T", {static_cast<int64_t>(input.size())}, input);
+  test.AddOutput<std::string>("Y", {static_cast<int64_t>(output.size())}, output);
+  test.Run(OpTester::ExpectResult::kExpectSuccess);
+}
 
 }  // namespace test
 }  // namespace onnxruntime
-#endif
\ No newline at end of file
@@ -690,6 +690,37 @@ TEST(TfIdfVectorizerTest, String_TFIDFWeights_onlyBigrams_Skip5_2rows) {
   test.Run(OpTester::ExpectResult::kExpectSuccess);
 }
 
+TEST(TfIdfVectorizerTest, Int64_TF_PrefixesAreNotCounted_ManyRows) {
+  OpTester test("TfIdfVectorizer", opset_ver);
+  // s=0, Min=1, Max=3, weights empty, int64. {3, 4} is the prefix of the tri-gram but not a bi-gram of the pool.
+  InitTestAttr(test, "TF", 1, 3, 0,
+               {0, 2, 4},
+               {0, 1, 2, 3},  //4 output indexes
+               {},
+               {1, 2,      //1-grams
+                1, 2,      //bi-grams
+                3, 4, 5},  //tri-grams
+               {});
+
+  // Enough rows to be split between several threads.
+  const int64_t rows = 64;
+  std::vector<int64_t> input;
+  std::vector<float> output;
+  for (int64_t row = 0; row < rows; ++row) {
+    if (row % 2 == 0) {
+      input.insert(input.end(), {1, 2, 3, 4, 5});
+      output.insert(output.end(), {1.f, 1.f, 1.f, 1.f});
+    } else {
+      input.insert(input.end(), {3, 4, 1, 2, 2});
+      output.insert(output.end(), {1.f, 2.f, 1.f, 0.f});
+    }
+  }
+  test.AddInput<int64_t>("T", {rows, 5}, input);
+  test.AddOutput<float>("Y", {rows, 4}, output);
+
+  test.Run(OpTester::ExpectResult::kExpectSuccess);
+}
+
 // This test runs the inference 100 times to test the improvement
 // It enables profiling while running inference multiple times.
 // So we can manually inspect the profiling output
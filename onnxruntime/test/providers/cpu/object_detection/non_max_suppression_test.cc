@@ -383,5 +383,53 @@ TEST(NonMaxSuppressionOpTest, WithIOUThresholdOpset11) {
   test.Run();
 }
 
+// Enough selections per class that the selected boxes are bucketed spatially, over several batches and classes.
+TEST(NonMaxSuppressionOpTest, ManyBoxesManyClasses) {
+  constexpr int64_t grid_size = 12;
+  constexpr int64_t num_cells = grid_size * grid_size;
+  constexpr int64_t num_boxes = 2 * num_cells + 1;
+  constexpr int64_t num_batches = 2;
+  constexpr int64_t num_classes = 2;
+
+  // a unit box per cell, a shifted copy of it that overlaps by more than the threshold, and one box covering all
+  std::vector<float> batch_boxes;
+  for (int64_t shift = 0; shift < 2; ++shift) {
+    for (int64_t i = 0; i < num_cells; ++i) {
+      const float y = static_cast<float>(i / grid_size);
+      const float x = static_cast<float>(i % grid_size) + 0.1f * shift;
+      batch_boxes.insert(batch_boxes.end(), {y, x, y + 1.0f, x + 1.0f});
+    }
+  }
+  batch_boxes.insert(batch_boxes.end(), {0.0f, 0.0f, static_cast<float>(grid_size), static_cast<float>(grid_size)});
+
+  std::vector<float> boxes;
+  std::vector<float> scores;
+  std::vector<int64_t> expected;
+  for (int64_t b = 0; b < num_batches; ++b) {
+    boxes.insert(boxes.end(), batch_boxes.begin(), batch_boxes.end());
+    for (int64_t c = 0; c < num_classes; ++c) {
+      for (int64_t i = 0; i < num_cells; ++i) {
+        scores.push_back(c == 0 ? 0.9f - 0.001f * i : 0.6f + 0.001f * i);
+      }
+      scores.insert(scores.end(), num_cells, 0.5f);
+      scores.push_back(0.1f);
+
+      for (int64_t i = 0; i < num_cells; ++i) {
+        expected.insert(expected.end(), {b, c, c == 0 ? i : num_cells - 1 - i});
+      }
+      expected.insert(expected.end(), {b, c, num_boxes - 1});
+    }
+  }
+
+  OpTester test("NonMaxSuppression", 11, kOnnxDomain);
+  test.AddInput<float>("boxes", {num_batches, num_boxes, 4}, boxes);
+  test.AddInput<float>("scores", {num_batches, num_classes, num_boxes}, scores);
+  test.AddInput<int64_t>("max_output_boxes_per_class", {}, {1000L});
+  test.AddInput<float>("iou_threshold", {}, {0.5f});
+  test.AddInput<float>("score_threshold", {}, {0.0f});
+  test.AddOutput<int64_t>("selected_indices", {static_cast<int64_t>(expected.size() / 3), 3}, expected);
+  test.Run();
+}
+
 }  // namespace test
 }  // namespace onnxruntime
@@ -3,6 +3,7 @@
 
 #include <random>
 #include <cmath>
+#include <numeric>
 #include <type_traits>
 #include "gtest/gtest.h"
 #include "test/common/tensor_op_test_utils.h"
@@ -2981,7 +2982,7 @@ TEST(ReductionOpTest, OptimizeShapeForFastReduce_KRK) {
   ASSERT_EQ(fast_axes, expected_fast_axes);
 }
 
-TEST(ReductionOpTest, OptimizeShapeForFastReduce_NONE) {
+TEST(ReductionOpTest, OptimizeShapeForFastReduce_Multi) {
   FastReduceKind fast_kind;
   std::vector<int64_t> fast_shape, fast_output_shape, fast_axes;
   std::vector<int64_t> expected_fast_shape, expected_fast_output_shape, expected_fast_axes;
@@ -2993,7 +2994,7 @@ TEST(ReductionOpTest, OptimizeShapeForFastReduce_NONE) {
   expected_fast_shape = std::vector<int64_t>{7, 9, 10, 11};
   expected_fast_output_shape = std::vector<int64_t>{9, 11};
   expected_fast_axes = std::vector<int64_t>{0, 2};
-  ASSERT_EQ(fast_kind, FastReduceKind::kNone);
+  ASSERT_EQ(fast_kind, FastReduceKind::kMulti);
   ASSERT_EQ(fast_shape, expected_fast_shape);
   ASSERT_EQ(fast_output_shape, expected_fast_output_shape);
   ASSERT_EQ(fast_axes, expected_fast_axes);
@@ -3004,7 +3005,7 @@ TEST(ReductionOpTest, OptimizeShapeForFastReduce_NONE) {
   expected_fast_shape = std::vector<int64_t>{7, 9, 10, 11};
   expected_fast_output_shape = std::vector<int64_t>{7, 1, 10, 1};
   expected_fast_axes = std::vector<int64_t>{1, 3};
-  ASSERT_EQ(fast_kind, FastReduceKind::kNone);
+  ASSERT_EQ(fast_kind, FastReduceKind::kMulti);
   ASSERT_EQ(fast_shape, expected_fast_shape);
   ASSERT_EQ(fast_output_shape, expected_fast_output_shape);
   ASSERT_EQ(fast_axes, expected_fast_axes);
@@ -3016,7 +3017,7 @@ TEST(ReductionOpTest, OptimizeShapeForFastReduce_NONE) {
   expected_fast_shape = std::vector<int64_t>{63, 110, 6, 24};
   expected_fast_output_shape = std::vector<int64_t>{10, 11, 4, 6};
   expected_fast_axes = std::vector<int64_t>{0, 2};
-  ASSERT_EQ(fast_kind, FastReduceKind::kNone);
+  ASSERT_EQ(fast_kind, FastReduceKind::kMulti);
   ASSERT_EQ(fast_shape, expected_fast_shape);
   ASSERT_EQ(fast_output_shape, expected_fast_output_shape);
   ASSERT_EQ(fast_axes, expected_fast_axes);
@@ -3027,7 +3028,7 @@ TEST(ReductionOpTest, OptimizeShapeForFastReduce_NONE) {
   expected_fast_shape = std::vector<int64_t>{63, 110, 6, 24};
   expected_fast_output_shape = std::vector<int64_t>{1, 1, 10, 11, 1, 1, 4, 6};
   expected_fast_axes = std::vector<int64_t>{0, 2};
-  ASSERT_EQ(fast_kind, FastReduceKind::kNone);
+  ASSERT_EQ(fast_kind, FastReduceKind::kMulti);
   ASSERT_EQ(fast_shape, expected_fast_shape);
   ASSERT_EQ(fast_output_shape, expected_fast_output_shape);
   ASSERT_EQ(fast_axes, expected_fast_axes);
@@ -3970,5 +3971,66 @@ TEST(ReductionOpTest, ReduceSum_RKRK_keepdims) {
   test.Run();
 }
 
+TEST(ReductionOpTest, ReduceSumSquare_RKRK) {
+  OpTester test("ReduceSumSquare");
+  test.AddAttribute("axes", std::vector<int64_t>{0, 2});
+  test.AddAttribute("keepdims", (int64_t)0);
+  std::vector<float> data(24);
+  std::iota(data.begin(), data.end(), 1.0f);
+  test.AddInput<float>("data", {3, 2, 2, 2}, data);
+  test.AddOutput<float>("reduced", {2, 2}, {862.f, 988.f, 1438.f, 1612.f});
+  test.Run();
+}
+
+TEST(ReductionOpTest, ReduceLogSumExp_RKRK) {
+  OpTester test("ReduceLogSumExp");
+  test.AddAttribute("axes", std::vector<int64_t>{0, 2});
+  test.AddAttribute("keepdims", (int64_t)1);
+  std::vector<float> data(24);
+  for (size_t i = 0; i < data.size(); ++i) {
+    data[i] = static_cast<float>(i + 1) / 10.f;
+  }
+  test.AddInput<float>("data", {3, 2, 2, 2}, data);
+  test.AddOutput<float>("reduced", {1, 2, 1, 2}, {2.9996566f, 3.0996566f, 3.3996566f, 3.4996566f});
+  test.Run();
+}
+
+TEST(ReductionOpTest, ReduceMean_RKRR) {
+  OpTester test("ReduceMean");
+  test.AddAttribute("axes", std::vector<int64_t>{0, 2, 3});
+  test.AddAttribute("keepdims", (int64_t)0);
+  std::vector<float> data(24);
+  std::iota(data.begin(), data.end(), 1.0f);
+  test.AddInput<float>("data", {2, 3, 2, 2}, data);
+  test.AddOutput<float>("reduced", {3}, {8.5f, 12.5f, 16.5f});
+  test.Run();
+}
+
+TEST(ReductionOpTest, ReduceL1_int32_KRK) {
+  OpTester test("ReduceL1");
+  test.AddAttribute("axes", std::vector<int64_t>{1});
+  test.AddAttribute("keepdims", (int64_t)0);
+  std::vector<int32_t> data(24);
+  std::iota(data.begin(), data.end(), -12);
+  test.AddInput<int32_t>("data", {2, 3, 4}, data);
+  test.AddOutput<int32_t>("reduced", {2, 4}, {24, 21, 18, 15, 12, 15, 18, 21});
+  test.Run();
+}
+
+TEST(ReductionOpTest, ReduceLogSumExp_double_KRK) {
+  OpTester test("ReduceLogSumExp");
+  test.AddAttribute("axes", std::vector<int64_t>{1});
+  test.AddAttribute("keepdims", (int64_t)0);
+  std::vector<double> data(24);
+  for (size_t i = 0; i < data.size(); ++i) {
+    data[i] = (static_cast<double>(i) - 12.0) / 4.0;
+  }
+  test.AddInput<double>("data", {2, 3, 4}, data);
+  test.AddOutput<double>("reduced", {2, 4},
+                         {-0.59239404, -0.34239404, -0.09239404, 0.15760596,
+                          2.40760596, 2.65760596, 2.90760596, 3.15760596});
+  test.Run();
+}
+
 }  // namespace test
 }  // namespace onnxruntime
@@ -487,6 +487,87 @@ TEST(LSTMTest, LargeBatchWithClip) {
   LargeBatchWithClip(Y_h_data, 4.f);
 }
 
+static std::vector<float> GenerateLstmTestData(size_t size, size_t multiplier, size_t modulus, size_t offset,
+                                               float scale) {
+  std::vector<float> data(size);
+  for (size_t i = 0; i < size; ++i) {
+    data[i] = (static_cast<float>((i * multiplier) % modulus) - static_cast<float>(offset)) * scale;
+  }
+
+  return data;
+}
+
+// R is pre-packed in tiles of hidden units when it is an initializer, and each step then runs the recurrent GEMM and
+// the gate computations one tile at a time. hidden_size is not a multiple of the tile size so there's a partial tile.
+static void TiledRecurrenceWeights(int64_t seq_length, int64_t batch_size, const std::vector<float>& Y_data,
+                                   const std::vector<float>& Y_h_data, const std::vector<float>& Y_c_data,
+                                   const std::vector<int>* sequence_lengths = nullptr) {
+  const int64_t input_size = 2;
+  const int64_t hidden_size = 20;
+
+  std::vector<float> X_data = GenerateLstmTestData(seq_length * batch_size * input_size, 7, 11, 5, 0.1f);
+  std::vector<float> W_data = GenerateLstmTestData(4 * hidden_size * input_size, 13, 17, 8, 0.02f);
+  std::vector<float> R_data = GenerateLstmTestData(4 * hidden_size * hidden_size, 5, 19, 9, 0.01f);
+  std::vector<float> B_data = GenerateLstmTestData(8 * hidden_size, 3, 7, 3, 0.05f);
+
+  for (bool is_initializer_R : std::initializer_list<bool>{false, true}) {
+    RunLstmTest(X_data, W_data, true, R_data, is_initializer_R, Y_data, Y_h_data, Y_c_data,
+                input_size, batch_size, hidden_size, seq_length, &B_data, nullptr, nullptr, nullptr,
+                sequence_lengths);
+  }
+}
+
+// batch_parallel_ is false so the tiles of each step are run in parallel
+TEST(LSTMTest, TiledRecurrenceWeightsSingleSequence) {
+  std::vector<float> Y_data{
+      -0.024664301f, -0.023933844f, 0.040587315f, -0.052696006f, 0.010477756f,
+      0.009129151f, -0.016881401f, -0.015964294f, 0.f, 0.046120636f,
+      -0.0262974f, 0.016961495f, 0.030607874f, -0.008570886f, 0.0082261776f,
+      -0.031433234f, 0.056969144f, -0.063657206f, 0.025554248f, -0.00047757451f,
+      -0.028777148f, -0.05215452f, 0.071135757f, -0.088898205f, 0.02839156f,
+      0.0039660734f, -0.0046517632f, -0.027645628f, -0.0065495407f, 0.062388942f,
+      -0.039593159f, 0.02635515f, 0.045151362f, -0.0082179476f, 0.016200965f,
+      -0.043162819f, 0.060224795f, -0.088461904f, 0.02642166f, 0.0096790806f,
+      -0.025240793f, -0.042588404f, 0.085623664f, -0.081291637f, 0.035211037f,
+      0.01829428f, -0.0019451011f, -0.019869477f, -0.040865226f, 0.086437211f,
+      -0.081320134f, 0.042057713f, 0.018022523f, 0.0021386932f, -0.019874306f,
+      -0.043303722f, 0.08457982f, -0.092943924f, 0.047747986f, 0.015892766f};
+
+  std::vector<float> Y_c_data{
+      -0.045492978f, -0.097116555f, 0.16377945f, -0.16511815f, 0.070176647f,
+      0.036538373f, -0.0041098747f, -0.035738556f, -0.090556438f, 0.16352159f,
+      -0.1611557f, 0.083366459f, 0.03694934f, 0.0044456766f, -0.037202299f,
+      -0.094856294f, 0.16688669f, -0.18105641f, 0.099110503f, 0.032317702f};
+
+  TiledRecurrenceWeights(3, 1, Y_data, {}, Y_c_data);
+}
+
+// only Y_h is output so the hidden state alternates between two buffers. the sequences end on an odd and an even step.
+TEST(LSTMTest, TiledRecurrenceWeightsNoOutputSequence) {
+  std::vector<float> Y_h_data{
+      -0.027486301f, -0.043412579f, 0.090996255f, -0.083718849f, 0.037136909f,
+      0.020763609f, 0.0014197816f, -0.018828563f, -0.052010268f, 0.091776486f,
+      -0.092971749f, 0.046877354f, 0.013426746f, 0.0041588475f, -0.025453417f,
+      -0.045454805f, 0.090259581f, -0.099638399f, 0.055835928f, 0.015717274f,
+      -0.022856661f, -0.034300205f, 0.086059947f, -0.073547189f, 0.03692045f,
+      0.025691043f, 0.00055689476f, -0.014543208f, -0.055175395f, 0.09254927f,
+      -0.097176836f, 0.046448268f, 0.0029116664f, 0.0054992893f, -0.037865341f,
+      -0.039943749f, 0.096938203f, -0.087574999f, 0.056820277f, 0.017113507f};
+
+  std::vector<float> Y_c_data{
+      -0.049664555f, -0.098606647f, 0.1744806f, -0.16940351f, 0.073810891f,
+      0.041878113f, 0.00298831f, -0.034159645f, -0.11431441f, 0.17499483f,
+      -0.18304231f, 0.093546513f, 0.027143641f, 0.0086817149f, -0.047813508f,
+      -0.09985663f, 0.17830033f, -0.19454983f, 0.1158402f, 0.031982253f,
+      -0.041265788f, -0.078327445f, 0.16556499f, -0.15023834f, 0.074091726f,
+      0.050196416f, 0.0011901338f, -0.025741254f, -0.12403412f, 0.17305197f,
+      -0.19628628f, 0.091222916f, 0.0060976503f, 0.011365979f, -0.070363087f,
+      -0.087306572f, 0.1911459f, -0.17079652f, 0.11836361f, 0.035017058f};
+
+  std::vector<int> sequence_lengths{4, 3};
+  TiledRecurrenceWeights(4, 2, {}, Y_h_data, Y_c_data, &sequence_lengths);
+}
+
 // ONNXRuntime tests
 class LstmOpContext2x1x2x2 {
  public:
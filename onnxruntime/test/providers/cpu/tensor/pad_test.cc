@@ -3,6 +3,7 @@
 
 #include "gtest/gtest.h"
 #include "test/providers/provider_test_utils.h"
+#include "test/util/include/default_providers.h"
 
 namespace onnxruntime {
 namespace test {
@@ -769,6 +770,78 @@ TYPED_TEST(PadOpTest, Pad_Reflect_DimWithZeroInput) {
                                   "Cannot use 'reflect' mode to pad dimension with a value of 0. Input shape:{0,2,1}");
 }
 
+// Runs the opset-13 Pad on the CPU EP only. The cases below cover CPU specific behavior that other EPs may not match.
+static void RunCpuPadTest(const std::vector<int64_t>& input_dims,
+                          const std::vector<float>& input,
+                          const std::vector<int64_t>& pads,
+                          const std::vector<int64_t>& output_dims,
+                          const std::vector<float>& output,
+                          const std::string& mode,
+                          OpTester::ExpectResult expect = OpTester::ExpectResult::kExpectSuccess,
+                          const std::string& error_msg = "") {
+  OpTester test("Pad", 13);
+  test.AddAttribute("mode", mode);
+  test.AddInput<float>("data", input_dims, input);
+  test.AddInput<int64_t>("pads", {static_cast<int64_t>(pads.size())}, pads);
+  test.AddInput<float>("value", {1}, {0.f});
+  test.AddOutput<float>("output", output_dims, output);
+
+  std::vector<std::unique_ptr<IExecutionProvider>> execution_providers;
+  execution_providers.push_back(DefaultCpuExecutionProvider());
+  test.Run(expect, error_msg, {}, nullptr, &execution_providers);
+}
+
+// Reflection repeats when the pads are at least as large as the extent, as numpy.pad does.
+TEST(PadOpTest, Pad_Reflect_1D_PadsLargerThanExtent) {
+  RunCpuPadTest({3},
+                {1.f, 2.f, 3.f},
+                {4, 5},
+                {12},
+                {1.f, 2.f, 3.f, 2.f, 1.f, 2.f, 3.f, 2.f, 1.f, 2.f, 3.f, 2.f},
+                "reflect");
+}
+
+TEST(PadOpTest, Pad_Reflect_2D_PadsLargerThanExtent) {
+  RunCpuPadTest({2, 3},
+                {1.f, 2.f, 3.f,
+                 4.f, 5.f, 6.f},
+                {2, 3, 3, 3},
+                {7, 9},
+                {2.f, 3.f, 2.f, 1.f, 2.f, 3.f, 2.f, 1.f, 2.f,
+                 5.f, 6.f, 5.f, 4.f, 5.f, 6.f, 5.f, 4.f, 5.f,
+                 2.f, 3.f, 2.f, 1.f, 2.f, 3.f, 2.f, 1.f, 2.f,
+                 5.f, 6.f, 5.f, 4.f, 5.f, 6.f, 5.f, 4.f, 5.f,
+                 2.f, 3.f, 2.f, 1.f, 2.f, 3.f, 2.f, 1.f, 2.f,
+                 5.f, 6.f, 5.f, 4.f, 5.f, 6.f, 5.f, 4.f, 5.f,
+                 2.f, 3.f, 2.f, 1.f, 2.f, 3.f, 2.f, 1.f, 2.f},
+                "reflect");
+}
+
+// Edge and reflect padding need at least one input value left on every axis after the negative pads are applied.
+TEST(PadOpTest, Pad_Edge_NoInputLeftAfterNegativePads) {
+  RunCpuPadTest({2, 3},
+                {1.f, 2.f, 3.f, 4.f, 5.f, 6.f},
+                {0, -3, 0, 1},
+                {2, 1},
+                {0.f, 0.f},
+                "edge",
+                OpTester::ExpectResult::kExpectFailure,
+                "Cannot use 'edge' or 'reflect' mode to pad a dimension that has no input values left after applying "
+                "the negative pads. Input shape:{2,3}");
+}
+
+TEST(PadOpTest, Pad_Reflect_NoInputLeftAfterNegativePads) {
+  RunCpuPadTest({2, 3},
+                {1.f, 2.f, 3.f, 4.f, 5.f, 6.f},
+                {-2, 1, 1, 1},
+                {1, 5},
+                {0.f, 0.f, 0.f, 0.f, 0.f},
+                "reflect",
+                OpTester::ExpectResult::kExpectFailure,
+                "Cannot use 'edge' or 'reflect' mode to pad a dimension that has no input values left after applying "
+                "the negative pads. Input shape:{2,3}");
+}
+
 TEST(PadOpTest, BoolType) {
   OpTester test("Pad", 13);
   test.AddAttribute("mode", "constant");
@@ -4,6 +4,7 @@
 #include "core/providers/cpu/tensor/resize.h"
 #include "gtest/gtest.h"
 #include "test/providers/provider_test_utils.h"
+#include "test/util/include/default_providers.h"
 
 namespace onnxruntime {
 namespace test {
@@ -993,6 +994,79 @@ TEST(ResizeOpTest, ResizeOpCubicUpSampleTest_MultiChannel) {
   test.AddOutput<float>("Y", {N, C, sizes[2], sizes[3]}, Y);
   test.Run();
 }
+
+TEST(ResizeOpTest, ResizeOpLinearUpSampleTest_4DBilinear_asymmetric_NHWC_uint8) {
+  // Same data as ResizeOpLinearUpSampleTest_4DBilinear_asymmetric with the 2 images as the channels of a
+  // [N, H, W, C] input, as found in image preprocessing graphs
+  OpTester test("Resize", 13);
+  std::vector<float> roi{};
+  std::vector<float> scales{1.0f, 2.0f, 4.0f, 1.0f};
+
+  test.AddAttribute("mode", "linear");
+  test.AddAttribute("coordinate_transformation_mode", "asymmetric");
+
+  const int64_t N = 1, H = 2, W = 2, C = 2;
+  std::vector<uint8_t> X = {1, 6, 3, 2,
+                            4, 7, 8, 11};
+
+  test.AddInput<uint8_t>("X", {N, H, W, C}, X);
+  test.AddInput<float>("roi", {0}, roi);
+  test.AddInput<float>("scales", {4}, scales);
+
+  std::vector<uint8_t> Y = {
+      1, 6, 1, 5, 2, 4, 2, 3, 3, 2, 3, 2, 3, 2, 3, 2,
+      2, 6, 3, 6, 4, 6, 4, 6, 5, 6, 5, 6, 5, 6, 5, 6,
+      4, 7, 5, 8, 6, 9, 7, 10, 8, 11, 8, 11, 8, 11, 8, 11,
+      4, 7, 5, 8, 6, 9, 7, 10, 8, 11, 8, 11, 8, 11, 8, 11};
+
+  test.AddOutput<uint8_t>("Y", {N, static_cast<int64_t>(H * scales[1]), static_cast<int64_t>(W * scales[2]), C}, Y);
+
+  // channels last linear resize is only implemented by the CPU EP
+  std::vector<std::unique_ptr<IExecutionProvider>> execution_providers;
+  execution_providers.push_back(DefaultCpuExecutionProvider());
+  test.Run(OpTester::ExpectResult::kExpectSuccess, "", {}, nullptr, &execution_providers);
+}
+
+TEST(ResizeOpTest, ResizeOpCubicUpSampleTest_MultiChannel_NHWC) {
+  // Same data as ResizeOpCubicUpSampleTest_MultiChannel in [N, H, W, C] layout
+  OpTester test("Resize", 13);
+  std::vector<float> scales{};
+  std::vector<int64_t> sizes{1, 9, 9, 2};
+  std::vector<float> roi{};
+
+  test.AddAttribute("mode", "cubic");
+
+  const int64_t N = 1, H = 4, W = 4, C = 2;
+  std::vector<float> X = {
+      0.0f, 16.0f, 1.0f, 17.0f, 2.0f, 18.0f, 3.0f, 19.0f,
+      4.0f, 20.0f, 5.0f, 21.0f, 6.0f, 22.0f, 7.0f, 23.0f,
+      8.0f, 24.0f, 9.0f, 25.0f, 10.0f, 26.0f, 11.0f, 27.0f,
+      12.0f, 28.0f, 13.0f, 29.0f, 14.0f, 30.0f, 15.0f, 31.0f};
+
+  test.AddInput<float>("X", {N, H, W, C}, X);
+  test.AddInput<float>("roi", {0}, roi);
+  test.AddInput<float>("scales", {0}, scales);
+  test.AddInput<int64_t>("sizes", {4}, sizes);
+
+  std::vector<float> Y = {
+      -0.543341f, 15.4567f, -0.308515f, 15.6915f, 0.0807175f, 16.0807f, 0.644203f, 16.6442f, 1.06533f, 17.0653f, 1.48645f, 17.4865f, 2.04994f, 18.0499f, 2.43917f, 18.4392f, 2.674f, 18.674f,
+      0.395961f, 16.396f, 0.630787f, 16.6308f, 1.02002f, 17.02f, 1.5835f, 17.5835f, 2.00463f, 18.0046f, 2.42575f, 18.4258f, 2.98924f, 18.9892f, 3.37847f, 19.3785f, 3.6133f, 19.6133f,
+      1.95289f, 17.9529f, 2.18772f, 18.1877f, 2.57695f, 18.5769f, 3.14043f, 19.1404f, 3.56156f, 19.5616f, 3.98268f, 19.9827f, 4.54617f, 20.5462f, 4.9354f, 20.9354f, 5.17023f, 21.1702f,
+      4.20683f, 20.2068f, 4.44166f, 20.4417f, 4.83089f, 20.8309f, 5.39437f, 21.3944f, 5.8155f, 21.8155f, 6.23662f, 22.2366f, 6.80011f, 22.8001f, 7.18934f, 23.1893f, 7.42417f, 23.4242f,
+      5.89133f, 21.8913f, 6.12616f, 22.1262f, 6.51539f, 22.5154f, 7.07887f, 23.0789f, 7.5f, 23.5f, 7.92112f, 23.9211f, 8.48461f, 24.4846f, 8.87384f, 24.8738f, 9.10867f, 25.1087f,
+      7.57583f, 23.5758f, 7.81066f, 23.8107f, 8.19989f, 24.1999f, 8.76337f, 24.7634f, 9.1845f, 25.1845f, 9.60562f, 25.6056f, 10.1691f, 26.1691f, 10.5583f, 26.5583f, 10.7932f, 26.7932f,
+      9.82977f, 25.8298f, 10.0646f, 26.0646f, 10.4538f, 26.4538f, 11.0173f, 27.0173f, 11.4384f, 27.4384f, 11.8596f, 27.8596f, 12.423f, 28.423f, 12.8123f, 28.8123f, 13.0471f, 29.0471f,
+      11.3867f, 27.3867f, 11.6215f, 27.6215f, 12.0108f, 28.0108f, 12.5742f, 28.5742f, 12.9954f, 28.9954f, 13.4165f, 29.4165f, 13.98f, 29.98f, 14.3692f, 30.3692f, 14.604f, 30.604f,
+      12.326f, 28.326f, 12.5608f, 28.5608f, 12.9501f, 28.9501f, 13.5135f, 29.5135f, 13.9347f, 29.9347f, 14.3558f, 30.3558f, 14.9193f, 30.9193f, 15.3085f, 31.3085f, 15.5433f, 31.5433f};
+
+  test.AddOutput<float>("Y", {N, sizes[1], sizes[2], C}, Y);
+
+  // channels last cubic resize is only implemented by the CPU EP
+  std::vector<std::unique_ptr<IExecutionProvider>> execution_providers;
+  execution_providers.push_back(DefaultCpuExecutionProvider());
+  test.Run(OpTester::ExpectResult::kExpectSuccess, "", {}, nullptr, &execution_providers);
+}
+
 TEST(ResizeOpTest, ResizeOpCubicUpSampleTest_tf_half_pixel_for_nn) {
   // tf_half_pixel_for_nn has been deprecated since opset 13
   OpTester test("Resize", 12);
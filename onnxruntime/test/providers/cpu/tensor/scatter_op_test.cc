@@ -294,5 +294,34 @@ TEST(Scatter, LargerIndicesOnAxis) {
   scatter_with_larger_indices_on_axis_tests("ScatterElements", 11);
 }
 
+// Duplicate indices in different rows and columns. Updates that only differ on the axis are applied in order,
+// so the last one wins.
+static void scatter_duplicate_indices_on_axis_tests(const char* op_name, int op_version) {
+  OpTester test(op_name, op_version);
+  test.AddAttribute<int64_t>("axis", 0);
+
+  test.AddInput<float>("data", {2, 3}, {0.0f, 0.0f, 0.0f,
+                                        0.0f, 0.0f, 0.0f});
+  test.AddInput<int64_t>("indices", {3, 3},
+                         {1, 0, 1,
+                          1, 1, 0,
+                          0, 1, 1});
+  test.AddInput<float>("updates", {3, 3},
+                       {1.0f, 2.0f, 3.0f,
+                        4.0f, 5.0f, 6.0f,
+                        7.0f, 8.0f, 9.0f});
+  test.AddOutput<float>("y", {2, 3},
+                        {7.0f, 2.0f, 6.0f,
+                         4.0f, 8.0f, 9.0f});
+  // the order in which duplicate indices are applied is not defined on GPUs
+  test.Run(OpTester::ExpectResult::kExpectSuccess, "",
+           {kCudaExecutionProvider, kRocmExecutionProvider, kTensorrtExecutionProvider});
+}
+
+TEST(Scatter, DuplicateIndicesOnAxis) {
+  scatter_duplicate_indices_on_axis_tests("Scatter", 9);
+  scatter_duplicate_indices_on_axis_tests("ScatterElements", 11);
+}
+
 }  // namespace test
 }  // namespace onnxruntime
@@ -967,6 +967,39 @@ TEST(CApiTest, get_string_tensor_element) {
   ASSERT_EQ(expected_string_len, string_len);
 }
 
+TEST(CApiTest, create_string_tensor_with_buffer) {
+  const std::string data = "abckmpxyz";
+  const size_t offsets[] = {0, 3, 3, 6};
+  const int64_t shape[] = {2, 2};
+  auto default_allocator = std::make_unique<MockedOrtAllocator>();
+
+  Ort::Value tensor = Ort::Value::CreateStringTensorWithBuffer(default_allocator.get(), shape, 2, data.data(),
+                                                               data.size(), offsets, 4);
+  ASSERT_EQ(tensor.GetTensorTypeAndShapeInfo().GetElementType(), ONNX_TENSOR_ELEMENT_DATA_TYPE_STRING);
+  ASSERT_EQ(tensor.GetStringTensorDataLength(), data.size());
+  ASSERT_EQ(tensor.GetStringTensorElementLength(1), 0u);
+
+  std::string result(data.size(), '\0');
+  std::vector<size_t> result_offsets(4);
+  tensor.GetStringTensorContent((void*)result.data(), result.size(), result_offsets.data(), result_offsets.size());
+  ASSERT_EQ(result, data);
+  ASSERT_EQ(result_offsets, std::vector<size_t>(std::begin(offsets), std::end(offsets)));
+
+  std::string element(3, '\0');
+  tensor.GetStringTensorElement(element.size(), 3, (void*)element.data());
+  ASSERT_EQ(element, "xyz");
+
+  // the strings can't be modified in place
+  const char* s[] = {"a", "b", "c", "d"};
+  ASSERT_THROW(tensor.FillStringTensor(s, 4), Ort::Exception);
+
+  // offsets must be increasing
+  const size_t bad_offsets[] = {0, 6, 3, 6};
+  ASSERT_THROW(Ort::Value::CreateStringTensorWithBuffer(default_allocator.get(), shape, 2, data.data(),
+                                                        data.size(), bad_offsets, 4),
+               Ort::Exception);
+}
+
 TEST(CApiTest, create_tensor_with_data) {
   float values[] = {3.0f, 1.0f, 2.f, 0.f};
   constexpr size_t values_length = sizeof(values) / sizeof(values[0]);